@@ -49,6 +49,7 @@
 #include <Pegasus/Common/PegasusVersion.h>
 #include <Pegasus/Common/StatisticalData.h>
 #include <Pegasus/Common/HostAddress.h>
+#include <Pegasus/Common/Constants.h>
 
 #include <Pegasus/Client/CIMClient.h>
 
@@ -137,6 +138,9 @@ void GetOptions(
         {"password","",false,Option::STRING, 0, 0, "w",
                 "login password for user"},
 
+        {"percentiles", "false", false, Option::BOOLEAN, 0, 0, "-percentiles",
+                "Also displays percentiles of times and sizes "},
+
     };
     const Uint32 NUM_OPTIONS = sizeof(optionsTable) / sizeof(optionsTable[0]);
 
@@ -172,6 +176,114 @@ const char* opTypeToOpName(Uint16 type)
     return opName;
 }
 
+/* Method that gets a Uint64 property value, 0 if it is not present.
+*/
+
+static Uint64 getUint64Property(const CIMInstance& instance, const char* name)
+{
+    Uint64 value = 0;
+    Uint32 pos = instance.findProperty(name);
+    if (pos != PEG_NOT_FOUND)
+    {
+        CIMValue v = instance.getProperty(pos).getValue();
+        if (v.getType() == CIMTYPE_UINT64 && !v.isNull())
+        {
+            v.get(value);
+        }
+    }
+    return value;
+}
+
+/* Method that gets a String property value, empty if it is not present.
+*/
+
+static String getStringProperty(const CIMInstance& instance, const char* name)
+{
+    String value;
+    Uint32 pos = instance.findProperty(name);
+    if (pos != PEG_NOT_FOUND)
+    {
+        CIMValue v = instance.getProperty(pos).getValue();
+        if (v.getType() == CIMTYPE_STRING && !v.isNull())
+        {
+            v.get(value);
+        }
+    }
+    return value;
+}
+
+/* Method that displays the instances of PG_CIMOMStatisticalLatencyData,
+   the percentiles of the statistics shown as averages by the main table.
+*/
+
+static void printPercentiles(CIMClient& client)
+{
+    // Indexed by the Metric property value
+    static const char* metricName[] =
+    {
+        "Server Time (usec)",
+        "Provider Time (usec)",
+        "Response Size (bytes)",
+        "Request Size (bytes)",
+        "Chunk Objects",
+        "Chunk Size (bytes)"
+    };
+    const Uint16 metricNameSize = sizeof(metricName) / sizeof(metricName[0]);
+
+    Array<CIMInstance> instances = client.enumerateInstances(
+        PEGASUS_NAMESPACENAME_INTERNAL,
+        PEGASUS_CLASSNAME_PG_CIMOMSTATLATENCYDATA,
+        false, false, false, false);
+
+    printf("\n%-25s%-22s%10s %10s %10s %10s %10s %10s\n",
+        "Operation Type or", "Statistic", "Samples", "p50", "p90", "p99",
+        "p99.9", "Maximum");
+
+    printf("%-25s\n", "Provider Module");
+
+    printf("%-25s\n", "-------------------------------------------"
+                      "--------------------------------------------------"
+                      "------------------------------");
+
+    for (Uint32 inst = 0; inst < instances.size(); inst++)
+    {
+        const CIMInstance& instance = instances[inst];
+
+        String name = getStringProperty(instance, "OperationName");
+        if (name.size() == 0)
+        {
+            name = getStringProperty(instance, "ProviderModuleName");
+        }
+
+        Uint16 metric = metricNameSize;
+        Uint32 pos = instance.findProperty("Metric");
+        if (pos != PEG_NOT_FOUND)
+        {
+            CIMValue v = instance.getProperty(pos).getValue();
+            if (v.getType() == CIMTYPE_UINT16 && !v.isNull())
+            {
+                v.get(metric);
+            }
+        }
+
+        printf("%-25s%-22s"
+            "%10" PEGASUS_64BIT_CONVERSION_WIDTH "u"
+            "%11" PEGASUS_64BIT_CONVERSION_WIDTH "u"
+            "%11" PEGASUS_64BIT_CONVERSION_WIDTH "u"
+            "%11" PEGASUS_64BIT_CONVERSION_WIDTH "u"
+            "%11" PEGASUS_64BIT_CONVERSION_WIDTH "u"
+            "%11" PEGASUS_64BIT_CONVERSION_WIDTH "u\n",
+            (const char*)name.getCString(),
+            metric < metricNameSize ? metricName[metric] : "UNKNOWN",
+            getUint64Property(instance, "NumberOfSamples"),
+            getUint64Property(instance, "Percentile50"),
+            getUint64Property(instance, "Percentile90"),
+            getUint64Property(instance, "Percentile99"),
+            getUint64Property(instance, "Percentile999"),
+            getUint64Property(instance, "MaximumValue"));
+    }
+}
+
 int main(int argc, char** argv)
 {
 
@@ -519,6 +631,11 @@ int main(int argc, char** argv)
                 averageRequestSize,
                 averageResponseSize);
         }
+
+        if (om.isTrue("percentiles"))
+        {
+            printPercentiles(client);
+        }
     }
     catch (Exception& e)
     {
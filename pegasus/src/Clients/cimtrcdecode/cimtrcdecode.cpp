@@ -0,0 +1,123 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+/*
+    cimtrcdecode converts a binary trace file written with
+    traceFacility=AsyncBinary into trace messages in the format written
+    with traceFacility=File.
+
+    Usage: cimtrcdecode binaryTraceFile [outputFile]
+*/
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/TraceAsyncHandler.h>
+#include <Pegasus/Common/PegasusVersion.h>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+PEGASUS_USING_PEGASUS;
+PEGASUS_USING_STD;
+
+static void _usage(const char* program)
+{
+    cerr << "Usage: " << program << " binaryTraceFile [outputFile]" << endl;
+    cerr << "Converts a trace file written with traceFacility=AsyncBinary"
+        " into trace" << endl;
+    cerr << "messages. The messages are written to outputFile or to the "
+        "standard output." << endl;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc == 2 &&
+        (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0))
+    {
+        _usage(argv[0]);
+        return 0;
+    }
+
+    if (argc == 2 && strcmp(argv[1], "--version") == 0)
+    {
+        cout << PEGASUS_PRODUCT_VERSION << endl;
+        return 0;
+    }
+
+    if (argc < 2 || argc > 3)
+    {
+        _usage(argv[0]);
+        return 1;
+    }
+
+    FILE* in = fopen(argv[1], "rb");
+    if (!in)
+    {
+        cerr << argv[0] << ": Cannot open " << argv[1] << ": "
+            << strerror(errno) << endl;
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (argc == 3)
+    {
+        out = fopen(argv[2], "w");
+        if (!out)
+        {
+            cerr << argv[0] << ": Cannot open " << argv[2] << ": "
+                << strerror(errno) << endl;
+            fclose(in);
+            return 1;
+        }
+    }
+
+    String error;
+    Boolean decoded = TraceAsyncHandler::decodeBinaryTrace(in, out, error);
+
+    fclose(in);
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    else
+    {
+        fflush(out);
+    }
+
+    if (!decoded)
+    {
+        cerr << argv[0] << ": " << argv[1] << ": " << error << endl;
+        return 1;
+    }
+
+    return 0;
+}
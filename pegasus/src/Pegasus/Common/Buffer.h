@@ -89,6 +89,15 @@ public:
 
     void grow(Uint32 size, char x = '\0');
 
+    /**
+        Adds size bytes to the Buffer contents that the caller has already
+        written to the reserved capacity at getContentPtr() + size(), for
+        example by reading from a socket directly into the Buffer.
+        ATTENTION: Function does NOT check if enough capacity is available in
+                  the Buffer and expects the caller to take care of that upfront.
+    */
+    void appendReserved(Uint32 size);
+
     void append(char x);
 
     void append_unchecked(char x);
@@ -213,6 +222,11 @@ inline void Buffer::grow(Uint32 size, char x)
     _rep->size += size;
 }
 
+inline void Buffer::appendReserved(Uint32 size)
+{
+    _rep->size += size;
+}
+
 inline void Buffer::append(char x)
 {
     if (_rep->size == _rep->cap)
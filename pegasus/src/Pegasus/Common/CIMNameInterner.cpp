@@ -0,0 +1,145 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#include <Pegasus/Common/CIMNameInterner.h>
+#include <Pegasus/Common/HashTable.h>
+#include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/StringRep.h>
+
+PEGASUS_NAMESPACE_BEGIN
+
+// Bounds of the table. The CIM schema has a few thousand class and property
+// names; the bounds leave ample room for those while keeping arbitrary names
+// received from clients from growing the table without limit.
+#define PEGASUS_CIMNAME_INTERN_MAX_ENTRIES 32768
+#define PEGASUS_CIMNAME_INTERN_MAX_LENGTH 256
+
+typedef HashTable<String, String, EqualFunc<String>, HashFunc<String> >
+    CIMNameInternTable;
+
+static Mutex _internMutex;
+
+// Allocated on first use and deliberately never destroyed, since interned
+// names may still be referenced during static destruction.
+static CIMNameInternTable* _internTable = 0;
+
+static inline StringRep* _getRep(const String& str)
+{
+    return const_cast<StringRep*>(
+        StringRep::fromData((const Uint16*)str.getChar16Data()));
+}
+
+void CIMNameInterner::intern(String& str)
+{
+    Uint32 size = str.size();
+
+    if (size == 0 || size > PEGASUS_CIMNAME_INTERN_MAX_LENGTH ||
+        StringRep::isInterned(_getRep(str)))
+    {
+        return;
+    }
+
+    AutoMutex lock(_internMutex);
+
+    if (!_internTable)
+    {
+        _internTable = new CIMNameInternTable(1024);
+    }
+
+    String canonical;
+
+    if (!_internTable->lookup(str, canonical))
+    {
+        if (_internTable->size() >= PEGASUS_CIMNAME_INTERN_MAX_ENTRIES)
+        {
+            return;
+        }
+
+        // Allocate a private representation with room for the hash after
+        // the null terminator.
+        canonical.reserveCapacity(size + 2);
+        canonical.append(str);
+
+        Uint32 hash = HashLowerCaseFunc::hash(canonical);
+        StringRep* rep = _getRep(canonical);
+        rep->data[size + 1] = Uint16(hash >> 16);
+        rep->data[size + 2] = Uint16(hash & 0xFFFF);
+
+        // canonical holds the one existing reference.
+        rep->refs.set(PEGASUS_STRINGREP_INTERNED_REFS + 1);
+
+        _internTable->insert(canonical, canonical);
+    }
+
+    str = canonical;
+}
+
+Boolean CIMNameInterner::lookup(String& str)
+{
+    Uint32 size = str.size();
+
+    if (StringRep::isInterned(_getRep(str)))
+    {
+        return true;
+    }
+
+    if (size == 0 || size > PEGASUS_CIMNAME_INTERN_MAX_LENGTH)
+    {
+        return false;
+    }
+
+    AutoMutex lock(_internMutex);
+
+    String canonical;
+
+    if (!_internTable || !_internTable->lookup(str, canonical))
+    {
+        return false;
+    }
+
+    str = canonical;
+    return true;
+}
+
+Boolean CIMNameInterner::isInterned(const String& str)
+{
+    return StringRep::isInterned(_getRep(str));
+}
+
+Uint32 CIMNameInterner::getSize()
+{
+    AutoMutex lock(_internMutex);
+    return _internTable ? _internTable->size() : 0;
+}
+
+PEGASUS_NAMESPACE_END
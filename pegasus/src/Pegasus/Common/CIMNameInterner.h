@@ -0,0 +1,120 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#ifndef Pegasus_CIMNameInterner_h
+#define Pegasus_CIMNameInterner_h
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/Linkage.h>
+#include <Pegasus/Common/CIMNameCast.h>
+
+PEGASUS_NAMESPACE_BEGIN
+
+/**
+    CIMNameInterner maintains a process wide table of canonical class,
+    property and namespace names. Interning a name replaces its string
+    representation with the canonical one holding the same characters, so
+    that all interned copies of a name share a single representation.
+
+    The canonical representation caches the case-folded hash of the name.
+    HashLowerCaseFunc returns that hash without scanning the name, and
+    String::equalNoCase() (and hence CIMName::equal()) of two interned
+    copies of the same name reduces to a pointer comparison. Names are
+    interned with their case preserved; names differing only in case have
+    distinct representations and still compare equal through the
+    character comparison.
+
+    Interned representations are never released. The number and length of
+    the interned names are therefore bounded; names beyond the bounds are
+    left as they are, which costs only the fast paths.
+*/
+class PEGASUS_COMMON_LINKAGE CIMNameInterner
+{
+public:
+
+    /**
+        Replaces the representation of str with the canonical one, adding
+        str to the table if it is not yet interned.
+    */
+    static void intern(String& str);
+
+    static CIMName intern(const CIMName& name)
+    {
+        String str = name.getString();
+        intern(str);
+        return CIMNameCast(str);
+    }
+
+    static CIMNamespaceName intern(const CIMNamespaceName& nameSpace)
+    {
+        String str = nameSpace.getString();
+        intern(str);
+        return CIMNamespaceNameCast(str);
+    }
+
+    /**
+        Replaces the representation of str with the canonical one if str is
+        already interned.  Unlike intern(), it never adds str to the table,
+        so it may be used for names received from clients.  Returns true if
+        str is interned.
+    */
+    static Boolean lookup(String& str);
+
+    static CIMName lookup(const CIMName& name)
+    {
+        String str = name.getString();
+        lookup(str);
+        return CIMNameCast(str);
+    }
+
+    static CIMNamespaceName lookup(const CIMNamespaceName& nameSpace)
+    {
+        String str = nameSpace.getString();
+        lookup(str);
+        return CIMNamespaceNameCast(str);
+    }
+
+    /**
+        Returns true if str shares a canonical representation.
+    */
+    static Boolean isInterned(const String& str);
+
+    /**
+        Returns the number of names in the table.
+    */
+    static Uint32 getSize();
+};
+
+PEGASUS_NAMESPACE_END
+
+#endif /* Pegasus_CIMNameInterner_h */
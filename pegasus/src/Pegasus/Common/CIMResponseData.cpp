@@ -42,6 +42,7 @@
 #include <Pegasus/Common/SCMOXmlWriter.h>
 #include <Pegasus/Common/XmlReader.h>
 #include <Pegasus/Common/CIMInternalXmlEncoder.h>
+#include <Pegasus/Common/UTF8CString.h>
 #include <Pegasus/Common/SCMOInternalXmlEncoder.h>
 
 
@@ -574,6 +575,11 @@ Boolean CIMResponseData::hasBinaryData() const
 {
     return (RESP_ENC_BINARY == (_encoding & RESP_ENC_BINARY));
 }
+
+Boolean CIMResponseData::hasCIMData() const
+{
+    return (RESP_ENC_CIM == (_encoding & RESP_ENC_CIM));
+}
 // Sets the _size variable based on the internal size counts.
 void CIMResponseData::setSize()
 {
@@ -1042,12 +1048,12 @@ void CIMResponseData::completeHostNameAndNamespace(
     }
     if (RESP_ENC_SCMO == (_encoding & RESP_ENC_SCMO))
     {
-        CString hnCString=hn.getCString();
+        UTF8CString hnCString(hn);
         const char* hnChars = hnCString;
-        Uint32 hnLen = strlen(hnChars);
-        CString nsCString=ns.getString().getCString();
+        Uint32 hnLen = hnCString.size();
+        UTF8CString nsCString(ns.getString());
         const char* nsChars=nsCString;
-        Uint32 nsLen = strlen(nsChars);
+        Uint32 nsLen = nsCString.size();
         switch (_dataType)
         {
             // KS_PULL add Instances and InstNames to cover pull operations
@@ -2074,17 +2080,9 @@ void CIMResponseData::_resolveCIMToSCMO()
 {
     PEG_METHOD_ENTER(TRC_DISPATCHER,
         "CIMResponseData::_resolveCIMToSCMO");
-    CString nsCString=_defaultNamespace.getString().getCString();
+    UTF8CString nsCString(_defaultNamespace.getString());
     const char* _defNamespace = nsCString;
-    Uint32 _defNamespaceLen;
-    if (_defaultNamespace.isNull())
-    {
-        _defNamespaceLen=0;
-    }
-    else
-    {
-        _defNamespaceLen=strlen(_defNamespace);
-    }
+    Uint32 _defNamespaceLen = nsCString.size();
     switch (_dataType)
     {
         case RESP_INSTNAMES:
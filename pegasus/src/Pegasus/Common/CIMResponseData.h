@@ -164,6 +164,13 @@ public:
      */
     Boolean hasBinaryData() const;
 
+    /** Determine if there is any content held as C++ objects
+        (CIMInstance, CIMObject, CIMObjectPath) in the CIM
+        ResponseData object
+        @return Boolean true if C++ objects exist in content.
+     */
+    Boolean hasCIMData() const;
+
     ~CIMResponseData()
     { }
 
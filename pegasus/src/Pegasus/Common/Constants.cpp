@@ -89,6 +89,8 @@ const CIMName PEGASUS_CLASSNAME___NAMESPACE          =
 #ifndef PEGASUS_DISABLE_PERFINST
 const CIMName PEGASUS_CLASSNAME_CIMOMSTATDATA        =
     CIMNameCast("CIM_CIMOMStatisticalData");
+const CIMName PEGASUS_CLASSNAME_PG_CIMOMSTATLATENCYDATA =
+    CIMNameCast("PG_CIMOMStatisticalLatencyData");
 #endif
 
 #ifdef PEGASUS_ENABLE_CQL
@@ -227,6 +227,20 @@
 #define PEGASUS_PULL_OPERATION_MAX_OBJECT_COUNT 10000
 #define PEGASUS_PULL_OPERATION_MAX_OBJECT_COUNT_STRING "10000"
 
+//
+//  Runtime provider response chunking configuration defaults and limits.
+//  A chunk is sent when the estimated size of its objects reaches
+//  responseChunkMaxSize bytes or when its first object has been held for
+//  responseChunkMaxDelay milliseconds.  The delay is checked when the
+//  provider delivers an object.
+//
+#define PEGASUS_DEFAULT_RESPONSE_CHUNK_MAX_SIZE_STRING "262144"
+#define PEGASUS_RESPONSE_CHUNK_MAX_SIZE_LIMIT 67108864
+#define PEGASUS_RESPONSE_CHUNK_MAX_SIZE_LIMIT_STRING "67108864"
+#define PEGASUS_DEFAULT_RESPONSE_CHUNK_MAX_DELAY_MSEC_STRING "500"
+#define PEGASUS_RESPONSE_CHUNK_MAX_DELAY_MSEC_LIMIT 3600000
+#define PEGASUS_RESPONSE_CHUNK_MAX_DELAY_MSEC_LIMIT_STRING "3600000"
+
 //
 // Constants that are NOT part of runtime configuration
 //
@@ -636,6 +650,8 @@ PEGASUS_COMMON_LINKAGE extern const CIMName PEGASUS_CLASSNAME___NAMESPACE;
 
 #ifndef PEGASUS_DISABLE_PERFINST
 PEGASUS_COMMON_LINKAGE extern const CIMName PEGASUS_CLASSNAME_CIMOMSTATDATA;
+PEGASUS_COMMON_LINKAGE
+    extern const CIMName PEGASUS_CLASSNAME_PG_CIMOMSTATLATENCYDATA;
 #endif
 
 #ifdef PEGASUS_ENABLE_CQL
@@ -61,6 +61,8 @@ Uint32 HTTPAcceptor::_socketWriteTimeout =
 Mutex HTTPAcceptor::_socketWriteTimeoutMutex;
 #endif
 
+Boolean HTTPAcceptor::_kernelTLSEnabled = false;
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 // HTTPAcceptorRep
@@ -691,6 +693,11 @@ void HTTPAcceptor::setSocketWriteTimeout(Uint32 socketWriteTimeout)
     _socketWriteTimeout = socketWriteTimeout;
 }
 
+void HTTPAcceptor::setKernelTLSEnabled(Boolean enabled)
+{
+    _kernelTLSEnabled = enabled;
+}
+
 void HTTPAcceptor::unbind()
 {
     if (_rep)
@@ -913,6 +920,11 @@ void HTTPAcceptor::_acceptConnection()
         mp_socket->setSocketWriteTimeout(_socketWriteTimeout);
     }
 
+    if (_kernelTLSEnabled)
+    {
+        mp_socket->enableKernelTLS();
+    }
+
     // Perform the SSL handshake, if applicable.
 
     Sint32 socketAcceptStatus = mp_socket->accept();
@@ -132,6 +132,12 @@ public:
 
     static void setSocketWriteTimeout(Uint32 socketWriteTimeout);
 
+    /**
+        Enables kernel TLS offload for HTTPS connections accepted from now
+        on (config property enableKernelTLS).
+    */
+    static void setKernelTLSEnabled(Boolean enabled);
+
 private:
 
     void _acceptConnection();
@@ -152,6 +158,7 @@ private:
 #ifndef PEGASUS_INTEGERS_BOUNDARY_ALIGNED
     static Mutex _socketWriteTimeoutMutex;
 #endif
+    static Boolean _kernelTLSEnabled;
     HostAddress *_listenAddress;
 };
 
@@ -66,6 +66,32 @@ PEGASUS_NAMESPACE_BEGIN
 // buffer size for sending receiving
 static const Uint32 httpTcpBufferSize = 8192;
 
+// upper limit for the size of a single read of bulk request data
+static const Uint32 httpTcpMaxReadSize = 1024 * 1024;
+
+// upper limit for the number of requests of a connection that are processed
+// at the same time. Further pipelined requests wait in the pipelined buffer.
+static const Uint32 httpMaxPipelinedRequests = 16;
+
+// upper limit for the size of the pipelined requests waiting to be
+// processed. The connection is closed when a client sends more.
+static const Uint32 httpMaxPipelinedDataSize = 1024 * 1024;
+
+// size of the first piece of pipelined data moved to the incoming buffer
+// for a request; the piece doubles while the request is incomplete
+static const Uint32 httpPipelinedMoveSize = 1024;
+
+static inline void _addSendBuffer(
+    SocketWriteBuffer* sendBuffers,
+    Uint32& sendCount,
+    const char* data,
+    Uint32 size)
+{
+    sendBuffers[sendCount].data = data;
+    sendBuffers[sendCount].size = size;
+    sendCount++;
+}
+
 // string constants for HTTP header. "Name" represents strings on the left
 // side of headerNameTerminator and "Value" represents strings on the right
 // side of headerNameTerminator
@@ -172,11 +198,65 @@ static void _throwEventFailure(
     }                                                                         \
     while (0)
 
-static inline Uint32 _Min(Uint32 x, Uint32 y)
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// HTTPPendingResponse
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * A request forwarded on a server connection whose response has not been
+ * sent completely, with the state of writing that response.
+ */
+
+struct HTTPPendingResponse
 {
-    return x < y ? x : y;
-}
+    HTTPPendingResponse(Uint32 queueId_, Boolean chunkRequested_)
+        : queueId(queueId_),
+          chunkRequested(chunkRequested_),
+          messageIndex(0),
+          errorReceived(false),
+          internalError(false)
+    {
+    }
+
+    ~HTTPPendingResponse()
+    {
+        for (Uint32 i = 0; i < messages.size(); i++)
+        {
+            delete messages[i];
+        }
+    }
+
+    // The queue id the request was sent upwards with
+    Uint32 queueId;
 
+    // Whether the request asked for chunking or trailers
+    Boolean chunkRequested;
+
+    // Index of the last message of the response written
+    Uint32 messageIndex;
+
+    // Whether a message with an error has been received for the response
+    Boolean errorReceived;
+
+    // Whether handleInternalServerError() was called for the response
+    Boolean internalError;
+
+    // The first error of the response written
+    CIMException cimException;
+
+    // The content languages of the response written
+    ContentLanguageList contentLanguages;
+
+    // 2 digit prefix on the http header of the response if mpost was used
+    String mpostPrefix;
+
+    // Messages of the response held until the responses before it have
+    // been sent
+    Array<HTTPMessage*> messages;
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 //
@@ -247,7 +327,8 @@ HTTPConnection::HTTPConnection(
     _connectionClosePending(false),
     _acceptPending(false),
     _httpMethodNotChecked(true),
-    _internalError(false)
+    _internalError(false),
+    _responseWriteFailed(false)
 {
     PEG_METHOD_ENTER(TRC_HTTP, "HTTPConnection::HTTPConnection");
 
@@ -277,7 +358,9 @@ HTTPConnection::HTTPConnection(
 
     _responsePending = false;
     _connectionRequestCount = 0;
+    _pipelinedOffset = 0;
     _transferEncodingChunkOffset = 0;
+    _transferEncodingDataEnd = 0;
 
     PEG_TRACE((TRC_HTTP, Tracer::LEVEL3,
         "Connection IP address = %s",(const char*)_ipAddress.getCString()));
@@ -303,6 +386,11 @@ HTTPConnection::~HTTPConnection()
     AutoMutex connectionLock(_connection_mut);
     _socket->close();
 
+    while (_pendingResponses.size() != 0)
+    {
+        _removePendingResponse();
+    }
+
     PEG_METHOD_EXIT();
 }
 
@@ -328,6 +416,7 @@ Boolean HTTPConnection::isActive()
 
 
 void HTTPConnection::handleInternalServerError(
+    Uint32 queueId,
     Uint32 respMsgIndex,
     Boolean isComplete)
 {
@@ -335,19 +424,32 @@ void HTTPConnection::handleInternalServerError(
 
     PEG_TRACE((TRC_HTTP, Tracer::LEVEL1,
         "Internal server error. Connection queue id : %u, IP address :%s, "
-            "Response Index :%u, Response is Complete :%u.",
+            "Request queue id :%u, Response Index :%u, "
+            "Response is Complete :%u.",
         getQueueId(),
         (const char*)_ipAddress.getCString(),
+        queueId,
         respMsgIndex,
         isComplete));
 
-    _internalError = true;
+    {
+        AutoMutex connectionLock(_connection_mut);
+
+        // The error takes effect when the response is written, which for a
+        // pipelined request may be after the responses before it.
+        if (_pendingResponses.size() != 0)
+        {
+            _pendingResponses[_findPendingResponse(queueId)]->internalError =
+                true;
+        }
+    }
+
     Buffer buffer;
-    HTTPMessage message(buffer);
-    message.setIndex(respMsgIndex);
-    message.setComplete(isComplete);
-    AutoMutex connectionLock(_connection_mut);
-    _handleWriteEvent(message);
+    HTTPMessage* message = new HTTPMessage(buffer);
+    message->dest = queueId;
+    message->setIndex(respMsgIndex);
+    message->setComplete(isComplete);
+    handleEnqueue(message);
     PEG_METHOD_EXIT();
 }
 
@@ -380,10 +482,46 @@ void HTTPConnection::handleEnqueue(Message *message)
     // completely mutual exclusion of the monitor and HTTPConnection but this
     // does remove the chance of deadlock. Today we are not sure what the
     // effect would be of another way to handle the setState
-    AutoMutex monitorLock(_monitor->getLock());
+    //
+    // Intermediate chunks of a server response are the exception. Writing
+    // them never calls back to the monitor and the connection entry stays
+    // BUSY until the last chunk, so the monitor does not dispatch to this
+    // connection in the meantime. They are written holding only the
+    // connection lock so that a client that reads slowly blocks the
+    // provider thread producing its response (which is the backpressure
+    // that bounds the data buffered for the connection to one chunk)
+    // without also holding the monitor lock and stalling every other
+    // connection for up to socketWriteTimeout per write.
+    Boolean messageHeld;
+
+    if (message->getType() == HTTP_MESSAGE && !message->isComplete() &&
+        !_isClient())
+    {
+        AutoMutex connectionLock(_connection_mut);
+        messageHeld = _handleEnqueuedMessage(message);
+    }
+    else
+    {
+        AutoMutex monitorLock(_monitor->getLock());
+        AutoMutex connectionLock(_connection_mut);
+        messageHeld = _handleEnqueuedMessage(message);
+    }
 
-    AutoMutex connectionLock(_connection_mut);
+    if (!messageHeld)
+    {
+        delete message;
+    }
 
+    PEG_METHOD_EXIT();
+}
+
+/*
+ * Handle a message enqueued on the connection. Returns true if the message
+ * is held by the connection, which then deletes it once it has been sent.
+ */
+
+Boolean HTTPConnection::_handleEnqueuedMessage(Message* message)
+{
     switch (message->getType())
     {
         case SOCKET_MESSAGE:
@@ -416,7 +554,25 @@ void HTTPConnection::handleEnqueue(Message *message)
             }
 #endif
 
-            _handleWriteEvent(*httpMessage);
+            if (_isClient())
+            {
+                _handleWriteEvent(*httpMessage);
+                break;
+            }
+
+            Boolean isComplete = httpMessage->isComplete();
+
+            if (_handleResponseMessage(httpMessage))
+            {
+                return true;
+            }
+
+            // A complete response may allow pipelined requests waiting for
+            // their turn to be processed.
+            if (isComplete)
+            {
+                _handlePipelinedRequests();
+            }
             break;
         }
 
@@ -425,9 +581,77 @@ void HTTPConnection::handleEnqueue(Message *message)
             break;
     } // switch
 
-    delete message;
+    return false;
+}
+
+/*
+ * Route a message of a server response to the request it answers, which is
+ * identified by the queue id in the message's dest (messages without one
+ * belong to the first pending response). The messages of the first pending
+ * response are written as they arrive; those of later responses are held
+ * until the responses before them are complete, so that the client receives
+ * the responses in the order in which it sent the requests. Returns true if
+ * the message is held.
+ */
 
-    PEG_METHOD_EXIT();
+Boolean HTTPConnection::_handleResponseMessage(HTTPMessage* httpMessage)
+{
+    if (_pendingResponses.size() == 0)
+    {
+        PEG_TRACE((TRC_DISCARDED_DATA, Tracer::LEVEL1,
+            "HTTPConnection::_handleResponseMessage - Discarding a response "
+                "message for which no request is pending. "
+                "Connection queue id: %u, dest: %u",
+            getQueueId(),
+            httpMessage->dest));
+        return false;
+    }
+
+    Uint32 index = _findPendingResponse(httpMessage->dest);
+    HTTPPendingResponse* response = _pendingResponses[index];
+
+    if (httpMessage->cimException.getCode() != CIM_ERR_SUCCESS)
+    {
+        response->errorReceived = true;
+    }
+
+    if (index != 0)
+    {
+        PEG_TRACE((TRC_HTTP, Tracer::LEVEL4,
+            "HTTPConnection::_handleResponseMessage - Holding message %u of "
+                "the response to pipelined request %u of %u on connection "
+                "queue id: %u",
+            httpMessage->getIndex(),
+            index + 1,
+            _pendingResponses.size(),
+            getQueueId()));
+        response->messages.append(httpMessage);
+        return true;
+    }
+
+    if (response->internalError)
+    {
+        _internalError = true;
+    }
+    _handleWriteEvent(*httpMessage);
+
+    // Once a response is complete, write what has been received of the
+    // responses after it.
+    while (_pendingResponses.size() != 0 &&
+        _pendingResponses[0]->messages.size() != 0)
+    {
+        response = _pendingResponses[0];
+        AutoPtr<HTTPMessage> heldMessage(response->messages[0]);
+        response->messages.remove(0);
+
+        if (response->internalError)
+        {
+            _internalError = true;
+        }
+        _handleWriteEvent(*heldMessage);
+    }
+
+    return false;
 }
 
 /*
@@ -505,57 +729,72 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
 
         Uint32 bytesRemaining = messageLength;
         char *messageStart = (char *) buffer.getData();
-        Uint32 bytesToWrite = httpTcpBufferSize;
+        // length of the header sent ahead of the first chunk
+        Uint32 chunkHeaderLength = 0;
         Uint32 messageIndex = httpMessage.getIndex();
         Boolean isChunkResponse = false;
         Boolean isChunkRequest = false;
         Boolean isFirstException = false;
 
+        // The response being written on the server
+        HTTPPendingResponse* response =
+            _isClient() ? 0 : _pendingResponses[0];
+
         if (_isClient() == false)
         {
             if (isFirst == true)
             {
                 _outgoingBuffer.clear();
-                // tracks the message coming from above
-                _transferEncodingChunkOffset = 0;
-                _mpostPrefix.clear();
-                cimException = CIMException();
+                // A response that starts after the connection was closed by
+                // the response before it is not sent.
+                _responseWriteFailed = _connectionClosePending;
             }
             else
             {
                 // this is coming from our own internal code, therefore it is an
                 // internal error. somehow the chunks came out of order.
-                if (_transferEncodingChunkOffset+1 != messageIndex)
+                // (the message index tracks the message coming from above)
+                if (response->messageIndex+1 != messageIndex)
                     _throwEventFailure(
                         httpStatusInternal, "chunk sequence mismatch");
-                _transferEncodingChunkOffset++;
+                response->messageIndex++;
             }
 
             // If there is an internal error on this connection, just return
             // from here if the current message is not the last message because
             // this connection will be closed once all messages are received.
+            // The responses to requests pipelined behind are discarded.
             if (_internalError)
             {
                 if (isLast)
                 {
-                    _responsePending = false;
+                    _removePendingResponse();
+                    if (!_connectionClosePending)
+                    {
+                        Logger::put_l(
+                            Logger::ERROR_LOG,
+                            System::CIMSERVER,
+                            Logger::SEVERE,
+                            MessageLoaderParms(
+                                INTERNAL_SERVER_ERROR_CONNECTION_CLOSED_KEY,
+                                INTERNAL_SERVER_ERROR_CONNECTION_CLOSED,
+                                _ipAddress));
+                    }
                     _closeConnection();
-                    Logger::put_l(
-                        Logger::ERROR_LOG,
-                        System::CIMSERVER,
-                        Logger::SEVERE,
-                        MessageLoaderParms(
-                            INTERNAL_SERVER_ERROR_CONNECTION_CLOSED_KEY,
-                            INTERNAL_SERVER_ERROR_CONNECTION_CLOSED,
-                            _ipAddress));
                 }
 
                 // Cleanup Authentication Handle
                 // currently only PAM implemented, see Bug#9642
-                _authInfo->getAuthHandle().destroy();
+                if (!_responsePending)
+                {
+                    _authInfo->getAuthHandle().destroy();
+                }
                 return true;
             }
 
+            CIMException& cimException = response->cimException;
+            ContentLanguageList& contentLanguages = response->contentLanguages;
+
             // save the first error
             if (httpMessage.cimException.getCode() != CIM_ERR_SUCCESS)
             {
@@ -581,7 +820,7 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
             // trailers are tightly integrated with chunking, so it can also
             // be used.
 
-            if (isChunkRequested() == true)
+            if (response->chunkRequested)
             {
                 isChunkRequest = true;
             }
@@ -878,7 +1117,7 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
                             headerNameTransferEncoding,
                             headerNameTerminator,
                             headerValueTransferEncodingChunked);
-                        bytesToWrite = messageLength - contentLength;
+                        chunkHeaderLength = messageLength - contentLength;
 
                         contentLengthStart[contentLengthLineLengthExpected] =
                             save;
@@ -886,7 +1125,7 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
                         HTTPMessage::lookupHeaderPrefix(
                             headers,
                             headerNameOperation,
-                            _mpostPrefix);
+                            response->mpostPrefix);
                     } // else chunk response is true
 
                 } // if content length was found
@@ -900,7 +1139,6 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
                 if (isChunkRequest == true && messageIndex > 0)
                 {
                     isChunkResponse = true;
-                    bytesToWrite = messageLength;
                 }
             }
 
@@ -909,6 +1147,16 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
             if (isChunkRequest == false)
                 _outgoingBuffer.swap(buffer);
 
+            // An earlier chunk of this response could not be written because
+            // the client stopped reading and socketWriteTimeout expired. The
+            // response the client receives is already truncated, so discard
+            // the rest of it instead of holding the provider thread that
+            // produces it in another timed write for every chunk.
+            if (_responseWriteFailed)
+            {
+                bytesRemaining = 0;
+            }
+
         } // if not a client
 
         PEG_TRACE_CSTRING(TRC_HTTP,Tracer::LEVEL4,
@@ -924,124 +1172,64 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
 
         SignalHandler::ignore(PEGASUS_SIGPIPE);
 
-        const char *sendStart = messageStart;
-        Sint32 bytesWritten = 0;
+        // The pieces of this write (header, trailer header, chunk framing,
+        // body and chunk trailer) are collected here and sent with a single
+        // gather write rather than one socket write per piece.
+        SocketWriteBuffer sendBuffers[6];
+        Uint32 sendCount = 0;
+        Buffer trailerHeader;
 
-        if (isFirst == true && isChunkResponse == true && bytesToWrite > 0)
+        if (isFirst == true && isChunkResponse == true &&
+            chunkHeaderLength > 0)
         {
             // send the header first for chunked reponses.
 
             // dont include header terminator yet
-            Uint32 headerLength = bytesToWrite;
-            bytesToWrite -= headerLineTerminatorLength;
-            PEG_TRACE_CSTRING(TRC_HTTP, Tracer::LEVEL4,
-                "HTTPConnection::_handleWriteEvent: "
-                    "Sending header for chunked reponses.");
-
-            bytesWritten = _socket->write(sendStart, bytesToWrite);
-            if (bytesWritten < 0)
-                _socketWriteError();
-            totalBytesWritten += bytesWritten;
-            bytesRemaining -= bytesWritten;
+            Uint32 headerLength = chunkHeaderLength;
+            _addSendBuffer(sendBuffers, sendCount,
+                messageStart, headerLength - headerLineTerminatorLength);
 
             // put in trailer header.
-            Buffer trailer;
-            trailer << headerNameTrailer << headerNameTerminator <<
-                _mpostPrefix << headerNameCode <<    headerValueSeparator <<
-                _mpostPrefix << headerNameDescription << headerValueSeparator <<
+            const String& mpostPrefix = response->mpostPrefix;
+            trailerHeader << headerNameTrailer << headerNameTerminator <<
+                mpostPrefix << headerNameCode <<    headerValueSeparator <<
+                mpostPrefix << headerNameDescription << headerValueSeparator <<
                 headerNameContentLanguage << headerLineTerminator;
-
-            sendStart = trailer.getData();
-            bytesToWrite = trailer.size();
-
-            PEG_TRACE_CSTRING(TRC_HTTP, Tracer::LEVEL4,
-                "HTTPConnection::_handleWriteEvent: "
-                    "Sending trailer header for chunked responses.");
-
-            bytesWritten = _socket->write(sendStart, bytesToWrite);
-
-            if (bytesWritten < 0)
-                _socketWriteError();
-            totalBytesWritten += bytesWritten;
-            // the trailer is outside the header buffer, so dont include in
-            // tracking variables
+            _addSendBuffer(sendBuffers, sendCount,
+                trailerHeader.getData(), trailerHeader.size());
 
             // now send header terminator
-            bytesToWrite = headerLineTerminatorLength;
-            sendStart = messageStart + headerLength - bytesToWrite;
-
-            PEG_TRACE_CSTRING(TRC_HTTP, Tracer::LEVEL4,
-                "HTTPConnection::_handleWriteEvent: "
-                    "Sending header terminator for chunked responses.");
-
-            bytesWritten = _socket->write(sendStart, bytesToWrite);
-            if (bytesWritten < 0)
-                _socketWriteError();
-            totalBytesWritten += bytesWritten;
-            bytesRemaining -= bytesWritten;
+            _addSendBuffer(sendBuffers, sendCount,
+                messageStart + headerLength - headerLineTerminatorLength,
+                headerLineTerminatorLength);
 
+            bytesRemaining -= headerLength;
             messageStart += headerLength;
             messageLength -= headerLength;
-            sendStart = messageStart;
-            bytesWritten = 0;
-            bytesToWrite = bytesRemaining;
         } // if first chunk of chunked response
 
         // room enough for hex string representing chunk length and terminator
         char chunkLine[sizeof(Uint32)*2 + chunkLineTerminatorLength+1];
+        Buffer trailer;
 
-        for (; bytesRemaining > 0; )
+        if (bytesRemaining > 0)
         {
             if (isChunkResponse == true)
             {
                 // send chunk line containing hex string and chunk line
                 // terminator
-                sprintf(chunkLine, "%x%s", bytesToWrite, chunkLineTerminator);
-                sendStart = chunkLine;
-                Sint32 chunkBytesToWrite = (Sint32)strlen(sendStart);
-
-                PEG_TRACE_CSTRING(TRC_HTTP, Tracer::LEVEL4,
-                    "HTTPConnection::_handleWriteEvent: "
-                        "Sending chunk with chunk line terminator.");
-
-                bytesWritten = _socket->write(sendStart, chunkBytesToWrite);
-                if (bytesWritten < 0)
-                    _socketWriteError();
-                totalBytesWritten += bytesWritten;
+                sprintf(chunkLine, "%x%s", bytesRemaining, chunkLineTerminator);
+                _addSendBuffer(sendBuffers, sendCount,
+                    chunkLine, (Uint32)strlen(chunkLine));
             }
 
-            // for chunking, we will send the entire chunk data in one send, but
-            // for non-chunking, we will send incrementally
-            else bytesToWrite = _Min(bytesRemaining, bytesToWrite);
-
-            // send non-chunked data
-            //
-            // Socket writes larger than 64K cause some platforms to return
-            //  errors. When the socket write can't send the full buffer at
-            //  one time, subtract the bytes sent and loop until the whole
-            //  buffer has gone.  Use httpTcpBufferSize for maximum send size.
-            //
-            for (; bytesRemaining > 0; )
-            {
-              sendStart = messageStart + messageLength - bytesRemaining;
-              bytesToWrite = _Min(httpTcpBufferSize, bytesRemaining);
-
-              PEG_TRACE_CSTRING(TRC_HTTP, Tracer::LEVEL4,
-                  "HTTPConnection::_handleWriteEvent: "
-                      "Sending non-chunked data.");
-
-              bytesWritten = _socket->write(sendStart, bytesToWrite);
-              if (bytesWritten < 0)
-                  _socketWriteError();
-              totalBytesWritten += bytesWritten;
-              bytesRemaining -= bytesWritten;
-            }
+            _addSendBuffer(sendBuffers, sendCount,
+                messageStart + messageLength - bytesRemaining, bytesRemaining);
 
             if (isChunkResponse == true)
             {
                 // send chunk terminator, on the last chunk, it is the chunk
                 // body terminator
-                Buffer trailer;
                 Boolean traceTrailer = false;
                 trailer << chunkLineTerminator;
 
@@ -1051,10 +1239,9 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
 
                 if (isLast == true)
                 {
-                    if (bytesRemaining > 0)
-                        _throwEventFailure(httpStatusInternal,
-                            "more bytes after indicated last chunk");
                     trailer << "0" << chunkLineTerminator;
+                    const String& mpostPrefix = response->mpostPrefix;
+                    const CIMException& cimException = response->cimException;
                     Uint32 httpStatus = cimException.getCode();
 
                     if (httpStatus != 0)
@@ -1063,25 +1250,25 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
                         sprintf(httpStatusP, "%u",httpStatus);
 
                         traceTrailer = true;
-                        trailer << _mpostPrefix << headerNameCode <<
+                        trailer << mpostPrefix << headerNameCode <<
                             headerNameTerminator << httpStatusP <<
                             headerLineTerminator;
                         const String& httpDescription =
                             cimException.getMessage();
                         if (httpDescription.size() != 0)
-                            trailer << _mpostPrefix << headerNameDescription <<
+                            trailer << mpostPrefix << headerNameDescription <<
                                 headerNameTerminator << httpDescription <<
                                 headerLineTerminator;
                     }
 
                     // Add Content-Language to the trailer if requested
-                    if (contentLanguages.size() != 0)
+                    if (response->contentLanguages.size() != 0)
                     {
                         traceTrailer = true;
-                        trailer << _mpostPrefix
+                        trailer << mpostPrefix
                             << headerNameContentLanguage << headerNameTerminator
                             << LanguageParser::buildContentLanguageHeader(
-                                   contentLanguages)
+                                   response->contentLanguages)
                             << headerLineTerminator;
                     }
 
@@ -1098,20 +1285,28 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
                             trailer,
                             httpMessage.binaryResponse).get()));
                 }
-                sendStart = trailer.getData();
-                Sint32 chunkBytesToWrite = (Sint32) trailer.size();
+                _addSendBuffer(sendBuffers, sendCount,
+                    trailer.getData(), trailer.size());
+            } // isChunkResponse == true
 
-                PEG_TRACE_CSTRING(TRC_HTTP, Tracer::LEVEL4,
-                    "HTTPConnection::_handleWriteEvent: "
-                        "Sending the last chunk with chunk body terminator");
+            bytesRemaining = 0;
+        }
 
-                bytesWritten = _socket->write(sendStart, chunkBytesToWrite);
-                if (bytesWritten < 0)
-                    _socketWriteError();
-                totalBytesWritten += bytesWritten;
-            } // isChunkResponse == true
+        // The message goes to the socket as a whole; the socket layer
+        // splits it into writes of at most PEGASUS_SOCKET_MAX_WRITE_SIZE.
+        if (sendCount > 0)
+        {
+            PEG_TRACE((TRC_HTTP, Tracer::LEVEL4,
+                "HTTPConnection::_handleWriteEvent: "
+                    "Sending %u buffers%s.",
+                sendCount,
+                isChunkResponse ? " of chunked response" : ""));
 
-        } // for all bytes in message
+            Sint32 bytesWritten = _socket->writev(sendBuffers, sendCount);
+            if (bytesWritten < 0)
+                _socketWriteError();
+            totalBytesWritten += bytesWritten;
+        }
 
     } // try
 
@@ -1120,6 +1315,7 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
         // On the server side, the socket write error is suppressed
         // and not handled as an internal error.
         httpStatusString = e.getMessage();
+        _responseWriteFailed = true;
     }
     catch (Exception &e)
     {
@@ -1148,18 +1344,19 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
     if (isLast == true)
     {
         _outgoingBuffer.clear();
-        _transferEncodingTEValues.clear();
-
-        // Reset the transfer encoding chunk offset. If it is not reset here,
-        // then a request sent with chunked encoding may not be properly read
-        // off of a connection in which a chunked response has been sent.
-        _transferEncodingChunkOffset = 0;
 
         //
         // decrement request count
         //
 
-        _responsePending = false;
+        if (_isClient())
+        {
+            _responsePending = false;
+        }
+        else
+        {
+            _removePendingResponse();
+        }
 
         if (httpStatusString.size() == 0)
         {
@@ -1178,9 +1375,12 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
         //
         if (_isClient() == false)
         {
-            // Cleanup Authentication Handle
+            // Cleanup Authentication Handle once no request is processed
             // currently only PAM implemented, see Bug#9642
-            _authInfo->getAuthHandle().destroy();
+            if (!_responsePending)
+            {
+                _authInfo->getAuthHandle().destroy();
+            }
 
             if (_internalError)
             {
@@ -1194,6 +1394,15 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
                         INTERNAL_SERVER_ERROR_CONNECTION_CLOSED,
                         _ipAddress));
             }
+            // A partially written response leaves the connection unusable
+            else if (_responseWriteFailed)
+            {
+                PEG_TRACE((TRC_HTTP, Tracer::LEVEL2,
+                    "HTTPConnection::_handleWriteEvent: Closing connection "
+                        "after failing to write response to %s.",
+                    (const char*)_ipAddress.getCString()));
+                _closeConnection();
+            }
             // Check for message to close
             else if (httpMessage.getCloseConnect())
             {
@@ -1202,7 +1411,9 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
                         "in client message."));
                 _closeConnection();
             }
-            else
+            // The connection stays busy while responses to pipelined
+            // requests are pending
+            else if (!_responsePending)
             {
                 // Update connection idle time.
                 if (getIdleConnectionTimeout())
@@ -1214,7 +1425,7 @@ Boolean HTTPConnection::_handleWriteEvent(HTTPMessage& httpMessage)
                 _monitor->setState(_entry_index, MonitorEntry::STATUS_IDLE);
                 _monitor->tickle();
             }
-            cimException = CIMException();
+            _responseWriteFailed = false;
         }
     }
 
@@ -1363,7 +1574,9 @@ void HTTPConnection::_getContentLengthAndContentOffset()
                         _contentOffset + 1);
                     _incomingBuffer.reserveCapacity(capacity);
                     data = (char *)_incomingBuffer.getData();
-                    data[capacity-1] = 0;
+                    // Do not overwrite a pipelined request read with it
+                    if (size < capacity)
+                        data[capacity-1] = 0;
                 }
                 catch (const PEGASUS_STD(bad_alloc)&)
                 {
@@ -1570,6 +1783,9 @@ void HTTPConnection::_clearIncoming()
     _contentOffset = -1;
     _contentLength = -1;
     _incomingBuffer.clear();
+    _transferEncodingChunkOffset = 0;
+    _transferEncodingValues.clear();
+    _transferEncodingTEValues.clear();
     _mpostPrefix.clear();
     contentLanguages.clear();
 }
@@ -1619,14 +1835,80 @@ void HTTPConnection::_closeConnection()
     PEG_METHOD_EXIT();
 }
 
-Boolean HTTPConnection::isChunkRequested()
+Boolean HTTPConnection::isChunkRequested(Uint32 queueId)
 {
-    Boolean answer = false;
-    if (_transferEncodingTEValues.size() > 0 &&
+    AutoMutex connectionLock(_connection_mut);
+
+    return _pendingResponses.size() != 0 &&
+        _pendingResponses[_findPendingResponse(queueId)]->chunkRequested;
+}
+
+Boolean HTTPConnection::hasResponseError(Uint32 queueId)
+{
+    AutoMutex connectionLock(_connection_mut);
+
+    return _pendingResponses.size() != 0 &&
+        _pendingResponses[_findPendingResponse(queueId)]->errorReceived;
+}
+
+/*
+ * Add a response to the pending responses of a server connection for the
+ * request that is being forwarded and return the queue id the request is
+ * sent upwards with. The first pending response uses the queue id of the
+ * connection; responses to requests pipelined behind it get a queue id
+ * alias, so that their messages can be told apart by their dest.
+ */
+
+Uint32 HTTPConnection::_addPendingResponse()
+{
+    // check to see if the client requested chunking OR trailers.
+    Boolean chunkRequested = _transferEncodingTEValues.size() > 0 &&
         (Contains(_transferEncodingTEValues, String(headerValueTEchunked)) ||
-         Contains(_transferEncodingTEValues, String(headerValueTEtrailers))))
-        answer = true;
-    return answer;
+         Contains(_transferEncodingTEValues, String(headerValueTEtrailers)));
+
+    Uint32 queueId =
+        _pendingResponses.size() == 0 ? getQueueId() : addQueueIdAlias();
+
+    _pendingResponses.append(new HTTPPendingResponse(queueId, chunkRequested));
+    _responsePending = true;
+
+    return queueId;
+}
+
+/*
+ * Return the index of the pending response to the request with the given
+ * queue id. Messages without a matching queue id belong to the first one.
+ */
+
+Uint32 HTTPConnection::_findPendingResponse(Uint32 queueId)
+{
+    for (Uint32 i = 1; i < _pendingResponses.size(); i++)
+    {
+        if (_pendingResponses[i]->queueId == queueId)
+        {
+            return i;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Remove the first pending response, once it has been sent.
+ */
+
+void HTTPConnection::_removePendingResponse()
+{
+    HTTPPendingResponse* response = _pendingResponses[0];
+    _pendingResponses.remove(0);
+
+    if (response->queueId != getQueueId())
+    {
+        removeQueueIdAlias(response->queueId);
+    }
+    delete response;
+
+    _responsePending = _pendingResponses.size() != 0;
 }
 
 void HTTPConnection::setSocketWriteTimeout(Uint32 socketWriteTimeout)
@@ -1681,7 +1963,10 @@ void HTTPConnection::_handleReadEventTransferEncoding()
     // offset
 
     if (_transferEncodingChunkOffset == 0)
+    {
         _transferEncodingChunkOffset = (Uint32) _contentOffset;
+        _transferEncodingDataEnd = (Uint32) _contentOffset;
+    }
 
     char *headerStart = (char *) _incomingBuffer.getData();
     char *messageStart = headerStart;
@@ -1788,24 +2073,63 @@ void HTTPConnection::_handleReadEventTransferEncoding()
         if (chunkLengthParsed + chunkMetaLength > remainderLength)
             break;
 
+        // On the server, the data after the last chunk may include a request
+        // the client has pipelined behind this one. The message ends with
+        // the empty line that terminates the optional trailer, so wait until
+        // it has been read and keep whatever follows it for later.
+        if (chunkLengthParsed == 0 && !_isClient())
+        {
+            char* messageEnd = chunkLineEnd;
+
+            if (strncmp(messageEnd, chunkBodyTerminator,
+                    chunkBodyTerminatorLength) == 0)
+            {
+                messageEnd += chunkBodyTerminatorLength;
+            }
+            else
+            {
+                messageEnd = strstr(messageEnd, CRLF CRLF);
+
+                if (!messageEnd)
+                    break;
+
+                messageEnd += trailerTerminatorLength +
+                    chunkBodyTerminatorLength;
+            }
+
+            _savePipelinedData((Uint32)(messageEnd - messageStart));
+            messageLength = _incomingBuffer.size();
+            remainderLength = messageLength - _transferEncodingChunkOffset;
+        }
+
         // at this point we have a complete chunk. proceed and strip out
         // meta-data
         // NOTE: any time "remove" is called on the buffer, many variables
         // must be recomputed to reflect the data removed.
 
-        // remove the chunk length line
-        _incomingBuffer.remove(_transferEncodingChunkOffset, chunkLineLength);
-        messageLength = _incomingBuffer.size();
-        // always keep the byte after the last data byte null for easy string
-        // processing.
-        messageStart[messageLength] = 0;
-
-        // recalculate since we just removed the chunk length line
-        chunkTerminatorOffset -= chunkLineLength;
-
         // is this the last chunk ?
         if (chunkLengthParsed == 0)
         {
+            // Close the gap the meta data of the previous chunks left between
+            // the de-chunked data and this chunk. Only the rest of the message
+            // is moved by this.
+            Uint32 gapLength =
+                _transferEncodingChunkOffset - _transferEncodingDataEnd;
+
+            if (gapLength)
+            {
+                _incomingBuffer.remove(_transferEncodingDataEnd, gapLength);
+                _transferEncodingChunkOffset = _transferEncodingDataEnd;
+            }
+
+            // remove the chunk length line
+            _incomingBuffer.remove(
+                _transferEncodingChunkOffset, chunkLineLength);
+            messageLength = _incomingBuffer.size();
+            // always keep the byte after the last data byte null for easy
+            // string processing.
+            messageStart[messageLength] = 0;
+
             // We are at the last chunk. The only remaining data should be:
             // 1. optional trailer first
             // 2. message terminator (will remain on incoming buffer and
@@ -2010,14 +2334,21 @@ void HTTPConnection::_handleReadEventTransferEncoding()
                 chunkTerminatorLength) != 0)
             _throwEventFailure(HTTP_STATUS_BADREQUEST, "Bad chunk terminator");
 
-        // now remove the chunk terminator
-        _incomingBuffer.remove(chunkTerminatorOffset, chunkTerminatorLength);
-        messageLength = _incomingBuffer.size();
-        messageStart[messageLength] = 0;
+        // Move the chunk data down to the end of the data de-chunked so far
+        // rather than removing the chunk line and terminator from the buffer.
+        // Each data byte is moved once, instead of every time meta data in
+        // front of it is removed, which is quadratic in the number of chunks
+        // read together for a large request.
+        // The chunk line always lies in between, so the data always moves.
+        char* chunkDataStart = chunkLineStart + chunkLineLength;
+        memmove(messageStart + _transferEncodingDataEnd,
+            chunkDataStart, chunkLengthParsed);
+        _transferEncodingDataEnd += chunkLengthParsed;
 
         // jump to the start of the next chunk (which may not have been
         // read yet)
-        _transferEncodingChunkOffset = chunkTerminatorOffset;
+        _transferEncodingChunkOffset =
+            chunkTerminatorOffset + chunkTerminatorLength;
     } // for all remaining bytes containing chunks
 
     PEG_METHOD_EXIT();
@@ -2027,12 +2358,14 @@ void HTTPConnection::_handleReadEventTransferEncoding()
  * Handle a failure on the read or an HTTP error. This is NOT meant for
  * errors found in the cim response or the trailer.
  * The http status MAY have the detailed message attached to it using the
- * detail delimiter.
+ * detail delimiter. On the server, queueId identifies the request that
+ * failed if it was already forwarded.
  */
 
 void HTTPConnection::_handleReadEventFailure(
     const String& httpStatusWithDetail,
-    const String& cimError)
+    const String& cimError,
+    Uint32 queueId)
 {
     Uint32 delimiterFound = httpStatusWithDetail.find(httpDetailDelimiter);
     String httpDetail;
@@ -2051,6 +2384,11 @@ void HTTPConnection::_handleReadEventFailure(
         (const char*)httpDetailDelimiter.getCString(),
         (const char*)cimError.getCString()));
 
+    // The connection is closed after the error, so requests pipelined
+    // behind the failed one are not processed.
+    _pipelinedBuffer.clear();
+    _pipelinedOffset = 0;
+
     Buffer message;
     message = XmlWriter::formatHttpErrorRspMessage(httpStatus, cimError,
         httpDetail);
@@ -2069,17 +2407,28 @@ void HTTPConnection::_handleReadEventFailure(
         _outputMessageQueue->enqueue(httpMessage);
 
         _clearIncoming();
+        _closeConnection();
     }
     else
     {
-        // else server side processing error - send back to client
+        // else server side processing error - send back to client. The
+        // error response follows the responses to the requests before the
+        // failed one and the connection is closed once it has been sent.
+        if (queueId == 0 || _pendingResponses.size() == 0 ||
+            _pendingResponses[_findPendingResponse(queueId)]->queueId !=
+                queueId)
+        {
+            queueId = _addPendingResponse();
+        }
+
         PEG_TRACE((TRC_XML_IO, Tracer::LEVEL2,
             "<!-- Error response: queue id: %u -->\n%s",
-            getQueueId(),
+            queueId,
             httpMessage->message.getData()));
+        httpMessage->dest = queueId;
+        httpMessage->setCloseConnect(true);
         handleEnqueue(httpMessage);
     }
-    _closeConnection();
 }
 
 void HTTPConnection::_handleReadEvent()
@@ -2144,12 +2493,36 @@ void HTTPConnection::_handleReadEvent()
 
     Sint32 bytesRead = 0;
     Boolean incompleteSecureReadOccurred = false;
+    Uint32 readSize = httpTcpBufferSize;
 
     for (;;)
     {
-        char buffer[httpTcpBufferSize];
+        // Read directly into the free capacity at the end of the incoming
+        // buffer, keeping one byte for the null terminator that getData()
+        // adds. The space reserved for a body of known length is filled by
+        // as few reads as the socket allows, and the read size doubles while
+        // reads keep filling it, so that bulk request data is not copied
+        // through an intermediate buffer in small pieces.
+        Uint32 size = _incomingBuffer.size();
 
-        Sint32 n = _socket->read(buffer, sizeof(buffer)-1);
+        try
+        {
+            _incomingBuffer.reserveCapacity(size + readSize + 1);
+        }
+        catch (...)
+        {
+            static const char detailP[] =
+                "Unable to append the request to the input buffer";
+            String httpStatus =
+                HTTP_STATUS_REQUEST_TOO_LARGE + httpDetailDelimiter + detailP;
+            _handleReadEventFailure(httpStatus);
+            PEG_METHOD_EXIT();
+            return;
+        }
+
+        Uint32 available = _incomingBuffer.capacity() - size - 1;
+        Sint32 n = _socket->read(
+            _incomingBuffer.getContentPtr() + size, available);
 
         if (n <= 0)
         {
@@ -2171,23 +2544,13 @@ void HTTPConnection::_handleReadEvent()
             break;
         }
 
-        try
+        _incomingBuffer.appendReserved(n);
+        bytesRead += n;
+
+        if (Uint32(n) == available && readSize < httpTcpMaxReadSize)
         {
-            _incomingBuffer.reserveCapacity(_incomingBuffer.size() + n);
-            _incomingBuffer.append(buffer, n);
+            readSize *= 2;
         }
-        catch (...)
-        {
-            static const char detailP[] =
-                "Unable to append the request to the input buffer";
-            String httpStatus =
-                HTTP_STATUS_REQUEST_TOO_LARGE + httpDetailDelimiter + detailP;
-            _handleReadEventFailure(httpStatus);
-            PEG_METHOD_EXIT();
-            return;
-        }
-
-        bytesRead += n;
 
         // Check if this was the first read of a connection to the server.
         // This has to happen inside the read loop, because there can be
@@ -2226,7 +2589,7 @@ void HTTPConnection::_handleReadEvent()
         }
 
 #if defined (PEGASUS_OS_VMS)
-        if (n < sizeof(buffer))
+        if (Uint32(n) < available)
         {
             //
             // Read is smaller than the buffer size.
@@ -2241,6 +2604,27 @@ void HTTPConnection::_handleReadEvent()
         "Total bytesRead = %d; Bytes read this iteration = %d",
         _incomingBuffer.size(), bytesRead));
 
+    _handleIncomingData(bytesRead == 0 && !incompleteSecureReadOccurred);
+
+    if (!_isClient())
+    {
+        _handlePipelinedRequests();
+    }
+
+    PEG_METHOD_EXIT();
+}
+
+/*
+ * Process the data in the incoming buffer. If it holds a complete message,
+ * the message is forwarded to the output message queue. endOfData indicates
+ * that the peer has closed the connection, which ends a message that has no
+ * content length.
+ */
+
+void HTTPConnection::_handleIncomingData(Boolean endOfData)
+{
+    PEG_METHOD_ENTER(TRC_HTTP, "HTTPConnection::_handleIncomingData");
+
     try
     {
         if (_contentOffset == -1)
@@ -2259,10 +2643,17 @@ void HTTPConnection::_handleReadEvent()
     // -- HTTP header and then there are those messages which have no bodies
     // -- at all).
 
-    if ((bytesRead == 0 && !incompleteSecureReadOccurred) ||
+    if (endOfData ||
         (_contentLength != -1 && _contentOffset != -1 &&
         (Sint32(_incomingBuffer.size()) >= _contentLength + _contentOffset)))
     {
+        // Anything read beyond the end of the message is the start of a
+        // request the client has pipelined behind this one.
+        if (!_isClient() && _contentLength != -1 && _contentOffset != -1)
+        {
+            _savePipelinedData(Uint32(_contentLength + _contentOffset));
+        }
+
         // If no message was received, just close the connection
         if (_incomingBuffer.size() == 0)
         {
@@ -2329,12 +2720,17 @@ void HTTPConnection::_handleReadEvent()
         //
         if (_isClient() == false)
         {
+            // The response to the request is sent to its own queue id
+            message->queueId = _addPendingResponse();
+
             PEG_TRACE((TRC_HTTP, Tracer::LEVEL4,
                 "Now setting state to %d", MonitorEntry::STATUS_BUSY));
             _monitor->setState(_entry_index, MonitorEntry::STATUS_BUSY);
             _monitor->tickle();
         }
 
+        Uint32 queueId = message->queueId;
+
         try
         {
             _outputMessageQueue->enqueue(message);
@@ -2344,19 +2740,19 @@ void HTTPConnection::_handleReadEvent()
             String httpStatus(HTTP_STATUS_REQUEST_TOO_LARGE);
             httpStatus.append(httpDetailDelimiter);
             httpStatus.append(e.getMessage());
-            _handleReadEventFailure(httpStatus);
+            _handleReadEventFailure(httpStatus, String(), queueId);
         }
         catch (Exception& e)
         {
             String httpStatus =
                 HTTP_STATUS_BADREQUEST + httpDetailDelimiter + e.getMessage();
-            _handleReadEventFailure(httpStatus);
+            _handleReadEventFailure(httpStatus, String(), queueId);
         }
         catch (const exception& e)
         {
             String httpStatus =
                 HTTP_STATUS_BADREQUEST + httpDetailDelimiter + e.what();
-            _handleReadEventFailure(httpStatus);
+            _handleReadEventFailure(httpStatus, String(), queueId);
         }
         catch (...)
         {
@@ -2367,7 +2763,7 @@ void HTTPConnection::_handleReadEvent()
             String mlString(MessageLoader::getMessage(mlParms));
             String httpStatus =
                 HTTP_STATUS_BADREQUEST + httpDetailDelimiter + mlString;
-            _handleReadEventFailure(httpStatus);
+            _handleReadEventFailure(httpStatus, String(), queueId);
         }
 
         _clearIncoming();
@@ -2375,6 +2771,121 @@ void HTTPConnection::_handleReadEvent()
     PEG_METHOD_EXIT();
 }
 
+/*
+ * Move the bytes that follow the current message in the incoming buffer to
+ * the pipelined request buffer. HTTP/1.1 clients may send further requests
+ * without waiting for the response to the previous one, so a single read can
+ * return the end of one request together with the start of the next.
+ */
+
+void HTTPConnection::_savePipelinedData(Uint32 messageLength)
+{
+    Uint32 size = _incomingBuffer.size();
+
+    if (size > messageLength)
+    {
+        PEG_TRACE((TRC_HTTP, Tracer::LEVEL4,
+            "HTTPConnection: %u bytes of a pipelined request received on "
+                "connection queue id: %u",
+            size - messageLength,
+            getQueueId()));
+
+        // If the message was completed with data moved from the pipelined
+        // buffer, the bytes beyond it are still there: the socket is not
+        // read until all pipelined data has been moved.
+        if (_pipelinedBuffer.size() != 0)
+        {
+            PEGASUS_ASSERT(_pipelinedOffset >= size - messageLength);
+            _pipelinedOffset -= size - messageLength;
+        }
+        else
+        {
+            _pipelinedBuffer.append(
+                _incomingBuffer.getData() + messageLength,
+                size - messageLength);
+        }
+        _incomingBuffer.remove(messageLength, size - messageLength);
+        // keep the byte after the message null for easy string processing
+        _incomingBuffer.getContentPtr()[messageLength] = 0;
+    }
+}
+
+/*
+ * Forward the requests in the pipelined buffer. They are processed
+ * concurrently (and their responses are written in order, see
+ * _handleResponseMessage()), up to httpMaxPipelinedRequests at a time; the
+ * rest wait until responses have been sent. The monitor does not report
+ * data that was already read from the socket, so this is called both after
+ * data has been read and after a response has been completed.
+ *
+ * A request is moved to the incoming buffer in pieces of increasing size
+ * until it is complete, and the data moved beyond its end is left to the
+ * next request, so that each byte of a burst of small requests is copied a
+ * bounded number of times.
+ */
+
+void HTTPConnection::_handlePipelinedRequests()
+{
+    // The incoming buffer still holds the current request while it is being
+    // forwarded, if a response is sent from within that call. It also holds
+    // an incomplete request once all pipelined data has been moved.
+    if (_pipelinedBuffer.size() == 0 || _incomingBuffer.size() != 0)
+    {
+        return;
+    }
+
+    PEG_METHOD_ENTER(TRC_HTTP, "HTTPConnection::_handlePipelinedRequests");
+
+    Uint32 moveSize = httpPipelinedMoveSize;
+
+    while (_pipelinedOffset < _pipelinedBuffer.size() &&
+        !_connectionClosePending &&
+        _pendingResponses.size() < httpMaxPipelinedRequests)
+    {
+        Uint32 size = _pipelinedBuffer.size() - _pipelinedOffset;
+
+        if (size > moveSize)
+        {
+            size = moveSize;
+        }
+
+        _incomingBuffer.append(
+            _pipelinedBuffer.getData() + _pipelinedOffset, size);
+        _pipelinedOffset += size;
+
+        _handleIncomingData(false);
+
+        // Move more of an incomplete request at a time
+        if (_incomingBuffer.size() == 0)
+        {
+            moveSize = httpPipelinedMoveSize;
+        }
+        else if (moveSize < httpTcpMaxReadSize)
+        {
+            moveSize *= 2;
+        }
+
+        if (_pipelinedOffset == _pipelinedBuffer.size())
+        {
+            _pipelinedBuffer.clear();
+            _pipelinedOffset = 0;
+        }
+    }
+
+    // Requests that wait for their turn are held in memory, so a client
+    // that pipelines too many of them at once is disconnected.
+    if (!_connectionClosePending &&
+        _pipelinedBuffer.size() - _pipelinedOffset > httpMaxPipelinedDataSize)
+    {
+        static const char detailP[] = "Too many pipelined requests";
+        String httpStatus =
+            HTTP_STATUS_REQUEST_TOO_LARGE + httpDetailDelimiter + detailP;
+        _handleReadEventFailure(httpStatus);
+    }
+
+    PEG_METHOD_EXIT();
+}
+
 Boolean HTTPConnection::isResponsePending()
 {
     return _responsePending;
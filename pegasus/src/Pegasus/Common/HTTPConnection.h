@@ -52,6 +52,7 @@ PEGASUS_NAMESPACE_BEGIN
 
 class Monitor;
 class HTTPAcceptor;
+struct HTTPPendingResponse;
 
 class PEGASUS_COMMON_LINKAGE HTTPConnection : public MessageQueue
 {
@@ -105,8 +106,15 @@ public:
         return *_owningAcceptor;
     }
 
-    // was the request for chunking ?
-    Boolean isChunkRequested();
+    // Did the request with the given queue id ask for a chunked response?
+    // On the server each request pipelined on the connection is sent
+    // upwards with a queue id of its own (see HTTPMessage::queueId), and
+    // the messages of its response are sent back with that id in dest.
+    Boolean isChunkRequested(Uint32 queueId);
+
+    // Has an error been sent in the response to the request with the given
+    // queue id?
+    Boolean hasResponseError(Uint32 queueId);
 
     void setSocketWriteTimeout(Uint32 socketWriteTimeout);
     static void setIdleConnectionTimeout(Uint32 idleConnectionTimeout);
@@ -123,9 +131,11 @@ public:
     // HTTPAuthenticatorDelegator runs out-of-memory. This method calls
     // _handleWriteEvent() with a dummy HTTPMessage to maintain  response
     // chunk sequence properly. Once all responses are  arrived, connection
-    // is closed. Param "respMsgIndex" indicates the response index and
-    // isComplete indicates whether the response is complete or not.
+    // is closed. Param "queueId" identifies the request the response is
+    // for, "respMsgIndex" indicates the response index and isComplete
+    // indicates whether the response is complete or not.
     void handleInternalServerError(
+        Uint32 queueId,
         Uint32 respMsgIndex,
         Boolean isComplete);
 
@@ -142,8 +152,6 @@ public:
     // HTTPConnection event thread will fail (hard).
     AtomicInt refcount;
 
-    CIMException cimException;
-
     // list of content languages
     ContentLanguageList contentLanguages;
 
@@ -160,10 +168,27 @@ private:
 
     void _handleReadEvent();
 
+    void _handleIncomingData(Boolean endOfData);
+
+    void _savePipelinedData(Uint32 messageLength);
+
+    void _handlePipelinedRequests();
+
+    Uint32 _addPendingResponse();
+
+    Uint32 _findPendingResponse(Uint32 queueId);
+
+    void _removePendingResponse();
+
+    Boolean _handleEnqueuedMessage(Message* message);
+
+    Boolean _handleResponseMessage(HTTPMessage* httpMessage);
+
     Boolean _handleWriteEvent(HTTPMessage& httpMessage);
 
     void _handleReadEventFailure(const String& httpStatusWithDetail,
-                                 const String& cimError = String());
+                                 const String& cimError = String(),
+                                 Uint32 queueId = 0);
     void _handleReadEventTransferEncoding();
     Boolean _isClient();
 
@@ -177,6 +202,11 @@ private:
     Sint32 _contentOffset;
     Sint32 _contentLength;
     Buffer _incomingBuffer;
+    // Requests a client has pipelined behind the one being received. They
+    // are moved to _incomingBuffer piece by piece, starting at
+    // _pipelinedOffset, as the requests before them have been forwarded.
+    Buffer _pipelinedBuffer;
+    Uint32 _pipelinedOffset;
     Buffer _outgoingBuffer;
     SharedPtr<AuthenticationInfo> _authInfo;
 
@@ -191,9 +221,17 @@ private:
         when a response is sent.  The connection object must not be destructed
         while a response is pending, because the CIM Server must route the
         response to the connection object when it becomes available.
+        On the server it is set while _pendingResponses is not empty.
     */
     Boolean _responsePending;
 
+    // The requests forwarded on a server connection whose responses have
+    // not been sent completely, in the order in which they were received.
+    // Pipelined requests are processed concurrently, but only the response
+    // to the first of them is written; the messages of the others are held
+    // until the responses before them are complete.
+    Array<HTTPPendingResponse*> _pendingResponses;
+
     Mutex _connection_mut;
 
     // The _connectionClosePending flag will be set to true if
@@ -219,23 +257,26 @@ private:
 
     int _entry_index;
 
-    // When used by the client, it is an offset (from start of http message)
-    // representing last NON completely parsed chunk of a transfer encoding.
-    // When used by the server, it is the message index that comes down
-    // from the providers/repository representing each message chunk.
-    // WARNING: Due to the duel use of this member variable, modifying code
-    // that uses this variable should be done very carefully. Accidental bugs
-    // introduced could easily break interoperability with wbem
-    // clients/servers that transfer and/or receive data via HTTP chunking.
+    // An offset (from start of http message) representing last NON
+    // completely parsed chunk of a transfer encoding. The server keeps the
+    // message index of the response being sent in HTTPPendingResponse, as
+    // a pipelined request may be received while a response is written.
     Uint32 _transferEncodingChunkOffset;
 
+    // Offset (from start of http message) of the end of the data de-chunked
+    // so far. The meta data of completed chunks is not removed from the
+    // buffer; the chunk data is moved down to this offset instead, and the
+    // gap up to _transferEncodingChunkOffset is closed at the last chunk.
+    Uint32 _transferEncodingDataEnd;
+
     // list of transfer encoding values from sender
     Array<String> _transferEncodingValues;
 
     // list of TE values from client
     Array<String> _transferEncodingTEValues;
 
-    // 2 digit prefix on http header if mpost was used
+    // 2 digit prefix on http header if mpost was used (in a received
+    // message; the server keeps that of its response in HTTPPendingResponse)
     String _mpostPrefix;
 
     // Holds time since this connection is idle.
@@ -253,6 +294,11 @@ private:
     // once all responses are arrived.
     Boolean _internalError;
 
+    // Set on the server when a write of the current response to the client
+    // failed. The remaining chunks of the response are discarded and the
+    // connection is closed once the last chunk arrives.
+    Boolean _responseWriteFailed;
+
     friend class Monitor;
     friend class HTTPAcceptor;
     friend class HTTPConnector;
@@ -31,6 +31,7 @@
 
 #include <cstring>
 #include "HashTable.h"
+#include "StringRep.h"
 
 PEGASUS_NAMESPACE_BEGIN
 
@@ -95,6 +96,14 @@ static const Uint8 _toLowerTable[256] =
 Uint32 HashLowerCaseFunc::hash(const String& str)
 {
     Uint16* p = (Uint16*)str.getChar16Data();
+
+    // Interned names (see CIMNameInterner) carry a precomputed hash.
+
+    const StringRep* rep = StringRep::fromData(p);
+
+    if (StringRep::isInterned(rep))
+        return StringRep::internedHash(rep);
+
     Uint32 h = 0;
     Uint32 n = str.size();
 
@@ -0,0 +1,80 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#include "IndicationPayload.h"
+
+PEGASUS_NAMESPACE_BEGIN
+
+IndicationPayload::IndicationPayload(
+    const Array<CIMName>& perDestinationProperties)
+    : _perDestinationProperties(perDestinationProperties)
+{
+    for (Uint32 i = 0; i < NUMBER_OF_FORMATS; i++)
+    {
+        _encoded[i] = false;
+    }
+}
+
+IndicationPayload::~IndicationPayload()
+{
+}
+
+Boolean IndicationPayload::appendEncoding(Format format, Buffer& out) const
+{
+    PEGASUS_ASSERT(format < NUMBER_OF_FORMATS);
+
+    AutoMutex mtx(_mutex);
+
+    if (!_encoded[format])
+    {
+        return false;
+    }
+
+    out.append(_encodings[format].getData(), _encodings[format].size());
+    return true;
+}
+
+void IndicationPayload::setEncoding(Format format, const Buffer& encoding)
+{
+    PEGASUS_ASSERT(format < NUMBER_OF_FORMATS);
+
+    AutoMutex mtx(_mutex);
+
+    // Another destination may have encoded the indication concurrently.
+    // Both encodings are identical, so keep the first one.
+    if (!_encoded[format])
+    {
+        _encodings[format] = encoding;
+        _encoded[format] = true;
+    }
+}
+
+PEGASUS_NAMESPACE_END
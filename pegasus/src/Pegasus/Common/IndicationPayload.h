@@ -0,0 +1,114 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#ifndef Pegasus_IndicationPayload_h
+#define Pegasus_IndicationPayload_h
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/Linkage.h>
+#include <Pegasus/Common/ArrayInternal.h>
+#include <Pegasus/Common/Buffer.h>
+#include <Pegasus/Common/CIMName.h>
+#include <Pegasus/Common/Mutex.h>
+
+PEGASUS_NAMESPACE_BEGIN
+
+/**
+    An IndicationPayload holds the encodings of one formatted indication
+    which are shared by all the destinations the indication is delivered to.
+
+    The IndicationService creates one IndicationPayload for each distinct
+    property projection of an indication and passes it to the handlers in
+    an IndicationPayloadContainer.  The first handler that encodes the
+    indication in a given format stores the encoding here, and the others
+    copy it instead of encoding the same instance again.
+
+    The properties named in the per-destination property list are not part
+    of the shared encoding.  They may be set differently for each
+    destination (e.g., the DSP1054 SequenceContext and SequenceNumber
+    properties) and are always encoded by the handler itself.  All other
+    properties of the indication instance must not be changed once the
+    IndicationPayload is created.
+*/
+class PEGASUS_COMMON_LINKAGE IndicationPayload
+{
+public:
+
+    enum Format
+    {
+        FORMAT_CIMXML,
+        NUMBER_OF_FORMATS
+    };
+
+    IndicationPayload(const Array<CIMName>& perDestinationProperties);
+
+    ~IndicationPayload();
+
+    /**
+        Returns the names of the properties which are not part of the shared
+        encodings.
+    */
+    const Array<CIMName>& getPerDestinationProperties() const
+    {
+        return _perDestinationProperties;
+    }
+
+    /**
+        Appends the shared encoding for the specified format to the buffer.
+
+        @param format The encoding format.
+        @param out The buffer to which the encoding is appended.
+        @return True if the encoding is available and was appended,
+            false otherwise.
+    */
+    Boolean appendEncoding(Format format, Buffer& out) const;
+
+    /**
+        Stores the shared encoding for the specified format.  If an encoding
+        is already stored for the format, it is kept and the new one is
+        ignored.
+    */
+    void setEncoding(Format format, const Buffer& encoding);
+
+private:
+
+    IndicationPayload(const IndicationPayload&);
+    IndicationPayload& operator=(const IndicationPayload&);
+
+    Array<CIMName> _perDestinationProperties;
+    mutable Mutex _mutex;
+    Buffer _encodings[NUMBER_OF_FORMATS];
+    Boolean _encoded[NUMBER_OF_FORMATS];
+};
+
+PEGASUS_NAMESPACE_END
+
+#endif /* Pegasus_IndicationPayload_h */
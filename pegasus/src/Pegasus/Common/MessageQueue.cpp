@@ -112,6 +112,33 @@ MessageQueue::~MessageQueue()
     PEG_METHOD_EXIT();
 }
 
+Uint32 MessageQueue::addQueueIdAlias()
+{
+    Uint32 queueId = getNextQueueId();
+
+    PEG_TRACE((TRC_MESSAGEQUEUESERVICE, Tracer::LEVEL4,
+        "MessageQueue::addQueueIdAlias name = %s, queueId = %u, alias = %u",
+        _name, _queueId, queueId));
+
+    AutoMutex autoMut(q_table_mut);
+    while (!_queueTable.insert(queueId, this))
+        ;
+
+    return queueId;
+}
+
+void MessageQueue::removeQueueIdAlias(Uint32 queueId)
+{
+    PEGASUS_ASSERT(queueId != _queueId);
+
+    {
+        AutoMutex autoMut(q_table_mut);
+        _queueTable.remove(queueId);
+    } // mutex unlocks here
+
+    putQueueId(queueId);
+}
+
 void MessageQueue::enqueue(Message* message)
 {
     PEG_METHOD_ENTER(TRC_MESSAGEQUEUESERVICE,"MessageQueue::enqueue()");
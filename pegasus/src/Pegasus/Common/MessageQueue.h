@@ -112,6 +112,19 @@ public:
      */
     static MessageQueue* lookup(const char *name);
 
+    /** Registers an additional queue id for this queue. lookup() returns
+        this queue for the id until it is removed with removeQueueIdAlias().
+        A queue that handles several independent conversations at a time
+        (such as a connection that processes pipelined requests) gives each
+        of them its own id, so that messages sent to it can be told apart
+        by their destination.
+        @return The new queue id.
+    */
+    Uint32 addQueueIdAlias();
+
+    /** Removes a queue id registered with addQueueIdAlias(). */
+    void removeQueueIdAlias(Uint32 queueId);
+
     /** Get the next available queue id. It always returns a non-zero
     queue id an monotonically increases and finally wraps (to one)
     after reaching the maximum unsigned 32 bit integer.
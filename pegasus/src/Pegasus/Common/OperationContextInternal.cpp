@@ -399,5 +399,67 @@ String UserRoleContainer::getUserRole() const
     return _userRole;
 }
 
+//
+// IndicationPayloadContainer
+//
+
+const String IndicationPayloadContainer::NAME = "IndicationPayloadContainer";
+
+IndicationPayloadContainer::IndicationPayloadContainer(
+    const OperationContext::Container& container)
+{
+    const IndicationPayloadContainer* p =
+        dynamic_cast<const IndicationPayloadContainer*>(&container);
+
+    if (p == 0)
+    {
+        throw DynamicCastFailedException();
+    }
+
+    *this = *p;
+}
+
+IndicationPayloadContainer::IndicationPayloadContainer(
+    const SharedPtr<IndicationPayload>& payload)
+    : _payload(payload)
+{
+}
+
+IndicationPayloadContainer::~IndicationPayloadContainer()
+{
+}
+
+IndicationPayloadContainer& IndicationPayloadContainer::operator=(
+    const IndicationPayloadContainer& container)
+{
+    if (this == &container)
+    {
+        return *this;
+    }
+
+    _payload = container._payload;
+
+    return *this;
+}
+
+String IndicationPayloadContainer::getName() const
+{
+    return NAME;
+}
+
+OperationContext::Container* IndicationPayloadContainer::clone() const
+{
+    return new IndicationPayloadContainer(*this);
+}
+
+void IndicationPayloadContainer::destroy()
+{
+    delete this;
+}
+
+IndicationPayload* IndicationPayloadContainer::getPayload() const
+{
+    return _payload.get();
+}
 
 PEGASUS_NAMESPACE_END
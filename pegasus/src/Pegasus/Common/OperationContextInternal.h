@@ -39,6 +39,8 @@
 #include <Pegasus/Common/CIMInstance.h>
 #include <Pegasus/Common/AutoPtr.h>
 #include <Pegasus/Common/ObjectNormalizer.h>
+#include <Pegasus/Common/SharedPtr.h>
+#include <Pegasus/Common/IndicationPayload.h>
 
 PEGASUS_NAMESPACE_BEGIN
 
@@ -191,7 +193,34 @@ private:
     UserRoleContainer();
 };
 
+class PEGASUS_COMMON_LINKAGE IndicationPayloadContainer
+    : virtual public OperationContext::Container
+{
+public:
+    static const String NAME;
+
+    IndicationPayloadContainer(const OperationContext::Container& container);
+    IndicationPayloadContainer(const SharedPtr<IndicationPayload>& payload);
+    virtual ~IndicationPayloadContainer();
 
+    // NOTE: The compiler default implementation of the copy constructor
+    // is used for this class.  Copies share the same IndicationPayload.
+
+    IndicationPayloadContainer& operator=(
+        const IndicationPayloadContainer& container);
+
+    virtual String getName() const;
+    virtual OperationContext::Container* clone() const;
+    virtual void destroy();
+
+    IndicationPayload* getPayload() const;
+
+protected:
+    SharedPtr<IndicationPayload> _payload;
+
+private:
+    IndicationPayloadContainer();
+};
 
 PEGASUS_NAMESPACE_END
 
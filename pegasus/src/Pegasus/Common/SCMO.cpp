@@ -39,6 +39,7 @@
 #include <Pegasus/Common/SCMOInstance.h>
 #include <Pegasus/Common/SCMODump.h>
 #include <Pegasus/Common/SCMOClassCache.h>
+#include <Pegasus/Common/SCMOBlockPool.h>
 #include <Pegasus/Common/CharSet.h>
 #include <Pegasus/Common/CIMDateTimeRep.h>
 #include <Pegasus/Common/CIMPropertyRep.h>
@@ -52,6 +53,7 @@
 #include <Pegasus/Common/System.h>
 #include <Pegasus/Common/FileSystem.h>
 #include <Pegasus/Common/StringConversion.h>
+#include <Pegasus/Common/UTF8CString.h>
 #include <Pegasus/Common/ArrayIterator.h>
 #include <Pegasus/Common/PegasusAssert.h>
 #include <Pegasus/Common/CIMValueRep.h>
@@ -283,12 +285,7 @@ inline void SCMOClass::_initSCMOClass()
     PEGASUS_ASSERT(SCMB_INITIAL_MEMORY_CHUNK_SIZE
         - sizeof(SCMBClass_Main)>0);
 
-    cls.base = (char*)malloc(SCMB_INITIAL_MEMORY_CHUNK_SIZE);
-    if (cls.base == 0)
-    {
-        // Not enough memory!
-        throw PEGASUS_STD(bad_alloc)();
-    }
+    cls.base = (char*)SCMOBlockPool::allocate(SCMB_INITIAL_MEMORY_CHUNK_SIZE);
 
     memset(cls.base,0,sizeof(SCMBClass_Main));
 
@@ -1150,10 +1147,8 @@ void SCMOClass::_setValue(
 QualifierNameEnum SCMOClass::_getSCMOQualifierNameEnum(
     const CIMName& theCIMName)
 {
-    // Get the UTF8 CString
-    CString theCString=theCIMName.getString().getCString();
     // Get the real size of the UTF8 sting.
-    Uint32 length = strlen((const char*)theCString);
+    Uint32 length = UTF8CString(theCIMName.getString()).size();
 
 
     // The start index is 1, because the at index 0 is a place holder for
@@ -1387,6 +1382,19 @@ void SCMOInstance::_destroyExternalReferences()
     _destroyExternalReferencesInternal(inst.mem);
 }
 
+void SCMOInstance::_freeInstanceMemory(SCMBInstance_Main* hdr)
+{
+    SCMOClass* theClass = hdr->theClass.ptr;
+    if (theClass != NULL)
+    {
+        theClass->cls.hdr->instanceSizeHint.set(
+            (Uint32)hdr->header.startOfFreeSpace);
+        // The class has also be dereferenced.
+        delete theClass;
+    }
+    SCMOBlockPool::release(hdr, hdr->header.totalSize);
+}
+
 SCMOClass SCMOInstance::_getSCMOClass(
     const CIMObjectPath& theCIMObj,
     const char* altNS,
@@ -1403,26 +1411,26 @@ SCMOClass SCMOInstance::_getSCMOClass(
     {
         // the name space of the object path is empty,
         // use alternative name space.
-        CString clsName = theCIMObj.getClassName().getString().getCString();
+        UTF8CString clsName(theCIMObj.getClassName().getString());
 
         SCMOClassCache* theCache = SCMOClassCache::getInstance();
         theClass = theCache->getSCMOClass(
             altNS,
             altNSlength,
-            (const char*)clsName,
-            strlen(clsName));
+            clsName,
+            clsName.size());
     }
     else
     {
-        CString nameSpace = theCIMObj.getNameSpace().getString().getCString();
-        CString clsName = theCIMObj.getClassName().getString().getCString();
+        UTF8CString nameSpace(theCIMObj.getNameSpace().getString());
+        UTF8CString clsName(theCIMObj.getClassName().getString());
 
         SCMOClassCache* theCache = SCMOClassCache::getInstance();
         theClass = theCache->getSCMOClass(
-            (const char*)nameSpace,
-            strlen(nameSpace),
-            (const char*)clsName,
-            strlen(clsName));
+            nameSpace,
+            nameSpace.size(),
+            clsName,
+            clsName.size());
     }
 
     return theClass;
@@ -2318,14 +2326,14 @@ void SCMOInstance::_getCIMValueFromSCMBValue(
 
 void SCMOInstance::_setCIMObjectPath(const CIMObjectPath& cimObj)
 {
-    CString className = cimObj.getClassName().getString().getCString();
+    UTF8CString className(cimObj.getClassName().getString());
 
     // Is the instance from the same class ?
     if (!(_equalNoCaseUTF8Strings(
              inst.hdr->instClassName,
              inst.base,
-             (const char*)className,
-             strlen(className))))
+             className,
+             className.size())))
     {
         throw PEGASUS_CIM_EXCEPTION(CIM_ERR_INVALID_CLASS,
            cimObj.getClassName().getString());
@@ -2744,21 +2752,28 @@ void SCMOInstance::_initSCMOInstance(SCMOClass* pClass)
     PEGASUS_ASSERT(SCMB_INITIAL_MEMORY_CHUNK_SIZE
         - sizeof(SCMBInstance_Main)>0);
 
-    inst.base = (char*)malloc(SCMB_INITIAL_MEMORY_CHUNK_SIZE);
-    if (inst.base == 0)
+    // Start with the size the previous instances of the class needed,
+    // to avoid growing the SCMB step by step.
+    Uint64 size = SCMB_INITIAL_MEMORY_CHUNK_SIZE;
+    if (pClass != NULL)
     {
-        // Not enough memory!
-        throw PEGASUS_STD(bad_alloc)();
+        size = SCMOBlockPool::getBlockSize(
+            pClass->cls.hdr->instanceSizeHint.get());
+        if (size < SCMB_INITIAL_MEMORY_CHUNK_SIZE)
+        {
+            size = SCMB_INITIAL_MEMORY_CHUNK_SIZE;
+        }
     }
 
+    inst.base = (char*)SCMOBlockPool::allocate(size);
+
     memset(inst.base,0,sizeof(SCMBInstance_Main));
 
     // initalize eye catcher
     inst.hdr->header.magic=PEGASUS_SCMB_INSTANCE_MAGIC;
-    inst.hdr->header.totalSize=SCMB_INITIAL_MEMORY_CHUNK_SIZE;
+    inst.hdr->header.totalSize=size;
     // The # of bytes free
-    inst.hdr->header.freeBytes=
-        SCMB_INITIAL_MEMORY_CHUNK_SIZE-sizeof(SCMBInstance_Main);
+    inst.hdr->header.freeBytes=size-sizeof(SCMBInstance_Main);
     // Index to the start of the free space in this instance
     inst.hdr->header.startOfFreeSpace=sizeof(SCMBInstance_Main);
 
@@ -3993,15 +4008,10 @@ void SCMOInstance::_setUnionValue(
 
     case CIMTYPE_STRING:
         {
-            // KS_TODO why do this when there is a _setChar function
-            // that directly uses Strings??? low priority question but
-            // this would seem less efficient that _setString with the
-            // strlen function in it.
-            CString cstr = ((String*)((void*)&u))->getCString();
-            const char *cptr = (const char*)cstr;
+            UTF8CString cstr(*((String*)((void*)&u)));
             _setBinary(
-                cptr,
-                strlen(cptr) + 1,
+                cstr,
+                cstr.size() + 1,
                 scmoUnion->stringValue,
                 pmem );
             break;
@@ -4360,11 +4370,7 @@ SCMOInstance SCMOInstance::clone(Boolean objectPathOnly) const
 void SCMOInstance::_clone()
 {
     char* newBase;
-    newBase = (char*)malloc((size_t)inst.mem->totalSize);
-    if (0 == newBase )
-    {
-        throw PEGASUS_STD(bad_alloc)();
-    }
+    newBase = (char*)SCMOBlockPool::allocate(inst.mem->totalSize);
 
     memcpy( newBase,inst.base,(size_t)inst.mem->totalSize);
 
@@ -7028,12 +7034,8 @@ Uint64 _getFreeSpace(
         oldSize = (*pmem)->totalSize;
         // reallocate the buffer, double the space !
         // This is a working approach until a better algorithm is found.
-        void* newBlockPtr = realloc((*pmem),(size_t)oldSize*2);
-        if ((newBlockPtr) == 0)
-        {
-            // Not enough memory!
-            throw PEGASUS_STD(bad_alloc)();
-        }
+        void* newBlockPtr =
+            SCMOBlockPool::reallocate((*pmem), oldSize, oldSize*2);
         (*pmem) = (SCMBMgmt_Header*)newBlockPtr;
         // increase the total size and free space
         (*pmem)->freeBytes+=oldSize;
@@ -7058,13 +7060,13 @@ void _setString(
     SCMBMgmt_Header** pmem)
 {
 
-    // Get the UTF8 CString
-    CString theCString=theString.getCString();
+    // Get the UTF8 string
+    UTF8CString theCString(theString);
     // Get the real size of the UTF8 sting + \0.
     // It maybe greater then the length in the String due to
     // 4 byte encoding of non ASCII chars.
     Uint64 start;
-    Uint32 length = strlen((const char*)theCString)+1;
+    Uint32 length = theCString.size() + 1;
 
     // If the string is not empty.
     if (length != 1)
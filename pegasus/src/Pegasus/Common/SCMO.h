@@ -447,6 +447,9 @@ struct SCMBClass_Main
     SCMBMgmt_Header     header;
     // The reference counter for this class
     AtomicInt       refCount;
+    // The number of bytes used by the most recently released instance of
+    // this class. Used to size the SCMB of new instances.
+    AtomicInt       instanceSizeHint;
     // Object flags
     struct
     {
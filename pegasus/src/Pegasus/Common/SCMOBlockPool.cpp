@@ -0,0 +1,171 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#include <Pegasus/Common/SCMOBlockPool.h>
+#include <Pegasus/Common/Mutex.h>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+PEGASUS_NAMESPACE_BEGIN
+
+// The smallest size class matches the initial size of an SCMB; the size
+// classes then double, as the SCMB does when it runs out of space.
+#define SCMO_POOL_MIN_BLOCK_SIZE 4096
+#define SCMO_POOL_NUM_SIZE_CLASSES 9
+
+// Upper limit of the memory kept in each size class.
+#define SCMO_POOL_BYTES_PER_SIZE_CLASS (1024 * 1024)
+
+struct SCMOPoolFreeBlock
+{
+    SCMOPoolFreeBlock* next;
+};
+
+struct SCMOPoolSizeClass
+{
+    Mutex mutex;
+    SCMOPoolFreeBlock* freeList;
+    Uint32 numFree;
+};
+
+static SCMOPoolSizeClass _sizeClasses[SCMO_POOL_NUM_SIZE_CLASSES];
+
+// Returns the index of the size class holding blocks of exactly size bytes,
+// or -1 if size is not a size class.
+static inline int _getSizeClass(Uint64 size)
+{
+    Uint64 classSize = SCMO_POOL_MIN_BLOCK_SIZE;
+    for (int i = 0; i < SCMO_POOL_NUM_SIZE_CLASSES; i++, classSize <<= 1)
+    {
+        if (size == classSize)
+        {
+            return i;
+        }
+        if (size < classSize)
+        {
+            break;
+        }
+    }
+    return -1;
+}
+
+Uint64 SCMOBlockPool::getBlockSize(Uint64 minSize)
+{
+    Uint64 classSize = SCMO_POOL_MIN_BLOCK_SIZE;
+    for (int i = 0; i < SCMO_POOL_NUM_SIZE_CLASSES; i++, classSize <<= 1)
+    {
+        if (minSize <= classSize)
+        {
+            return classSize;
+        }
+    }
+    return minSize;
+}
+
+void* SCMOBlockPool::allocate(Uint64 size)
+{
+    int sc = _getSizeClass(size);
+    if (sc >= 0)
+    {
+        SCMOPoolSizeClass& sizeClass = _sizeClasses[sc];
+        AutoMutex lock(sizeClass.mutex);
+        SCMOPoolFreeBlock* block = sizeClass.freeList;
+        if (block)
+        {
+            sizeClass.freeList = block->next;
+            sizeClass.numFree--;
+            return block;
+        }
+    }
+
+    void* block = malloc((size_t)size);
+    if (block == 0)
+    {
+        // Not enough memory!
+        throw PEGASUS_STD(bad_alloc)();
+    }
+    return block;
+}
+
+void* SCMOBlockPool::reallocate(void* block, Uint64 oldSize, Uint64 newSize)
+{
+    if (_getSizeClass(newSize) < 0)
+    {
+        // The new block will not be pooled, so let the heap try to grow the
+        // block in place.  Release the old block to the heap only if it was
+        // not a pooled size, because a pooled size is worth keeping.
+        if (_getSizeClass(oldSize) < 0)
+        {
+            void* newBlock = realloc(block, (size_t)newSize);
+            if (newBlock == 0)
+            {
+                // Not enough memory!
+                throw PEGASUS_STD(bad_alloc)();
+            }
+            return newBlock;
+        }
+    }
+
+    void* newBlock = allocate(newSize);
+    memcpy(newBlock, block, (size_t)(oldSize < newSize ? oldSize : newSize));
+    release(block, oldSize);
+    return newBlock;
+}
+
+void SCMOBlockPool::release(void* block, Uint64 size)
+{
+    if (block == 0)
+    {
+        return;
+    }
+
+    int sc = _getSizeClass(size);
+    if (sc >= 0)
+    {
+        SCMOPoolSizeClass& sizeClass = _sizeClasses[sc];
+        AutoMutex lock(sizeClass.mutex);
+        if (sizeClass.numFree * size < SCMO_POOL_BYTES_PER_SIZE_CLASS)
+        {
+            SCMOPoolFreeBlock* freeBlock = (SCMOPoolFreeBlock*)block;
+            freeBlock->next = sizeClass.freeList;
+            sizeClass.freeList = freeBlock;
+            sizeClass.numFree++;
+            return;
+        }
+    }
+
+    free(block);
+}
+
+PEGASUS_NAMESPACE_END
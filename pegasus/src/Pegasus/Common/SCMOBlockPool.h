@@ -0,0 +1,87 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+#ifndef _SCMOBlockPool_H_
+#define _SCMOBlockPool_H_
+
+#include <Pegasus/Common/Linkage.h>
+#include <Pegasus/Common/Config.h>
+
+PEGASUS_NAMESPACE_BEGIN
+
+/**
+    SCMOBlockPool caches released SCMB memory blocks in power-of-two size
+    classes, so that the blocks of the many short lived SCMOInstances that
+    pass through a CIMResponseData are reused by the next response rather
+    than being returned to and requested from the heap one by one.
+
+    Only blocks whose size is exactly one of the size classes are cached;
+    any other block is passed through to malloc(), realloc() and free().
+    The number of blocks kept per size class is bounded.
+*/
+class PEGASUS_COMMON_LINKAGE SCMOBlockPool
+{
+public:
+
+    /**
+        Returns the smallest pooled block size that is at least minSize, or
+        minSize itself if it is larger than the largest size class.
+    */
+    static Uint64 getBlockSize(Uint64 minSize);
+
+    /**
+        Allocates a block of exactly size bytes.
+        @exception bad_alloc if no memory is available.
+    */
+    static void* allocate(Uint64 size);
+
+    /**
+        Moves the content of block to a new block of newSize bytes and
+        releases block.  Only the first oldSize bytes are preserved.
+        @exception bad_alloc if no memory is available; block is unchanged.
+    */
+    static void* reallocate(void* block, Uint64 oldSize, Uint64 newSize);
+
+    /**
+        Releases a block previously obtained from this pool or from malloc().
+        The size must not exceed the allocated size of the block.
+    */
+    static void release(void* block, Uint64 size);
+
+private:
+
+    SCMOBlockPool();
+};
+
+PEGASUS_NAMESPACE_END
+
+#endif
@@ -41,6 +41,7 @@
 #include <Pegasus/Common/Config.h>
 #include <Pegasus/Common/Linkage.h>
 #include <Pegasus/Common/SCMO.h>
+#include <Pegasus/Common/SCMOBlockPool.h>
 #include <Pegasus/Common/CIMClass.h>
 #include <Pegasus/Common/CIMClassRep.h>
 #include <Pegasus/Common/CIMObjectRep.h>
@@ -185,7 +186,7 @@ private:
         if (cls.hdr->refCount.decAndTestIfZero())
         {
             _destroyExternalReferences();
-            free(cls.base);
+            SCMOBlockPool::release(cls.base, cls.mem->totalSize);
             cls.base=0;
         }
 
@@ -256,6 +257,7 @@ private:
     friend class SCMOInstance;
     friend class SCMODump;
     friend class SCMOXmlWriter;
+    friend class SCMOWsmWriter;
     friend class SCMOClassCache;
     friend class SCMOStreamer;
 };
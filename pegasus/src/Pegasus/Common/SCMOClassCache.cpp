@@ -73,22 +73,44 @@ SCMOClassCache::~SCMOClassCache()
     }
 }
 
+// Case-folded hash of a UTF-8 encoded name, folding the ASCII letters like
+// HashLowerCaseFunc does for the names of the other class and namespace
+// tables.
+static inline Uint32 _hashNoCase(const char* name, Uint32 nameLen)
+{
+    Uint32 h = 0;
+
+    for (Uint32 i = 0; i < nameLen; i++)
+    {
+        Uint8 c = Uint8(name[i]);
+
+        if (c >= 'A' && c <= 'Z')
+        {
+            c |= 0x20;
+        }
+
+        h = ((h << 9) | (h >> 23)) ^ c;
+    }
+
+    return h;
+}
+
 Uint64 SCMOClassCache::_generateKey(
     const char* className,
     Uint32 classNameLen,
     const char* nameSpaceName,
     Uint32 nameSpaceNameLen)
 {
-    Uint64 key = 0;
-
-    key  =  (Uint64(classNameLen) << 48 ) |
-            (Uint64(className[0]) << 40 ) |
-            (Uint64(className[classNameLen-1]) << 32 ) |
-            (Uint64(nameSpaceNameLen) << 16 ) |
-            (Uint64(nameSpaceName[0]) << 8 ) |
-            Uint64(nameSpaceName[nameSpaceNameLen-1]);
-
-    return key;
+    // The key combines the case-folded hashes of both names, so that
+    // different spellings of a name share an entry, and distinct classes
+    // of equal name length and first and last characters (common in the
+    // CIM schema) rarely share a key.
+    Uint64 key =
+        (Uint64(_hashNoCase(className, classNameLen)) << 32) |
+        Uint64(_hashNoCase(nameSpaceName, nameSpaceNameLen));
+
+    // A key of zero denotes an unused entry.
+    return key ? key : 1;
 }
 
 inline Boolean SCMOClassCache::_lockEntry(Uint32 index)
@@ -786,6 +786,15 @@ public:
     }
 
 
+    /**
+     * Returns the number of bytes in use in the memory block of the
+     * instance. Instances hosted as external references are not included.
+     **/
+    Uint64 getUsedMemorySize() const
+    {
+        return inst.mem->startOfFreeSpace;
+    }
+
     /**
      * Returns the number of external references hosted by the instance.
      **/
@@ -822,9 +831,7 @@ private:
         {
             // All external references have to be destroyed.
             _destroyExternalReferences();
-            // The class has also be dereferenced.
-            delete inst.hdr->theClass.ptr;
-            free(inst.base);
+            _freeInstanceMemory(inst.hdr);
             inst.base=NULL;
         }
 
@@ -843,9 +850,7 @@ private:
             {
                 // All external references have to be destroyed.
                 _destroyExternalReferencesInternal(oldMgmt);
-                // The class has also be dereferenced.
-                delete oldRef->theClass.ptr;
-                free((void*)oldRef);
+                _freeInstanceMemory(oldRef);
                 oldRef=0;
             }
         }
@@ -853,6 +858,12 @@ private:
 
     void _clone();
 
+    /**
+     * Dereferences the class of the instance, after recording the size of
+     * the instance in it as hint for new instances, and releases the SCMB.
+     */
+    static void _freeInstanceMemory(SCMBInstance_Main* hdr);
+
     void _destroyExternalReferences();
 
     void _destroyExternalKeyBindings();
@@ -865,7 +876,7 @@ private:
 
     void _setCIMInstance(const CIMInstance& cimInstance);
 
-    // Internal but used by friend class SCMOXmlWriter.cpp
+    // Internal but used by friend classes SCMOXmlWriter and SCMOWsmWriter
     // This function accounts for user-defined and class-defined properties
     void _getPropertyAt(
         Uint32 pos,
@@ -1065,6 +1076,7 @@ private:
     friend class SCMOClass;
     friend class SCMODump;
     friend class SCMOXmlWriter;
+    friend class SCMOWsmWriter;
     friend class SCMOStreamer;
 };
 
@@ -40,6 +40,10 @@
 #include <Pegasus/Common/Threads.h>
 #include <Pegasus/Common/Mutex.h>
 
+#ifdef PEGASUS_OS_TYPE_UNIX
+# include <sys/uio.h>
+#endif
+
 PEGASUS_NAMESPACE_BEGIN
 
 #ifdef PEGASUS_OS_TYPE_WINDOWS
@@ -238,6 +242,139 @@ Sint32 Socket::timedWrite(
     }
 }
 
+#ifdef PEGASUS_OS_TYPE_UNIX
+
+// Number of buffers passed to one writev() call. Callers pass a handful of
+// buffers, so this is well below IOV_MAX on every supported platform.
+static const Uint32 _MAX_WRITEV_BUFFERS = 16;
+
+Sint32 Socket::timedWritev(
+    SocketHandle socket,
+    const SocketWriteBuffer* buffers,
+    Uint32 count,
+    Uint32 socketWriteTimeout)
+{
+    struct iovec iov[_MAX_WRITEV_BUFFERS];
+    Sint32 totalBytesWritten = 0;
+    Boolean socketTimedOut = false;
+
+    // The first buffer not yet completely written and the number of its
+    // bytes that have been written.
+    Uint32 index = 0;
+    Uint32 offset = 0;
+
+    while (1)
+    {
+        int iovCount = 0;
+        Uint32 iovBytes = 0;
+
+        for (Uint32 i = index;
+             i < count && iovCount < (int)_MAX_WRITEV_BUFFERS &&
+                 iovBytes < PEGASUS_SOCKET_MAX_WRITE_SIZE;
+             i++)
+        {
+            Uint32 skip = (i == index) ? offset : 0;
+
+            if (buffers[i].size > skip)
+            {
+                Uint32 size = buffers[i].size - skip;
+                if (size > PEGASUS_SOCKET_MAX_WRITE_SIZE - iovBytes)
+                {
+                    size = PEGASUS_SOCKET_MAX_WRITE_SIZE - iovBytes;
+                }
+                iov[iovCount].iov_base = (char*)buffers[i].data + skip;
+                iov[iovCount].iov_len = size;
+                iovBytes += size;
+                iovCount++;
+            }
+        }
+
+        // All data written ? return amount of data written
+        if (iovCount == 0)
+        {
+            return totalBytesWritten;
+        }
+
+        ssize_t bytesWritten;
+        PEGASUS_RETRY_SYSTEM_CALL(
+            ::writev(socket, iov, iovCount), bytesWritten);
+
+        // Some data written this cycle ? Skip past it and resume writing
+        // with the rest.
+        if (bytesWritten > 0)
+        {
+            totalBytesWritten += (Sint32)bytesWritten;
+            socketTimedOut = false;
+
+            Uint32 bytesLeft = (Uint32)bytesWritten;
+
+            while (index < count && bytesLeft >= buffers[index].size - offset)
+            {
+                bytesLeft -= buffers[index].size - offset;
+                index++;
+                offset = 0;
+            }
+            offset += bytesLeft;
+            continue;
+        }
+
+        // Something went wrong
+        // if we already waited for the socket to get ready, bail out
+        if (socketTimedOut || (errno != EAGAIN && errno != EWOULDBLOCK))
+        {
+            return PEGASUS_SOCKET_ERROR;
+        }
+
+        fd_set fdwrite;
+        // max. timeout seconds waiting for the socket to get ready
+        struct timeval tv = { socketWriteTimeout, 0 };
+        FD_ZERO(&fdwrite);
+        FD_SET(socket, &fdwrite);
+        if (select(FD_SETSIZE, NULL, &fdwrite, NULL, &tv) == 0)
+        {
+            socketTimedOut = true; // ran out of time
+        }
+    }
+}
+
+#else
+
+Sint32 Socket::timedWritev(
+    SocketHandle socket,
+    const SocketWriteBuffer* buffers,
+    Uint32 count,
+    Uint32 socketWriteTimeout)
+{
+    // No gather write available, write the buffers one after the other.
+    Sint32 totalBytesWritten = 0;
+
+    for (Uint32 i = 0; i < count; i++)
+    {
+        for (Uint32 offset = 0; offset < buffers[i].size; )
+        {
+            Uint32 size = buffers[i].size - offset;
+            if (size > PEGASUS_SOCKET_MAX_WRITE_SIZE)
+            {
+                size = PEGASUS_SOCKET_MAX_WRITE_SIZE;
+            }
+
+            Sint32 bytesWritten = timedWrite(
+                socket, buffers[i].data + offset, size, socketWriteTimeout);
+
+            if (bytesWritten < 0)
+            {
+                return bytesWritten;
+            }
+            totalBytesWritten += bytesWritten;
+            offset += size;
+        }
+    }
+
+    return totalBytesWritten;
+}
+
+#endif
+
 void Socket::close(SocketHandle& socket)
 {
     if (socket != PEGASUS_INVALID_SOCKET)
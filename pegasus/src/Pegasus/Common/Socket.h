@@ -43,6 +43,23 @@
 
 PEGASUS_NAMESPACE_BEGIN
 
+/**
+    Socket writes larger than 64K cause some platforms to return errors.
+    The gather writes therefore pass at most this many bytes to a single
+    system call or SSL_write(), and loop until all the buffers have gone.
+*/
+#define PEGASUS_SOCKET_MAX_WRITE_SIZE (64 * 1024)
+
+/**
+    Describes one of the buffers passed to a gather write
+    (Socket::timedWritev() and MP_Socket::writev()).
+*/
+struct SocketWriteBuffer
+{
+    const char* data;
+    Uint32 size;
+};
+
 class Socket
 {
 public:
@@ -77,6 +94,25 @@ public:
                              Uint32 size,
                              Uint32 socketWriteTimeout);
 
+    /**
+        Writes the specified buffers to the socket in order, as if they were
+        one contiguous buffer, with the same timeout behavior as timedWrite().
+        Where the platform supports it the buffers are sent with writev(),
+        so framing and body data go out in one system call without being
+        copied together first.
+
+        @param socket The socket to write to.
+        @param buffers The buffers to write. Buffers of size 0 are skipped.
+        @param count The number of buffers.
+        @param socketWriteTimeout Seconds to wait for the socket to accept
+            more data before the write fails.
+        @return The total number of bytes written, or PEGASUS_SOCKET_ERROR.
+    */
+    static Sint32 timedWritev(SocketHandle socket,
+                              const SocketWriteBuffer* buffers,
+                              Uint32 count,
+                              Uint32 socketWriteTimeout);
+
     /**
         Closes a specified socket.  If successful, the socket handle is set to
         PEGASUS_INVALID_SOCKET.
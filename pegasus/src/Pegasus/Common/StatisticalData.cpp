@@ -114,6 +114,7 @@ StatisticalData* StatisticalData::current()
 StatisticalData::StatisticalData()
 {
     copyGSD = 0;
+    memset(_providerModules, 0, sizeof(_providerModules));
     clear();
 }
 
@@ -127,6 +128,16 @@ void StatisticalData::clear()
         providerTime[i] = 0;
         responseSize[i] = 0;
         requestSize[i] = 0;
+        for (Uint32 j = 0; j < NUMBER_OF_STATDATA_TYPES; j++)
+        {
+            histograms[i][j].clear();
+        }
+    }
+
+    Uint32 numModules = _numProviderModules.get();
+    for (Uint32 i = 0; i < numModules; i++)
+    {
+        _providerModules[i]->histogram.clear();
     }
 }
 
@@ -173,6 +184,18 @@ void StatisticalData::addToValue(Sint64 value,
 
     if (copyGSD)
     {
+        if (value >= 0)
+        {
+            histograms[type][t].record(Uint64(value));
+        }
+
+        // Response chunk statistics have no totals to update
+        if (t == PEGASUS_STATDATA_CHUNK_OBJECTS ||
+            t == PEGASUS_STATDATA_CHUNK_SIZE)
+        {
+            return;
+        }
+
         AutoMutex autoMut(_mutex);
         switch (t)
         {
@@ -217,10 +240,79 @@ void StatisticalData::addToValue(Sint64 value,
                     (const char *)requestName[type].getCString(), type,
                     numCalls[type], value, requestSize[type]));
                 break;
+        default:
+                break;
         }
     }
 }
 
+void StatisticalData::addProviderModuleValue(
+    const String& moduleName,
+    Sint64 value)
+{
+    if (!copyGSD || value < 0)
+    {
+        return;
+    }
+
+    Uint32 numModules = _numProviderModules.get();
+    for (Uint32 i = 0; i < numModules; i++)
+    {
+        if (_providerModules[i]->name == moduleName)
+        {
+            _providerModules[i]->histogram.record(Uint64(value));
+            return;
+        }
+    }
+
+    AutoMutex autoMut(_moduleMutex);
+
+    // Another thread may have added the module since the search above.
+    numModules = _numProviderModules.get();
+    for (Uint32 i = 0; i < numModules; i++)
+    {
+        if (_providerModules[i]->name == moduleName)
+        {
+            _providerModules[i]->histogram.record(Uint64(value));
+            return;
+        }
+    }
+
+    if (numModules >= MAX_PROVIDER_MODULES)
+    {
+        PEG_TRACE((TRC_DISCARDED_DATA, Tracer::LEVEL2,
+            "StatData: Provider time of module %s discarded.  "
+                "More than %u provider modules.",
+            (const char*)moduleName.getCString(),
+            MAX_PROVIDER_MODULES));
+        return;
+    }
+
+    ProviderModuleEntry* entry = new ProviderModuleEntry;
+    entry->name = moduleName;
+    entry->histogram.record(Uint64(value));
+    _providerModules[numModules] = entry;
+    _numProviderModules.inc();
+}
+
+Uint32 StatisticalData::getProviderModuleCount() const
+{
+    return _numProviderModules.get();
+}
+
+const String& StatisticalData::getProviderModuleName(Uint32 index) const
+{
+    PEGASUS_ASSERT(index < _numProviderModules.get());
+    return _providerModules[index]->name;
+}
+
+const StatisticalHistogram& StatisticalData::getProviderModuleHistogram(
+    Uint32 index) const
+{
+    PEGASUS_ASSERT(index < _numProviderModules.get());
+    return _providerModules[index]->histogram;
+}
+
 void StatisticalData::setCopyGSD(Boolean flag)
 {
     copyGSD = flag;
@@ -43,6 +43,8 @@
 #include <Pegasus/Common/CIMDateTime.h>
 #include <Pegasus/Common/CIMMessage.h>
 #include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/AtomicInt.h>
+#include <Pegasus/Common/StatisticalHistogram.h>
 #include <Pegasus/Common/Time.h>
 #include <Pegasus/Common/TimeValue.h>
 
@@ -173,9 +175,18 @@ public:
         PEGASUS_STATDATA_SERVER,
         PEGASUS_STATDATA_PROVIDER,
         PEGASUS_STATDATA_BYTES_SENT,
-        PEGASUS_STATDATA_BYTES_READ
+        PEGASUS_STATDATA_BYTES_READ,
+        // Objects and estimated bytes per provider response chunk.  These
+        // are kept as distributions only, without totals.
+        PEGASUS_STATDATA_CHUNK_OBJECTS,
+        PEGASUS_STATDATA_CHUNK_SIZE,
+        NUMBER_OF_STATDATA_TYPES
     };
 
+    // Maximum number of provider modules for which provider time
+    // distributions are kept.  Further modules are not recorded.
+    enum { MAX_PROVIDER_MODULES = 128 };
+
     static const Uint32 length;
 
     /**
@@ -199,6 +210,10 @@ public:
     Sint64 requSize;    //temporary storage for requestSize value
     Boolean copyGSD;
 
+    // Distribution of each statistic per operation type, from which
+    // percentiles are reported.  Recorded without holding _mutex.
+    StatisticalHistogram histograms[NUMBER_OF_TYPES][NUMBER_OF_STATDATA_TYPES];
+
     static StatisticalData* table;
 
     /** Add the value parameter to the current value for the
@@ -211,6 +226,30 @@ public:
      */
     void addToValue(Sint64 value, MessageType msgType, StatDataType t);
 
+    /** Add the provider time of an operation to the distribution kept
+        for the provider module that processed it.
+
+        @param moduleName name of the provider module
+        @param value provider time in microseconds
+     */
+    void addProviderModuleValue(const String& moduleName, Sint64 value);
+
+    /** Get the number of provider modules for which provider time
+        distributions are kept.  Modules are never removed, so indexes
+        below the returned count remain valid.
+     */
+    Uint32 getProviderModuleCount() const;
+
+    /** Get the name of the provider module with the given index.
+     */
+    const String& getProviderModuleName(Uint32 index) const;
+
+    /** Get the provider time distribution of the provider module with the
+        given index.
+     */
+    const StatisticalHistogram& getProviderModuleHistogram(
+        Uint32 index) const;
+
     /** Clear the StatisticalData table entries back to zero
      */
     void clear();
@@ -230,6 +269,19 @@ protected:
     Mutex _mutex;
 
 private:
+    struct ProviderModuleEntry
+    {
+        String name;
+        StatisticalHistogram histogram;
+    };
+
+    // Append-only; an entry is complete before _numProviderModules counts
+    // it, so readers and recorders do not lock.  _moduleMutex serializes
+    // the addition of entries.
+    ProviderModuleEntry* _providerModules[MAX_PROVIDER_MODULES];
+    AtomicInt _numProviderModules;
+    Mutex _moduleMutex;
+
     StatisticalData();
     StatisticalData(const StatisticalData&);        // Prevent copy-construction
     StatisticalData& operator=(const StatisticalData&);
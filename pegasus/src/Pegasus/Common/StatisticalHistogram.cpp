@@ -0,0 +1,190 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#include "StatisticalHistogram.h"
+#include "Threads.h"
+
+PEGASUS_NAMESPACE_BEGIN
+
+// Values below this limit have a bucket each.
+#define STATHIST_LINEAR_LIMIT 16
+
+// log2 of the number of buckets per power of two above the linear range.
+#define STATHIST_SUB_BUCKET_BITS 3
+#define STATHIST_SUB_BUCKETS (1 << STATHIST_SUB_BUCKET_BITS)
+
+// log2 of STATHIST_LINEAR_LIMIT, the exponent of the first log bucket.
+#define STATHIST_FIRST_EXPONENT 4
+
+// Selects the shard of the calling thread.
+static inline Uint32 _getShard()
+{
+    ThreadType self = Threads::self();
+    const unsigned char* p = (const unsigned char*)&self;
+    Uint32 hash = 0;
+    for (size_t i = 0; i < sizeof(self); i++)
+    {
+        hash = hash * 31 + p[i];
+    }
+    // pthread_t values are typically addresses of large aligned blocks, so
+    // fold the higher bits in.
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash % StatisticalHistogram::NUMBER_OF_SHARDS;
+}
+
+StatisticalHistogram::StatisticalHistogram()
+{
+}
+
+Uint32 StatisticalHistogram::getBucketIndex(Uint64 value)
+{
+    if (value < STATHIST_LINEAR_LIMIT)
+    {
+        return Uint32(value);
+    }
+
+    if (value > getBucketHighestValue(NUMBER_OF_BUCKETS - 1))
+    {
+        return NUMBER_OF_BUCKETS - 1;
+    }
+
+    Uint32 exponent = STATHIST_FIRST_EXPONENT;
+    while ((value >> (exponent + 1)) != 0)
+    {
+        exponent++;
+    }
+
+    return STATHIST_LINEAR_LIMIT +
+        (exponent - STATHIST_FIRST_EXPONENT) * STATHIST_SUB_BUCKETS +
+        Uint32((value >> (exponent - STATHIST_SUB_BUCKET_BITS)) &
+            (STATHIST_SUB_BUCKETS - 1));
+}
+
+Uint64 StatisticalHistogram::getBucketHighestValue(Uint32 index)
+{
+    if (index < STATHIST_LINEAR_LIMIT)
+    {
+        return index;
+    }
+
+    Uint32 exponent = STATHIST_FIRST_EXPONENT +
+        (index - STATHIST_LINEAR_LIMIT) / STATHIST_SUB_BUCKETS;
+    Uint64 subBucket = (index - STATHIST_LINEAR_LIMIT) % STATHIST_SUB_BUCKETS;
+    Uint32 shift = exponent - STATHIST_SUB_BUCKET_BITS;
+
+    return ((STATHIST_SUB_BUCKETS + subBucket + 1) << shift) - 1;
+}
+
+void StatisticalHistogram::record(Uint64 value)
+{
+    _counts[_getShard()][getBucketIndex(value)].inc();
+}
+
+void StatisticalHistogram::clear()
+{
+    for (Uint32 shard = 0; shard < NUMBER_OF_SHARDS; shard++)
+    {
+        for (Uint32 i = 0; i < NUMBER_OF_BUCKETS; i++)
+        {
+            _counts[shard][i].set(0);
+        }
+    }
+}
+
+void StatisticalHistogram::_getCounts(Uint64 counts[NUMBER_OF_BUCKETS]) const
+{
+    for (Uint32 i = 0; i < NUMBER_OF_BUCKETS; i++)
+    {
+        counts[i] = 0;
+        for (Uint32 shard = 0; shard < NUMBER_OF_SHARDS; shard++)
+        {
+            counts[i] += _counts[shard][i].get();
+        }
+    }
+}
+
+Uint64 StatisticalHistogram::getCount() const
+{
+    Uint64 counts[NUMBER_OF_BUCKETS];
+    _getCounts(counts);
+
+    Uint64 total = 0;
+    for (Uint32 i = 0; i < NUMBER_OF_BUCKETS; i++)
+    {
+        total += counts[i];
+    }
+    return total;
+}
+
+Uint64 StatisticalHistogram::getPercentile(Uint32 perMille) const
+{
+    Uint64 counts[NUMBER_OF_BUCKETS];
+    _getCounts(counts);
+
+    Uint64 total = 0;
+    for (Uint32 i = 0; i < NUMBER_OF_BUCKETS; i++)
+    {
+        total += counts[i];
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    // Nearest rank: the smallest value with at least perMille/1000 of the
+    // recorded values at or below it.
+    if (perMille > 1000)
+    {
+        perMille = 1000;
+    }
+    Uint64 rank = (total * perMille + 999) / 1000;
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+
+    Uint64 seen = 0;
+    for (Uint32 i = 0; i < NUMBER_OF_BUCKETS; i++)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            return getBucketHighestValue(i);
+        }
+    }
+
+    return getBucketHighestValue(NUMBER_OF_BUCKETS - 1);
+}
+
+PEGASUS_NAMESPACE_END
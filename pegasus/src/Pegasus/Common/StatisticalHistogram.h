@@ -0,0 +1,124 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#ifndef Pegasus_StatisticalHistogram_h
+#define Pegasus_StatisticalHistogram_h
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/Linkage.h>
+#include <Pegasus/Common/AtomicInt.h>
+
+PEGASUS_NAMESPACE_BEGIN
+
+/**
+    StatisticalHistogram records the distribution of a non-negative value,
+    such as a response time in microseconds or a response size in bytes, so
+    that percentiles can be reported rather than only averages.
+
+    Values are counted in log-linear buckets: values below 16 have a bucket
+    each, larger values are divided into eight buckets per power of two.
+    A reported percentile is therefore within 12.5% of the recorded value.
+    Values of 2^36 and above are counted in the last bucket.
+
+    Recording is lock-free.  The counters are split into shards selected by
+    the recording thread, so that threads recording concurrently rarely
+    update the same counters.  Reading sums the shards and is not atomic
+    with respect to concurrent recording.
+*/
+class PEGASUS_COMMON_LINKAGE StatisticalHistogram
+{
+public:
+
+    enum
+    {
+        NUMBER_OF_SHARDS = 4,
+        NUMBER_OF_BUCKETS = 16 + 32 * 8
+    };
+
+    StatisticalHistogram();
+
+    /**
+        Counts a value.
+     */
+    void record(Uint64 value);
+
+    /**
+        Resets all counts to zero.
+     */
+    void clear();
+
+    /**
+        Returns the number of values recorded.
+     */
+    Uint64 getCount() const;
+
+    /**
+        Returns the value below or at which the given fraction of the
+        recorded values lie, e.g. getPercentile(990) for the 99th
+        percentile.  Returns 0 if no values were recorded.
+
+        @param perMille The percentile in tenths of a percent (0 to 1000).
+     */
+    Uint64 getPercentile(Uint32 perMille) const;
+
+    /**
+        Returns the highest value recorded (within the bucket precision).
+     */
+    Uint64 getMaximum() const
+    {
+        return getPercentile(1000);
+    }
+
+    /**
+        Returns the index of the bucket that counts the given value.
+     */
+    static Uint32 getBucketIndex(Uint64 value);
+
+    /**
+        Returns the highest value counted by the given bucket.
+     */
+    static Uint64 getBucketHighestValue(Uint32 index);
+
+private:
+
+    StatisticalHistogram(const StatisticalHistogram&);
+    StatisticalHistogram& operator=(const StatisticalHistogram&);
+
+    void _getCounts(Uint64 counts[NUMBER_OF_BUCKETS]) const;
+
+    AtomicInt _counts[NUMBER_OF_SHARDS][NUMBER_OF_BUCKETS];
+};
+
+PEGASUS_NAMESPACE_END
+
+#endif /* Pegasus_StatisticalHistogram_h */
@@ -34,6 +34,7 @@
 #include "InternalException.h"
 #include "MessageLoader.h"
 #include "StringRep.h"
+#include "UTF8CString.h"
 #include <Pegasus/Common/Pegasus_inl.h>
 #include <cstdarg>
 
@@ -419,6 +420,31 @@ CString& CString::operator=(const CString& cstr)
     return *this;
 }
 
+//==============================================================================
+//
+// class UTF8CString
+//
+//==============================================================================
+
+UTF8CString::UTF8CString(const String& str)
+{
+    const Uint16* p = (const Uint16*)str.getChar16Data();
+    size_t n = str.size();
+
+#ifdef PEGASUS_STRING_NO_UTF8
+    _data = n < sizeof(_inline) ? _inline : (char*)operator new(n + 1);
+    _copy(_data, p, n);
+    _size = (Uint32)n;
+#else
+    // See String::getCString() for the size of the worst case.
+    _data = 3 * n < sizeof(_inline) ?
+        _inline : (char*)operator new(3 * n + 1);
+    _size = (Uint32)_copyToUTF8(_data, p, n);
+#endif
+
+    _data[_size] = '\0';
+}
+
 //==============================================================================
 //
 // class StringRep
@@ -1043,13 +1069,25 @@ Boolean StringEqualNoCase(const String& s1, const String& s2)
 
 #else /* PEGASUS_HAS_ICU */
 
-    // The following employs loop unrolling for efficiency. Please do not
-    // eliminate.
-
     Uint16* p = (Uint16*)s1.getChar16Data();
     Uint16* q = (Uint16*)s2.getChar16Data();
     Uint32 n = s2.size();
 
+    // Interned names carry their case-folded hash; names whose hashes
+    // differ cannot be equal.
+
+    const StringRep* r1 = StringRep::fromData(p);
+    const StringRep* r2 = StringRep::fromData(q);
+
+    if (StringRep::isInterned(r1) && StringRep::isInterned(r2) &&
+        StringRep::internedHash(r1) != StringRep::internedHash(r2))
+    {
+        return false;
+    }
+
+    // The following employs loop unrolling for efficiency. Please do not
+    // eliminate.
+
     while (n >= 8)
     {
         if (((p[0] - q[0]) && (_toUpper(p[0]) - _toUpper(q[0]))) ||
@@ -165,7 +165,8 @@ PEGASUS_STRING_INLINE Boolean String::equalNoCase(
 #ifdef PEGASUS_HAS_ICU
     return StringEqualNoCase(s1, s2);
 #else
-    return s1._rep->size == s2._rep->size && StringEqualNoCase(s1, s2);
+    return s1._rep == s2._rep ||
+        (s1._rep->size == s2._rep->size && StringEqualNoCase(s1, s2));
 #endif
 }
 
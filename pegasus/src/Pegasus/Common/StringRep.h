@@ -36,6 +36,7 @@
 #include <Pegasus/Common/AtomicInt.h>
 #include <Pegasus/Common/CommonUTF.h>
 #include <new>
+#include <cstddef>
 
 PEGASUS_NAMESPACE_BEGIN
 
@@ -61,6 +62,12 @@ struct PEGASUS_COMMON_LINKAGE StringRep
 
     static void unref(const StringRep* rep);
 
+    static const StringRep* fromData(const Uint16* data);
+
+    static Boolean isInterned(const StringRep* rep);
+
+    static Uint32 internedHash(const StringRep* rep);
+
     static StringRep _emptyRep;
 
     // Number of characters in this string, excluding the null terminator.
@@ -110,6 +117,30 @@ inline void StringRep::unref(const StringRep* rep)
         StringRep::free((StringRep*)rep);
 }
 
+// Interned representations (see CIMNameInterner) are shared by every copy
+// of an interned name. Their reference count is biased by the following
+// amount so that they are never modified in place nor released, and their
+// case-folded hash (as computed by HashLowerCaseFunc) is stored in the two
+// characters following the null terminator.
+#define PEGASUS_STRINGREP_INTERNED_REFS 0x40000000
+
+inline const StringRep* StringRep::fromData(const Uint16* data)
+{
+    return reinterpret_cast<const StringRep*>(
+        reinterpret_cast<const char*>(data) - offsetof(StringRep, data));
+}
+
+inline Boolean StringRep::isInterned(const StringRep* rep)
+{
+    return rep->refs.get() >= PEGASUS_STRINGREP_INTERNED_REFS;
+}
+
+inline Uint32 StringRep::internedHash(const StringRep* rep)
+{
+    const Uint16* p = rep->data + rep->size + 1;
+    return (Uint32(p[0]) << 16) | Uint32(p[1]);
+}
+
 PEGASUS_COMMON_LINKAGE void StringThrowOutOfBounds();
 
 PEGASUS_COMMON_LINKAGE void StringAppendCharAux(StringRep*& _rep);
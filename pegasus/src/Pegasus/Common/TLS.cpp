@@ -37,6 +37,7 @@
 #include <Pegasus/Common/MessageLoader.h>
 #include <Pegasus/Common/FileSystem.h>
 #include <Pegasus/Common/AuditLogger.h>
+#include <Pegasus/Common/Buffer.h>
 
 #include "TLS.h"
 
@@ -76,7 +77,8 @@ SSLSocket::SSLSocket(
    _SSLContext(sslcontext),
    _sslContextObjectLock(sslContextObjectLock),
    _ipAddress(ipAddress),
-   _certificateVerified(false)
+   _certificateVerified(false),
+   _kernelTLSSend(false)
 {
     PEG_METHOD_ENTER(TRC_SSL, "SSLSocket::SSLSocket()");
 
@@ -322,6 +324,110 @@ Sint32 SSLSocket::timedWrite( const void* ptr,
     return totalBytesWritten;
 }
 
+Sint32 SSLSocket::timedWritev(
+    const SocketWriteBuffer* buffers,
+    Uint32 count,
+    Uint32 socketWriteTimeout)
+{
+    PEG_METHOD_ENTER(TRC_SSL, "SSLSocket::timedWritev()");
+
+    // With kernel TLS the kernel builds the records for whatever is written
+    // to the socket, so the buffers go to it unchanged in one gather write.
+    if (_kernelTLSSend)
+    {
+        Sint32 bytesWritten = Socket::timedWritev(
+            _socket, buffers, count, socketWriteTimeout);
+        PEG_METHOD_EXIT();
+        return bytesWritten;
+    }
+
+    // OpenSSL has no gather write, and every SSL_write() produces at least
+    // one TLS record and one socket write. Small buffers such as HTTP
+    // framing are therefore coalesced into full-sized records. Only data
+    // that fills whole records on its own is passed to SSL_write() in place.
+    const Uint32 recordSize = SSL3_RT_MAX_PLAIN_LENGTH;
+    Buffer record(recordSize);
+    Sint32 totalBytesWritten = 0;
+
+    for (Uint32 i = 0; i < count; i++)
+    {
+        const char* data = buffers[i].data;
+        Uint32 size = buffers[i].size;
+
+        if (record.size() > 0 || size < recordSize)
+        {
+            Uint32 n = recordSize - record.size();
+            if (n > size)
+            {
+                n = size;
+            }
+            record.append(data, n);
+            data += n;
+            size -= n;
+
+            if (record.size() < recordSize)
+            {
+                continue;
+            }
+
+            Sint32 bytesWritten = timedWrite(
+                record.getData(), record.size(), socketWriteTimeout);
+            if (bytesWritten < 0)
+            {
+                PEG_METHOD_EXIT();
+                return bytesWritten;
+            }
+            totalBytesWritten += bytesWritten;
+            record.clear();
+        }
+
+        while (size >= recordSize)
+        {
+            Uint32 n = size - size % recordSize;
+            if (n > PEGASUS_SOCKET_MAX_WRITE_SIZE)
+            {
+                n = PEGASUS_SOCKET_MAX_WRITE_SIZE;
+            }
+            Sint32 bytesWritten = timedWrite(data, n, socketWriteTimeout);
+            if (bytesWritten < 0)
+            {
+                PEG_METHOD_EXIT();
+                return bytesWritten;
+            }
+            totalBytesWritten += bytesWritten;
+            data += n;
+            size -= n;
+        }
+
+        record.append(data, size);
+    }
+
+    if (record.size() > 0)
+    {
+        Sint32 bytesWritten = timedWrite(
+            record.getData(), record.size(), socketWriteTimeout);
+        if (bytesWritten < 0)
+        {
+            PEG_METHOD_EXIT();
+            return bytesWritten;
+        }
+        totalBytesWritten += bytesWritten;
+    }
+
+    PEG_METHOD_EXIT();
+    return totalBytesWritten;
+}
+
+void SSLSocket::enableKernelTLS()
+{
+#ifdef SSL_OP_ENABLE_KTLS
+    SSL_set_options(static_cast<SSL*>(_SSLConnection), SSL_OP_ENABLE_KTLS);
+#else
+    PEG_TRACE_CSTRING(TRC_SSL, Tracer::LEVEL3,
+        "---> SSL: Kernel TLS is not supported by this OpenSSL version");
+#endif
+}
+
 void SSLSocket::close()
 {
     PEG_METHOD_ENTER(TRC_SSL, "SSLSocket::close()");
@@ -431,6 +537,17 @@ Sint32 SSLSocket::accept()
     }
     PEG_TRACE_CSTRING(TRC_SSL, Tracer::LEVEL4, "---> SSL: Accepted");
 
+#ifdef SSL_OP_ENABLE_KTLS
+    if (SSL_get_options(sslConnection) & SSL_OP_ENABLE_KTLS)
+    {
+        _kernelTLSSend = BIO_get_ktls_send(SSL_get_wbio(sslConnection));
+        PEG_TRACE((TRC_SSL, Tracer::LEVEL3,
+            "---> SSL: Kernel TLS send offload %s for cipher %s",
+            _kernelTLSSend ? "enabled" : "not available",
+            SSL_get_cipher_name(sslConnection)));
+    }
+#endif
+
     //
     // If peer certificate verification is enabled or request received on
     // export connection, get the peer certificate and verify the trust
@@ -754,6 +871,21 @@ Sint32 MP_Socket::write(const void * ptr, Uint32 size)
         return Socket::timedWrite(_socket,ptr,size,_socketWriteTimeout);
 }
 
+Sint32 MP_Socket::writev(const SocketWriteBuffer* buffers, Uint32 count)
+{
+    if (_isSecure)
+        return _sslsock->timedWritev(buffers, count, _socketWriteTimeout);
+    else
+        return Socket::timedWritev(
+            _socket, buffers, count, _socketWriteTimeout);
+}
+
+void MP_Socket::enableKernelTLS()
+{
+    if (_isSecure)
+        _sslsock->enableKernelTLS();
+}
+
 void MP_Socket::close()
 {
     if (_isSecure)
@@ -874,6 +1006,15 @@ Sint32 MP_Socket::write(const void * ptr, Uint32 size)
     return Socket::timedWrite(_socket,ptr,size,_socketWriteTimeout);
 }
 
+Sint32 MP_Socket::writev(const SocketWriteBuffer* buffers, Uint32 count)
+{
+    return Socket::timedWritev(_socket, buffers, count, _socketWriteTimeout);
+}
+
+void MP_Socket::enableKernelTLS()
+{
+}
+
 void MP_Socket::close()
 {
     Socket::close(_socket);
@@ -66,6 +66,23 @@ public:
                       Uint32 size,
                       Uint32 socketWriteTimeout);
 
+    /**
+        Writes the specified buffers in order, as if they were one
+        contiguous buffer. Small buffers are copied together so that they
+        share TLS records instead of each producing its own.
+    */
+    Sint32 timedWritev(const SocketWriteBuffer* buffers,
+                       Uint32 count,
+                       Uint32 socketWriteTimeout);
+
+    /**
+        Requests kernel TLS offload for the connection. Must be called before
+        accept(). Whether the offload is used depends on the platform, the
+        OpenSSL build and the negotiated cipher; if it is not available the
+        connection silently uses OpenSSL for the record layer.
+    */
+    void enableKernelTLS();
+
     void close();
 
     void disableBlocking();
@@ -120,6 +137,12 @@ private:
     AutoPtr<SSLCallbackInfo> _SSLCallbackInfo;
     String _ipAddress;
     Boolean _certificateVerified;
+
+    /**
+        Set once the handshake has completed with kernel TLS offload for
+        sending. Application data may then be written to the socket directly.
+    */
+    Boolean _kernelTLSSend;
 };
 #else
 
@@ -158,6 +181,18 @@ public:
 
     Sint32 write(const void* ptr, Uint32 size);
 
+    /**
+        Writes the specified buffers in order with a single gather write
+        where possible. See Socket::timedWritev().
+    */
+    Sint32 writev(const SocketWriteBuffer* buffers, Uint32 count);
+
+    /**
+        Requests kernel TLS offload if this is a secure socket. Must be
+        called before accept(). See SSLSocket::enableKernelTLS().
+    */
+    void enableKernelTLS();
+
     void close();
 
     void disableBlocking();
@@ -64,6 +64,12 @@ public:
 
     static Uint32 create(TSDKeyType * key);
 
+    /** Creates a key with a function that is called with the non-null
+        value of the key when a thread exits.  The function is not called
+        on platforms without support for it (Windows).
+     */
+    static Uint32 create(TSDKeyType * key, void (*destructor)(void*));
+
     static Uint32 destroy(TSDKeyType key);
 
     static void* get_thread_specific(TSDKeyType key);
@@ -84,6 +90,11 @@ inline Uint32 TSDKey::create(TSDKeyType* key)
     return pthread_key_create(key, NULL);
 }
 
+inline Uint32 TSDKey::create(TSDKeyType* key, void (*destructor)(void*))
+{
+    return pthread_key_create(key, destructor);
+}
+
 inline Uint32 TSDKey::destroy(TSDKeyType key)
 {
     return pthread_key_delete(key);
@@ -123,6 +134,11 @@ inline Uint32 TSDKey::create(TSDKeyType* key)
         return 0;
 }
 
+inline Uint32 TSDKey::create(TSDKeyType* key, void (*)(void*))
+{
+    return create(key);
+}
+
 inline Uint32 TSDKey::destroy(TSDKeyType key)
 {
     if (TlsFree(key))
@@ -0,0 +1,1732 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <cstddef>
+#include <Pegasus/Common/TraceAsyncHandler.h>
+#include <Pegasus/Common/Tracer.h>
+#include <Pegasus/Common/Thread.h>
+#include <Pegasus/Common/Threads.h>
+#include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/System.h>
+#include <Pegasus/Common/Buffer.h>
+#include <Pegasus/Common/AutoPtr.h>
+
+#if defined(PEGASUS_OS_TYPE_WINDOWS)
+# include <windows.h>
+#endif
+
+PEGASUS_USING_STD;
+
+PEGASUS_NAMESPACE_BEGIN
+
+//==============================================================================
+//
+// Local definitions
+//
+//==============================================================================
+
+// The producer of a ring stores the data of an entry before it advances the
+// head, the writer reads the data before it advances the tail.  The memory
+// barrier keeps the processor from reordering these accesses.
+#if defined(PEGASUS_PLATFORM_WIN64_IA64_MSVC) || \
+    defined(PEGASUS_PLATFORM_WIN64_X86_64_MSVC) || \
+    defined(PEGASUS_PLATFORM_WIN32_IX86_MSVC)
+# define PEGASUS_TRC_MEMORY_BARRIER() MemoryBarrier()
+#elif defined(__GNUC__)
+# define PEGASUS_TRC_MEMORY_BARRIER() __sync_synchronize()
+#else
+static Mutex _barrierMutex;
+PEGASUS_FORK_SAFE_MUTEX(_barrierMutex)
+# define PEGASUS_TRC_MEMORY_BARRIER() \
+    do { _barrierMutex.lock(); _barrierMutex.unlock(); } while (0)
+#endif
+
+// Number of strings each thread remembers to have defined.
+#define PEGASUS_TRC_ASYNC_STRING_CACHE_SIZE 256
+
+// Entries in the ring and in the binary trace file are preceded by their
+// size.  Larger sizes in a binary trace file indicate a corrupted file.
+#define PEGASUS_TRC_ASYNC_MAX_ENTRY_SIZE (1024*1024)
+
+// Guards the list of rings and the output of the writer.  The mutex is
+// recursive, so that the writer can trace while it holds the mutex.  It is
+// held across fork(), so that the child does not inherit partially written
+// entries in the buffer of the trace file.
+static Mutex _asyncTraceMutex;
+
+// The handler installed by the Tracer, flushed at exit and reset after fork.
+static TraceAsyncHandler* _activeHandler = 0;
+static Boolean _processHandlersRegistered = false;
+
+struct TraceAsyncHandler::Ring
+{
+    Ring(Uint32 index_)
+        : head(0), tail(0), dropped(0), reportedDropped(0), orphaned(false),
+          index(index_), stringGeneration(0), next(0)
+    {
+        memset(strings, 0, sizeof(strings));
+        strcpy(threadId, Threads::id().buffer);
+    }
+
+    char buffer[PEGASUS_TRC_ASYNC_RING_SIZE];
+
+    // Free running positions; head is written only by the owning thread,
+    // tail only by the writer.
+    volatile Uint32 head;
+    volatile Uint32 tail;
+
+    // Number of entries dropped because the ring was full, written only
+    // by the owning thread, and the number reported by the writer.
+    volatile Uint32 dropped;
+    Uint32 reportedDropped;
+
+    // Set when the owning thread exits; the writer deletes the ring when
+    // it is empty.
+    volatile Boolean orphaned;
+
+    Uint32 index;
+    char threadId[sizeof(ThreadId)];
+
+    // Addresses of the strings this thread defined, direct mapped, and
+    // the string generation they were defined in.
+    const char* strings[PEGASUS_TRC_ASYNC_STRING_CACHE_SIZE];
+    Uint32 stringGeneration;
+
+    Ring* next;
+};
+
+// Builds an entry in a fixed size buffer.  Data that does not fit sets
+// the overflow flag.
+struct EntryBuilder
+{
+    EntryBuilder(char* data_, Uint32 capacity_)
+        : data(data_), size(0), capacity(capacity_), overflow(false)
+    {
+    }
+
+    void put(const void* p, Uint32 n)
+    {
+        if (overflow || n > capacity - size)
+        {
+            overflow = true;
+            return;
+        }
+        memcpy(data + size, p, n);
+        size += n;
+    }
+
+    void putUint8(Uint8 x)
+    {
+        put(&x, sizeof(x));
+    }
+
+    void putUint32(Uint32 x)
+    {
+        put(&x, sizeof(x));
+    }
+
+    void putUint64(Uint64 x)
+    {
+        put(&x, sizeof(x));
+    }
+
+    char* data;
+    Uint32 size;
+    Uint32 capacity;
+    Boolean overflow;
+};
+
+// Reads the fields of an entry.  Reading beyond the entry sets the
+// overflow flag.
+struct EntryReader
+{
+    EntryReader(const char* data_, Uint32 size_)
+        : data(data_), pos(0), size(size_), overflow(false)
+    {
+    }
+
+    Boolean get(void* p, Uint32 n)
+    {
+        if (overflow || n > size - pos)
+        {
+            overflow = true;
+            memset(p, 0, n);
+            return false;
+        }
+        memcpy(p, data + pos, n);
+        pos += n;
+        return true;
+    }
+
+    Uint8 getUint8()
+    {
+        Uint8 x;
+        get(&x, sizeof(x));
+        return x;
+    }
+
+    Uint32 getUint32()
+    {
+        Uint32 x;
+        get(&x, sizeof(x));
+        return x;
+    }
+
+    Uint64 getUint64()
+    {
+        Uint64 x;
+        get(&x, sizeof(x));
+        return x;
+    }
+
+    const char* data;
+    Uint32 pos;
+    Uint32 size;
+    Boolean overflow;
+};
+
+enum LengthModifier
+{
+    LENGTH_NONE,
+    LENGTH_CHAR,
+    LENGTH_SHORT,
+    LENGTH_LONG,
+    LENGTH_LONG_LONG,
+    LENGTH_INTMAX,
+    LENGTH_SIZE,
+    LENGTH_PTRDIFF,
+    LENGTH_LONG_DOUBLE
+};
+
+// A printf conversion specification.
+struct FormatSpec
+{
+    const char* flags;
+    Uint32 flagsLength;
+    Boolean widthStar;
+    const char* width;
+    Uint32 widthLength;
+    Boolean hasPrecision;
+    Boolean precisionStar;
+    const char* precision;
+    Uint32 precisionLength;
+    Uint32 precisionValue;
+    LengthModifier length;
+    char conversion;
+};
+
+// Parses the conversion specification following a '%'.  Returns a pointer
+// to the character following the specification or 0 if it is incomplete.
+static const char* _parseFormatSpec(const char* p, FormatSpec& spec)
+{
+    spec.flags = p;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0' ||
+           *p == '\'')
+    {
+        p++;
+    }
+    spec.flagsLength = Uint32(p - spec.flags);
+
+    spec.widthStar = (*p == '*');
+    spec.width = p;
+    if (spec.widthStar)
+    {
+        p++;
+    }
+    else
+    {
+        while (*p >= '0' && *p <= '9')
+        {
+            p++;
+        }
+    }
+    spec.widthLength = Uint32(p - spec.width);
+
+    spec.hasPrecision = (*p == '.');
+    spec.precisionStar = false;
+    spec.precisionValue = 0;
+    spec.precision = p;
+    if (spec.hasPrecision)
+    {
+        p++;
+        spec.precision = p;
+        if (*p == '*')
+        {
+            spec.precisionStar = true;
+            p++;
+        }
+        else
+        {
+            while (*p >= '0' && *p <= '9')
+            {
+                spec.precisionValue = spec.precisionValue * 10 + (*p - '0');
+                p++;
+            }
+        }
+    }
+    spec.precisionLength = Uint32(p - spec.precision);
+
+    spec.length = LENGTH_NONE;
+    switch (*p)
+    {
+        case 'h':
+            p++;
+            spec.length = LENGTH_SHORT;
+            if (*p == 'h')
+            {
+                p++;
+                spec.length = LENGTH_CHAR;
+            }
+            break;
+        case 'l':
+            p++;
+            spec.length = LENGTH_LONG;
+            if (*p == 'l')
+            {
+                p++;
+                spec.length = LENGTH_LONG_LONG;
+            }
+            break;
+        case 'q':
+            p++;
+            spec.length = LENGTH_LONG_LONG;
+            break;
+        case 'L':
+            p++;
+            spec.length = LENGTH_LONG_DOUBLE;
+            break;
+        case 'j':
+            p++;
+            spec.length = LENGTH_INTMAX;
+            break;
+        case 'z':
+            p++;
+            spec.length = LENGTH_SIZE;
+            break;
+        case 't':
+            p++;
+            spec.length = LENGTH_PTRDIFF;
+            break;
+        case 'I':
+            if (p[1] == '6' && p[2] == '4')
+            {
+                p += 3;
+                spec.length = LENGTH_LONG_LONG;
+            }
+            else if (p[1] == '3' && p[2] == '2')
+            {
+                p += 3;
+            }
+            else
+            {
+                p++;
+                spec.length = LENGTH_SIZE;
+            }
+            break;
+    }
+
+    if (*p == '\0')
+    {
+        return 0;
+    }
+    spec.conversion = *p;
+    return p + 1;
+}
+
+// Appends the arguments of a format string to a binary trace record.
+// Returns false if the format string contains a conversion that is not
+// supported; the caller then writes the formatted message instead.
+static Boolean _putArguments(
+    EntryBuilder& entry,
+    const char* fmt,
+    va_list argList)
+{
+    const char* p = fmt;
+
+    while ((p = strchr(p, '%')) != 0)
+    {
+        p++;
+        if (*p == '%')
+        {
+            p++;
+            continue;
+        }
+
+        FormatSpec spec;
+        p = _parseFormatSpec(p, spec);
+        if (!p)
+        {
+            return false;
+        }
+
+        if (spec.widthStar)
+        {
+            entry.putUint8(TraceAsyncHandler::ARG_SIGNED);
+            entry.putUint64(Uint64(Sint64(va_arg(argList, int))));
+        }
+
+        Sint32 precision = -1;
+        if (spec.precisionStar)
+        {
+            precision = va_arg(argList, int);
+            entry.putUint8(TraceAsyncHandler::ARG_SIGNED);
+            entry.putUint64(Uint64(Sint64(precision)));
+        }
+        else if (spec.hasPrecision)
+        {
+            precision = Sint32(spec.precisionValue);
+        }
+
+        switch (spec.conversion)
+        {
+            case 'd':
+            case 'i':
+            {
+                Sint64 x;
+                switch (spec.length)
+                {
+                    case LENGTH_LONG:
+                        x = va_arg(argList, long);
+                        break;
+                    case LENGTH_LONG_LONG:
+                    case LENGTH_INTMAX:
+                    case LENGTH_LONG_DOUBLE:
+                        x = va_arg(argList, Sint64);
+                        break;
+                    case LENGTH_SIZE:
+                    case LENGTH_PTRDIFF:
+                        x = va_arg(argList, ptrdiff_t);
+                        break;
+                    default:
+                        x = va_arg(argList, int);
+                        break;
+                }
+                entry.putUint8(TraceAsyncHandler::ARG_SIGNED);
+                entry.putUint64(Uint64(x));
+                break;
+            }
+
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            {
+                Uint64 x;
+                switch (spec.length)
+                {
+                    case LENGTH_LONG:
+                        x = va_arg(argList, unsigned long);
+                        break;
+                    case LENGTH_LONG_LONG:
+                    case LENGTH_INTMAX:
+                    case LENGTH_LONG_DOUBLE:
+                        x = va_arg(argList, Uint64);
+                        break;
+                    case LENGTH_SIZE:
+                    case LENGTH_PTRDIFF:
+                        x = va_arg(argList, size_t);
+                        break;
+                    default:
+                        x = va_arg(argList, unsigned int);
+                        break;
+                }
+                entry.putUint8(TraceAsyncHandler::ARG_UNSIGNED);
+                entry.putUint64(x);
+                break;
+            }
+
+            case 'c':
+            {
+                if (spec.length != LENGTH_NONE)
+                {
+                    return false;
+                }
+                entry.putUint8(TraceAsyncHandler::ARG_SIGNED);
+                entry.putUint64(Uint64(Sint64(va_arg(argList, int))));
+                break;
+            }
+
+            case 'e':
+            case 'E':
+            case 'f':
+            case 'F':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+            {
+                double x;
+                if (spec.length == LENGTH_LONG_DOUBLE)
+                {
+                    x = double(va_arg(argList, long double));
+                }
+                else
+                {
+                    x = va_arg(argList, double);
+                }
+                entry.putUint8(TraceAsyncHandler::ARG_DOUBLE);
+                entry.put(&x, sizeof(x));
+                break;
+            }
+
+            case 's':
+            {
+                if (spec.length != LENGTH_NONE)
+                {
+                    return false;
+                }
+                const char* s = va_arg(argList, const char*);
+                if (!s)
+                {
+                    s = "(null)";
+                }
+
+                // With a precision the string need not be null terminated.
+                Uint32 n = 0;
+                while ((precision < 0 || n < Uint32(precision)) && s[n])
+                {
+                    n++;
+                }
+                if (n > 0xFFFF)
+                {
+                    return false;
+                }
+                Uint16 len = Uint16(n);
+                entry.putUint8(TraceAsyncHandler::ARG_STRING);
+                entry.put(&len, sizeof(len));
+                entry.put(s, n);
+                break;
+            }
+
+            case 'p':
+            {
+                entry.putUint8(TraceAsyncHandler::ARG_POINTER);
+                entry.putUint64(Uint64(size_t(va_arg(argList, void*))));
+                break;
+            }
+
+            default:
+                return false;
+        }
+
+        if (entry.overflow)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Writes the trace message of a binary trace record, formatting the
+// arguments with the conversion specifications of the format string.
+static void _printArguments(FILE* out, const char* fmt, EntryReader& args)
+{
+    const char* p = fmt;
+
+    while (*p)
+    {
+        const char* percent = strchr(p, '%');
+        if (!percent)
+        {
+            fputs(p, out);
+            return;
+        }
+        fwrite(p, 1, percent - p, out);
+        p = percent + 1;
+
+        if (*p == '%')
+        {
+            fputc('%', out);
+            p++;
+            continue;
+        }
+
+        FormatSpec spec;
+        p = _parseFormatSpec(p, spec);
+        if (!p)
+        {
+            fputs(percent, out);
+            return;
+        }
+
+        // Rebuild the specification with the width and precision from the
+        // record and a length modifier that matches the recorded argument.
+        char specBuffer[128];
+        EntryBuilder specBuilder(specBuffer, sizeof(specBuffer) - 1);
+        specBuilder.put("%", 1);
+        specBuilder.put(spec.flags, spec.flagsLength);
+
+        char number[32];
+        if (spec.widthStar)
+        {
+            args.getUint8();
+            sprintf(number, "%d", int(Sint64(args.getUint64())));
+            specBuilder.put(number, Uint32(strlen(number)));
+        }
+        else
+        {
+            specBuilder.put(spec.width, spec.widthLength);
+        }
+
+        if (spec.precisionStar)
+        {
+            args.getUint8();
+            int precision = int(Sint64(args.getUint64()));
+            if (precision >= 0)
+            {
+                sprintf(number, ".%d", precision);
+                specBuilder.put(number, Uint32(strlen(number)));
+            }
+        }
+        else if (spec.hasPrecision)
+        {
+            specBuilder.put(".", 1);
+            specBuilder.put(spec.precision, spec.precisionLength);
+        }
+
+        Uint8 tag = args.getUint8();
+        switch (tag)
+        {
+            case TraceAsyncHandler::ARG_SIGNED:
+            case TraceAsyncHandler::ARG_UNSIGNED:
+            {
+                Uint64 x = args.getUint64();
+                if (spec.conversion == 'c')
+                {
+                    specBuilder.put("c", 1);
+                    specBuilder.data[specBuilder.size] = '\0';
+                    fprintf(out, specBuffer, int(Sint64(x)));
+                }
+                else
+                {
+                    specBuilder.put(PEGASUS_64BIT_CONVERSION_WIDTH,
+                        Uint32(strlen(PEGASUS_64BIT_CONVERSION_WIDTH)));
+                    specBuilder.put(&spec.conversion, 1);
+                    specBuilder.data[specBuilder.size] = '\0';
+                    fprintf(out, specBuffer, x);
+                }
+                break;
+            }
+
+            case TraceAsyncHandler::ARG_DOUBLE:
+            {
+                double x;
+                args.get(&x, sizeof(x));
+                specBuilder.put(&spec.conversion, 1);
+                specBuilder.data[specBuilder.size] = '\0';
+                fprintf(out, specBuffer, x);
+                break;
+            }
+
+            case TraceAsyncHandler::ARG_POINTER:
+            {
+                Uint64 x = args.getUint64();
+                specBuilder.put("p", 1);
+                specBuilder.data[specBuilder.size] = '\0';
+                fprintf(out, specBuffer, (void*)size_t(x));
+                break;
+            }
+
+            case TraceAsyncHandler::ARG_STRING:
+            {
+                Uint16 len;
+                args.get(&len, sizeof(len));
+                if (args.overflow || len > args.size - args.pos)
+                {
+                    args.overflow = true;
+                    break;
+                }
+                char* s = new char[len + 1];
+                memcpy(s, args.data + args.pos, len);
+                s[len] = '\0';
+                args.pos += len;
+                specBuilder.put("s", 1);
+                specBuilder.data[specBuilder.size] = '\0';
+                fprintf(out, specBuffer, s);
+                delete [] s;
+                break;
+            }
+
+            default:
+                args.overflow = true;
+                break;
+        }
+
+        if (args.overflow)
+        {
+            fputs("<missing argument>", out);
+            return;
+        }
+    }
+}
+
+//==============================================================================
+//
+// TraceAsyncHandler
+//
+//==============================================================================
+
+TraceAsyncHandler::TraceAsyncHandler(Boolean binary)
+    : _binary(binary),
+      _rings(0),
+      _nextThreadIndex(1),
+      _ringKey(),
+      _entryBuffer(new char[PEGASUS_TRC_ASYNC_MAX_RECORD_SIZE]),
+      _stringGeneration(0),
+      _fileGeneration(0),
+      _file(0),
+      _writer(0),
+      _writerRunning(false),
+      _writerStarting(false),
+      _stopWriterFlag(false),
+      _writerWakeup(0)
+{
+    TSDKey::create(&_ringKey, _destroyRing);
+
+    if (_binary)
+    {
+        _fileHandler.setFileNameSuffix(PEGASUS_TRC_BINARY_FILE_SUFFIX);
+    }
+
+    AutoMutex lock(_asyncTraceMutex);
+    _activeHandler = this;
+
+    if (!_processHandlersRegistered)
+    {
+        _processHandlersRegistered = true;
+        atexit(_flushAtExit);
+#if defined(PEGASUS_HAVE_PTHREADS) && \
+    !defined(PEGASUS_OS_ZOS) && !defined(PEGASUS_OS_VMS)
+        pthread_atfork(_forkPrepare, _forkParent, _forkChild);
+#endif
+    }
+}
+
+TraceAsyncHandler::~TraceAsyncHandler()
+{
+    _stopWriter();
+
+    AutoMutex lock(_asyncTraceMutex);
+
+    if (_activeHandler == this)
+    {
+        _activeHandler = 0;
+    }
+
+    TSDKey::destroy(_ringKey);
+
+    _drain();
+
+    while (_rings)
+    {
+        Ring* ring = _rings;
+        _rings = ring->next;
+        delete ring;
+    }
+
+    delete [] _entryBuffer;
+}
+
+void TraceAsyncHandler::handleMessage(
+    const char* message,
+    Uint32 msgLen,
+    const char* fmt,
+    va_list argList)
+{
+    Ring* ring = _getRing();
+    if (!ring)
+    {
+        return;
+    }
+
+    // Format the message into a buffer on the stack.  Messages that do not
+    // fit are formatted again into a buffer on the heap.
+    char data[PEGASUS_TRC_ASYNC_MAX_RECORD_SIZE];
+    Uint32 headerSize = _binary ? 1 : 0;
+    data[0] = ENTRY_TEXT;
+
+    va_list ap;
+    va_copy(ap, argList);
+
+    Uint32 available = sizeof(data) - headerSize;
+    if (msgLen < available)
+    {
+        memcpy(data + headerSize, message, msgLen);
+        available -= msgLen;
+        int n = vsnprintf(data + headerSize + msgLen, available, fmt, ap);
+        if (n >= 0 && Uint32(n) < available)
+        {
+            va_end(ap);
+            _put(ring, data, headerSize + msgLen + n);
+            return;
+        }
+    }
+    va_end(ap);
+
+    va_copy(ap, argList);
+    int n = vsnprintf(0, 0, fmt, ap);
+    va_end(ap);
+    if (n < 0)
+    {
+        return;
+    }
+
+    Uint32 size = headerSize + msgLen + n;
+    char* entry = new char[size + 1];
+    entry[0] = ENTRY_TEXT;
+    memcpy(entry + headerSize, message, msgLen);
+    vsnprintf(entry + headerSize + msgLen, n + 1, fmt, argList);
+    _putSynchronously(ring, entry, size);
+    delete [] entry;
+}
+
+void TraceAsyncHandler::handleMessage(const char* message, Uint32 msgLen)
+{
+    Ring* ring = _getRing();
+    if (!ring)
+    {
+        return;
+    }
+
+    char data[PEGASUS_TRC_ASYNC_MAX_RECORD_SIZE];
+    Uint32 headerSize = _binary ? 1 : 0;
+    Uint32 size = headerSize + msgLen;
+
+    char* entry = size <= sizeof(data) ? data : new char[size];
+    entry[0] = ENTRY_TEXT;
+    memcpy(entry + headerSize, message, msgLen);
+
+    if (entry == data)
+    {
+        _put(ring, entry, size);
+    }
+    else
+    {
+        _putSynchronously(ring, entry, size);
+        delete [] entry;
+    }
+}
+
+void TraceAsyncHandler::configurationUpdated()
+{
+    AutoMutex lock(_asyncTraceMutex);
+    _fileHandler.configurationUpdated();
+}
+
+void TraceAsyncHandler::flushTrace()
+{
+    AutoMutex lock(_asyncTraceMutex);
+    _drain();
+}
+
+void TraceAsyncHandler::resetDefinedStrings()
+{
+    AutoMutex lock(_asyncTraceMutex);
+
+    // Write the records that refer to the strings of the library before
+    // other strings are defined at the same addresses.
+    _drain();
+    _stringGeneration++;
+}
+
+void TraceAsyncHandler::setMaxTraceFileSize(Uint32 maxTraceFileSizeBytes)
+{
+    AutoMutex lock(_asyncTraceMutex);
+    _fileHandler.setMaxTraceFileSize(maxTraceFileSizeBytes);
+}
+
+void TraceAsyncHandler::setMaxTraceFileNumber(Uint32 maxTraceFileNumber)
+{
+    AutoMutex lock(_asyncTraceMutex);
+    _fileHandler.setMaxTraceFileNumber(maxTraceFileNumber);
+}
+
+void TraceAsyncHandler::traceBinary(
+    const char* fileName,
+    Uint32 lineNum,
+    TraceComponentId traceComponent,
+    Uint32 traceLevel,
+    const char* fmt,
+    va_list argList)
+{
+    Ring* ring = _getRing();
+    if (!ring)
+    {
+        return;
+    }
+
+    _defineString(ring, fileName);
+    _defineString(ring, fmt);
+
+    Uint32 sec, usec;
+    System::getCurrentTimeUsec(sec, usec);
+
+    char data[PEGASUS_TRC_ASYNC_MAX_RECORD_SIZE];
+    EntryBuilder entry(data, sizeof(data));
+    entry.putUint8(ENTRY_RECORD);
+    entry.putUint32(sec);
+    entry.putUint32(usec);
+    entry.putUint32(ring->index);
+    entry.putUint32(lineNum);
+    entry.putUint8(Uint8(traceComponent));
+    entry.putUint8(Uint8(traceLevel));
+    entry.putUint8(RECORD_FORMAT);
+    entry.putUint64(Uint64(size_t(fileName)));
+    entry.putUint64(Uint64(size_t(fmt)));
+
+    va_list ap;
+    va_copy(ap, argList);
+    Boolean complete = _putArguments(entry, fmt, ap);
+    va_end(ap);
+
+    if (complete && !entry.overflow)
+    {
+        _put(ring, entry.data, entry.size);
+        return;
+    }
+
+    // The record is too large or uses an unsupported conversion; write the
+    // formatted message as a text entry.
+    char header[256];
+    int headerLength = snprintf(
+        header,
+        sizeof(header),
+        "%us-%uus: %s [%u:%s:%s:%u]: ",
+        sec,
+        usec,
+        Tracer::TRACE_COMPONENT_LIST[traceComponent],
+        System::getPID(),
+        Threads::id().buffer,
+        fileName,
+        lineNum);
+    if (headerLength < 0 || headerLength >= int(sizeof(header)))
+    {
+        headerLength = int(strlen(header));
+    }
+    handleMessage(header, Uint32(headerLength), fmt, argList);
+}
+
+void TraceAsyncHandler::traceBinaryMethod(
+    const char* fileName,
+    Uint32 lineNum,
+    TraceComponentId traceComponent,
+    Boolean enter,
+    const char* method)
+{
+    Ring* ring = _getRing();
+    if (!ring)
+    {
+        return;
+    }
+
+    _defineString(ring, fileName);
+    _defineString(ring, method);
+
+    Uint32 sec, usec;
+    System::getCurrentTimeUsec(sec, usec);
+
+    char data[64];
+    EntryBuilder entry(data, sizeof(data));
+    entry.putUint8(ENTRY_RECORD);
+    entry.putUint32(sec);
+    entry.putUint32(usec);
+    entry.putUint32(ring->index);
+    entry.putUint32(lineNum);
+    entry.putUint8(Uint8(traceComponent));
+    entry.putUint8(Uint8(Tracer::LEVEL5));
+    entry.putUint8(enter ? RECORD_METHOD_ENTER : RECORD_METHOD_EXIT);
+    entry.putUint64(Uint64(size_t(fileName)));
+    entry.putUint64(Uint64(size_t(method)));
+    _put(ring, entry.data, entry.size);
+}
+
+TraceAsyncHandler::Ring* TraceAsyncHandler::_getRing()
+{
+    Ring* ring = (Ring*)TSDKey::get_thread_specific(_ringKey);
+    if (ring)
+    {
+        return ring;
+    }
+
+    {
+        AutoMutex lock(_asyncTraceMutex);
+        ring = new Ring(_nextThreadIndex++);
+        ring->next = _rings;
+        _rings = ring;
+    }
+    TSDKey::set_thread_specific(_ringKey, ring);
+
+    if (_binary)
+    {
+        // Define the thread id for the records of this thread.
+        char data[64];
+        EntryBuilder entry(data, sizeof(data));
+        entry.putUint8(ENTRY_THREAD);
+        entry.putUint32(ring->index);
+        const char* id = Threads::id().buffer;
+        entry.put(id, Uint32(strlen(id)));
+        _put(ring, entry.data, entry.size);
+    }
+
+    return ring;
+}
+
+void TraceAsyncHandler::_defineString(Ring* ring, const char* str)
+{
+    Uint32 generation = _stringGeneration;
+    if (ring->stringGeneration != generation)
+    {
+        memset(ring->strings, 0, sizeof(ring->strings));
+        ring->stringGeneration = generation;
+    }
+
+    Uint32 slot = Uint32((size_t(str) >> 3) %
+        PEGASUS_TRC_ASYNC_STRING_CACHE_SIZE);
+    if (ring->strings[slot] == str)
+    {
+        return;
+    }
+
+    char data[PEGASUS_TRC_ASYNC_MAX_RECORD_SIZE];
+    EntryBuilder entry(data, sizeof(data));
+    entry.putUint8(ENTRY_STRING);
+    entry.putUint64(Uint64(size_t(str)));
+    Uint32 n = Uint32(strlen(str));
+    if (n > entry.capacity - entry.size)
+    {
+        n = entry.capacity - entry.size;
+    }
+    entry.put(str, n);
+
+    if (_put(ring, entry.data, entry.size))
+    {
+        ring->strings[slot] = str;
+    }
+}
+
+Boolean TraceAsyncHandler::_put(Ring* ring, const char* entry, Uint32 size)
+{
+    Uint32 head = ring->head;
+    Uint32 used = head - ring->tail;
+    PEGASUS_TRC_MEMORY_BARRIER();
+
+    Uint32 needed = sizeof(Uint32) + size;
+
+    if (needed > PEGASUS_TRC_ASYNC_RING_SIZE - used)
+    {
+        // The writer reports the dropped entries.
+        if (ring->dropped++ == ring->reportedDropped)
+        {
+            _wakeUpWriter();
+        }
+        return false;
+    }
+
+    head = _copyToRing(ring, head, size, entry);
+
+    PEGASUS_TRC_MEMORY_BARRIER();
+    ring->head = head;
+
+    if (!_writerRunning)
+    {
+        _startWriter();
+    }
+    else if (used < PEGASUS_TRC_ASYNC_RING_SIZE / 2 &&
+        used + needed >= PEGASUS_TRC_ASYNC_RING_SIZE / 2)
+    {
+        // Wake up the writer early when the ring fills up.
+        _wakeUpWriter();
+    }
+
+    return true;
+}
+
+Uint32 TraceAsyncHandler::_copyToRing(
+    Ring* ring,
+    Uint32 head,
+    Uint32 size,
+    const char* data)
+{
+    const Uint32 mask = PEGASUS_TRC_ASYNC_RING_SIZE - 1;
+
+    char length[sizeof(Uint32)];
+    memcpy(length, &size, sizeof(Uint32));
+    for (Uint32 i = 0; i < sizeof(Uint32); i++)
+    {
+        ring->buffer[head++ & mask] = length[i];
+    }
+
+    Uint32 offset = head & mask;
+    Uint32 first = PEGASUS_TRC_ASYNC_RING_SIZE - offset;
+    if (first > size)
+    {
+        first = size;
+    }
+    memcpy(ring->buffer + offset, data, first);
+    memcpy(ring->buffer, data + first, size - first);
+
+    return head + size;
+}
+
+void TraceAsyncHandler::_putSynchronously(
+    Ring* ring,
+    const char* entry,
+    Uint32 size)
+{
+    AutoMutex lock(_asyncTraceMutex);
+
+    // Write the entries this thread queued before, to keep them in order.
+    Boolean writing = _beginWrite();
+    _drainRing(ring, writing);
+    if (writing)
+    {
+        _writeEntry(entry, size);
+        _endWrite();
+    }
+}
+
+Boolean TraceAsyncHandler::_drain()
+{
+    Boolean written = false;
+    Ring** link = &_rings;
+
+    while (*link)
+    {
+        Ring* ring = *link;
+
+        if (ring->head != ring->tail ||
+            ring->dropped != ring->reportedDropped)
+        {
+            // Check the file size and roll the file before each ring.
+            Boolean writing = _beginWrite();
+            _drainRing(ring, writing);
+            if (writing)
+            {
+                _endWrite();
+            }
+            written = true;
+        }
+
+        if (ring->orphaned && ring->head == ring->tail &&
+            ring->dropped == ring->reportedDropped)
+        {
+            *link = ring->next;
+            _threads.remove(ring->index);
+            delete ring;
+        }
+        else
+        {
+            link = &ring->next;
+        }
+    }
+
+    return written;
+}
+
+void TraceAsyncHandler::_drainRing(Ring* ring, Boolean writing)
+{
+    const Uint32 mask = PEGASUS_TRC_ASYNC_RING_SIZE - 1;
+
+    Uint32 head = ring->head;
+    PEGASUS_TRC_MEMORY_BARRIER();
+    Uint32 tail = ring->tail;
+
+    while (tail != head)
+    {
+        char length[sizeof(Uint32)];
+        for (Uint32 i = 0; i < sizeof(Uint32); i++)
+        {
+            length[i] = ring->buffer[tail++ & mask];
+        }
+        Uint32 size;
+        memcpy(&size, length, sizeof(Uint32));
+
+        Uint32 offset = tail & mask;
+        Uint32 first = PEGASUS_TRC_ASYNC_RING_SIZE - offset;
+        if (first > size)
+        {
+            first = size;
+        }
+        memcpy(_entryBuffer, ring->buffer + offset, first);
+        memcpy(_entryBuffer + first, ring->buffer, size - first);
+        tail += size;
+
+        PEGASUS_TRC_MEMORY_BARRIER();
+        ring->tail = tail;
+
+        if (writing)
+        {
+            _writeEntry(_entryBuffer, size);
+        }
+    }
+
+    Uint32 dropped = ring->dropped;
+    if (dropped != ring->reportedDropped)
+    {
+        char data[64];
+        EntryBuilder entry(data, sizeof(data));
+        if (_binary)
+        {
+            entry.putUint8(ENTRY_DROPPED);
+            entry.putUint32(ring->index);
+            entry.putUint32(dropped - ring->reportedDropped);
+        }
+        else
+        {
+            entry.size = sprintf(data, "DROPPED %u [%u:%s]",
+                dropped - ring->reportedDropped, System::getPID(),
+                ring->threadId);
+        }
+        ring->reportedDropped = dropped;
+
+        if (writing)
+        {
+            _writeEntry(entry.data, entry.size);
+        }
+    }
+}
+
+Boolean TraceAsyncHandler::_beginWrite()
+{
+    _file = _fileHandler.beginWrite();
+    if (!_file)
+    {
+        return false;
+    }
+
+    if (!_binary)
+    {
+        return true;
+    }
+
+    char data[64];
+
+    if (_fileHandler.getFileGeneration() != _fileGeneration)
+    {
+        // A new trace file was opened.  Write the file header and all
+        // definitions of this process.
+        _fileGeneration = _fileHandler.getFileGeneration();
+
+        EntryBuilder entry(data, sizeof(data));
+        entry.putUint8(ENTRY_FILE);
+        entry.put(
+            PEGASUS_TRC_BINARY_EYE_CATCHER,
+            PEGASUS_TRC_BINARY_EYE_CATCHER_LEN);
+        entry.putUint32(PEGASUS_TRC_BINARY_VERSION);
+        entry.putUint32(0x01020304);
+        entry.putUint32(System::getPID());
+        _writeFileEntry(entry.data, entry.size);
+
+        for (Uint32 i = 0; i < Tracer::_NUM_COMPONENTS; i++)
+        {
+            EntryBuilder component(data, sizeof(data));
+            component.putUint8(ENTRY_COMPONENT);
+            component.putUint8(Uint8(i));
+            const char* name = Tracer::TRACE_COMPONENT_LIST[i];
+            component.put(name, Uint32(strlen(name)));
+            _writeFileEntry(component.data, component.size);
+        }
+
+        for (DefinitionTable::Iterator i = _threads.start(); i; i++)
+        {
+            _writeFileEntry(i.value().getData(), i.value().size());
+        }
+        for (DefinitionTable::Iterator i = _strings.start(); i; i++)
+        {
+            _writeFileEntry(i.value().getData(), i.value().size());
+        }
+
+        // The queued records refer to the definitions written above.
+        // Threads define the strings they use again, so that definitions
+        // of strings no longer used are not carried to every later file.
+        _strings.clear();
+        _stringGeneration++;
+    }
+    else
+    {
+        // Other processes may append to the same file; identify the
+        // process that wrote the following entries.
+        EntryBuilder entry(data, sizeof(data));
+        entry.putUint8(ENTRY_PROCESS);
+        entry.putUint32(System::getPID());
+        _writeFileEntry(entry.data, entry.size);
+    }
+
+    return true;
+}
+
+void TraceAsyncHandler::_endWrite()
+{
+    // Write the batch with a single write, so that batches of processes
+    // sharing the trace file do not interleave.
+    if (_batch.size())
+    {
+        fwrite(_batch.getData(), 1, _batch.size(), _file);
+    }
+    _batch.clear();
+    _fileHandler.endWrite();
+    _file = 0;
+}
+
+void TraceAsyncHandler::_writeEntry(const char* entry, Uint32 size)
+{
+    if (!_binary)
+    {
+        _batch.append(entry, size);
+        _batch.append('\n');
+        return;
+    }
+
+    // Remember the definitions, to repeat them in new trace files.
+    // Strings defined by more than one thread are written only once.
+    EntryReader reader(entry, size);
+    Uint8 type = reader.getUint8();
+    if (type == ENTRY_STRING || type == ENTRY_THREAD)
+    {
+        DefinitionTable& table = type == ENTRY_STRING ? _strings : _threads;
+        Uint64 key = type == ENTRY_STRING ?
+            reader.getUint64() : Uint64(reader.getUint32());
+
+        Buffer* defined;
+        if (table.lookupReference(key, defined))
+        {
+            if (defined->size() == size &&
+                memcmp(defined->getData(), entry, size) == 0)
+            {
+                return;
+            }
+            table.remove(key);
+        }
+        table.insert(key, Buffer(entry, size, 0));
+    }
+
+    _writeFileEntry(entry, size);
+}
+
+void TraceAsyncHandler::_writeFileEntry(const char* entry, Uint32 size)
+{
+    _batch.append((const char*)&size, sizeof(size));
+    _batch.append(entry, size);
+}
+
+void TraceAsyncHandler::_startWriter()
+{
+    if (_writerRunning || _writerStarting)
+    {
+        return;
+    }
+
+    {
+        AutoMutex lock(_asyncTraceMutex);
+        if (_writerRunning || _writerStarting)
+        {
+            return;
+        }
+        // Thread creation may trace; those records are queued and do not
+        // start another writer.
+        _writerStarting = true;
+    }
+
+    _stopWriterFlag = false;
+    _writerWakeup = new Semaphore(0);
+    _writer = new Thread(_writerThread, this, false);
+    if (_writer->run() == PEGASUS_THREAD_OK)
+    {
+        _writerRunning = true;
+    }
+    else
+    {
+        // Write the queued records now; the next record tries again.
+        delete _writer;
+        _writer = 0;
+        delete _writerWakeup;
+        _writerWakeup = 0;
+        flushTrace();
+    }
+    _writerStarting = false;
+}
+
+void TraceAsyncHandler::_wakeUpWriter()
+{
+    if (_writerRunning)
+    {
+        _writerWakeup->signal();
+    }
+    else
+    {
+        _startWriter();
+    }
+}
+
+void TraceAsyncHandler::_stopWriter()
+{
+    if (!_writerRunning)
+    {
+        return;
+    }
+
+    _stopWriterFlag = true;
+    _writerWakeup->signal();
+    _writer->join();
+    delete _writer;
+    _writer = 0;
+    delete _writerWakeup;
+    _writerWakeup = 0;
+    _writerRunning = false;
+}
+
+ThreadReturnType PEGASUS_THREAD_CDECL TraceAsyncHandler::_writerThread(
+    void* parm)
+{
+    Thread* myself = reinterpret_cast<Thread*>(parm);
+    TraceAsyncHandler* handler =
+        reinterpret_cast<TraceAsyncHandler*>(myself->get_parm());
+
+    while (!handler->_stopWriterFlag)
+    {
+        handler->flushTrace();
+        handler->_writerWakeup->time_wait(
+            PEGASUS_TRC_ASYNC_WRITER_INTERVAL_MSEC);
+    }
+
+    handler->flushTrace();
+    return ThreadReturnType(0);
+}
+
+void TraceAsyncHandler::_destroyRing(void* ring)
+{
+    PEGASUS_TRC_MEMORY_BARRIER();
+    reinterpret_cast<Ring*>(ring)->orphaned = true;
+}
+
+void TraceAsyncHandler::_flushAtExit()
+{
+    AutoMutex lock(_asyncTraceMutex);
+    if (_activeHandler)
+    {
+        _activeHandler->_drain();
+    }
+}
+
+void TraceAsyncHandler::_forkPrepare()
+{
+    _asyncTraceMutex.lock();
+}
+
+void TraceAsyncHandler::_forkParent()
+{
+    _asyncTraceMutex.unlock();
+}
+
+void TraceAsyncHandler::_forkChild()
+{
+    // Only the forking thread exists in the child process.  The queued
+    // records are written by a new writer thread.  The Thread and the
+    // Semaphore of the writer of the parent process are abandoned; the
+    // state of the semaphore may refer to the writer thread.
+    if (_activeHandler)
+    {
+        _activeHandler->_writer = 0;
+        _activeHandler->_writerWakeup = 0;
+        _activeHandler->_writerRunning = false;
+        _activeHandler->_writerStarting = false;
+
+        // Start the next batch with the file header and the definitions,
+        // identifying the child process.
+        _activeHandler->_fileGeneration =
+            _activeHandler->_fileHandler.getFileGeneration() - 1;
+    }
+
+    // The thread of the child process does not own the mutex on Linux.
+#if defined(PEGASUS_OS_LINUX)
+    _asyncTraceMutex.reinitialize();
+#else
+    _asyncTraceMutex.unlock();
+#endif
+}
+
+//==============================================================================
+//
+// Decoding of binary trace files
+//
+//==============================================================================
+
+struct TraceAsyncHandler::ProcessDefinitions
+{
+    DefinitionTable strings;
+    DefinitionTable threads;
+};
+
+Boolean TraceAsyncHandler::decodeBinaryTrace(
+    FILE* in,
+    FILE* out,
+    String& error)
+{
+    typedef HashTable<Uint32, ProcessDefinitions*,
+        EqualFunc<Uint32>, HashFunc<Uint32> > ProcessTable;
+
+    // Several processes may write to the same trace file; each has its own
+    // threads and string addresses.
+    ProcessTable processes;
+    ProcessDefinitions* process = 0;
+    Uint32 pid = 0;
+    Array<String> components;
+    Uint64 entries = 0;
+    Boolean decoded = true;
+
+    Uint32 capacity = 4096;
+    AutoArrayPtr<char> buffer(new char[capacity]);
+
+    for (;;)
+    {
+        Uint32 size;
+        size_t n = fread(&size, 1, sizeof(size), in);
+        if (n == 0)
+        {
+            break;
+        }
+        if (n != sizeof(size) || size == 0 ||
+            size > PEGASUS_TRC_ASYNC_MAX_ENTRY_SIZE)
+        {
+            char number[32];
+            sprintf(number, "%u", Uint32(entries));
+            error = "Invalid entry length after entry ";
+            error.append(number);
+            decoded = false;
+            break;
+        }
+
+        if (size > capacity)
+        {
+            capacity = size;
+            buffer.reset(new char[capacity]);
+        }
+        char* data = buffer.get();
+        if (fread(data, 1, size, in) != size)
+        {
+            error = "The last entry of the file is incomplete";
+            decoded = false;
+            break;
+        }
+        entries++;
+
+        EntryReader entry(data, size);
+        Uint8 type = entry.getUint8();
+
+        if (!process && type != ENTRY_FILE)
+        {
+            error = "The file is not a binary trace file";
+            decoded = false;
+            break;
+        }
+
+        if (type == ENTRY_FILE || type == ENTRY_PROCESS)
+        {
+            if (type == ENTRY_FILE)
+            {
+                char eyeCatcher[PEGASUS_TRC_BINARY_EYE_CATCHER_LEN];
+                entry.get(eyeCatcher, sizeof(eyeCatcher));
+                Uint32 version = entry.getUint32();
+                Uint32 byteOrder = entry.getUint32();
+                if (entry.overflow || memcmp(eyeCatcher,
+                        PEGASUS_TRC_BINARY_EYE_CATCHER, sizeof(eyeCatcher)))
+                {
+                    error = "The file is not a binary trace file";
+                    decoded = false;
+                    break;
+                }
+                if (byteOrder != 0x01020304)
+                {
+                    error = "The binary trace file was written on a system "
+                        "with a different byte order";
+                    decoded = false;
+                    break;
+                }
+                if (version != PEGASUS_TRC_BINARY_VERSION)
+                {
+                    error = "Unsupported binary trace file version";
+                    decoded = false;
+                    break;
+                }
+            }
+
+            pid = entry.getUint32();
+            if (!processes.lookup(pid, process))
+            {
+                process = new ProcessDefinitions();
+                processes.insert(pid, process);
+            }
+            else if (type == ENTRY_FILE)
+            {
+                // The process writes all its definitions again.
+                process->strings.clear();
+                process->threads.clear();
+            }
+            continue;
+        }
+
+        switch (type)
+        {
+            case ENTRY_COMPONENT:
+            {
+                Uint32 id = entry.getUint8();
+                while (components.size() <= id)
+                {
+                    components.append(String());
+                }
+                components[id] = String(data + entry.pos, size - entry.pos);
+                break;
+            }
+
+            case ENTRY_THREAD:
+            case ENTRY_STRING:
+            {
+                DefinitionTable& table = type == ENTRY_STRING ?
+                    process->strings : process->threads;
+                Uint64 key = type == ENTRY_STRING ?
+                    entry.getUint64() : Uint64(entry.getUint32());
+                table.remove(key);
+                table.insert(key,
+                    Buffer(data + entry.pos, size - entry.pos, 0));
+                break;
+            }
+
+            case ENTRY_TEXT:
+            {
+                fwrite(data + 1, 1, size - 1, out);
+                fputc('\n', out);
+                break;
+            }
+
+            case ENTRY_DROPPED:
+            {
+                Uint32 index = entry.getUint32();
+                Uint32 count = entry.getUint32();
+                Buffer* thread = 0;
+                process->threads.lookupReference(index, thread);
+                fprintf(out, "DROPPED %u [%u:%s]\n", count, pid,
+                    thread ? thread->getData() : "<unknown>");
+                break;
+            }
+
+            case ENTRY_RECORD:
+            {
+                Uint32 sec = entry.getUint32();
+                Uint32 usec = entry.getUint32();
+                Uint32 index = entry.getUint32();
+                Uint32 line = entry.getUint32();
+                Uint32 component = entry.getUint8();
+                entry.getUint8();
+                Uint32 kind = entry.getUint8();
+                Uint64 fileAddress = entry.getUint64();
+                Uint64 fmtAddress = entry.getUint64();
+                if (entry.overflow)
+                {
+                    error = "Invalid trace record";
+                    decoded = false;
+                    break;
+                }
+
+                Buffer* thread = 0;
+                Buffer* file = 0;
+                Buffer* fmt = 0;
+                process->threads.lookupReference(index, thread);
+                process->strings.lookupReference(fileAddress, file);
+                process->strings.lookupReference(fmtAddress, fmt);
+
+                CString componentName;
+                if (component < components.size())
+                {
+                    componentName = components[component].getCString();
+                }
+                fprintf(out, "%us-%uus: %s [%u:%s:%s:%u]: ",
+                    sec,
+                    usec,
+                    component < components.size() ?
+                        (const char*)componentName : "<unknown>",
+                    pid,
+                    thread ? thread->getData() : "<unknown>",
+                    file ? file->getData() : "<unknown>",
+                    line);
+
+                if (!fmt)
+                {
+                    fprintf(out, "<undefined string 0x%"
+                        PEGASUS_64BIT_CONVERSION_WIDTH "x>", fmtAddress);
+                }
+                else if (kind == RECORD_METHOD_ENTER)
+                {
+                    fprintf(out, "%s %s", Tracer::_METHOD_ENTER_MSG,
+                        fmt->getData());
+                }
+                else if (kind == RECORD_METHOD_EXIT)
+                {
+                    fprintf(out, "%s %s", Tracer::_METHOD_EXIT_MSG,
+                        fmt->getData());
+                }
+                else
+                {
+                    _printArguments(out, fmt->getData(), entry);
+                }
+                fputc('\n', out);
+                break;
+            }
+
+            default:
+                // Skip entries of later versions.
+                break;
+        }
+
+        if (!decoded)
+        {
+            break;
+        }
+    }
+
+    if (decoded && !process)
+    {
+        error = "The file is not a binary trace file";
+        decoded = false;
+    }
+
+    for (ProcessTable::Iterator i = processes.start(); i; i++)
+    {
+        delete i.value();
+    }
+
+    return decoded;
+}
+
+PEGASUS_NAMESPACE_END
@@ -0,0 +1,358 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef Pegasus_TraceAsyncHandler_h
+#define Pegasus_TraceAsyncHandler_h
+
+#include <cstdarg>
+#include <cstdio>
+#include <Pegasus/Common/String.h>
+#include <Pegasus/Common/Linkage.h>
+#include <Pegasus/Common/Tracer.h>
+#include <Pegasus/Common/TraceHandler.h>
+#include <Pegasus/Common/TraceFileHandler.h>
+#include <Pegasus/Common/TSDKey.h>
+#include <Pegasus/Common/Semaphore.h>
+#include <Pegasus/Common/Buffer.h>
+#include <Pegasus/Common/HashTable.h>
+
+PEGASUS_NAMESPACE_BEGIN
+
+class Thread;
+
+// Size of the ring buffer of each tracing thread; must be a power of two.
+#define PEGASUS_TRC_ASYNC_RING_SIZE (64*1024)
+
+// Trace records up to this size are queued, larger ones are written
+// synchronously by the tracing thread.
+#define PEGASUS_TRC_ASYNC_MAX_RECORD_SIZE 4096
+
+// Interval in milliseconds at which an idle writer thread checks the rings.
+#define PEGASUS_TRC_ASYNC_WRITER_INTERVAL_MSEC 10
+
+// Suffix appended to the trace file name for binary traces.
+#define PEGASUS_TRC_BINARY_FILE_SUFFIX ".bin"
+
+// A binary trace file is a sequence of entries, each a Uint32 length of
+// the remaining entry, a type byte and the type-specific fields listed in
+// TraceAsyncHandler::EntryType, in the byte order of the writing system.
+// Strings are not null terminated; their length is implied by the entry
+// length or given as a Uint16.  Each file starts with an ENTRY_FILE.
+#define PEGASUS_TRC_BINARY_EYE_CATCHER "PEGTRBIN"
+#define PEGASUS_TRC_BINARY_EYE_CATCHER_LEN 8
+#define PEGASUS_TRC_BINARY_VERSION 1
+
+/** TraceAsyncHandler implements tracing through per-thread ring buffers
+    that a background writer thread drains to the trace file, so that
+    tracing threads neither lock nor perform file I/O.
+
+    In text mode (traceFacility=Async) messages are formatted by the
+    tracing thread and written in the format of traceFacility=File, using
+    the same file rotation.
+
+    In binary mode (traceFacility=AsyncBinary) the Tracer passes the
+    format string and arguments of a trace statement unformatted, and a
+    compact binary record is queued: timestamp, component, level, the
+    addresses of the source file name and format string, and the raw
+    arguments.  Each thread defines a string the first time it refers to
+    it.  The records are written to the trace file name with the suffix
+    PEGASUS_TRC_BINARY_FILE_SUFFIX and are decoded offline with
+    decodeBinaryTrace() (the cimtrcdecode utility).
+
+    When the ring of a thread is full, records are dropped; the writer
+    writes the number of dropped records of the thread.
+ */
+class PEGASUS_COMMON_LINKAGE TraceAsyncHandler: public TraceHandler
+{
+public:
+
+    /** Binary entry types.
+     */
+    enum EntryType
+    {
+        // Eye catcher, Uint32 version, Uint32 byte order mark 0x01020304,
+        // Uint32 process id.  Starts the definitions of a process.
+        ENTRY_FILE = 'F',
+        // Uint32 process id of the process that wrote the following entries
+        ENTRY_PROCESS = 'P',
+        // Uint8 component id, name
+        ENTRY_COMPONENT = 'C',
+        // Uint32 thread index, thread id
+        ENTRY_THREAD = 'H',
+        // Uint64 address, string
+        ENTRY_STRING = 'S',
+        // Uint32 thread index, Uint32 number of dropped records
+        ENTRY_DROPPED = 'D',
+        // A formatted trace message
+        ENTRY_TEXT = 'T',
+        // Uint32 sec, Uint32 usec, Uint32 thread index, Uint32 line,
+        // Uint8 component, Uint8 level, Uint8 record kind,
+        // Uint64 file address, Uint64 format address, arguments
+        ENTRY_RECORD = 'R'
+    };
+
+    /** Kinds of binary trace records.
+     */
+    enum RecordKind
+    {
+        // Format string and arguments
+        RECORD_FORMAT,
+        // Method entry, the format address is the method name
+        RECORD_METHOD_ENTER,
+        // Method exit, the format address is the method name
+        RECORD_METHOD_EXIT
+    };
+
+    /** Argument type tags of binary trace records.
+     */
+    enum ArgumentTag
+    {
+        ARG_SIGNED = 'i',       // Sint64
+        ARG_UNSIGNED = 'u',     // Uint64
+        ARG_DOUBLE = 'f',       // double
+        ARG_POINTER = 'p',      // Uint64
+        ARG_STRING = 's'        // Uint16 length, characters
+    };
+
+    /** Constructs a TraceAsyncHandler.
+        @param    binary  true to write binary trace records
+     */
+    TraceAsyncHandler(Boolean binary);
+
+    virtual ~TraceAsyncHandler();
+
+    /** Writes message with format string to the tracing facility
+        @param    message  message to be written
+        @param    msgLen   lenght of message without terminating '\0'
+        @param    fmt      printf style format string
+        @param    argList  variable argument list
+     */
+    virtual void handleMessage(const char* message,
+                               Uint32 msgLen,
+                               const char* fmt,
+                               va_list argList);
+
+    /** Writes simple message to the tracing facility.
+        @param    message  message to be written
+        @param    msgLen   lenght of message without terminating '\0'
+     */
+    virtual void handleMessage(const char* message,
+                               Uint32 msgLen);
+
+    /** Informs the message handler that the configuraion
+        of the trace has been updated.
+     */
+    virtual void configurationUpdated();
+
+    /** Writes all queued trace records to the trace file.
+     */
+    virtual void flushTrace();
+
+    /** Returns true if the handler writes binary trace records.
+     */
+    Boolean isBinary() const
+    {
+        return _binary;
+    }
+
+    /** Queues a binary trace record for a format string and arguments.
+        The file name and format string are copied to the trace file when
+        a thread first refers to them and are identified by their address
+        afterwards, so the contents of a string must not change while its
+        address is in use.
+     */
+    void traceBinary(
+        const char* fileName,
+        Uint32 lineNum,
+        TraceComponentId traceComponent,
+        Uint32 traceLevel,
+        const char* fmt,
+        va_list argList);
+
+    /** Queues a binary trace record for a method entry or exit.
+     */
+    void traceBinaryMethod(
+        const char* fileName,
+        Uint32 lineNum,
+        TraceComponentId traceComponent,
+        Boolean enter,
+        const char* method);
+
+    /** Writes all queued trace records and makes all threads define
+        their strings again.  Called when a library is unloaded, since
+        other strings may be loaded at the addresses of its strings.
+     */
+    void resetDefinedStrings();
+
+    /** Sets the maximum trace file size in bytes.
+     */
+    void setMaxTraceFileSize(Uint32 maxTraceFileSizeBytes);
+
+    /** Sets the number of trace files kept when the trace file is rolled.
+     */
+    void setMaxTraceFileNumber(Uint32 maxTraceFileNumber);
+
+    /** Decodes a binary trace file into trace messages in the format
+        written by traceFacility=File.
+        @param    in      binary trace file, positioned at its start
+        @param    out     file the trace messages are written to
+        @param    error   set to a description of the error
+        @return   true if the complete file was decoded
+     */
+    static Boolean decodeBinaryTrace(FILE* in, FILE* out, String& error);
+
+private:
+
+    struct Ring;
+
+    struct HashUint64
+    {
+        static Uint32 hash(Uint64 x)
+        {
+            return Uint32(x >> 4) ^ Uint32(x >> 32);
+        }
+    };
+
+    typedef HashTable<Uint64, Buffer, EqualFunc<Uint64>, HashUint64>
+        DefinitionTable;
+
+    // Definitions of a process, used by decodeBinaryTrace().
+    struct ProcessDefinitions;
+
+    TraceAsyncHandler(const TraceAsyncHandler&);
+    TraceAsyncHandler& operator=(const TraceAsyncHandler&);
+
+    // Returns the ring of the calling thread, creating it if needed.
+    Ring* _getRing();
+
+    // Queues an entry in the ring of the calling thread.  Returns false if
+    // the ring is full and the entry was dropped.
+    Boolean _put(Ring* ring, const char* entry, Uint32 size);
+
+    // Copies a size and an entry to the ring at the head position and
+    // returns the new head position.
+    static Uint32 _copyToRing(
+        Ring* ring,
+        Uint32 head,
+        Uint32 size,
+        const char* entry);
+
+    // Writes an entry that is too large to be queued, after the entries
+    // queued by the calling thread.
+    void _putSynchronously(Ring* ring, const char* entry, Uint32 size);
+
+    // Queues an ENTRY_STRING for the string unless the calling thread
+    // defined it recently in the current string generation.
+    void _defineString(Ring* ring, const char* str);
+
+    // Writes the queued entries of all rings and deletes the rings of
+    // threads that exited.  Returns true if any entries were written.
+    // Called with the mutex locked, like all following methods.
+    Boolean _drain();
+
+    // Writes the queued entries of one ring.  Unless writing is true the
+    // entries are discarded.
+    void _drainRing(Ring* ring, Boolean writing);
+
+    // Starts a batch of entries, opening or rolling the trace file if
+    // needed.  Returns false if the trace file is not open.
+    Boolean _beginWrite();
+
+    // Writes the batch of entries to the trace file.
+    void _endWrite();
+
+    // Adds an entry to the batch.
+    void _writeEntry(const char* entry, Uint32 size);
+
+    // Adds an entry to the batch without recording definitions.
+    void _writeFileEntry(const char* entry, Uint32 size);
+
+    // Starts the writer thread unless it is running.
+    void _startWriter();
+
+    // Wakes up the writer thread, starting it if needed.
+    void _wakeUpWriter();
+
+    // Stops the writer thread after it wrote all queued entries.
+    void _stopWriter();
+
+    static ThreadReturnType PEGASUS_THREAD_CDECL _writerThread(void* parm);
+
+    // Called when a thread exits.
+    static void _destroyRing(void* ring);
+
+    static void _flushAtExit();
+
+    // Called before and after a fork.
+    static void _forkPrepare();
+    static void _forkParent();
+    static void _forkChild();
+
+    Boolean _binary;
+
+    // The rings of all threads that traced, linked through Ring::next.
+    Ring* _rings;
+    Uint32 _nextThreadIndex;
+    TSDKeyType _ringKey;
+
+    // Entry currently written by the writer.
+    char* _entryBuffer;
+
+    // The ENTRY_STRING and ENTRY_THREAD definitions written to the binary
+    // trace file, written again to each new file.  The string definitions
+    // are cleared once they were written to a new file.
+    DefinitionTable _strings;
+    DefinitionTable _threads;
+
+    // Incremented when a library is unloaded and when a new trace file is
+    // opened.  A thread clears the strings it remembers to have defined
+    // when it sees a new generation.
+    volatile Uint32 _stringGeneration;
+
+    // Opens, rolls and flushes the trace file.
+    TraceFileHandler _fileHandler;
+    Uint32 _fileGeneration;
+    FILE* _file;
+    Buffer _batch;
+
+    Thread* _writer;
+    volatile Boolean _writerRunning;
+    volatile Boolean _writerStarting;
+    volatile Boolean _stopWriterFlag;
+    Semaphore* _writerWakeup;
+};
+
+PEGASUS_NAMESPACE_END
+
+#endif /* Pegasus_TraceAsyncHandler_h */
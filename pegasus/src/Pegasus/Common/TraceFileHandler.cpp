@@ -60,7 +60,9 @@ TraceFileHandler::TraceFileHandler():
     _logErrorBitField(0),
     _configHasChanged(true),
     _maxTraceFileSizeBytes(0),
-    _maxTraceFileNumber(0)
+    _maxTraceFileNumber(0),
+    _fileNameSuffix(""),
+    _fileGeneration(0)
 {
 }
 
@@ -113,8 +115,9 @@ void TraceFileHandler::_reConfigure()
         return;
     }
 
-    _fileName = strdup((const char*)Tracer::_getInstance()
-                            ->_traceFile.getCString());
+    String fileName = Tracer::_getInstance()->_traceFile;
+    fileName.append(_fileNameSuffix);
+    _fileName = strdup((const char*)fileName.getCString());
 
     // If a file is already open, close it.
     if (_fileHandle)
@@ -141,6 +144,8 @@ void TraceFileHandler::_reConfigure()
 
 FILE* TraceFileHandler::_openFile(const char* fileName)
 {
+    _fileGeneration++;
+
 #ifdef PEGASUS_OS_VMS
 //    FILE* fileHandle = fopen(fileName,"a+", "shr=get,put,upd");
     FILE* fileHandle = fopen(fileName,"w", "shr=get,put,upd");
@@ -296,4 +301,35 @@ void TraceFileHandler::rollTraceFile(const char* fileName)
     _fileHandle = TraceFileHandler::_openFile(fileName);
 }
 
+void TraceFileHandler::setFileNameSuffix(const char* suffix)
+{
+    _fileNameSuffix = suffix;
+    _configHasChanged = true;
+}
+
+FILE* TraceFileHandler::beginWrite()
+{
+    if (_configHasChanged)
+    {
+        _reConfigure();
+    }
+
+    if (!_fileHandle || !_fileExists(_fileName))
+    {
+        return 0;
+    }
+
+    return _fileHandle;
+}
+
+void TraceFileHandler::endWrite()
+{
+    if (_fileHandle && fflush(_fileHandle) == 0)
+    {
+        // trace messages successful written, reset error log messages
+        // thus allow writing of errors to log again
+        _logErrorBitField = 0;
+    }
+}
+
 PEGASUS_NAMESPACE_END
@@ -133,6 +133,29 @@ public:
      */
     void rollTraceFile(const char* fileName);
 
+    /** Sets a suffix that is appended to the configured trace file name.
+        @param suffix  suffix of the trace file name
+     */
+    void setFileNameSuffix(const char* suffix);
+
+    /** Prepares the trace file for writing a batch of messages, opening
+        or rolling the file if needed.  Used by TraceAsyncHandler, which
+        serializes the calls.
+        @return  handle of the trace file or 0 if it is not open
+     */
+    FILE* beginWrite();
+
+    /** Flushes the messages written after beginWrite().
+     */
+    void endWrite();
+
+    /** Returns a number that changes whenever a trace file is opened.
+     */
+    Uint32 getFileGeneration() const
+    {
+        return _fileGeneration;
+    }
+
     TraceFileHandler();
 
     virtual ~TraceFileHandler();
@@ -142,6 +165,8 @@ private:
     void _reConfigure(void);
     Uint32 _maxTraceFileSizeBytes;
     Uint32 _maxTraceFileNumber;
+    const char* _fileNameSuffix;
+    Uint32 _fileGeneration;
 };
 
 PEGASUS_NAMESPACE_END
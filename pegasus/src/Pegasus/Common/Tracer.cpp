@@ -35,6 +35,7 @@
 #include <Pegasus/Common/TraceFileHandler.h>
 #include <Pegasus/Common/TraceLogHandler.h>
 #include <Pegasus/Common/TraceMemoryHandler.h>
+#include <Pegasus/Common/TraceAsyncHandler.h>
 #include <Pegasus/Common/Thread.h>
 #include <Pegasus/Common/System.h>
 #include <Pegasus/Common/HTTPMessage.h>
@@ -125,6 +126,8 @@ char const* Tracer::TRACE_FACILITY_LIST[] =
     "File",
     "Log",
     "Memory",
+    "Async",
+    "AsyncBinary",
     0
 };
 
@@ -170,7 +173,8 @@ Tracer::Tracer()
     : _traceMemoryBufferSize(PEGASUS_TRC_DEFAULT_BUFFER_SIZE_KB),
       _traceFacility(TRACE_FACILITY_FILE),
       _runningOOP(false),
-      _traceHandler(0)
+      _traceHandler(0),
+      _binaryTraceHandler(0)
 {
 
     // The tracer uses a 64bit field to mask the user configured components.
@@ -199,6 +203,9 @@ void Tracer::_setTraceHandler( Uint32 traceFacility )
 {
     TraceHandler * oldTrcHandler = _traceHandler;
 
+    // Tracing threads must not pass binary records to another handler.
+    _binaryTraceHandler = 0;
+
     switch(traceFacility)
     {
         case TRACE_FACILITY_LOG:
@@ -211,6 +218,20 @@ void Tracer::_setTraceHandler( Uint32 traceFacility )
             _traceHandler = new TraceMemoryHandler();
             break;
 
+        case TRACE_FACILITY_ASYNC:
+            _traceFacility = TRACE_FACILITY_ASYNC;
+            _traceHandler = new TraceAsyncHandler(false);
+            break;
+
+        case TRACE_FACILITY_ASYNC_BINARY:
+        {
+            _traceFacility = TRACE_FACILITY_ASYNC_BINARY;
+            TraceAsyncHandler* handler = new TraceAsyncHandler(true);
+            _traceHandler = handler;
+            _binaryTraceHandler = handler;
+            break;
+        }
+
         case TRACE_FACILITY_FILE:
         default:
             _traceFacility = TRACE_FACILITY_FILE;
@@ -269,6 +290,25 @@ Boolean Tracer::_isValidTraceFile(String fileName)
 ////////////////////////////////////////////////////////////////////////////////
 //Traces the given message - Overloaded for including FileName and Line number
 ////////////////////////////////////////////////////////////////////////////////
+void Tracer::_trace(
+    const char* fileName,
+    const Uint32 lineNum,
+    const TraceComponentId traceComponent,
+    const Uint32 traceLevel,
+    const char* fmt,
+    va_list argList)
+{
+    TraceAsyncHandler* binaryHandler = _getInstance()->_binaryTraceHandler;
+    if (binaryHandler)
+    {
+        binaryHandler->traceBinary(
+            fileName, lineNum, traceComponent, traceLevel, fmt, argList);
+        return;
+    }
+
+    _trace(fileName, lineNum, traceComponent, fmt, argList);
+}
+
 void Tracer::_trace(
     const char* fileName,
     const Uint32 lineNum,
@@ -489,6 +529,18 @@ void Tracer::_traceMethod(
     const char* methodEntryExit,
     const char* method)
 {
+    TraceAsyncHandler* binaryHandler = _getInstance()->_binaryTraceHandler;
+    if (binaryHandler)
+    {
+        binaryHandler->traceBinaryMethod(
+            fileName,
+            lineNum,
+            traceComponent,
+            methodEntryExit == _METHOD_ENTER_MSG,
+            method);
+        return;
+    }
+
     char* message;
 
     //
@@ -1018,6 +1070,15 @@ void Tracer::flushTrace()
     return;
 }
 
+void Tracer::libraryUnloaded()
+{
+    TraceAsyncHandler* binaryHandler = _getInstance()->_binaryTraceHandler;
+    if (binaryHandler)
+    {
+        binaryHandler->resetDefinedStrings();
+    }
+}
+
 
 void Tracer::traceEnter(
     TracerToken& token,
@@ -1108,16 +1169,22 @@ void Tracer::traceCIMException(
 void Tracer::setMaxTraceFileSize(const String &size)
 {
     Tracer *inst = _getInstance();
+    Uint32 traceFileSizeKBytes = 0;
+    StringConversion::decimalStringToUint32(size, traceFileSizeKBytes);
+
     if ( inst->getTraceFacility() == TRACE_FACILITY_FILE )
     {
-        Uint32 traceFileSizeKBytes = 0;
-        StringConversion::decimalStringToUint32(size, traceFileSizeKBytes);
-
         //Safe to typecast here as we know that handler is of type file
         TraceFileHandler *hdlr = (TraceFileHandler*) (inst->_traceHandler);
 
         hdlr->setMaxTraceFileSize(traceFileSizeKBytes*1024);
+    }
+    else if ( inst->getTraceFacility() == TRACE_FACILITY_ASYNC ||
+        inst->getTraceFacility() == TRACE_FACILITY_ASYNC_BINARY )
+    {
+        TraceAsyncHandler *hdlr = (TraceAsyncHandler*) (inst->_traceHandler);
 
+        hdlr->setMaxTraceFileSize(traceFileSizeKBytes*1024);
     }
 }
 
@@ -1126,17 +1193,24 @@ void Tracer::setMaxTraceFileNumber(const String &maxTraceFileNumber)
 {
     Tracer *inst = _getInstance();
 
+    Uint32 numberOfTraceFiles = 0;
+    StringConversion::decimalStringToUint32(maxTraceFileNumber,
+                                            numberOfTraceFiles);
+
     if ( inst->getTraceFacility() == TRACE_FACILITY_FILE )
     {
-        Uint32 numberOfTraceFiles = 0;
-        StringConversion::decimalStringToUint32(maxTraceFileNumber,
-                                                numberOfTraceFiles);
-
         //Safe to typecast here as we know that handler is of type file
         TraceFileHandler *hdlr = (TraceFileHandler*) (inst->_traceHandler);
 
         hdlr->setMaxTraceFileNumber(numberOfTraceFiles);
-     }
+    }
+    else if ( inst->getTraceFacility() == TRACE_FACILITY_ASYNC ||
+        inst->getTraceFacility() == TRACE_FACILITY_ASYNC_BINARY )
+    {
+        TraceAsyncHandler *hdlr = (TraceAsyncHandler*) (inst->_traceHandler);
+
+        hdlr->setMaxTraceFileNumber(numberOfTraceFiles);
+    }
 }
 
 
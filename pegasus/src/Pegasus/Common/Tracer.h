@@ -43,6 +43,8 @@
 
 PEGASUS_NAMESPACE_BEGIN
 
+class TraceAsyncHandler;
+
 /**
     Trace component identifiers.  This list must be kept in sync with the
     TRACE_COMPONENT_LIST in Tracer.cpp.
@@ -133,7 +135,9 @@ public:
     {
         TRACE_FACILITY_FILE = 0,
         TRACE_FACILITY_LOG  = 1,
-        TRACE_FACILITY_MEMORY = 2
+        TRACE_FACILITY_MEMORY = 2,
+        TRACE_FACILITY_ASYNC = 3,
+        TRACE_FACILITY_ASYNC_BINARY = 4
     };
 
 
@@ -239,6 +243,10 @@ public:
         @return TRACE_FACILITY_FILE - if trace facility is file
                 TRACE_FACILITY_LOG - if trace facility is the log
                 TRACE_FACILITY_MEMORY - if trace facility is memory tracing
+                TRACE_FACILITY_ASYNC - if trace facility is asynchronous
+                    file tracing
+                TRACE_FACILITY_ASYNC_BINARY - if trace facility is
+                    asynchronous binary file tracing
     */
     static Uint32 getTraceFacility();
 
@@ -263,6 +271,13 @@ public:
     */
     static void flushTrace();
 
+    /** Informs the tracer that a dynamic library was unloaded.  The
+        AsyncBinary trace facility refers to strings by their address and
+        defines them again, since other strings may be loaded at the
+        addresses of the strings of the library.
+    */
+    static void libraryUnloaded();
+
     /** Traces method entry.
         @param token           TracerToken
         @param fileName        filename of the trace originator
@@ -372,6 +387,7 @@ private:
     Uint32                _traceFacility;
     Boolean               _runningOOP;
     TraceHandler*         _traceHandler;
+    TraceAsyncHandler*    _binaryTraceHandler;
     String                _traceFile;
     String                _oopTraceFileExtension;
 
@@ -409,6 +425,16 @@ private:
         const char* fmt,
         va_list argList);
 
+    // Traces the given message at the given trace level.  The level is
+    // recorded by the AsyncBinary trace facility.
+    static void _trace(
+        const char* fileName,
+        const Uint32 lineNum,
+        const TraceComponentId traceComponent,
+        const Uint32 traceLevel,
+        const char* fmt,
+        va_list argList);
+
     //  Traces the message in the given CIMException object.  The message
     //  to be written to the trace file will include the source filename and
     //  line number of the CIMException originator.
@@ -467,6 +493,7 @@ private:
     friend class TracePropertyOwner;
     friend class TraceMemoryHandler;
     friend class TraceFileHandler;
+    friend class TraceAsyncHandler;
 };
 
 //==============================================================================
@@ -543,6 +570,12 @@ inline void Tracer::flushTrace()
     return;
 }
 
+inline void Tracer::libraryUnloaded()
+{
+    // empty function
+    return;
+}
+
 
 
 #endif /* PEGASUS_REMOVE_TRACE */
@@ -642,7 +675,7 @@ public:
         {
             va_list ap;
             va_start(ap, format);
-            Tracer::_trace(file, line, component, format, ap);
+            Tracer::_trace(file, line, component, level, format, ap);
             va_end(ap);
         }
     }
@@ -0,0 +1,95 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#ifndef Pegasus_UTF8CString_h
+#define Pegasus_UTF8CString_h
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/Linkage.h>
+#include <Pegasus/Common/String.h>
+
+PEGASUS_NAMESPACE_BEGIN
+
+// Size of the inline storage of UTF8CString. Names and most property values
+// fit, even when every character takes three bytes in UTF-8.
+#define PEGASUS_UTF8CSTRING_INLINE_SIZE 256
+
+/**
+    UTF8CString converts a String to a null terminated UTF-8 string, like
+    String::getCString(). Results of up to PEGASUS_UTF8CSTRING_INLINE_SIZE
+    bytes are kept in the object itself instead of on the heap, and the
+    length of the result is known without a strlen(). UTF8CString is meant
+    for the short-lived conversions on the request and response paths,
+    where it is created on the stack.
+*/
+class PEGASUS_COMMON_LINKAGE UTF8CString
+{
+public:
+
+    explicit UTF8CString(const String& str);
+
+    ~UTF8CString()
+    {
+        if (_data != _inline)
+        {
+            operator delete(_data);
+        }
+    }
+
+    operator const char*() const
+    {
+        return _data;
+    }
+
+    /**
+        Returns the number of bytes of the UTF-8 string, excluding the
+        null terminator.
+    */
+    Uint32 size() const
+    {
+        return _size;
+    }
+
+private:
+
+    UTF8CString(const UTF8CString&);
+    UTF8CString& operator=(const UTF8CString&);
+
+    char* _data;
+    Uint32 _size;
+    char _inline[PEGASUS_UTF8CSTRING_INLINE_SIZE];
+};
+
+PEGASUS_NAMESPACE_END
+
+#endif /* Pegasus_UTF8CString_h */
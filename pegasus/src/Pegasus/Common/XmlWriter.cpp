@@ -3265,6 +3265,56 @@ void XmlWriter::appendInstanceEParameter(
     _appendEParamValueElementEnd(out);
 }
 
+void XmlWriter::appendInstanceEParameterBegin(
+    Buffer& out,
+    const char* name,
+    const CIMConstInstance& instance,
+    const Array<CIMName>& excludedProperties)
+{
+    CheckRep(instance._rep);
+    const CIMInstanceRep* rep = instance._rep;
+
+    _appendEParamValueElementBegin(out, name);
+
+    out << STRLIT("<INSTANCE CLASSNAME=\"")
+        << rep->getClassName()
+        << STRLIT("\" >\n");
+
+    for (Uint32 i = 0, n = rep->getQualifierCount(); i < n; i++)
+    {
+        XmlWriter::appendQualifierElement(out, rep->getQualifier(i));
+    }
+
+    for (Uint32 i = 0, n = rep->getPropertyCount(); i < n; i++)
+    {
+        CIMConstProperty property = rep->getProperty(i);
+
+        if (!Contains(excludedProperties, property.getName()))
+        {
+            XmlWriter::appendPropertyElement(out, property);
+        }
+    }
+}
+
+void XmlWriter::appendInstanceEParameterEnd(
+    Buffer& out,
+    const CIMConstInstance& instance,
+    const Array<CIMName>& includedProperties)
+{
+    for (Uint32 i = 0, n = includedProperties.size(); i < n; i++)
+    {
+        Uint32 pos = instance.findProperty(includedProperties[i]);
+
+        if (pos != PEG_NOT_FOUND)
+        {
+            XmlWriter::appendPropertyElement(out, instance.getProperty(pos));
+        }
+    }
+
+    out << STRLIT("</INSTANCE>\n");
+    _appendEParamValueElementEnd(out);
+}
+
 //------------------------------------------------------------------------------
 //
 // _appendSimpleExportRspElementBegin()
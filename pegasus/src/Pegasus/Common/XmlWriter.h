@@ -443,6 +443,31 @@ public:
         const char* name,
         const CIMInstance& instance);
 
+    /**
+        Appends the leading part of an EXPPARAMVALUE element for the
+        specified instance: the element and INSTANCE start tags, the
+        instance qualifiers, and all the properties which are not named
+        in excludedProperties.  The element is completed by a call to
+        appendInstanceEParameterEnd() with the same property names.
+        This allows the leading part to be encoded once and reused for
+        instances which only differ in the excluded properties.
+    */
+    static void appendInstanceEParameterBegin(
+        Buffer& out,
+        const char* name,
+        const CIMConstInstance& instance,
+        const Array<CIMName>& excludedProperties);
+
+    /**
+        Appends the properties of the instance which are named in
+        includedProperties, followed by the INSTANCE and EXPPARAMVALUE
+        end tags.
+    */
+    static void appendInstanceEParameterEnd(
+        Buffer& out,
+        const CIMConstInstance& instance,
+        const Array<CIMName>& includedProperties);
+
     static void appendEMethodRequestHeader(
         Buffer& out,
         const char* requestUri,
@@ -166,6 +166,17 @@ int main(int, char** argv)
         b.getData(), "AAAAAAABBBBBBBCCCCCCC\0\0\0\0\0\0\0", 28) == 0);
     }
 
+    // Test reserveCapacity() and appendReserved()
+    {
+    Buffer b("abc", 3);
+    b.reserveCapacity(b.size() + 23);
+    memcpy(b.getContentPtr() + b.size(), "defghijklmnopqrstuvwxyz", 23);
+    b.appendReserved(23);
+
+    PEGASUS_TEST_ASSERT(b.size() == 26);
+    PEGASUS_TEST_ASSERT(strcmp(b.getData(), "abcdefghijklmnopqrstuvwxyz") == 0);
+    }
+
     // Test append(char,char,char,char) and
     // append(char,char,char,char,char,char,char,char)
     {
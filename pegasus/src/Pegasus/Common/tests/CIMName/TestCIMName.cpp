@@ -33,6 +33,8 @@
 #include <Pegasus/Common/Char16.h>
 #include <Pegasus/Common/CIMName.h>
 #include <Pegasus/Common/CIMNameCast.h>
+#include <Pegasus/Common/CIMNameInterner.h>
+#include <Pegasus/Common/HashTable.h>
 
 #include <Pegasus/Common/PegasusAssert.h>
 
@@ -476,6 +478,102 @@ void runCIMNameCastTests()
 #endif
 }
 
+void runCIMNameInternerTests()
+{
+    String plain("CIM_ManagedElement");
+    Uint32 plainHash = HashLowerCaseFunc::hash(plain);
+
+    // Interning preserves the characters and the case-folded hash.
+    CIMName first = CIMNameInterner::intern(CIMName(plain));
+    PEGASUS_TEST_ASSERT(CIMNameInterner::isInterned(first.getString()));
+    PEGASUS_TEST_ASSERT(!CIMNameInterner::isInterned(plain));
+    PEGASUS_TEST_ASSERT(first.getString() == plain);
+    PEGASUS_TEST_ASSERT(HashLowerCaseFunc::hash(first.getString()) ==
+        plainHash);
+
+    // Interning the same name again yields the same representation.
+    Uint32 size = CIMNameInterner::getSize();
+    CIMName second =
+        CIMNameInterner::intern(CIMName("CIM_ManagedElement"));
+    PEGASUS_TEST_ASSERT(CIMNameInterner::getSize() == size);
+    PEGASUS_TEST_ASSERT(first.getString().getChar16Data() ==
+        second.getString().getChar16Data());
+    PEGASUS_TEST_ASSERT(first == second);
+
+    // Case is preserved; names differing only in case are distinct entries
+    // that still compare and hash as equal.
+    CIMName upper = CIMNameInterner::intern(CIMName("CIM_MANAGEDELEMENT"));
+    PEGASUS_TEST_ASSERT(upper.getString() == "CIM_MANAGEDELEMENT");
+    PEGASUS_TEST_ASSERT(CIMNameInterner::getSize() == size + 1);
+    PEGASUS_TEST_ASSERT(upper == first);
+    PEGASUS_TEST_ASSERT(upper == CIMName(plain));
+    PEGASUS_TEST_ASSERT(HashLowerCaseFunc::hash(upper.getString()) ==
+        plainHash);
+
+    // Interned names of different hash are unequal.
+    CIMName other = CIMNameInterner::intern(CIMName("CIM_ManagedElemenT_"));
+    PEGASUS_TEST_ASSERT(!(other == first));
+    CIMName sameSize = CIMNameInterner::intern(CIMName("CIM_ManagedElemenX"));
+    PEGASUS_TEST_ASSERT(!(sameSize == first));
+    PEGASUS_TEST_ASSERT(!(sameSize == CIMName(plain)));
+
+    // Interned representations are never modified in place.
+    String copy = first.getString();
+    copy.append(Char16('X'));
+    PEGASUS_TEST_ASSERT(copy == "CIM_ManagedElementX");
+    PEGASUS_TEST_ASSERT(first.getString() == plain);
+    PEGASUS_TEST_ASSERT(!CIMNameInterner::isInterned(copy));
+    copy = first.getString();
+    copy.toLower();
+    PEGASUS_TEST_ASSERT(copy == "cim_managedelement");
+    PEGASUS_TEST_ASSERT(first.getString() == plain);
+    copy = first.getString();
+    copy.clear();
+    PEGASUS_TEST_ASSERT(first.getString() == plain);
+
+    // Namespace names, and lookups of interned keys in a case-insensitive
+    // table holding plain keys and vice versa.
+    CIMNamespaceName ns =
+        CIMNameInterner::intern(CIMNamespaceName("root/cimv2"));
+    PEGASUS_TEST_ASSERT(CIMNameInterner::isInterned(ns.getString()));
+    PEGASUS_TEST_ASSERT(ns == CIMNamespaceName("ROOT/CIMV2"));
+
+    typedef HashTable<String, Uint32, EqualNoCaseFunc, HashLowerCaseFunc>
+        Table;
+    Table table;
+    table.insert("Root/CIMV2", 1);
+    table.insert(first.getString(), 2);
+    Uint32 value = 0;
+    PEGASUS_TEST_ASSERT(table.lookup(ns.getString(), value) && value == 1);
+    PEGASUS_TEST_ASSERT(table.lookup(plain, value) && value == 2);
+    PEGASUS_TEST_ASSERT(table.lookup(upper.getString(), value) && value == 2);
+    PEGASUS_TEST_ASSERT(!table.lookup(other.getString(), value));
+
+    // Lookups share the representation of interned names but never add
+    // names to the table.
+    size = CIMNameInterner::getSize();
+    CIMName found = CIMNameInterner::lookup(CIMName("CIM_ManagedElement"));
+    PEGASUS_TEST_ASSERT(CIMNameInterner::isInterned(found.getString()));
+    PEGASUS_TEST_ASSERT(
+        found.getString().getChar16Data() == first.getString().getChar16Data());
+    CIMNamespaceName foundNameSpace =
+        CIMNameInterner::lookup(CIMNamespaceName("root/cimv2"));
+    PEGASUS_TEST_ASSERT(
+        CIMNameInterner::isInterned(foundNameSpace.getString()));
+    CIMName unknown = CIMNameInterner::lookup(CIMName("XYZ_NotInterned"));
+    PEGASUS_TEST_ASSERT(!CIMNameInterner::isInterned(unknown.getString()));
+    PEGASUS_TEST_ASSERT(unknown == CIMName("XYZ_NotInterned"));
+    String unknownString = "XYZ_NotInterned";
+    PEGASUS_TEST_ASSERT(!CIMNameInterner::lookup(unknownString));
+    PEGASUS_TEST_ASSERT(CIMNameInterner::getSize() == size);
+
+    // Empty names are not interned.
+    String empty;
+    CIMNameInterner::intern(empty);
+    PEGASUS_TEST_ASSERT(!CIMNameInterner::isInterned(empty));
+    PEGASUS_TEST_ASSERT(empty.size() == 0);
+}
+
 int main(int, char** argv)
 {
     verbose = getenv("PEGASUS_TEST_VERBOSE") ? true : false;
@@ -485,6 +583,7 @@ int main(int, char** argv)
         runCIMNameConstructorTests();
         runCIMNameAssignmentTests();
         runCIMNameCastTests();
+        runCIMNameInternerTests();
     }
     catch (Exception& e)
     {
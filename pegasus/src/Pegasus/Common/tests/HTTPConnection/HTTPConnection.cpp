@@ -0,0 +1,735 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+/*
+    Tests the request framing of server HTTP connections: requests are sent
+    by a client socket to an HTTPAcceptor and checked as they are forwarded
+    to the output queue, and the responses are checked as the client reads
+    them.
+*/
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/PegasusAssert.h>
+#include <Pegasus/Common/HTTPAcceptor.h>
+#include <Pegasus/Common/HTTPMessage.h>
+#include <Pegasus/Common/HostAddress.h>
+#include <Pegasus/Common/Monitor.h>
+#include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/Network.h>
+#include <Pegasus/Common/Socket.h>
+#include <Pegasus/Common/Thread.h>
+#include <Pegasus/Common/Threads.h>
+#include <Pegasus/Common/TimeValue.h>
+#include <cstdio>
+#include <cstring>
+
+PEGASUS_USING_PEGASUS;
+PEGASUS_USING_STD;
+
+static Boolean verbose;
+
+static void _sendResponse(const HTTPMessage& request, const String& body);
+static String _getBody(const Buffer& message, Boolean chunked);
+
+/* Stands in for the server components behind the connections and keeps
+   the requests they forward, or answers them as they are forwarded.
+   Requests arrive on the monitor thread. */
+class TestRequestQueue : public MessageQueue
+{
+public:
+    TestRequestQueue()
+        : MessageQueue("TestRequestQueue"),
+          _answerRequests(false)
+    {
+    }
+
+    virtual void enqueue(Message* message)
+    {
+        HTTPMessage* request = (HTTPMessage*) message;
+
+        if (_answerRequests)
+        {
+            // Answer with the body of the request from within the call that
+            // forwards it, as the server does for requests it rejects.
+            _sendResponse(*request, _getBody(request->message, false));
+            delete request;
+            return;
+        }
+
+        AutoMutex lock(_mutex);
+        _requests.append(request);
+    }
+
+    void setAnswerRequests(Boolean answerRequests)
+    {
+        _answerRequests = answerRequests;
+    }
+
+    HTTPMessage* waitForRequest()
+    {
+        for (Uint32 i = 0; i < 1000; i++)
+        {
+            {
+                AutoMutex lock(_mutex);
+                if (_requests.size())
+                {
+                    HTTPMessage* request = _requests[0];
+                    _requests.remove(0);
+                    return request;
+                }
+            }
+            Threads::sleep(10);
+        }
+        return 0;
+    }
+
+    Uint32 getRequestCount()
+    {
+        AutoMutex lock(_mutex);
+        return _requests.size();
+    }
+
+private:
+    Mutex _mutex;
+    Array<HTTPMessage*> _requests;
+    Boolean _answerRequests;
+};
+
+static AtomicInt monitorStopped;
+
+static ThreadReturnType PEGASUS_THREAD_CDECL _runMonitor(void* parm)
+{
+    Monitor* monitor = (Monitor*) ((Thread*) parm)->get_parm();
+
+    while (!monitorStopped.get())
+    {
+        monitor->run(100);
+    }
+
+    return ThreadReturnType(0);
+}
+
+static void _append(Buffer& buffer, const char* data)
+{
+    buffer.append(data, (Uint32) strlen(data));
+}
+
+static void _append(Buffer& buffer, const Buffer& data)
+{
+    buffer.append(data.getData(), data.size());
+}
+
+static String _makeBody(Uint32 size)
+{
+    String body;
+    for (Uint32 i = 0; i < size; i++)
+    {
+        body.append(Char16('a' + i % 26));
+    }
+    return body;
+}
+
+static Buffer _makeRequest(const String& body, Boolean acceptTrailers = false)
+{
+    Buffer request;
+    char header[128];
+    sprintf(header,
+        "POST /test HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "%s"
+        "Content-Length: %u\r\n\r\n",
+        acceptTrailers ? "TE: trailers\r\n" : "",
+        (Uint32) body.size());
+    _append(request, header);
+    _append(request, body.getCString());
+    return request;
+}
+
+static Buffer _makeChunkedRequest(
+    const String& body,
+    Uint32 chunkSize,
+    const char* trailer)
+{
+    Buffer request;
+    _append(request,
+        "POST /test HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "Transfer-Encoding: chunked\r\n");
+    if (trailer)
+    {
+        _append(request, "Trailer: X-Test\r\n");
+    }
+    _append(request, "\r\n");
+
+    CString data = body.getCString();
+    for (Uint32 i = 0; i < body.size(); i += chunkSize)
+    {
+        Uint32 size = body.size() - i < chunkSize ? body.size() - i : chunkSize;
+        char chunkLine[32];
+        sprintf(chunkLine, "%x\r\n", size);
+        _append(request, chunkLine);
+        request.append((const char*) data + i, size);
+        _append(request, "\r\n");
+    }
+
+    _append(request, "0\r\n");
+    if (trailer)
+    {
+        _append(request, trailer);
+    }
+    _append(request, "\r\n");
+    return request;
+}
+
+/* Returns the body of a request, which follows the header terminator.
+   A de-chunked request keeps the terminator of its chunk body. */
+static String _getBody(const Buffer& message, Boolean chunked)
+{
+    const char* data = message.getData();
+    const char* body = strstr(data, "\r\n\r\n");
+    PEGASUS_TEST_ASSERT(body);
+    body += 4;
+
+    Uint32 size = message.size() - (Uint32)(body - data);
+    if (chunked)
+    {
+        PEGASUS_TEST_ASSERT(size >= 2 &&
+            strncmp(data + message.size() - 2, "\r\n", 2) == 0);
+        size -= 2;
+    }
+
+    return String(body, size);
+}
+
+class TestClient
+{
+public:
+
+    /* A receive buffer size other than 0 is set before connecting, so
+       that the server can send little data the client does not read. */
+    TestClient(Uint32 port, int receiveBufferSize = 0)
+    {
+        _socket = Socket::createSocket(AF_INET, SOCK_STREAM, 0);
+        PEGASUS_TEST_ASSERT(_socket != PEGASUS_INVALID_SOCKET);
+
+        if (receiveBufferSize)
+        {
+            PEGASUS_TEST_ASSERT(setsockopt(_socket, SOL_SOCKET, SO_RCVBUF,
+                (char*) &receiveBufferSize, sizeof(receiveBufferSize)) == 0);
+        }
+
+        struct sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons((Uint16) port);
+        HostAddress::convertTextToBinary(
+            HostAddress::AT_IPV4, "127.0.0.1", &address.sin_addr.s_addr);
+        PEGASUS_TEST_ASSERT(Socket::timedConnect(
+            _socket, (sockaddr*) &address, sizeof(address), 5000));
+    }
+
+    ~TestClient()
+    {
+        close();
+    }
+
+    void close()
+    {
+        if (_socket != PEGASUS_INVALID_SOCKET)
+        {
+            Socket::close(_socket);
+            _socket = PEGASUS_INVALID_SOCKET;
+        }
+    }
+
+    /* Sends the data in pieces of the specified size, pausing after each
+       piece so that the server reads them separately, or in one write if
+       the size is 0. */
+    void send(const Buffer& data, Uint32 pieceSize = 0)
+    {
+        if (pieceSize == 0)
+        {
+            pieceSize = data.size();
+        }
+
+        for (Uint32 i = 0; i < data.size(); i += pieceSize)
+        {
+            Uint32 size =
+                data.size() - i < pieceSize ? data.size() - i : pieceSize;
+            PEGASUS_TEST_ASSERT(Socket::write(
+                _socket, data.getData() + i, size) == Sint32(size));
+            if (size < data.size())
+            {
+                Threads::sleep(1);
+            }
+        }
+    }
+
+    /* Reads the next response, which must have a content length. */
+    String readResponse()
+    {
+        for (;;)
+        {
+            const char* data = _received.getData();
+            const char* body = strstr(data, "\r\n\r\n");
+            if (body)
+            {
+                const char* length = strstr(data, "Content-Length: ");
+                PEGASUS_TEST_ASSERT(length && length < body);
+                Uint32 bodyOffset = (Uint32)(body - data) + 4;
+                Uint32 messageSize =
+                    bodyOffset + (Uint32) atoi(length + 16);
+
+                if (_received.size() >= messageSize)
+                {
+                    String response(data + bodyOffset,
+                        messageSize - bodyOffset);
+                    _received.remove(0, messageSize);
+                    return response;
+                }
+            }
+
+            fd_set fdread;
+            FD_ZERO(&fdread);
+            FD_SET(_socket, &fdread);
+            struct timeval tv = { 10, 0 };
+            PEGASUS_TEST_ASSERT(
+                select(FD_SETSIZE, &fdread, NULL, NULL, &tv) == 1);
+
+            char buffer[4096];
+            Sint32 n = Socket::read(_socket, buffer, sizeof(buffer));
+            PEGASUS_TEST_ASSERT(n > 0);
+            _received.append(buffer, (Uint32) n);
+        }
+    }
+
+    /* Reads until the server closes the connection and returns the number
+       of bytes read. */
+    Uint32 readToEnd()
+    {
+        Uint32 total = _received.size();
+        _received.clear();
+
+        for (;;)
+        {
+            fd_set fdread;
+            FD_ZERO(&fdread);
+            FD_SET(_socket, &fdread);
+            struct timeval tv = { 10, 0 };
+            PEGASUS_TEST_ASSERT(
+                select(FD_SETSIZE, &fdread, NULL, NULL, &tv) == 1);
+
+            char buffer[65536];
+            Sint32 n = Socket::read(_socket, buffer, sizeof(buffer));
+            if (n <= 0)
+            {
+                return total;
+            }
+            total += (Uint32) n;
+        }
+    }
+
+private:
+
+    SocketHandle _socket;
+    Buffer _received;
+};
+
+/* Waits for the next request forwarded by the connection and checks that
+   it has the specified body. */
+static HTTPMessage* _receiveRequest(
+    TestRequestQueue& queue,
+    const String& body,
+    Boolean chunked)
+{
+    HTTPMessage* request = queue.waitForRequest();
+    PEGASUS_TEST_ASSERT(request);
+
+    String requestBody = _getBody(request->message, chunked);
+    if (verbose)
+    {
+        cout << "Request of " << requestBody.size() << " bytes" << endl;
+    }
+    PEGASUS_TEST_ASSERT(requestBody == body);
+
+    return request;
+}
+
+/* Answers a request on its connection with the specified body. */
+static void _sendResponse(const HTTPMessage& request, const String& body)
+{
+    Buffer response;
+    char header[128];
+    sprintf(header, "HTTP/1.1 200 OK\r\nContent-Length: %u\r\n\r\n",
+        (Uint32) body.size());
+    _append(response, header);
+    _append(response, body.getCString());
+
+    // The queue id of a request identifies its place in the order of the
+    // responses of the connection.
+    MessageQueue* connection = MessageQueue::lookup(request.queueId);
+    PEGASUS_TEST_ASSERT(connection);
+    HTTPMessage* httpMessage = new HTTPMessage(response);
+    httpMessage->dest = request.queueId;
+    connection->enqueue(httpMessage);
+}
+
+/* Checks the next request forwarded by the connection and answers it with
+   its body. */
+static void _checkRequest(
+    TestRequestQueue& queue,
+    const String& body,
+    Boolean chunked)
+{
+    AutoPtr<HTTPMessage> request(_receiveRequest(queue, body, chunked));
+    _sendResponse(*request, body);
+}
+
+/* Sends a message of a chunked response to a request and returns the time
+   it took to write it in milliseconds.  The first message holds the header
+   of the response. */
+static Uint64 _sendResponseChunk(
+    const HTTPMessage& request,
+    Uint32 index,
+    Uint32 size,
+    Boolean isComplete)
+{
+    Buffer response;
+    if (index == 0)
+    {
+        // The content length is padded to the length of the transfer
+        // encoding header that replaces it, as in the responses of the
+        // server.
+        _append(response,
+            "HTTP/1.1 200 OK\r\nContent-Length: 0000000000\r\n\r\n");
+    }
+    _append(response, _makeBody(size).getCString());
+
+    MessageQueue* connection = MessageQueue::lookup(request.queueId);
+    PEGASUS_TEST_ASSERT(connection);
+    HTTPMessage* httpMessage = new HTTPMessage(response);
+    httpMessage->dest = request.queueId;
+    httpMessage->setIndex(index);
+    httpMessage->setComplete(isComplete);
+
+    Uint64 start = TimeValue::getCurrentTime().toMilliseconds();
+    connection->enqueue(httpMessage);
+    return TimeValue::getCurrentTime().toMilliseconds() - start;
+}
+
+/* Waits for the connection with the specified queue id to be removed. */
+static Boolean _waitForClose(Uint32 queueId)
+{
+    for (Uint32 i = 0; i < 500; i++)
+    {
+        if (!MessageQueue::lookup(queueId))
+        {
+            return true;
+        }
+        Threads::sleep(10);
+    }
+    return false;
+}
+
+static void _testChunkedRequests(TestRequestQueue& queue, Uint32 port)
+{
+    TestClient client(port);
+
+    // Chunk lines, data and the final chunk arrive in separate reads.
+    String body = _makeBody(300);
+    client.send(_makeChunkedRequest(body, 10, 0), 5);
+    _checkRequest(queue, body, true);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body);
+
+    // A trailer that arrives in pieces is removed from the body.
+    body = _makeBody(100);
+    client.send(_makeChunkedRequest(body, 30, "X-Test: 1\r\n"), 3);
+    _checkRequest(queue, body, true);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body);
+
+    // Many small chunks read together
+    body = _makeBody(5000);
+    client.send(_makeChunkedRequest(body, 1, 0));
+    _checkRequest(queue, body, true);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body);
+
+    body = _makeBody(20000);
+    client.send(_makeChunkedRequest(body, 7, "X-Test: 1\r\n"), 1000);
+    _checkRequest(queue, body, true);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body);
+
+    PEGASUS_TEST_ASSERT(queue.getRequestCount() == 0);
+}
+
+static void _testPipelinedRequests(TestRequestQueue& queue, Uint32 port)
+{
+    TestClient client(port);
+
+    // Three requests with a content length in one write.  They are
+    // processed at the same time, and the responses are sent in the order
+    // of the requests although they are answered in reverse order.
+    String body1 = _makeBody(50);
+    String body2 = _makeBody(70);
+    String body3 = _makeBody(2000);
+    Buffer requests = _makeRequest(body1);
+    _append(requests, _makeRequest(body2));
+    _append(requests, _makeRequest(body3));
+    client.send(requests);
+
+    AutoPtr<HTTPMessage> request1(_receiveRequest(queue, body1, false));
+    AutoPtr<HTTPMessage> request2(_receiveRequest(queue, body2, false));
+    AutoPtr<HTTPMessage> request3(_receiveRequest(queue, body3, false));
+    PEGASUS_TEST_ASSERT(request1->queueId != request2->queueId);
+    PEGASUS_TEST_ASSERT(request2->queueId != request3->queueId);
+    _sendResponse(*request3, body3);
+    _sendResponse(*request2, body2);
+    Threads::sleep(100);
+    _sendResponse(*request1, body1);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body1);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body2);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body3);
+
+    // A chunked request followed by a request with a content length in the
+    // same read.  The second request must not inherit the transfer encoding
+    // of the first.
+    requests = _makeChunkedRequest(body1, 16, 0);
+    _append(requests, _makeRequest(body2));
+    client.send(requests);
+
+    _checkRequest(queue, body1, true);
+    _checkRequest(queue, body2, false);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body1);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body2);
+
+    // Mixed requests, with the boundaries between them falling anywhere in
+    // the reads
+    requests = _makeRequest(body1);
+    _append(requests, _makeChunkedRequest(body2, 9, "X-Test: 1\r\n"));
+    _append(requests, _makeChunkedRequest(body3, 100, 0));
+    _append(requests, _makeRequest(body3));
+    client.send(requests, 37);
+
+    _checkRequest(queue, body1, false);
+    _checkRequest(queue, body2, true);
+    _checkRequest(queue, body3, true);
+    _checkRequest(queue, body3, false);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body1);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body2);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body3);
+    PEGASUS_TEST_ASSERT(client.readResponse() == body3);
+
+    PEGASUS_TEST_ASSERT(queue.getRequestCount() == 0);
+}
+
+static void _testPipelinedRequestLimit(TestRequestQueue& queue, Uint32 port)
+{
+    TestClient client(port);
+
+    // Only 16 requests of a connection are processed at a time.  The next
+    // one is forwarded when the response to the first has been sent.
+    const Uint32 count = 20;
+    Buffer requests;
+    for (Uint32 i = 0; i < count; i++)
+    {
+        _append(requests, _makeRequest(_makeBody(i + 1)));
+    }
+    client.send(requests);
+
+    Array<HTTPMessage*> received;
+    for (Uint32 i = 0; i < 16; i++)
+    {
+        received.append(_receiveRequest(queue, _makeBody(i + 1), false));
+    }
+    Threads::sleep(200);
+    PEGASUS_TEST_ASSERT(queue.getRequestCount() == 0);
+
+    _sendResponse(*received[0], _makeBody(1));
+    received.append(_receiveRequest(queue, _makeBody(17), false));
+    Threads::sleep(100);
+    PEGASUS_TEST_ASSERT(queue.getRequestCount() == 0);
+
+    // Answer the rest in reverse order; the remaining requests are
+    // forwarded once the responses before them have been sent.
+    for (Uint32 i = 16; i > 0; i--)
+    {
+        _sendResponse(*received[i], _makeBody(i + 1));
+    }
+    for (Uint32 i = 17; i < count; i++)
+    {
+        received.append(_receiveRequest(queue, _makeBody(i + 1), false));
+        _sendResponse(*received[i], _makeBody(i + 1));
+    }
+
+    for (Uint32 i = 0; i < count; i++)
+    {
+        PEGASUS_TEST_ASSERT(client.readResponse() == _makeBody(i + 1));
+        delete received[i];
+    }
+
+    PEGASUS_TEST_ASSERT(queue.getRequestCount() == 0);
+}
+
+static void _testSynchronousResponses(TestRequestQueue& queue, Uint32 port)
+{
+    TestClient client(port);
+
+    // Many pipelined requests that are answered while they are forwarded,
+    // so that each response completes before the next request is handled.
+    const Uint32 count = 500;
+    Buffer requests;
+    for (Uint32 i = 0; i < count; i++)
+    {
+        _append(requests, _makeRequest(_makeBody(i % 40 + 1)));
+    }
+
+    queue.setAnswerRequests(true);
+    client.send(requests);
+
+    for (Uint32 i = 0; i < count; i++)
+    {
+        PEGASUS_TEST_ASSERT(client.readResponse() == _makeBody(i % 40 + 1));
+    }
+    queue.setAnswerRequests(false);
+
+    PEGASUS_TEST_ASSERT(queue.getRequestCount() == 0);
+}
+
+static void _testFailedResponseWrites(TestRequestQueue& queue, Uint32 port)
+{
+    const Uint32 chunkSize = 256 * 1024;
+    const Uint32 chunkCount = 96;
+
+    // A client that closes the connection while the response is sent.
+    // Writing the chunks after it fails at once, they are discarded, and
+    // the connection is closed with the last chunk.
+    {
+        TestClient client(port);
+        client.send(_makeRequest(_makeBody(10), true));
+        AutoPtr<HTTPMessage> request(
+            _receiveRequest(queue, _makeBody(10), false));
+
+        _sendResponseChunk(*request, 0, 1000, false);
+        client.close();
+        Threads::sleep(100);
+
+        for (Uint32 i = 1; i < chunkCount; i++)
+        {
+            PEGASUS_TEST_ASSERT(
+                _sendResponseChunk(*request, i, chunkSize, false) < 500);
+        }
+        Threads::sleep(200);
+        PEGASUS_TEST_ASSERT(MessageQueue::lookup(request->queueId));
+
+        _sendResponseChunk(*request, chunkCount, 1000, true);
+        PEGASUS_TEST_ASSERT(_waitForClose(request->queueId));
+    }
+
+    // A client that stops reading.  A write waits out the socket write
+    // timeout and fails (the send buffer of the socket may grow once or
+    // twice before), the chunks after it are discarded without waiting, and
+    // the connection is closed with the last chunk.
+    {
+        TestClient client(port, 4096);
+        client.send(_makeRequest(_makeBody(10), true));
+        AutoPtr<HTTPMessage> request(
+            _receiveRequest(queue, _makeBody(10), false));
+
+        Uint32 slowChunks = 0;
+        Uint32 lastSlowChunk = 0;
+        for (Uint32 i = 0; i < chunkCount; i++)
+        {
+            Uint64 time = _sendResponseChunk(*request, i, chunkSize, false);
+            if (verbose)
+            {
+                cout << "Chunk " << i << " written in " << time << " ms"
+                    << endl;
+            }
+
+            if (time >= 500)
+            {
+                slowChunks++;
+                lastSlowChunk = i;
+            }
+        }
+        PEGASUS_TEST_ASSERT(slowChunks > 0 && slowChunks <= 4);
+        PEGASUS_TEST_ASSERT(lastSlowChunk + 48 < chunkCount);
+        PEGASUS_TEST_ASSERT(MessageQueue::lookup(request->queueId));
+
+        _sendResponseChunk(*request, chunkCount, 1000, true);
+        PEGASUS_TEST_ASSERT(_waitForClose(request->queueId));
+
+        // The client receives a truncated response that ends at the close
+        PEGASUS_TEST_ASSERT(
+            client.readToEnd() < chunkSize * (lastSlowChunk + 1));
+    }
+
+    PEGASUS_TEST_ASSERT(queue.getRequestCount() == 0);
+}
+
+int main(int, char** argv)
+{
+    verbose = getenv("PEGASUS_TEST_VERBOSE") ? true : false;
+
+    try
+    {
+        Monitor monitor;
+        TestRequestQueue queue;
+
+        // Writes to clients that do not read fail after a second
+        HTTPAcceptor::setSocketWriteTimeout(1);
+
+        AutoPtr<HTTPAcceptor> acceptor(new HTTPAcceptor(
+            &monitor, &queue, HTTPAcceptor::IPV4_CONNECTION, 0, 0));
+        acceptor->bind();
+        Uint32 port = acceptor->getPortNumber();
+
+        Thread monitorThread(_runMonitor, &monitor, false);
+        PEGASUS_TEST_ASSERT(monitorThread.run() == PEGASUS_THREAD_OK);
+
+        _testChunkedRequests(queue, port);
+        _testPipelinedRequests(queue, port);
+        _testPipelinedRequestLimit(queue, port);
+        _testSynchronousResponses(queue, port);
+        _testFailedResponseWrites(queue, port);
+
+        monitorStopped.set(1);
+        monitor.tickle();
+        monitorThread.join();
+        acceptor.reset();
+    }
+    catch (Exception& e)
+    {
+        cerr << "Error: " << e.getMessage() << endl;
+        exit(1);
+    }
+
+    cout << argv[0] << " +++++ passed all tests" << endl;
+
+    return 0;
+}
@@ -503,7 +503,7 @@ void structureSizesTest()
          << sizeof(SCMBKeyBindingSet_Header) << endl;
     PEGASUS_TEST_ASSERT(sizeof(SCMBKeyBindingSet_Header) == 152);
     VCOUT << "SCMBClass_Main      : " << sizeof(SCMBClass_Main) << endl;
-    PEGASUS_TEST_ASSERT(sizeof(SCMBClass_Main) == 600);
+    PEGASUS_TEST_ASSERT(sizeof(SCMBClass_Main) == 608);
     VCOUT << "SCMBInstance_Main   : " << sizeof(SCMBInstance_Main) << endl;
     PEGASUS_TEST_ASSERT(sizeof(SCMBInstance_Main) == 200);
 
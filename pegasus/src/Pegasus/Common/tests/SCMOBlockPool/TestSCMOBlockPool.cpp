@@ -0,0 +1,166 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/PegasusAssert.h>
+#include <Pegasus/Common/SCMOBlockPool.h>
+#include <Pegasus/Common/Exception.h>
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+PEGASUS_USING_PEGASUS;
+PEGASUS_USING_STD;
+
+static Boolean verbose;
+
+#define VCOUT if (verbose) cout
+
+void testGetBlockSize()
+{
+    PEGASUS_TEST_ASSERT(SCMOBlockPool::getBlockSize(0) == 4096);
+    PEGASUS_TEST_ASSERT(SCMOBlockPool::getBlockSize(1) == 4096);
+    PEGASUS_TEST_ASSERT(SCMOBlockPool::getBlockSize(4096) == 4096);
+    PEGASUS_TEST_ASSERT(SCMOBlockPool::getBlockSize(4097) == 8192);
+    PEGASUS_TEST_ASSERT(SCMOBlockPool::getBlockSize(100000) == 131072);
+    PEGASUS_TEST_ASSERT(SCMOBlockPool::getBlockSize(1048576) == 1048576);
+
+    // Larger than the largest size class.
+    PEGASUS_TEST_ASSERT(SCMOBlockPool::getBlockSize(1048577) == 1048577);
+}
+
+void testReuse()
+{
+    // A released block of a pooled size is handed out again.
+    void* block = SCMOBlockPool::allocate(8192);
+    memset(block, 0xAB, 8192);
+    SCMOBlockPool::release(block, 8192);
+
+    void* block2 = SCMOBlockPool::allocate(8192);
+    PEGASUS_TEST_ASSERT(block2 == block);
+
+    // But not for another size class.
+    void* block3 = SCMOBlockPool::allocate(4096);
+    PEGASUS_TEST_ASSERT(block3 != block);
+
+    SCMOBlockPool::release(block2, 8192);
+    SCMOBlockPool::release(block3, 4096);
+
+    // Blocks that are not of a pooled size go to the heap.
+    void* odd = SCMOBlockPool::allocate(5000);
+    SCMOBlockPool::release(odd, 5000);
+
+    // Releasing a null block is a no-op.
+    SCMOBlockPool::release(0, 4096);
+}
+
+void testReallocate()
+{
+    char* block = (char*)SCMOBlockPool::allocate(4096);
+    for (Uint32 i = 0; i < 4096; i++)
+    {
+        block[i] = (char)i;
+    }
+
+    // Pooled to pooled size.
+    block = (char*)SCMOBlockPool::reallocate(block, 4096, 8192);
+    for (Uint32 i = 0; i < 4096; i++)
+    {
+        PEGASUS_TEST_ASSERT(block[i] == (char)i);
+    }
+
+    // Pooled to heap size.
+    block = (char*)SCMOBlockPool::reallocate(block, 8192, 10000);
+    for (Uint32 i = 0; i < 4096; i++)
+    {
+        PEGASUS_TEST_ASSERT(block[i] == (char)i);
+    }
+
+    // Heap to heap size, as for instances received through SCMOStreamer.
+    block = (char*)SCMOBlockPool::reallocate(block, 10000, 20000);
+    for (Uint32 i = 0; i < 4096; i++)
+    {
+        PEGASUS_TEST_ASSERT(block[i] == (char)i);
+    }
+
+    SCMOBlockPool::release(block, 20000);
+}
+
+void testBoundedCache()
+{
+    // Releasing more blocks than the pool keeps must not fail.
+    const Uint32 count = 1000;
+    void* blocks[count];
+    for (Uint32 i = 0; i < count; i++)
+    {
+        blocks[i] = SCMOBlockPool::allocate(4096);
+    }
+    for (Uint32 i = 0; i < count; i++)
+    {
+        SCMOBlockPool::release(blocks[i], 4096);
+    }
+    for (Uint32 i = 0; i < count; i++)
+    {
+        blocks[i] = SCMOBlockPool::allocate(4096);
+        memset(blocks[i], 0, 4096);
+    }
+    for (Uint32 i = 0; i < count; i++)
+    {
+        SCMOBlockPool::release(blocks[i], 4096);
+    }
+}
+
+int main(int, char** argv)
+{
+    verbose = getenv("PEGASUS_TEST_VERBOSE") ? true : false;
+
+    try
+    {
+        VCOUT << "testGetBlockSize" << endl;
+        testGetBlockSize();
+        VCOUT << "testReuse" << endl;
+        testReuse();
+        VCOUT << "testReallocate" << endl;
+        testReallocate();
+        VCOUT << "testBoundedCache" << endl;
+        testBoundedCache();
+    }
+    catch (Exception& e)
+    {
+        cerr << argv[0] << " Exception " << e.getMessage() << endl;
+        exit(1);
+    }
+
+    cout << argv[0] << " +++++ passed all tests" << endl;
+    return 0;
+}
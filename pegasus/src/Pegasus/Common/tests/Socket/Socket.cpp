@@ -0,0 +1,578 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+/*
+    Tests the gather writes of Socket and SSLSocket.  The buffers are written
+    to one end of a socket pair with a small send buffer while a thread reads
+    the other end slowly, so that the writes stop and resume at arbitrary
+    places in the buffers.  The data read must be the buffers in order.
+*/
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/PegasusAssert.h>
+#include <Pegasus/Common/Network.h>
+#include <Pegasus/Common/Buffer.h>
+#include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/Socket.h>
+#include <Pegasus/Common/Thread.h>
+#include <Pegasus/Common/Threads.h>
+#include <Pegasus/Common/TimeValue.h>
+#ifdef PEGASUS_HAS_SSL
+# include <Pegasus/Common/TLS.h>
+#endif
+#include <cstring>
+
+PEGASUS_USING_PEGASUS;
+PEGASUS_USING_STD;
+
+static Boolean verbose;
+
+#ifdef PEGASUS_OS_TYPE_UNIX
+
+// Size of the data read from a socket at a time by the slow readers
+static const Uint32 readSize = 1000;
+
+// Maximum amount of data in one TLS record
+static const Uint32 recordSize = 16384;
+
+// Sizes of the buffers of one gather write.  There are more buffers than
+// are passed to one writev() call, some of them empty, and some larger
+// than a single socket write.
+static const Uint32 bufferSizes[] =
+{
+    0, 1, 0, 5, 100, 0, 7000, 3, 65536 + 17, 2, 0, 150000, 1, 1, 1, 16383,
+    16384, 16385, 0, 0, 4096, 7, 131072, 9, 0, 65535, 65536, 11, 20000, 0
+};
+
+static const Uint32 bufferCount =
+    sizeof(bufferSizes) / sizeof(bufferSizes[0]);
+
+/* Builds data of the specified size whose content differs at every
+   position of a buffer, so that data that is lost, repeated or reordered
+   is detected. */
+static Buffer _makeData(Uint32 size)
+{
+    Buffer data(size);
+    for (Uint32 i = 0; i < size; i++)
+    {
+        data.append(char(i % 251 + i / 251 % 3));
+    }
+    return data;
+}
+
+/* Splits data into buffers of the specified sizes and returns their total
+   size. */
+static Uint32 _makeBuffers(
+    const Buffer& data,
+    const Uint32* sizes,
+    Uint32 count,
+    SocketWriteBuffer* buffers)
+{
+    Uint32 offset = 0;
+    for (Uint32 i = 0; i < count; i++)
+    {
+        buffers[i].data = data.getData() + offset;
+        buffers[i].size = sizes[i];
+        offset += sizes[i];
+    }
+    PEGASUS_TEST_ASSERT(offset <= data.size());
+    return offset;
+}
+
+static void _createSocketPair(SocketHandle sockets[2], int sendBufferSize)
+{
+    PEGASUS_TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+
+    if (sendBufferSize)
+    {
+        PEGASUS_TEST_ASSERT(setsockopt(sockets[0], SOL_SOCKET, SO_SNDBUF,
+            (char*) &sendBufferSize, sizeof(sendBufferSize)) == 0);
+    }
+}
+
+/* Reads a socket in small pieces until it is closed. */
+class SlowReader
+{
+public:
+
+    SlowReader(SocketHandle socket)
+        : _socket(socket),
+#ifdef PEGASUS_HAS_SSL
+          _sslSocket(0),
+#endif
+          _thread(_run, this, false)
+    {
+    }
+
+#ifdef PEGASUS_HAS_SSL
+    /* Connects the SSL socket and then reads it. */
+    SlowReader(SSLSocket* sslSocket)
+        : _socket(PEGASUS_INVALID_SOCKET),
+          _sslSocket(sslSocket),
+          _thread(_run, this, false)
+    {
+    }
+#endif
+
+    void start()
+    {
+        PEGASUS_TEST_ASSERT(_thread.run() == PEGASUS_THREAD_OK);
+    }
+
+    void join()
+    {
+        _thread.join();
+    }
+
+    /* Waits until the specified number of bytes has been read in total. */
+    void waitFor(Uint32 size)
+    {
+        for (Uint32 i = 0; i < 3000 && getSize() < size; i++)
+        {
+            Threads::sleep(10);
+        }
+        PEGASUS_TEST_ASSERT(getSize() == size);
+    }
+
+    Uint32 getSize()
+    {
+        AutoMutex lock(_mutex);
+        return _received.size();
+    }
+
+    /* Checks that the data read from the specified offset on is the
+       specified data. */
+    void check(Uint32 offset, const char* data, Uint32 size)
+    {
+        AutoMutex lock(_mutex);
+        PEGASUS_TEST_ASSERT(offset + size == _received.size());
+        PEGASUS_TEST_ASSERT(
+            memcmp(_received.getData() + offset, data, size) == 0);
+    }
+
+private:
+
+    static ThreadReturnType PEGASUS_THREAD_CDECL _run(void* parm)
+    {
+        SlowReader* reader = (SlowReader*) ((Thread*) parm)->get_parm();
+        char buffer[readSize];
+
+#ifdef PEGASUS_HAS_SSL
+        if (reader->_sslSocket)
+        {
+            PEGASUS_TEST_ASSERT(reader->_sslSocket->connect(5000) == 1);
+        }
+#endif
+
+        for (;;)
+        {
+            Sint32 n;
+#ifdef PEGASUS_HAS_SSL
+            if (reader->_sslSocket)
+            {
+                n = reader->_sslSocket->read(buffer, sizeof(buffer));
+            }
+            else
+#endif
+            {
+                n = Socket::read(reader->_socket, buffer, sizeof(buffer));
+            }
+
+            if (n <= 0)
+            {
+                break;
+            }
+
+            {
+                AutoMutex lock(reader->_mutex);
+                reader->_received.append(buffer, (Uint32) n);
+            }
+            Threads::sleep(1);
+        }
+
+        return ThreadReturnType(0);
+    }
+
+    SocketHandle _socket;
+#ifdef PEGASUS_HAS_SSL
+    SSLSocket* _sslSocket;
+#endif
+    Thread _thread;
+    Mutex _mutex;
+    Buffer _received;
+};
+
+/* Writes the buffers and checks that the reader receives them in order. */
+static void _checkWrite(
+    SlowReader& reader,
+    Sint32 (*write)(const SocketWriteBuffer*, Uint32, void*),
+    void* writer,
+    const Buffer& data,
+    const Uint32* sizes,
+    Uint32 count)
+{
+    SocketWriteBuffer buffers[bufferCount];
+    PEGASUS_TEST_ASSERT(count <= bufferCount);
+    Uint32 size = _makeBuffers(data, sizes, count, buffers);
+    Uint32 offset = reader.getSize();
+
+    PEGASUS_TEST_ASSERT(write(buffers, count, writer) == Sint32(size));
+
+    reader.waitFor(offset + size);
+    reader.check(offset, data.getData(), size);
+
+    if (verbose)
+    {
+        cout << "Wrote " << count << " buffers, " << size << " bytes" << endl;
+    }
+}
+
+static Sint32 _writeSocket(
+    const SocketWriteBuffer* buffers,
+    Uint32 count,
+    void* writer)
+{
+    return Socket::timedWritev(*(SocketHandle*) writer, buffers, count, 10);
+}
+
+static void _testSocketWritev()
+{
+    SocketHandle sockets[2];
+    _createSocketPair(sockets, 4096);
+    Socket::disableBlocking(sockets[0]);
+
+    SlowReader reader(sockets[1]);
+    reader.start();
+
+    Buffer data = _makeData(1024 * 1024);
+
+    // All the buffers in one write
+    _checkWrite(reader, _writeSocket, &sockets[0],
+        data, bufferSizes, bufferCount);
+
+    // Exactly as many buffers as one writev() takes, all small
+    static const Uint32 smallSizes[] =
+        { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+    _checkWrite(reader, _writeSocket, &sockets[0], data, smallSizes, 16);
+
+    // Empty buffers only, and no buffers at all
+    static const Uint32 emptySizes[] = { 0, 0, 0 };
+    _checkWrite(reader, _writeSocket, &sockets[0], data, emptySizes, 3);
+    _checkWrite(reader, _writeSocket, &sockets[0], data, emptySizes, 0);
+
+    // A single buffer larger than one socket write
+    static const Uint32 largeSizes[] = { 300000 };
+    _checkWrite(reader, _writeSocket, &sockets[0], data, largeSizes, 1);
+
+    Socket::close(sockets[0]);
+    reader.join();
+    Socket::close(sockets[1]);
+
+    // The write fails once the peer has not read for the timeout
+    _createSocketPair(sockets, 4096);
+    Socket::disableBlocking(sockets[0]);
+
+    SocketWriteBuffer buffers[bufferCount];
+    _makeBuffers(data, bufferSizes, bufferCount, buffers);
+    Uint64 start = TimeValue::getCurrentTime().toMilliseconds();
+    PEGASUS_TEST_ASSERT(Socket::timedWritev(
+        sockets[0], buffers, bufferCount, 1) == PEGASUS_SOCKET_ERROR);
+    PEGASUS_TEST_ASSERT(
+        TimeValue::getCurrentTime().toMilliseconds() - start >= 900);
+
+    Socket::close(sockets[0]);
+    Socket::close(sockets[1]);
+}
+
+#ifdef PEGASUS_HAS_SSL
+
+/* Passes the data between the two SSL sockets, slowly in the direction
+   of the writer to the reader, and keeps the sizes of the TLS records the
+   writer sends. */
+class RecordRelay
+{
+public:
+
+    RecordRelay(SocketHandle writerSide, SocketHandle readerSide)
+        : _writerSide(writerSide),
+          _readerSide(readerSide),
+          _headerSize(0),
+          _recordRemaining(0),
+          _thread(_run, this, false)
+    {
+        PEGASUS_TEST_ASSERT(_thread.run() == PEGASUS_THREAD_OK);
+    }
+
+    void join()
+    {
+        _thread.join();
+    }
+
+    Uint32 getRecordCount()
+    {
+        AutoMutex lock(_mutex);
+        return _recordSizes.size();
+    }
+
+    /* Returns the number of application data records sent since the
+       specified count, and checks that all but the last are full. */
+    Uint32 getFullRecords(Uint32 start)
+    {
+        AutoMutex lock(_mutex);
+        Uint32 count = _recordSizes.size() - start;
+        for (Uint32 i = start; i + 1 < _recordSizes.size(); i++)
+        {
+            // A record holds its data, and with the current cipher suites
+            // up to 256 bytes of padding, authentication tag and header.
+            PEGASUS_TEST_ASSERT(_recordSizes[i] >= recordSize);
+            PEGASUS_TEST_ASSERT(_recordSizes[i] <= recordSize + 256);
+        }
+        return count;
+    }
+
+private:
+
+    /* Parses the record headers in the data sent by the writer. */
+    void _parseRecords(const unsigned char* data, Uint32 size)
+    {
+        while (size)
+        {
+            if (_recordRemaining)
+            {
+                Uint32 n = size < _recordRemaining ? size : _recordRemaining;
+                _recordRemaining -= n;
+                data += n;
+                size -= n;
+                continue;
+            }
+
+            _header[_headerSize++] = *data++;
+            size--;
+
+            if (_headerSize == 5)
+            {
+                _recordRemaining = (Uint32(_header[3]) << 8) | _header[4];
+                _headerSize = 0;
+
+                // Application data, which TLS 1.3 also uses for the
+                // encrypted messages after the handshake
+                if (_header[0] == 23)
+                {
+                    AutoMutex lock(_mutex);
+                    _recordSizes.append(_recordRemaining);
+                }
+            }
+        }
+    }
+
+    static Boolean _forward(SocketHandle from, SocketHandle to, char* buffer,
+        Uint32 size)
+    {
+        Sint32 n = Socket::read(from, buffer, size);
+        if (n <= 0)
+        {
+            return false;
+        }
+        PEGASUS_TEST_ASSERT(Socket::write(to, buffer, (Uint32) n) == n);
+        return true;
+    }
+
+    static ThreadReturnType PEGASUS_THREAD_CDECL _run(void* parm)
+    {
+        RecordRelay* relay = (RecordRelay*) ((Thread*) parm)->get_parm();
+        char buffer[8192];
+
+        for (;;)
+        {
+            fd_set fdread;
+            FD_ZERO(&fdread);
+            FD_SET(relay->_writerSide, &fdread);
+            FD_SET(relay->_readerSide, &fdread);
+            struct timeval tv = { 30, 0 };
+            PEGASUS_TEST_ASSERT(
+                select(FD_SETSIZE, &fdread, NULL, NULL, &tv) > 0);
+
+            if (FD_ISSET(relay->_readerSide, &fdread))
+            {
+                if (!_forward(relay->_readerSide, relay->_writerSide,
+                        buffer, sizeof(buffer)))
+                {
+                    break;
+                }
+            }
+
+            if (FD_ISSET(relay->_writerSide, &fdread))
+            {
+                Sint32 n = Socket::read(relay->_writerSide, buffer, readSize);
+                if (n <= 0)
+                {
+                    break;
+                }
+                relay->_parseRecords((const unsigned char*) buffer, n);
+                PEGASUS_TEST_ASSERT(
+                    Socket::write(relay->_readerSide, buffer, n) == n);
+                Threads::sleep(1);
+            }
+        }
+
+        // Let the reader see the end of the connection
+        shutdown(relay->_readerSide, SHUT_WR);
+
+        return ThreadReturnType(0);
+    }
+
+    SocketHandle _writerSide;
+    SocketHandle _readerSide;
+    unsigned char _header[5];
+    Uint32 _headerSize;
+    Uint32 _recordRemaining;
+    Mutex _mutex;
+    Array<Uint32> _recordSizes;
+    Thread _thread;
+};
+
+static Sint32 _writeSSLSocket(
+    const SocketWriteBuffer* buffers,
+    Uint32 count,
+    void* writer)
+{
+    return ((SSLSocket*) writer)->timedWritev(buffers, count, 10);
+}
+
+/* Writes the buffers and checks the number of TLS records used. */
+static void _checkSSLWrite(
+    SlowReader& reader,
+    RecordRelay& relay,
+    SSLSocket& writer,
+    const Buffer& data,
+    const Uint32* sizes,
+    Uint32 count)
+{
+    Uint32 start = relay.getRecordCount();
+    _checkWrite(reader, _writeSSLSocket, &writer, data, sizes, count);
+
+    Uint32 size = 0;
+    for (Uint32 i = 0; i < count; i++)
+    {
+        size += sizes[i];
+    }
+
+    // The buffers are coalesced into full records
+    PEGASUS_TEST_ASSERT(
+        relay.getFullRecords(start) == (size + recordSize - 1) / recordSize);
+}
+
+static void _testSSLSocketWritev()
+{
+    String certPath(getenv("PEGASUS_ROOT"));
+    certPath.append("/src/Server/cert.pem");
+    String keyPath(getenv("PEGASUS_ROOT"));
+    keyPath.append("/src/Server/file.pem");
+
+    SSLContext serverContext(String(), certPath, keyPath, 0, String());
+    SSLContext clientContext(String(), 0, String());
+    ReadWriteSem contextLock;
+
+    SocketHandle writerPair[2];
+    SocketHandle readerPair[2];
+    _createSocketPair(writerPair, 4096);
+    _createSocketPair(readerPair, 0);
+
+    RecordRelay relay(writerPair[1], readerPair[0]);
+
+    SSLSocket writer(writerPair[0], &serverContext, &contextLock, "writer");
+    SSLSocket* readerSocket = new SSLSocket(
+        readerPair[1], &clientContext, &contextLock, "reader");
+    SlowReader reader(readerSocket);
+    reader.start();
+
+    PEGASUS_TEST_ASSERT(writer.accept() == 1);
+    writer.disableBlocking();
+
+    Buffer data = _makeData(1024 * 1024);
+
+    // Let the messages the writer sends after the handshake pass before
+    // the records are counted
+    static const Uint32 oneSize[] = { 1 };
+    _checkWrite(reader, _writeSSLSocket, &writer, data, oneSize, 1);
+
+    _checkSSLWrite(reader, relay, writer, data, bufferSizes, bufferCount);
+
+    // Many small buffers go into one record
+    static const Uint32 smallSizes[] =
+        { 100, 0, 200, 300, 400, 500, 600, 700, 800, 900, 1000, 0, 1, 2, 3,
+          4, 5, 6, 7, 8, 9, 10 };
+    _checkSSLWrite(reader, relay, writer, data, smallSizes,
+        sizeof(smallSizes) / sizeof(smallSizes[0]));
+
+    // Data that is not aligned to records after small buffers
+    static const Uint32 mixedSizes[] = { 100, 100000, 5, 32768 };
+    _checkSSLWrite(reader, relay, writer, data, mixedSizes, 4);
+
+    // Whole records written in place, and empty buffers only
+    static const Uint32 recordSizes[] = { 32768, 0, 16384 * 5 };
+    _checkSSLWrite(reader, relay, writer, data, recordSizes, 3);
+    static const Uint32 emptySizes[] = { 0, 0 };
+    _checkSSLWrite(reader, relay, writer, data, emptySizes, 2);
+
+    writer.close();
+    relay.join();
+    reader.join();
+    delete readerSocket;
+    Socket::close(writerPair[1]);
+    Socket::close(readerPair[0]);
+}
+
+#endif /* PEGASUS_HAS_SSL */
+
+#endif /* PEGASUS_OS_TYPE_UNIX */
+
+int main(int, char** argv)
+{
+    verbose = getenv("PEGASUS_TEST_VERBOSE") ? true : false;
+
+#ifdef PEGASUS_OS_TYPE_UNIX
+    try
+    {
+        _testSocketWritev();
+#ifdef PEGASUS_HAS_SSL
+        _testSSLSocketWritev();
+#endif
+    }
+    catch (Exception& e)
+    {
+        cerr << "Error: " << e.getMessage() << endl;
+        exit(1);
+    }
+#endif
+
+    cout << argv[0] << " +++++ passed all tests" << endl;
+
+    return 0;
+}
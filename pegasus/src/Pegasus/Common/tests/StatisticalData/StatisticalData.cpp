@@ -89,6 +89,60 @@ PEGASUS_TEST_ASSERT(sd->numCalls[5] == curr->numCalls[5]);
 PEGASUS_TEST_ASSERT(sd->requestSize[6] == curr->requestSize[6]);
 
 
+//****************************************************
+// check the distributions recorded while gathering is enabled
+
+sd->clear();
+for (Sint64 i = 1; i <= 100; i++)
+{
+    sd->addToValue(i, CIM_GET_INSTANCE_RESPONSE_MESSAGE,
+        StatisticalData::PEGASUS_STATDATA_PROVIDER);
+}
+const StatisticalHistogram& h = sd->histograms[StatisticalData::GET_INSTANCE][
+    StatisticalData::PEGASUS_STATDATA_PROVIDER];
+PEGASUS_TEST_ASSERT(h.getCount() == 100);
+PEGASUS_TEST_ASSERT(h.getPercentile(500) >= 50 && h.getPercentile(500) <= 56);
+PEGASUS_TEST_ASSERT(h.getMaximum() >= 100 && h.getMaximum() <= 103);
+PEGASUS_TEST_ASSERT(sd->histograms[StatisticalData::GET_INSTANCE][
+    StatisticalData::PEGASUS_STATDATA_SERVER].getCount() == 0);
+
+// response chunk statistics are kept as distributions only
+Sint64 providerTime = sd->providerTime[StatisticalData::ENUMERATE_INSTANCES];
+sd->addToValue(100, CIM_ENUMERATE_INSTANCES_REQUEST_MESSAGE,
+    StatisticalData::PEGASUS_STATDATA_CHUNK_OBJECTS);
+sd->addToValue(65536, CIM_ENUMERATE_INSTANCES_REQUEST_MESSAGE,
+    StatisticalData::PEGASUS_STATDATA_CHUNK_SIZE);
+PEGASUS_TEST_ASSERT(sd->histograms[StatisticalData::ENUMERATE_INSTANCES][
+    StatisticalData::PEGASUS_STATDATA_CHUNK_OBJECTS].getCount() == 1);
+PEGASUS_TEST_ASSERT(sd->histograms[StatisticalData::ENUMERATE_INSTANCES][
+    StatisticalData::PEGASUS_STATDATA_CHUNK_SIZE].getMaximum() >= 65536);
+PEGASUS_TEST_ASSERT(sd->numCalls[StatisticalData::ENUMERATE_INSTANCES] == 0);
+PEGASUS_TEST_ASSERT(
+    sd->providerTime[StatisticalData::ENUMERATE_INSTANCES] == providerTime);
+
+sd->addProviderModuleValue("ModuleA", 10);
+sd->addProviderModuleValue("ModuleB", 1000);
+sd->addProviderModuleValue("ModuleA", 20);
+PEGASUS_TEST_ASSERT(sd->getProviderModuleCount() == 2);
+PEGASUS_TEST_ASSERT(sd->getProviderModuleName(0) == "ModuleA");
+PEGASUS_TEST_ASSERT(sd->getProviderModuleHistogram(0).getCount() == 2);
+PEGASUS_TEST_ASSERT(sd->getProviderModuleHistogram(1).getCount() == 1);
+VCOUT << "ModuleB p50 = "
+      << sd->getProviderModuleHistogram(1).getPercentile(500) << endl;
+
+// clear() resets the distributions but keeps the modules
+sd->clear();
+PEGASUS_TEST_ASSERT(h.getCount() == 0);
+PEGASUS_TEST_ASSERT(sd->getProviderModuleCount() == 2);
+PEGASUS_TEST_ASSERT(sd->getProviderModuleHistogram(0).getCount() == 0);
+
+// Nothing is recorded while gathering is disabled
+sd->setCopyGSD(0);
+sd->addProviderModuleValue("ModuleA", 10);
+sd->addProviderModuleValue("ModuleC", 10);
+PEGASUS_TEST_ASSERT(sd->getProviderModuleCount() == 2);
+PEGASUS_TEST_ASSERT(sd->getProviderModuleHistogram(0).getCount() == 0);
+
 //**************************
 
     cout << argv[0] << " +++++ passed all tests" << endl;
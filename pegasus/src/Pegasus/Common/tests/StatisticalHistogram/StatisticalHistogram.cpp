@@ -0,0 +1,176 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#include <Pegasus/Common/PegasusAssert.h>
+#include <Pegasus/Common/StatisticalHistogram.h>
+#include <Pegasus/Common/Thread.h>
+#include <iostream>
+#include <cstdlib>
+
+PEGASUS_USING_PEGASUS;
+PEGASUS_USING_STD;
+
+static Boolean verbose;
+
+static StatisticalHistogram _shared;
+
+static const Uint32 NUM_THREADS = 8;
+static const Uint32 VALUES_PER_THREAD = 100000;
+
+static ThreadReturnType PEGASUS_THREAD_CDECL _recordThread(void*)
+{
+    for (Uint32 i = 0; i < VALUES_PER_THREAD; i++)
+    {
+        _shared.record(i % 1000);
+    }
+    return 0;
+}
+
+// Every value lies in the bucket whose highest value is the smallest one
+// not below it, and that value is within 12.5% of it.
+static void testBuckets()
+{
+    Uint32 lastIndex = 0;
+    for (Uint64 value = 0; value < 100000; value++)
+    {
+        Uint32 index = StatisticalHistogram::getBucketIndex(value);
+        Uint64 high = StatisticalHistogram::getBucketHighestValue(index);
+
+        PEGASUS_TEST_ASSERT(index == lastIndex || index == lastIndex + 1);
+        PEGASUS_TEST_ASSERT(high >= value);
+        PEGASUS_TEST_ASSERT(high - value <= value / 8);
+        if (index > 0)
+        {
+            PEGASUS_TEST_ASSERT(
+                StatisticalHistogram::getBucketHighestValue(index - 1) <
+                    value);
+        }
+        lastIndex = index;
+    }
+
+    // Values below 16 are exact
+    for (Uint32 i = 0; i < 16; i++)
+    {
+        PEGASUS_TEST_ASSERT(StatisticalHistogram::getBucketIndex(i) == i);
+        PEGASUS_TEST_ASSERT(StatisticalHistogram::getBucketHighestValue(i) == i);
+    }
+
+    // Values beyond the range are counted in the last bucket
+    PEGASUS_TEST_ASSERT(
+        StatisticalHistogram::getBucketIndex(PEGASUS_UINT64_LITERAL(1) << 40) ==
+            StatisticalHistogram::NUMBER_OF_BUCKETS - 1);
+    PEGASUS_TEST_ASSERT(
+        StatisticalHistogram::getBucketIndex(Uint64(-1)) ==
+            StatisticalHistogram::NUMBER_OF_BUCKETS - 1);
+}
+
+static void testPercentiles()
+{
+    StatisticalHistogram h;
+
+    PEGASUS_TEST_ASSERT(h.getCount() == 0);
+    PEGASUS_TEST_ASSERT(h.getPercentile(500) == 0);
+    PEGASUS_TEST_ASSERT(h.getMaximum() == 0);
+
+    h.record(7);
+    PEGASUS_TEST_ASSERT(h.getCount() == 1);
+    PEGASUS_TEST_ASSERT(h.getPercentile(0) == 7);
+    PEGASUS_TEST_ASSERT(h.getPercentile(999) == 7);
+    PEGASUS_TEST_ASSERT(h.getMaximum() == 7);
+
+    h.clear();
+
+    // 990 fast values and 10 slow ones: the slow tail shows from the
+    // 99.9th percentile only
+    for (Uint32 i = 0; i < 990; i++)
+    {
+        h.record(10);
+    }
+    for (Uint32 i = 0; i < 10; i++)
+    {
+        h.record(50000);
+    }
+
+    PEGASUS_TEST_ASSERT(h.getCount() == 1000);
+    PEGASUS_TEST_ASSERT(h.getPercentile(500) == 10);
+    PEGASUS_TEST_ASSERT(h.getPercentile(990) == 10);
+    PEGASUS_TEST_ASSERT(h.getPercentile(999) >= 50000);
+    PEGASUS_TEST_ASSERT(h.getPercentile(999) <= 50000 + 50000 / 8);
+    PEGASUS_TEST_ASSERT(h.getMaximum() == h.getPercentile(999));
+
+    if (verbose)
+    {
+        cout << "p50 = " << h.getPercentile(500)
+             << " p99.9 = " << h.getPercentile(999)
+             << " max = " << h.getMaximum() << endl;
+    }
+
+    h.clear();
+    PEGASUS_TEST_ASSERT(h.getCount() == 0);
+}
+
+// No counts are lost when threads record concurrently
+static void testConcurrentRecording()
+{
+    Thread* threads[NUM_THREADS];
+
+    for (Uint32 i = 0; i < NUM_THREADS; i++)
+    {
+        threads[i] = new Thread(_recordThread, 0, false);
+        threads[i]->run();
+    }
+
+    for (Uint32 i = 0; i < NUM_THREADS; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    PEGASUS_TEST_ASSERT(_shared.getCount() == NUM_THREADS * VALUES_PER_THREAD);
+
+    Uint64 median = _shared.getPercentile(500);
+    PEGASUS_TEST_ASSERT(median >= 499 && median <= 499 + 499 / 8);
+}
+
+int main(int, char** argv)
+{
+    verbose = getenv("PEGASUS_TEST_VERBOSE") ? true : false;
+
+    testBuckets();
+    testPercentiles();
+    testConcurrentRecording();
+
+    cout << argv[0] << " +++++ passed all tests" << endl;
+
+    return 0;
+}
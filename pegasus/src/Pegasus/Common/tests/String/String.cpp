@@ -35,6 +35,7 @@
 #include <Pegasus/Common/String.h>
 #include <Pegasus/Common/Exception.h>
 #include <Pegasus/Common/CommonUTF.h>
+#include <Pegasus/Common/UTF8CString.h>
 #include <stdcxx/stream/strstream>
 
 PEGASUS_USING_PEGASUS;
@@ -1703,12 +1704,55 @@ void testappendPrintf()
 
 }
 
+// Checks that UTF8CString yields the same result as String::getCString().
+static void _checkUTF8CString(const String& str)
+{
+    UTF8CString utf8(str);
+    CString cstr = str.getCString();
+    PEGASUS_TEST_ASSERT(utf8.size() == strlen(cstr));
+    PEGASUS_TEST_ASSERT(strcmp(utf8, cstr) == 0);
+    PEGASUS_TEST_ASSERT(String(utf8, utf8.size()) == str);
+}
+
+void testUTF8CString()
+{
+    _checkUTF8CString(String());
+    _checkUTF8CString("CIM_ManagedElement");
+
+    // Results on either side of the inline storage size.
+    for (Uint32 n = 80; n <= 90; n++)
+    {
+        String ascii;
+        String twoBytes;
+        String threeBytes;
+        for (Uint32 i = 0; i < n; i++)
+        {
+            ascii.append(Char16('a' + i % 26));
+            twoBytes.append(Char16(0x00E9));
+            threeBytes.append(Char16(0x20AC));
+        }
+        _checkUTF8CString(ascii);
+        _checkUTF8CString(twoBytes);
+        _checkUTF8CString(threeBytes);
+        _checkUTF8CString(ascii + ascii + ascii + ascii);
+    }
+
+    // A surrogate pair following ASCII characters.
+    String surrogate("abc");
+    surrogate.append(Char16(0xD800));
+    surrogate.append(Char16(0xDC00));
+    UTF8CString utf8(surrogate);
+    PEGASUS_TEST_ASSERT(utf8.size() == 7);
+    PEGASUS_TEST_ASSERT(strcmp(utf8, "abc\xF0\x90\x80\x80") == 0);
+}
+
 int main(int, char** argv)
 {
     verbose = (getenv("PEGASUS_TEST_VERBOSE")) ? true : false;
 
     test1();
     testappendPrintf();
+    testUTF8CString();
 
     cout << argv[0] << " +++++ passed all tests" << endl;
     return 0;
@@ -34,6 +34,7 @@
 #include <Pegasus/Common/System.h>
 #include <Pegasus/Common/Tracer.h>
 #include <Pegasus/Common/TraceMemoryHandler.h>
+#include <Pegasus/Common/TraceAsyncHandler.h>
 #include <Pegasus/Common/AutoPtr.h>
 #include <Pegasus/Common/SharedPtr.h>
 #include <Pegasus/Common/CIMClass.h>
@@ -65,6 +66,9 @@ CString FILE2;
 CString FILE3;
 CString FILE4;
 CString FILE5;
+CString FILE6;
+CString FILE7;
+CString FILE8;
 
 // A message string for testing the tracer with variable arguments
 #define VAR_TEST_MESSAGE "Variable length part of message"
@@ -1132,6 +1136,325 @@ Uint32 testMemoryHandler(const char* filename)
 
 
 
+//----------------------------------------------------------
+// Tests for the Async and AsyncBinary trace facilities
+//----------------------------------------------------------
+
+#define NUM_ASYNC_TEST_THREADS 8
+#define NUM_ASYNC_TEST_MESSAGES 2000
+
+ThreadReturnType PEGASUS_THREAD_CDECL asyncTracerThread(void* parm)
+{
+    Thread* myself = reinterpret_cast<Thread*>(parm);
+    Uint32 threadNumber = *reinterpret_cast<Uint32*>(myself->get_parm());
+
+    for (Uint32 i = 0; i < NUM_ASYNC_TEST_MESSAGES; i++)
+    {
+        PEG_TRACE((TRC_CONFIG, Tracer::LEVEL4, "T%u %u", threadNumber, i));
+    }
+
+    return ThreadReturnType(0);
+}
+
+//
+// Returns true if a line of the given file ends with ']: ' followed by
+// the expected message.
+//
+Boolean findMessage(const char* fileName, const char* expectedMessage)
+{
+    String expected = "]: ";
+    expected.append(expectedMessage);
+    CString expectedLine = expected.getCString();
+    Uint32 expectedLength = (Uint32)strlen(expectedLine);
+
+    fstream file;
+    file.open(fileName, fstream::in);
+    string line;
+    while (getline(file, line))
+    {
+        if (line.size() >= expectedLength &&
+            line.compare(line.size() - expectedLength, expectedLength,
+                (const char*)expectedLine) == 0)
+        {
+            return true;
+        }
+    }
+
+    cout << "Message not found in " << fileName << ": \"" <<
+        expectedMessage << "\"" << endl;
+    return false;
+}
+
+//
+// Traces from several threads and checks that all messages of each thread
+// are written in order.  Messages that did not fit into the ring buffer of
+// a thread must be reported as dropped.
+//
+Uint32 checkAsyncThreadMessages(const char* fileName)
+{
+    Uint32 next[NUM_ASYNC_TEST_THREADS];
+    Uint32 received = 0;
+    Uint32 dropped = 0;
+    memset(next, 0, sizeof(next));
+
+    fstream file;
+    file.open(fileName, fstream::in);
+    string line;
+    while (getline(file, line))
+    {
+        Uint32 threadNumber;
+        Uint32 messageNumber;
+        Uint32 count;
+        string::size_type pos = line.find("]: T");
+        if (pos != string::npos &&
+            sscanf(line.c_str() + pos + 4, "%u %u",
+                &threadNumber, &messageNumber) == 2)
+        {
+            PEGASUS_TEST_ASSERT(threadNumber < NUM_ASYNC_TEST_THREADS);
+            PEGASUS_TEST_ASSERT(messageNumber >= next[threadNumber]);
+            next[threadNumber] = messageNumber + 1;
+            received++;
+        }
+        else if (sscanf(line.c_str(), "DROPPED %u", &count) == 1)
+        {
+            dropped += count;
+        }
+    }
+
+    if (received + dropped != NUM_ASYNC_TEST_THREADS * NUM_ASYNC_TEST_MESSAGES)
+    {
+        cout << "Async trace: received " << received << ", dropped " <<
+            dropped << endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+Uint32 runAsyncTracerThreads()
+{
+    Uint32 threadNumbers[NUM_ASYNC_TEST_THREADS];
+    Thread* threads[NUM_ASYNC_TEST_THREADS];
+
+    for (Uint32 i = 0; i < NUM_ASYNC_TEST_THREADS; i++)
+    {
+        threadNumbers[i] = i;
+        threads[i] = new Thread(asyncTracerThread, &threadNumbers[i], false);
+        PEGASUS_TEST_ASSERT(threads[i]->run() == PEGASUS_THREAD_OK);
+    }
+
+    for (Uint32 i = 0; i < NUM_ASYNC_TEST_THREADS; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    return 0;
+}
+
+//
+// Description:
+// Traces with the Async facility: the messages are written by the writer
+// thread in the format of the File facility.
+//
+// Type:
+// Positive
+//
+// return 0 if the test passed
+// return 1 if the test failed
+//
+Uint32 testAsyncHandler(const char* fileName)
+{
+    PEGASUS_TEST_ASSERT(Tracer::setTraceFacility("Async"));
+    PEGASUS_TEST_ASSERT(
+        Tracer::getTraceFacility() == Tracer::TRACE_FACILITY_ASYNC);
+    Tracer::setMaxTraceFileSize(_traceFileSizeKBytes);
+    Tracer::setMaxTraceFileNumber(_numberOfTraceFiles);
+    Tracer::setTraceFile(fileName);
+    Tracer::setTraceComponents("Config");
+    Tracer::setTraceLevel(Tracer::LEVEL4);
+
+    PEG_TRACE((TRC_CONFIG, Tracer::LEVEL4, "%s %d %u",
+        "Async trace value=", -123, 456));
+    Tracer::flushTrace();
+    if (compare(fileName, "Async trace value= -123 456"))
+    {
+        return 1;
+    }
+
+    runAsyncTracerThreads();
+    Tracer::flushTrace();
+    return checkAsyncThreadMessages(fileName);
+}
+
+//
+// Decodes a binary trace file into the given file.
+//
+Boolean decodeTrace(const char* binaryFile, const char* fileName)
+{
+    FILE* in = fopen(binaryFile, "rb");
+    PEGASUS_TEST_ASSERT(in);
+    FILE* out = fopen(fileName, "w");
+    PEGASUS_TEST_ASSERT(out);
+    String error;
+    Boolean decoded = TraceAsyncHandler::decodeBinaryTrace(in, out, error);
+    fclose(in);
+    fclose(out);
+    if (!decoded)
+    {
+        cout << "Decoding failed: " << error << endl;
+    }
+    return decoded;
+}
+
+//
+// Description:
+// Traces with the AsyncBinary facility and decodes the binary trace file.
+// The decoded messages must match the messages written by the File
+// facility.
+//
+// Type:
+// Positive
+//
+// return 0 if the test passed
+// return 1 if the test failed
+//
+Uint32 testAsyncBinaryHandler(const char* fileName)
+{
+    String binaryFileName = fileName;
+    binaryFileName.append(PEGASUS_TRC_BINARY_FILE_SUFFIX);
+    CString binaryFile = binaryFileName.getCString();
+    System::removeFile(binaryFile);
+
+    PEGASUS_TEST_ASSERT(Tracer::setTraceFacility("AsyncBinary"));
+    Tracer::setMaxTraceFileSize(_traceFileSizeKBytes);
+    Tracer::setMaxTraceFileNumber(_numberOfTraceFiles);
+    Tracer::setTraceFile(fileName);
+    Tracer::setTraceComponents("Config");
+    Tracer::setTraceLevel(PEGASUS_TRACER_LEVEL5);
+
+    char longString[2 * PEGASUS_TRC_ASYNC_MAX_RECORD_SIZE];
+    memset(longString, 'x', sizeof(longString) - 1);
+    longString[sizeof(longString) - 1] = 0;
+    const char* notTerminated = "abcdef";
+    Sint64 largeValue = -PEGASUS_SINT64_LITERAL(1099511627776);
+
+    {
+        PEG_METHOD_ENTER(TRC_CONFIG, "testAsyncBinaryHandler");
+        PEG_TRACE((TRC_CONFIG, Tracer::LEVEL4,
+            "%s|%5d|%-4u|%x|%" PEGASUS_64BIT_CONVERSION_WIDTH "d|%.2f|%c|"
+                "%.*s|%*d|%%|%p",
+            "Binary trace", -12, 34u, 255u, largeValue, 3.14159, 'z',
+            3, notTerminated, 6, 42, notTerminated));
+        PEG_TRACE_CSTRING(TRC_CONFIG, Tracer::LEVEL4, "A character string");
+        PEG_TRACE((TRC_CONFIG, Tracer::LEVEL4, "Long: %s", longString));
+        PEG_METHOD_EXIT();
+    }
+
+    runAsyncTracerThreads();
+    Tracer::flushTrace();
+
+    if (!decodeTrace(binaryFile, fileName))
+    {
+        return 1;
+    }
+
+    char expected[256];
+    sprintf(expected,
+        "%s|%5d|%-4u|%x|%" PEGASUS_64BIT_CONVERSION_WIDTH "d|%.2f|%c|"
+            "%.*s|%*d|%%|%p",
+        "Binary trace", -12, 34u, 255u, largeValue, 3.14159, 'z',
+        3, notTerminated, 6, 42, notTerminated);
+
+    String longMessage = "Long: ";
+    longMessage.append(longString);
+
+    if (!findMessage(fileName, "Entering method testAsyncBinaryHandler") ||
+        !findMessage(fileName, expected) ||
+        !findMessage(fileName, "A character string") ||
+        !findMessage(fileName, longMessage.getCString()) ||
+        !findMessage(fileName, "Exiting method testAsyncBinaryHandler"))
+    {
+        return 1;
+    }
+
+    Uint32 rc = checkAsyncThreadMessages(fileName);
+    System::removeFile(binaryFile);
+    return rc;
+}
+
+//
+// Description:
+// The AsyncBinary facility identifies strings by their address.  A string
+// at the address of a string of an unloaded library must be defined
+// again, and each trace file must define the strings its records use,
+// also after the file was rolled more than once.
+//
+// Type:
+// Positive
+//
+// return 0 if the test passed
+// return 1 if the test failed
+//
+Uint32 testAsyncBinaryStrings(const char* fileName)
+{
+    String binaryFileName = fileName;
+    binaryFileName.append(PEGASUS_TRC_BINARY_FILE_SUFFIX);
+    CString binaryFile = binaryFileName.getCString();
+    System::removeFile(binaryFile);
+
+    PEGASUS_TEST_ASSERT(Tracer::setTraceFacility("AsyncBinary"));
+    Tracer::setMaxTraceFileSize(_traceFileSizeKBytes);
+    Tracer::setMaxTraceFileNumber(_numberOfTraceFiles);
+    Tracer::setTraceFile(fileName);
+    Tracer::setTraceComponents("Config");
+    Tracer::setTraceLevel(Tracer::LEVEL4);
+
+    // Open the trace file, which defines the strings again
+    PEG_TRACE_CSTRING(TRC_CONFIG, Tracer::LEVEL4, "Strings test");
+    Tracer::flushTrace();
+
+    char format[32];
+    strcpy(format, "Unloaded library %d");
+    PEG_TRACE((TRC_CONFIG, Tracer::LEVEL4, format, 1));
+    Tracer::libraryUnloaded();
+    strcpy(format, "Loaded library %d");
+    PEG_TRACE((TRC_CONFIG, Tracer::LEVEL4, format, 2));
+    Tracer::flushTrace();
+
+    if (!decodeTrace(binaryFile, fileName) ||
+        !findMessage(fileName, "Unloaded library 1") ||
+        !findMessage(fileName, "Loaded library 2"))
+    {
+        return 1;
+    }
+
+    // Roll the trace file several times and decode the last file only
+    Tracer::setMaxTraceFileSize("1");
+    for (Uint32 i = 0; i < 200; i++)
+    {
+        PEG_TRACE((TRC_CONFIG, Tracer::LEVEL4, "Rolled trace file %u", i));
+        Tracer::flushTrace();
+    }
+
+    if (!decodeTrace(binaryFile, fileName) ||
+        !findMessage(fileName, "Rolled trace file 199"))
+    {
+        return 1;
+    }
+
+    Tracer::setTraceFacility("File");
+    Tracer::setMaxTraceFileSize(_traceFileSizeKBytes);
+    System::removeFile(binaryFile);
+    for (Uint32 i = 1; i <= 3; i++)
+    {
+        char rolledFile[256];
+        sprintf(rolledFile, "%s.%u", (const char*)binaryFile, i);
+        System::removeFile(rolledFile);
+    }
+    return 0;
+}
+
 int main(int argc, char** argv)
 {
 
@@ -1162,12 +1485,24 @@ int main(int argc, char** argv)
     String f5 (tmpDir);
     f5.append("/testtracer5.trace");
     FILE5 = f5.getCString();
+    String f6 (tmpDir);
+    f6.append("/testtracer6.trace");
+    FILE6 = f6.getCString();
+    String f7 (tmpDir);
+    f7.append("/testtracer7.trace");
+    FILE7 = f7.getCString();
+    String f8 (tmpDir);
+    f8.append("/testtracer8.trace");
+    FILE8 = f8.getCString();
 
     System::removeFile(FILE1);
     System::removeFile(FILE2);
     System::removeFile(FILE3);
     System::removeFile(FILE4);
     System::removeFile(FILE5);
+    System::removeFile(FILE6);
+    System::removeFile(FILE7);
+    System::removeFile(FILE8);
     if (test1() != 0)
     {
        cout << "Tracer test (test1) failed" << endl;
@@ -1320,6 +1655,26 @@ int main(int argc, char** argv)
        exit(1);
     }
 
+    if (testAsyncHandler(FILE6) != 0)
+    {
+       cout << "Tracer test (testAsyncHandler) failed" << endl;
+       exit(1);
+    }
+
+    if (testAsyncBinaryHandler(FILE7) != 0)
+    {
+       cout << "Tracer test (testAsyncBinaryHandler) failed" << endl;
+       exit(1);
+    }
+
+    if (testAsyncBinaryStrings(FILE8) != 0)
+    {
+       cout << "Tracer test (testAsyncBinaryStrings) failed" << endl;
+       exit(1);
+    }
+
+    Tracer::setTraceFacility("File");
+
 
     cout << argv[0] << " +++++ passed all tests" << endl;
     System::removeFile(FILE1);
@@ -1327,6 +1682,9 @@ int main(int argc, char** argv)
     System::removeFile(FILE3);
     System::removeFile(FILE4);
     System::removeFile(FILE5);
+    System::removeFile(FILE6);
+    System::removeFile(FILE7);
+    System::removeFile(FILE8);
     return 0;
 #endif
 }
@@ -28,8 +28,10 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <cstdio>
+#include <cstring>
 #include <Pegasus/Common/PegasusAssert.h>
 #include <Pegasus/Common/XmlWriter.h>
+#include <Pegasus/Common/IndicationPayload.h>
 #include <Pegasus/Common/System.h>
 
 PEGASUS_USING_PEGASUS;
@@ -173,6 +175,59 @@ void testClassOriginC()
     return;
 }
 
+/* function shall check that an EXPPARAMVALUE element built from a shared
+   leading part and the per-destination properties is identical to the
+   element encoded in one piece */
+void testSharedInstanceEParameter()
+{
+    Array<CIMName> perDestinationProperties;
+    perDestinationProperties.append(CIMName("SequenceContext"));
+    perDestinationProperties.append(CIMName("SequenceNumber"));
+
+    CIMInstance indication(CIMName("CIM_AlertIndication"));
+    indication.addProperty(
+        CIMProperty(CIMName("Description"), String("payload test")));
+    indication.addProperty(
+        CIMProperty(CIMName("AlertType"), Uint16(2)));
+
+    IndicationPayload payload(perDestinationProperties);
+    Buffer encoding;
+    PEGASUS_TEST_ASSERT(
+        !payload.appendEncoding(IndicationPayload::FORMAT_CIMXML, encoding));
+
+    for (Sint64 sequenceNumber = 0; sequenceNumber < 3; sequenceNumber++)
+    {
+        CIMInstance destinationIndication = indication.clone();
+        destinationIndication.addProperty(
+            CIMProperty(CIMName("SequenceContext"), String("context")));
+        destinationIndication.addProperty(
+            CIMProperty(CIMName("SequenceNumber"), sequenceNumber));
+
+        Buffer expected;
+        XmlWriter::appendInstanceEParameter(
+            expected, "NewIndication", destinationIndication);
+
+        Buffer actual;
+        if (!payload.appendEncoding(IndicationPayload::FORMAT_CIMXML, actual))
+        {
+            PEGASUS_TEST_ASSERT(sequenceNumber == 0);
+            XmlWriter::appendInstanceEParameterBegin(
+                actual,
+                "NewIndication",
+                destinationIndication,
+                perDestinationProperties);
+            payload.setEncoding(IndicationPayload::FORMAT_CIMXML, actual);
+        }
+        XmlWriter::appendInstanceEParameterEnd(
+            actual, destinationIndication, perDestinationProperties);
+
+        if (verbose) cout << actual.getData() << endl;
+        PEGASUS_TEST_ASSERT(expected.size() == actual.size());
+        PEGASUS_TEST_ASSERT(
+            strcmp(expected.getData(), actual.getData()) == 0);
+    }
+}
+
 int main(int, char** argv)
 {
     verbose = getenv("PEGASUS_TEST_VERBOSE") ? true : false;
@@ -191,6 +246,8 @@ int main(int, char** argv)
     // c) a basic type property
     testClassOriginC();
 
+    testSharedInstanceEParameter();
+
     cout << argv[0] << " +++++ passed all tests" << endl;
     return 0;
 }
@@ -46,7 +46,7 @@ PEGASUS_USING_PEGASUS;
 cimmofRepository::cimmofRepository(const String& path,
     Uint32 mode,
     compilerCommonDefs::operationType ot)
-    : _cimrepository(0), _context(0), _ot(ot)
+    : _cimrepository(0), _context(0), _ot(ot), _inInstanceTransaction(false)
 {
     // Decl context is allocated here but will be owned and deleted by
     // the CIMRepository class
@@ -70,14 +70,67 @@ cimmofRepository::cimmofRepository(const String& path,
 
 cimmofRepository::~cimmofRepository()
 {
+    // Keep the instances added before a compilation error, as when each
+    // instance was committed on its own.
+    try
+    {
+        _commitInstanceTransaction();
+    }
+    catch (...)
+    {
+    }
+
     delete _cimrepository;
 }
 
+void cimmofRepository::_beginInstanceTransaction(
+    const CIMNamespaceName &nameSpace)
+{
+    if (_inInstanceTransaction && _transactionNameSpace == nameSpace)
+    {
+        return;
+    }
+
+    _commitInstanceTransaction();
+
+    if (_cimrepository && _ot == compilerCommonDefs::USE_REPOSITORY)
+    {
+        _cimrepository->beginInstanceTransaction(nameSpace);
+        _inInstanceTransaction = true;
+        _transactionNameSpace = nameSpace;
+    }
+}
+
+void cimmofRepository::_commitInstanceTransaction()
+{
+    if (_inInstanceTransaction)
+    {
+        _inInstanceTransaction = false;
+        _cimrepository->commitInstanceTransaction();
+    }
+}
+
+void cimmofRepository::finish()
+{
+    try
+    {
+        _commitInstanceTransaction();
+    }
+    catch (CIMException& e)
+    {
+        // Convert the exception message to the one that would be received by
+        // a client.
+        throw CIMException(
+            e.getCode(), TraceableCIMException(e).getDescription());
+    }
+}
+
 int cimmofRepository::addClass(const CIMNamespaceName &nameSpace,
     CIMClass *classdecl)
 {
     try
     {
+        _commitInstanceTransaction();
         _context->addClass( nameSpace,  *classdecl);
     }
     catch (CIMException& e)
@@ -97,7 +150,25 @@ int cimmofRepository::addInstance(const CIMNamespaceName &nameSpace,
 {
     try
     {
-        _context->addInstance(nameSpace, *instance);
+        _beginInstanceTransaction(nameSpace);
+
+        try
+        {
+            _context->addInstance(nameSpace, *instance);
+        }
+        catch (...)
+        {
+            // End the transaction so that the instances added before are
+            // kept, unless the failed change rolled them back.
+            try
+            {
+                _commitInstanceTransaction();
+            }
+            catch (...)
+            {
+            }
+            throw;
+        }
     }
     catch (CIMException& e)
     {
@@ -115,6 +186,7 @@ int cimmofRepository::addQualifier(const CIMNamespaceName &nameSpace,
 {
     try
     {
+        _commitInstanceTransaction();
         _context->addQualifierDecl(nameSpace, *qualifier);
     }
     catch (CIMException& e)
@@ -172,6 +244,7 @@ int cimmofRepository::modifyClass(const CIMNamespaceName &nameSpace,
 {
     try
     {
+        _commitInstanceTransaction();
         _context->modifyClass( nameSpace,  *classdecl);
     }
     catch (CIMException& e)
@@ -191,6 +264,7 @@ void cimmofRepository::createNameSpace(const CIMNamespaceName &nameSpaceName)
     {
         try
         {
+            _commitInstanceTransaction();
             _cimrepository->createNameSpace(nameSpaceName);
         }
         catch (CIMException& e)
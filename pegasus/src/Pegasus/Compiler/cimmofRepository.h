@@ -80,10 +80,22 @@ class PEGASUS_COMPILER_LINKAGE cimmofRepository
 
         virtual void createNameSpace(const CIMNamespaceName &nameSpaceName);
 
+        // Commits the instances added since the last change of a class,
+        // qualifier or namespace.
+        virtual void finish();
+
     private:
+        // Consecutive instances of a namespace are added in one instance
+        // transaction of the repository, which is committed before any
+        // other change.
+        void _beginInstanceTransaction(const CIMNamespaceName &nameSpace);
+        void _commitInstanceTransaction();
+
         CIMRepository *_cimrepository;
         compilerDeclContext *_context;
         compilerCommonDefs::operationType _ot;
+        Boolean _inInstanceTransaction;
+        CIMNamespaceName _transactionNameSpace;
 };
 
 PEGASUS_NAMESPACE_END
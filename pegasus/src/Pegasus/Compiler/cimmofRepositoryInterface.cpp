@@ -277,6 +277,8 @@ void cimmofRepositoryInterface::start()
 
 void cimmofRepositoryInterface::finish()
 {
+    if (_repository)
+        _repository->finish();
 #ifdef PEGASUS_ENABLE_MRR_GENERATION
     if (_mrr)
         _mrr->finish();
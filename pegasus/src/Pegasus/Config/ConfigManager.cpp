@@ -202,6 +202,10 @@ static struct OwnerEntry _properties[] =
          (ConfigPropertyOwner*)&ConfigManager::defaultOwner},
     {"idleConnectionTimeout",
          (ConfigPropertyOwner*)&ConfigManager::defaultOwner},
+#if defined(PEGASUS_HAS_SSL) && defined(PEGASUS_OS_LINUX)
+    {"enableKernelTLS",
+         (ConfigPropertyOwner*)&ConfigManager::defaultOwner},
+#endif
     {"maxFailedProviderModuleRestarts",
          (ConfigPropertyOwner*)&ConfigManager::defaultOwner},
     {"listenAddress",
@@ -220,6 +224,8 @@ static struct OwnerEntry _properties[] =
     ,{"maxIndicationDeliveryRetryAttempts",
         (ConfigPropertyOwner*)&ConfigManager::indicationServiceOwner},
     {"minIndicationDeliveryRetryInterval",
+        (ConfigPropertyOwner*)&ConfigManager::indicationServiceOwner},
+    {"maxIndicationDeliveryThreads",
         (ConfigPropertyOwner*)&ConfigManager::indicationServiceOwner}
 #endif
 
@@ -232,6 +238,10 @@ static struct OwnerEntry _properties[] =
     {"pullOperationsMaxTimeout",
         (ConfigPropertyOwner*)&ConfigManager::defaultOwner},
     {"pullOperationsDefaultTimeout",
+        (ConfigPropertyOwner*)&ConfigManager::defaultOwner},
+    {"responseChunkMaxSize",
+        (ConfigPropertyOwner*)&ConfigManager::defaultOwner},
+    {"responseChunkMaxDelay",
         (ConfigPropertyOwner*)&ConfigManager::defaultOwner}
 };
 
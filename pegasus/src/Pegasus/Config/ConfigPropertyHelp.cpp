@@ -89,7 +89,7 @@ struct configPropertyDescription configPropertyDescriptionList[] =
 
     {"traceFilePath",
         "Specifies location and name of OpenPegasus trace file.\n"
-        "Ignored when 'traceFacility!=File."},
+        "Ignored when 'traceFacility' is not File, Async or AsyncBinary."},
 
     {"traceMemoryBufferKbytes",
         "Integer defines size of buffer for in-memory tracing.\n"
@@ -110,7 +110,12 @@ struct configPropertyDescription configPropertyDescriptionList[] =
         "Possible Values:\n"
         "    'File'   Trace output to file defined by 'traceFilePath'\n"
         "    'Log'    Trace output to log file\n"
-        "    'Memory' Trace output to memory"},
+        "    'Memory' Trace output to memory\n"
+        "    'Async'  Trace output to file defined by 'traceFilePath',\n"
+        "             written by a background thread\n"
+        "    'AsyncBinary' Binary trace output to file 'traceFilePath'.bin,\n"
+        "             written by a background thread, decoded by\n"
+        "             cimtrcdecode"},
 
     {"hostname", "Override local system supplied hostname CIM Server uses to\n"
         "build objects for WBEM operations that return hostname (ex.\n"
@@ -339,6 +344,14 @@ struct configPropertyDescription configPropertyDescriptionList[] =
         "value for idle client connections. If set to zero, idle client\n"
         "connections do not time out."},
 
+    {"enableKernelTLS",
+        "If 'true', HTTPS connections ask the Linux kernel to perform TLS\n"
+        "record encryption (kTLS) once the handshake has completed, so\n"
+        "responses are written to the socket without being encrypted in the\n"
+        "CIM Server process. Requires a kernel with the tls module and an\n"
+        "OpenSSL built with kTLS support; connections whose cipher the\n"
+        "kernel does not support continue to use OpenSSL."},
+
     {"maxFailedProviderModuleRestarts",
         "If set to a positive integer, this value specifies the number of\n"
         "times a failed provider module with indications enabled is restarted\n"
@@ -360,6 +373,12 @@ struct configPropertyDescription configPropertyDescriptionList[] =
         "indication to a listener destination that previously failed.\n"
         "Cimserver may take longer due to QoS or other processing."},
 
+    {"maxIndicationDeliveryThreads",
+        "Defines the maximum number of threads the indication service uses\n"
+        "to deliver indications to listener destinations. Each destination\n"
+        "is served by at most one thread at a time, so a slow listener\n"
+        "cannot delay the delivery to the other destinations."},
+
     {"slpProviderStartupTimeout",
         "Timeout value in milliseconds used to specify how long the\n"
         "registration with an SLP SA may take. Registration will be retried\n"
@@ -424,7 +443,26 @@ struct configPropertyDescription configPropertyDescriptionList[] =
         "enumeration sequence)\nthe server uses when the client open... "
         "request \'operationTimeout\' parameter\nis NULL. Minimum value = 1 "
         "sec . Maximum value = "
-        PEGASUS_DEFAULT_PULL_OPERATION_TIMEOUT_SEC_STRING "sec"}
+        PEGASUS_DEFAULT_PULL_OPERATION_TIMEOUT_SEC_STRING "sec"},
+
+    {"responseChunkMaxSize",
+        "Defines the estimated size in bytes at which the objects a "
+        "provider has\ndelivered for an enumeration or association "
+        "operation are sent on as\none response chunk. A response to a "
+        "client that does not accept\nchunked responses (TE: trailers) is "
+        "held in full until it is complete.\n"
+        "Minimum value = 1. Maximum value = "
+        PEGASUS_RESPONSE_CHUNK_MAX_SIZE_LIMIT_STRING},
+
+    {"responseChunkMaxDelay",
+        "Defines the time in milliseconds that the first object of a "
+        "provider\nresponse chunk may be held before the chunk is sent on, "
+        "even if it\nhas not reached responseChunkMaxSize. The time is "
+        "checked at delivery\ntime, when the provider delivers the next "
+        "object; a chunk is not sent\nwhile the provider delivers "
+        "nothing. If set to 0, chunks are sent by\nsize only. "
+        "Maximum value = "
+        PEGASUS_RESPONSE_CHUNK_MAX_DELAY_MSEC_LIMIT_STRING " msec"}
 };
 
 const Uint32 configPropertyDescriptionListSize =
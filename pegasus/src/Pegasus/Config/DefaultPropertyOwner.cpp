@@ -298,6 +298,13 @@ void DefaultPropertyOwner::initCurrentValue(
         StringConversion::decimalStringToUint64(value.getCString(), v);
         HTTPAcceptor::setSocketWriteTimeout((Uint32)v);
     }
+#if defined(PEGASUS_HAS_SSL) && defined(PEGASUS_OS_LINUX)
+    else if (String::equal(name, "enableKernelTLS"))
+    {
+        HTTPAcceptor::setKernelTLSEnabled(
+            ConfigManager::parseBooleanValue(value));
+    }
+#endif
     return;
 }
 
@@ -529,6 +536,9 @@ Boolean DefaultPropertyOwner::isValid(
         String::equal(name, "enableAssociationTraversal") ||
         String::equal(name, "enableIndicationService") ||
         String::equal(name, "forceProviderProcesses")
+#if defined(PEGASUS_HAS_SSL) && defined(PEGASUS_OS_LINUX)
+        || String::equal(name, "enableKernelTLS")
+#endif
 #ifdef PEGASUS_ENABLE_SLP
         || String::equal(name, "slp")
 #endif
@@ -570,6 +580,20 @@ Boolean DefaultPropertyOwner::isValid(
             (Uint32)1,
             (Uint32)PEGASUS_DEFAULT_PULL_OPERATION_TIMEOUT_SEC);
     }
+    // If you change the following values, please also change
+    // the help file which displays the min and max
+    else if (String::equal(name, "responseChunkMaxSize"))
+    {
+        return ConfigManager::isValidUint32Value(value,
+            (Uint32)1,
+            (Uint32)PEGASUS_RESPONSE_CHUNK_MAX_SIZE_LIMIT);
+    }
+    else if (String::equal(name, "responseChunkMaxDelay"))
+    {
+        return ConfigManager::isValidUint32Value(value,
+            (Uint32)0,
+            (Uint32)PEGASUS_RESPONSE_CHUNK_MAX_DELAY_MSEC_LIMIT);
+    }
     return true;
 }
 
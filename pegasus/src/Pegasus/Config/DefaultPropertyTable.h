@@ -35,6 +35,9 @@
     {"socketWriteTimeout", PEGASUS_DEFAULT_SOCKETWRITE_TIMEOUT_SECONDS_STRING,
         IS_DYNAMIC, IS_VISIBLE},
     {"idleConnectionTimeout", "0", IS_DYNAMIC, IS_VISIBLE},
+# if defined(PEGASUS_HAS_SSL) && defined(PEGASUS_OS_LINUX)
+    {"enableKernelTLS", "false", IS_STATIC, IS_VISIBLE},
+# endif
     {"maxFailedProviderModuleRestarts", "3", IS_DYNAMIC, IS_VISIBLE},
     {"listenAddress", "All", IS_STATIC, IS_VISIBLE},
     {"hostname", "", IS_STATIC, IS_VISIBLE},
@@ -92,8 +95,13 @@
         PEGASUS_PULL_OPERATION_MAX_TIMEOUT_SEC_STRING, IS_DYNAMIC, IS_VISIBLE},
     {"pullOperationsDefaultTimeout",
         PEGASUS_DEFAULT_PULL_OPERATION_TIMEOUT_SEC_STRING, IS_DYNAMIC,
-        IS_VISIBLE}
+        IS_VISIBLE},
 // PULL_EXP_END
+    {"responseChunkMaxSize",
+        PEGASUS_DEFAULT_RESPONSE_CHUNK_MAX_SIZE_STRING, IS_DYNAMIC, IS_VISIBLE},
+    {"responseChunkMaxDelay",
+        PEGASUS_DEFAULT_RESPONSE_CHUNK_MAX_DELAY_MSEC_STRING, IS_DYNAMIC,
+        IS_VISIBLE}
 #endif
 
 #endif /* Pegasus_DefaultPropertyTable_h */
@@ -66,8 +66,13 @@
         PEGASUS_PULL_OPERATION_MAX_TIMEOUT_SEC_STRING, IS_DYNAMIC, IS_VISIBLE},
     {"pullOperationsDefaultTimeout",
         PEGASUS_DEFAULT_PULL_OPERATION_TIMEOUT_SEC_STRING, IS_DYNAMIC,
-        IS_VISIBLE}
+        IS_VISIBLE},
 // PULL_EXP_END
+    {"responseChunkMaxSize",
+        PEGASUS_DEFAULT_RESPONSE_CHUNK_MAX_SIZE_STRING, IS_DYNAMIC, IS_VISIBLE},
+    {"responseChunkMaxDelay",
+        PEGASUS_DEFAULT_RESPONSE_CHUNK_MAX_DELAY_MSEC_STRING, IS_DYNAMIC,
+        IS_VISIBLE}
 
 #else // Non Release build
     {"httpPort", "", IS_STATIC, IS_VISIBLE},
@@ -100,8 +105,13 @@
         PEGASUS_PULL_OPERATION_MAX_TIMEOUT_SEC_STRING, IS_DYNAMIC, IS_VISIBLE},
     {"pullOperationsDefaultTimeout",
         PEGASUS_DEFAULT_PULL_OPERATION_TIMEOUT_SEC_STRING, IS_DYNAMIC,
-        IS_VISIBLE}
+        IS_VISIBLE},
 // PULL_EXP_END
+    {"responseChunkMaxSize",
+        PEGASUS_DEFAULT_RESPONSE_CHUNK_MAX_SIZE_STRING, IS_DYNAMIC, IS_VISIBLE},
+    {"responseChunkMaxDelay",
+        PEGASUS_DEFAULT_RESPONSE_CHUNK_MAX_DELAY_MSEC_STRING, IS_DYNAMIC,
+        IS_VISIBLE}
 #endif
 
 #endif /* Pegasus_DefaultPropertyTableLinux_h */
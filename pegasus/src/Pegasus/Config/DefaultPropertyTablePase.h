@@ -58,6 +58,11 @@
         PEGASUS_PULL_OPERATION_MAX_TIMEOUT_SEC_STRING, IS_DYNAMIC, IS_VISIBLE},
     {"pullOperationsDefaultTimeout",
         PEGASUS_DEFAULT_PULL_OPERATION_TIMEOUT_SEC_STRING, IS_DYNAMIC,
-        IS_VISIBLE}
+        IS_VISIBLE},
 // PULL_EXP_END
+    {"responseChunkMaxSize",
+        PEGASUS_DEFAULT_RESPONSE_CHUNK_MAX_SIZE_STRING, IS_DYNAMIC, IS_VISIBLE},
+    {"responseChunkMaxDelay",
+        PEGASUS_DEFAULT_RESPONSE_CHUNK_MAX_DELAY_MSEC_STRING, IS_DYNAMIC,
+        IS_VISIBLE}
 #endif /* Pegasus_DefaultPropertyTablePase_h */
@@ -44,6 +44,7 @@ static struct ConfigPropertyRow properties[] =
 {
     {"maxIndicationDeliveryRetryAttempts", "3", IS_DYNAMIC, IS_VISIBLE},
     {"minIndicationDeliveryRetryInterval", "30",IS_DYNAMIC, IS_VISIBLE},
+    {"maxIndicationDeliveryThreads", "5", IS_STATIC, IS_VISIBLE},
 };
 
 const Uint32 NUM_PROPERTIES = sizeof(properties) / sizeof(properties[0]);
@@ -53,6 +54,7 @@ IndicationServicePropertyOwner::IndicationServicePropertyOwner():
 {
     _maxIndicationDeliveryRetryAttempts.reset(new ConfigProperty);
     _minIndicationDeliveryRetryInterval.reset(new ConfigProperty);
+    _maxIndicationDeliveryThreads.reset(new ConfigProperty);
 }
 
 /**
@@ -99,6 +101,22 @@ void IndicationServicePropertyOwner::initialize()
             _minIndicationDeliveryRetryInterval->externallyVisible =
                 properties[i].externallyVisible;
         }
+        else if (String::equal(
+            properties[i].propertyName, "maxIndicationDeliveryThreads"))
+        {
+            _maxIndicationDeliveryThreads->propertyName
+                = properties[i].propertyName;
+            _maxIndicationDeliveryThreads->defaultValue
+                = properties[i].defaultValue;
+            _maxIndicationDeliveryThreads->currentValue
+                = properties[i].defaultValue;
+            _maxIndicationDeliveryThreads->plannedValue
+                = properties[i].defaultValue;
+            _maxIndicationDeliveryThreads->dynamic
+                = properties[i].dynamic;
+            _maxIndicationDeliveryThreads->externallyVisible =
+                properties[i].externallyVisible;
+        }
         else
         {
             PEGASUS_UNREACHABLE(PEGASUS_ASSERT(false);)
@@ -119,6 +137,10 @@ struct ConfigProperty* IndicationServicePropertyOwner::_lookupConfigProperty(
     {
         return _minIndicationDeliveryRetryInterval.get();
     }
+    else if (String::equal(_maxIndicationDeliveryThreads->propertyName, name))
+    {
+        return _maxIndicationDeliveryThreads.get();
+    }
     else
     {
         throw UnrecognizedConfigProperty(name);
@@ -166,6 +188,10 @@ void IndicationServicePropertyOwner::initCurrentValue(
     {
         _minIndicationDeliveryRetryInterval->currentValue = value;
     }
+    else if (String::equal(_maxIndicationDeliveryThreads->propertyName, name))
+    {
+        _maxIndicationDeliveryThreads->currentValue = value;
+    }
     else
     {
         throw UnrecognizedConfigProperty(name);
@@ -215,6 +241,14 @@ Boolean IndicationServicePropertyOwner::isValid(
             StringConversion::decimalStringToUint64(value.getCString(), v) &&
             StringConversion::checkUintBounds(v, CIMTYPE_UINT32);
     }
+    else if (String::equal(_maxIndicationDeliveryThreads->propertyName, name))
+    {
+        // At least one delivery thread is required.
+        return
+            StringConversion::decimalStringToUint64(value.getCString(), v) &&
+            StringConversion::checkUintBounds(v, CIMTYPE_UINT16) &&
+            v > 0;
+    }
     else
     {
         throw UnrecognizedConfigProperty(name);
@@ -182,6 +182,8 @@ private:
 
     AutoPtr<struct ConfigProperty> _minIndicationDeliveryRetryInterval;
 
+    AutoPtr<struct ConfigProperty> _maxIndicationDeliveryThreads;
+
     /**
         Remember if configproperties are already initialized.
     */
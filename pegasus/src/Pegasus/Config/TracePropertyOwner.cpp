@@ -470,9 +470,9 @@ void TracePropertyOwner::initCurrentValue(
         //set trace facility
         Tracer::setTraceFacility(value);
 
-        //should take effect only when the tracing is on "File"
+        //should take effect only when the tracing is on a file
         Tracer::setMaxTraceFileSize(_traceFileSizeKBytes->currentValue);
-        Tracer::setMaxTraceFileNumber(value);
+        Tracer::setMaxTraceFileNumber(_numberOfTraceFiles->currentValue);
     }
     else if (String::equal(_traceMemoryBufferKbytes->propertyName, name))
     {
@@ -32,6 +32,7 @@
 #include "CIMOMStatDataProvider.h"
 #include <Pegasus/Common/PegasusVersion.h>
 #include <Pegasus/Common/Print.h>
+#include <Pegasus/Common/Constants.h>
 
 PEGASUS_USING_STD;
 PEGASUS_NAMESPACE_BEGIN
@@ -78,6 +79,23 @@ void CIMOMStatDataProvider::getInstance(
     // begin processing the request
     handler.processing();
 
+    if (instanceReference.getClassName().equal(
+            PEGASUS_CLASSNAME_PG_CIMOMSTATLATENCYDATA))
+    {
+        Array<CIMInstance> instances = buildLatencyInstances();
+        for (Uint32 i = 0; i < instances.size(); i++)
+        {
+            if (localReference == instances[i].getPath())
+            {
+                handler.deliver(instances[i]);
+                break;
+            }
+        }
+
+        handler.complete();
+        return;
+    }
+
     // find the correct instance and build it
     for (Uint16 i = StatisticalData::GET_CLASS;
            i < StatisticalData::NUMBER_OF_TYPES; i++)
@@ -107,6 +125,14 @@ void CIMOMStatDataProvider::enumerateInstances(
     // begin processing the request
     handler.processing();
 
+    if (classReference.getClassName().equal(
+            PEGASUS_CLASSNAME_PG_CIMOMSTATLATENCYDATA))
+    {
+        handler.deliver(buildLatencyInstances());
+        handler.complete();
+        return;
+    }
+
     // Loop throuh complete StatisticalData table building instances
     // Start at GET_CLASS because lower groups are not part of data
     for (StatisticalData::StatRequestType i = StatisticalData::GET_CLASS;
@@ -129,6 +155,18 @@ void CIMOMStatDataProvider::enumerateInstanceNames(
     // begin processing the request
     handler.processing();
 
+    if (classReference.getClassName().equal(
+            PEGASUS_CLASSNAME_PG_CIMOMSTATLATENCYDATA))
+    {
+        Array<CIMInstance> instances = buildLatencyInstances();
+        for (Uint32 i = 0; i < instances.size(); i++)
+        {
+            handler.deliver(instances[i].getPath());
+        }
+        handler.complete();
+        return;
+    }
+
     // Enumerate over the whole enum set
     for (StatisticalData::StatRequestType i = StatisticalData::GET_CLASS;
           i < StatisticalData::NUMBER_OF_TYPES;
@@ -222,6 +260,101 @@ CIMInstance CIMOMStatDataProvider::buildInstance(
     return requestedInstance;
 }
 
+CIMInstance CIMOMStatDataProvider::_buildLatencyInstance(
+    const String& operationName,
+    const String& providerModuleName,
+    Uint16 metric,
+    const StatisticalHistogram& histogram)
+{
+    // The key is the operation name, or "Module:" and the provider module
+    // name, followed by the metric.
+    char buffer[32];
+    sprintf(buffer, ":%u", metric);
+    String key;
+    if (providerModuleName.size())
+    {
+        key.append("Module:");
+        key.append(providerModuleName);
+    }
+    else
+    {
+        key.append(operationName);
+    }
+    key.append(buffer);
+
+    CIMInstance instance(PEGASUS_CLASSNAME_PG_CIMOMSTATLATENCYDATA);
+
+    instance.addProperty(CIMProperty("InstanceID", CIMValue(key)));
+    instance.addProperty(CIMProperty("OperationName",
+        CIMValue(operationName)));
+    instance.addProperty(CIMProperty("ProviderModuleName",
+        CIMValue(providerModuleName)));
+    instance.addProperty(CIMProperty("Metric", CIMValue(metric)));
+    instance.addProperty(CIMProperty("NumberOfSamples",
+        CIMValue(histogram.getCount())));
+    instance.addProperty(CIMProperty("Percentile50",
+        CIMValue(histogram.getPercentile(500))));
+    instance.addProperty(CIMProperty("Percentile90",
+        CIMValue(histogram.getPercentile(900))));
+    instance.addProperty(CIMProperty("Percentile99",
+        CIMValue(histogram.getPercentile(990))));
+    instance.addProperty(CIMProperty("Percentile999",
+        CIMValue(histogram.getPercentile(999))));
+    instance.addProperty(CIMProperty("MaximumValue",
+        CIMValue(histogram.getMaximum())));
+
+    Array<CIMKeyBinding> keys;
+    keys.append(CIMKeyBinding("InstanceID", key, CIMKeyBinding::STRING));
+    instance.setPath(CIMObjectPath(String::EMPTY, CIMNamespaceName(),
+        PEGASUS_CLASSNAME_PG_CIMOMSTATLATENCYDATA, keys));
+
+    return instance;
+}
+
+Array<CIMInstance> CIMOMStatDataProvider::buildLatencyInstances()
+{
+    Array<CIMInstance> instances;
+
+    // No distributions are reported while gathering is disabled, matching
+    // the zero totals of the CIM_CIMOMStatisticalData instances.
+    if (!sData->copyGSD)
+    {
+        return instances;
+    }
+
+    for (Uint16 type = StatisticalData::GET_CLASS;
+         type < StatisticalData::NUMBER_OF_TYPES; type++)
+    {
+        for (Uint16 metric = 0;
+             metric < StatisticalData::NUMBER_OF_STATDATA_TYPES; metric++)
+        {
+            const StatisticalHistogram& histogram =
+                sData->histograms[type][metric];
+            if (histogram.getCount() != 0)
+            {
+                instances.append(_buildLatencyInstance(
+                    sData->getRequestName(type), String::EMPTY, metric,
+                    histogram));
+            }
+        }
+    }
+
+    Uint32 numModules = sData->getProviderModuleCount();
+    for (Uint32 i = 0; i < numModules; i++)
+    {
+        const StatisticalHistogram& histogram =
+            sData->getProviderModuleHistogram(i);
+        if (histogram.getCount() != 0)
+        {
+            instances.append(_buildLatencyInstance(
+                String::EMPTY, sData->getProviderModuleName(i),
+                StatisticalData::PEGASUS_STATDATA_PROVIDER, histogram));
+        }
+    }
+
+    return instances;
+}
+
 void CIMOMStatDataProvider::checkObjectManager()
 {
 
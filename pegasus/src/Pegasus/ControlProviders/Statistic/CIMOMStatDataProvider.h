@@ -111,10 +111,23 @@ public:
     CIMObjectPath buildObjectPath(Uint16 type);
     String buildKey(Uint16 type);
 
+    /**
+        Builds the PG_CIMOMStatisticalLatencyData instances, one for each
+        operation type and statistic and one for each provider module, for
+        which samples were recorded.
+     */
+    Array<CIMInstance> buildLatencyInstances();
+
 protected:
 ////    CIMObjectPath _references[StatisticalData::NUMBER_OF_TYPES];
     void checkObjectManager();
 private:
+    CIMInstance _buildLatencyInstance(
+        const String& operationName,
+        const String& providerModuleName,
+        Uint16 metric,
+        const StatisticalHistogram& histogram);
+
 StatisticalData* sData;
 };
 
@@ -44,6 +44,7 @@
 #include <Pegasus/Common/Mutex.h>
 
 #include "ConsumerManager.h"
+#include "DynamicListener.h"
 
 PEGASUS_NAMESPACE_BEGIN
 PEGASUS_USING_STD;
@@ -79,6 +80,7 @@ ConsumerManager::ConsumerManager(
         _consumerConfigDir(consumerConfigDir),
         _enableConsumerUnload(enableConsumerUnload),
         _idleTimeout(idleTimeout),
+        _maxQueuedIndications(DynamicListener::DEFAULT_MAX_QUEUED_INDICATIONS),
         _forceShutdown(true)
 {
     PEG_METHOD_ENTER(TRC_LISTENER, "ConsumerManager::ConsumerManager");
@@ -193,6 +195,16 @@ Uint32 ConsumerManager::getIdleTimeout()
     return _idleTimeout;
 }
 
+Uint32 ConsumerManager::getMaxQueuedIndications()
+{
+    return _maxQueuedIndications.get();
+}
+
+void ConsumerManager::setMaxQueuedIndications(Uint32 maxQueuedIndications)
+{
+    _maxQueuedIndications.set(maxQueuedIndications);
+}
+
 /** Retrieves the library name associated with the consumer name.
  *  By default, the library name
  * is the same as the consumer name.  However, you may specify a different
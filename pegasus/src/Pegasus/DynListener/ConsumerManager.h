@@ -38,6 +38,7 @@
 #include <Pegasus/Common/CIMInstance.h>
 #include <Pegasus/Consumer/CIMIndicationConsumer.h>
 #include <Pegasus/Common/System.h>
+#include <Pegasus/Common/AtomicInt.h>
 
 #include <Pegasus/General/OptionManager.h>
 
@@ -72,6 +73,10 @@ public:
 
     Uint32 getIdleTimeout();
 
+    Uint32 getMaxQueuedIndications();
+
+    void setMaxQueuedIndications(Uint32 maxQueuedIndications);
+
     Boolean hasLoadedConsumers();
 
     Boolean hasActiveConsumers();
@@ -111,6 +116,7 @@ private:
     String _consumerConfigDir;
     Boolean _enableConsumerUnload;
     Uint32 _idleTimeout; //ms
+    AtomicInt _maxQueuedIndications;
     Boolean _forceShutdown;
 
     //ATTN: Bugzilla 3765 - Uncomment when OptionManager has a reset capability
@@ -57,6 +57,7 @@ const Boolean DynamicListener::DEFAULT_CONSUMER_UNLOAD = true;
 const Uint32 DynamicListener::DEFAULT_IDLE_TIMEOUT = 300000; //ms
 const Boolean DynamicListener::DEFAULT_FORCE_SHUTDOWN = false;
 const Uint32 DynamicListener::DEFAULT_SHUTDOWN_TIMEOUT = 10000; //ms
+const Uint32 DynamicListener::DEFAULT_MAX_QUEUED_INDICATIONS = 1000;
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -119,6 +120,10 @@ public:
 
     Uint32 getIdleTimeout();
 
+    void setMaxQueuedIndications(Uint32 maxQueuedIndications);
+
+    Uint32 getMaxQueuedIndications();
+
 private:
 
     // core components
@@ -309,6 +314,16 @@ void DynamicListenerRep::setIdleTimeout(Uint32 idleTimeout)
 //do nothing for now
 }
 
+Uint32 DynamicListenerRep::getMaxQueuedIndications()
+{
+    return _consumerManager->getMaxQueuedIndications();
+}
+
+void DynamicListenerRep::setMaxQueuedIndications(Uint32 maxQueuedIndications)
+{
+    _consumerManager->setMaxQueuedIndications(maxQueuedIndications);
+}
+
 
 /////////////////////////////////////////////////////////////////////////////
 // DynamicListener
@@ -454,6 +469,17 @@ void DynamicListener::setIdleTimeout(Uint32 idleTimeout)
     static_cast<DynamicListenerRep*>(_rep)->setIdleTimeout(idleTimeout);
 }
 
+Uint32 DynamicListener::getMaxQueuedIndications()
+{
+    return static_cast<DynamicListenerRep*>(_rep)->getMaxQueuedIndications();
+}
+
+void DynamicListener::setMaxQueuedIndications(Uint32 maxQueuedIndications)
+{
+    static_cast<DynamicListenerRep*>(_rep)->setMaxQueuedIndications(
+        maxQueuedIndications);
+}
+
 
 PEGASUS_NAMESPACE_END
 
@@ -50,6 +50,7 @@ public:
     static const Uint32 DEFAULT_IDLE_TIMEOUT;
     static const Boolean DEFAULT_FORCE_SHUTDOWN;
     static const Uint32 DEFAULT_SHUTDOWN_TIMEOUT;
+    static const Uint32 DEFAULT_MAX_QUEUED_INDICATIONS;
 
     DynamicListener(Uint32 portNumber,
                     const String& consumerDir,
@@ -110,6 +111,16 @@ public:
 
     Uint32 getIdleTimeout();
 
+    /**
+        Sets the maximum number of indications waiting to be delivered to
+        a consumer, or 0 for no limit.  While the queue of a consumer is
+        full, indications for it are rejected with CIM_ERR_FAILED so that
+        the exporting CIMOM retries them later.
+    */
+    void setMaxQueuedIndications(Uint32 maxQueuedIndications);
+
+    Uint32 getMaxQueuedIndications();
+
 private:
     void* _rep;
 
@@ -88,6 +88,10 @@ static struct OptionRow optionsTable[] =
  "shutdownTimeout",
  "the length of time to wait for consumer threads to complete, in ms"},
 
+{"maxQueuedIndications", "1000", false, Option::WHOLE_NUMBER, 0, 0,
+ "maxQueuedIndications",
+ "maximum number of indications queued per consumer, 0 for no limit"},
+
 {"traceFilePath", "cimlistener.trc", false, Option::STRING, 0, 0,
  "traceFilePath", "path to the listener's trace file"},
 
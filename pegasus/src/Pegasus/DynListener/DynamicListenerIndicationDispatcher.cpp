@@ -104,6 +104,12 @@ void DynamicListenerIndicationDispatcher::handleEnqueue(Message* message)
                 {
                     _handleIndicationRequest(request);
 
+                } catch (CIMException& ex)
+                {
+                    // Raised for a bad destination URL or a full consumer
+                    // queue; both are already logged or traced.
+                    cimException = ex;
+
                 } catch (Exception& ex)
                 {
                     cimException = CIMException(
@@ -233,6 +239,27 @@ void DynamicListenerIndicationDispatcher::_handleIndicationRequest(
     //gets deleted by the ConsumerManager
     DynamicConsumer* consumer = _consumerManager->getConsumer(consumerName);
 
+    // A slow consumer must not make the listener queue an unbounded
+    // number of indications.  Reject the indication instead; the
+    // exporting CIMOM retries it later.
+    Uint32 maxQueuedIndications = _consumerManager->getMaxQueuedIndications();
+    if (maxQueuedIndications &&
+        consumer->getPendingIndications() >= maxQueuedIndications)
+    {
+        PEG_TRACE((TRC_DISCARDED_DATA, Tracer::LEVEL1,
+            "Indication rejected: the queue of consumer %s holds %u "
+                "indications.",
+            (const char*)consumerName.getCString(),
+            maxQueuedIndications));
+
+        MessageLoaderParms msgLoaderParms(
+            "DynListener.DynamicListenerIndicationDispatcher.QUEUE_FULL",
+            "The queue of consumer $0 is full.",
+            consumerName);
+
+        throw CIMException(CIM_ERR_FAILED, msgLoaderParms);
+    }
+
     //deliver indication to consumer
     //gets deleted by the DynamicConsumer
     IndicationDispatchEvent* event = new IndicationDispatchEvent(
@@ -646,6 +646,7 @@ int CIMListenerProcess::cimserver_run(
     Boolean enableConsumerUnload;
     Uint32 consumerIdleTimeout;
     Uint32 shutdownTimeout;
+    Uint32 maxQueuedIndications;
     String traceFile;
     Uint32 traceLevel;
     String traceComponents;
@@ -670,6 +671,8 @@ int CIMListenerProcess::cimserver_run(
     configManager->lookupIntegerValue("consumerIdleTimeout",
                                       consumerIdleTimeout);
     configManager->lookupIntegerValue("shutdownTimeout", shutdownTimeout);
+    configManager->lookupIntegerValue("maxQueuedIndications",
+                                      maxQueuedIndications);
     configManager->lookupValue("traceFilePath", traceFile);
     configManager->lookupIntegerValue("traceLevel", traceLevel);
     configManager->lookupValue("traceComponents", traceComponents);
@@ -828,6 +831,7 @@ MessageLoader::_useProcessLocale = false;
                 consumerIdleTimeout,
                 shutdownTimeout);
         }
+        _cimListener->setMaxQueuedIndications(maxQueuedIndications);
         _cimListener->start();
 
         Logger::put_l(Logger::STANDARD_LOG,
@@ -856,6 +860,7 @@ MessageLoader::_useProcessLocale = false;
         printf("\tenableConsumerUnload %d\n", enableConsumerUnload);
         printf("\tconsumerIdleTimeout %u\n", consumerIdleTimeout);
         printf("\tshutdownTimeout %u\n", shutdownTimeout);
+        printf("\tmaxQueuedIndications %u\n", maxQueuedIndications);
         printf("\ttraceFilePath %s\n", (const char*)traceFile.getCString());
         printf("\ttraceLevel %u\n", traceLevel);
         printf("\ttraceComponents %s\n",
@@ -33,6 +33,7 @@
 #include <Pegasus/Common/XmlWriter.h>
 #include <Pegasus/Common/TimeValue.h>
 #include <Pegasus/Common/MessageLoader.h>
+#include <Pegasus/Common/OperationContextInternal.h>
 
 #include "CIMExportClient.h"
 
@@ -67,7 +68,8 @@ CIMExportClient::~CIMExportClient()
 void CIMExportClient::exportIndication(
     const String& url,
     const CIMInstance& instanceName,
-    const ContentLanguageList& contentLanguages)
+    const ContentLanguageList& contentLanguages,
+    const OperationContext& context)
 {
     PEG_METHOD_ENTER (TRC_EXPORT_CLIENT, "CIMExportClient::exportIndication()");
 
@@ -85,6 +87,12 @@ void CIMExportClient::exportIndication(
         request->operationContext.set
             (ContentLanguageListContainer(contentLanguages));
 
+        if (context.contains(IndicationPayloadContainer::NAME))
+        {
+            request->operationContext.insert(
+                context.get(IndicationPayloadContainer::NAME));
+        }
+
         PEG_TRACE ((TRC_INDICATION_GENERATION, Tracer::LEVEL4,
             "Exporting %s Indication for destination %s:%d%s",
             (const char*)(instanceName.getClassName().getString().
@@ -57,10 +57,21 @@ public:
     // Destructor for a CIM Export Client object.
     ~CIMExportClient();
 
+    /**
+        Exports an indication to the connected listener.
+
+        @param url The path of the listener on the connected host.
+        @param instance The indication instance.
+        @param contentLanguages The content languages of the indication.
+        @param context If the context holds an IndicationPayloadContainer,
+            the shared encoding of the indication it refers to is used
+            instead of encoding the whole instance again.
+    */
     virtual void exportIndication(
         const String& url,
         const CIMInstance& instance,
-        const ContentLanguageList& contentLanguages = ContentLanguageList());
+        const ContentLanguageList& contentLanguages = ContentLanguageList(),
+        const OperationContext& context = OperationContext());
 
 private:
 
@@ -36,6 +36,7 @@
 #include <Pegasus/Common/HTTPMessage.h>
 #include <Pegasus/Common/AcceptLanguageList.h>
 #include <Pegasus/Common/ContentLanguageList.h>
+#include <Pegasus/Common/OperationContextInternal.h>
 #include "CIMExportRequestEncoder.h"
 
 PEGASUS_USING_STD;
@@ -102,8 +103,36 @@ void CIMExportRequestEncoder::_encodeExportIndicationRequest(
         "CIMExportRequestEncoder::_encodeExportIndicationRequest()");
     Buffer params;
 
-    XmlWriter::appendInstanceEParameter(
-        params, "NewIndication", message->indicationInstance);
+    if (message->operationContext.contains(IndicationPayloadContainer::NAME))
+    {
+        // The same indication is being exported to several destinations.
+        // Only the per-destination properties are encoded here; the rest
+        // of the instance is encoded once and shared.
+        IndicationPayload* payload = ((IndicationPayloadContainer)
+            message->operationContext.get(IndicationPayloadContainer::NAME))
+                .getPayload();
+        const Array<CIMName>& perDestinationProperties =
+            payload->getPerDestinationProperties();
+
+        if (!payload->appendEncoding(
+                IndicationPayload::FORMAT_CIMXML, params))
+        {
+            XmlWriter::appendInstanceEParameterBegin(
+                params,
+                "NewIndication",
+                message->indicationInstance,
+                perDestinationProperties);
+            payload->setEncoding(IndicationPayload::FORMAT_CIMXML, params);
+        }
+
+        XmlWriter::appendInstanceEParameterEnd(
+            params, message->indicationInstance, perDestinationProperties);
+    }
+    else
+    {
+        XmlWriter::appendInstanceEParameter(
+            params, "NewIndication", message->indicationInstance);
+    }
 
     // Note:  Accept-Language will not be set in the request
     // We will accept the default language of the export server.
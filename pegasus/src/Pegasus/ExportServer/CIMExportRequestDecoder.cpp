@@ -72,6 +72,7 @@ void CIMExportRequestDecoder::sendResponse(
     if (queue)
     {
         HTTPMessage* httpMessage = new HTTPMessage(message);
+        httpMessage->dest = queueId;
         httpMessage->setCloseConnect(closeConnect);
         queue->enqueue(httpMessage);
     }
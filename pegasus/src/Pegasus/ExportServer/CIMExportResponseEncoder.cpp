@@ -66,6 +66,7 @@ void CIMExportResponseEncoder::sendResponse(
     {
         HTTPMessage* httpMessage = new HTTPMessage(message);
 
+        httpMessage->dest = queueId;
         httpMessage->setCloseConnect(closeConnect);
 
         queue->enqueue(httpMessage);
@@ -30,6 +30,7 @@
 //%/////////////////////////////////////////////////////////////////////////////
 
 #include <Pegasus/Common/PegasusAssert.h>
+#include <Pegasus/Common/Tracer.h>
 #include "DynamicLibrary.h"
 
 #if defined(PEGASUS_OS_TYPE_WINDOWS)
@@ -81,6 +82,7 @@ DynamicLibrary::~DynamicLibrary()
     {
         PEGASUS_ASSERT(_handle != 0);
         _unload();
+        Tracer::libraryUnloaded();
     }
 }
 
@@ -156,6 +158,7 @@ void DynamicLibrary::unload()
         _unload();
         _handle = 0;
         _loadErrorMessage.clear();
+        Tracer::libraryUnloaded();
     }
 }
 
@@ -40,24 +40,51 @@
 #include <Pegasus/Common/System.h>
 #include <Pegasus/Common/Tracer.h>
 #include <Pegasus/Common/HostLocator.h>
+#include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/StringConversion.h>
 
 PEGASUS_NAMESPACE_BEGIN
 
 PEGASUS_USING_STD;
 
-class CIMXMLExportConnection : public IndicationExportConnection
+//
+// Export connections are pooled per listener so that the TCP connect and the
+// SSL handshake are not repeated every time a DestinationQueue drains and
+// releases its connection, and so that several destinations (or delivery
+// threads) sending to the same listener can share warm connections.
+//
+
+// Maximum number of idle connections kept open for a single listener.
+static const Uint32 _MAX_IDLE_CONNECTIONS_PER_LISTENER = 4;
+
+// Maximum number of idle connections kept open for all the listeners.
+static const Uint32 _MAX_IDLE_CONNECTIONS = 64;
+
+// Idle connections which were not used within this interval are closed.
+static const Uint64 _IDLE_CONNECTION_TIMEOUT_USEC = 60 * 1000000;
+
+/**
+    Holds the objects required to talk to one listener. The CIMExportClient
+    keeps the underlying HTTP connection open between the requests and
+    reconnects it if the listener has closed it in between.
+*/
+class CIMXMLExportClientConnection
 {
 public:
-    CIMXMLExportConnection(
-        Monitor         *monitor,
-        HTTPConnector   *connector,
-        CIMExportClient *client,
-        String           uri):
-            _monitor(monitor),_connector(connector),_client(client),_uri(uri)
+    CIMXMLExportClientConnection(
+        const String& poolKey,
+        Monitor* monitor,
+        HTTPConnector* connector,
+        CIMExportClient* client)
+        : _poolKey(poolKey),
+          _monitor(monitor),
+          _connector(connector),
+          _client(client),
+          _lastUsedTimeUsec(0)
     {
-    };
+    }
 
-    ~CIMXMLExportConnection()
+    ~CIMXMLExportClientConnection()
     {
         delete _client;
         delete _connector;
@@ -69,16 +96,210 @@ public:
         return _client;
     }
 
+    const String& getPoolKey() const
+    {
+        return _poolKey;
+    }
+
+    Uint64 getLastUsedTimeUsec() const
+    {
+        return _lastUsedTimeUsec;
+    }
+
+    void setLastUsedTimeUsec(Uint64 timeUsec)
+    {
+        _lastUsedTimeUsec = timeUsec;
+    }
+
+private:
+    CIMXMLExportClientConnection(const CIMXMLExportClientConnection&);
+    CIMXMLExportClientConnection& operator=(
+        const CIMXMLExportClientConnection&);
+
+    String _poolKey;
+    Monitor* _monitor;
+    HTTPConnector* _connector;
+    CIMExportClient* _client;
+    Uint64 _lastUsedTimeUsec;
+};
+
+/**
+    Bounded pool of idle listener connections keyed by the scheme, host,
+    port and the TLS identity (certificate and key) of the connection.
+    Connections which are in use are owned by their CIMXMLExportConnection
+    and are returned to the pool when it is destroyed.
+*/
+class CIMXMLExportConnectionPool
+{
+public:
+    CIMXMLExportConnectionPool()
+    {
+    }
+
+    ~CIMXMLExportConnectionPool()
+    {
+        clear();
+    }
+
+    /**
+        Returns the most recently used idle connection for the listener
+        identified by poolKey, or 0 if there is none. Connections idle for
+        longer than the idle timeout are closed first.
+    */
+    CIMXMLExportClientConnection* acquire(const String& poolKey)
+    {
+        AutoMutex mtx(_mutex);
+
+        _reapIdleConnections(System::getCurrentTimeUsec());
+
+        for (Uint32 i = _idleConnections.size(); i > 0; i--)
+        {
+            CIMXMLExportClientConnection* conn = _idleConnections[i - 1];
+            if (String::equal(conn->getPoolKey(), poolKey))
+            {
+                _idleConnections.remove(i - 1);
+                PEG_TRACE((TRC_IND_HANDLER, Tracer::LEVEL4,
+                    "Reusing pooled export connection for %s",
+                    (const char*)poolKey.getCString()));
+                return conn;
+            }
+        }
+
+        return 0;
+    }
+
+    /**
+        Returns a connection to the pool. The connection is closed instead
+        if the pool already holds the maximum number of idle connections
+        for the listener.
+    */
+    void release(CIMXMLExportClientConnection* conn)
+    {
+        Uint64 timeNowUsec = System::getCurrentTimeUsec();
+        conn->setLastUsedTimeUsec(timeNowUsec);
+
+        AutoMutex mtx(_mutex);
+
+        _reapIdleConnections(timeNowUsec);
+
+        Uint32 listenerIdleCount = 0;
+        Uint32 oldestIndex = PEG_NOT_FOUND;
+
+        for (Uint32 i = 0, n = _idleConnections.size(); i < n; i++)
+        {
+            if (String::equal(
+                    _idleConnections[i]->getPoolKey(), conn->getPoolKey()))
+            {
+                if (listenerIdleCount++ == 0)
+                {
+                    oldestIndex = i;
+                }
+            }
+        }
+
+        // Keep the most recently used connections, they are the least
+        // likely ones to have been closed by the listener.
+        if (listenerIdleCount >= _MAX_IDLE_CONNECTIONS_PER_LISTENER)
+        {
+            delete _idleConnections[oldestIndex];
+            _idleConnections.remove(oldestIndex);
+        }
+        else if (_idleConnections.size() >= _MAX_IDLE_CONNECTIONS)
+        {
+            delete _idleConnections[0];
+            _idleConnections.remove(0);
+        }
+
+        _idleConnections.append(conn);
+    }
+
+    /**
+        Closes all the idle connections.
+    */
+    void clear()
+    {
+        AutoMutex mtx(_mutex);
+
+        for (Uint32 i = 0, n = _idleConnections.size(); i < n; i++)
+        {
+            delete _idleConnections[i];
+        }
+        _idleConnections.clear();
+    }
+
+private:
+    CIMXMLExportConnectionPool(const CIMXMLExportConnectionPool&);
+    CIMXMLExportConnectionPool& operator=(const CIMXMLExportConnectionPool&);
+
+    // Idle connections are kept in least recently used order, so the
+    // expired ones are always at the front. Caller must hold _mutex.
+    void _reapIdleConnections(Uint64 timeNowUsec)
+    {
+        while (_idleConnections.size() &&
+            (timeNowUsec < _idleConnections[0]->getLastUsedTimeUsec() ||
+             timeNowUsec - _idleConnections[0]->getLastUsedTimeUsec() >=
+                 _IDLE_CONNECTION_TIMEOUT_USEC))
+        {
+            PEG_TRACE((TRC_IND_HANDLER, Tracer::LEVEL4,
+                "Closing idle export connection for %s",
+                (const char*)_idleConnections[0]->getPoolKey().getCString()));
+            delete _idleConnections[0];
+            _idleConnections.remove(0);
+        }
+    }
+
+    Array<CIMXMLExportClientConnection*> _idleConnections;
+    Mutex _mutex;
+};
+
+/**
+    The connection handed out to the DestinationQueue. It leases a pooled
+    listener connection and returns it to the pool when the DestinationQueue
+    is done with it, unless the last delivery using it has failed.
+*/
+class CIMXMLExportConnection : public IndicationExportConnection
+{
+public:
+    CIMXMLExportConnection(
+        CIMXMLExportConnectionPool* pool,
+        CIMXMLExportClientConnection* conn,
+        const String& uri)
+        : _pool(pool), _conn(conn), _uri(uri), _reusable(false)
+    {
+    }
+
+    ~CIMXMLExportConnection()
+    {
+        if (_reusable)
+        {
+            _pool->release(_conn);
+        }
+        else
+        {
+            delete _conn;
+        }
+    }
+
+    CIMExportClient* getClient() const
+    {
+        return _conn->getClient();
+    }
+
     String getURI() const
     {
         return _uri;
     }
- 
+
+    void setReusable(Boolean reusable)
+    {
+        _reusable = reusable;
+    }
+
 private:
-    Monitor         *_monitor;
-    HTTPConnector   *_connector;
-    CIMExportClient *_client;
-    String           _uri;
+    CIMXMLExportConnectionPool* _pool;
+    CIMXMLExportClientConnection* _conn;
+    String _uri;
+    Boolean _reusable;
 };
 
 static Boolean verifyListenerCertificate(SSLCertificateInfo& certInfo)
@@ -114,7 +335,7 @@ public:
 
     void terminate()
     {
-
+        _connectionPool.clear();
     }
 
     void handleIndication(
@@ -167,7 +388,8 @@ public:
                     conn->getClient()->exportIndication(
                         conn->getURI(),
                         indicationInstance,
-                        contentLanguages);
+                        contentLanguages,
+                        context);
                 }
                 catch(const Exception &e)
                 {
@@ -179,6 +401,7 @@ public:
                 }
                 if (errorMsg.size())
                 {
+                    conn->setReusable(false);
                     delete conn;
                     *connection = 0;
                     PEG_TRACE ((TRC_INDICATION_GENERATION, Tracer::LEVEL1,
@@ -282,13 +505,6 @@ public:
                 ConfigManager::getHomedPath(PEGASUS_SSLSERVER_RANDOMFILE);
 #endif
 
-            AutoPtr<Monitor> monitor(new Monitor());
-            AutoPtr<HTTPConnector> httpConnector(
-                new HTTPConnector(monitor.get()));
-
-            AutoPtr<CIMExportClient> exportclient(
-                new CIMExportClient(monitor.get(), httpConnector.get()));
-
             Uint32 colon = dest.find (":");
             Uint32 portNumber = 0;
             Boolean useHttps = false;
@@ -387,75 +603,114 @@ public:
                 throw PEGASUS_CIM_EXCEPTION(CIM_ERR_NOT_SUPPORTED, msg);
             }
 
-#ifndef PEGASUS_OS_ZOS
-
+            // Connections are shared by all the destinations of a listener
+            // which use the same transport and TLS identity.
+            String poolKey = useHttps ? "https://" : "http://";
+            poolKey.append(hostName);
+            poolKey.append(Char16(':'));
+            char portBuffer[22];
+            Uint32 portLen;
+            const char* portStr =
+                Uint32ToString(portBuffer, portNumber, portLen);
+            poolKey.append(portStr, portLen);
             if (useHttps)
             {
+                poolKey.append(Char16(' '));
+                poolKey.append(certPath);
+                poolKey.append(Char16(' '));
+                poolKey.append(keyPath);
+            }
+
+            CIMXMLExportClientConnection* clientConn =
+                _connectionPool.acquire(poolKey);
+
+            if (!clientConn)
+            {
+                AutoPtr<Monitor> monitor(new Monitor());
+                AutoPtr<HTTPConnector> httpConnector(
+                    new HTTPConnector(monitor.get()));
+
+                AutoPtr<CIMExportClient> exportclient(
+                    new CIMExportClient(monitor.get(), httpConnector.get()));
+
+#ifndef PEGASUS_OS_ZOS
+
+                if (useHttps)
+                {
 #ifdef PEGASUS_HAS_SSL
-                PEG_TRACE_CSTRING(TRC_IND_HANDLER, Tracer::LEVEL4,
-                    "Build SSL Context...");
+                    PEG_TRACE_CSTRING(TRC_IND_HANDLER, Tracer::LEVEL4,
+                        "Build SSL Context...");
 
-                SSLContext sslcontext(trustPath,
-                    certPath, keyPath, verifyListenerCertificate, randFile);
-                exportclient->connect (hostName, portNumber, sslcontext);
+                    SSLContext sslcontext(trustPath, certPath, keyPath,
+                        verifyListenerCertificate, randFile);
+                    exportclient->connect (hostName, portNumber, sslcontext);
 #else
-                PEG_TRACE((
-                    TRC_DISCARDED_DATA, Tracer::LEVEL1,
-                    "CIMxmlIndicationHandler::handleIndication failed to "
-                    "deliver indication: "
-                    "https not supported "
-                    "in Destination %s",
-                    (const char*) dest.getCString()));
-
-                MessageLoaderParms param(
-                    "Handler.CIMxmlIndicationHandler.CIMxmlIndicationHandler."
-                        "CANNOT_DO_HTTPS_CONNECTION",
-                    "SSL is not available. "
-                        "Cannot support an HTTPS connection.");
+                    PEG_TRACE((
+                        TRC_DISCARDED_DATA, Tracer::LEVEL1,
+                        "CIMxmlIndicationHandler::handleIndication failed to "
+                        "deliver indication: "
+                        "https not supported "
+                        "in Destination %s",
+                        (const char*) dest.getCString()));
+
+                    MessageLoaderParms param(
+                        "Handler.CIMxmlIndicationHandler."
+                            "CIMxmlIndicationHandler."
+                            "CANNOT_DO_HTTPS_CONNECTION",
+                        "SSL is not available. "
+                            "Cannot support an HTTPS connection.");
 
-                PEG_METHOD_EXIT();
-                throw PEGASUS_CIM_EXCEPTION(
-                    CIM_ERR_FAILED,
-                    MessageLoader::getMessage(param));
+                    PEG_METHOD_EXIT();
+                    throw PEGASUS_CIM_EXCEPTION(
+                        CIM_ERR_FAILED,
+                        MessageLoader::getMessage(param));
 #endif
-            }
-            else
-            {
-                exportclient->connect (hostName, portNumber);
-            }
+                }
+                else
+                {
+                    exportclient->connect (hostName, portNumber);
+                }
 #else
-            // On zOS the ATTLS facility is using the port number(s) defined
-            // of the outbound policy to decide if the indication is
-            // delivered through a SSL secured socket. This is totally
-            // transparent to the CIM Server.
-            exportclient->connect (hostName, portNumber);
+                // On zOS the ATTLS facility is using the port number(s) defined
+                // of the outbound policy to decide if the indication is
+                // delivered through a SSL secured socket. This is totally
+                // transparent to the CIM Server.
+                exportclient->connect (hostName, portNumber);
 
 #endif
+
+                clientConn = new CIMXMLExportClientConnection(
+                    poolKey,
+                    monitor.release(),
+                    httpConnector.release(),
+                    exportclient.release());
+            }
+
             // check destStr, if no path is specified, use "/" for the URI
             Uint32 slash = destStr.find ("/");
             String uri = "/";
             if (slash != PEG_NOT_FOUND)
             {
                 uri = destStr.subString(slash);
-                exportclient->exportIndication(
-                    uri, indicationInstance, contentLanguages);
-            }
-            else
-            {
-                exportclient->exportIndication(
-                    uri, indicationInstance, contentLanguages);
             }
 
-            // Save the connection if requested for future use.
+            AutoPtr<CIMXMLExportConnection> conn(
+                new CIMXMLExportConnection(
+                    &_connectionPool,
+                    clientConn,
+                    uri));
+
+            conn->getClient()->exportIndication(
+                uri, indicationInstance, contentLanguages, context);
+
+            conn->setReusable(true);
+
+            // Save the connection if requested for future use, otherwise
+            // it goes back to the pool.
             if (connection)
             {
-                *connection =  new CIMXMLExportConnection(
-                    monitor.release(),
-                    httpConnector.release(),
-                    exportclient.release(),
-                    uri);
+                *connection = conn.release();
             }
-
         }
         catch(Exception& e)
         {
@@ -476,6 +731,8 @@ public:
     }
 
 private:
+    CIMXMLExportConnectionPool _connectionPool;
+
     String _getMalformedExceptionMsg(
         String destinationValue)
     {
@@ -0,0 +1,129 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#include <Pegasus/Common/PegasusAssert.h>
+#include "DeliveryTimerWheel.h"
+
+PEGASUS_NAMESPACE_BEGIN
+
+DeliveryTimerWheel::DeliveryTimerWheel(
+    Uint32 numSlots,
+    Uint64 tickUsec,
+    Uint64 timeNowUsec)
+    : _numSlots(numSlots),
+      _tickUsec(tickUsec),
+      _currentTick(timeNowUsec / tickUsec),
+      _size(0)
+{
+    PEGASUS_ASSERT(numSlots > 0 && tickUsec > 0);
+    _slots = new Slot[numSlots];
+}
+
+DeliveryTimerWheel::~DeliveryTimerWheel()
+{
+    // The slots must not delete the entries they do not own.
+    for (Uint32 i = 0; i < _numSlots; i++)
+    {
+        while (_slots[i].remove_front())
+        {
+        }
+    }
+    delete [] _slots;
+}
+
+void DeliveryTimerWheel::schedule(
+    DeliveryTimerEntry* entry,
+    Uint64 expirationTimeUsec)
+{
+    PEGASUS_ASSERT(entry->list == 0);
+
+    // Round up so that entries never expire before their time.
+    Uint64 tick = _getTick(expirationTimeUsec);
+
+    // The slot of the current tick has been visited already.
+    if (tick <= _currentTick)
+    {
+        tick = _currentTick + 1;
+    }
+
+    entry->expirationTimeUsec = expirationTimeUsec;
+    entry->timerSlot = Uint32(tick % _numSlots);
+    _slots[entry->timerSlot].insert_back(entry);
+    _size++;
+}
+
+void DeliveryTimerWheel::cancel(DeliveryTimerEntry* entry)
+{
+    _slots[entry->timerSlot].remove(entry);
+    _size--;
+}
+
+void DeliveryTimerWheel::advance(
+    Uint64 timeNowUsec,
+    Array<DeliveryTimerEntry*>& expired)
+{
+    Uint64 targetTick = timeNowUsec / _tickUsec;
+
+    if (targetTick <= _currentTick)
+    {
+        return;
+    }
+
+    // If we fell behind by more than one revolution, each slot has to be
+    // visited only once.
+    Uint64 ticks = targetTick - _currentTick;
+    if (ticks > _numSlots)
+    {
+        ticks = _numSlots;
+    }
+
+    for (Uint64 i = 1; i <= ticks; i++)
+    {
+        Slot& slot = _slots[(_currentTick + i) % _numSlots];
+
+        DeliveryTimerEntry* entry = slot.front();
+        while (entry)
+        {
+            DeliveryTimerEntry* next = slot.next_of(entry);
+            if (_getTick(entry->expirationTimeUsec) <= targetTick)
+            {
+                slot.remove(entry);
+                _size--;
+                expired.append(entry);
+            }
+            entry = next;
+        }
+    }
+
+    _currentTick = targetTick;
+}
+
+PEGASUS_NAMESPACE_END
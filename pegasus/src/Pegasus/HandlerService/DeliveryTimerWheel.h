@@ -0,0 +1,131 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#ifndef Pegasus_DeliveryTimerWheel_h
+#define Pegasus_DeliveryTimerWheel_h
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/List.h>
+#include <Pegasus/Common/ArrayInternal.h>
+
+#include <Pegasus/HandlerService/Linkage.h>
+
+PEGASUS_NAMESPACE_BEGIN
+
+/**
+    An element which can be scheduled on the DeliveryTimerWheel. The fields
+    are maintained by the timer wheel and are protected by the lock of its
+    owner.
+*/
+struct PEGASUS_HANDLER_SERVICE_LINKAGE DeliveryTimerEntry : public Linkable
+{
+    DeliveryTimerEntry() : expirationTimeUsec(0), timerSlot(0)
+    {
+    }
+
+    Uint64 expirationTimeUsec;
+    Uint32 timerSlot;
+};
+
+/**
+    Hashed timer wheel used to schedule the delivery retries of the
+    DestinationQueues. Scheduling and cancelling an entry is O(1), and
+    advancing the wheel only visits the slots of the elapsed ticks, so the
+    cost does not grow with the number of destinations which have nothing
+    to deliver. Entries which expire more than one wheel revolution ahead
+    stay in their slot until their expiration time is reached.
+
+    The wheel does not own the entries and does no locking of its own.
+*/
+class PEGASUS_HANDLER_SERVICE_LINKAGE DeliveryTimerWheel
+{
+public:
+
+    DeliveryTimerWheel(Uint32 numSlots, Uint64 tickUsec, Uint64 timeNowUsec);
+
+    /**
+        Unlinks the entries still scheduled, the entries are not deleted.
+    */
+    ~DeliveryTimerWheel();
+
+    /**
+        Schedules the entry to expire at expirationTimeUsec. Entries which
+        are already due expire on the next tick. The entry must not be
+        scheduled already.
+    */
+    void schedule(DeliveryTimerEntry* entry, Uint64 expirationTimeUsec);
+
+    /**
+        Removes a scheduled entry from the wheel.
+    */
+    void cancel(DeliveryTimerEntry* entry);
+
+    /**
+        Advances the wheel to timeNowUsec and appends the entries which have
+        expired to the expired array. The expired entries are removed from
+        the wheel.
+    */
+    void advance(Uint64 timeNowUsec, Array<DeliveryTimerEntry*>& expired);
+
+    /**
+        Returns the number of entries scheduled on the wheel.
+    */
+    Uint32 size() const
+    {
+        return _size;
+    }
+
+    Uint64 getTickUsec() const
+    {
+        return _tickUsec;
+    }
+
+private:
+    DeliveryTimerWheel(const DeliveryTimerWheel&);
+    DeliveryTimerWheel& operator=(const DeliveryTimerWheel&);
+
+    Uint64 _getTick(Uint64 timeUsec) const
+    {
+        return (timeUsec + _tickUsec - 1) / _tickUsec;
+    }
+
+    typedef List<DeliveryTimerEntry, NullLock> Slot;
+
+    Slot* _slots;
+    Uint32 _numSlots;
+    Uint64 _tickUsec;
+    Uint64 _currentTick;
+    Uint32 _size;
+};
+
+PEGASUS_NAMESPACE_END
+
+#endif // Pegasus_DeliveryTimerWheel_h
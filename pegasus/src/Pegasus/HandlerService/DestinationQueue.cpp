@@ -214,6 +214,7 @@ DestinationQueue::DestinationQueue(
     _sequenceContext.append("-");
 
     _connection = 0;
+    schedulingState = SCHEDULE_IDLE;
 
     Uint32 len = 0;
     char buffer[22];
@@ -721,6 +722,34 @@ IndicationInfo* DestinationQueue::getNextIndicationForDelivery(
     return 0;
 }
 
+Uint64 DestinationQueue::getNextDeliveryTimeUsec()
+{
+    AutoMutex mtx(_queueMutex);
+
+    if (!_queue.size() || _lastDeliveryRetryStatus == PENDING)
+    {
+        return 0;
+    }
+
+    IndicationInfo *info = _queue.front();
+
+    if (!info->lastDeliveryRetryTimeUsec)
+    {
+        return info->arrivalTimeUsec;
+    }
+
+    return info->lastDeliveryRetryTimeUsec + _minDeliveryRetryIntervalUsec;
+}
+
+void DestinationQueue::releaseConnection()
+{
+    AutoMutex mtx(_queueMutex);
+
+    PEGASUS_ASSERT(_lastDeliveryRetryStatus != PENDING);
+    delete _connection;
+    _connection = 0;
+}
+
 void DestinationQueue::setDeliveryRetryAttempts( Uint16 DeliveryRetryAttempts )
 {
     AutoMutex mtx(_intializeMutex);
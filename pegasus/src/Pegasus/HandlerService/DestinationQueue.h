@@ -42,6 +42,7 @@
 
 #include <Pegasus/HandlerService/Linkage.h>
 #include <Pegasus/HandlerService/IndicationHandlerConstants.h>
+#include <Pegasus/HandlerService/DeliveryTimerWheel.h>
 #include <Pegasus/Handler/CIMHandler.h>
 
 PEGASUS_NAMESPACE_BEGIN
@@ -94,9 +95,15 @@ public:
 /**
     The DestinationQueue class holds the indications to be delivered to the
     destination in the form of IndicationInfo.
+
+    The queue is itself scheduled by the IndicationHandlerService delivery
+    scheduler, either on its ready list or on its retry timer wheel. The
+    Linkable and DeliveryTimerEntry members and schedulingState are owned
+    by the scheduler and protected by its mutex.
 */
 
-class PEGASUS_HANDLER_SERVICE_LINKAGE DestinationQueue
+class PEGASUS_HANDLER_SERVICE_LINKAGE DestinationQueue :
+    public DeliveryTimerEntry
 {
 public:
     // Structure to hold the queue statistics information
@@ -135,6 +142,19 @@ public:
         SUCCESS,
     };
 
+    // Scheduling states of the DestinationQueue. A queue is delivered by
+    // at most one delivery thread at a time, which preserves the order of
+    // the indications for the destination.
+    enum
+    {
+        SCHEDULE_IDLE,       // Nothing to deliver.
+        SCHEDULE_READY,      // On the ready list of the scheduler.
+        SCHEDULE_WAITING,    // On the retry timer wheel of the scheduler.
+        SCHEDULE_DELIVERING  // Being delivered by a delivery thread.
+    };
+
+    Uint32 schedulingState;
+
     DestinationQueue(const CIMInstance &handler);
     ~DestinationQueue();
 
@@ -218,6 +238,20 @@ public:
     IndicationInfo* getNextIndicationForDelivery(
         Uint64 &timeNowUsec, Uint64 &nextIndDRIExpTimeUsec);
 
+    /**
+        Returns the time at which the indication at the front of the queue
+        becomes eligible for delivery, which is in the past if it may be
+        delivered right away. Returns 0 if the queue is empty or if an
+        indication from the queue is being delivered.
+    */
+    Uint64 getNextDeliveryTimeUsec();
+
+    /**
+        Deletes the connection saved for the destination, if any. Must not
+        be called while an indication from the queue is being delivered.
+    */
+    void releaseConnection();
+
     void getInfo(QueueInfo &qinfo);
 
     IndicationExportConnection** getConnectionPtr()
@@ -50,6 +50,33 @@ PEGASUS_NAMESPACE_BEGIN
 
 #ifdef PEGASUS_ENABLE_DMTF_INDICATION_PROFILE_SUPPORT
 static struct timeval deallocateWait = { 300, 0 };
+
+// The retry timer wheel covers 64 seconds per revolution with a resolution
+// of 250 milliseconds. Longer DeliveryRetryIntervals take several
+// revolutions.
+static const Uint32 _RETRY_TIMER_WHEEL_SLOTS = 256;
+static const Uint64 _RETRY_TIMER_WHEEL_TICK_USEC = 250000;
+
+// Time the dispatcher thread waits when no delivery retry is scheduled.
+static const Uint32 _DISPATCHER_IDLE_WAIT_MSEC = 5000;
+
+// Returns the value of the maxIndicationDeliveryThreads config property.
+static Uint32 _getMaxDeliveryThreads()
+{
+    Uint32 maxDeliveryThreads = 5;
+    Uint64 v;
+
+    String strValue = ConfigManager::getInstance()->getCurrentValue(
+        "maxIndicationDeliveryThreads");
+
+    if (StringConversion::decimalStringToUint64(strValue.getCString(), v) &&
+        StringConversion::checkUintBounds(v, CIMTYPE_UINT16) && v > 0)
+    {
+        maxDeliveryThreads = (Uint32)v;
+    }
+
+    return maxDeliveryThreads;
+}
 #endif
 
 IndicationHandlerService::IndicationHandlerService(CIMRepository* repository)
@@ -57,9 +84,18 @@ IndicationHandlerService::IndicationHandlerService(CIMRepository* repository)
       _repository(repository)
 #ifdef PEGASUS_ENABLE_DMTF_INDICATION_PROFILE_SUPPORT
       ,_destinationQueueTable(),
-      _deliveryThreadPool(0, "IndicationHandlerService", 0, 5, deallocateWait),
+      _retryTimerWheel(
+          _RETRY_TIMER_WHEEL_SLOTS,
+          _RETRY_TIMER_WHEEL_TICK_USEC,
+          System::getCurrentTimeUsec()),
+      _maxDeliveryThreads(_getMaxDeliveryThreads()),
+      _deliveryThreadPool(
+          0,
+          "IndicationHandlerService",
+          0,
+          _maxDeliveryThreads,
+          deallocateWait),
       _dispatcherThread(_dispatcherRoutine, this, true),
-      _maxDeliveryThreads(5),
       _needDestinationQueueCleanup(false) 
 #endif
 {
@@ -84,6 +120,9 @@ IndicationHandlerService::IndicationHandlerService(CIMRepository* repository)
             _maxDeliveryRetry));
     }
 
+    PEG_TRACE((TRC_IND_HANDLER, Tracer::LEVEL4,
+        "Value of maxIndicationDeliveryThreads when cimserver start = %u",
+        _maxDeliveryThreads));
 #endif
 }
 
@@ -914,6 +953,7 @@ CIMNotifyListenerNotActiveResponseMessage*
 
     if (_destinationQueueTable.lookup(queueName, queue))
     {
+        _unscheduleQueue(queue);
         queue->cleanup();
         delete queue;
         PEGASUS_FCT_EXECUTE_AND_ASSERT(
@@ -1033,7 +1073,7 @@ void IndicationHandlerService::_setSequenceIdentifierAndEnqueue(
         if (_destinationQueueTable.lookup(queueName, queue))
         {
             queue->enqueue(message);
-            _dispatcherWaitSemaphore.signal();
+            _scheduleQueue(queue);
             PEG_TRACE((TRC_IND_HANDLER, Tracer::LEVEL4,
                 "DestinationQueue %s already exists",
                 (const char*)queueName.getCString()));
@@ -1046,7 +1086,7 @@ void IndicationHandlerService::_setSequenceIdentifierAndEnqueue(
     if (_destinationQueueTable.lookup(queueName, queue))
     {
         queue->enqueue(message);
-        _dispatcherWaitSemaphore.signal();
+        _scheduleQueue(queue);
         PEG_TRACE((TRC_IND_HANDLER, Tracer::LEVEL4,
             "DestinationQueue %s already exists",
             (const char*)queueName.getCString()));
@@ -1060,7 +1100,7 @@ void IndicationHandlerService::_setSequenceIdentifierAndEnqueue(
         _destinationQueueTable.insert(queueName, queue));
 
     queue->enqueue(message);
-    _dispatcherWaitSemaphore.signal();
+    _scheduleQueue(queue);
     PEG_TRACE((TRC_IND_HANDLER, Tracer::LEVEL4,
         "DestinationQueue %s created",
         (const char*)queueName.getCString()));
@@ -1141,6 +1181,103 @@ String IndicationHandlerService::_getQueueName(
     return queueName;
 }
 
+void IndicationHandlerService::_scheduleQueue(DestinationQueue *queue)
+{
+    AutoMutex mtx(_schedulerMutex);
+
+    if (queue->schedulingState == DestinationQueue::SCHEDULE_IDLE)
+    {
+        queue->schedulingState = DestinationQueue::SCHEDULE_READY;
+        _readyQueues.insert_back(queue);
+        _startDeliveryThread();
+    }
+}
+
+void IndicationHandlerService::_rescheduleQueue(DestinationQueue *queue)
+{
+    AutoMutex mtx(_schedulerMutex);
+
+    PEGASUS_ASSERT(
+        queue->schedulingState == DestinationQueue::SCHEDULE_DELIVERING);
+
+    Uint64 nextDeliveryTimeUsec = queue->getNextDeliveryTimeUsec();
+
+    if (!nextDeliveryTimeUsec)
+    {
+        // Nothing left to deliver, the connection is saved only while
+        // there are indications for the destination.
+        queue->schedulingState = DestinationQueue::SCHEDULE_IDLE;
+        queue->releaseConnection();
+    }
+    else if (nextDeliveryTimeUsec <= System::getCurrentTimeUsec())
+    {
+        // Go to the back of the ready list to give the other destinations
+        // a fair share of the delivery threads.
+        queue->schedulingState = DestinationQueue::SCHEDULE_READY;
+        _readyQueues.insert_back(queue);
+        _startDeliveryThread();
+    }
+    else
+    {
+        queue->schedulingState = DestinationQueue::SCHEDULE_WAITING;
+        _retryTimerWheel.schedule(queue, nextDeliveryTimeUsec);
+        if (_retryTimerWheel.size() == 1)
+        {
+            // Wake up the dispatcher if it was waiting with the idle timeout.
+            _dispatcherWaitSemaphore.signal();
+        }
+    }
+}
+
+void IndicationHandlerService::_unscheduleQueue(DestinationQueue *queue)
+{
+    PEG_METHOD_ENTER(TRC_IND_HANDLER,
+        "IndicationHandlerService::_unscheduleQueue");
+
+    while (true)
+    {
+        {
+            AutoMutex mtx(_schedulerMutex);
+
+            if (queue->schedulingState == DestinationQueue::SCHEDULE_READY)
+            {
+                _readyQueues.remove(queue);
+                queue->schedulingState = DestinationQueue::SCHEDULE_IDLE;
+            }
+            else if (queue->schedulingState ==
+                DestinationQueue::SCHEDULE_WAITING)
+            {
+                _retryTimerWheel.cancel(queue);
+                queue->schedulingState = DestinationQueue::SCHEDULE_IDLE;
+            }
+
+            if (queue->schedulingState == DestinationQueue::SCHEDULE_IDLE)
+            {
+                break;
+            }
+        }
+        Threads::yield();
+        Threads::sleep(50);
+    }
+
+    PEG_METHOD_EXIT();
+}
+
+void IndicationHandlerService::_startDeliveryThread()
+{
+    if (_readyQueues.size() &&
+        Uint32(_deliveryThreadsRunningCount.get()) < _maxDeliveryThreads)
+    {
+        _deliveryThreadsRunningCount++;
+        if (_deliveryThreadPool.allocate_and_awaken(
+                this, _deliveryRoutine, 0) != PEGASUS_THREAD_OK)
+        {
+            // The dispatcher retries on its next wakeup.
+            _deliveryThreadsRunningCount--;
+        }
+    }
+}
+
 ThreadReturnType PEGASUS_THREAD_CDECL
     IndicationHandlerService::_dispatcherRoutine(void *parm)
 {
@@ -1151,26 +1288,25 @@ ThreadReturnType PEGASUS_THREAD_CDECL
     IndicationHandlerService *service =
         reinterpret_cast<IndicationHandlerService*>(myself->get_parm());
 
-    const Uint32 RETRY_THREAD_MAX_WAITTIME = // milliseconds
-        DestinationQueue::getDeliveryRetryIntervalSeconds() * 1000;
+    const Uint32 tickMsec =
+        Uint32(service->_retryTimerWheel.getTickUsec() / 1000);
 
-    DestinationQueue *queue;
     Uint64 timeNowUsec;
-    IndicationInfo *indication;
     Uint64 idleTimeoutUsec;
-
-    // Holds the minimum of next eligible indication DeliveryRetryInterval
-    // expiration time from all DestinationQueues.
-    Uint32 nextMinIndDRIExpTime = RETRY_THREAD_MAX_WAITTIME;
+    Uint32 waitMsec = _DISPATCHER_IDLE_WAIT_MSEC;
+    Array<DeliveryTimerEntry*> expired;
 
     idleTimeoutUsec = System::getCurrentTimeUsec();
     service->_deliveryThreadsRunningCount = 0;
 
+    // The dispatcher only moves the queues whose delivery retry is due from
+    // the retry timer wheel to the ready list. Queues with new indications
+    // are put on the ready list directly by _scheduleQueue().
     for (;;)
     {
         try
         {
-            service->_dispatcherWaitSemaphore.time_wait(nextMinIndDRIExpTime);
+            service->_dispatcherWaitSemaphore.time_wait(waitMsec);
 
             // Check if we need to terminate
             if (service->_stopDispatcherThread.get())
@@ -1179,45 +1315,30 @@ ThreadReturnType PEGASUS_THREAD_CDECL
                 break;
             }
 
-            nextMinIndDRIExpTime = RETRY_THREAD_MAX_WAITTIME;
             timeNowUsec = System::getCurrentTimeUsec();
 
-            Uint64 nextIndDRIExpTime;
-
             {
-                ReadLock lock(service->_destinationQueueTableLock);
+                AutoMutex mtx(service->_schedulerMutex);
 
-                DestinationQueueTable::Iterator i =
-                    service->_destinationQueueTable.start();
+                expired.clear();
+                service->_retryTimerWheel.advance(timeNowUsec, expired);
 
-                for(; i; i++)
+                for (Uint32 i = 0, n = expired.size(); i < n; i++)
                 {
-                    queue = i.value();
-                    if ((indication = queue->getNextIndicationForDelivery(
-                        timeNowUsec, nextIndDRIExpTime)))
-                    {
-                        service->_deliveryQueue.insert_back(indication);
-                        if (service->_deliveryThreadsRunningCount.get()
-                            < service->_maxDeliveryThreads)
-                        {
-                            service->_deliveryThreadsRunningCount++;
-                            if (service->
-                                _deliveryThreadPool.allocate_and_awaken(
-                                    service, _deliveryRoutine, 0)
-                                        != PEGASUS_THREAD_OK)
-                            {
-                                service->_deliveryThreadsRunningCount--;
-                            }
-                        }
-                    }
+                    DestinationQueue *queue =
+                        static_cast<DestinationQueue*>(expired[i]);
+                    queue->schedulingState =
+                        DestinationQueue::SCHEDULE_READY;
+                    service->_readyQueues.insert_back(queue);
+                }
 
-                    // convert to milliseconds
-                    nextIndDRIExpTime/= 1000;
-                    if (nextIndDRIExpTime < nextMinIndDRIExpTime)
-                    {
-                        nextMinIndDRIExpTime = nextIndDRIExpTime;
-                    }
+                for (Uint32 i = service->_readyQueues.size(); i > 0; i--)
+                {
+                    service->_startDeliveryThread();
                 }
+
+                waitMsec = service->_retryTimerWheel.size() ?
+                    tickMsec : _DISPATCHER_IDLE_WAIT_MSEC;
             }
 
             // Cleanup idle threads for every 5 minutes
@@ -1259,15 +1380,51 @@ ThreadReturnType PEGASUS_THREAD_CDECL
     IndicationHandlerService *service =
         reinterpret_cast<IndicationHandlerService *>(parm);
 
-    IndicationInfo *indication;
+    DestinationQueue *queue;
 
-    while ((indication = service->_deliveryQueue.remove_front()))
+    for (;;)
     {
-        service->_deliverIndication(indication);
-        // Notify the dispatcher that the indication delivery has finished.
-        service->_dispatcherWaitSemaphore.signal();
+        {
+            AutoMutex mtx(service->_schedulerMutex);
+
+            if (!(queue = service->_readyQueues.remove_front()))
+            {
+                service->_deliveryThreadsRunningCount--;
+                break;
+            }
+            queue->schedulingState = DestinationQueue::SCHEDULE_DELIVERING;
+        }
+
+        // Deliver one indication and reschedule the queue, so that the
+        // delivery threads are shared fairly by all the destinations.
+        try
+        {
+            Uint64 timeNowUsec = System::getCurrentTimeUsec();
+            Uint64 nextIndDRIExpTimeUsec;
+            IndicationInfo *indication = queue->getNextIndicationForDelivery(
+                timeNowUsec, nextIndDRIExpTimeUsec);
+
+            if (indication)
+            {
+                service->_deliverIndication(indication);
+            }
+        }
+        catch(const Exception &e)
+        {
+            PEG_TRACE((TRC_IND_HANDLER, Tracer::LEVEL4,
+                "Unexpected exception in IndicationHandlerService::"
+                    "_deliveryRoutine() : %s",
+            (const char*)e.getMessage().getCString()));
+        }
+        catch(...)
+        {
+            PEG_TRACE_CSTRING(TRC_IND_HANDLER, Tracer::LEVEL4,
+                "Unexpected exception in IndicationHandlerService::"
+                    "_deliveryRoutine() : Unknown");
+        }
+
+        service->_rescheduleQueue(queue);
     }
-    service->_deliveryThreadsRunningCount--;
     PEG_METHOD_EXIT();
 
     return (ThreadReturnType)0;
@@ -1325,6 +1482,7 @@ void IndicationHandlerService:: _destinationQueuesCleanup()
     for(; i; i++)
     {
         queue = i.value();
+        _unscheduleQueue(queue);
         queue->shutdown();
         delete queue;
     }
@@ -204,13 +204,50 @@ private:
     DestinationQueueTable _destinationQueueTable;
     ReadWriteSem _destinationQueueTableLock;
 
+    /**
+        Puts the queue on the ready list if it is idle. Called after an
+        indication has been enqueued to the queue. Queues which are waiting
+        for a delivery retry or which are being delivered are rescheduled
+        when the retry is due or when the delivery has finished.
+    */
+    void _scheduleQueue(DestinationQueue *queue);
+
+    /**
+        Reschedules the queue after a delivery thread is done with it. The
+        queue goes to the back of the ready list if it has more indications
+        to deliver, to the retry timer wheel if the next indication is
+        waiting for the DeliveryRetryInterval to expire, or becomes idle.
+    */
+    void _rescheduleQueue(DestinationQueue *queue);
+
+    /**
+        Removes the queue from the scheduler before it is deleted. Waits
+        until the queue is not being delivered by a delivery thread.
+    */
+    void _unscheduleQueue(DestinationQueue *queue);
+
+    /**
+        Starts a delivery thread if there are queues on the ready list and
+        fewer than _maxDeliveryThreads delivery threads running. Caller must
+        hold _schedulerMutex.
+    */
+    void _startDeliveryThread();
+
     AtomicInt _deliveryThreadsRunningCount;
     AtomicInt _dispatcherThreadRunning;
-    List<IndicationInfo, Mutex> _deliveryQueue;
+
+    // Queues which have an indication eligible for delivery, served in
+    // round-robin order by the delivery threads. The ready list and the
+    // retry timer wheel are protected by _schedulerMutex.
+    List<DestinationQueue, NullLock> _readyQueues;
+    DeliveryTimerWheel _retryTimerWheel;
+    Mutex _schedulerMutex;
+
+    // Declared before _deliveryThreadPool, which is sized from it.
+    const Uint32 _maxDeliveryThreads;
     ThreadPool _deliveryThreadPool;
     Thread _dispatcherThread;
     AtomicInt _stopDispatcherThread;
-    const Uint32 _maxDeliveryThreads;
     Uint16 _maxDeliveryRetry;
     Boolean _needDestinationQueueCleanup; 
     Semaphore _dispatcherWaitSemaphore;
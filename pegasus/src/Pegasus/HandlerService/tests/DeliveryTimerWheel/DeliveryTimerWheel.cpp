@@ -0,0 +1,148 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/PegasusAssert.h>
+#include <Pegasus/HandlerService/DeliveryTimerWheel.h>
+
+PEGASUS_USING_PEGASUS;
+PEGASUS_USING_STD;
+
+static const Uint64 TICK = 250000;
+
+static Boolean _contains(
+    const Array<DeliveryTimerEntry*>& entries,
+    const DeliveryTimerEntry* entry)
+{
+    for (Uint32 i = 0, n = entries.size(); i < n; i++)
+    {
+        if (entries[i] == entry)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void testExpiration()
+{
+    Uint64 start = 1000 * TICK;
+    // The entries must outlive the wheel which links them.
+    DeliveryTimerEntry e1, e2, e3;
+    DeliveryTimerWheel wheel(8, TICK, start);
+    Array<DeliveryTimerEntry*> expired;
+
+    wheel.schedule(&e1, start + TICK);
+    wheel.schedule(&e2, start + 3 * TICK + 1);
+    // More than one revolution ahead.
+    wheel.schedule(&e3, start + 20 * TICK);
+    PEGASUS_TEST_ASSERT(wheel.size() == 3);
+
+    // Nothing is due yet.
+    wheel.advance(start + TICK - 1, expired);
+    PEGASUS_TEST_ASSERT(expired.size() == 0);
+
+    wheel.advance(start + TICK, expired);
+    PEGASUS_TEST_ASSERT(expired.size() == 1);
+    PEGASUS_TEST_ASSERT(expired[0] == &e1);
+    PEGASUS_TEST_ASSERT(e1.list == 0);
+
+    // Entries never expire before their expiration time.
+    expired.clear();
+    wheel.advance(start + 3 * TICK, expired);
+    PEGASUS_TEST_ASSERT(expired.size() == 0);
+    wheel.advance(start + 4 * TICK, expired);
+    PEGASUS_TEST_ASSERT(expired.size() == 1);
+    PEGASUS_TEST_ASSERT(expired[0] == &e2);
+
+    // e3 shares its slot with tick 12 but must stay for the next revolution.
+    expired.clear();
+    wheel.advance(start + 12 * TICK, expired);
+    PEGASUS_TEST_ASSERT(expired.size() == 0);
+    PEGASUS_TEST_ASSERT(wheel.size() == 1);
+
+    wheel.advance(start + 20 * TICK, expired);
+    PEGASUS_TEST_ASSERT(expired.size() == 1);
+    PEGASUS_TEST_ASSERT(expired[0] == &e3);
+    PEGASUS_TEST_ASSERT(wheel.size() == 0);
+}
+
+static void testPastAndCancel()
+{
+    Uint64 start = 1000 * TICK;
+    DeliveryTimerEntry e1, e2, e3;
+    DeliveryTimerWheel wheel(8, TICK, start);
+    Array<DeliveryTimerEntry*> expired;
+
+    // An entry which is already due expires on the next tick.
+    wheel.schedule(&e1, start - 5 * TICK);
+    wheel.schedule(&e2, start + 2 * TICK);
+    wheel.schedule(&e3, start + 2 * TICK);
+
+    wheel.cancel(&e2);
+    PEGASUS_TEST_ASSERT(wheel.size() == 2);
+    PEGASUS_TEST_ASSERT(e2.list == 0);
+
+    wheel.advance(start + TICK, expired);
+    PEGASUS_TEST_ASSERT(expired.size() == 1);
+    PEGASUS_TEST_ASSERT(expired[0] == &e1);
+
+    // A cancelled entry may be scheduled again.
+    wheel.schedule(&e2, start + 2 * TICK);
+
+    // Falling behind by several revolutions expires everything that is due.
+    expired.clear();
+    wheel.advance(start + 100 * TICK, expired);
+    PEGASUS_TEST_ASSERT(expired.size() == 2);
+    PEGASUS_TEST_ASSERT(_contains(expired, &e2));
+    PEGASUS_TEST_ASSERT(_contains(expired, &e3));
+    PEGASUS_TEST_ASSERT(wheel.size() == 0);
+
+    // The wheel does not delete entries still scheduled when destroyed.
+    wheel.schedule(&e1, start + 200 * TICK);
+}
+
+int main(int, char** argv)
+{
+    try
+    {
+        testExpiration();
+        testPastAndCancel();
+    }
+    catch(const Exception& e)
+    {
+        cerr << argv[0] << ": Exception " << e.getMessage() << endl;
+        return 1;
+    }
+
+    cout << argv[0] << " +++++ passed all tests" << endl;
+    return 0;
+}
@@ -340,6 +340,18 @@ const CIMName _PROPERTY_ENABLEDSTATE =
 */
 const CIMName _PROPERTY_HEALTHSTATE =
     CIMNameCast("HealthState");
+
+/**
+    The name of the CIM_Indication.SequenceContext property.
+*/
+const CIMName _PROPERTY_INDICATIONSEQUENCECONTEXT =
+    CIMNameCast("SequenceContext");
+
+/**
+    The name of the CIM_Indication.SequenceNumber property.
+*/
+const CIMName _PROPERTY_INDICATIONSEQUENCENUMBER =
+    CIMNameCast("SequenceNumber");
 #endif
 
 
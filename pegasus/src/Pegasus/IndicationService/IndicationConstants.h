@@ -378,6 +378,18 @@ PEGASUS_SERVER_LINKAGE extern const CIMName _PROPERTY_ENABLEDSTATE;
 */
 PEGASUS_SERVER_LINKAGE extern const CIMName _PROPERTY_HEALTHSTATE;
 
+/**
+    The name of the CIM_Indication.SequenceContext property.
+*/
+PEGASUS_SERVER_LINKAGE extern const CIMName
+    _PROPERTY_INDICATIONSEQUENCECONTEXT;
+
+/**
+    The name of the CIM_Indication.SequenceNumber property.
+*/
+PEGASUS_SERVER_LINKAGE extern const CIMName
+    _PROPERTY_INDICATIONSEQUENCENUMBER;
+
 #endif
 
 /**
@@ -3495,6 +3495,21 @@ void IndicationService::_handleProcessIndicationRequest(Message* message)
             subscriptions,
             subscriptionKeys);
 
+        //
+        // The formatted indications of subscriptions with the same filter
+        // query are identical, so they share one IndicationPayload and the
+        // handlers encode the indication only once for all of them.
+        // The properties set per destination by the handler service are
+        // excluded from the shared encoding.
+        //
+        Array<String> payloadKeys;
+        Array<OperationContext> payloadContexts;
+        Array<CIMName> perDestinationProperties;
+#ifdef PEGASUS_ENABLE_DMTF_INDICATION_PROFILE_SUPPORT
+        perDestinationProperties.append(_PROPERTY_INDICATIONSEQUENCECONTEXT);
+        perDestinationProperties.append(_PROPERTY_INDICATIONSEQUENCENUMBER);
+#endif
+
         for (Uint32 i = 0; i < subscriptions.size(); i++)
         {
             try
@@ -3580,11 +3595,45 @@ void IndicationService::_handleProcessIndicationRequest(Message* message)
                                 getString().getCString()),
                             (const char*)(request->messageId.getCString())));
 
+                        Uint32 payloadIndex = PEG_NOT_FOUND;
+                        if (subscriptions.size() > 1)
+                        {
+                            String payloadKey = queryLanguage;
+                            payloadKey.append(Char16('\n'));
+                            payloadKey.append(filterQuery);
+
+                            for (Uint32 j = 0; j < payloadKeys.size(); j++)
+                            {
+                                if (payloadKeys[j] == payloadKey)
+                                {
+                                    payloadIndex = j;
+                                    break;
+                                }
+                            }
+
+                            if (payloadIndex == PEG_NOT_FOUND)
+                            {
+                                OperationContext payloadContext(
+                                    request->operationContext);
+                                payloadContext.insert(
+                                    IndicationPayloadContainer(
+                                        SharedPtr<IndicationPayload>(
+                                            new IndicationPayload(
+                                                perDestinationProperties))));
+
+                                payloadIndex = payloadKeys.size();
+                                payloadKeys.append(payloadKey);
+                                payloadContexts.append(payloadContext);
+                            }
+                        }
+
                         _forwardIndToHandler(subscriptions[i],
                                              handlerInstance,
                                              formattedIndication,
                                              request->nameSpace,
-                                             request->operationContext,
+                                             payloadIndex == PEG_NOT_FOUND ?
+                                                 request->operationContext :
+                                                 payloadContexts[payloadIndex],
                                              deliveryStatusAggregator.get());
                         matchedSubscriptions.append(subscriptions[i]);
                         matchedSubscriptionsKeys.append(subscriptionKeys[i]);
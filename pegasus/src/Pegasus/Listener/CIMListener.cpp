@@ -431,6 +431,11 @@ public:
     Boolean addConsumer(CIMIndicationConsumer * consumer);
     Boolean removeConsumer(CIMIndicationConsumer * consumer);
 
+    void setIndicationDispatchPolicy(
+        Uint32 dispatchThreads,
+        Uint32 maxQueuedIndications,
+        Boolean orderedDelivery);
+
 private:
     Boolean waitForPendingRequests(Uint32 shutdownTimeout);
 
@@ -591,6 +596,15 @@ Boolean CIMListenerRep::removeConsumer(CIMIndicationConsumer * consumer)
     return _dispatcher->removeConsumer(consumer);
 }
 
+void CIMListenerRep::setIndicationDispatchPolicy(
+    Uint32 dispatchThreads,
+    Uint32 maxQueuedIndications,
+    Boolean orderedDelivery)
+{
+    _dispatcher->setDispatchPolicy(
+        dispatchThreads, maxQueuedIndications, orderedDelivery);
+}
+
 Boolean CIMListenerRep::waitForPendingRequests(Uint32 shutdownTimeout)
 {
     // Wait for 10 sec max
@@ -670,4 +684,13 @@ Boolean CIMListener::removeConsumer(CIMIndicationConsumer * consumer)
     return static_cast < CIMListenerRep * >(_rep)->removeConsumer(consumer);
 }
 
+void CIMListener::setIndicationDispatchPolicy(
+    Uint32 dispatchThreads,
+    Uint32 maxQueuedIndications,
+    Boolean orderedDelivery)
+{
+    static_cast < CIMListenerRep * >(_rep)->setIndicationDispatchPolicy(
+        dispatchThreads, maxQueuedIndications, orderedDelivery);
+}
+
 PEGASUS_NAMESPACE_END
@@ -124,6 +124,33 @@ public:
      */
     Boolean removeConsumer(CIMIndicationConsumer* consumer);
 
+#ifdef PEGASUS_USE_EXPERIMENTAL_INTERFACES
+
+    /**
+     * Sets how received indications are dispatched to the consumers.
+     * The listener acknowledges an indication as soon as it is queued for
+     * the consumers; a pool of dispatch threads then calls the consumers.
+     * By default 5 dispatch threads are used, up to 1000 indications are
+     * queued per consumer, and delivery is unordered.
+     *
+     * @param dispatchThreads the number of threads delivering indications
+     *        to the consumers.
+     * @param maxQueuedIndications the maximum number of indications
+     *        waiting to be delivered to a consumer, or 0 for no limit.
+     *        While the queue of any consumer is full, received indications
+     *        are rejected with CIM_ERR_FAILED so that the exporting CIMOM
+     *        retries them later.
+     * @param orderedDelivery if true, each consumer receives indications
+     *        one at a time in the order they were received; otherwise a
+     *        consumer may be called from several threads concurrently.
+     */
+    void setIndicationDispatchPolicy(
+        Uint32 dispatchThreads,
+        Uint32 maxQueuedIndications,
+        Boolean orderedDelivery);
+
+#endif /* PEGASUS_USE_EXPERIMENTAL_INTERFACES */
+
 private:
     /*
      * Copy constructor - not implemented
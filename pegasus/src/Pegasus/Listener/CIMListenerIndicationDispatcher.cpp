@@ -35,10 +35,13 @@
 #include <Pegasus/Common/Constants.h>
 #include <Pegasus/Common/OperationContext.h>
 #include <Pegasus/Common/CIMMessage.h>
+#include <Pegasus/Common/List.h>
+#include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/Condition.h>
 #include <Pegasus/Common/Thread.h>
+#include <Pegasus/Common/ThreadPool.h>
 #include <Pegasus/Common/Tracer.h>
 
-#include <Pegasus/Listener/List.h>
 #include <Pegasus/Consumer/CIMIndicationConsumer.h>
 #include <Pegasus/Common/ContentLanguageList.h>
 
@@ -47,43 +50,34 @@ PEGASUS_NAMESPACE_BEGIN
 ///////////////////////////////////////////////////////////////////////////////
 // CIMListenerIndicationDispatchEvent
 ///////////////////////////////////////////////////////////////////////////////
-class CIMListenerIndicationDispatchEvent
+class CIMListenerIndicationDispatchEvent : public Linkable
 {
 public:
-    CIMListenerIndicationDispatchEvent(CIMIndicationConsumer* consumer,
-                                           String url,
-                                           CIMInstance instance,
-                                           ContentLanguageList contentLangs);
+    CIMListenerIndicationDispatchEvent(String url,
+                                       CIMInstance instance,
+                                       ContentLanguageList contentLangs);
     ~CIMListenerIndicationDispatchEvent();
 
-    CIMIndicationConsumer* getConsumer() const;
-
     String getURL() const;
     CIMInstance getIndicationInstance() const;
-        ContentLanguageList getContentLanguages() const;
+    ContentLanguageList getContentLanguages() const;
 
 private:
-    CIMIndicationConsumer*  _consumer;
     String                  _url;
     CIMInstance             _instance;
     ContentLanguageList     _contentLangs;
 };
 
 CIMListenerIndicationDispatchEvent::CIMListenerIndicationDispatchEvent(
-    CIMIndicationConsumer* consumer,
     String url,
     CIMInstance instance,
     ContentLanguageList contentLangs)
-:_consumer(consumer),_url(url),_instance(instance), _contentLangs(contentLangs)
+:_url(url),_instance(instance), _contentLangs(contentLangs)
 {
 }
 CIMListenerIndicationDispatchEvent::~CIMListenerIndicationDispatchEvent()
 {
 }
-CIMIndicationConsumer* CIMListenerIndicationDispatchEvent::getConsumer() const
-{
-    return _consumer;
-}
 String CIMListenerIndicationDispatchEvent::getURL() const
 {
     return _url;
@@ -98,6 +92,32 @@ ContentLanguageList
     return _contentLangs;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// CIMListenerConsumerQueue
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    Holds the indications waiting to be delivered to one consumer.  All the
+    members are protected by the dispatcher mutex.
+*/
+class CIMListenerConsumerQueue : public Linkable
+{
+public:
+    CIMListenerConsumerQueue(CIMIndicationConsumer* consumer_)
+        : consumer(consumer_), activeDeliveries(0), ready(false)
+    {
+    }
+
+    CIMIndicationConsumer* consumer;
+    List<CIMListenerIndicationDispatchEvent, NullLock> events;
+
+    // Number of dispatch threads currently delivering to the consumer
+    Uint32 activeDeliveries;
+
+    // True if the queue is in the dispatcher ready list
+    Boolean ready;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // CIMListenerIndicationDispatcherRep
 ///////////////////////////////////////////////////////////////////////////////
@@ -110,6 +130,11 @@ public:
     Boolean addConsumer(CIMIndicationConsumer* consumer);
     Boolean removeConsumer(CIMIndicationConsumer* consumer);
 
+    void setDispatchPolicy(
+        Uint32 dispatchThreads,
+        Uint32 maxQueuedIndications,
+        Boolean orderedDelivery);
+
     CIMExportIndicationResponseMessage* handleIndicationRequest(
         CIMExportIndicationRequestMessage* request);
 
@@ -121,37 +146,171 @@ private:
                               CIMInstance instance,
                               ContentLanguageList contentLangs);
 
+    /**
+        Adds the queue to the ready list if it has indications which can be
+        delivered now.  Must be called with _mutex locked.
+    */
+    void _scheduleQueue(CIMListenerConsumerQueue* queue);
+
+    /**
+        Starts dispatch threads up to the configured number.  Must be called
+        with _mutex locked.
+    */
+    void _startDispatchThreads();
+
+    /**
+        Waits for a consumer queue with indications ready for delivery and
+        removes one indication from it.  Returns 0 if the dispatcher is
+        shutting down.
+    */
+    CIMListenerIndicationDispatchEvent* _getNextEvent(
+        CIMListenerConsumerQueue*& queue);
+
+    /**
+        Reschedules the queue after a dispatch thread has delivered an
+        indication from it.
+    */
+    void _deliveryComplete(CIMListenerConsumerQueue* queue);
+
     ThreadPool* _thread_pool;
-    PtrList*        _consumers;
+
+    Mutex _mutex;
+    Condition _eventsReady;
+    Array<CIMListenerConsumerQueue*> _consumerQueues;
+    List<CIMListenerConsumerQueue, NullLock> _readyQueues;
+
+    Uint32 _dispatchThreads;
+    Uint32 _maxQueuedIndications;
+    Boolean _orderedDelivery;
+
+    Uint32 _runningThreads;
+    Semaphore _threadExited;
+    Boolean _stopping;
 };
 
 static struct timeval deallocateWait = {15, 0};
 
+static const Uint32 _DEFAULT_DISPATCH_THREADS = 5;
+static const Uint32 _DEFAULT_MAX_QUEUED_INDICATIONS = 1000;
+
+// Interval at which removeConsumer() checks whether the deliveries to the
+// consumer have completed.
+static const Uint32 _REMOVE_CONSUMER_WAIT_MSEC = 50;
 
 CIMListenerIndicationDispatcherRep::CIMListenerIndicationDispatcherRep()
     : _thread_pool(new ThreadPool(0, "ListenerIndicationDispatcher", 0, 0,
-    deallocateWait)), _consumers(new PtrList())
+    deallocateWait)),
+    _dispatchThreads(_DEFAULT_DISPATCH_THREADS),
+    _maxQueuedIndications(_DEFAULT_MAX_QUEUED_INDICATIONS),
+    _orderedDelivery(false),
+    _runningThreads(0),
+    _threadExited(0),
+    _stopping(false)
 {
 
 }
 CIMListenerIndicationDispatcherRep::~CIMListenerIndicationDispatcherRep()
 {
+    Uint32 runningThreads;
+    {
+        AutoMutex mtx(_mutex);
+        _stopping = true;
+        runningThreads = _runningThreads;
+        for (Uint32 i = 0; i < runningThreads; i++)
+        {
+            _eventsReady.signal();
+        }
+    }
+
+    // Wait for the dispatch threads to finish their current delivery.
+    for (Uint32 i = 0; i < runningThreads; i++)
+    {
+        _threadExited.wait();
+    }
+
+    // The queues are owned by _consumerQueues, so they must not be deleted
+    // by the ready list.
+    while (_readyQueues.remove_front())
+    {
+    }
+
+    for (Uint32 i = 0; i < _consumerQueues.size(); i++)
+    {
+        delete _consumerQueues[i];
+    }
+
     delete _thread_pool;
-    delete _consumers;
 }
 
 Boolean CIMListenerIndicationDispatcherRep::addConsumer(
     CIMIndicationConsumer* consumer)
 {
-    _consumers->add(consumer);
+    AutoMutex mtx(_mutex);
+    _consumerQueues.append(new CIMListenerConsumerQueue(consumer));
     return true;
 }
 Boolean CIMListenerIndicationDispatcherRep::removeConsumer(
     CIMIndicationConsumer* consumer)
 {
-    _consumers->remove(consumer);
+    CIMListenerConsumerQueue* queue = 0;
+
+    {
+        AutoMutex mtx(_mutex);
+
+        for (Uint32 i = 0; i < _consumerQueues.size(); i++)
+        {
+            if (_consumerQueues[i]->consumer == consumer)
+            {
+                queue = _consumerQueues[i];
+                _consumerQueues.remove(i);
+                break;
+            }
+        }
+
+        if (!queue)
+        {
+            return true;
+        }
+
+        // Discard the indications not yet delivered to the consumer.
+        if (queue->ready)
+        {
+            _readyQueues.remove(queue);
+            queue->ready = false;
+        }
+        queue->events.clear();
+    }
+
+    // The caller may destroy the consumer once this method returns, so
+    // wait until the dispatch threads are no longer using it.
+    while (true)
+    {
+        {
+            AutoMutex mtx(_mutex);
+            if (queue->activeDeliveries == 0)
+            {
+                break;
+            }
+        }
+        Threads::sleep(_REMOVE_CONSUMER_WAIT_MSEC);
+    }
+
+    delete queue;
     return true;
 }
+
+void CIMListenerIndicationDispatcherRep::setDispatchPolicy(
+    Uint32 dispatchThreads,
+    Uint32 maxQueuedIndications,
+    Boolean orderedDelivery)
+{
+    AutoMutex mtx(_mutex);
+
+    _dispatchThreads = dispatchThreads ? dispatchThreads : 1;
+    _maxQueuedIndications = maxQueuedIndications;
+    _orderedDelivery = orderedDelivery;
+}
+
 CIMExportIndicationResponseMessage*
 CIMListenerIndicationDispatcherRep::handleIndicationRequest(
     CIMExportIndicationRequestMessage* request)
@@ -165,11 +324,20 @@ CIMListenerIndicationDispatcherRep::handleIndicationRequest(
         ((ContentLanguageListContainer)request->operationContext.
             get(ContentLanguageListContainer::NAME)).getLanguages();
 
-    deliverIndication(url,instance,contentLangs);
-
     // compose a response message
     CIMException cimException;
 
+    // The indication is only queued here, so the exporting CIMOM gets its
+    // response without waiting for the consumers.
+    try
+    {
+        deliverIndication(url,instance,contentLangs);
+    }
+    catch (CIMException& e)
+    {
+        cimException = e;
+    }
+
     CIMExportIndicationResponseMessage* response =
         dynamic_cast<CIMExportIndicationResponseMessage*>(
             request->buildResponse());
@@ -185,57 +353,168 @@ void CIMListenerIndicationDispatcherRep::deliverIndication(String url,
     CIMInstance instance,
     ContentLanguageList contentLangs)
 {
-    // go thru all consumers and broadcast the result;
-    // should be run in seperate thread
-        AutoPtr<Iterator> it( _consumers->iterator() );
+    AutoMutex mtx(_mutex);
+
+    // Reject the indication if any consumer queue is full, rather than
+    // delivering it to only some of the consumers.  The exporting CIMOM
+    // retries the delivery later.
+    if (_maxQueuedIndications)
+    {
+        for (Uint32 i = 0; i < _consumerQueues.size(); i++)
+        {
+            if (_consumerQueues[i]->events.size() >= _maxQueuedIndications)
+            {
+                PEG_TRACE((TRC_DISCARDED_DATA, Tracer::LEVEL1,
+                    "Indication %s rejected: the queue of a consumer "
+                        "holds %u indications.",
+                    (const char*)instance.getClassName().getString().
+                        getCString(),
+                    _maxQueuedIndications));
+
+                throw PEGASUS_CIM_EXCEPTION_L(CIM_ERR_FAILED,
+                    MessageLoaderParms(
+                        "Listener.CIMListenerIndicationDispatcher."
+                            "QUEUE_FULL",
+                        "The listener cannot accept more indications at "
+                            "this time."));
+            }
+        }
+    }
+
+    _startDispatchThreads();
 
-    while(it->hasNext()==true)
+    for (Uint32 i = 0; i < _consumerQueues.size(); i++)
+    {
+        CIMListenerConsumerQueue* queue = _consumerQueues[i];
+        queue->events.insert_back(
+            new CIMListenerIndicationDispatchEvent(
+                url,
+                instance,
+                contentLangs));
+        _scheduleQueue(queue);
+    }
+}
+
+void CIMListenerIndicationDispatcherRep::_scheduleQueue(
+    CIMListenerConsumerQueue* queue)
+{
+    if (queue->ready || queue->events.size() == 0)
+    {
+        return;
+    }
+
+    // With ordered delivery, only one thread at a time delivers to a
+    // consumer, so the consumer sees the indications in the order received.
+    if (_orderedDelivery && queue->activeDeliveries)
+    {
+        return;
+    }
+
+    queue->ready = true;
+    _readyQueues.insert_back(queue);
+    _eventsReady.signal();
+}
+
+void CIMListenerIndicationDispatcherRep::_startDispatchThreads()
+{
+    while (_runningThreads < _dispatchThreads && !_stopping)
     {
-        CIMIndicationConsumer* consumer =
-            static_cast<CIMIndicationConsumer*>(it->next());
-        CIMListenerIndicationDispatchEvent* event =
-            new CIMListenerIndicationDispatchEvent(consumer,
-                                                   url,
-                                                   instance,
-                                                   contentLangs);
         ThreadStatus rtn = _thread_pool->allocate_and_awaken(
-                                event,deliver_routine);
+            this, deliver_routine, &_threadExited);
 
-            if (rtn != PEGASUS_THREAD_OK)
+        if (rtn != PEGASUS_THREAD_OK)
+        {
+            PEG_TRACE((TRC_SERVER, Tracer::LEVEL1,
+                "Could not allocate dispatch thread, %u threads running.",
+                _runningThreads));
+
+            if (_runningThreads == 0)
             {
-                PEG_TRACE_CSTRING(
-                    TRC_SERVER,
-                    Tracer::LEVEL1,
-                    "Could not allocate thread to deliver event."
-                        " Instead using current thread.");
-            delete event;
-            throw Exception(MessageLoaderParms(
-                "Listener.CIMListenerIndicationDispatcher."
-                    "CANNOT_ALLOCATE_THREAD",
-                "Not enough threads to allocate a worker to deliver the"
-                    " event."));
+                throw PEGASUS_CIM_EXCEPTION_L(CIM_ERR_FAILED,
+                    MessageLoaderParms(
+                        "Listener.CIMListenerIndicationDispatcher."
+                            "CANNOT_ALLOCATE_THREAD",
+                        "Not enough threads to allocate a worker to deliver "
+                            "the event."));
             }
+            break;
+        }
+
+        _runningThreads++;
     }
 }
+
+CIMListenerIndicationDispatchEvent*
+CIMListenerIndicationDispatcherRep::_getNextEvent(
+    CIMListenerConsumerQueue*& queue)
+{
+    AutoMutex mtx(_mutex);
+
+    while (!_stopping && _readyQueues.size() == 0)
+    {
+        _eventsReady.wait(_mutex);
+    }
+
+    if (_stopping)
+    {
+        return 0;
+    }
+
+    queue = _readyQueues.remove_front();
+    queue->ready = false;
+    queue->activeDeliveries++;
+
+    CIMListenerIndicationDispatchEvent* event = queue->events.remove_front();
+
+    // With unordered delivery, other threads may deliver the remaining
+    // indications of the consumer in the meantime.
+    _scheduleQueue(queue);
+
+    return event;
+}
+
+void CIMListenerIndicationDispatcherRep::_deliveryComplete(
+    CIMListenerConsumerQueue* queue)
+{
+    AutoMutex mtx(_mutex);
+
+    queue->activeDeliveries--;
+    _scheduleQueue(queue);
+}
+
 ThreadReturnType PEGASUS_THREAD_CDECL
 CIMListenerIndicationDispatcherRep::deliver_routine(void *param)
 {
-    CIMListenerIndicationDispatchEvent* event =
-        static_cast<CIMListenerIndicationDispatchEvent*>(param);
+    CIMListenerIndicationDispatcherRep* rep =
+        static_cast<CIMListenerIndicationDispatcherRep*>(param);
 
-    if(event!=NULL)
+    CIMListenerConsumerQueue* queue;
+    CIMListenerIndicationDispatchEvent* event;
+
+    while ((event = rep->_getNextEvent(queue)) != 0)
     {
-        CIMIndicationConsumer* consumer = event->getConsumer();
-        OperationContext context;
-            context.insert(ContentLanguageListContainer(
-                        event->getContentLanguages()));
-        if(consumer)
+        try
         {
-            consumer->consumeIndication(context,
+            OperationContext context;
+            context.insert(ContentLanguageListContainer(
+                event->getContentLanguages()));
+            queue->consumer->consumeIndication(context,
                 event->getURL(),event->getIndicationInstance());
         }
+        catch (Exception& e)
+        {
+            PEG_TRACE((TRC_DISCARDED_DATA, Tracer::LEVEL1,
+                "Consumer failed to consume indication: %s",
+                (const char*)e.getMessage().getCString()));
+        }
+        catch (...)
+        {
+            PEG_TRACE_CSTRING(TRC_DISCARDED_DATA, Tracer::LEVEL1,
+                "Consumer failed to consume indication.");
+        }
 
         delete event;
+        rep->_deliveryComplete(queue);
     }
 
     return (0);
@@ -306,6 +585,14 @@ Boolean CIMListenerIndicationDispatcher::addConsumer(
     return static_cast<CIMListenerIndicationDispatcherRep*>(_rep)->addConsumer(
             consumer);
 }
+void CIMListenerIndicationDispatcher::setDispatchPolicy(
+    Uint32 dispatchThreads,
+    Uint32 maxQueuedIndications,
+    Boolean orderedDelivery)
+{
+    static_cast<CIMListenerIndicationDispatcherRep*>(_rep)->setDispatchPolicy(
+        dispatchThreads, maxQueuedIndications, orderedDelivery);
+}
 Boolean CIMListenerIndicationDispatcher::removeConsumer(
         CIMIndicationConsumer* consumer)
 {
@@ -63,6 +63,15 @@ public:
     Boolean addConsumer(CIMIndicationConsumer* consumer);
     Boolean removeConsumer(CIMIndicationConsumer* consumer);
 
+    /**
+        Sets how indications are dispatched to the consumers.  See
+        CIMListener::setIndicationDispatchPolicy().
+    */
+    void setDispatchPolicy(
+        Uint32 dispatchThreads,
+        Uint32 maxQueuedIndications,
+        Boolean orderedDelivery);
+
 private:
     void* _rep;
 };
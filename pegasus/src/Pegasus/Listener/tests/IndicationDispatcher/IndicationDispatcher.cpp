@@ -0,0 +1,339 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include <Pegasus/Common/PegasusAssert.h>
+#include <Pegasus/Common/CIMMessage.h>
+#include <Pegasus/Common/ContentLanguageList.h>
+#include <Pegasus/Common/OperationContextInternal.h>
+#include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/Semaphore.h>
+#include <Pegasus/Common/Threads.h>
+#include <Pegasus/Consumer/CIMIndicationConsumer.h>
+#include <Pegasus/Listener/CIMListenerIndicationDispatcher.h>
+
+PEGASUS_USING_PEGASUS;
+PEGASUS_USING_STD;
+
+static Boolean verbose;
+
+/* Records the sequence numbers of the indications it receives.  A blocked
+   consumer waits in consumeIndication() until it is unblocked. */
+class TestConsumer : public CIMIndicationConsumer
+{
+public:
+    TestConsumer(Boolean blocked = false)
+        : _blocked(blocked), _gate(0), _entered(0), _active(0),
+          _maxActive(0)
+    {
+    }
+
+    virtual void consumeIndication(
+        const OperationContext& context,
+        const String& url,
+        const CIMInstance& indicationInstance)
+    {
+        {
+            AutoMutex lock(_mutex);
+            if (++_active > _maxActive)
+            {
+                _maxActive = _active;
+            }
+        }
+
+        if (_blocked)
+        {
+            _entered.signal();
+            _gate.wait();
+        }
+
+        Uint32 sequence;
+        indicationInstance.getProperty(0).getValue().get(sequence);
+
+        AutoMutex lock(_mutex);
+        _received.append(sequence);
+        _active--;
+    }
+
+    void waitForDelivery()
+    {
+        _entered.wait();
+    }
+
+    void unblock()
+    {
+        AutoMutex lock(_mutex);
+        if (_blocked)
+        {
+            _blocked = false;
+            for (Uint32 i = 0; i < 10; i++)
+            {
+                _gate.signal();
+            }
+        }
+    }
+
+    Array<Uint32> waitForIndications(Uint32 count)
+    {
+        for (Uint32 i = 0; i < 1000; i++)
+        {
+            {
+                AutoMutex lock(_mutex);
+                if (_received.size() >= count)
+                {
+                    return _received;
+                }
+            }
+            Threads::sleep(10);
+        }
+        AutoMutex lock(_mutex);
+        return _received;
+    }
+
+    Uint32 getMaxActive()
+    {
+        AutoMutex lock(_mutex);
+        return _maxActive;
+    }
+
+private:
+    Mutex _mutex;
+    Boolean _blocked;
+    Semaphore _gate;
+    Semaphore _entered;
+    Uint32 _active;
+    Uint32 _maxActive;
+    Array<Uint32> _received;
+};
+
+/* Keeps the status of the last export response of the dispatcher. */
+class TestResponseQueue : public MessageQueue
+{
+public:
+    TestResponseQueue() : MessageQueue("TestResponseQueue") {}
+
+    virtual void enqueue(Message* message)
+    {
+        AutoPtr<CIMExportIndicationResponseMessage> response(
+            (CIMExportIndicationResponseMessage*) message);
+        lastStatus = response->cimException.getCode();
+    }
+
+    CIMStatusCode lastStatus;
+};
+
+static CIMStatusCode _exportIndication(
+    CIMListenerIndicationDispatcher& dispatcher,
+    TestResponseQueue& responseQueue,
+    Uint32 sequence)
+{
+    CIMInstance indication(CIMName("TST_Indication"));
+    indication.addProperty(CIMProperty(CIMName("Sequence"), sequence));
+
+    CIMExportIndicationRequestMessage* request =
+        new CIMExportIndicationRequestMessage(
+            "1",
+            "/test",
+            indication,
+            QueueIdStack(responseQueue.getQueueId()));
+    request->operationContext.set(
+        ContentLanguageListContainer(ContentLanguageList()));
+
+    dispatcher.enqueue(request);
+    return responseQueue.lastStatus;
+}
+
+/* With ordered delivery, each consumer gets the indications one at a time
+   in the order they were exported. */
+static void _testOrderedDelivery()
+{
+    CIMListenerIndicationDispatcher dispatcher;
+    TestResponseQueue responseQueue;
+    TestConsumer consumer1;
+    TestConsumer consumer2;
+
+    dispatcher.setDispatchPolicy(4, 0, true);
+    dispatcher.addConsumer(&consumer1);
+    dispatcher.addConsumer(&consumer2);
+
+    const Uint32 count = 200;
+    for (Uint32 i = 0; i < count; i++)
+    {
+        PEGASUS_TEST_ASSERT(
+            _exportIndication(dispatcher, responseQueue, i) ==
+                CIM_ERR_SUCCESS);
+    }
+
+    Array<Uint32> received1 = consumer1.waitForIndications(count);
+    Array<Uint32> received2 = consumer2.waitForIndications(count);
+    PEGASUS_TEST_ASSERT(received1.size() == count);
+    PEGASUS_TEST_ASSERT(received2.size() == count);
+    for (Uint32 i = 0; i < count; i++)
+    {
+        PEGASUS_TEST_ASSERT(received1[i] == i);
+        PEGASUS_TEST_ASSERT(received2[i] == i);
+    }
+    PEGASUS_TEST_ASSERT(consumer1.getMaxActive() == 1);
+    PEGASUS_TEST_ASSERT(consumer2.getMaxActive() == 1);
+
+    dispatcher.removeConsumer(&consumer1);
+    dispatcher.removeConsumer(&consumer2);
+}
+
+/* A consumer that does not return does not hold up the delivery to the
+   other consumers, and its queue keeps the indications for it. */
+static void _testConsumerQueues()
+{
+    CIMListenerIndicationDispatcher dispatcher;
+    TestResponseQueue responseQueue;
+    TestConsumer slowConsumer(true);
+    TestConsumer consumer;
+
+    dispatcher.setDispatchPolicy(2, 0, true);
+    dispatcher.addConsumer(&slowConsumer);
+    dispatcher.addConsumer(&consumer);
+
+    for (Uint32 i = 0; i < 10; i++)
+    {
+        PEGASUS_TEST_ASSERT(
+            _exportIndication(dispatcher, responseQueue, i) ==
+                CIM_ERR_SUCCESS);
+    }
+
+    PEGASUS_TEST_ASSERT(consumer.waitForIndications(10).size() == 10);
+    slowConsumer.waitForDelivery();
+    PEGASUS_TEST_ASSERT(slowConsumer.waitForIndications(0).size() == 0);
+
+    slowConsumer.unblock();
+    Array<Uint32> received = slowConsumer.waitForIndications(10);
+    PEGASUS_TEST_ASSERT(received.size() == 10);
+    for (Uint32 i = 0; i < received.size(); i++)
+    {
+        PEGASUS_TEST_ASSERT(received[i] == i);
+    }
+
+    dispatcher.removeConsumer(&slowConsumer);
+    dispatcher.removeConsumer(&consumer);
+}
+
+/* Indications are rejected while the queue of any consumer is full, and
+   are then delivered to none of the consumers. */
+static void _testQueueFull()
+{
+    CIMListenerIndicationDispatcher dispatcher;
+    TestResponseQueue responseQueue;
+    TestConsumer slowConsumer(true);
+    TestConsumer consumer;
+
+    const Uint32 maxQueued = 3;
+    dispatcher.setDispatchPolicy(2, maxQueued, true);
+    dispatcher.addConsumer(&slowConsumer);
+    dispatcher.addConsumer(&consumer);
+
+    // The first indication is being delivered to the slow consumer, so it
+    // is no longer queued.  The other consumer is served by the second
+    // dispatch thread.
+    PEGASUS_TEST_ASSERT(
+        _exportIndication(dispatcher, responseQueue, 0) == CIM_ERR_SUCCESS);
+    slowConsumer.waitForDelivery();
+    PEGASUS_TEST_ASSERT(consumer.waitForIndications(1).size() == 1);
+
+    for (Uint32 i = 1; i <= maxQueued; i++)
+    {
+        PEGASUS_TEST_ASSERT(
+            _exportIndication(dispatcher, responseQueue, i) ==
+                CIM_ERR_SUCCESS);
+        PEGASUS_TEST_ASSERT(consumer.waitForIndications(i + 1).size() == i + 1);
+    }
+    PEGASUS_TEST_ASSERT(
+        _exportIndication(dispatcher, responseQueue, 100) == CIM_ERR_FAILED);
+
+    slowConsumer.unblock();
+    PEGASUS_TEST_ASSERT(
+        slowConsumer.waitForIndications(maxQueued + 1).size() ==
+            maxQueued + 1);
+    PEGASUS_TEST_ASSERT(
+        consumer.waitForIndications(maxQueued + 1).size() == maxQueued + 1);
+
+    // The queues have room again.
+    PEGASUS_TEST_ASSERT(
+        _exportIndication(dispatcher, responseQueue, maxQueued + 1) ==
+            CIM_ERR_SUCCESS);
+
+    Array<Uint32> received = consumer.waitForIndications(maxQueued + 2);
+    PEGASUS_TEST_ASSERT(received.size() == maxQueued + 2);
+    for (Uint32 i = 0; i < received.size(); i++)
+    {
+        PEGASUS_TEST_ASSERT(received[i] == i);
+    }
+    received = slowConsumer.waitForIndications(maxQueued + 2);
+    PEGASUS_TEST_ASSERT(received.size() == maxQueued + 2);
+    for (Uint32 i = 0; i < received.size(); i++)
+    {
+        PEGASUS_TEST_ASSERT(received[i] == i);
+    }
+
+    dispatcher.removeConsumer(&slowConsumer);
+    dispatcher.removeConsumer(&consumer);
+}
+
+int main(int argc, char** argv)
+{
+    verbose = getenv("PEGASUS_TEST_VERBOSE") ? true : false;
+
+    try
+    {
+        if (verbose)
+        {
+            cout << "Testing ordered delivery." << endl;
+        }
+        _testOrderedDelivery();
+
+        if (verbose)
+        {
+            cout << "Testing per-consumer queues." << endl;
+        }
+        _testConsumerQueues();
+
+        if (verbose)
+        {
+            cout << "Testing full consumer queues." << endl;
+        }
+        _testQueueFull();
+    }
+    catch (Exception& e)
+    {
+        cerr << "Error: " << e.getMessage() << endl;
+        exit(1);
+    }
+
+    cout << argv[0] << " +++++ passed all tests" << endl;
+
+    return 0;
+}
@@ -34,6 +34,8 @@
 
 #include <Pegasus/Common/Tracer.h>
 #include <Pegasus/Common/SharedPtr.h>
+#include <Pegasus/Common/StatisticalData.h>
+#include <Pegasus/Common/System.h>
 #include <Pegasus/Provider/CIMOMHandle.h>
 #include <Pegasus/Config/ConfigManager.h>
 #include <Pegasus/Common/SCMOClassCache.h>
@@ -80,10 +82,16 @@ OperationResponseHandler::OperationResponseHandler(
     _responseChunkCallback(responseChunkCallback),
     _responseObjectTotal(0),
     _responseMessageTotal(0),
-    _responseObjectThreshold(0)
-{
+    _responseObjectThreshold(0),
+    _responseSizeThreshold(0),
+    _responseDelayThreshold(0),
+    _chunkStartTime(0)
+{
+    // Chunks are normally bounded by the responseChunkMaxSize and
+    // responseChunkMaxDelay configuration properties.  The object count
+    // threshold only caps the number of very small objects in a chunk.
 #ifndef PEGASUS_RESPONSE_OBJECT_COUNT_THRESHOLD
-# define PEGASUS_RESPONSE_OBJECT_COUNT_THRESHOLD 100
+# define PEGASUS_RESPONSE_OBJECT_COUNT_THRESHOLD 10000
 #elif PEGASUS_RESPONSE_OBJECT_COUNT_THRESHOLD  == 0
 # undef PEGASUS_RESPONSE_OBJECT_COUNT_THRESHOLD
 # define PEGASUS_RESPONSE_OBJECT_COUNT_THRESHOLD  ~0
@@ -92,10 +100,25 @@ OperationResponseHandler::OperationResponseHandler(
     if (!request)
     {
         _responseObjectThreshold = ~0;
+        _responseSizeThreshold = ~0;
     }
     else
     {
         _responseObjectThreshold = PEGASUS_RESPONSE_OBJECT_COUNT_THRESHOLD;
+        _responseSizeThreshold = ~0;
+
+        // The chunking properties are dynamic; they are read when the
+        // operation starts so that changes apply to subsequent operations.
+        if (responseChunkCallback)
+        {
+            ConfigManager* configManager = ConfigManager::getInstance();
+
+            _responseSizeThreshold = ConfigManager::parseUint32Value(
+                configManager->getCurrentValue("responseChunkMaxSize"));
+            _responseDelayThreshold = Uint64(1000) *
+                ConfigManager::parseUint32Value(
+                    configManager->getCurrentValue("responseChunkMaxDelay"));
+        }
 
 #ifdef PEGASUS_DEBUG
         static const char* responseObjectThreshold =
@@ -208,12 +231,67 @@ void OperationResponseHandler::send(Boolean isComplete)
     SimpleResponseHandler& simple = *simpleP;
     PEGASUS_ASSERT(_response);
     Uint32 objectCount = simple.size();
+    Uint32 chunkSize = simple.getEstimatedSize();
 
-    // have not reached threshold yet
-    if ((isComplete == false) && (objectCount < _responseObjectThreshold))
+    // have not reached a threshold yet. A chunk is sent once its estimated
+    // size or object count reaches the threshold, or once its first object
+    // has been held for the delay threshold.  The delay is checked as
+    // objects are delivered.
+    if (isComplete == false)
     {
-        return;
+        if (objectCount == 0)
+        {
+            return;
+        }
+
+        if ((chunkSize < _responseSizeThreshold) &&
+            (objectCount < _responseObjectThreshold))
+        {
+            if (_responseDelayThreshold == 0)
+            {
+                return;
+            }
+
+            Uint64 now = System::getCurrentTimeUsec();
+
+            if (_chunkStartTime == 0)
+            {
+                _chunkStartTime = now;
+                return;
+            }
+
+            if (now - _chunkStartTime < _responseDelayThreshold)
+            {
+                return;
+            }
+        }
+    }
+
+    _chunkStartTime = 0;
+
+#ifndef PEGASUS_DISABLE_PERFINST
+    if (objectCount != 0)
+    {
+        StatisticalData* sd = StatisticalData::current();
+
+        if (sd->copyGSD)
+        {
+            sd->addToValue(Sint64(objectCount), _request->getType(),
+                StatisticalData::PEGASUS_STATDATA_CHUNK_OBJECTS);
+            sd->addToValue(Sint64(chunkSize), _request->getType(),
+                StatisticalData::PEGASUS_STATDATA_CHUNK_SIZE);
+        }
     }
+#endif
+
+    PEG_TRACE((
+        TRC_PROVIDERMANAGER,
+        Tracer::LEVEL4,
+        "%s::send: %u objects, estimated size %u, complete %d",
+        (const char*) getClass().getCString(),
+        objectCount,
+        chunkSize,
+        int(isComplete)));
 
     CIMResponseMessage* response = _response;
 
@@ -302,6 +380,11 @@ Uint32 OperationResponseHandler::getResponseObjectThreshold() const
     return _responseObjectThreshold;
 }
 
+Uint32 OperationResponseHandler::getResponseSizeThreshold() const
+{
+    return _responseSizeThreshold;
+}
+
 //
 // GetInstanceResponseHandler
 //
@@ -107,6 +107,8 @@ protected:
 
     Uint32 getResponseObjectThreshold() const;
 
+    Uint32 getResponseSizeThreshold() const;
+
     CIMRequestMessage* _request;
     CIMResponseMessage* _response;
     PEGASUS_RESPONSE_CHUNK_CALLBACK_T _responseChunkCallback;
@@ -116,6 +118,16 @@ private:
     Uint32 _responseMessageTotal;
     Uint32 _responseObjectThreshold;
 
+    // estimated size in bytes at which a chunk is sent
+    Uint32 _responseSizeThreshold;
+
+    // time in microseconds that the first object of a chunk may be held
+    // before the chunk is sent, or zero if objects may be held indefinitely
+    Uint64 _responseDelayThreshold;
+
+    // time the first object of the current chunk was delivered, or zero if
+    // the current chunk is empty
+    Uint64 _chunkStartTime;
 };
 
 class PEGASUS_PPM_LINKAGE GetInstanceResponseHandler :
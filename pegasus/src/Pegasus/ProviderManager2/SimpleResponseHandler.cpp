@@ -37,6 +37,162 @@
 
 PEGASUS_NAMESPACE_BEGIN
 
+//
+// Estimates of the encoded size of the objects delivered to a handler, used
+// to size response chunks.  Names and string values, which dominate the
+// size of a response, are counted; every other element is counted as a
+// fixed amount.  No particular encoding is matched.
+//
+
+static const Uint32 _ELEMENT_SIZE_ESTIMATE = 32;
+
+static Uint32 _estimateObjectSize(const CIMConstObject& object);
+
+static Uint32 _estimatePathSize(const CIMObjectPath& path)
+{
+    Uint32 size = _ELEMENT_SIZE_ESTIMATE +
+        path.getHost().size() +
+        path.getNameSpace().getString().size() +
+        path.getClassName().getString().size();
+
+    const Array<CIMKeyBinding>& keyBindings = path.getKeyBindings();
+
+    for (Uint32 i = 0, n = keyBindings.size(); i < n; i++)
+    {
+        size += _ELEMENT_SIZE_ESTIMATE +
+            keyBindings[i].getName().getString().size() +
+            keyBindings[i].getValue().size();
+    }
+
+    return size;
+}
+
+static Uint32 _estimateValueSize(const CIMValue& value)
+{
+    if (value.isNull())
+    {
+        return 0;
+    }
+
+    Uint32 size = 0;
+
+    switch (value.getType())
+    {
+        case CIMTYPE_STRING:
+        {
+            if (value.isArray())
+            {
+                Array<String> a;
+                value.get(a);
+                for (Uint32 i = 0, n = a.size(); i < n; i++)
+                {
+                    size += _ELEMENT_SIZE_ESTIMATE + a[i].size();
+                }
+            }
+            else
+            {
+                String x;
+                value.get(x);
+                size = x.size();
+            }
+            break;
+        }
+        case CIMTYPE_REFERENCE:
+        {
+            if (value.isArray())
+            {
+                Array<CIMObjectPath> a;
+                value.get(a);
+                for (Uint32 i = 0, n = a.size(); i < n; i++)
+                {
+                    size += _estimatePathSize(a[i]);
+                }
+            }
+            else
+            {
+                CIMObjectPath x;
+                value.get(x);
+                size = _estimatePathSize(x);
+            }
+            break;
+        }
+        case CIMTYPE_OBJECT:
+        {
+            if (value.isArray())
+            {
+                Array<CIMObject> a;
+                value.get(a);
+                for (Uint32 i = 0, n = a.size(); i < n; i++)
+                {
+                    size += _estimateObjectSize(a[i]);
+                }
+            }
+            else
+            {
+                CIMObject x;
+                value.get(x);
+                size = _estimateObjectSize(x);
+            }
+            break;
+        }
+        case CIMTYPE_INSTANCE:
+        {
+            if (value.isArray())
+            {
+                Array<CIMInstance> a;
+                value.get(a);
+                for (Uint32 i = 0, n = a.size(); i < n; i++)
+                {
+                    size += _estimateObjectSize(a[i]);
+                }
+            }
+            else
+            {
+                CIMInstance x;
+                value.get(x);
+                size = _estimateObjectSize(x);
+            }
+            break;
+        }
+        default:
+        {
+            size = value.isArray() ?
+                value.getArraySize() * _ELEMENT_SIZE_ESTIMATE :
+                _ELEMENT_SIZE_ESTIMATE;
+            break;
+        }
+    }
+
+    return size;
+}
+
+static Uint32 _estimateObjectSize(const CIMConstObject& object)
+{
+    if (object.isUninitialized())
+    {
+        return 0;
+    }
+
+    Uint32 size = _ELEMENT_SIZE_ESTIMATE +
+        object.getClassName().getString().size() +
+        _estimatePathSize(object.getPath());
+
+    for (Uint32 i = 0, n = object.getPropertyCount(); i < n; i++)
+    {
+        CIMConstProperty property = object.getProperty(i);
+        size += _ELEMENT_SIZE_ESTIMATE +
+            property.getName().getString().size() +
+            _estimateValueSize(property.getValue());
+    }
+
+    return size;
+}
+
+static inline Uint32 _estimateSCMOSize(const SCMOInstance& object)
+{
+    return Uint32(object.getUsedMemorySize());
+}
+
 //
 // SimpleResponseHandler
 //
@@ -79,6 +235,11 @@ void SimpleResponseHandler::clear()
 {
 }
 
+Uint32 SimpleResponseHandler::getEstimatedSize() const
+{
+    return 0;
+}
+
 ContentLanguageList SimpleResponseHandler::getLanguages()
 {
     PEG_TRACE_CSTRING(
@@ -123,6 +284,7 @@ void SimpleResponseHandler::send(Boolean isComplete)
 //
 
 SimpleInstanceResponseHandler::SimpleInstanceResponseHandler()
+    : _estimatedSize(0)
 {
 }
 
@@ -149,6 +311,12 @@ void SimpleInstanceResponseHandler::clear()
 {
     _objects.clear();
     _scmoObjects.clear();
+    _estimatedSize = 0;
+}
+
+Uint32 SimpleInstanceResponseHandler::getEstimatedSize() const
+{
+    return _estimatedSize;
 }
 
 void SimpleInstanceResponseHandler::deliver(const CIMInstance& instance)
@@ -159,6 +327,7 @@ void SimpleInstanceResponseHandler::deliver(const CIMInstance& instance)
         "SimpleInstanceResponseHandler::deliver()");
 
     _objects.append(instance);
+    _estimatedSize += _estimateObjectSize(instance);
 
     send(false);
 }
@@ -172,6 +341,7 @@ void SimpleInstanceResponseHandler::deliver(const SCMOInstance& instance)
 
     //fprintf(stderr, "SimpleInstanceResponseHandler::deliver\n");
     _scmoObjects.append(instance);
+    _estimatedSize += _estimateSCMOSize(instance);
 
     send(false);
 }
@@ -200,6 +370,7 @@ const Array<SCMOInstance> SimpleInstanceResponseHandler::getSCMOObjects() const
 //
 
 SimpleObjectPathResponseHandler::SimpleObjectPathResponseHandler()
+    : _estimatedSize(0)
 {
 }
 
@@ -226,6 +397,12 @@ void SimpleObjectPathResponseHandler::clear()
 {
     _objects.clear();
     _scmoObjects.clear();
+    _estimatedSize = 0;
+}
+
+Uint32 SimpleObjectPathResponseHandler::getEstimatedSize() const
+{
+    return _estimatedSize;
 }
 
 void SimpleObjectPathResponseHandler::deliver(const CIMObjectPath& objectPath)
@@ -236,6 +413,7 @@ void SimpleObjectPathResponseHandler::deliver(const CIMObjectPath& objectPath)
         "SimpleObjectPathResponseHandler::deliver()");
 
     _objects.append(objectPath);
+    _estimatedSize += _estimatePathSize(objectPath);
 
     send(false);
 }
@@ -248,6 +426,7 @@ void SimpleObjectPathResponseHandler::deliver(const SCMOInstance& objectPath)
         "SimpleObjectPathResponseHandler::deliver()");
 
     _scmoObjects.append(objectPath);
+    _estimatedSize += _estimateSCMOSize(objectPath);
 
     send(false);
 }
@@ -429,6 +608,7 @@ const Array<CIMIndication> SimpleIndicationResponseHandler::getObjects() const
 //
 
 SimpleObjectResponseHandler::SimpleObjectResponseHandler()
+    : _estimatedSize(0)
 {
 }
 
@@ -451,6 +631,12 @@ void SimpleObjectResponseHandler::clear()
 {
     _objects.clear();
     _scmoObjects.clear();
+    _estimatedSize = 0;
+}
+
+Uint32 SimpleObjectResponseHandler::getEstimatedSize() const
+{
+    return _estimatedSize;
 }
 
 void SimpleObjectResponseHandler::deliver(const CIMObject& object)
@@ -461,6 +647,7 @@ void SimpleObjectResponseHandler::deliver(const CIMObject& object)
         "SimpleObjectResponseHandler::deliver()");
 
     _objects.append(object);
+    _estimatedSize += _estimateObjectSize(object);
 
     send(false);
 }
@@ -473,6 +660,7 @@ void SimpleObjectResponseHandler::deliver(const CIMInstance& instance)
         "SimpleObjectResponseHandler::deliver()");
 
     _objects.append(instance);
+    _estimatedSize += _estimateObjectSize(instance);
 
     send(false);
 }
@@ -485,6 +673,7 @@ void SimpleObjectResponseHandler::deliver(const SCMOInstance& object)
         "SimpleObjectResponseHandler::deliver()");
 
     _scmoObjects.append(object);
+    _estimatedSize += _estimateSCMOSize(object);
     send(false);
 }
 
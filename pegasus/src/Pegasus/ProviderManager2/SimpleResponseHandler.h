@@ -72,6 +72,10 @@ public:
     // clear any objects in this handler
     virtual void clear();
 
+    // return the estimated encoded size in bytes of the objects in this
+    // handler, or zero if the handler does not estimate object sizes
+    virtual Uint32 getEstimatedSize() const;
+
     ContentLanguageList getLanguages();
 
 protected:
@@ -94,6 +98,8 @@ public:
 
     virtual void clear();
 
+    virtual Uint32 getEstimatedSize() const;
+
     virtual void deliver(const CIMInstance& instance);
 
     virtual void deliver(const SCMOInstance& instance);
@@ -106,6 +112,7 @@ public:
 private:
     Array<CIMInstance> _objects;
     Array<SCMOInstance> _scmoObjects;
+    Uint32 _estimatedSize;
     //CIMInstanceResponseData responseData;
 };
 
@@ -124,6 +131,8 @@ public:
 
     virtual void clear();
 
+    virtual Uint32 getEstimatedSize() const;
+
     virtual void deliver(const CIMObjectPath& objectPath);
 
     virtual void deliver(const SCMOInstance& objectPath);
@@ -136,6 +145,7 @@ public:
 private:
     Array<CIMObjectPath> _objects;
     Array<SCMOInstance> _scmoObjects;
+    Uint32 _estimatedSize;
     //CIMInstanceNamesResponseData responseData;
 };
 
@@ -221,6 +231,8 @@ public:
 
     virtual void clear();
 
+    virtual Uint32 getEstimatedSize() const;
+
     virtual void deliver(const CIMObject& object);
 
     virtual void deliver(const SCMOInstance& object);
@@ -235,6 +247,7 @@ public:
 private:
     Array<CIMObject> _objects;
     Array<SCMOInstance> _scmoObjects;
+    Uint32 _estimatedSize;
 };
 
 class PEGASUS_PPM_LINKAGE SimpleInstance2ObjectResponseHandler :
@@ -30,6 +30,8 @@
 //%/////////////////////////////////////////////////////////////////////////////
 
 #include <Pegasus/ProviderManager2/OperationResponseHandler.h>
+#include <Pegasus/Config/ConfigManager.h>
+#include <Pegasus/Common/Threads.h>
 
 PEGASUS_USING_PEGASUS;
 PEGASUS_USING_STD;
@@ -40,6 +42,23 @@ void dummyCallback(CIMRequestMessage* request, CIMResponseMessage* response)
 {
 }
 
+static Uint32 chunkCount;
+static Uint32 chunkObjectCount;
+
+void countingCallback(CIMRequestMessage* request, CIMResponseMessage* response)
+{
+    CIMEnumerateInstanceNamesResponseMessage* msg =
+        dynamic_cast<CIMEnumerateInstanceNamesResponseMessage*>(response);
+    PEGASUS_TEST_ASSERT(msg != 0);
+    PEGASUS_TEST_ASSERT(!msg->isComplete());
+
+    chunkCount++;
+    chunkObjectCount += msg->getResponseData().size();
+
+    // chunks are deleted once they have been sent
+    delete response;
+}
+
 // test null object checks
 void Test1()
 {
@@ -341,6 +360,87 @@ void Test2(void)
     }
 }
 
+static Uint32 deliverObjectPaths(Uint32 count, Uint32 sleepMilliseconds)
+{
+    chunkCount = 0;
+    chunkObjectCount = 0;
+
+    CIMEnumerateInstanceNamesRequestMessage request(
+        String::EMPTY,
+        CIMNamespaceName("test/TestProvider"),
+        CIMName("TST_Chunk"),
+        QueueIdStack(1));
+
+    CIMEnumerateInstanceNamesResponseMessage response(
+        String::EMPTY,
+        CIMException(),
+        QueueIdStack());
+
+    EnumerateInstanceNamesResponseHandler handler(
+        &request, &response, countingCallback);
+
+    handler.processing();
+
+    for (Uint32 i = 0; i < count; i++)
+    {
+        char key[32];
+        sprintf(key, "key%u", i);
+
+        Array<CIMKeyBinding> keyBindings;
+        keyBindings.append(
+            CIMKeyBinding("Name", String(key), CIMKeyBinding::STRING));
+
+        handler.deliver(CIMObjectPath(
+            String::EMPTY, CIMNamespaceName(), "TST_Chunk", keyBindings));
+
+        if (sleepMilliseconds)
+        {
+            Threads::sleep(sleepMilliseconds);
+        }
+    }
+
+    handler.complete();
+
+    Uint32 lastChunkObjectCount = response.getResponseData().size();
+
+    if (verbose)
+    {
+        cout << count << " objects in " << chunkCount + 1 << " chunks" <<
+            endl;
+    }
+
+    PEGASUS_TEST_ASSERT(chunkObjectCount + lastChunkObjectCount == count);
+
+    return chunkCount;
+}
+
+// test chunking by size and by delay
+void Test3()
+{
+    if (verbose)
+    {
+        cout << "Test3()" << endl;
+    }
+
+    ConfigManager* configManager = ConfigManager::getInstance();
+
+    // no chunks below the size threshold without a delay threshold
+    configManager->initCurrentValue("responseChunkMaxSize", "1000000");
+    configManager->initCurrentValue("responseChunkMaxDelay", "0");
+    PEGASUS_TEST_ASSERT(deliverObjectPaths(100, 0) == 0);
+
+    // chunks by size, a small path is estimated at 50 to 200 bytes
+    configManager->initCurrentValue("responseChunkMaxSize", "1000");
+    Uint32 chunks = deliverObjectPaths(100, 0);
+    PEGASUS_TEST_ASSERT(chunks >= 5 && chunks <= 20);
+
+    // every object held for the delay threshold is sent in a chunk with
+    // the object that follows it
+    configManager->initCurrentValue("responseChunkMaxSize", "1000000");
+    configManager->initCurrentValue("responseChunkMaxDelay", "1");
+    PEGASUS_TEST_ASSERT(deliverObjectPaths(6, 5) == 3);
+}
+
 int main(int, char** argv)
 {
     verbose = getenv("PEGASUS_TEST_VERBOSE") ? true : false;
@@ -349,6 +449,7 @@ int main(int, char** argv)
     {
         Test1();
         Test2();
+        Test3();
     }
     catch (CIMException & e)
     {
@@ -77,6 +77,36 @@ static HashTable <String, Uint32, EqualFunc <String>,
 
 static Mutex _failedProviderModuleTableMutex;
 
+#ifndef PEGASUS_DISABLE_PERFINST
+//
+// Adds the provider time of a completed provider operation to the
+// distribution kept for the provider module that processed it.
+//
+static void _recordProviderModuleStatistics(
+    CIMRequestMessage* request,
+    CIMResponseMessage* response)
+{
+    StatisticalData* sd = StatisticalData::current();
+    if (!sd->copyGSD ||
+        !request->operationContext.contains(ProviderIdContainer::NAME))
+    {
+        return;
+    }
+
+    ProviderIdContainer pidc =
+        request->operationContext.get(ProviderIdContainer::NAME);
+    const CIMInstance& providerModule = pidc.getModule();
+    Uint32 pos = providerModule.findProperty(PEGASUS_PROPERTYNAME_NAME);
+    if (pos != PEG_NOT_FOUND)
+    {
+        String moduleName;
+        providerModule.getProperty(pos).getValue().get(moduleName);
+        sd->addProviderModuleValue(
+            moduleName, Sint64(response->getProviderTime()));
+    }
+}
+#endif
+
 //
 // This method is called when the provider module is failed and
 // maxFailedProviderModuleRestarts config value is specified.
@@ -512,6 +542,10 @@ void ProviderManagerService::handleCimRequest(
 
     if(!cimResponse->isAsyncResponsePending)
     {
+#ifndef PEGASUS_DISABLE_PERFINST
+        _recordProviderModuleStatistics(request, cimResponse);
+#endif
+
         // constructor of object is putting itself into a linked list
         // DO NOT remove the new operator
         new AsyncLegacyOperationResult(
@@ -665,6 +699,10 @@ void ProviderManagerService::asyncResponseCallback(
         response->cimException = CIMException(CIM_ERR_FAILED, String());
     }
 
+#ifndef PEGASUS_DISABLE_PERFINST
+    _recordProviderModuleStatistics(request, response);
+#endif
+
     // constructor of object is putting itself into a linked list
     // DO NOT remove the new operator
     new AsyncLegacyOperationResult(op, response);
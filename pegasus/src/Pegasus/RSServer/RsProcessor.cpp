@@ -903,6 +903,7 @@ void RsProcessor::handleRequest(RsHTTPRequest* request)
             MessageQueue* queue = MessageQueue::lookup(request->queueId);
             response->setStatus(STRLIT_ARGS(HTTP_STATUS_OK));
             httpMessage.reset(response->getHTTPMessage());
+            httpMessage->dest = request->queueId;
             queue->enqueue(httpMessage.release());
         }
         else
@@ -1193,9 +1194,10 @@ void RsProcessor::handleRequest(RsHTTPRequest* request)
         writer->append(e, request->method, uri);
 
         MessageQueue* queue = MessageQueue::lookup(request->queueId);
-        _requestTable.remove(queue->getQueueId());
+        _requestTable.remove(request->queueId);
 
         AutoPtr<HTTPMessage> httpMessage(request->response->getHTTPMessage());
+        httpMessage->dest = request->queueId;
         queue->enqueue(httpMessage.release());
     }
     catch (Exception& e)
@@ -1212,9 +1214,10 @@ void RsProcessor::handleRequest(RsHTTPRequest* request)
         writer->append(e, request->method, uri);
 
         MessageQueue* queue = MessageQueue::lookup(request->queueId);
-        _requestTable.remove(queue->getQueueId());
+        _requestTable.remove(request->queueId);
 
         AutoPtr<HTTPMessage> httpMessage(request->response->getHTTPMessage());
+        httpMessage->dest = request->queueId;
         queue->enqueue(httpMessage.release());
     }
     catch (PEGASUS_STD(exception)& e)
@@ -1321,6 +1324,7 @@ void RsProcessor::handleResponse(CIMResponseMessage* cimResponse)
             httpMessage->setComplete(complete);
             //httpMessage->setIndex(cimResponse->getIndex());
             httpMessage->setIndex(0);
+            httpMessage->dest = queueId;
             PEGASUS_FCT_EXECUTE_AND_ASSERT(true, _requestTable.remove(queueId));
 
             delete request;
@@ -1355,9 +1359,10 @@ void RsProcessor::handleResponse(CIMResponseMessage* cimResponse)
         writer->append(e, request->method, request->getURI());
 
         MessageQueue* queue = MessageQueue::lookup(request->queueId);
-        _requestTable.remove(queue->getQueueId());
+        _requestTable.remove(request->queueId);
 
         AutoPtr<HTTPMessage> httpMessage(request->response->getHTTPMessage());
+        httpMessage->dest = request->queueId;
         queue->enqueue(httpMessage.release());
     }
     catch (Exception& e)
@@ -1374,9 +1379,10 @@ void RsProcessor::handleResponse(CIMResponseMessage* cimResponse)
         writer->append(e, request->method, request->getURI());
 
         MessageQueue* queue = MessageQueue::lookup(request->queueId);
-        _requestTable.remove(queue->getQueueId());
+        _requestTable.remove(request->queueId);
 
         AutoPtr<HTTPMessage> httpMessage(request->response->getHTTPMessage());
+        httpMessage->dest = request->queueId;
         queue->enqueue(httpMessage.release());
     }
     catch (PEGASUS_STD(exception)& e)
@@ -0,0 +1,168 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#include <Pegasus/Common/Config.h>
+#include "AssocInstCache.h"
+
+PEGASUS_USING_STD;
+
+PEGASUS_NAMESPACE_BEGIN
+
+AssocInstCacheManager::AssocInstCacheManager()
+{
+}
+
+AssocInstCacheManager::~AssocInstCacheManager()
+{
+    for (Uint32 i = _assocInstCacheList.size(); i > 0; i--)
+    {
+        delete _assocInstCacheList[i-1];
+        _assocInstCacheList.remove(i-1);
+    }
+}
+
+/**
+    Retrieves a singleton instance of the instance association cache for the
+    given association table path.
+*/
+AssocInstCache* AssocInstCacheManager::getAssocInstCache(const String& path)
+{
+    for (Uint32 i = 0; i < _assocInstCacheList.size(); i++)
+    {
+        if (path == _assocInstCacheList[i]->getPath())
+        {
+            return _assocInstCacheList[i];
+        }
+    }
+
+    // If we got here, no cache exists for the given table so far,
+    // so we will create a new one.
+    AssocInstCache* newCache = new AssocInstCache(path);
+    _assocInstCacheList.append(newCache);
+
+    return newCache;
+}
+
+
+Boolean AssocInstCache::getAssocInstEntry(
+    const CIMObjectPath& fromInstanceName,
+    Array<InstanceAssociation>& entryList)
+{
+    return _assocTable.lookup(fromInstanceName, entryList);
+}
+
+/** Add a new record to the association cache.
+    If an entry for the from instance name of the record already exists,
+    the record is appended to it. Otherwise a new entry is added.
+*/
+void AssocInstCache::addRecord(const InstanceAssociation& assocInstRecord)
+{
+    CIMObjectPath fromInstanceName = assocInstRecord.fromInstanceName;
+    Array<InstanceAssociation>* entryList;
+
+    if (_assocTable.lookupReference(fromInstanceName, entryList))
+    {
+        entryList->append(assocInstRecord);
+    }
+    else
+    {
+        _assocTable.insert(
+            fromInstanceName,
+            Array<InstanceAssociation>(&assocInstRecord, 1));
+    }
+}
+
+/** Remove the record of an association instance from the entry of its
+    from instance name.  The entry is removed when it becomes empty.
+*/
+Boolean AssocInstCache::removeRecord(
+    const InstanceAssociation& assocInstRecord)
+{
+    CIMObjectPath fromInstanceName = assocInstRecord.fromInstanceName;
+    Array<InstanceAssociation>* entryList;
+
+    if (_assocTable.lookupReference(fromInstanceName, entryList))
+    {
+        for (Uint32 i = 0; i < entryList->size(); i++)
+        {
+            const InstanceAssociation& entry = (*entryList)[i];
+
+            if (entry.assocInstanceName == assocInstRecord.assocInstanceName &&
+                entry.fromPropertyName == assocInstRecord.fromPropertyName &&
+                entry.toPropertyName == assocInstRecord.toPropertyName)
+            {
+                if (entryList->size() == 1)
+                {
+                    _assocTable.remove(fromInstanceName);
+                }
+                else
+                {
+                    entryList->remove(i);
+                }
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void AssocInstCache::clear()
+{
+    _assocTable.clear();
+    _isInitialized = false;
+}
+
+/** Check if the cache is loaded with objects already.
+*/
+Boolean AssocInstCache::isActive()
+{
+    return _isInitialized;
+}
+
+void AssocInstCache::setActive(Boolean flag)
+{
+    _isInitialized = flag;
+}
+
+
+AssocInstCache::~AssocInstCache()
+{
+}
+
+AssocInstCache::AssocInstCache(const String& path)
+    : _path(path),
+      _isInitialized(false),
+      _assocTable(1000)
+{
+}
+
+PEGASUS_NAMESPACE_END
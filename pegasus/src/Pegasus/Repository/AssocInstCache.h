@@ -0,0 +1,120 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#ifndef Pegasus_AssocInstCache_h
+#define Pegasus_AssocInstCache_h
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/String.h>
+#include <Pegasus/Common/CIMObjectPath.h>
+#include <Pegasus/Common/ArrayInternal.h>
+#include <Pegasus/Common/HashTable.h>
+#include <Pegasus/Repository/PersistentStoreData.h>
+#include <Pegasus/Repository/Linkage.h>
+
+PEGASUS_NAMESPACE_BEGIN
+
+class AssocInstCache;
+
+/** Maintains instance association caches for all association tables.
+*/
+class PEGASUS_REPOSITORY_LINKAGE AssocInstCacheManager
+{
+public:
+
+    AssocInstCacheManager();
+    ~AssocInstCacheManager();
+
+    /** Retrieves the instance association cache for the given association
+        table path.
+    */
+    AssocInstCache* getAssocInstCache(const String& path);
+
+private:
+
+    Array<AssocInstCache*> _assocInstCacheList;
+};
+
+/** Maintains an index of the instance associations of an association table.
+    The entries are indexed by their from instance name, so the associators
+    and references of an instance are found without reading the whole table.
+*/
+class PEGASUS_REPOSITORY_LINKAGE AssocInstCache
+{
+public:
+
+    AssocInstCache(const String& path);
+    ~AssocInstCache();
+
+    const String& getPath()
+    {
+        return _path;
+    }
+
+    /** Retrieves the entries having the given from instance name.
+    */
+    Boolean getAssocInstEntry(
+        const CIMObjectPath& fromInstanceName,
+        Array<InstanceAssociation>& entryList);
+
+    /** Adds a new entry to the association cache.
+    */
+    void addRecord(const InstanceAssociation& assocInstRecord);
+
+    /** Removes the entry matching the given one in its association instance
+        name and property names.
+    */
+    Boolean removeRecord(const InstanceAssociation& assocInstRecord);
+
+    /** Removes all entries and marks the cache inactive, so that it is
+        loaded again from the association table.
+    */
+    void clear();
+
+    /** Check if the cache is loaded with objects already.
+    */
+    Boolean isActive();
+    void setActive(Boolean flag);
+
+private:
+    String _path;
+    Boolean _isInitialized;
+
+    typedef HashTable<CIMObjectPath, Array<InstanceAssociation>,
+        EqualFunc<CIMObjectPath>, HashFunc<CIMObjectPath> >
+            AssocInstCacheHashTableType;
+
+    AssocInstCacheHashTableType _assocTable;
+};
+
+PEGASUS_NAMESPACE_END
+
+#endif /* Pegasus_AssocInstCache_h */
@@ -34,6 +34,7 @@
 #include <Pegasus/Common/InternalException.h>
 #include <Pegasus/Common/FileSystem.h>
 #include <Pegasus/Common/Exception.h>
+#include <Pegasus/Common/CIMNameCast.h>
 #include "AssocInstTable.h"
 
 PEGASUS_USING_STD;
@@ -189,41 +190,50 @@ static void _PutRecord(ofstream& os, Array<String>& fields)
     os << endl;
 }
 
-void AssocInstTable::append(
-    PEGASUS_STD(ofstream)& os,
-    const String& assocInstanceName,
-    const CIMName& assocClassName,
-    const String& fromInstanceName,
-    const CIMName& fromClassName,
-    const CIMName& fromPropertyName,
-    const String& toInstanceName,
-    const CIMName& toClassName,
-    const CIMName& toPropertyName)
+static InstanceAssociation _ToInstanceAssociation(const Array<String>& fields)
+{
+    return InstanceAssociation(
+        fields[ASSOC_INSTANCE_NAME_INDEX],
+        CIMNameCast(fields[ASSOC_CLASS_NAME_INDEX]),
+        fields[FROM_OBJECT_NAME_INDEX],
+        CIMNameCast(fields[FROM_CLASS_NAME_INDEX]),
+        CIMNameCast(fields[FROM_PROPERTY_NAME_INDEX]),
+        fields[TO_OBJECT_NAME_INDEX],
+        CIMNameCast(fields[TO_CLASS_NAME_INDEX]),
+        CIMNameCast(fields[TO_PROPERTY_NAME_INDEX]));
+}
+
+static void _PutRecord(
+    ofstream& os,
+    const InstanceAssociation& instanceAssociation)
 {
     Array<String> fields;
     fields.reserveCapacity(8);
-    fields.append(assocInstanceName);
-    fields.append(assocClassName.getString());
-    fields.append(fromInstanceName);
-    fields.append(fromClassName.getString());
-    fields.append(fromPropertyName.getString());
-    fields.append(toInstanceName);
-    fields.append(toClassName.getString());
-    fields.append(toPropertyName.getString());
+    fields.append(instanceAssociation.assocInstanceName);
+    fields.append(instanceAssociation.assocClassName.getString());
+    fields.append(instanceAssociation.fromInstanceName);
+    fields.append(instanceAssociation.fromClassName.getString());
+    fields.append(instanceAssociation.fromPropertyName.getString());
+    fields.append(instanceAssociation.toInstanceName);
+    fields.append(instanceAssociation.toClassName.getString());
+    fields.append(instanceAssociation.toPropertyName.getString());
 
     _PutRecord(os, fields);
 }
 
+void AssocInstTable::append(
+    PEGASUS_STD(ofstream)& os,
+    const String& path,
+    const InstanceAssociation& instanceAssociation)
+{
+    _PutRecord(os, instanceAssociation);
+
+    _updateCache(path, instanceAssociation);
+}
+
 void AssocInstTable::append(
     const String& path,
-    const String& assocInstanceName,
-    const CIMName& assocClassName,
-    const String& fromInstanceName,
-    const CIMName& fromClassName,
-    const CIMName& fromPropertyName,
-    const String& toInstanceName,
-    const CIMName& toClassName,
-    const CIMName& toPropertyName)
+    const InstanceAssociation& instanceAssociation)
 {
     // Open input file:
 
@@ -234,18 +244,22 @@ void AssocInstTable::append(
 
     // Insert the entry:
 
-    Array<String> fields;
-    fields.reserveCapacity(8);
-    fields.append(assocInstanceName);
-    fields.append(assocClassName.getString());
-    fields.append(fromInstanceName);
-    fields.append(fromClassName.getString());
-    fields.append(fromPropertyName.getString());
-    fields.append(toInstanceName);
-    fields.append(toClassName.getString());
-    fields.append(toPropertyName.getString());
+    _PutRecord(os, instanceAssociation);
 
-    _PutRecord(os, fields);
+    _updateCache(path, instanceAssociation);
+}
+
+void AssocInstTable::_updateCache(
+    const String& path,
+    const InstanceAssociation& instanceAssociation)
+{
+    AutoMutex autoMut(_cacheLock);
+
+    AssocInstCache* cache = _assocInstCacheManager.getAssocInstCache(path);
+    if (cache->isActive())
+    {
+        cache->addRecord(instanceAssociation);
+    }
 }
 
 Boolean AssocInstTable::deleteAssociation(
@@ -276,14 +290,18 @@ Boolean AssocInstTable::deleteAssociation(
     // Copy over all lines except ones with the given association instance name:
 
     Array<String> fields;
-    Boolean found = false;
+    Array<InstanceAssociation> instanceAssociationsToDelete;
 
     while (_GetRecord(is, fields))
     {
         if (assocInstanceName != fields[ASSOC_INSTANCE_NAME_INDEX])
         {
             _PutRecord(os, fields);
-            found = true;
+        }
+        else
+        {
+            instanceAssociationsToDelete.append(
+                _ToInstanceAssociation(fields));
         }
     }
 
@@ -309,7 +327,66 @@ Boolean AssocInstTable::deleteAssociation(
         FileSystem::removeFile(path);
     }
 
-    return found;
+    // Update cache
+    AutoMutex autoMut(_cacheLock);
+    AssocInstCache* cache = _assocInstCacheManager.getAssocInstCache(path);
+    if (cache->isActive())
+    {
+        for (Uint32 i = 0; i < instanceAssociationsToDelete.size(); i++)
+        {
+            cache->removeRecord(instanceAssociationsToDelete[i]);
+        }
+    }
+
+    return instanceAssociationsToDelete.size() != 0;
+}
+
+AssocInstCache* AssocInstTable::_getInitializedCache(const String& path)
+{
+    AssocInstCache* cache = _assocInstCacheManager.getAssocInstCache(path);
+
+    if (!cache->isActive())
+    {
+        // Open input file:
+        ifstream is;
+        if (!FileSystem::exists(path))
+        {
+            return 0;
+        }
+
+        if (!Open(is, path))
+        {
+            throw CannotOpenFile(path);
+        }
+
+        Array<String> fields;
+
+        // For each line in the associations table:
+        try
+        {
+            while (_GetRecord(is, fields))
+            {
+                cache->addRecord(_ToInstanceAssociation(fields));
+            }
+        }
+        catch (...)
+        {
+            // Do not leave a partially loaded cache behind
+            cache->clear();
+            throw;
+        }
+
+        cache->setActive(true);
+    }
+
+    return cache;
+}
+
+void AssocInstTable::invalidateCache(const String& path)
+{
+    AutoMutex autoMut(_cacheLock);
+
+    _assocInstCacheManager.getAssocInstCache(path)->clear();
 }
 
 Boolean AssocInstTable::getAssociatorNames(
@@ -321,33 +398,33 @@ Boolean AssocInstTable::getAssociatorNames(
     const String& resultRole,
     Array<String>& associatorNames)
 {
-    // Open input file:
-    ifstream is;
-    if (!FileSystem::exists(path))
-    {
-        return false;
-    }
+    Array<InstanceAssociation> records;
 
-    if (!Open(is, path))
     {
-        throw CannotOpenFile(path);
+        AutoMutex autoMut(_cacheLock);
+
+        AssocInstCache* cache = _getInitializedCache(path);
+        if (!cache || !cache->getAssocInstEntry(instanceName, records))
+        {
+            return false;
+        }
     }
 
-    Array<String> fields;
     Boolean found = false;
 
-    // For each line in the associations table:
-    while (_GetRecord(is, fields))
+    // For each association from the given object:
+    for (Uint32 i = 0; i < records.size(); i++)
     {
-        // Process associations from the right end object and with right roles
-        if (instanceName == fields[FROM_OBJECT_NAME_INDEX] &&
-            _MatchNoCase(fields[FROM_PROPERTY_NAME_INDEX], role) &&
-            _MatchNoCase(fields[TO_PROPERTY_NAME_INDEX], resultRole))
+        const InstanceAssociation& record = records[i];
+
+        // Process associations with right roles
+        if (_MatchNoCase(record.fromPropertyName.getString(), role) &&
+            _MatchNoCase(record.toPropertyName.getString(), resultRole))
         {
             // Skip classes that do not appear in the association class list
             if ((assocClassList.size() != 0) &&
                 (!_ContainsClass(assocClassList,
-                                 fields[ASSOC_CLASS_NAME_INDEX])))
+                                 record.assocClassName.getString())))
             {
                 continue;
             }
@@ -355,15 +432,15 @@ Boolean AssocInstTable::getAssociatorNames(
             // Skip classes that do not appear in the result class list
             if ((resultClassList.size() != 0) &&
                 (!_ContainsClass(resultClassList,
-                                 fields[TO_CLASS_NAME_INDEX])))
+                                 record.toClassName.getString())))
             {
                 continue;
             }
 
             // This class qualifies; add it to the list (skipping duplicates)
-            if (!Contains(associatorNames, fields[TO_OBJECT_NAME_INDEX]))
+            if (!Contains(associatorNames, record.toInstanceName))
             {
-                associatorNames.append(fields[TO_OBJECT_NAME_INDEX]);
+                associatorNames.append(record.toInstanceName);
             }
             found = true;
         }
@@ -379,40 +456,40 @@ Boolean AssocInstTable::getReferenceNames(
     const String& role,
     Array<String>& referenceNames)
 {
-    // Open input file:
-    ifstream is;
-    if (!FileSystem::exists(path))
-    {
-        return false;
-    }
+    Array<InstanceAssociation> records;
 
-    if (!Open(is, path))
     {
-        throw CannotOpenFile(path);
+        AutoMutex autoMut(_cacheLock);
+
+        AssocInstCache* cache = _getInitializedCache(path);
+        if (!cache || !cache->getAssocInstEntry(instanceName, records))
+        {
+            return false;
+        }
     }
 
-    Array<String> fields;
     Boolean found = false;
 
-    // For each line in the associations table:
-    while (_GetRecord(is, fields))
+    // For each association from the given object:
+    for (Uint32 i = 0; i < records.size(); i++)
     {
-        // Process associations from the right end class and with right role
-        if (instanceName == fields[FROM_OBJECT_NAME_INDEX] &&
-            _MatchNoCase(fields[FROM_PROPERTY_NAME_INDEX], role))
+        const InstanceAssociation& record = records[i];
+
+        // Process associations with right role
+        if (_MatchNoCase(record.fromPropertyName.getString(), role))
         {
             // Skip classes that do not appear in the result class list
             if ((resultClassList.size() != 0) &&
                 (!_ContainsClass(resultClassList,
-                                 fields[ASSOC_CLASS_NAME_INDEX])))
+                                 record.assocClassName.getString())))
             {
                 continue;
             }
 
             // This instance qualifies; add it to the list (skipping duplicates)
-            if (!Contains(referenceNames, fields[ASSOC_INSTANCE_NAME_INDEX]))
+            if (!Contains(referenceNames, record.assocInstanceName))
             {
-                referenceNames.append(fields[ASSOC_INSTANCE_NAME_INDEX]);
+                referenceNames.append(record.assocInstanceName);
             }
             found = true;
         }
@@ -38,58 +38,59 @@
 #include <Pegasus/Common/CIMObjectPath.h>
 #include <Pegasus/Common/String.h>
 #include <Pegasus/Common/ArrayInternal.h>
+#include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Repository/PersistentStoreData.h>
+#include <Pegasus/Repository/AssocInstCache.h>
 #include <Pegasus/Repository/Linkage.h>
 
 PEGASUS_NAMESPACE_BEGIN
 
-/** Maintains all associations for a given namesspace.
+/** Maintains all associations for a given namesspace.  The associations of
+    a table are indexed in memory by their from instance name once the table
+    is first searched, so an associator or reference lookup does not read
+    the whole table.
 */
 class PEGASUS_REPOSITORY_LINKAGE AssocInstTable
 {
 public:
 
+    AssocInstTable()
+    {
+    }
+
+    ~AssocInstTable()
+    {
+    }
+
     /** Appends a row into the association table. There is no checking
         for duplicate entries (the caller ensures this). The case of
         the arguments doesn't matter. They are ignored during comparison.
     */
-    static void append(
+    void append(
         PEGASUS_STD(ofstream)& os,
-        const String& assocInstanceName,
-        const CIMName& assocClassName,
-        const String& fromInstanceName,
-        const CIMName& fromClassName,
-        const CIMName& fromPropertyName,
-        const String& toInstanceName,
-        const CIMName& toClassName,
-        const CIMName& toPropertyName);
+        const String& path,
+        const InstanceAssociation& instanceAssociation);
 
     /** Appends a row into the association table. There is no checking
         for duplicate entries (the caller ensures this). The case of the
         arguments doesn't matter. Case is ignored during comparison.
     */
-    static void append(
+    void append(
         const String& path,
-        const String& assocInstanceName,
-        const CIMName& assocClassName,
-        const String& fromInstanceName,
-        const CIMName& fromClassName,
-        const CIMName& fromPropertyName,
-        const String& toInstanceName,
-        const CIMName& toClassName,
-        const CIMName& toPropertyName);
+        const InstanceAssociation& instanceAssociation);
 
     /** Deletes the given association from the table by removing every entry
         with an assocInstanceName equal to the assocInstanceName parameter.
         @returns true if such an association was found.
     */
-    static Boolean deleteAssociation(
+    Boolean deleteAssociation(
         const String& path,
         const CIMObjectPath& assocInstanceName);
 
     /** Finds all associators of the given object. See
         CIMOperations::associators() for a full description.
     */
-    static Boolean getAssociatorNames(
+    Boolean getAssociatorNames(
         const String& path,
         const CIMObjectPath& objectName,
         const Array<CIMName>& assocClassList,
@@ -102,16 +103,36 @@ public:
         given object is involved. See CIMOperations::associators() for a
         full description.
     */
-    static Boolean getReferenceNames(
+    Boolean getReferenceNames(
         const String& path,
         const CIMObjectPath& objectName,
         const Array<CIMName>& resultClassList,
         const String& role,
         Array<String>& referenceNames);
 
+    /** Discards the index of the given association table.  This must be
+        called when the table file is replaced other than through this
+        class, for example when it is restored from a saved copy.
+    */
+    void invalidateCache(const String& path);
+
 private:
 
-    AssocInstTable() { /* private */ }
+    /** Gets the index of the given association table, loading it from the
+        table file if necessary.  Returns 0 if the table file does not
+        exist.  The caller must hold _cacheLock.
+    */
+    AssocInstCache* _getInitializedCache(const String& path);
+
+    void _updateCache(
+        const String& path,
+        const InstanceAssociation& instanceAssociation);
+
+    AssocInstCacheManager _assocInstCacheManager;
+
+    // Lookups in a namespace may run concurrently, so the caches of all
+    // tables are loaded, searched and updated under this lock.
+    Mutex _cacheLock;
 };
 
 PEGASUS_NAMESPACE_END
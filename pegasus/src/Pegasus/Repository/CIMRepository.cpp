@@ -42,6 +42,9 @@
 #include <Pegasus/Common/PegasusVersion.h>
 #include <Pegasus/Common/MessageLoader.h>
 #include <Pegasus/Common/ReadWriteSem.h>
+#include <Pegasus/Common/AtomicInt.h>
+#include <Pegasus/Common/HashTable.h>
+#include <Pegasus/Common/Threads.h>
 #include <Pegasus/Common/SCMOClassCache.h>
 
 #include <Pegasus/Repository/XmlStreamer.h>
@@ -53,6 +56,7 @@
 #include "ObjectCache.h"
 
 #include "PersistentStore.h"
+#include "RepositorySnapshot.h"
 
 #if 0
 #undef PEG_METHOD_ENTER
@@ -86,6 +90,10 @@ PEGASUS_USING_STD;
 
 PEGASUS_NAMESPACE_BEGIN
 
+class InstanceLockReference;
+
+class StoreFileLock;
+
 class CIMRepositoryRep
 {
 public:
@@ -95,10 +103,58 @@ public:
 #ifdef PEGASUS_USE_CLASS_CACHE
           _classCache(PEGASUS_CLASS_CACHE_SIZE),
 #endif /* PEGASUS_USE_CLASS_CACHE */
-          _qualifierCache(PEGASUS_QUALIFIER_CACHE_SIZE)
+          _qualifierCache(PEGASUS_QUALIFIER_CACHE_SIZE),
+          _fileLockCount(0),
+          _transactionAborted(false)
+    {
+    }
+
+    ~CIMRepositoryRep();
+
+    /**
+        Returns the lock of the instances of the specified namespace,
+        creating it if necessary, and adds a reference to it.  Every call
+        must be matched by a call to _releaseInstanceLock() once the lock
+        is no longer held (see InstanceLockReference).
+    */
+    ReadWriteSem& _acquireInstanceLock(const CIMNamespaceName& nameSpace);
+
+    /**
+        Drops a reference to the instance lock of the specified namespace
+        and removes the lock when the last reference is gone, so the table
+        only holds the locks of namespaces with instance operations in
+        progress.
+    */
+    void _releaseInstanceLock(const CIMNamespaceName& nameSpace);
+
+    /**
+        Returns true if the calling thread owns the active instance
+        transaction and it is for the specified namespace.
+    */
+    Boolean _ownsInstanceTransaction(const CIMNamespaceName& nameSpace) const
     {
+        return _transactionActive.get() &&
+            Threads::equal(_transactionThread, Threads::self()) &&
+            _transactionNameSpace == nameSpace;
     }
 
+    /**
+        Called before the persistent store is changed.  Throws if the
+        instance transaction of the calling thread was rolled back.
+    */
+    void _checkInstanceTransaction(const CIMNamespaceName& nameSpace);
+
+    /**
+        Called when a change of the persistent store fails.  Rolls back the
+        instance transaction of the calling thread, if any.
+    */
+    void _abortInstanceTransaction(const CIMNamespaceName& nameSpace);
+
+    /**
+        Releases the locks of the active instance transaction and ends it.
+    */
+    void _endInstanceTransaction();
+
     /**
         Checks whether an instance with the specified key values exists in the
         class hierarchy of the specified class.
@@ -121,6 +177,19 @@ public:
 
     AutoPtr<PersistentStore> _persistentStore;
 
+    /**
+        Copy of the namespaces and class names of the persistent store, used
+        to initialize the NameSpaceManager on startup.  It is invalidated
+        before each change of the namespaces or classes.
+    */
+    AutoPtr<RepositorySnapshot> _snapshot;
+
+    /**
+        Incremented, under the write lock, with each change of the namespaces
+        or classes.  See CIMRepository::getClassGeneration().
+    */
+    AtomicInt _classGeneration;
+
     /**
         Indicates whether the class definitions in the persistent store are
         complete (contain propagated elements).
@@ -129,8 +198,29 @@ public:
 
     NameSpaceManager _nameSpaceManager;
 
+    /**
+        Held for writing while namespaces, classes or qualifiers change and
+        for reading by all other operations.  Instance operations hold it
+        for reading only and serialize on the lock of their namespace, so
+        an instance change in one namespace does not block class readers or
+        the instance operations of other namespaces.
+    */
     ReadWriteSem _lock;
 
+    struct InstanceLockEntry
+    {
+        InstanceLockEntry() : references(0) { }
+
+        ReadWriteSem lock;
+        Uint32 references;
+    };
+
+    typedef HashTable<String, InstanceLockEntry*, EqualNoCaseFunc,
+        HashLowerCaseFunc> InstanceLockTable;
+
+    InstanceLockTable _instanceLocks;
+    Mutex _instanceLocksMutex;
+
     RepositoryDeclContext* _context;
 
     CString _lockFile;
@@ -140,8 +230,241 @@ public:
 #endif /* PEGASUS_USE_CLASS_CACHE */
 
     ObjectCache<CIMQualifierDecl> _qualifierCache;
+
+    /**
+        The lock of _lockFile protects the persistent store against changes
+        from other processes.  It is owned by the process, so it is shared
+        by the threads changing the store and released when the last of
+        them is done (see StoreFileLock).
+    */
+    AutoPtr<AutoFileLock> _fileLock;
+    Uint32 _fileLockCount;
+    Mutex _fileLockMutex;
+
+    /**
+        Instance transaction state.  _transactionMutex is held by the owner
+        of the active transaction, which serializes the transactions.  The
+        owner also holds the repository lock for reading, the instance lock
+        of its namespace for writing and the lock file until the transaction
+        ends; its own instance operations do not lock them again.
+    */
+    Mutex _transactionMutex;
+    AtomicInt _transactionActive;
+    ThreadType _transactionThread;
+    CIMNamespaceName _transactionNameSpace;
+    Boolean _transactionAborted;
+    AutoPtr<ReadLock> _transactionRepositoryLock;
+    AutoPtr<InstanceLockReference> _transactionInstanceLockReference;
+    AutoPtr<WriteLock> _transactionInstanceLock;
+    AutoPtr<StoreFileLock> _transactionFileLock;
+};
+
+ReadWriteSem& CIMRepositoryRep::_acquireInstanceLock(
+    const CIMNamespaceName& nameSpace)
+{
+    AutoMutex lock(_instanceLocksMutex);
+
+    InstanceLockEntry* entry;
+
+    if (!_instanceLocks.lookup(nameSpace.getString(), entry))
+    {
+        entry = new InstanceLockEntry();
+        _instanceLocks.insert(nameSpace.getString(), entry);
+    }
+
+    entry->references++;
+    return entry->lock;
+}
+
+void CIMRepositoryRep::_releaseInstanceLock(const CIMNamespaceName& nameSpace)
+{
+    AutoMutex lock(_instanceLocksMutex);
+
+    InstanceLockEntry* entry;
+
+    if (_instanceLocks.lookup(nameSpace.getString(), entry) &&
+        --entry->references == 0)
+    {
+        _instanceLocks.remove(nameSpace.getString());
+        delete entry;
+    }
+}
+
+/**
+    Holds a reference to the instance lock of a namespace, which keeps the
+    lock in the table while it is waited for or held.  It must be released
+    after the lock itself.
+*/
+class InstanceLockReference
+{
+public:
+
+    InstanceLockReference(
+        CIMRepositoryRep* rep,
+        const CIMNamespaceName& nameSpace)
+        : _rep(rep),
+          _nameSpace(nameSpace),
+          _lock(rep->_acquireInstanceLock(nameSpace))
+    {
+    }
+
+    ~InstanceLockReference()
+    {
+        _rep->_releaseInstanceLock(_nameSpace);
+    }
+
+    ReadWriteSem& getLock()
+    {
+        return _lock;
+    }
+
+private:
+
+    InstanceLockReference(const InstanceLockReference&);
+    InstanceLockReference& operator=(const InstanceLockReference&);
+
+    CIMRepositoryRep* _rep;
+    CIMNamespaceName _nameSpace;
+    ReadWriteSem& _lock;
+};
+
+/**
+    Locks held by the instance operations: the repository lock for reading,
+    which keeps the namespaces and classes from changing, and the instance
+    lock of the namespace.  The owner of an instance transaction already
+    holds them for its namespace.
+*/
+class InstanceReadLock
+{
+public:
+
+    InstanceReadLock(CIMRepositoryRep* rep, const CIMNamespaceName& nameSpace)
+    {
+        if (!rep->_ownsInstanceTransaction(nameSpace))
+        {
+            _repositoryLock.reset(new ReadLock(rep->_lock));
+            _instanceLockReference.reset(
+                new InstanceLockReference(rep, nameSpace));
+            _instanceLock.reset(
+                new ReadLock(_instanceLockReference->getLock()));
+        }
+    }
+
+private:
+
+    // Destroyed in reverse order: the instance lock is unlocked before
+    // its reference is released.
+    AutoPtr<ReadLock> _repositoryLock;
+    AutoPtr<InstanceLockReference> _instanceLockReference;
+    AutoPtr<ReadLock> _instanceLock;
+};
+
+class InstanceWriteLock
+{
+public:
+
+    InstanceWriteLock(CIMRepositoryRep* rep, const CIMNamespaceName& nameSpace)
+    {
+        if (!rep->_ownsInstanceTransaction(nameSpace))
+        {
+            _repositoryLock.reset(new ReadLock(rep->_lock));
+            _instanceLockReference.reset(
+                new InstanceLockReference(rep, nameSpace));
+            _instanceLock.reset(
+                new WriteLock(_instanceLockReference->getLock()));
+        }
+    }
+
+private:
+
+    AutoPtr<ReadLock> _repositoryLock;
+    AutoPtr<InstanceLockReference> _instanceLockReference;
+    AutoPtr<WriteLock> _instanceLock;
 };
 
+/**
+    Holds the repository lock file while the persistent store is changed.
+    Threads changing different namespaces share the lock of the process.
+*/
+class StoreFileLock
+{
+public:
+
+    StoreFileLock(CIMRepositoryRep* rep) : _rep(rep)
+    {
+        AutoMutex lock(_rep->_fileLockMutex);
+
+        if (_rep->_fileLockCount++ == 0)
+        {
+            _rep->_fileLock.reset(new AutoFileLock(_rep->_lockFile));
+        }
+    }
+
+    ~StoreFileLock()
+    {
+        AutoMutex lock(_rep->_fileLockMutex);
+
+        if (--_rep->_fileLockCount == 0)
+        {
+            _rep->_fileLock.reset();
+        }
+    }
+
+private:
+
+    StoreFileLock(const StoreFileLock&);
+    StoreFileLock& operator=(const StoreFileLock&);
+
+    CIMRepositoryRep* _rep;
+};
+
+CIMRepositoryRep::~CIMRepositoryRep()
+{
+    for (InstanceLockTable::Iterator i = _instanceLocks.start(); i; i++)
+    {
+        delete i.value();
+    }
+}
+
+void CIMRepositoryRep::_checkInstanceTransaction(
+    const CIMNamespaceName& nameSpace)
+{
+    if (_transactionAborted && _ownsInstanceTransaction(nameSpace))
+    {
+        throw PEGASUS_CIM_EXCEPTION_L(CIM_ERR_FAILED,
+            MessageLoaderParms(
+                "Repository.CIMRepository.INSTANCE_TRANSACTION_ROLLED_BACK",
+                "The instance transaction was rolled back after a failed "
+                    "change."));
+    }
+}
+
+void CIMRepositoryRep::_abortInstanceTransaction(
+    const CIMNamespaceName& nameSpace)
+{
+    if (_ownsInstanceTransaction(nameSpace) && !_transactionAborted)
+    {
+        PEG_TRACE((TRC_REPOSITORY, Tracer::LEVEL1,
+            "Rolling back the instance transaction for namespace %s "
+                "after a failed change",
+            (const char*)nameSpace.getString().getCString()));
+
+        _transactionAborted = true;
+        _persistentStore->rollbackInstanceTransaction();
+    }
+}
+
+void CIMRepositoryRep::_endInstanceTransaction()
+{
+    _transactionActive = 0;
+    _transactionAborted = false;
+    _transactionFileLock.reset();
+    _transactionInstanceLock.reset();
+    _transactionInstanceLockReference.reset();
+    _transactionRepositoryLock.reset();
+    _transactionMutex.unlock();
+}
+
 static String _getCacheKey(
     const CIMNamespaceName& nameSpace,
     const CIMName& entryName)
@@ -706,9 +1029,17 @@ CIMRepository::CIMRepository(
     _rep->_storeCompleteClassDefinitions =
         _rep->_persistentStore->storeCompleteClassDefinitions();
 
-    // Initialize the NameSpaceManager
+    // Initialize the NameSpaceManager, from the repository snapshot if it
+    // was saved after the last change of namespaces or classes.  Otherwise
+    // enumerate the namespaces and classes of the persistent store and save
+    // a new snapshot.  The snapshot lists parent namespaces first.
 
-    Array<NamespaceDefinition> nameSpaces =
+    _rep->_snapshot.reset(new RepositorySnapshot(repositoryRoot));
+
+    Boolean fromSnapshot = _rep->_snapshot->load();
+
+    Array<NamespaceDefinition> nameSpaces = fromSnapshot ?
+        _rep->_snapshot->getNameSpaces() :
         _rep->_persistentStore->enumerateNameSpaces();
 
     Uint32 i = 0;
@@ -719,10 +1050,20 @@ CIMRepository::CIMRepository(
                 nameSpaces[i].parentNameSpace))
         {
             // Parent namespace exists; go ahead and initialize this namespace
-            _rep->_nameSpaceManager.initializeNameSpace(
-                nameSpaces[i],
-                _rep->_persistentStore->enumerateClassNames(
-                    nameSpaces[i].name));
+            if (fromSnapshot)
+            {
+                _rep->_nameSpaceManager.initializeNameSpace(
+                    nameSpaces[i], _rep->_snapshot->getClassNames(i));
+            }
+            else
+            {
+                Array<Pair<String, String> > classList =
+                    _rep->_persistentStore->enumerateClassNames(
+                        nameSpaces[i].name);
+                _rep->_nameSpaceManager.initializeNameSpace(
+                    nameSpaces[i], classList);
+                _rep->_snapshot->addNameSpace(nameSpaces[i], classList);
+            }
             i++;
         }
         else
@@ -754,6 +1095,13 @@ CIMRepository::CIMRepository(
         }
     }
 
+    if (!fromSnapshot)
+    {
+        _rep->_snapshot->save();
+    }
+
+    _rep->_snapshot->clear();
+
     if (!_rep->_nameSpaceManager.nameSpaceExists("root"))
     {
         // Create a root namespace per ...
@@ -778,6 +1126,16 @@ CIMRepository::~CIMRepository()
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::~CIMRepository");
 
+    // An instance transaction left open holds locks of the repository,
+    // so it is rolled back before they are destroyed.
+    try
+    {
+        rollbackInstanceTransaction();
+    }
+    catch (...)
+    {
+    }
+
     delete _rep->_context;
 
     delete _rep;
@@ -790,6 +1148,90 @@ String _toString(Boolean x)
     return(x ? "true" : "false");
 }
 
+/**
+    Applies the localOnly, includeQualifiers, includeClassOrigin and
+    propertyList options of a GetClass request to the class.  If clone is
+    false, the class refers to the one in the class cache and is cloned
+    before it is changed.
+*/
+static void _filterClass(
+    CIMClass& cimClass,
+    Boolean classIncludesPropagatedElements,
+    Boolean localOnly,
+    Boolean includeQualifiers,
+    Boolean includeClassOrigin,
+    const CIMPropertyList& propertyList,
+    Boolean clone)
+{
+#if !defined(PEGASUS_USE_CLASS_CACHE)
+    // This flag must be true if caching is disabled, otherwise, an unecessary
+    // copy could be created below.
+    clone = true;
+#endif
+
+    // If clone is true, then cimClass is a clone (not shared with cache).
+    // Else, it refers to the same one in the cache and any code below that
+    // changes it, will need to clone it first.
+
+    if (localOnly && classIncludesPropagatedElements)
+    {
+        // We must clone after all since object is modified below.
+        if (!clone)
+            cimClass = cimClass.clone();
+
+        _stripPropagatedElements(cimClass);
+    }
+
+    // Remove properties based on propertyList
+    if (!propertyList.isNull())
+    {
+        // We must clone after all since object is modified below.
+        if (!clone)
+            cimClass = cimClass.clone();
+
+        // Remove properties that are not in the property list.
+        // Work backwards because removal may be cheaper. Sint32 covers count=0
+        for (Sint32 i = cimClass.getPropertyCount() - 1; i >= 0; i--)
+        {
+            if (!_containsProperty(cimClass.getProperty(i), propertyList))
+            {
+                cimClass.removeProperty(i);
+            }
+        }
+    }
+
+    // If includequalifiers false, remove all qualifiers from
+    // properties, methods and parameters.
+    if (!includeQualifiers)
+    {
+        // We must clone after all since object is modified below.
+        if (!clone)
+            cimClass = cimClass.clone();
+
+        _removeAllQualifiers(cimClass);
+    }
+
+    // if ClassOrigin Flag false, remove classOrigin info from class object
+    // by setting the property to Null.
+    if (!includeClassOrigin)
+    {
+        // We must clone after all since object is modified below.
+        if (!clone)
+            cimClass = cimClass.clone();
+
+        PEG_TRACE_CSTRING(TRC_REPOSITORY, Tracer::LEVEL4,
+            "Remove Class Origins");
+
+        Uint32 propertyCount = cimClass.getPropertyCount();
+        for (Uint32 i = 0; i < propertyCount ; i++)
+            cimClass.getProperty(i).setClassOrigin(CIMName());
+
+        Uint32 methodCount =  cimClass.getMethodCount();
+        for (Uint32 i=0; i < methodCount ; i++)
+            cimClass.getMethod(i).setClassOrigin(CIMName());
+    }
+}
+
 CIMClass CIMRepository::getClass(
     const CIMNamespaceName& nameSpace,
     const CIMName& className,
@@ -800,13 +1242,37 @@ CIMClass CIMRepository::getClass(
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::getClass");
 
+    CIMClass cimClass;
+
+#ifdef PEGASUS_USE_CLASS_CACHE
+    // The classes in the cache are complete and never modified.  Writers
+    // evict them, under the write lock, before a class changes, so a class
+    // found in the cache is returned without waiting for the lock.
+
+    if (_rep->_classCache.get(
+            _getCacheKey(nameSpace, className), cimClass, true))
+    {
+        _filterClass(
+            cimClass,
+            true,
+            localOnly,
+            includeQualifiers,
+            includeClassOrigin,
+            propertyList,
+            true);
+
+        PEG_METHOD_EXIT();
+        return cimClass;
+    }
+#endif
+
     ReadLock lock(_rep->_lock);
-    CIMClass cimClass = _getClass(nameSpace,
-                                  className,
-                                  localOnly,
-                                  includeQualifiers,
-                                  includeClassOrigin,
-                                  propertyList);
+    cimClass = _getClass(nameSpace,
+                         className,
+                         localOnly,
+                         includeQualifiers,
+                         includeClassOrigin,
+                         propertyList);
 
     PEG_METHOD_EXIT();
     return cimClass;
@@ -879,73 +1345,14 @@ CIMClass CIMRepository::_getClass(
     }
 #endif
 
-#if !defined(PEGASUS_USE_CLASS_CACHE)
-    // This flag must be true if caching is disabled, otherwise, an unecessary
-    // copy could be created below.
-    clone = true;
-#endif
-
-    // If clone is true, then cimClass is a clone (not shared with cache).
-    // Else, it refers to the same one in the cache and any code below that
-    // changes it, will need to clone it first.
-
-    if (localOnly && classIncludesPropagatedElements)
-    {
-        // We must clone after all since object is modified below.
-        if (!clone)
-            cimClass = cimClass.clone();
-
-        _stripPropagatedElements(cimClass);
-    }
-
-    // Remove properties based on propertyList
-    if (!propertyList.isNull())
-    {
-        // We must clone after all since object is modified below.
-        if (!clone)
-            cimClass = cimClass.clone();
-
-        // Remove properties that are not in the property list.
-        // Work backwards because removal may be cheaper. Sint32 covers count=0
-        for (Sint32 i = cimClass.getPropertyCount() - 1; i >= 0; i--)
-        {
-            if (!_containsProperty(cimClass.getProperty(i), propertyList))
-            {
-                cimClass.removeProperty(i);
-            }
-        }
-    }
-
-    // If includequalifiers false, remove all qualifiers from
-    // properties, methods and parameters.
-    if (!includeQualifiers)
-    {
-        // We must clone after all since object is modified below.
-        if (!clone)
-            cimClass = cimClass.clone();
-
-        _removeAllQualifiers(cimClass);
-    }
-
-    // if ClassOrigin Flag false, remove classOrigin info from class object
-    // by setting the property to Null.
-    if (!includeClassOrigin)
-    {
-        // We must clone after all since object is modified below.
-        if (!clone)
-            cimClass = cimClass.clone();
-
-        PEG_TRACE_CSTRING(TRC_REPOSITORY, Tracer::LEVEL4,
-            "Remove Class Origins");
-
-        Uint32 propertyCount = cimClass.getPropertyCount();
-        for (Uint32 i = 0; i < propertyCount ; i++)
-            cimClass.getProperty(i).setClassOrigin(CIMName());
-
-        Uint32 methodCount =  cimClass.getMethodCount();
-        for (Uint32 i=0; i < methodCount ; i++)
-            cimClass.getMethod(i).setClassOrigin(CIMName());
-    }
+    _filterClass(
+        cimClass,
+        classIncludesPropagatedElements,
+        localOnly,
+        includeQualifiers,
+        includeClassOrigin,
+        propertyList,
+        clone);
 
     PEG_METHOD_EXIT();
     return cimClass;
@@ -1000,7 +1407,7 @@ CIMInstance CIMRepository::getInstance(
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::getInstance");
 
-    ReadLock lock(_rep->_lock);
+    InstanceReadLock lock(_rep, nameSpace);
 
     CIMInstance cimInstance = _getInstance(
         nameSpace,
@@ -1070,7 +1477,6 @@ void CIMRepository::deleteClass(
     PEG_METHOD_ENTER(TRC_REPOSITORY,"CIMRepository::deleteClass");
 
     WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
 
     //
     // Get the class and check to see if it is an association class.
@@ -1120,6 +1526,11 @@ void CIMRepository::deleteClass(
     CIMName superClassName =
         _rep->_nameSpaceManager.getSuperClassName(nameSpace, className);
 
+    StoreFileLock fileLock(_rep);
+
+    _rep->_snapshot->invalidate();
+    _rep->_classGeneration++;
+
     _rep->_nameSpaceManager.deleteClass(nameSpace, className);
 
     _rep->_persistentStore->deleteClass(
@@ -1144,10 +1555,31 @@ void CIMRepository::deleteInstance(
     CIMObjectPath normalizedInstanceName =
         _stripInstanceName(nameSpace, instanceName);
 
-    WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
+    InstanceWriteLock lock(_rep, nameSpace);
+
+    StoreFileLock fileLock(_rep);
+    _rep->_checkInstanceTransaction(nameSpace);
 
-    _rep->_persistentStore->deleteInstance(nameSpace, normalizedInstanceName);
+    // A missing instance is reported before the store is changed, so it
+    // does not roll back the instance transaction.
+    if (!_rep->_persistentStore->instanceExists(
+            nameSpace, normalizedInstanceName))
+    {
+        PEG_METHOD_EXIT();
+        throw PEGASUS_CIM_EXCEPTION(
+            CIM_ERR_NOT_FOUND, normalizedInstanceName.toString());
+    }
+
+    try
+    {
+        _rep->_persistentStore->deleteInstance(
+            nameSpace, normalizedInstanceName);
+    }
+    catch (...)
+    {
+        _rep->_abortInstanceTransaction(nameSpace);
+        throw;
+    }
 
     PEG_METHOD_EXIT();
 }
@@ -1159,7 +1591,6 @@ void CIMRepository::createClass(
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::createClass");
 
     WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
     _createClass(nameSpace, newClass);
 
     PEG_METHOD_EXIT();
@@ -1199,6 +1630,11 @@ void CIMRepository::_createClass(
 
     // -- Create the class declaration:
 
+    StoreFileLock fileLock(_rep);
+
+    _rep->_snapshot->invalidate();
+    _rep->_classGeneration++;
+
     _rep->_persistentStore->createClass(nameSpace, cimClass, classAssocEntries);
 
     // -- Create namespace manager entry:
@@ -1215,8 +1651,7 @@ CIMObjectPath CIMRepository::createInstance(
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::createInstance");
 
-    WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
+    InstanceWriteLock lock(_rep, nameSpace);
     CIMObjectPath instanceName = _createInstance(nameSpace, newInstance);
 
     PEG_METHOD_EXIT();
@@ -1281,8 +1716,19 @@ CIMObjectPath CIMRepository::_createInstance(
     // Create the instance
     //
 
-    _rep->_persistentStore->createInstance(
-        nameSpace, instanceName, cimInstance, instAssocEntries);
+    StoreFileLock fileLock(_rep);
+    _rep->_checkInstanceTransaction(nameSpace);
+
+    try
+    {
+        _rep->_persistentStore->createInstance(
+            nameSpace, instanceName, cimInstance, instAssocEntries);
+    }
+    catch (...)
+    {
+        _rep->_abortInstanceTransaction(nameSpace);
+        throw;
+    }
 
     PEG_METHOD_EXIT();
     return instanceName;
@@ -1295,7 +1741,6 @@ void CIMRepository::modifyClass(
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::modifyClass");
 
     WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
     _modifyClass(nameSpace, modifiedClass);
 
     PEG_METHOD_EXIT();
@@ -1363,6 +1808,11 @@ void CIMRepository::_modifyClass(
         _stripPropagatedElements(cimClass);
     }
 
+    StoreFileLock fileLock(_rep);
+
+    _rep->_snapshot->invalidate();
+    _rep->_classGeneration++;
+
     _rep->_persistentStore->modifyClass(
         nameSpace,
         cimClass,
@@ -1381,8 +1831,7 @@ void CIMRepository::modifyInstance(
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::modifyInstance");
 
-    WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
+    InstanceWriteLock lock(_rep, nameSpace);
 
     //
     // Do this:
@@ -1570,8 +2019,9 @@ void CIMRepository::modifyInstance(
 
                     // Nothing to do; just make sure the property name is valid
                     // ATTN: This is not the most efficient solution
-                    CIMClass cimClass = getClass(
-                        nameSpace, cimInstance.getClassName(), false);
+                    CIMClass cimClass = _getClass(
+                        nameSpace, cimInstance.getClassName(), false, true,
+                        false, CIMPropertyList());
                     if (cimClass.findProperty(propertyList[i]) == PEG_NOT_FOUND)
                     {
                         // ATTN: This exception may be returned by setProperty
@@ -1609,8 +2059,19 @@ void CIMRepository::modifyInstance(
                 "Attempted to modify a key property"));
     }
 
-    _rep->_persistentStore->modifyInstance(
-        nameSpace, normalizedInstanceName, cimInstance);
+    StoreFileLock fileLock(_rep);
+    _rep->_checkInstanceTransaction(nameSpace);
+
+    try
+    {
+        _rep->_persistentStore->modifyInstance(
+            nameSpace, normalizedInstanceName, cimInstance);
+    }
+    catch (...)
+    {
+        _rep->_abortInstanceTransaction(nameSpace);
+        throw;
+    }
 
     PEG_METHOD_EXIT();
 }
@@ -1717,7 +2178,7 @@ Array<CIMInstance> CIMRepository::enumerateInstancesForClass(
     PEG_METHOD_ENTER(TRC_REPOSITORY,
         "CIMRepository::enumerateInstancesForClass");
 
-    ReadLock lock(_rep->_lock);
+    InstanceReadLock lock(_rep, nameSpace);
 
     _rep->_nameSpaceManager.validateClass(nameSpace, className);
 
@@ -1796,7 +2257,7 @@ Array<CIMObjectPath> CIMRepository::enumerateInstanceNamesForClass(
     PEG_METHOD_ENTER(TRC_REPOSITORY,
         "CIMRepository::enumerateInstanceNamesForClass");
 
-    ReadLock lock(_rep->_lock);
+    InstanceReadLock lock(_rep, nameSpace);
 
     _rep->_nameSpaceManager.validateClass(nameSpace, className);
 
@@ -1822,7 +2283,7 @@ Array<CIMObject> CIMRepository::associators(
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::associators");
 
-    ReadLock lock(_rep->_lock);
+    InstanceReadLock lock(_rep, nameSpace);
 
     Array<CIMObjectPath> names = _associatorNames(
         nameSpace,
@@ -1897,7 +2358,7 @@ Array<CIMObjectPath> CIMRepository::associatorNames(
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::associatorNames");
 
-    ReadLock lock(_rep->_lock);
+    InstanceReadLock lock(_rep, nameSpace);
     Array<CIMObjectPath> result = _associatorNames(
         nameSpace, objectName, assocClass, resultClass, role, resultRole);
 
@@ -2015,7 +2476,7 @@ Array<CIMObject> CIMRepository::references(
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::references");
 
-    ReadLock lock(_rep->_lock);
+    InstanceReadLock lock(_rep, nameSpace);
 
     Array<CIMObjectPath> names = _referenceNames(
         nameSpace,
@@ -2089,7 +2550,7 @@ Array<CIMObjectPath> CIMRepository::referenceNames(
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::referenceNames");
 
-    ReadLock lock(_rep->_lock);
+    InstanceReadLock lock(_rep, nameSpace);
     Array<CIMObjectPath> result = _referenceNames(
         nameSpace, objectName, resultClass, role);
 
@@ -2204,7 +2665,7 @@ CIMValue CIMRepository::getProperty(
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::getProperty");
 
-    ReadLock lock(_rep->_lock);
+    InstanceReadLock lock(_rep, nameSpace);
 
     //
     // Retrieve the specified instance
@@ -2336,7 +2797,6 @@ void CIMRepository::setQualifier(
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::setQualifier");
 
     WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
     _setQualifier(nameSpace, qualifierDecl);
 
     PEG_METHOD_EXIT();
@@ -2351,6 +2811,8 @@ void CIMRepository::_setQualifier(
     _rep->_nameSpaceManager.checkNameSpaceUpdateAllowed(
         nameSpace);
 
+    StoreFileLock fileLock(_rep);
+
     // Exception if namespace does not allow update
     _rep->_persistentStore->setQualifier(nameSpace, qualifierDecl);
 
@@ -2370,12 +2832,13 @@ void CIMRepository::deleteQualifier(
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::deleteQualifier");
 
     WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
 
     // Exception exit if not allowed
     _rep->_nameSpaceManager.checkNameSpaceUpdateAllowed(
         nameSpace);
 
+    StoreFileLock fileLock(_rep);
+
     _rep->_persistentStore->deleteQualifier(nameSpace, qualifierName);
 
     String qualifierCacheKey = _getCacheKey(nameSpace, qualifierName);
@@ -2408,7 +2871,6 @@ void CIMRepository::createNameSpace(
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::createNameSpace");
 
     WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
 
     Boolean shareable = false;
     Boolean updatesAllowed = true;
@@ -2448,6 +2910,11 @@ void CIMRepository::createNameSpace(
     _rep->_nameSpaceManager.createNameSpace(
         nameSpace, shareable, updatesAllowed, parentNameSpace, remoteInfo);
 
+    StoreFileLock fileLock(_rep);
+
+    _rep->_snapshot->invalidate();
+    _rep->_classGeneration++;
+
     try
     {
         _rep->_persistentStore->createNameSpace(
@@ -2469,7 +2936,6 @@ void CIMRepository::modifyNameSpace(
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::modifyNameSpace");
 
     WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
 
     Boolean shareable = false;
     Boolean updatesAllowed = true;
@@ -2514,6 +2980,11 @@ void CIMRepository::modifyNameSpace(
         }
     }
 
+    StoreFileLock fileLock(_rep);
+
+    _rep->_snapshot->invalidate();
+    _rep->_classGeneration++;
+
     _rep->_persistentStore->modifyNameSpace(
         nameSpace, shareable, updatesAllowed);
 
@@ -2530,10 +3001,14 @@ void CIMRepository::modifyNameSpaceName(
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::modifyNameSpaceName");
 
     WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
 
     _rep->_nameSpaceManager.validateNameSpace(nameSpace);
 
+    StoreFileLock fileLock(_rep);
+
+    _rep->_snapshot->invalidate();
+    _rep->_classGeneration++;
+
     _rep->_persistentStore->modifyNameSpaceName(
             nameSpace, newNameSpaceName);
 
@@ -2561,7 +3036,6 @@ void CIMRepository::deleteNameSpace(const CIMNamespaceName& nameSpace)
     PEG_METHOD_ENTER(TRC_REPOSITORY, "CIMRepository::deleteNameSpace");
 
     WriteLock lock(_rep->_lock);
-    AutoFileLock fileLock(_rep->_lockFile);
 
     // Check for dependent namespaces
 
@@ -2585,6 +3059,11 @@ void CIMRepository::deleteNameSpace(const CIMNamespaceName& nameSpace)
         throw NonEmptyNameSpace(nameSpace.getString());
     }
 
+    StoreFileLock fileLock(_rep);
+
+    _rep->_snapshot->invalidate();
+    _rep->_classGeneration++;
+
     _rep->_persistentStore->deleteNameSpace(nameSpace);
 
     _rep->_nameSpaceManager.deleteNameSpace(nameSpace);
@@ -2689,6 +3168,111 @@ Boolean CIMRepository::isDefaultInstanceProvider()
     return _rep->_isDefaultInstanceProvider;
 }
 
+Uint32 CIMRepository::getClassGeneration() const
+{
+    return _rep->_classGeneration.get();
+}
+
+void CIMRepository::beginInstanceTransaction(
+    const CIMNamespaceName& nameSpace)
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY,
+        "CIMRepository::beginInstanceTransaction");
+
+    _rep->_transactionMutex.lock();
+
+    try
+    {
+        _rep->_transactionRepositoryLock.reset(new ReadLock(_rep->_lock));
+
+        if (!_rep->_nameSpaceManager.nameSpaceExists(nameSpace))
+        {
+            throw PEGASUS_CIM_EXCEPTION(
+                CIM_ERR_INVALID_NAMESPACE, nameSpace.getString());
+        }
+
+        _rep->_transactionInstanceLockReference.reset(
+            new InstanceLockReference(_rep, nameSpace));
+        _rep->_transactionInstanceLock.reset(new WriteLock(
+            _rep->_transactionInstanceLockReference->getLock()));
+        _rep->_transactionFileLock.reset(new StoreFileLock(_rep));
+
+        _rep->_persistentStore->beginInstanceTransaction(nameSpace);
+    }
+    catch (...)
+    {
+        _rep->_endInstanceTransaction();
+        PEG_METHOD_EXIT();
+        throw;
+    }
+
+    _rep->_transactionThread = Threads::self();
+    _rep->_transactionNameSpace = nameSpace;
+    _rep->_transactionActive = 1;
+
+    PEG_METHOD_EXIT();
+}
+
+void CIMRepository::commitInstanceTransaction()
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY,
+        "CIMRepository::commitInstanceTransaction");
+
+    if (!_rep->_transactionActive.get() ||
+        !_rep->_ownsInstanceTransaction(_rep->_transactionNameSpace))
+    {
+        PEG_METHOD_EXIT();
+        throw PEGASUS_CIM_EXCEPTION_L(CIM_ERR_FAILED,
+            MessageLoaderParms(
+                "Repository.CIMRepository.NO_INSTANCE_TRANSACTION",
+                "No instance transaction is active."));
+    }
+
+    try
+    {
+        _rep->_checkInstanceTransaction(_rep->_transactionNameSpace);
+        _rep->_persistentStore->commitInstanceTransaction();
+    }
+    catch (...)
+    {
+        _rep->_endInstanceTransaction();
+        PEG_METHOD_EXIT();
+        throw;
+    }
+
+    _rep->_endInstanceTransaction();
+
+    PEG_METHOD_EXIT();
+}
+
+void CIMRepository::rollbackInstanceTransaction()
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY,
+        "CIMRepository::rollbackInstanceTransaction");
+
+    if (_rep->_transactionActive.get() &&
+        _rep->_ownsInstanceTransaction(_rep->_transactionNameSpace))
+    {
+        try
+        {
+            if (!_rep->_transactionAborted)
+            {
+                _rep->_persistentStore->rollbackInstanceTransaction();
+            }
+        }
+        catch (...)
+        {
+            _rep->_endInstanceTransaction();
+            PEG_METHOD_EXIT();
+            throw;
+        }
+
+        _rep->_endInstanceTransaction();
+    }
+
+    PEG_METHOD_EXIT();
+}
+
 CIMConstClass CIMRepository::getFullConstClass(
     const CIMNamespaceName& nameSpace,
     const CIMName& className)
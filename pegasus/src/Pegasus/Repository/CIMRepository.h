@@ -412,6 +412,44 @@ public:
     */
     Boolean isDefaultInstanceProvider();
 
+    /** Returns a counter that changes whenever a namespace or class is
+        created, modified or deleted.  Callers may cache information derived
+        from the class hierarchy (for example subclass name lists) and
+        discard it when the value returned differs from the value read
+        before the information was obtained.
+    */
+    Uint32 getClassGeneration() const;
+
+    /** Begins an instance transaction for the specified namespace.  The
+        instance changes the calling thread makes in the namespace until the
+        transaction ends are applied under a single recovery journal of the
+        persistent store and become durable together when
+        commitInstanceTransaction() is called, rather than one by one.  If a
+        change fails in the persistent store, all changes of the transaction
+        are rolled back; the transaction must still be ended.
+
+        While the transaction is active, other threads are blocked from the
+        instances of the namespace and from changing namespaces, classes
+        and qualifiers.  The calling thread must not change namespaces,
+        classes or qualifiers itself.  Instance transactions are serialized.
+        @param nameSpace the namespace of the instance changes
+        @exception CIMException with CIM_ERR_INVALID_NAMESPACE if the
+            namespace does not exist
+    */
+    void beginInstanceTransaction(const CIMNamespaceName& nameSpace);
+
+    /** Makes the changes of the instance transaction of the calling thread
+        durable and ends the transaction.
+        @exception CIMException with CIM_ERR_FAILED if the transaction was
+            rolled back after a failed change.  The transaction is ended.
+    */
+    void commitInstanceTransaction();
+
+    /** Discards the changes of the instance transaction of the calling
+        thread and ends the transaction.
+    */
+    void rollbackInstanceTransaction();
+
     /** Get subclass names of the given class in the given namespace.
         @param nameSpaceName
         @param className - class whose subclass names will be gotten. If
@@ -44,10 +44,11 @@
 #include <Pegasus/Common/Dir.h>
 #include <Pegasus/Common/CommonUTF.h>
 #include <Pegasus/Common/ReadWriteSem.h>
+#include <Pegasus/Common/AutoPtr.h>
 #include "InstanceIndexFile.h"
 #include "InstanceDataFile.h"
-#include "AssocInstTable.h"
 #include "FileBasedStore.h"
+#include "RepositorySnapshot.h"
 
 #ifdef PEGASUS_ENABLE_COMPRESSED_REPOSITORY
 // #define win32
@@ -77,6 +78,11 @@ static const Uint32 _MAX_FREE_COUNT = 16;
 #define REPOSITORY_BEGIN_PROGRESS_FILE     "begin.progress";
 #define REPOSITORY_COMMIT_PROGRESS_FILE    "commit.progress";
 #define REPOSITORY_ROLLBACK_PROGRESS_FILE  "rollback.progress";
+#define REPOSITORY_TRANSACTION_PROGRESS_FILE "transaction.progress"
+
+// Suffix of the copy of the instance association file saved by an instance
+// transaction.  It must not match the "*.rollback" pattern.
+static const char _TRANSACTION_SAVE_SUFFIX[] = ".transaction";
 
 //
 // This static variable is used inside "rollbackInstanceTransaction" function
@@ -556,7 +562,8 @@ Boolean FileBasedStore::_completeTransactions()
         String nameSpaceDirName = dir.getName();
         if ((nameSpaceDirName == "..") ||
             (nameSpaceDirName == ".") ||
-            (nameSpaceDirName == _CONFIGFILE_NAME))
+            (nameSpaceDirName == _CONFIGFILE_NAME) ||
+            (nameSpaceDirName == PEGASUS_REPOSITORY_SNAPSHOT_FILE))
         {
             continue;
         }
@@ -587,6 +594,19 @@ Boolean FileBasedStore::_completeTransactions()
         String beginFilePath=dirPath+"/"+REPOSITORY_BEGIN_PROGRESS_FILE;
         String commitFilePath=dirPath+"/"+REPOSITORY_COMMIT_PROGRESS_FILE;
         String rollbackfilePath=dirPath+"/"+REPOSITORY_ROLLBACK_PROGRESS_FILE;
+        String transactionFilePath =
+            dirPath + "/" + REPOSITORY_TRANSACTION_PROGRESS_FILE;
+        String assocFilePath = dirPath + _ASSOCIATIONS_SUFFIX;
+        String assocSavePath = assocFilePath + _TRANSACTION_SAVE_SUFFIX;
+
+        // Read the class names only if a transaction is incomplete.
+        if (!FileSystem::exists(beginFilePath) &&
+            !FileSystem::exists(commitFilePath) &&
+            !FileSystem::exists(rollbackfilePath) &&
+            !FileSystem::exists(transactionFilePath))
+        {
+            continue;
+        }
 
         Array<String> classNames;
 
@@ -609,6 +629,48 @@ Boolean FileBasedStore::_completeTransactions()
             classNames.append(className);
         }
 
+        if (FileSystem::exists(transactionFilePath))
+        {
+            //
+            // An instance transaction was not committed.  Restore every
+            // file pair it changed.  The index rollback file of a pair is
+            // complete before its data rollback file is created, so a pair
+            // without a data rollback file was not changed yet.
+            //
+            for (Uint32 j = 0; j < classNames.size(); j++)
+            {
+                String filePath = dirPath + "/" +
+                    _escapeUtf8FileNameCharacters(classNames[j]);
+                String indexFilePath = filePath + ".idx";
+                String dataFilePath = filePath + ".instances";
+
+                if (FileSystem::existsNoCase(dataFilePath + ".rollback"))
+                {
+                    InstanceIndexFile::rollbackTransaction(indexFilePath);
+
+                    if (!InstanceDataFile::rollbackTransaction(dataFilePath))
+                    {
+                        InstanceDataFile::undoBeginTransaction(dataFilePath);
+                    }
+                }
+                else
+                {
+                    InstanceIndexFile::undoBeginTransaction(indexFilePath);
+                }
+            }
+
+            if (FileSystem::exists(assocSavePath))
+            {
+                FileSystem::renameFile(assocSavePath, assocFilePath);
+            }
+
+            FileSystem::removeFile(commitFilePath);
+            FileSystem::removeFile(transactionFilePath);
+
+            PEG_METHOD_EXIT();
+            return true;
+        }
+
         if(FileSystem::exists(beginFilePath))
         {
             //
@@ -663,6 +725,7 @@ Boolean FileBasedStore::_completeTransactions()
                 InstanceDataFile::commitTransaction(dataFilePath);
             }
 
+            FileSystem::removeFile(assocSavePath);
             FileSystem::removeFile(commitFilePath);
 
             PEG_METHOD_EXIT();
@@ -710,6 +773,11 @@ Boolean FileBasedStore::_completeTransactions()
 //      The appropriate repository write locks must be owned while an
 //      InstanceTransactionHandler instance exists.
 //
+//      If the calling thread has an instance transaction active for the
+//      namespace, the file pair joins that transaction instead.  It is then
+//      committed with the instance transaction, and a failure rolls back
+//      the whole instance transaction.
+//
 //      This algorithm is used to allow recovery on an operation failure:
 //
 //      1.  Check to see if any rollback files exist for instances of the
@@ -739,33 +807,72 @@ class InstanceTransactionHandler
 {
 public:
     InstanceTransactionHandler(
+        FileBasedStore* store,
+        const CIMNamespaceName& nameSpace,
         const String& indexFilePath,
         const String& dataFilePath)
-    : _indexFilePath(indexFilePath),
+    : _store(store),
+      _indexFilePath(indexFilePath),
       _dataFilePath(dataFilePath),
+      _isShared(store->_inInstanceTransaction(nameSpace)),
       _isComplete(false)
     {
-        _rollbackInstanceTransaction(_indexFilePath, _dataFilePath);
-        _beginInstanceTransaction(_indexFilePath, _dataFilePath);
+        if (_isShared)
+        {
+            try
+            {
+                _store->_joinInstanceTransaction(_indexFilePath, _dataFilePath);
+            }
+            catch (...)
+            {
+                _store->_abortInstanceTransaction();
+                throw;
+            }
+        }
+        else
+        {
+            _rollbackInstanceTransaction(_indexFilePath, _dataFilePath);
+            _beginInstanceTransaction(_indexFilePath, _dataFilePath);
+        }
     }
 
     ~InstanceTransactionHandler()
     {
         if (!_isComplete)
         {
-            _rollbackInstanceTransaction(_indexFilePath, _dataFilePath);
+            if (_isShared)
+            {
+                _store->rollbackInstanceTransaction();
+            }
+            else
+            {
+                _rollbackInstanceTransaction(_indexFilePath, _dataFilePath);
+            }
         }
     }
 
+    /**
+        Returns true if the file pair joined an active instance transaction.
+    */
+    Boolean isShared() const
+    {
+        return _isShared;
+    }
+
     void complete()
     {
-        _commitInstanceTransaction(_indexFilePath, _dataFilePath);
+        if (!_isShared)
+        {
+            _commitInstanceTransaction(_indexFilePath, _dataFilePath);
+        }
         _isComplete = true;
     }
 
 private:
+    FileBasedStore* _store;
     String _indexFilePath;
     String _dataFilePath;
+    Boolean _isShared;
     Boolean _isComplete;
 };
 
@@ -792,6 +899,8 @@ FileBasedStore::FileBasedStore(
 #ifdef PEGASUS_ENABLE_COMPRESSED_REPOSITORY
       ,_compressMode(compressMode)
 #endif
+      ,_transactionActive(false),
+      _transactionAssocSaved(false)
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "FileBasedStore::FileBasedStore");
 
@@ -930,7 +1039,8 @@ void FileBasedStore::_rollbackIncompleteTransactions()
         String nameSpaceDirName = dir.getName();
         if ((nameSpaceDirName == "..") ||
             (nameSpaceDirName == ".") ||
-            (nameSpaceDirName == _CONFIGFILE_NAME))
+            (nameSpaceDirName == _CONFIGFILE_NAME) ||
+            (nameSpaceDirName == PEGASUS_REPOSITORY_SNAPSHOT_FILE))
         {
             continue;
         }
@@ -1277,7 +1387,8 @@ Array<NamespaceDefinition> FileBasedStore::enumerateNameSpaces()
         String nameSpaceDirName = dir.getName();
         if ((nameSpaceDirName == "..") ||
             (nameSpaceDirName == ".") ||
-            (nameSpaceDirName == _CONFIGFILE_NAME))
+            (nameSpaceDirName == _CONFIGFILE_NAME) ||
+            (nameSpaceDirName == PEGASUS_REPOSITORY_SNAPSHOT_FILE))
         {
             continue;
         }
@@ -1516,6 +1627,9 @@ void FileBasedStore::modifyNameSpaceName(
 
     String nameSpacePath = _getNameSpaceDirPath(nameSpace);
     String repositoryPath = nameSpacePath;
+
+    _assocInstTable.invalidateCache(_getAssocInstPath(nameSpace));
+
     Uint32 pos = repositoryPath.reverseFind('/');
     repositoryPath.remove(pos+1);
     repositoryPath.append(_namespaceNameToDirName(newNameSpaceName));
@@ -1533,6 +1647,8 @@ void FileBasedStore::deleteNameSpace(const CIMNamespaceName& nameSpace)
 
     String nameSpacePath = _getNameSpaceDirPath(nameSpace);
 
+    _assocInstTable.invalidateCache(_getAssocInstPath(nameSpace));
+
     if (!FileSystem::removeDirectoryHier(nameSpacePath))
     {
         PEG_METHOD_EXIT();
@@ -2021,7 +2137,8 @@ void FileBasedStore::createInstance(
     // failure.
     //
 
-    InstanceTransactionHandler transaction(indexFilePath, dataFilePath);
+    InstanceTransactionHandler transaction(
+        this, nameSpace, indexFilePath, dataFilePath);
 
     //
     // Save instance to file:
@@ -2061,8 +2178,6 @@ void FileBasedStore::createInstance(
                 instanceName.toString()));
     }
 
-    transaction.complete();
-
     //
     // Create association entries if an association instance.
     //
@@ -2072,6 +2187,8 @@ void FileBasedStore::createInstance(
         _addInstanceAssociationEntries(nameSpace, instAssocEntries);
     }
 
+    transaction.complete();
+
     PEG_METHOD_EXIT();
 }
 
@@ -2113,7 +2230,8 @@ void FileBasedStore::modifyInstance(
     // failure.
     //
 
-    InstanceTransactionHandler transaction(indexFilePath, dataFilePath);
+    InstanceTransactionHandler transaction(
+        this, nameSpace, indexFilePath, dataFilePath);
 
     //
     // Modify the data file:
@@ -2160,7 +2278,14 @@ void FileBasedStore::modifyInstance(
 
     if (freeCount >= _MAX_FREE_COUNT)
     {
-        _CompactInstanceRepository(indexFilePath, dataFilePath);
+        if (transaction.isShared())
+        {
+            _deferInstanceCompaction(indexFilePath);
+        }
+        else
+        {
+            _CompactInstanceRepository(indexFilePath, dataFilePath);
+        }
     }
 
     transaction.complete();
@@ -2184,13 +2309,6 @@ void FileBasedStore::deleteInstance(
     String dataFilePath = _getInstanceDataFilePath(
         nameSpace, instanceName.getClassName());
 
-    //
-    // Perform the operation in a transaction scope to enable rollback on
-    // failure.
-    //
-
-    InstanceTransactionHandler transaction(indexFilePath, dataFilePath);
-
     //
     // Lookup instance from the index file (raise error if not found).
     //
@@ -2205,6 +2323,14 @@ void FileBasedStore::deleteInstance(
         throw PEGASUS_CIM_EXCEPTION(CIM_ERR_NOT_FOUND, instanceName.toString());
     }
 
+    //
+    // Perform the operation in a transaction scope to enable rollback on
+    // failure.
+    //
+
+    InstanceTransactionHandler transaction(
+        this, nameSpace, indexFilePath, dataFilePath);
+
     //
     // Remove entry from index file.
     //
@@ -2228,17 +2354,24 @@ void FileBasedStore::deleteInstance(
 
     if (freeCount >= _MAX_FREE_COUNT)
     {
-        _CompactInstanceRepository(indexFilePath, dataFilePath);
+        if (transaction.isShared())
+        {
+            _deferInstanceCompaction(indexFilePath);
+        }
+        else
+        {
+            _CompactInstanceRepository(indexFilePath, dataFilePath);
+        }
     }
 
-    transaction.complete();
-
     //
     // Delete from association table (if an association).
     //
 
     _removeInstanceAssociationEntries(nameSpace, instanceName);
 
+    transaction.complete();
+
     PEG_METHOD_EXIT();
 }
 
@@ -2263,6 +2396,348 @@ Boolean FileBasedStore::instanceExists(
     return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// Instance transactions
+//
+//      An instance transaction applies the instance changes of one thread in
+//      a namespace under a single recovery journal.  While it is active, the
+//      "transaction.progress" state file exists in the instance directory of
+//      the namespace.  Each index and data file pair creates its rollback
+//      files the first time it is changed, and the instance association file
+//      is copied before it is first changed.  The transaction is committed
+//      when the state file is removed; the rollback files and the copy of
+//      the association file are then discarded.  If the state file is found
+//      during initialization, all changed files are restored.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+void FileBasedStore::beginInstanceTransaction(
+    const CIMNamespaceName& nameSpace)
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY,
+        "FileBasedStore::beginInstanceTransaction");
+
+    String stateFilePath = _getNameSpaceDirPath(nameSpace) +
+        _INSTANCES_SUFFIX + "/" + REPOSITORY_TRANSACTION_PROGRESS_FILE;
+
+    AutoMutex lock(_transactionLock);
+
+    PEGASUS_ASSERT(!_transactionActive);
+
+    fstream fs;
+
+    fs.open(stateFilePath.getCString(), ios::out PEGASUS_OR_IOS_BINARY);
+
+    if (!fs)
+    {
+        PEG_METHOD_EXIT();
+        throw PEGASUS_CIM_EXCEPTION_L(CIM_ERR_FAILED,
+            MessageLoaderParms(
+                "Repository.CIMRepository.BEGIN_FAILED",
+                "The attempt to begin the transaction failed."));
+    }
+
+    FileSystem::syncWithDirectoryUpdates(fs);
+    fs.close();
+
+    _transactionActive = true;
+    _transactionThread = Threads::self();
+    _transactionNameSpace = nameSpace;
+    _transactionIndexFilePaths.clear();
+    _transactionDataFilePaths.clear();
+    _transactionCompactFlags.clear();
+    _transactionAssocSaved = false;
+
+    PEG_METHOD_EXIT();
+}
+
+void FileBasedStore::commitInstanceTransaction()
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY,
+        "FileBasedStore::commitInstanceTransaction");
+
+    PEGASUS_ASSERT(_transactionActive);
+
+    String dirPath =
+        _getNameSpaceDirPath(_transactionNameSpace) + _INSTANCES_SUFFIX;
+    String commitFilePath = dirPath + "/" + REPOSITORY_COMMIT_PROGRESS_FILE;
+    String transactionFilePath =
+        dirPath + "/" + REPOSITORY_TRANSACTION_PROGRESS_FILE;
+
+    //
+    // The commit state file makes the removal of the rollback files
+    // complete if it is interrupted after the transaction state file
+    // is removed.
+    //
+
+    fstream fs;
+
+    fs.open(commitFilePath.getCString(), ios::out PEGASUS_OR_IOS_BINARY);
+
+    if (!fs)
+    {
+        _abortInstanceTransaction();
+
+        PEG_METHOD_EXIT();
+        throw PEGASUS_CIM_EXCEPTION_L(CIM_ERR_FAILED,
+            MessageLoaderParms(
+                "Repository.CIMRepository.COMMIT_FAILED",
+                "The commit operation failed."));
+    }
+
+    FileSystem::syncWithDirectoryUpdates(fs);
+    fs.close();
+
+    if (!FileSystem::removeFile(transactionFilePath))
+    {
+        FileSystem::removeFile(commitFilePath);
+        _abortInstanceTransaction();
+
+        PEG_METHOD_EXIT();
+        throw PEGASUS_CIM_EXCEPTION_L(CIM_ERR_FAILED,
+            MessageLoaderParms(
+                "Repository.CIMRepository.COMMIT_FAILED",
+                "The commit operation failed."));
+    }
+
+    //
+    // The transaction is committed.  Discard the rollback files.
+    //
+
+    for (Uint32 i = 0; i < _transactionIndexFilePaths.size(); i++)
+    {
+        InstanceIndexFile::commitTransaction(_transactionIndexFilePaths[i]);
+        InstanceDataFile::commitTransaction(_transactionDataFilePaths[i]);
+    }
+
+    if (_transactionAssocSaved)
+    {
+        FileSystem::removeFile(
+            _getAssocInstPath(_transactionNameSpace) +
+                _TRANSACTION_SAVE_SUFFIX);
+    }
+
+    FileSystem::removeFile(commitFilePath);
+
+    Array<String> indexFilePaths;
+    Array<String> dataFilePaths;
+
+    for (Uint32 i = 0; i < _transactionIndexFilePaths.size(); i++)
+    {
+        if (_transactionCompactFlags[i])
+        {
+            indexFilePaths.append(_transactionIndexFilePaths[i]);
+            dataFilePaths.append(_transactionDataFilePaths[i]);
+        }
+    }
+
+    {
+        AutoMutex lock(_transactionLock);
+        _transactionActive = false;
+    }
+
+    //
+    // Compact the file pairs that reached the free count maximum.  A
+    // failure here does not affect the committed changes; the compaction
+    // is then retried by the next change of the pair.
+    //
+
+    for (Uint32 i = 0; i < indexFilePaths.size(); i++)
+    {
+        try
+        {
+            InstanceTransactionHandler transaction(
+                this, _transactionNameSpace,
+                indexFilePaths[i], dataFilePaths[i]);
+            _CompactInstanceRepository(indexFilePaths[i], dataFilePaths[i]);
+            transaction.complete();
+        }
+        catch (const Exception& e)
+        {
+            PEG_TRACE((TRC_REPOSITORY, Tracer::LEVEL2,
+                "Failed to compact instance files %s: %s",
+                (const char*)indexFilePaths[i].getCString(),
+                (const char*)e.getMessage().getCString()));
+        }
+    }
+
+    PEG_METHOD_EXIT();
+}
+
+void FileBasedStore::rollbackInstanceTransaction()
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY,
+        "FileBasedStore::rollbackInstanceTransaction");
+
+    if (_inInstanceTransaction(_transactionNameSpace))
+    {
+        _abortInstanceTransaction();
+    }
+
+    PEG_METHOD_EXIT();
+}
+
+void FileBasedStore::_abortInstanceTransaction()
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY,
+        "FileBasedStore::_abortInstanceTransaction");
+
+    PEGASUS_ASSERT(_transactionActive);
+
+    // End the transaction first so that a failure to restore a file does
+    // not leave it active.  The state file is kept in that case, and the
+    // restore is completed the next time the repository is initialized.
+
+    {
+        AutoMutex lock(_transactionLock);
+        _transactionActive = false;
+    }
+
+    for (Uint32 i = 0; i < _transactionIndexFilePaths.size(); i++)
+    {
+        _rollbackInstanceTransaction(
+            _transactionIndexFilePaths[i], _transactionDataFilePaths[i]);
+    }
+
+    if (_transactionAssocSaved)
+    {
+        String assocFilePath = _getAssocInstPath(_transactionNameSpace);
+
+        // The association index holds the changes being rolled back.
+        _assocInstTable.invalidateCache(assocFilePath);
+
+        if (!FileSystem::renameFile(
+                assocFilePath + _TRANSACTION_SAVE_SUFFIX, assocFilePath))
+        {
+            PEG_METHOD_EXIT();
+            throw PEGASUS_CIM_EXCEPTION_L(CIM_ERR_FAILED,
+                MessageLoaderParms(
+                    "Repository.CIMRepository.ROLLBACK_FAILED",
+                    "The rollback operation failed."));
+        }
+    }
+
+    FileSystem::removeFile(
+        _getNameSpaceDirPath(_transactionNameSpace) + _INSTANCES_SUFFIX +
+            "/" + REPOSITORY_TRANSACTION_PROGRESS_FILE);
+
+    PEG_METHOD_EXIT();
+}
+
+Boolean FileBasedStore::_inInstanceTransaction(
+    const CIMNamespaceName& nameSpace)
+{
+    AutoMutex lock(_transactionLock);
+
+    return _transactionActive &&
+        Threads::equal(_transactionThread, Threads::self()) &&
+        _transactionNameSpace == nameSpace;
+}
+
+void FileBasedStore::_joinInstanceTransaction(
+    const String& indexFilePath,
+    const String& dataFilePath)
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY,
+        "FileBasedStore::_joinInstanceTransaction");
+
+    for (Uint32 i = 0; i < _transactionIndexFilePaths.size(); i++)
+    {
+        if (_transactionIndexFilePaths[i] == indexFilePath)
+        {
+            PEG_METHOD_EXIT();
+            return;
+        }
+    }
+
+    //
+    // The index rollback file must be complete before the data rollback
+    // file is created; recovery relies on this order.
+    //
+
+    if (!InstanceIndexFile::beginTransaction(indexFilePath))
+    {
+        PEG_METHOD_EXIT();
+        throw PEGASUS_CIM_EXCEPTION_L(CIM_ERR_FAILED,
+            MessageLoaderParms(
+                "Repository.CIMRepository.BEGIN_FAILED",
+                "The attempt to begin the transaction failed."));
+    }
+
+    if (!InstanceDataFile::beginTransaction(dataFilePath))
+    {
+        InstanceIndexFile::undoBeginTransaction(indexFilePath);
+
+        PEG_METHOD_EXIT();
+        throw PEGASUS_CIM_EXCEPTION_L(CIM_ERR_FAILED,
+            MessageLoaderParms(
+                "Repository.CIMRepository.BEGIN_FAILED",
+                "The attempt to begin the transaction failed."));
+    }
+
+    _transactionIndexFilePaths.append(indexFilePath);
+    _transactionDataFilePaths.append(dataFilePath);
+    _transactionCompactFlags.append(false);
+
+    PEG_METHOD_EXIT();
+}
+
+void FileBasedStore::_saveInstanceAssociationFile()
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY,
+        "FileBasedStore::_saveInstanceAssociationFile");
+
+    if (_transactionAssocSaved)
+    {
+        PEG_METHOD_EXIT();
+        return;
+    }
+
+    String assocFilePath = _getAssocInstPath(_transactionNameSpace);
+    String savePath = assocFilePath + _TRANSACTION_SAVE_SUFFIX;
+    Boolean saved;
+
+    if (FileSystem::exists(assocFilePath))
+    {
+        saved = FileSystem::copyFile(assocFilePath, savePath);
+    }
+    else
+    {
+        // An empty association file is equivalent to a missing one
+        fstream fs;
+        fs.open(savePath.getCString(), ios::out PEGASUS_OR_IOS_BINARY);
+        saved = !!fs;
+    }
+
+    if (!saved)
+    {
+        FileSystem::removeFile(savePath);
+
+        PEG_METHOD_EXIT();
+        throw PEGASUS_CIM_EXCEPTION_L(CIM_ERR_FAILED,
+            MessageLoaderParms(
+                "Repository.CIMRepository.BEGIN_FAILED",
+                "The attempt to begin the transaction failed."));
+    }
+
+    _transactionAssocSaved = true;
+
+    PEG_METHOD_EXIT();
+}
+
+void FileBasedStore::_deferInstanceCompaction(const String& indexFilePath)
+{
+    for (Uint32 i = 0; i < _transactionIndexFilePaths.size(); i++)
+    {
+        if (_transactionIndexFilePaths[i] == indexFilePath)
+        {
+            _transactionCompactFlags[i] = true;
+            return;
+        }
+    }
+}
+
 void FileBasedStore::_addClassAssociationEntries(
     const CIMNamespaceName& nameSpace,
     const Array<ClassAssociation>& classAssocEntries)
@@ -2359,6 +2834,11 @@ void FileBasedStore::_addInstanceAssociationEntries(
     PEG_METHOD_ENTER(TRC_REPOSITORY,
         "FileBasedStore::_addInstanceAssociationEntries");
 
+    if (_inInstanceTransaction(nameSpace))
+    {
+        _saveInstanceAssociationFile();
+    }
+
     String assocFileName = _getAssocInstPath(nameSpace);
     PEGASUS_STD(ofstream) os;
 
@@ -2370,16 +2850,7 @@ void FileBasedStore::_addInstanceAssociationEntries(
 
     for (Uint32 i = 0; i < instanceAssocEntries.size(); i++)
     {
-        AssocInstTable::append(
-            os,
-            instanceAssocEntries[i].assocInstanceName,
-            instanceAssocEntries[i].assocClassName,
-            instanceAssocEntries[i].fromInstanceName,
-            instanceAssocEntries[i].fromClassName,
-            instanceAssocEntries[i].fromPropertyName,
-            instanceAssocEntries[i].toInstanceName,
-            instanceAssocEntries[i].toClassName,
-            instanceAssocEntries[i].toPropertyName);
+        _assocInstTable.append(os, assocFileName, instanceAssocEntries[i]);
     }
 
     PEG_METHOD_EXIT();
@@ -2392,8 +2863,13 @@ void FileBasedStore::_removeInstanceAssociationEntries(
     PEG_METHOD_ENTER(TRC_REPOSITORY,
         "FileBasedStore::_removeInstanceAssociationEntries");
 
+    if (_inInstanceTransaction(nameSpace))
+    {
+        _saveInstanceAssociationFile();
+    }
+
     String assocFileName = _getAssocInstPath(nameSpace);
-    AssocInstTable::deleteAssociation(assocFileName, assocInstanceName);
+    _assocInstTable.deleteAssociation(assocFileName, assocInstanceName);
 
     PEG_METHOD_EXIT();
 }
@@ -2413,7 +2889,7 @@ void FileBasedStore::getInstanceAssociatorNames(
     String assocFileName = _getAssocInstPath(nameSpace);
 
     // ATTN: Return value is ignored.
-    AssocInstTable::getAssociatorNames(
+    _assocInstTable.getAssociatorNames(
         assocFileName,
         instanceName,
         assocClassList,
@@ -2438,7 +2914,7 @@ void FileBasedStore::getInstanceReferenceNames(
     String assocFileName = _getAssocInstPath(nameSpace);
 
     // ATTN: Return value is ignored.
-    AssocInstTable::getReferenceNames(
+    _assocInstTable.getReferenceNames(
         assocFileName,
         instanceName,
         resultClassList,
@@ -34,9 +34,12 @@
 
 #include <Pegasus/Common/Config.h>
 #include <Pegasus/Common/HashTable.h>
+#include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/Threads.h>
 #include <Pegasus/Repository/PersistentStore.h>
 #include <Pegasus/Repository/PersistentStoreData.h>
 #include <Pegasus/Repository/AssocClassTable.h>
+#include <Pegasus/Repository/AssocInstTable.h>
 #include <Pegasus/Repository/Linkage.h>
 
 PEGASUS_NAMESPACE_BEGIN
@@ -167,6 +170,10 @@ public:
         const CIMNamespaceName& nameSpace,
         const CIMObjectPath& instanceName);
 
+    void beginInstanceTransaction(const CIMNamespaceName& nameSpace);
+    void commitInstanceTransaction();
+    void rollbackInstanceTransaction();
+
     void getClassAssociatorNames(
         const CIMNamespaceName& nameSpace,
         const Array<CIMName>& classList,
@@ -199,6 +206,8 @@ public:
 
 private:
 
+    friend class InstanceTransactionHandler;
+
     void _rollbackIncompleteTransactions();
 
     /**
@@ -322,6 +331,39 @@ private:
     void _SaveObject(const String& path,
         Buffer& objectXml);
 
+    /**
+        Returns true if the calling thread has an instance transaction
+        active for the specified namespace.
+    */
+    Boolean _inInstanceTransaction(const CIMNamespaceName& nameSpace);
+
+    /**
+        Adds an index and data file pair to the active instance transaction.
+        The rollback files of the pair are created the first time it is
+        changed within the transaction.
+    */
+    void _joinInstanceTransaction(
+        const String& indexFilePath,
+        const String& dataFilePath);
+
+    /**
+        Saves a copy of the instance association file of the active instance
+        transaction before it is first changed within the transaction.
+    */
+    void _saveInstanceAssociationFile();
+
+    /**
+        Defers the compaction of a joined index and data file pair until the
+        active instance transaction is committed.  The data file of a pair
+        must only grow within the transaction so that it can be rolled back.
+    */
+    void _deferInstanceCompaction(const String& indexFilePath);
+
+    /**
+        Discards the changes of the active instance transaction and ends it.
+    */
+    void _abortInstanceTransaction();
+
     String _repositoryPath;
     ObjectStreamer* _streamer;
 #ifdef PEGASUS_ENABLE_COMPRESSED_REPOSITORY
@@ -341,6 +383,25 @@ private:
         storage and lookup.
     */
     AssocClassTable _assocClassTable;
+
+    /**
+        Like the class association table, this table caches the instance
+        association data of the namespaces it has searched.
+    */
+    AssocInstTable _assocInstTable;
+
+    /**
+        State of the active instance transaction.  The index and data file
+        arrays list the file pairs changed within the transaction.
+    */
+    Mutex _transactionLock;
+    Boolean _transactionActive;
+    ThreadType _transactionThread;
+    CIMNamespaceName _transactionNameSpace;
+    Array<String> _transactionIndexFilePaths;
+    Array<String> _transactionDataFilePaths;
+    Array<Boolean> _transactionCompactFlags;
+    Boolean _transactionAssocSaved;
 };
 
 PEGASUS_NAMESPACE_END
@@ -32,6 +32,7 @@
 #include <Pegasus/Common/String.h>
 #include <Pegasus/Common/HashTable.h>
 #include <Pegasus/Common/CIMNameCast.h>
+#include <Pegasus/Common/CIMNameInterner.h>
 #include "InheritanceTree.h"
 
 #if 0
@@ -259,12 +260,27 @@ InheritanceTree::~InheritanceTree()
 
     delete _rep;
 }
+
+// Interns the names of a class inserted into the tree. The table keys then
+// share the representation of the interned names of requests (see
+// CIMOperationRequestDispatcher), and looking those up neither hashes nor
+// compares the characters of the names.
+static inline void _internNames(String& className, String& superClassName)
+{
+    CIMNameInterner::intern(className);
+    CIMNameInterner::intern(superClassName);
+}
+
 void InheritanceTree::insert(
-    const String& className,
-    const String& superClassName,
+    const String& className_,
+    const String& superClassName_,
     InheritanceTree& parentTree,
     NameSpace* tag)
 {
+    String className(className_);
+    String superClassName(superClassName_);
+    _internNames(className, superClassName);
+
     InheritanceTreeNode* superClassNode = 0;
 
     if (superClassName.size() &&
@@ -304,9 +320,13 @@ void InheritanceTree::insert(
 }
 
 void InheritanceTree::insert(
-    const String& className,
-    const String& superClassName)
+    const String& className_,
+    const String& superClassName_)
 {
+    String className(className_);
+    String superClassName(superClassName_);
+    _internNames(className, superClassName);
+
     // ATTN: need found flag!
 
     // -- Insert superclass:
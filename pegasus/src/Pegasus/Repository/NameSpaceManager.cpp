@@ -30,6 +30,7 @@
 //%/////////////////////////////////////////////////////////////////////////////
 
 #include <Pegasus/Common/HashTable.h>
+#include <Pegasus/Common/CIMNameInterner.h>
 #include <Pegasus/Common/Tracer.h>
 #include <Pegasus/Common/MessageLoader.h>
 #include <Pegasus/Common/Pair.h>
@@ -274,7 +275,7 @@ void NameSpaceManager::initializeNameSpace(
     }
 
     _rep->table.insert(
-        nameSpace.name.getString(),
+        CIMNameInterner::intern(nameSpace.name).getString(),
         new NameSpace(
             nameSpace.name.getString(),
             nameSpace.shareable,
@@ -361,7 +362,8 @@ void NameSpaceManager::createNameSpace(
         remoteInfo,
         Array<Pair<String, String> >());
 
-    _rep->table.insert(nameSpaceName.getString(), nameSpace);
+    _rep->table.insert(
+        CIMNameInterner::intern(nameSpaceName).getString(), nameSpace);
 
     PEG_METHOD_EXIT();
 }
@@ -392,7 +394,8 @@ void NameSpaceManager::modifyNameSpaceName(
         true,
         _rep->table.remove(nameSpaceName.getString()));
     nameSpace->modifyName(newNameSpaceName);
-    _rep->table.insert(newNameSpaceName.getString(), nameSpace);
+    _rep->table.insert(
+        CIMNameInterner::intern(newNameSpaceName).getString(), nameSpace);
 
     PEG_METHOD_EXIT();
 }
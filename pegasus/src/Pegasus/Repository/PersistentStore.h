@@ -162,6 +162,29 @@ public:
         const CIMNamespaceName& nameSpace,
         const CIMObjectPath& instanceName) = 0;
 
+    /**
+        Begins an instance transaction for the specified namespace on behalf
+        of the calling thread.  The instance changes this thread makes in the
+        namespace are applied under a single recovery journal and become
+        durable together when commitInstanceTransaction() is called.  If the
+        store fails to apply a change, the whole transaction is rolled back
+        and ended before the exception is thrown.  Only one instance
+        transaction may be active at a time.  The caller must hold the
+        repository locks that exclude other writers of the namespace.
+    */
+    virtual void beginInstanceTransaction(
+        const CIMNamespaceName& nameSpace) = 0;
+    /**
+        Makes the changes of the active instance transaction durable and
+        ends the transaction.
+    */
+    virtual void commitInstanceTransaction() = 0;
+    /**
+        Discards the changes of the active instance transaction and ends the
+        transaction.  Has no effect if no transaction is active.
+    */
+    virtual void rollbackInstanceTransaction() = 0;
+
     virtual void getClassAssociatorNames(
         const CIMNamespaceName& nameSpace,
         const Array<CIMName>& classList,
@@ -0,0 +1,364 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/FileSystem.h>
+#include <Pegasus/Common/System.h>
+#include <Pegasus/Common/Tracer.h>
+#include <Pegasus/Common/InternalException.h>
+#include "Packer.h"
+#include "RepositorySnapshot.h"
+
+PEGASUS_NAMESPACE_BEGIN
+
+//
+// Snapshot file layout, packed by the Packer:
+//
+//     header:   eye catcher (8 bytes), Uint32 version, Uint32 length and
+//               Uint32 checksum of the contents
+//     contents: Uint32 namespace count, then for each namespace its name,
+//               Boolean shareable, Boolean updatesAllowed, parent name,
+//               remote info, Uint32 length of the class list, Uint32 class
+//               count and the class and superclass names.
+//
+// The version must be incremented when the layout changes.
+//
+
+static const char _EYE_CATCHER[] = "PEGRSNAP";
+static const Uint32 _EYE_CATCHER_SIZE = 8;
+static const Uint32 _VERSION = 1;
+static const Uint32 _HEADER_SIZE = _EYE_CATCHER_SIZE + 3 * sizeof(Uint32);
+
+// FNV-1a hash of the snapshot contents.
+static Uint32 _checksum(const char* data, Uint32 size)
+{
+    Uint32 hash = 2166136261U;
+
+    for (Uint32 i = 0; i < size; i++)
+    {
+        hash ^= Uint8(data[i]);
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+RepositorySnapshot::RepositorySnapshot(const String& repositoryRoot)
+    : _path(repositoryRoot + "/" + PEGASUS_REPOSITORY_SNAPSHOT_FILE)
+{
+}
+
+RepositorySnapshot::~RepositorySnapshot()
+{
+}
+
+Boolean RepositorySnapshot::load()
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY, "RepositorySnapshot::load");
+
+    clear();
+
+    if (!FileSystem::exists(_path))
+    {
+        PEG_METHOD_EXIT();
+        return false;
+    }
+
+    Buffer file;
+
+    try
+    {
+        FileSystem::loadFileToMemory(file, _path);
+    }
+    catch (const CannotOpenFile&)
+    {
+        PEG_TRACE((TRC_REPOSITORY, Tracer::LEVEL2,
+            "Cannot open repository snapshot %s",
+            (const char*)_path.getCString()));
+        PEG_METHOD_EXIT();
+        return false;
+    }
+
+    Uint32 version = 0;
+    Uint32 length = 0;
+    Uint32 checksum = 0;
+
+    if (file.size() >= _HEADER_SIZE &&
+        memcmp(file.getData(), _EYE_CATCHER, _EYE_CATCHER_SIZE) == 0)
+    {
+        Uint32 pos = _EYE_CATCHER_SIZE;
+        Packer::unpackUint32(file, pos, version);
+        Packer::unpackUint32(file, pos, length);
+        Packer::unpackUint32(file, pos, checksum);
+    }
+
+    if (version != _VERSION ||
+        length != file.size() - _HEADER_SIZE ||
+        checksum != _checksum(file.getData() + _HEADER_SIZE, length))
+    {
+        PEG_TRACE((TRC_REPOSITORY, Tracer::LEVEL2,
+            "Repository snapshot %s ignored: version %u, length %u, "
+                "file size %u",
+            (const char*)_path.getCString(),
+            version,
+            length,
+            file.size()));
+        PEG_METHOD_EXIT();
+        return false;
+    }
+
+    _data.append(file.getData() + _HEADER_SIZE, length);
+
+    if (!_parse())
+    {
+        PEG_TRACE((TRC_REPOSITORY, Tracer::LEVEL1,
+            "Repository snapshot %s ignored: invalid contents",
+            (const char*)_path.getCString()));
+        clear();
+        PEG_METHOD_EXIT();
+        return false;
+    }
+
+    PEG_TRACE((TRC_REPOSITORY, Tracer::LEVEL3,
+        "Loaded repository snapshot %s: %u namespaces",
+        (const char*)_path.getCString(),
+        _nameSpaces.size()));
+
+    PEG_METHOD_EXIT();
+    return true;
+}
+
+Boolean RepositorySnapshot::_parse()
+{
+    Uint32 pos = 0;
+    Uint32 count;
+    Packer::unpackUint32(_data, pos, count);
+
+    for (Uint32 i = 0; i < count; i++)
+    {
+        if (pos >= _data.size())
+        {
+            return false;
+        }
+
+        String name;
+        Boolean shareable;
+        Boolean updatesAllowed;
+        String parent;
+        String remoteInfo;
+        Uint32 classListLength;
+
+        Packer::unpackString(_data, pos, name);
+        Packer::unpackBoolean(_data, pos, shareable);
+        Packer::unpackBoolean(_data, pos, updatesAllowed);
+        Packer::unpackString(_data, pos, parent);
+        Packer::unpackString(_data, pos, remoteInfo);
+        Packer::unpackUint32(_data, pos, classListLength);
+
+        if (pos > _data.size() || classListLength > _data.size() - pos ||
+            !CIMNamespaceName::legal(name) ||
+            (parent.size() && !CIMNamespaceName::legal(parent)))
+        {
+            return false;
+        }
+
+        NamespaceDefinition nameSpace(name);
+        nameSpace.shareable = shareable;
+        nameSpace.updatesAllowed = updatesAllowed;
+        nameSpace.remoteInfo = remoteInfo;
+
+        if (parent.size())
+        {
+            // The parent namespace must be initialized first.
+            Boolean found = false;
+            for (Uint32 j = 0; j < _nameSpaces.size() && !found; j++)
+            {
+                found = _nameSpaces[j].name == parent;
+            }
+            if (!found)
+            {
+                return false;
+            }
+            nameSpace.parentNameSpace = parent;
+        }
+
+        _nameSpaces.append(nameSpace);
+        _classListPositions.append(pos);
+        pos += classListLength;
+    }
+
+    return pos == _data.size();
+}
+
+Array<Pair<String, String> > RepositorySnapshot::getClassNames(
+    Uint32 index) const
+{
+    Array<Pair<String, String> > classList;
+
+    Uint32 pos = _classListPositions[index];
+    Uint32 count;
+    Packer::unpackUint32(_data, pos, count);
+    classList.reserveCapacity(count);
+
+    for (Uint32 i = 0; i < count; i++)
+    {
+        String className;
+        String superClassName;
+        Packer::unpackString(_data, pos, className);
+        Packer::unpackString(_data, pos, superClassName);
+        classList.append(Pair<String, String>(className, superClassName));
+    }
+
+    return classList;
+}
+
+void RepositorySnapshot::addNameSpace(
+    const NamespaceDefinition& nameSpace,
+    const Array<Pair<String, String> >& classList)
+{
+    if (_data.size() == 0)
+    {
+        // Placeholder for the namespace count
+        Packer::packUint32(_data, 0);
+    }
+
+    Packer::packString(_data, nameSpace.name.getString());
+    Packer::packBoolean(_data, nameSpace.shareable);
+    Packer::packBoolean(_data, nameSpace.updatesAllowed);
+    Packer::packString(_data, nameSpace.parentNameSpace.getString());
+    Packer::packString(_data, nameSpace.remoteInfo);
+
+    Uint32 lengthPos = _data.size();
+    Packer::packUint32(_data, 0);
+    Uint32 classListPos = _data.size();
+
+    Packer::packUint32(_data, classList.size());
+    for (Uint32 i = 0; i < classList.size(); i++)
+    {
+        Packer::packString(_data, classList[i].first);
+        Packer::packString(_data, classList[i].second);
+    }
+
+    Buffer length;
+    Packer::packUint32(length, _data.size() - classListPos);
+    memcpy((char*)_data.getData() + lengthPos, length.getData(),
+        sizeof(Uint32));
+
+    _nameSpaces.append(nameSpace);
+    _classListPositions.append(classListPos);
+}
+
+Boolean RepositorySnapshot::save()
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY, "RepositorySnapshot::save");
+
+    if (_data.size() == 0)
+    {
+        Packer::packUint32(_data, 0);
+    }
+    else
+    {
+        Buffer count;
+        Packer::packUint32(count, _nameSpaces.size());
+        memcpy((char*)_data.getData(), count.getData(), sizeof(Uint32));
+    }
+
+    Buffer header;
+    header.append(_EYE_CATCHER, _EYE_CATCHER_SIZE);
+    Packer::packUint32(header, _VERSION);
+    Packer::packUint32(header, _data.size());
+    Packer::packUint32(header, _checksum(_data.getData(), _data.size()));
+
+    // Write to a file name of this process, then replace the snapshot.
+    char pid[32];
+    sprintf(pid, ".%u", (Uint32)System::getPID());
+    String tmpPath = _path + pid;
+
+    Boolean written = false;
+    FILE* fp = fopen(tmpPath.getCString(), "wb");
+    if (fp)
+    {
+        written =
+            fwrite(header.getData(), 1, header.size(), fp) == header.size() &&
+            fwrite(_data.getData(), 1, _data.size(), fp) == _data.size();
+        written = (fclose(fp) == 0) && written;
+
+        if (written)
+        {
+            written = FileSystem::renameFile(tmpPath, _path);
+        }
+
+        if (!written)
+        {
+            FileSystem::removeFile(tmpPath);
+        }
+    }
+
+    if (written)
+    {
+        PEG_TRACE((TRC_REPOSITORY, Tracer::LEVEL3,
+            "Saved repository snapshot %s: %u namespaces",
+            (const char*)_path.getCString(),
+            _nameSpaces.size()));
+    }
+    else
+    {
+        PEG_TRACE((TRC_REPOSITORY, Tracer::LEVEL2,
+            "Cannot write repository snapshot %s",
+            (const char*)_path.getCString()));
+    }
+
+    PEG_METHOD_EXIT();
+    return written;
+}
+
+void RepositorySnapshot::invalidate()
+{
+    clear();
+
+    if (FileSystem::exists(_path) && !FileSystem::removeFile(_path))
+    {
+        PEG_TRACE((TRC_REPOSITORY, Tracer::LEVEL1,
+            "Cannot remove repository snapshot %s",
+            (const char*)_path.getCString()));
+    }
+}
+
+void RepositorySnapshot::clear()
+{
+    _data.clear();
+    _nameSpaces.clear();
+    _classListPositions.clear();
+}
+
+PEGASUS_NAMESPACE_END
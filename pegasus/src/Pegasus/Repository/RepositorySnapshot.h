@@ -0,0 +1,141 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+#ifndef Pegasus_RepositorySnapshot_h
+#define Pegasus_RepositorySnapshot_h
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/String.h>
+#include <Pegasus/Common/Buffer.h>
+#include <Pegasus/Common/Pair.h>
+#include <Pegasus/Common/ArrayInternal.h>
+#include <Pegasus/Repository/PersistentStoreData.h>
+#include <Pegasus/Repository/Linkage.h>
+
+PEGASUS_NAMESPACE_BEGIN
+
+// Name of the snapshot file in the repository root directory.  Like the
+// repository config file name it contains a '.', so it cannot collide with
+// a namespace directory name.
+#define PEGASUS_REPOSITORY_SNAPSHOT_FILE "repository.snapshot"
+
+/** A RepositorySnapshot is a copy of the namespace definitions and the
+    class/superclass names of all namespaces, saved in a single file in the
+    repository root directory.  On startup the CIMRepository initializes
+    the NameSpaceManager from the snapshot instead of enumerating the
+    namespaces and classes of the persistent store, which for the file
+    based store means reading every classes directory.
+
+    The snapshot is a copy of the persistent store, not a replacement for
+    it: it is saved after the NameSpaceManager was initialized from the
+    persistent store and is removed before any change of namespaces or
+    classes.  The file starts with a header holding an eye catcher, the
+    format version, the length and a checksum of the contents; a snapshot
+    that does not match is ignored.
+*/
+class PEGASUS_REPOSITORY_LINKAGE RepositorySnapshot
+{
+public:
+
+    /** Constructor.
+        @param repositoryRoot The repository root directory.
+    */
+    RepositorySnapshot(const String& repositoryRoot);
+
+    ~RepositorySnapshot();
+
+    /** Reads the snapshot file.
+        @return true if a valid snapshot was read.  The namespaces are then
+            available from getNameSpaces() in the order in which they were
+            added, parent namespaces before their dependents.
+    */
+    Boolean load();
+
+    /** Gets the namespace definitions of a loaded snapshot.
+    */
+    const Array<NamespaceDefinition>& getNameSpaces() const
+    {
+        return _nameSpaces;
+    }
+
+    /** Gets the class and superclass names of a namespace of a loaded
+        snapshot, in the format returned by
+        PersistentStore::enumerateClassNames().
+        @param index The index of the namespace in getNameSpaces().
+    */
+    Array<Pair<String, String> > getClassNames(Uint32 index) const;
+
+    /** Adds a namespace to the snapshot to be saved.  Namespaces must be
+        added in initialization order, parent namespaces first.
+    */
+    void addNameSpace(
+        const NamespaceDefinition& nameSpace,
+        const Array<Pair<String, String> >& classList);
+
+    /** Writes the added namespaces to the snapshot file.  The file is
+        written under a temporary name and then renamed, so a concurrent
+        load() never reads a partially written snapshot.
+        @return true if the snapshot file was written.
+    */
+    Boolean save();
+
+    /** Removes the snapshot file.  Called before a change of the
+        namespaces or classes in the persistent store.
+    */
+    void invalidate();
+
+    /** Releases the loaded or added namespaces.
+    */
+    void clear();
+
+private:
+
+    RepositorySnapshot(const RepositorySnapshot&);
+    RepositorySnapshot& operator=(const RepositorySnapshot&);
+
+    // Parses the contents of _data.  Returns false if it is not valid.
+    Boolean _parse();
+
+    String _path;
+
+    // The snapshot file contents, header excluded.
+    Buffer _data;
+
+    // Loaded namespaces and the positions of their class lists in _data.
+    Array<NamespaceDefinition> _nameSpaces;
+    Array<Uint32> _classListPositions;
+};
+
+PEGASUS_NAMESPACE_END
+
+#endif /* Pegasus_RepositorySnapshot_h */
@@ -33,6 +33,7 @@
 #include <Pegasus/Common/CIMNameCast.h>
 #include <cctype>
 #include <cstdio>
+#include <cstring>
 
 #include <Pegasus/Common/InternalException.h>
 #include <Pegasus/Common/DeclContext.h>
@@ -75,6 +76,85 @@ struct FinalizeSQLiteStatement
     }
 };
 
+struct ResetSQLiteStatement
+{
+    void operator()(sqlite3_stmt* stmt)
+    {
+        // A cached statement is reset rather than finalized, which ends its
+        // read of the database and drops the values bound to it.
+        if (stmt)
+        {
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+        }
+    }
+};
+
+// Size optimization:  Keep the exception throwing logic in a function so it
+// does not get replicated with each error check.
+static void _throwSQLiteOperationException(sqlite3* db)
+{
+    throw Exception(MessageLoaderParms(
+        "Repository.SQLiteStore.DB_OP_ERROR",
+        "Repository SQLite database operation failed with error $0: $1",
+        sqlite3_errcode(db),
+        String((const Char16*)sqlite3_errmsg16(db))));
+}
+
+inline void CHECK_RC_OK(int rc, sqlite3* db)
+{
+    if (rc != SQLITE_OK)
+    {
+        _throwSQLiteOperationException(db);
+    }
+}
+
+inline void CHECK_RC_DONE(int rc, sqlite3* db)
+{
+    if (rc != SQLITE_DONE)
+    {
+        _throwSQLiteOperationException(db);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// DbHandle
+//
+///////////////////////////////////////////////////////////////////////////////
+
+DbHandle::~DbHandle()
+{
+    for (Uint32 i = 0; i < _statements.size(); i++)
+    {
+        sqlite3_finalize(_statements[i]);
+    }
+
+    int rc = sqlite3_close(_db);
+
+    // It is expected that all uncached prepared statements are finalized.
+    PEGASUS_ASSERT(rc == SQLITE_OK);
+}
+
+sqlite3_stmt* DbHandle::getStatement(const char* sqlStatement)
+{
+    // A statement prepared with sqlite3_prepare_v2() keeps a copy of its
+    // SQL text, which serves as the cache key.
+    for (Uint32 i = 0; i < _statements.size(); i++)
+    {
+        if (strcmp(sqlite3_sql(_statements[i]), sqlStatement) == 0)
+        {
+            return _statements[i];
+        }
+    }
+
+    sqlite3_stmt* stmt = 0;
+    CHECK_RC_OK(sqlite3_prepare_v2(_db, sqlStatement, -1, &stmt, 0), _db);
+    _statements.append(stmt);
+    return stmt;
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -84,15 +164,26 @@ struct FinalizeSQLiteStatement
 
 static const Uint32 MAX_CONNECTION_CACHE_SIZE = 4;
 
+// Time a connection waits for a concurrent writer of the same namespace
+// database (in this or another process) before SQLITE_BUSY is returned
+static const int DB_BUSY_TIMEOUT_MSEC = 30000;
+
+// Suffixes of the write-ahead log and its shared-memory index, which SQLite
+// keeps next to a database file in WAL mode
+static const char* DB_SIDE_FILE_SUFFIXES[] = { "-wal", "-shm" };
+
 DbConnectionManager::~DbConnectionManager()
 {
+    rollbackTransaction();
+
     for (Uint32 i = 0; i < _cache.size(); i++)
     {
-        sqlite3_close(_cache[i].db);
+        delete _cache[i].db;
     }
 }
 
-sqlite3* DbConnectionManager::getDbConnection(const CIMNamespaceName& nameSpace)
+DbHandle* DbConnectionManager::getDbConnection(
+    const CIMNamespaceName& nameSpace)
 {
     AutoMutex lock(_cacheLock);
 
@@ -102,7 +193,7 @@ sqlite3* DbConnectionManager::getDbConnection(const CIMNamespaceName& nameSpace)
     {
         if (_cache[i].nameSpace == nameSpace)
         {
-            sqlite3* db = _cache[i].db;
+            DbHandle* db = _cache[i].db;
             _cache.remove(i);
             return db;
         }
@@ -110,12 +201,12 @@ sqlite3* DbConnectionManager::getDbConnection(const CIMNamespaceName& nameSpace)
 
     // Create a database connection handle for this namespace
 
-    return openDb(getDbPath(nameSpace).getCString());
+    return new DbHandle(openDb(getDbPath(nameSpace).getCString()));
 }
 
 void DbConnectionManager::cacheDbConnection(
     const CIMNamespaceName& nameSpace,
-    sqlite3* db)
+    DbHandle* db)
 {
     AutoMutex lock(_cacheLock);
 
@@ -123,17 +214,87 @@ void DbConnectionManager::cacheDbConnection(
 
     if (_cache.size() == MAX_CONNECTION_CACHE_SIZE)
     {
-        int rc = sqlite3_close(_cache[0].db);
-
-        // It is expected that all prepared statements are finalized.
-        PEGASUS_ASSERT(rc == SQLITE_OK);
-
+        delete _cache[0].db;
         _cache.remove(0);
     }
 
     _cache.append(CacheEntry(nameSpace, db));
 }
 
+void DbConnectionManager::closeDbConnections(
+    const CIMNamespaceName& nameSpace)
+{
+    AutoMutex lock(_cacheLock);
+
+    for (Uint32 i = _cache.size(); i > 0; i--)
+    {
+        if (_cache[i - 1].nameSpace == nameSpace)
+        {
+            delete _cache[i - 1].db;
+            _cache.remove(i - 1);
+        }
+    }
+}
+
+void DbConnectionManager::setTransactionConnection(
+    const CIMNamespaceName& nameSpace,
+    DbHandle* db)
+{
+    AutoMutex lock(_cacheLock);
+
+    PEGASUS_ASSERT(!_transactionDb);
+
+    _transactionNameSpace = nameSpace;
+    _transactionDb = db;
+    _transactionThread = Threads::self();
+}
+
+DbHandle* DbConnectionManager::getTransactionConnection(
+    const CIMNamespaceName& nameSpace)
+{
+    AutoMutex lock(_cacheLock);
+
+    if (_transactionDb &&
+        Threads::equal(_transactionThread, Threads::self()) &&
+        _transactionNameSpace == nameSpace)
+    {
+        return _transactionDb;
+    }
+
+    return 0;
+}
+
+DbHandle* DbConnectionManager::removeTransactionConnection(
+    CIMNamespaceName& nameSpace)
+{
+    AutoMutex lock(_cacheLock);
+
+    if (!_transactionDb ||
+        !Threads::equal(_transactionThread, Threads::self()))
+    {
+        return 0;
+    }
+
+    DbHandle* db = _transactionDb;
+    nameSpace = _transactionNameSpace;
+    _transactionDb = 0;
+    return db;
+}
+
+void DbConnectionManager::rollbackTransaction()
+{
+    CIMNamespaceName nameSpace;
+    DbHandle* db = removeTransactionConnection(nameSpace);
+
+    if (db)
+    {
+        // Statements of the failed operation may still be active, so the
+        // connection is closed rather than cached.
+        sqlite3_exec(db->get(), "ROLLBACK;", 0, 0, 0);
+        delete db;
+    }
+}
+
 String DbConnectionManager::getDbPath(const CIMNamespaceName& nameSpace)
 {
     String dbFileName = nameSpace.getString();
@@ -150,6 +311,20 @@ String DbConnectionManager::getDbPath(const CIMNamespaceName& nameSpace)
     return _repositoryRoot + "/" + escapeStringEncoder(dbFileName) + ".db";
 }
 
+Array<String> DbConnectionManager::getDbSideFilePaths(const String& dbPath)
+{
+    Array<String> paths;
+
+    for (Uint32 i = 0;
+         i < sizeof(DB_SIDE_FILE_SUFFIXES) / sizeof(DB_SIDE_FILE_SUFFIXES[0]);
+         i++)
+    {
+        paths.append(dbPath + DB_SIDE_FILE_SUFFIXES[i]);
+    }
+
+    return paths;
+}
+
 sqlite3* DbConnectionManager::openDb(const char* fileName)
 {
     sqlite3* db;
@@ -164,6 +339,15 @@ sqlite3* DbConnectionManager::openDb(const char* fileName)
             fileName));
     }
 
+    sqlite3_busy_timeout(db, DB_BUSY_TIMEOUT_MSEC);
+
+    // In WAL mode a commit appends to the log without syncing, and the log
+    // is synced when it is checkpointed into the database file.  A commit
+    // remains atomic, though the most recent ones may be lost on a power
+    // failure.  The setting is per connection and is ignored in case of an
+    // error, as it affects only performance.
+    sqlite3_exec(db, "PRAGMA synchronous=NORMAL;", 0, 0, 0);
+
     return db;
 }
 
@@ -180,6 +364,10 @@ sqlite3* DbConnectionManager::openDb(const char* fileName)
     connection and when an error occurs and caching it for reuse otherwise.
     The release() method must be called before the object is destructed to
     allow the connection to be reused.
+
+    If the calling thread has an instance transaction active for the
+    namespace, the connection of that transaction is shared.  An error then
+    rolls back the whole instance transaction.
 */
 class DbConnection
 {
@@ -188,35 +376,64 @@ public:
         : _dbcm(dbcm),
           _nameSpace(nameSpace)
     {
-        _db = _dbcm.getDbConnection(nameSpace);
+        _db = _dbcm.getTransactionConnection(nameSpace);
+        _isShared = (_db != 0);
+
+        if (!_isShared)
+        {
+            _db = _dbcm.getDbConnection(nameSpace);
+        }
     }
 
     ~DbConnection()
     {
         if (_db)
         {
-            int rc = sqlite3_close(_db);
-
-            // It is expected that all prepared statements are finalized.
-            PEGASUS_ASSERT(rc == SQLITE_OK);
+            if (_isShared)
+            {
+                _dbcm.rollbackTransaction();
+            }
+            else
+            {
+                delete _db;
+            }
         }
     }
 
     sqlite3* get()
     {
-        return _db;
+        return _db->get();
+    }
+
+    /**
+        Gets the cached prepared statement for the specified SQL text, which
+        must be a string literal.  The statement must be reset before the
+        connection is released.
+    */
+    sqlite3_stmt* getStatement(const char* sqlStatement)
+    {
+        return _db->getStatement(sqlStatement);
+    }
+
+    Boolean isShared() const
+    {
+        return _isShared;
     }
 
     void release()
     {
-        _dbcm.cacheDbConnection(_nameSpace, _db);
+        if (!_isShared)
+        {
+            _dbcm.cacheDbConnection(_nameSpace, _db);
+        }
         _db = 0;
     }
 
 private:
     DbConnectionManager& _dbcm;
     CIMNamespaceName _nameSpace;
-    sqlite3* _db;
+    DbHandle* _db;
+    Boolean _isShared;
 };
 
 
@@ -226,32 +443,11 @@ private:
 //
 ///////////////////////////////////////////////////////////////////////////////
 
-// Size optimization:  Keep the exception throwing logic in a function so it
-// does not get replicated with each error check.
-static void _throwSQLiteOperationException(sqlite3* db)
-{
-    throw Exception(MessageLoaderParms(
-        "Repository.SQLiteStore.DB_OP_ERROR",
-        "Repository SQLite database operation failed with error $0: $1",
-        sqlite3_errcode(db),
-        String((const Char16*)sqlite3_errmsg16(db))));
-}
-
-inline void CHECK_RC_OK(int rc, sqlite3* db)
-{
-    if (rc != SQLITE_OK)
-    {
-        _throwSQLiteOperationException(db);
-    }
-}
-
-inline void CHECK_RC_DONE(int rc, sqlite3* db)
-{
-    if (rc != SQLITE_DONE)
-    {
-        _throwSQLiteOperationException(db);
-    }
-}
+// Version of the namespace database schema, which is recorded as the
+// user_version of each database file.  Databases at version 0 have no
+// secondary indexes and use a rollback journal.
+static const int DB_SCHEMA_VERSION = 1;
+static const char DB_SCHEMA_VERSION_STATEMENT[] = "PRAGMA user_version=1;";
 
 Boolean SQLiteStore::isExistingRepository(const String& repositoryRoot)
 {
@@ -279,6 +475,33 @@ SQLiteStore::SQLiteStore(
     _repositoryRoot = repositoryRoot;
     _streamer = streamer;
 
+    // Bring the namespace databases of an existing repository up to the
+    // current schema version
+
+    Array<String> dbFileNames;
+    if (FileSystem::glob(_repositoryRoot, "*.db", dbFileNames))
+    {
+        for (Uint32 i = 0; i < dbFileNames.size(); i++)
+        {
+            String dbPath = _repositoryRoot + "/" + dbFileNames[i];
+
+            try
+            {
+                AutoPtr<sqlite3, CloseSQLiteDb> db(
+                    DbConnectionManager::openDb(dbPath.getCString()));
+                _upgradeSchema(db.get(), dbPath);
+            }
+            catch (Exception& e)
+            {
+                // The namespace remains usable at its old schema version.
+                PEG_TRACE((TRC_REPOSITORY, Tracer::LEVEL1,
+                    "Failed to upgrade namespace database %s: %s",
+                    (const char*) dbPath.getCString(),
+                    (const char*) e.getMessage().getCString()));
+            }
+        }
+    }
+
     PEG_METHOD_EXIT();
 }
 
@@ -321,6 +544,11 @@ void SQLiteStore::_initSchema(sqlite3* db)
 {
     PEG_METHOD_ENTER(TRC_REPOSITORY, "SQLiteStore::_initSchema");
 
+    // Readers and the writer of a namespace do not block each other in WAL
+    // mode, and a commit does not rewrite the database pages.  The mode is
+    // recorded in the database file.
+    _execDbStatement(db, "PRAGMA journal_mode=WAL;");
+
     // The NamespaceTable contains a single row describing the namespace
     // corresponding to the database file.
     _execDbStatement(
@@ -382,17 +610,104 @@ void SQLiteStore::_initSchema(sqlite3* db)
             "PRIMARY KEY("
                 "normassocinstname, normfrompropname, normtopropname));");
 
+    _createIndexes(db);
+
+    _execDbStatement(db, DB_SCHEMA_VERSION_STATEMENT);
+
     PEG_METHOD_EXIT();
 }
 
-void SQLiteStore::_beginTransaction(sqlite3* db)
+void SQLiteStore::_createIndexes(sqlite3* db)
 {
-    _execDbStatement(db, "BEGIN;");
+    PEG_METHOD_ENTER(TRC_REPOSITORY, "SQLiteStore::_createIndexes");
+
+    // Instance enumeration selects the instances of a class.
+    _execDbStatement(
+        db,
+        "CREATE INDEX IF NOT EXISTS InstanceClassIndex "
+            "ON InstanceTable(normclassname);");
+
+    // Class association lookups select by the source class.
+    _execDbStatement(
+        db,
+        "CREATE INDEX IF NOT EXISTS ClassAssocFromIndex "
+            "ON ClassAssocTable(normfromclassname);");
+
+    // Instance associator and reference lookups select by the source
+    // instance.
+    _execDbStatement(
+        db,
+        "CREATE INDEX IF NOT EXISTS InstanceAssocFromIndex "
+            "ON InstanceAssocTable(normfrominstname);");
+
+    PEG_METHOD_EXIT();
 }
 
-void SQLiteStore::_commitTransaction(sqlite3* db)
+void SQLiteStore::_upgradeSchema(sqlite3* db, const String& dbPath)
 {
-    _execDbStatement(db, "COMMIT;");
+    PEG_METHOD_ENTER(TRC_REPOSITORY, "SQLiteStore::_upgradeSchema");
+
+    sqlite3_stmt* stmt = 0;
+    CHECK_RC_OK(
+        sqlite3_prepare_v2(db, "PRAGMA user_version;", -1, &stmt, 0),
+        db);
+    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+
+    if (sqlite3_step(stmt) != SQLITE_ROW)
+    {
+        _throwSQLiteOperationException(db);
+    }
+
+    int version = sqlite3_column_int(stmt, 0);
+    stmtDestroyer.reset();
+
+    if (version >= DB_SCHEMA_VERSION)
+    {
+        PEG_METHOD_EXIT();
+        return;
+    }
+
+    PEG_TRACE((TRC_REPOSITORY, Tracer::LEVEL3,
+        "Upgrading namespace database %s from schema version %d to %d",
+        (const char*) dbPath.getCString(),
+        version,
+        DB_SCHEMA_VERSION));
+
+    _execDbStatement(db, "BEGIN IMMEDIATE;");
+
+    try
+    {
+        _createIndexes(db);
+        _execDbStatement(db, DB_SCHEMA_VERSION_STATEMENT);
+        _execDbStatement(db, "COMMIT;");
+    }
+    catch (...)
+    {
+        sqlite3_exec(db, "ROLLBACK;", 0, 0, 0);
+        PEG_METHOD_EXIT();
+        throw;
+    }
+
+    // The journal mode cannot be changed within a transaction.
+    _execDbStatement(db, "PRAGMA journal_mode=WAL;");
+
+    PEG_METHOD_EXIT();
+}
+
+void SQLiteStore::_beginTransaction(DbConnection& db)
+{
+    if (!db.isShared())
+    {
+        _execDbStatement(db.get(), "BEGIN;");
+    }
+}
+
+void SQLiteStore::_commitTransaction(DbConnection& db)
+{
+    if (!db.isShared())
+    {
+        _execDbStatement(db.get(), "COMMIT;");
+    }
 }
 
 Array<NamespaceDefinition> SQLiteStore::enumerateNameSpaces()
@@ -533,6 +848,13 @@ void SQLiteStore::createNameSpace(
     {
         // Do not leave a partially created database file
         FileSystem::removeFile(dbPath);
+
+        Array<String> sideFilePaths =
+            DbConnectionManager::getDbSideFilePaths(dbPath);
+        for (Uint32 i = 0; i < sideFilePaths.size(); i++)
+        {
+            FileSystem::removeFile(sideFilePaths[i]);
+        }
         PEG_METHOD_EXIT();
         throw;
     }
@@ -554,11 +876,8 @@ void SQLiteStore::modifyNameSpace(
     const char* sqlStatement = "UPDATE NamespaceTable SET shareable=?, "
         "updatesallowed=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     CHECK_RC_OK(sqlite3_bind_int(stmt, 1, shareable? 1 : 0), db.get());
     CHECK_RC_OK(sqlite3_bind_int(stmt, 2, updatesAllowed? 1 : 0), db.get());
@@ -579,8 +898,14 @@ void SQLiteStore::modifyNameSpaceName(
     
     String dbPath = _dbcm.getDbPath(nameSpace);
     String dbPathnew = _dbcm.getDbPath(newNameSpaceName);
-   
-    DbConnection db(_dbcm, nameSpace);
+
+    // Cached connections would keep using the old file name.  Closing the
+    // last connection also checkpoints the write-ahead log into the
+    // database file.
+    _dbcm.closeDbConnections(nameSpace);
+
+    AutoPtr<sqlite3, CloseSQLiteDb> db(
+        DbConnectionManager::openDb(dbPath.getCString()));
 
     String ns = newNameSpaceName.getString();
     sqlite3_stmt* stmt = 0;
@@ -601,9 +926,23 @@ void SQLiteStore::modifyNameSpaceName(
     CHECK_RC_DONE(sqlite3_step(stmt), db.get());
 
     stmtDestroyer.reset();
-    db.release();
+    db.reset();
     FileSystem::renameFile(dbPath, dbPathnew);
 
+    // Move any log left by a connection of another process along with the
+    // database file
+    Array<String> sideFilePaths = DbConnectionManager::getDbSideFilePaths(
+        dbPath);
+    Array<String> newSideFilePaths = DbConnectionManager::getDbSideFilePaths(
+        dbPathnew);
+    for (Uint32 i = 0; i < sideFilePaths.size(); i++)
+    {
+        if (FileSystem::exists(sideFilePaths[i]))
+        {
+            FileSystem::renameFile(sideFilePaths[i], newSideFilePaths[i]);
+        }
+    }
+
     PEG_METHOD_EXIT();
 }
 void SQLiteStore::deleteNameSpace(const CIMNamespaceName& nameSpace)
@@ -612,11 +951,20 @@ void SQLiteStore::deleteNameSpace(const CIMNamespaceName& nameSpace)
 
     String dbPath = _dbcm.getDbPath(nameSpace);
 
+    _dbcm.closeDbConnections(nameSpace);
+
     if (!FileSystem::removeFile(dbPath))
     {
         throw CannotRemoveFile(dbPath);
     }
 
+    Array<String> sideFilePaths = DbConnectionManager::getDbSideFilePaths(
+        dbPath);
+    for (Uint32 i = 0; i < sideFilePaths.size(); i++)
+    {
+        FileSystem::removeFile(sideFilePaths[i]);
+    }
+
     PEG_METHOD_EXIT();
 }
 
@@ -642,11 +990,8 @@ Array<CIMQualifierDecl> SQLiteStore::enumerateQualifiers(
 
     const char* sqlStatement = "SELECT rep FROM QualifierTable;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     int rc;
     while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
@@ -681,11 +1026,8 @@ CIMQualifierDecl SQLiteStore::getQualifier(
     const char* sqlStatement = "SELECT rep FROM QualifierTable "
         "WHERE normqualname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String qualname = _getNormalizedName(qualifierName);
 
@@ -743,11 +1085,8 @@ void SQLiteStore::setQualifier(
     const char* sqlStatement =
         "INSERT INTO QualifierTable VALUES(?,?,?);";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String qualname = qualifierDecl.getName().getString();
     String normqualname = _getNormalizedName(qualifierDecl.getName());
@@ -803,11 +1142,8 @@ void SQLiteStore::deleteQualifier(
     const char* sqlStatement = "DELETE FROM QualifierTable "
         "WHERE normqualname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String qualname = _getNormalizedName(qualifierName);
 
@@ -839,11 +1175,8 @@ Array<Pair<String, String> > SQLiteStore::enumerateClassNames(
     const char* sqlStatement = "SELECT classname, superclassname "
         "FROM ClassTable;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     int rc;
     while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
@@ -879,11 +1212,8 @@ CIMClass SQLiteStore::getClass(
     const char* sqlStatement = "SELECT rep FROM ClassTable "
         "WHERE normclassname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String classname = _getNormalizedName(className);
 
@@ -932,15 +1262,12 @@ void SQLiteStore::createClass(
 
     DbConnection db(_dbcm, nameSpace);
 
-    _beginTransaction(db.get());
+    _beginTransaction(db);
 
     const char* sqlStatement = "INSERT INTO ClassTable VALUES(?,?,?,?);";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String classname = newClass.getClassName().getString();
     String normclassname = _getNormalizedName(newClass.getClassName());
@@ -981,10 +1308,10 @@ void SQLiteStore::createClass(
     // Create the class association entries
     if (classAssocEntries.size())
     {
-        _addClassAssociationEntries(db.get(), nameSpace, classAssocEntries);
+        _addClassAssociationEntries(db, nameSpace, classAssocEntries);
     }
 
-    _commitTransaction(db.get());
+    _commitTransaction(db);
 
     stmtDestroyer.reset();
     db.release();
@@ -1003,16 +1330,13 @@ void SQLiteStore::modifyClass(
 
     DbConnection db(_dbcm, nameSpace);
 
-    _beginTransaction(db.get());
+    _beginTransaction(db);
 
     const char* sqlStatement = "UPDATE ClassTable SET rep=? "
         "WHERE normclassname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     Buffer data;
     _streamer->encode(data, modifiedClass);
@@ -1039,14 +1363,14 @@ void SQLiteStore::modifyClass(
     if (isAssociation)
     {
         _removeClassAssociationEntries(
-            db.get(), nameSpace, modifiedClass.getClassName());
+            db, nameSpace, modifiedClass.getClassName());
         if (classAssocEntries.size())
         {
-            _addClassAssociationEntries(db.get(), nameSpace, classAssocEntries);
+            _addClassAssociationEntries(db, nameSpace, classAssocEntries);
         }
     }
 
-    _commitTransaction(db.get());
+    _commitTransaction(db);
 
     stmtDestroyer.reset();
     db.release();
@@ -1069,16 +1393,13 @@ void SQLiteStore::deleteClass(
 
     DbConnection db(_dbcm, nameSpace);
 
-    _beginTransaction(db.get());
+    _beginTransaction(db);
 
     const char* sqlStatement = "DELETE FROM ClassTable "
         "WHERE normclassname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String normclassname = _getNormalizedName(className);
 
@@ -1099,10 +1420,10 @@ void SQLiteStore::deleteClass(
 
     if (isAssociation)
     {
-        _removeClassAssociationEntries(db.get(), nameSpace, className);
+        _removeClassAssociationEntries(db, nameSpace, className);
     }
 
-    _commitTransaction(db.get());
+    _commitTransaction(db);
 
     stmtDestroyer.reset();
     db.release();
@@ -1123,11 +1444,8 @@ Array<CIMObjectPath> SQLiteStore::enumerateInstanceNamesForClass(
     const char* sqlStatement = "SELECT instname FROM InstanceTable "
         "WHERE normclassname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String classname = _getNormalizedName(className);
 
@@ -1171,11 +1489,8 @@ Array<CIMInstance> SQLiteStore::enumerateInstancesForClass(
     const char* sqlStatement = "SELECT instname, rep FROM InstanceTable "
         "WHERE normclassname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String classname = _getNormalizedName(className);
 
@@ -1226,11 +1541,8 @@ CIMInstance SQLiteStore::getInstance(
     const char* sqlStatement = "SELECT instname, rep FROM InstanceTable "
         "WHERE norminstname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String norminstname = instanceName._toStringCanonical();
 
@@ -1280,15 +1592,12 @@ void SQLiteStore::createInstance(
 
     DbConnection db(_dbcm, nameSpace);
 
-    _beginTransaction(db.get());
+    _beginTransaction(db);
 
     const char* sqlStatement = "INSERT INTO InstanceTable VALUES(?,?,?,?);";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String classname = _getNormalizedName(cimInstance.getClassName());
     String instname = instanceName.toString();
@@ -1332,10 +1641,10 @@ void SQLiteStore::createInstance(
 
     if (instAssocEntries.size())
     {
-        _addInstanceAssociationEntries(db.get(), nameSpace, instAssocEntries);
+        _addInstanceAssociationEntries(db, nameSpace, instAssocEntries);
     }
 
-    _commitTransaction(db.get());
+    _commitTransaction(db);
 
     stmtDestroyer.reset();
     db.release();
@@ -1361,11 +1670,8 @@ void SQLiteStore::modifyInstance(
     const char* sqlStatement = "UPDATE InstanceTable SET rep=? "
         "WHERE norminstname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     Buffer data;
     _streamer->encode(data, cimInstance);
@@ -1404,16 +1710,13 @@ void SQLiteStore::deleteInstance(
 
     DbConnection db(_dbcm, nameSpace);
 
-    _beginTransaction(db.get());
+    _beginTransaction(db);
 
     const char* sqlStatement = "DELETE FROM InstanceTable "
         "WHERE norminstname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String norminstname = instanceName._toStringCanonical();
 
@@ -1432,9 +1735,9 @@ void SQLiteStore::deleteInstance(
     // Delete from association table (if an assocation).
     //
 
-    _removeInstanceAssociationEntries(db.get(), nameSpace, instanceName);
+    _removeInstanceAssociationEntries(db, nameSpace, instanceName);
 
-    _commitTransaction(db.get());
+    _commitTransaction(db);
 
     stmtDestroyer.reset();
     db.release();
@@ -1453,11 +1756,8 @@ Boolean SQLiteStore::instanceExists(
     const char* sqlStatement = "SELECT instname FROM InstanceTable "
         "WHERE norminstname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String norminstname = instanceName._toStringCanonical();
 
@@ -1489,6 +1789,53 @@ Boolean SQLiteStore::instanceExists(
     return found;
 }
 
+void SQLiteStore::beginInstanceTransaction(const CIMNamespaceName& nameSpace)
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY, "SQLiteStore::beginInstanceTransaction");
+
+    // The write lock is taken immediately so that the transaction cannot
+    // fail later on a lock upgrade.
+    AutoPtr<DbHandle> db(_dbcm.getDbConnection(nameSpace));
+    _execDbStatement(db->get(), "BEGIN IMMEDIATE;");
+    _dbcm.setTransactionConnection(nameSpace, db.release());
+
+    PEG_METHOD_EXIT();
+}
+
+void SQLiteStore::commitInstanceTransaction()
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY, "SQLiteStore::commitInstanceTransaction");
+
+    CIMNamespaceName nameSpace;
+    AutoPtr<DbHandle> db(_dbcm.removeTransactionConnection(nameSpace));
+    PEGASUS_ASSERT(db.get());
+
+    try
+    {
+        _execDbStatement(db->get(), "COMMIT;");
+    }
+    catch (...)
+    {
+        sqlite3_exec(db->get(), "ROLLBACK;", 0, 0, 0);
+        PEG_METHOD_EXIT();
+        throw;
+    }
+
+    _dbcm.cacheDbConnection(nameSpace, db.release());
+
+    PEG_METHOD_EXIT();
+}
+
+void SQLiteStore::rollbackInstanceTransaction()
+{
+    PEG_METHOD_ENTER(TRC_REPOSITORY,
+        "SQLiteStore::rollbackInstanceTransaction");
+
+    _dbcm.rollbackTransaction();
+
+    PEG_METHOD_EXIT();
+}
+
 void SQLiteStore::_initAssocClassCache(
     const CIMNamespaceName& nameSpace,
     AssocClassCache* cache)
@@ -1502,11 +1849,8 @@ void SQLiteStore::_initAssocClassCache(
         "SELECT assocclassname, normfromclassname, normfrompropname, "
             "toclassname, normtopropname FROM ClassAssocTable;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db.get(), sqlStatement, -1, &stmt, 0),
-        db.get());
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     int rc;
     while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
@@ -1542,7 +1886,7 @@ void SQLiteStore::_initAssocClassCache(
 }
 
 void SQLiteStore::_addClassAssociationEntries(
-    sqlite3* db,
+    DbConnection& db,
     const CIMNamespaceName& nameSpace,
     const Array<ClassAssociation>& classAssocEntries)
 {
@@ -1552,11 +1896,8 @@ void SQLiteStore::_addClassAssociationEntries(
     const char* sqlStatement =
         "INSERT INTO ClassAssocTable VALUES(?,?,?,?,?,?,?);";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db, sqlStatement, -1, &stmt, 0),
-        db);
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     for (Uint32 i = 0; i < classAssocEntries.size(); i++)
     {
@@ -1582,7 +1923,7 @@ void SQLiteStore::_addClassAssociationEntries(
                 assocclassname.getChar16Data(),
                 assocclassname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -1590,7 +1931,7 @@ void SQLiteStore::_addClassAssociationEntries(
                 normassocclassname.getChar16Data(),
                 normassocclassname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -1598,7 +1939,7 @@ void SQLiteStore::_addClassAssociationEntries(
                 normfromclassname.getChar16Data(),
                 normfromclassname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -1606,7 +1947,7 @@ void SQLiteStore::_addClassAssociationEntries(
                 normfrompropname.getChar16Data(),
                 normfrompropname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -1614,7 +1955,7 @@ void SQLiteStore::_addClassAssociationEntries(
                 toclassname.getChar16Data(),
                 toclassname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -1622,7 +1963,7 @@ void SQLiteStore::_addClassAssociationEntries(
                 normtoclassname.getChar16Data(),
                 normtoclassname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -1630,13 +1971,13 @@ void SQLiteStore::_addClassAssociationEntries(
                 normtopropname.getChar16Data(),
                 normtopropname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
 
-        CHECK_RC_DONE(sqlite3_step(stmt), db);
+        CHECK_RC_DONE(sqlite3_step(stmt), db.get());
 
-        CHECK_RC_OK(sqlite3_reset(stmt), db);
+        CHECK_RC_OK(sqlite3_reset(stmt), db.get());
 
-        CHECK_RC_OK(sqlite3_clear_bindings(stmt), db);
+        CHECK_RC_OK(sqlite3_clear_bindings(stmt), db.get());
     }
 
 #ifdef USE_ASSOC_CLASS_CACHE
@@ -1661,7 +2002,7 @@ void SQLiteStore::_addClassAssociationEntries(
 }
 
 void SQLiteStore::_removeClassAssociationEntries(
-    sqlite3* db,
+    DbConnection& db,
     const CIMNamespaceName& nameSpace,
     const CIMName& assocClassName)
 {
@@ -1671,11 +2012,8 @@ void SQLiteStore::_removeClassAssociationEntries(
     const char* sqlStatement = "DELETE FROM ClassAssocTable "
         "WHERE normassocclassname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db, sqlStatement, -1, &stmt, 0),
-        db);
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String normassocclassname = _getNormalizedName(assocClassName);
 
@@ -1686,9 +2024,9 @@ void SQLiteStore::_removeClassAssociationEntries(
             normassocclassname.getChar16Data(),
             normassocclassname.size() * 2,
             SQLITE_STATIC),
-        db);
+        db.get());
 
-    CHECK_RC_DONE(sqlite3_step(stmt), db);
+    CHECK_RC_DONE(sqlite3_step(stmt), db.get());
 
 #ifdef USE_ASSOC_CLASS_CACHE
 
@@ -2010,7 +2348,7 @@ void SQLiteStore::getClassReferenceNames(
 }
 
 void SQLiteStore::_addInstanceAssociationEntries(
-    sqlite3* db,
+    DbConnection& db,
     const CIMNamespaceName& nameSpace,
     const Array<InstanceAssociation>& instanceAssocEntries)
 {
@@ -2020,11 +2358,8 @@ void SQLiteStore::_addInstanceAssociationEntries(
     const char* sqlStatement =
         "INSERT INTO InstanceAssocTable VALUES(?,?,?,?,?,?,?,?);";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db, sqlStatement, -1, &stmt, 0),
-        db);
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     for (Uint32 i = 0; i < instanceAssocEntries.size(); i++)
     {
@@ -2054,7 +2389,7 @@ void SQLiteStore::_addInstanceAssociationEntries(
                 associnstname.getChar16Data(),
                 associnstname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -2062,7 +2397,7 @@ void SQLiteStore::_addInstanceAssociationEntries(
                 normassocinstname.getChar16Data(),
                 normassocinstname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -2070,7 +2405,7 @@ void SQLiteStore::_addInstanceAssociationEntries(
                 normassocclassname.getChar16Data(),
                 normassocclassname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -2078,7 +2413,7 @@ void SQLiteStore::_addInstanceAssociationEntries(
                 normfrominstname.getChar16Data(),
                 normfrominstname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -2086,7 +2421,7 @@ void SQLiteStore::_addInstanceAssociationEntries(
                 normfrompropname.getChar16Data(),
                 normfrompropname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -2094,7 +2429,7 @@ void SQLiteStore::_addInstanceAssociationEntries(
                 toinstname.getChar16Data(),
                 toinstname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -2102,7 +2437,7 @@ void SQLiteStore::_addInstanceAssociationEntries(
                 normtoclassname.getChar16Data(),
                 normtoclassname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
         CHECK_RC_OK(
             sqlite3_bind_text16(
                 stmt,
@@ -2110,20 +2445,20 @@ void SQLiteStore::_addInstanceAssociationEntries(
                 normtopropname.getChar16Data(),
                 normtopropname.size() * 2,
                 SQLITE_STATIC),
-            db);
+            db.get());
 
-        CHECK_RC_DONE(sqlite3_step(stmt), db);
+        CHECK_RC_DONE(sqlite3_step(stmt), db.get());
 
-        CHECK_RC_OK(sqlite3_reset(stmt), db);
+        CHECK_RC_OK(sqlite3_reset(stmt), db.get());
 
-        CHECK_RC_OK(sqlite3_clear_bindings(stmt), db);
+        CHECK_RC_OK(sqlite3_clear_bindings(stmt), db.get());
     }
 
     PEG_METHOD_EXIT();
 }
 
 void SQLiteStore::_removeInstanceAssociationEntries(
-    sqlite3* db,
+    DbConnection& db,
     const CIMNamespaceName& nameSpace,
     const CIMObjectPath& assocInstanceName)
 {
@@ -2133,11 +2468,8 @@ void SQLiteStore::_removeInstanceAssociationEntries(
     const char* sqlStatement = "DELETE FROM InstanceAssocTable "
         "WHERE normassocinstname=?;";
 
-    sqlite3_stmt* stmt = 0;
-    CHECK_RC_OK(
-        sqlite3_prepare_v2(db, sqlStatement, -1, &stmt, 0),
-        db);
-    AutoPtr<sqlite3_stmt, FinalizeSQLiteStatement> stmtDestroyer(stmt);
+    sqlite3_stmt* stmt = db.getStatement(sqlStatement);
+    AutoPtr<sqlite3_stmt, ResetSQLiteStatement> stmtDestroyer(stmt);
 
     String associnstname = assocInstanceName._toStringCanonical();
 
@@ -2148,9 +2480,9 @@ void SQLiteStore::_removeInstanceAssociationEntries(
             associnstname.getChar16Data(),
             associnstname.size() * 2,
             SQLITE_STATIC),
-        db);
+        db.get());
 
-    CHECK_RC_DONE(sqlite3_step(stmt), db);
+    CHECK_RC_DONE(sqlite3_step(stmt), db.get());
 
     PEG_METHOD_EXIT();
 }
@@ -35,6 +35,7 @@
 #include <Pegasus/Common/Config.h>
 #include <Pegasus/Common/CommonUTF.h>
 #include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/Threads.h>
 #include <Pegasus/Repository/PersistentStore.h>
 #include <Pegasus/Repository/AssocClassCache.h>
 #include <Pegasus/Repository/Linkage.h>
@@ -43,6 +44,47 @@
 
 PEGASUS_NAMESPACE_BEGIN
 
+class DbConnection;
+
+/**
+    A DbHandle holds an open database connection together with the prepared
+    statements cached for it.  A statement is prepared the first time it is
+    used on the connection and is reset for reuse after each operation, so
+    the SQL text is compiled once per connection rather than once per
+    operation.  Deleting the handle finalizes its statements and closes the
+    connection.
+*/
+class PEGASUS_REPOSITORY_LINKAGE DbHandle
+{
+public:
+    DbHandle(sqlite3* db)
+        : _db(db)
+    {
+    }
+
+    ~DbHandle();
+
+    sqlite3* get()
+    {
+        return _db;
+    }
+
+    /**
+        Gets the prepared statement for the specified SQL text, preparing it
+        if it is not cached yet.  Statements are looked up by their SQL
+        text, so the text need not be a string literal.  The caller must
+        reset the statement when it is done with it.
+    */
+    sqlite3_stmt* getStatement(const char* sqlStatement);
+
+private:
+    DbHandle(const DbHandle&);
+    DbHandle& operator=(const DbHandle&);
+
+    sqlite3* _db;
+    Array<sqlite3_stmt*> _statements;
+};
+
 /**
     The DbConnectionManager caches database handles for reuse.
     It has a fixed maximum cache size (currently 4) and uses an LRU algorithm
@@ -54,7 +96,8 @@ class DbConnectionManager
 {
 public:
     DbConnectionManager(const String& repositoryRoot)
-        : _repositoryRoot(repositoryRoot)
+        : _repositoryRoot(repositoryRoot),
+          _transactionDb(0)
     {
     }
 
@@ -63,10 +106,10 @@ public:
     /**
         Gets a database connection handle for the specified namespace.  It may
         return a handle removed from its cache or a newly opened one.  The
-        caller is responsible for cleaning up the dynamic resources for the
-        database connection or returning it to the cache.
+        caller is responsible for deleting the handle or returning it to the
+        cache.
     */
-    sqlite3* getDbConnection(const CIMNamespaceName& nameSpace);
+    DbHandle* getDbConnection(const CIMNamespaceName& nameSpace);
 
     /**
         Add a database connection handle to the cache.  If the cache is full,
@@ -74,7 +117,13 @@ public:
     */
     void cacheDbConnection(
         const CIMNamespaceName& nameSpace,
-        sqlite3* db);
+        DbHandle* db);
+
+    /**
+        Closes the cached database connection handles for the specified
+        namespace, so that its database file may be renamed or removed.
+    */
+    void closeDbConnections(const CIMNamespaceName& nameSpace);
 
     /**
         Converts a namespace name to the database file path which contains
@@ -88,12 +137,47 @@ public:
     */
     static sqlite3* openDb(const char* fileName);
 
+    /**
+        Gets the path names of the files that SQLite keeps next to the
+        specified database file while it is in use in WAL mode.
+    */
+    static Array<String> getDbSideFilePaths(const String& dbPath);
+
+    /**
+        Registers the database connection handle on which the calling thread
+        has begun an instance transaction for the specified namespace.  The
+        handle is owned by the manager until the transaction ends.
+    */
+    void setTransactionConnection(
+        const CIMNamespaceName& nameSpace,
+        DbHandle* db);
+
+    /**
+        Gets the database connection handle of the instance transaction that
+        the calling thread has active for the specified namespace.  Returns
+        0 if there is no such transaction.
+    */
+    DbHandle* getTransactionConnection(const CIMNamespaceName& nameSpace);
+
+    /**
+        Ends the instance transaction of the calling thread and returns its
+        database connection handle and namespace.  The caller takes
+        ownership of the handle.  Returns 0 if there is no such transaction.
+    */
+    DbHandle* removeTransactionConnection(CIMNamespaceName& nameSpace);
+
+    /**
+        Rolls back the instance transaction of the calling thread, if any,
+        and closes its database connection handle.  Does not throw.
+    */
+    void rollbackTransaction();
+
 private:
 
     class CacheEntry
     {
     public:
-        CacheEntry(const CIMNamespaceName& nameSpace_, sqlite3* db_)
+        CacheEntry(const CIMNamespaceName& nameSpace_, DbHandle* db_)
             : nameSpace(nameSpace_),
               db(db_)
         {
@@ -103,12 +187,17 @@ private:
         // The caller is responsible for ensuring proper pointer management.
 
         CIMNamespaceName nameSpace;
-        sqlite3* db;
+        DbHandle* db;
     };
 
     Array<CacheEntry> _cache;
     Mutex _cacheLock;
     String _repositoryRoot;
+
+    // Instance transaction state, protected by _cacheLock
+    CIMNamespaceName _transactionNameSpace;
+    DbHandle* _transactionDb;
+    ThreadType _transactionThread;
 };
 
 
@@ -240,16 +329,40 @@ public:
         const String& role,
         Array<String>& referenceNames);
 
+    void beginInstanceTransaction(const CIMNamespaceName& nameSpace);
+    void commitInstanceTransaction();
+    void rollbackInstanceTransaction();
+
 private:
 
     void _execDbStatement(
         sqlite3* db,
         const char* sqlStatement);
 
+    /**
+        Creates the tables and indexes of a new namespace database at the
+        current schema version.
+    */
     void _initSchema(sqlite3* db);
 
-    void _beginTransaction(sqlite3* db);
-    void _commitTransaction(sqlite3* db);
+    /**
+        Creates the secondary indexes that are not part of the table
+        definitions.  The statements may be repeated safely.
+    */
+    void _createIndexes(sqlite3* db);
+
+    /**
+        Brings a namespace database created by an earlier version of this
+        store up to the current schema version.
+    */
+    void _upgradeSchema(sqlite3* db, const String& dbPath);
+
+    /**
+        Begins and commits the transaction of a single operation.  These have
+        no effect on a connection shared with an active instance transaction.
+    */
+    void _beginTransaction(DbConnection& db);
+    void _commitTransaction(DbConnection& db);
 
     String _getNormalizedName(const CIMName& className)
     {
@@ -262,20 +375,20 @@ private:
         const CIMNamespaceName& nameSpace,
         AssocClassCache* cache);
     void _addClassAssociationEntries(
-        sqlite3* db,
+        DbConnection& db,
         const CIMNamespaceName& nameSpace,
         const Array<ClassAssociation>& classAssocEntries);
     void _removeClassAssociationEntries(
-        sqlite3* db,
+        DbConnection& db,
         const CIMNamespaceName& nameSpace,
         const CIMName& assocClassName);
 
     void _addInstanceAssociationEntries(
-        sqlite3* db,
+        DbConnection& db,
         const CIMNamespaceName& nameSpace,
         const Array<InstanceAssociation>& instanceAssocEntries);
     void _removeInstanceAssociationEntries(
-        sqlite3* db,
+        DbConnection& db,
         const CIMNamespaceName& nameSpace,
         const CIMObjectPath& assocInstanceName);
 
@@ -31,6 +31,7 @@
 
 #include <Pegasus/Repository/AssocClassTable.h>
 #include <Pegasus/Repository/AssocInstTable.h>
+#include <Pegasus/Common/FileSystem.h>
 
 PEGASUS_USING_PEGASUS;
 PEGASUS_USING_STD;
@@ -102,27 +103,121 @@ int main(int, char** argv)
         PEGASUS_TEST_ASSERT(referenceNames.size() == 0);
     }
 
+    AssocInstTable _assocInstTable;
+
     //
     // create instance association
     //
-    AssocInstTable::append(
+    _assocInstTable.append(
+        assocTablePath,
+        InstanceAssociation(
+            "A.left=\"x.key=\\\"one\\\"\",right=\"y.key=\\\"two\\\"\"",
+            CIMName("A"),
+            "X.key=\"one\"",
+            CIMName("X"),
+            CIMName("left"),
+            "Y.key=\"two\"",
+            CIMName("Y"),
+            CIMName("right")));
+
+    //
+    // check that the association is found, also after it has been cached
+    //
+    for (Uint32 pass = 0; pass < 2; pass++)
+    {
+        Array<String> associatorNames;
+        _assocInstTable.getAssociatorNames(
+            assocTablePath,
+            CIMObjectPath("x.KEY=\"one\""),
+            Array<CIMName>(),
+            Array<CIMName>(),
+            "LEFT",
+            String::EMPTY,
+            associatorNames);
+        PEGASUS_TEST_ASSERT(associatorNames.size() == 1);
+        PEGASUS_TEST_ASSERT(associatorNames[0] == "Y.key=\"two\"");
+
+        Array<String> referenceNames;
+        _assocInstTable.getReferenceNames(
+            assocTablePath,
+            CIMObjectPath("X.key=\"one\""),
+            Array<CIMName>(),
+            "right",
+            referenceNames);
+        PEGASUS_TEST_ASSERT(referenceNames.size() == 0);
+    }
+
+    //
+    // an association added to a cached table is found
+    //
+    _assocInstTable.append(
         assocTablePath,
-        "A.left=\"x.key=\\\"one\\\"\",right=\"y.key=\\\"two\\\"\"",
-        CIMName ("A"),
-        "X.key=\"one\"",
-        CIMName ("X"),
-        CIMName ("left"),
-        "Y.key=\"two\"",
-        CIMName ("Y"),
-        CIMName ("right"));
+        InstanceAssociation(
+            "B.left=\"x.key=\\\"one\\\"\",right=\"y.key=\\\"three\\\"\"",
+            CIMName("B"),
+            "X.key=\"one\"",
+            CIMName("X"),
+            CIMName("left"),
+            "Y.key=\"three\"",
+            CIMName("Y"),
+            CIMName("right")));
+
+    {
+        Array<String> referenceNames;
+        _assocInstTable.getReferenceNames(
+            assocTablePath,
+            CIMObjectPath("X.key=\"one\""),
+            Array<CIMName>(),
+            String::EMPTY,
+            referenceNames);
+        PEGASUS_TEST_ASSERT(referenceNames.size() == 2);
+
+        Array<CIMName> assocClassList;
+        assocClassList.append(CIMName("b"));
+        Array<String> associatorNames;
+        _assocInstTable.getAssociatorNames(
+            assocTablePath,
+            CIMObjectPath("X.key=\"one\""),
+            assocClassList,
+            Array<CIMName>(),
+            String::EMPTY,
+            String::EMPTY,
+            associatorNames);
+        PEGASUS_TEST_ASSERT(associatorNames.size() == 1);
+        PEGASUS_TEST_ASSERT(associatorNames[0] == "Y.key=\"three\"");
+    }
 
     //
     // delete instance association
     //
-    AssocInstTable::deleteAssociation(
+    PEGASUS_TEST_ASSERT(_assocInstTable.deleteAssociation(
+        assocTablePath,
+        CIMObjectPath
+            ("A.left=\"x.key=\\\"one\\\"\",right=\"y.key=\\\"two\\\"\"")));
+
+    //
+    // check that the association was really deleted, both from the cache
+    // and from the table
+    //
+    for (Uint32 pass = 0; pass < 2; pass++)
+    {
+        Array<String> referenceNames;
+        _assocInstTable.getReferenceNames(
+            assocTablePath,
+            CIMObjectPath("X.key=\"one\""),
+            Array<CIMName>(),
+            String::EMPTY,
+            referenceNames);
+        PEGASUS_TEST_ASSERT(referenceNames.size() == 1);
+
+        _assocInstTable.invalidateCache(assocTablePath);
+    }
+
+    PEGASUS_TEST_ASSERT(_assocInstTable.deleteAssociation(
         assocTablePath,
         CIMObjectPath
-            ("A.left=\"x.key=\\\"one\\\"\",right=\"y.key=\\\"two\\\"\""));
+            ("B.left=\"x.key=\\\"one\\\"\",right=\"y.key=\\\"three\\\"\"")));
+    PEGASUS_TEST_ASSERT(!FileSystem::exists(assocTablePath));
 
     cout << argv[0] << " +++++ passed all tests" << endl;
 
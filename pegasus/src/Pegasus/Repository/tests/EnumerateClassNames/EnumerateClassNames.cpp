@@ -193,6 +193,33 @@ static void CreateClass(
     r.createClass(NAMESPACE, c);
 }
 
+// Verify that the class generation changes with the class hierarchy only.
+void TestCase5(CIMRepository& r)
+{
+    if (verbose)
+    {
+        cout << "TestCase5" << endl;
+    }
+
+    Uint32 generation = r.getClassGeneration();
+
+    Array<CIMName> classNames;
+    r.getSubClassNames(NAMESPACE, CIMName ("TST_X"), true, classNames);
+    PEGASUS_TEST_ASSERT(classNames.size() == 6);
+    PEGASUS_TEST_ASSERT(r.getClassGeneration() == generation);
+
+    CreateClass(r, CIMName ("TST_U"), CIMName ("TST_T"));
+    PEGASUS_TEST_ASSERT(r.getClassGeneration() != generation);
+    generation = r.getClassGeneration();
+
+    classNames.clear();
+    r.getSubClassNames(NAMESPACE, CIMName ("TST_X"), true, classNames);
+    PEGASUS_TEST_ASSERT(classNames.size() == 7);
+
+    r.deleteClass(NAMESPACE, CIMName ("TST_U"));
+    PEGASUS_TEST_ASSERT(r.getClassGeneration() != generation);
+}
+
 int main(int argc, char** argv)
 {
     verbose = getenv("PEGASUS_TEST_VERBOSE") ? true : false;
@@ -257,6 +284,7 @@ int main(int argc, char** argv)
         TestCase2();
         TestCase3();
         TestCase4();
+        TestCase5(r);
     }
     catch (Exception& e)
     {
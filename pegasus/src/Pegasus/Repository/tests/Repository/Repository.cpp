@@ -35,6 +35,7 @@
     failure of delete of non-existant namespaced
     delete non-empty namespace (should fail)
     putting classes into namespace
+    SQLite store: statement cache, schema upgrade and namespace rename
 
 */
 #include <Pegasus/Common/Config.h>
@@ -42,6 +43,10 @@
 #include <Pegasus/Common/FileSystem.h>
 #include <Pegasus/Repository/CIMRepository.h>
 
+#ifdef PEGASUS_USE_SQLITE_REPOSITORY
+# include <Pegasus/Repository/SQLiteStore.h>
+#endif
+
 PEGASUS_USING_PEGASUS;
 PEGASUS_USING_STD;
 static Boolean verbose;
@@ -204,6 +209,203 @@ void test03(Uint32 mode)
     }
 }
 
+#ifdef PEGASUS_USE_SQLITE_REPOSITORY
+
+static sqlite3* _openDb(const String& dbPath)
+{
+    sqlite3* db = 0;
+    PEGASUS_TEST_ASSERT(
+        sqlite3_open((const char*)dbPath.getCString(), &db) == SQLITE_OK);
+    return db;
+}
+
+static void _execDb(sqlite3* db, const char* sqlStatement)
+{
+    PEGASUS_TEST_ASSERT(
+        sqlite3_exec(db, sqlStatement, 0, 0, 0) == SQLITE_OK);
+}
+
+static String _queryDb(sqlite3* db, const char* sqlStatement)
+{
+    sqlite3_stmt* stmt = 0;
+    PEGASUS_TEST_ASSERT(
+        sqlite3_prepare_v2(db, sqlStatement, -1, &stmt, 0) == SQLITE_OK);
+    PEGASUS_TEST_ASSERT(sqlite3_step(stmt) == SQLITE_ROW);
+    String result((const char*)sqlite3_column_text(stmt, 0));
+    sqlite3_finalize(stmt);
+    return result;
+}
+
+static const char INDEX_COUNT_STATEMENT[] =
+    "SELECT COUNT(*) FROM sqlite_master WHERE type='index' AND name IN("
+        "'InstanceClassIndex','ClassAssocFromIndex',"
+        "'InstanceAssocFromIndex');";
+
+static void _createTestClass(
+    CIMRepository& r,
+    const CIMNamespaceName& nameSpace)
+{
+    r.setQualifier(
+        nameSpace,
+        CIMQualifierDecl(CIMName("key"), true, CIMScope::PROPERTY));
+
+    CIMClass c(CIMName("TST_Item"));
+    c.addProperty(CIMProperty(CIMName("Id"), Uint32(0))
+        .addQualifier(CIMQualifier(CIMName("key"), true)));
+    r.createClass(nameSpace, c);
+}
+
+static void _createTestInstance(
+    CIMRepository& r,
+    const CIMNamespaceName& nameSpace,
+    Uint32 id)
+{
+    CIMInstance instance(CIMName("TST_Item"));
+    instance.addProperty(CIMProperty(CIMName("Id"), id));
+    r.createInstance(nameSpace, instance);
+}
+
+// Statements are cached by their SQL text, not by its address.
+void testStatementCache()
+{
+    sqlite3* db = 0;
+    PEGASUS_TEST_ASSERT(sqlite3_open(":memory:", &db) == SQLITE_OK);
+    DbHandle handle(db);
+
+    sqlite3_stmt* stmt = handle.getStatement("SELECT 1;");
+
+    char sqlStatement[] = "SELECT 1;";
+    PEGASUS_TEST_ASSERT(handle.getStatement(sqlStatement) == stmt);
+
+    strcpy(sqlStatement, "SELECT 2;");
+    sqlite3_stmt* stmt2 = handle.getStatement(sqlStatement);
+    PEGASUS_TEST_ASSERT(stmt2 != stmt);
+    PEGASUS_TEST_ASSERT(sqlite3_step(stmt2) == SQLITE_ROW);
+    PEGASUS_TEST_ASSERT(sqlite3_column_int(stmt2, 0) == 2);
+    sqlite3_reset(stmt2);
+
+    PEGASUS_TEST_ASSERT(handle.getStatement("SELECT 2;") == stmt2);
+}
+
+// A namespace database at schema version 0 (no indexes, rollback journal)
+// is upgraded to version 1 when the repository is opened.
+void testSchemaUpgrade(Uint32 mode)
+{
+    const CIMNamespaceName NAMESPACE("test/upgrade");
+    const String dbPath = repositoryRoot + "/test#upgrade.db";
+
+    {
+        CIMRepository r(repositoryRoot, mode);
+        r.createNameSpace(NAMESPACE);
+        _createTestClass(r, NAMESPACE);
+        _createTestInstance(r, NAMESPACE, 1);
+    }
+
+    sqlite3* db = _openDb(dbPath);
+    PEGASUS_TEST_ASSERT(_queryDb(db, "PRAGMA user_version;") == "1");
+    PEGASUS_TEST_ASSERT(_queryDb(db, INDEX_COUNT_STATEMENT) == "3");
+    PEGASUS_TEST_ASSERT(_queryDb(db, "PRAGMA journal_mode;") == "wal");
+
+    _execDb(db, "PRAGMA journal_mode=DELETE;");
+    _execDb(db, "DROP INDEX InstanceClassIndex;");
+    _execDb(db, "DROP INDEX ClassAssocFromIndex;");
+    _execDb(db, "DROP INDEX InstanceAssocFromIndex;");
+    _execDb(db, "PRAGMA user_version=0;");
+    PEGASUS_TEST_ASSERT(_queryDb(db, INDEX_COUNT_STATEMENT) == "0");
+    PEGASUS_TEST_ASSERT(sqlite3_close(db) == SQLITE_OK);
+
+    {
+        CIMRepository r(repositoryRoot, mode);
+
+        db = _openDb(dbPath);
+        PEGASUS_TEST_ASSERT(_queryDb(db, "PRAGMA user_version;") == "1");
+        PEGASUS_TEST_ASSERT(_queryDb(db, INDEX_COUNT_STATEMENT) == "3");
+        PEGASUS_TEST_ASSERT(_queryDb(db, "PRAGMA journal_mode;") == "wal");
+        PEGASUS_TEST_ASSERT(sqlite3_close(db) == SQLITE_OK);
+
+        // The upgraded database remains usable.
+        _createTestInstance(r, NAMESPACE, 2);
+        PEGASUS_TEST_ASSERT(r.enumerateInstanceNamesForClass(
+            NAMESPACE, CIMName("TST_Item")).size() == 2);
+
+        r.deleteInstance(NAMESPACE, CIMObjectPath("TST_Item.Id=1"));
+        r.deleteInstance(NAMESPACE, CIMObjectPath("TST_Item.Id=2"));
+        r.deleteClass(NAMESPACE, CIMName("TST_Item"));
+        r.deleteQualifier(NAMESPACE, CIMName("key"));
+        r.deleteNameSpace(NAMESPACE);
+    }
+}
+
+// Renaming a namespace closes its cached connections first, so later
+// changes go to the renamed database, no log is left under the old name and
+// a new namespace with the old name does not get a connection to the
+// renamed database.
+void testRenameNameSpace(Uint32 mode)
+{
+    const CIMNamespaceName NAMESPACE("test/rename");
+    const CIMNamespaceName NEW_NAMESPACE("test/renamed");
+    const String dbPath = repositoryRoot + "/test#rename.db";
+    const String newDbPath = repositoryRoot + "/test#renamed.db";
+
+    {
+        CIMRepository r(repositoryRoot, mode);
+        r.createNameSpace(NAMESPACE);
+        _createTestClass(r, NAMESPACE);
+        _createTestInstance(r, NAMESPACE, 1);
+        PEGASUS_TEST_ASSERT(r.enumerateInstanceNamesForClass(
+            NAMESPACE, CIMName("TST_Item")).size() == 1);
+
+        r.modifyNameSpaceName(NAMESPACE, NEW_NAMESPACE);
+
+        PEGASUS_TEST_ASSERT(!FileSystem::exists(dbPath));
+        PEGASUS_TEST_ASSERT(!FileSystem::exists(dbPath + "-wal"));
+        PEGASUS_TEST_ASSERT(!FileSystem::exists(dbPath + "-shm"));
+        PEGASUS_TEST_ASSERT(FileSystem::exists(newDbPath));
+
+        _createTestInstance(r, NEW_NAMESPACE, 2);
+        PEGASUS_TEST_ASSERT(r.enumerateInstanceNamesForClass(
+            NEW_NAMESPACE, CIMName("TST_Item")).size() == 2);
+
+        r.createNameSpace(NAMESPACE);
+        r.setQualifier(
+            NAMESPACE,
+            CIMQualifierDecl(CIMName("Extra"), true, CIMScope::CLASS));
+    }
+
+    PEGASUS_TEST_ASSERT(!FileSystem::exists(dbPath + "-wal"));
+
+    CIMRepository r(repositoryRoot, mode);
+    Array<CIMNamespaceName> nameSpaces = r.enumerateNameSpaces();
+    Uint32 found = 0;
+    for (Uint32 i = 0; i < nameSpaces.size(); i++)
+    {
+        if (nameSpaces[i] == NAMESPACE || nameSpaces[i] == NEW_NAMESPACE)
+        {
+            found++;
+        }
+    }
+    PEGASUS_TEST_ASSERT(found == 2);
+    PEGASUS_TEST_ASSERT(r.enumerateInstanceNamesForClass(
+        NEW_NAMESPACE, CIMName("TST_Item")).size() == 2);
+
+    Array<CIMQualifierDecl> qualifiers = r.enumerateQualifiers(NAMESPACE);
+    PEGASUS_TEST_ASSERT(qualifiers.size() == 1);
+    PEGASUS_TEST_ASSERT(qualifiers[0].getName() == CIMName("Extra"));
+    qualifiers = r.enumerateQualifiers(NEW_NAMESPACE);
+    PEGASUS_TEST_ASSERT(qualifiers.size() == 1);
+    PEGASUS_TEST_ASSERT(qualifiers[0].getName() == CIMName("key"));
+
+    r.deleteQualifier(NAMESPACE, CIMName("Extra"));
+    r.deleteNameSpace(NAMESPACE);
+
+    r.deleteInstance(NEW_NAMESPACE, CIMObjectPath("TST_Item.Id=1"));
+    r.deleteInstance(NEW_NAMESPACE, CIMObjectPath("TST_Item.Id=2"));
+    r.deleteClass(NEW_NAMESPACE, CIMName("TST_Item"));
+    r.deleteQualifier(NEW_NAMESPACE, CIMName("key"));
+    r.deleteNameSpace(NEW_NAMESPACE);
+}
+
+#endif /* PEGASUS_USE_SQLITE_REPOSITORY */
 
 int main(int argc, char** argv)
 {
@@ -250,6 +452,12 @@ int main(int argc, char** argv)
       test01(mode);
       test02(mode);
 
+#ifdef PEGASUS_USE_SQLITE_REPOSITORY
+      testStatementCache();
+      testSchemaUpgrade(mode);
+      testRenameNameSpace(mode);
+#endif
+
       // bug 4206 - test03 removed because it usees the repository
       // in PEGASUS_HOME which should not be done in unit tests.
       // Additionally: There is are unit test under the Pegasus/Compiler
@@ -810,6 +810,155 @@ void TestQualifiers(Uint32 mode)
     r.deleteNameSpace(NS);
 }
 
+static CIMInstance _makeTransactionInstance(Uint32 key, const String& value)
+{
+    CIMInstance instance(CIMName("TST_Transaction"));
+    instance.addProperty(CIMProperty(CIMName("key"), key));
+    instance.addProperty(CIMProperty(CIMName("value"), value));
+
+    Array<CIMKeyBinding> keys;
+    keys.append(CIMKeyBinding(CIMName("key"), CIMValue(key)));
+    instance.setPath(
+        CIMObjectPath(String(), CIMNamespaceName(), instance.getClassName(),
+            keys));
+    return instance;
+}
+
+void TestInstanceTransactions(Uint32 mode)
+{
+    //
+    // -- Create repository and test namespace:
+    //
+    CIMRepository r(repositoryRoot, mode);
+    const CIMNamespaceName NS = CIMNamespaceName("TestInstanceTransactions");
+    const CIMName CLASSNAME = CIMName("TST_Transaction");
+
+    r.createNameSpace(NS);
+    r.setQualifier(NS, CIMQualifierDecl(CIMName("key"), true,
+        CIMScope::PROPERTY));
+
+    CIMClass c(CLASSNAME);
+    c.addProperty(CIMProperty(CIMName("key"), Uint32(0))
+        .addQualifier(CIMQualifier(CIMName("key"), true)));
+    c.addProperty(CIMProperty(CIMName("value"), String()));
+    r.createClass(NS, c);
+
+    //
+    // -- Committed changes are kept:
+    //
+    r.beginInstanceTransaction(NS);
+    CIMObjectPath path1 =
+        r.createInstance(NS, _makeTransactionInstance(1, "one"));
+    CIMObjectPath path2 =
+        r.createInstance(NS, _makeTransactionInstance(2, "two"));
+    r.createInstance(NS, _makeTransactionInstance(3, "three"));
+    r.modifyInstance(NS, _makeTransactionInstance(2, "TWO"));
+
+    // Changes are visible to the owner of the transaction
+    PEGASUS_TEST_ASSERT(
+        r.enumerateInstanceNamesForClass(NS, CLASSNAME).size() == 3);
+    r.commitInstanceTransaction();
+
+    PEGASUS_TEST_ASSERT(
+        r.enumerateInstanceNamesForClass(NS, CLASSNAME).size() == 3);
+    CIMInstance instance = r.getInstance(NS, path2);
+    String value;
+    instance.getProperty(instance.findProperty("value")).getValue().get(value);
+    PEGASUS_TEST_ASSERT(value == "TWO");
+
+    //
+    // -- Rolled back changes are discarded:
+    //
+    r.beginInstanceTransaction(NS);
+    r.createInstance(NS, _makeTransactionInstance(4, "four"));
+    r.deleteInstance(NS, path1);
+    r.modifyInstance(NS, _makeTransactionInstance(2, "two"));
+    r.rollbackInstanceTransaction();
+
+    PEGASUS_TEST_ASSERT(
+        r.enumerateInstanceNamesForClass(NS, CLASSNAME).size() == 3);
+    r.getInstance(NS, path1);
+    instance = r.getInstance(NS, path2);
+    instance.getProperty(instance.findProperty("value")).getValue().get(value);
+    PEGASUS_TEST_ASSERT(value == "TWO");
+
+    //
+    // -- A change rejected before the store is changed does not end the
+    //    transaction:
+    //
+    r.beginInstanceTransaction(NS);
+    try
+    {
+        r.createInstance(NS, _makeTransactionInstance(1, "one"));
+        PEGASUS_TEST_ASSERT(false);
+    }
+    catch (CIMException& e)
+    {
+        PEGASUS_TEST_ASSERT(e.getCode() == CIM_ERR_ALREADY_EXISTS);
+    }
+    r.createInstance(NS, _makeTransactionInstance(4, "four"));
+    try
+    {
+        r.deleteInstance(NS, _makeTransactionInstance(5, "five").getPath());
+        PEGASUS_TEST_ASSERT(false);
+    }
+    catch (CIMException& e)
+    {
+        PEGASUS_TEST_ASSERT(e.getCode() == CIM_ERR_NOT_FOUND);
+    }
+    r.modifyInstance(NS, _makeTransactionInstance(3, "THREE"));
+    r.commitInstanceTransaction();
+
+    PEGASUS_TEST_ASSERT(
+        r.enumerateInstanceNamesForClass(NS, CLASSNAME).size() == 4);
+    instance = r.getInstance(NS, _makeTransactionInstance(3, "").getPath());
+    instance.getProperty(instance.findProperty("value")).getValue().get(value);
+    PEGASUS_TEST_ASSERT(value == "THREE");
+
+    //
+    // -- Errors:
+    //
+    try
+    {
+        r.commitInstanceTransaction();
+        PEGASUS_TEST_ASSERT(false);
+    }
+    catch (CIMException& e)
+    {
+        PEGASUS_TEST_ASSERT(e.getCode() == CIM_ERR_FAILED);
+    }
+
+    try
+    {
+        r.beginInstanceTransaction(CIMNamespaceName("NoSuchNameSpace"));
+        PEGASUS_TEST_ASSERT(false);
+    }
+    catch (CIMException& e)
+    {
+        PEGASUS_TEST_ASSERT(e.getCode() == CIM_ERR_INVALID_NAMESPACE);
+    }
+
+    // Rolling back without a transaction has no effect
+    r.rollbackInstanceTransaction();
+
+    //
+    // -- Clean up:
+    //
+    r.beginInstanceTransaction(NS);
+    Array<CIMObjectPath> paths = r.enumerateInstanceNamesForClass(NS, CLASSNAME);
+    for (Uint32 i = 0; i < paths.size(); i++)
+    {
+        r.deleteInstance(NS, paths[i]);
+    }
+    r.commitInstanceTransaction();
+
+    PEGASUS_TEST_ASSERT(
+        r.enumerateInstanceNamesForClass(NS, CLASSNAME).size() == 0);
+
+    r.deleteClass(NS, CLASSNAME);
+    r.deleteQualifier(NS, CIMName("key"));
+    r.deleteNameSpace(NS);
+}
 
 int main(int argc, char** argv)
 {
@@ -857,6 +1006,7 @@ int main(int argc, char** argv)
     TestCreateClass(mode);
     TestModifyClass(mode);
     TestQualifiers(mode);
+    TestInstanceTransactions(mode);
 
     }
     catch (Exception& e)
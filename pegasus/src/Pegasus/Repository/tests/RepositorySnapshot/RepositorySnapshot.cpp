@@ -0,0 +1,333 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+/*
+    This test exercises the repository snapshot.  It verifies that a
+    CIMRepository saves a snapshot on startup, initializes its namespaces
+    from the snapshot, removes the snapshot when classes or namespaces
+    change, and ignores an invalid snapshot.
+*/
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/PegasusAssert.h>
+#include <Pegasus/Common/FileSystem.h>
+#include <Pegasus/Repository/CIMRepository.h>
+#include <Pegasus/Repository/RepositorySnapshot.h>
+
+PEGASUS_USING_PEGASUS;
+PEGASUS_USING_STD;
+
+static Boolean verbose;
+
+static String repositoryRoot;
+static String snapshotPath;
+
+static const CIMNamespaceName PRIMARY = CIMNamespaceName("test/snapshot");
+static const CIMNamespaceName SECONDARY =
+    CIMNamespaceName("test/snapshot/secondary");
+
+static void createClass(
+    CIMRepository& r,
+    const CIMNamespaceName& nameSpace,
+    const CIMName& className,
+    const CIMName& superClassName = CIMName())
+{
+    CIMClass c(className, superClassName);
+    r.createClass(nameSpace, c);
+}
+
+static Array<CIMName> getClassNames(
+    CIMRepository& r,
+    const CIMNamespaceName& nameSpace)
+{
+    Array<CIMName> classNames =
+        r.enumerateClassNames(nameSpace, CIMName(), true);
+    BubbleSort(classNames);
+    return classNames;
+}
+
+static Array<CIMName> makeClassNames(const char* const* names)
+{
+    Array<CIMName> classNames;
+    for (; *names; names++)
+    {
+        classNames.append(CIMName(*names));
+    }
+    BubbleSort(classNames);
+    return classNames;
+}
+
+static void verifyRepository(CIMRepository& r, const char* const* names)
+{
+    Array<CIMName> expected = makeClassNames(names);
+    PEGASUS_TEST_ASSERT(getClassNames(r, PRIMARY) == expected);
+
+    CIMRepository::NameSpaceAttributes attributes;
+    PEGASUS_TEST_ASSERT(r.getNameSpaceAttributes(SECONDARY, attributes));
+    String parent;
+    PEGASUS_TEST_ASSERT(attributes.lookup("parent", parent));
+    PEGASUS_TEST_ASSERT(parent == PRIMARY.getString());
+
+    PEGASUS_TEST_ASSERT(r.nameSpaceExists("root"));
+
+    // The secondary namespace sees the classes of its parent.
+    PEGASUS_TEST_ASSERT(r.getClass(SECONDARY, CIMName("TST_B"),
+        false).getSuperClassName() == CIMName("TST_A"));
+}
+
+static void testSaveAndLoad()
+{
+    static const char* const names[] = { "TST_A", "TST_B", "TST_C", 0 };
+
+    {
+        // The repository was initialized from the persistent store and
+        // saved a snapshot.
+        CIMRepository r(repositoryRoot);
+        PEGASUS_TEST_ASSERT(FileSystem::exists(snapshotPath));
+        verifyRepository(r, names);
+    }
+
+    // The snapshot holds the namespaces in initialization order.
+    RepositorySnapshot snapshot(repositoryRoot);
+    PEGASUS_TEST_ASSERT(snapshot.load());
+    const Array<NamespaceDefinition>& nameSpaces = snapshot.getNameSpaces();
+    Uint32 primary = PEG_NOT_FOUND;
+    Uint32 secondary = PEG_NOT_FOUND;
+    for (Uint32 i = 0; i < nameSpaces.size(); i++)
+    {
+        if (nameSpaces[i].name == PRIMARY)
+        {
+            primary = i;
+            PEGASUS_TEST_ASSERT(nameSpaces[i].shareable);
+            PEGASUS_TEST_ASSERT(snapshot.getClassNames(i).size() == 3);
+        }
+        else if (nameSpaces[i].name == SECONDARY)
+        {
+            secondary = i;
+            PEGASUS_TEST_ASSERT(nameSpaces[i].parentNameSpace == PRIMARY);
+            PEGASUS_TEST_ASSERT(snapshot.getClassNames(i).size() == 0);
+        }
+    }
+    PEGASUS_TEST_ASSERT(primary != PEG_NOT_FOUND);
+    PEGASUS_TEST_ASSERT(secondary != PEG_NOT_FOUND);
+    PEGASUS_TEST_ASSERT(primary < secondary);
+
+    {
+        // Initialized from the snapshot
+        CIMRepository r(repositoryRoot);
+        verifyRepository(r, names);
+    }
+}
+
+static void testSnapshotIsUsed()
+{
+    // Replace the snapshot with one that has an additional class that is
+    // not in the persistent store.  A repository initialized from the
+    // snapshot reports it.
+
+    RepositorySnapshot snapshot(repositoryRoot);
+    PEGASUS_TEST_ASSERT(snapshot.load());
+    Array<NamespaceDefinition> nameSpaces = snapshot.getNameSpaces();
+
+    RepositorySnapshot modified(repositoryRoot);
+    for (Uint32 i = 0; i < nameSpaces.size(); i++)
+    {
+        Array<Pair<String, String> > classList = snapshot.getClassNames(i);
+        if (nameSpaces[i].name == PRIMARY)
+        {
+            classList.append(Pair<String, String>("TST_Snapshot", "TST_A"));
+        }
+        modified.addNameSpace(nameSpaces[i], classList);
+    }
+    PEGASUS_TEST_ASSERT(modified.save());
+
+    static const char* const names[] =
+        { "TST_A", "TST_B", "TST_C", "TST_Snapshot", 0 };
+    CIMRepository r(repositoryRoot);
+    verifyRepository(r, names);
+
+    // Restore a valid snapshot
+    FileSystem::removeFile(snapshotPath);
+}
+
+static void testInvalidation()
+{
+    static const char* const names[] =
+        { "TST_A", "TST_B", "TST_C", "TST_D", 0 };
+
+    {
+        CIMRepository r(repositoryRoot);
+        PEGASUS_TEST_ASSERT(FileSystem::exists(snapshotPath));
+
+        createClass(r, PRIMARY, CIMName("TST_D"), CIMName("TST_C"));
+        PEGASUS_TEST_ASSERT(!FileSystem::exists(snapshotPath));
+    }
+
+    {
+        CIMRepository r(repositoryRoot);
+        PEGASUS_TEST_ASSERT(FileSystem::exists(snapshotPath));
+        verifyRepository(r, names);
+
+        r.deleteClass(PRIMARY, CIMName("TST_D"));
+        PEGASUS_TEST_ASSERT(!FileSystem::exists(snapshotPath));
+    }
+
+    {
+        CIMRepository r(repositoryRoot);
+        r.createNameSpace(CIMNamespaceName("test/snapshot2"));
+        PEGASUS_TEST_ASSERT(!FileSystem::exists(snapshotPath));
+    }
+
+    {
+        CIMRepository r(repositoryRoot);
+        PEGASUS_TEST_ASSERT(r.nameSpaceExists("test/snapshot2"));
+        r.deleteNameSpace(CIMNamespaceName("test/snapshot2"));
+        PEGASUS_TEST_ASSERT(!FileSystem::exists(snapshotPath));
+    }
+
+    {
+        CIMRepository r(repositoryRoot);
+        PEGASUS_TEST_ASSERT(!r.nameSpaceExists("test/snapshot2"));
+    }
+}
+
+static void testInvalidSnapshot()
+{
+    static const char* const names[] = { "TST_A", "TST_B", "TST_C", 0 };
+
+    {
+        CIMRepository r(repositoryRoot);
+    }
+
+    // Change one byte of the contents; the checksum no longer matches.
+    Buffer data;
+    FileSystem::loadFileToMemory(data, snapshotPath);
+    PEGASUS_TEST_ASSERT(data.size() > 40);
+    data.set(data.size() - 2, data[data.size() - 2] ^ 0x20);
+    FILE* fp = fopen(snapshotPath.getCString(), "wb");
+    PEGASUS_TEST_ASSERT(fp);
+    PEGASUS_TEST_ASSERT(
+        fwrite(data.getData(), 1, data.size(), fp) == data.size());
+    fclose(fp);
+
+    RepositorySnapshot snapshot(repositoryRoot);
+    PEGASUS_TEST_ASSERT(!snapshot.load());
+
+    {
+        // Initialized from the persistent store, saves a new snapshot
+        CIMRepository r(repositoryRoot);
+        verifyRepository(r, names);
+    }
+
+    PEGASUS_TEST_ASSERT(snapshot.load());
+
+    // A truncated snapshot is ignored as well.
+    fp = fopen(snapshotPath.getCString(), "wb");
+    PEGASUS_TEST_ASSERT(fp);
+    PEGASUS_TEST_ASSERT(fwrite(data.getData(), 1, 30, fp) == 30);
+    fclose(fp);
+    PEGASUS_TEST_ASSERT(!snapshot.load());
+
+    {
+        CIMRepository r(repositoryRoot);
+        verifyRepository(r, names);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    verbose = getenv("PEGASUS_TEST_VERBOSE") ? true : false;
+
+    const char* tmpDir = getenv("PEGASUS_TMP");
+    repositoryRoot = tmpDir ? tmpDir : ".";
+    repositoryRoot.append("/repository");
+    snapshotPath = repositoryRoot + "/" + PEGASUS_REPOSITORY_SNAPSHOT_FILE;
+
+    FileSystem::removeDirectoryHier(repositoryRoot);
+
+    try
+    {
+        {
+            CIMRepository r(repositoryRoot);
+
+            CIMRepository::NameSpaceAttributes attributes;
+            attributes.insert("shareable", "true");
+            r.createNameSpace(PRIMARY, attributes);
+
+            createClass(r, PRIMARY, CIMName("TST_A"));
+            createClass(r, PRIMARY, CIMName("TST_B"), CIMName("TST_A"));
+            createClass(r, PRIMARY, CIMName("TST_C"), CIMName("TST_B"));
+
+            CIMRepository::NameSpaceAttributes secondaryAttributes;
+            secondaryAttributes.insert("parent", PRIMARY.getString());
+            r.createNameSpace(SECONDARY, secondaryAttributes);
+
+            PEGASUS_TEST_ASSERT(!FileSystem::exists(snapshotPath));
+        }
+
+        testSaveAndLoad();
+        if (verbose)
+        {
+            cout << "testSaveAndLoad passed" << endl;
+        }
+
+        testSnapshotIsUsed();
+        if (verbose)
+        {
+            cout << "testSnapshotIsUsed passed" << endl;
+        }
+
+        testInvalidation();
+        if (verbose)
+        {
+            cout << "testInvalidation passed" << endl;
+        }
+
+        testInvalidSnapshot();
+        if (verbose)
+        {
+            cout << "testInvalidSnapshot passed" << endl;
+        }
+    }
+    catch (Exception& e)
+    {
+        cout << "Exception " << e.getMessage() << endl;
+        PEGASUS_TEST_ASSERT(false);
+    }
+
+    FileSystem::removeDirectoryHier(repositoryRoot);
+
+    cout << argv[0] << " +++++ passed all tests" << endl;
+
+    return 0;
+}
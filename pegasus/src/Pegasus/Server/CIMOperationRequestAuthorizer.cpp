@@ -89,7 +89,9 @@ void CIMOperationRequestAuthorizer::sendResponse(
 
     if (queue)
     {
-        queue->enqueue(new HTTPMessage(message));
+        HTTPMessage* httpMessage = new HTTPMessage(message);
+        httpMessage->dest = queueId;
+        queue->enqueue(httpMessage);
     }
 
     PEG_METHOD_EXIT();
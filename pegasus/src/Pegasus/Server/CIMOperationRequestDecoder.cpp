@@ -328,6 +328,7 @@ void CIMOperationRequestDecoder::sendResponse(
     if (queue)
     {
         AutoPtr<HTTPMessage> httpMessage(new HTTPMessage(message));
+        httpMessage->dest = queueId;
         httpMessage->setCloseConnect(closeConnect);
         queue->enqueue(httpMessage.release());
     }
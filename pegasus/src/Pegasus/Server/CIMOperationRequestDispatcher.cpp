@@ -39,6 +39,9 @@
 #include <Pegasus/Common/AuditLogger.h>
 #include <Pegasus/Common/Tracer.h>
 #include <Pegasus/Common/ObjectNormalizer.h>
+#include <Pegasus/Common/CIMNameInterner.h>
+#include <Pegasus/Common/HashTable.h>
+#include <Pegasus/Common/ReadWriteSem.h>
 #include <Pegasus/Server/reg_table.h>
 #include <Pegasus/General/VersionUtil.h>
 #include <ctime>
@@ -112,6 +115,98 @@ private:
 // characteristics.
 static Boolean requireCompleteResponses = false;
 
+/******************************************************************************
+**
+**  SubClassNameCache - deep subclass name lists of the classes enumerated
+**      through the dispatcher.  The whole cache is valid for a single class
+**      generation of the repository and is emptied when a list obtained for
+**      a later generation is inserted, so repeated enumerations of the same
+**      class do not walk the inheritance tree until a class or namespace
+**      changes.
+**
+******************************************************************************/
+
+struct SubClassNameKey
+{
+    SubClassNameKey(
+        const CIMNamespaceName& nameSpace_,
+        const CIMName& className_)
+        : nameSpace(nameSpace_), className(className_)
+    {
+    }
+
+    CIMNamespaceName nameSpace;
+    CIMName className;
+};
+
+struct SubClassNameKeyEqual
+{
+    static Boolean equal(const SubClassNameKey& x, const SubClassNameKey& y)
+    {
+        return x.className.equal(y.className) &&
+            x.nameSpace.equal(y.nameSpace);
+    }
+};
+
+struct SubClassNameKeyHash
+{
+    static Uint32 hash(const SubClassNameKey& key)
+    {
+        return HashLowerCaseFunc::hash(key.className.getString()) * 31 +
+            HashLowerCaseFunc::hash(key.nameSpace.getString());
+    }
+};
+
+struct SubClassNameCache
+{
+    SubClassNameCache() : _generation(0)
+    {
+    }
+
+    Boolean lookup(
+        Uint32 generation,
+        const CIMNamespaceName& nameSpace,
+        const CIMName& className,
+        Array<CIMName>& subClassNames)
+    {
+        ReadLock lock(_lock);
+        return generation == _generation &&
+            _table.lookup(SubClassNameKey(nameSpace, className), subClassNames);
+    }
+
+    void insert(
+        Uint32 generation,
+        const CIMNamespaceName& nameSpace,
+        const CIMName& className,
+        const Array<CIMName>& subClassNames)
+    {
+        WriteLock lock(_lock);
+
+        if (generation != _generation)
+        {
+            // Drop lists obtained for a generation older than the cache
+            if (Sint32(generation - _generation) < 0)
+            {
+                return;
+            }
+
+            _table.clear();
+            _generation = generation;
+        }
+
+        _table.insert(SubClassNameKey(nameSpace, className), subClassNames);
+    }
+
+private:
+
+    typedef HashTable<SubClassNameKey, Array<CIMName>,
+        SubClassNameKeyEqual, SubClassNameKeyHash> Table;
+
+    ReadWriteSem _lock;
+    Uint32 _generation;
+    Table _table;
+};
+
 // A helper function that resets the Propagated and ClassOrigin attributes on
 // properties of CIMInstance and CIMClass objects. This is used during
 // Create/Modify Instance and Create/Modify Class operations, where the
@@ -548,6 +643,8 @@ CIMOperationRequestDispatcher::CIMOperationRequestDispatcher(
     _enumerationContextTable = EnumerationContextTable::getInstance();
 //EXP_PULL_END
 
+    _subClassNameCache = new SubClassNameCache();
+
     //
     // Setup list of provider modules that will be excluded from normalization
     // List derived from runtime variable with format name, name, ....
@@ -593,6 +690,8 @@ CIMOperationRequestDispatcher::~CIMOperationRequestDispatcher()
     _enumerationContextTable->removeContextTable();
     delete _enumerationContextTable;
 
+    delete _subClassNameCache;
+
     PEG_METHOD_EXIT();
 }
 
@@ -1329,18 +1428,37 @@ Array<CIMName> CIMOperationRequestDispatcher::_getSubClassNames(
     // Ignore if the special class __Namespace because it works in very
     // strange way.  NOTE: This class is also deprecated in DSP0200.
     //
-    if (!className.equal (PEGASUS_CLASSNAME___NAMESPACE))
+    if (className.equal (PEGASUS_CLASSNAME___NAMESPACE))
+    {
+        subClassNames.append(className);
+        PEG_METHOD_EXIT();
+        return subClassNames;
+    }
+
+    // The generation is read before the subclass names so that a list
+    // obtained while a class is changed is never cached for the
+    // generation following the change.
+    Uint32 generation = _repository->getClassGeneration();
+
+    if (_subClassNameCache->lookup(
+            generation, nameSpace, className, subClassNames))
     {
-        // Get the complete list of subclass names
-        // getSubClassNames throws an exception if the class does not exist
-        _repository->getSubClassNames(nameSpace,
-             className, true, subClassNames);
+        PEG_METHOD_EXIT();
+        return subClassNames;
     }
 
+    // Get the complete list of subclass names
+    // getSubClassNames throws an exception if the class does not exist
+    _repository->getSubClassNames(nameSpace,
+         className, true, subClassNames);
+
     // Prepend the array with the classname from the request so
     // return is this class and all subclasses
     subClassNames.prepend(className);
 
+    _subClassNameCache->insert(
+        generation, nameSpace, className, subClassNames);
+
     PEG_METHOD_EXIT();
     return subClassNames;
 }
@@ -2362,6 +2480,13 @@ void CIMOperationRequestDispatcher::handleEnqueue(Message* request)
         // in the correct language.
         opRequest->updateThreadLanguages();
 
+        // Share the interned representation of the target names, so that
+        // the class and namespace lookups made for the request compare them
+        // by reference.  The names come from the client and are not yet
+        // validated, so only names the repository has interned are shared.
+        opRequest->nameSpace = CIMNameInterner::lookup(opRequest->nameSpace);
+        opRequest->className = CIMNameInterner::lookup(opRequest->className);
+
         switch (opRequest->getType())
         {
         case CIM_GET_CLASS_REQUEST_MESSAGE:
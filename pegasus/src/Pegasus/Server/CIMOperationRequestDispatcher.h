@@ -65,6 +65,10 @@ PEGASUS_USING_STD;
 //
 #define CSTRING(ARG) (const char*) ARG.getCString()
 
+// Cache of the subclass name lists returned by _getSubClassNames().  Defined
+// in the dispatcher implementation.
+struct SubClassNameCache;
+
 /******************************************************************************
 **
 **  ProviderInfo Class - manage info about classes and providers received
@@ -720,7 +724,9 @@ protected:
 
     /** _getSubClassNames - Gets the names of all subclasses of the defined
         class (including the class) and returns it in an array of strings. Uses
-        a similar function in the repository class to get the names.
+        a similar function in the repository class to get the names and
+        caches the result until the class generation of the repository
+        changes.
         @param namespace
         @param className
         @return Array of strings with class names.  Note that there should be
@@ -1139,6 +1145,10 @@ private:
     // Pointer to internal RoutingTable for Control Providers and Services
     DynamicRoutingTable *_routing_table;
 
+    // Subclass name lists by namespace and class, valid for one class
+    // generation of the repository.
+    SubClassNameCache* _subClassNameCache;
+
     // internal bool that defines whether handleEnqueue will delete
     // the original request.  Used because in some cases the handler
     // retains the request beyond the life of the handleEnqueue call.
@@ -239,9 +239,8 @@ void CIMOperationResponseEncoder::sendResponsePull(
         // Note:  The WMI Mapper may use a non-HTTPConnection queue here.
         if (httpQueue)
         {
-            isChunkRequest = httpQueue->isChunkRequested();
-            isFirstError =
-                (httpQueue->cimException.getCode() == CIM_ERR_SUCCESS);
+            isChunkRequest = httpQueue->isChunkRequested(queueId);
+            isFirstError = !httpQueue->hasResponseError(queueId);
         }
 
         // only process the FIRST error
@@ -349,6 +348,7 @@ void CIMOperationResponseEncoder::sendResponsePull(
     }
 
     httpMessage->setCloseConnect(closeConnect);
+    httpMessage->dest = queueId;
 
     queue->enqueue(httpMessage.release());
 
@@ -380,7 +380,7 @@ void CIMOperationResponseEncoder::enqueue(Message* message)
 
         // Handle internal error on this connection.
         httpQueue->handleInternalServerError(
-            response->getIndex(), response->isComplete());
+            queueId, response->getIndex(), response->isComplete());
 
         delete message;
     }
@@ -124,7 +124,7 @@ void HTTPAuthenticatorDelegator::_sendResponse(
     if (queue)
     {
         HTTPMessage* httpMessage = new HTTPMessage(message);
-        httpMessage->dest = queue->getQueueId();
+        httpMessage->dest = queueId;
 
         httpMessage->setCloseConnect(closeConnect);
 
@@ -1244,7 +1244,7 @@ void HTTPAuthenticatorDelegator::handleHTTPMessage(
                              MessageQueue::lookup(queueId));
                     if (httpQueue)
                     {
-                        httpQueue->handleInternalServerError(0, true);
+                        httpQueue->handleInternalServerError(queueId, 0, true);
                     }
                     PEG_METHOD_EXIT();
                     deleteMessage = false;
@@ -1308,7 +1308,7 @@ void HTTPAuthenticatorDelegator::handleHTTPMessage(
                              MessageQueue::lookup(queueId));
                     if (httpQueue)
                     {
-                        httpQueue->handleInternalServerError(0, true);
+                        httpQueue->handleInternalServerError(queueId, 0, true);
                     }
                     PEG_METHOD_EXIT();
                     deleteMessage = false;
@@ -1387,7 +1387,7 @@ void HTTPAuthenticatorDelegator::handleHTTPMessage(
                              MessageQueue::lookup(queueId));
                     if (httpQueue)
                     {
-                        httpQueue->handleInternalServerError(0, true);
+                        httpQueue->handleInternalServerError(queueId, 0, true);
                     }
                     PEG_METHOD_EXIT();
                     deleteMessage = false;
@@ -1418,7 +1418,7 @@ void HTTPAuthenticatorDelegator::handleHTTPMessage(
                              MessageQueue::lookup(queueId));
                     if (httpQueue)
                     {
-                        httpQueue->handleInternalServerError(0, true);
+                        httpQueue->handleInternalServerError(queueId, 0, true);
                     }
                     PEG_METHOD_EXIT();
                     deleteMessage = false;
@@ -48,6 +48,7 @@
 #include <Pegasus/Repository/CIMRepository.h>
 #include <Pegasus/Common/MessageLoader.h>
 #include <Pegasus/Common/CIMNameCast.h>
+#include <Pegasus/Common/CIMNameInterner.h>
 
 #include <Pegasus/Server/ProviderRegistrationManager/ProviderManagerMap.h>
 
@@ -132,6 +133,107 @@ struct RegistrationTable
     Table table;
 };
 
+/**
+    The routing index resolves lookupInstanceProvider() for the instance,
+    instance query and association provider capabilities in the registration
+    table.  For each namespace and class name with such a capability, it
+    holds the provider and provider module instances of the capabilities, so
+    that a lookup is a single hash table probe on the names, rather than the
+    construction of lower-cased keys and three probes of the registration
+    table under the _registrationTableLock.
+*/
+struct ProviderRoutingKey
+{
+    ProviderRoutingKey(
+        const CIMNamespaceName& nameSpace_,
+        const CIMName& className_)
+        : nameSpace(nameSpace_), className(className_)
+    {
+    }
+
+    CIMNamespaceName nameSpace;
+    CIMName className;
+};
+
+struct ProviderRoutingKeyEqual
+{
+    static Boolean equal(
+        const ProviderRoutingKey& x,
+        const ProviderRoutingKey& y)
+    {
+        return x.className.equal(y.className) &&
+            x.nameSpace.equal(y.nameSpace);
+    }
+};
+
+struct ProviderRoutingKeyHash
+{
+    static Uint32 hash(const ProviderRoutingKey& key)
+    {
+        return HashLowerCaseFunc::hash(key.className.getString()) * 31 +
+            HashLowerCaseFunc::hash(key.nameSpace.getString());
+    }
+};
+
+struct ProviderRoute
+{
+    ProviderRoute() : registered(false)
+    {
+    }
+
+    // True if a capability is registered.  The provider is uninitialized
+    // if the provider or provider module of the capability is not.
+    Boolean registered;
+    CIMInstance provider;
+    CIMInstance providerModule;
+};
+
+struct ProviderRoutes
+{
+    ProviderRoute instance;
+    ProviderRoute instanceQuery;
+    ProviderRoute association;
+};
+
+struct ProviderRoutingIndex
+{
+    ProviderRoutingIndex() : complete(true)
+    {
+    }
+
+    typedef HashTable<ProviderRoutingKey, ProviderRoutes,
+        ProviderRoutingKeyEqual, ProviderRoutingKeyHash> Table;
+
+    Table table;
+
+    // False if a capability in the registration table could not be
+    // indexed; the index then answers only the lookups it holds routes for.
+    Boolean complete;
+};
+
+/**
+    Rebuilds the routing index of a ProviderRegistrationManager when it goes
+    out of scope, so that the index follows the registration table also
+    when a modification of the table fails part way.  It must be declared
+    after the WriteLock of the _registrationTableLock.
+*/
+class RoutingIndexRebuilder
+{
+public:
+    RoutingIndexRebuilder(ProviderRegistrationManager* manager)
+        : _manager(manager)
+    {
+    }
+
+    ~RoutingIndexRebuilder()
+    {
+        _manager->_rebuildRoutingIndex();
+    }
+
+private:
+    ProviderRegistrationManager* _manager;
+};
+
 Boolean containsCIMInstance (
     const Array <CIMInstance> & instanceArray,
     const CIMInstance & instance)
@@ -314,6 +416,7 @@ ProviderRegistrationManager::ProviderRegistrationManager(
     _registrationTable = new RegistrationTable;
 
     WriteLock lock(_registrationTableLock);
+    RoutingIndexRebuilder rebuilder(this);
 
     //
     // get all registered providers from repository and add them to the table
@@ -439,6 +542,15 @@ Boolean ProviderRegistrationManager::lookupInstanceProvider(
     PEG_METHOD_ENTER(TRC_PROVIDERMANAGER,
         "ProviderRegistrationManager::lookupInstanceProvider");
 
+    Boolean found;
+
+    if (_lookupRoutingIndex(nameSpace, className, is_assoc, has_no_query,
+            found, provider, providerModule))
+    {
+        PEG_METHOD_EXIT();
+        return found;
+    }
+
     ReadLock lock(_registrationTableLock);
 
     ProviderRegistrationTable* providerCapability = 0;
@@ -1439,6 +1551,7 @@ CIMObjectPath ProviderRegistrationManager::createInstance(
     // lock resulting the deadlock.
     {
         WriteLock lock(_registrationTableLock);
+        RoutingIndexRebuilder rebuilder(this);
         cimRef = _createInstance(ref, createdInstance, OP_CREATE);
     }
     sendPMInstAlert(createdInstance, PM_CREATED);
@@ -1458,6 +1571,7 @@ void ProviderRegistrationManager::deleteInstance(
     CIMInstance deletedInstance;
     {
         WriteLock lock(_registrationTableLock);
+        RoutingIndexRebuilder rebuilder(this);
         _deleteInstance(instanceReference, OP_DELETE, deletedInstance);
     }
 
@@ -1482,6 +1596,7 @@ void ProviderRegistrationManager::modifyInstance(
          "ProviderRegistrationManager::modifyInstance");
 
     WriteLock lock(_registrationTableLock);
+    RoutingIndexRebuilder rebuilder(this);
 
     CIMObjectPath newInstanceRef("", CIMNamespaceName (),
         ref.getClassName(), ref.getKeyBindings());
@@ -1705,6 +1820,7 @@ Boolean ProviderRegistrationManager::setProviderModuleGroupName(
     try
     {
         WriteLock lock(_registrationTableLock);
+        RoutingIndexRebuilder rebuilder(this);
         Array <CIMKeyBinding> moduleKeyBindings;
 
         moduleKeyBindings.append (CIMKeyBinding
@@ -1792,6 +1908,7 @@ Boolean ProviderRegistrationManager::updateProviderModuleStatus(
     Array<Uint16>& outStatus)
 {
     WriteLock lock(_registrationTableLock);
+    RoutingIndexRebuilder rebuilder(this);
 
     outStatus = _getProviderModuleStatus (providerModuleName);
 
@@ -3785,6 +3902,253 @@ void ProviderRegistrationManager::_addInitialInstancesToTable(
     PEG_METHOD_EXIT();
 }
 
+// Returns true if the (lower-cased) key ends with the lower-cased suffix.
+static Boolean _keyHasSuffix(const String& key, const char* suffix)
+{
+    Uint32 n = (Uint32)strlen(suffix);
+
+    return key.size() >= n &&
+        String::equalNoCase(key.subString(key.size() - n), suffix);
+}
+
+void ProviderRegistrationManager::_rebuildRoutingIndex()
+{
+    PEG_METHOD_ENTER(TRC_PROVIDERMANAGER,
+        "ProviderRegistrationManager::_rebuildRoutingIndex");
+
+    SharedPtr<ProviderRoutingIndex> index(new ProviderRoutingIndex);
+
+    try
+    {
+        for (Table::Iterator i = _registrationTable->table.start(); i; i++)
+        {
+            // Only the capabilities of instance, instance query and
+            // association providers are indexed.  Their entries consist of
+            // a single PG_ProviderCapabilities instance.
+            const String& key = i.key();
+            const Array<CIMInstance>& instances = i.value()->getInstances();
+
+            if (instances.size() != 1 ||
+                !instances[0].getClassName().equal(
+                    PEGASUS_CLASSNAME_PROVIDERCAPABILITIES) ||
+                !(_keyHasSuffix(key, INS_PROVIDER) ||
+                  _keyHasSuffix(key, ASSO_PROVIDER) ||
+                  _keyHasSuffix(key, INSTANCE_QUERY_PROVIDER)))
+            {
+                continue;
+            }
+
+            const CIMInstance& capability = instances[0];
+            String className;
+            Array<String> namespaces;
+            Array<Uint16> providerTypes;
+
+            capability.getProperty(capability.findProperty(
+                _PROPERTY_CLASSNAME)).getValue().get(className);
+            capability.getProperty(capability.findProperty(
+                _PROPERTY_NAMESPACES)).getValue().get(namespaces);
+            capability.getProperty(capability.findProperty(
+                _PROPERTY_PROVIDERTYPE)).getValue().get(providerTypes);
+
+            // Find the namespace and provider type the entry was added
+            // for, generating the key the way the table entries are added.
+            ProviderRoutes routes;
+            ProviderRoute* route = 0;
+            String nameSpace;
+
+            for (Uint32 j = 0; !route && j < providerTypes.size(); j++)
+            {
+                const char* providerType;
+                ProviderRoute* typeRoute;
+
+                switch (providerTypes[j])
+                {
+                    case _INSTANCE_PROVIDER:
+                        providerType = INS_PROVIDER;
+                        typeRoute = &routes.instance;
+                        break;
+                    case _ASSOCIATION_PROVIDER:
+                        providerType = ASSO_PROVIDER;
+                        typeRoute = &routes.association;
+                        break;
+                    case _INSTANCE_QUERY_PROVIDER:
+                        providerType = INSTANCE_QUERY_PROVIDER;
+                        typeRoute = &routes.instanceQuery;
+                        break;
+                    default:
+                        continue;
+                }
+
+                for (Uint32 k = 0; k < namespaces.size(); k++)
+                {
+                    nameSpace = supportWildCardNamespaceNames ?
+                        WildCardNamespaceNames::add(namespaces[k]) :
+                        namespaces[k];
+
+                    if (String::equal(key, _generateKey(
+                            CIMNamespaceNameCast(nameSpace),
+                            CIMNameCast(className), providerType)))
+                    {
+                        route = typeRoute;
+                        break;
+                    }
+                }
+            }
+
+            if (!route)
+            {
+                PEG_TRACE((TRC_PROVIDERMANAGER, Tracer::LEVEL2,
+                    "Registration table entry %s not indexed.",
+                    (const char*)key.getCString()));
+                index->complete = false;
+                continue;
+            }
+
+            route->registered = true;
+
+            String providerName;
+            String providerModuleName;
+            ProviderRegistrationTable* entry;
+
+            if (getProviderName(capability, providerName) &&
+                getProviderModuleName(capability, providerModuleName) &&
+                _registrationTable->table.lookup(
+                    _generateKey(providerModuleName, MODULE_KEY), entry))
+            {
+                CIMInstance providerModule = entry->getInstances()[0];
+
+                if (_registrationTable->table.lookup(
+                        _generateKey(providerModuleName, providerName),
+                        entry))
+                {
+                    route->provider = entry->getInstances()[0];
+                    route->providerModule = providerModule;
+                }
+            }
+
+            // Merge the route with those of the other provider types.
+            ProviderRoutingKey routingKey(
+                CIMNameInterner::intern(CIMNamespaceNameCast(nameSpace)),
+                CIMNameInterner::intern(CIMNameCast(className)));
+            ProviderRoutes* existing;
+
+            if (index->table.lookupReference(routingKey, existing))
+            {
+                if (routes.instance.registered)
+                    existing->instance = routes.instance;
+                if (routes.instanceQuery.registered)
+                    existing->instanceQuery = routes.instanceQuery;
+                if (routes.association.registered)
+                    existing->association = routes.association;
+            }
+            else
+            {
+                index->table.insert(routingKey, routes);
+            }
+        }
+    }
+    catch (const Exception& e)
+    {
+        // Let the lookups fall back to the registration table.
+        PEG_TRACE((TRC_PROVIDERMANAGER, Tracer::LEVEL1,
+            "Failed to build the provider routing index: %s",
+            (const char*)e.getMessage().getCString()));
+        index.reset(new ProviderRoutingIndex);
+        index->complete = false;
+    }
+
+    PEG_TRACE((TRC_PROVIDERMANAGER, Tracer::LEVEL4,
+        "Provider routing index rebuilt: %u classes, complete = %s",
+        index->table.size(), (index->complete ? "true" : "false")));
+
+    AutoMutex lock(_routingIndexMutex);
+    _routingIndex = index;
+
+    PEG_METHOD_EXIT();
+}
+
+SharedPtr<ProviderRoutingIndex> ProviderRegistrationManager::_getRoutingIndex()
+{
+    AutoMutex lock(_routingIndexMutex);
+    return _routingIndex;
+}
+
+Boolean ProviderRegistrationManager::_lookupRoutingIndex(
+    const CIMNamespaceName & nameSpace,
+    const CIMName & className,
+    Boolean is_assoc,
+    Boolean * has_no_query,
+    Boolean & found,
+    CIMInstance & provider,
+    CIMInstance & providerModule)
+{
+    SharedPtr<ProviderRoutingIndex> index = _getRoutingIndex();
+
+    if (!index.get())
+    {
+        return false;
+    }
+
+    CIMNamespaceName nameSpaceKey = nameSpace;
+
+    if (supportWildCardNamespaceNames)
+    {
+        // The wild card namespace names are guarded by the
+        // _registrationTableLock.
+        ReadLock lock(_registrationTableLock);
+        nameSpaceKey = WildCardNamespaceNames::check(nameSpace);
+    }
+
+    ProviderRoutes* routes = 0;
+
+    if (!index->table.lookupReference(
+            ProviderRoutingKey(nameSpaceKey, className), routes) &&
+        !index->complete)
+    {
+        return false;
+    }
+
+    const ProviderRoute* route = 0;
+
+    if (routes)
+    {
+        if (is_assoc)
+        {
+            route = &routes->association;
+        }
+        else if (has_no_query && routes->instanceQuery.registered)
+        {
+            route = &routes->instanceQuery;
+        }
+        else
+        {
+            route = &routes->instance;
+        }
+    }
+
+    if (has_no_query && !is_assoc)
+    {
+        *has_no_query = !(routes && routes->instanceQuery.registered);
+    }
+
+    found = route && !route->provider.isUninitialized();
+
+    if (found)
+    {
+        provider = route->provider;
+        providerModule = route->providerModule;
+    }
+
+    PEG_TRACE((TRC_PROVIDERMANAGER, Tracer::LEVEL4,
+        "nameSpace = %s; className = %s; provider found in routing "
+            "index = %s",
+        (const char*)nameSpace.getString().getCString(),
+        (const char*)className.getString().getCString(),
+        (found ? "true" : "false")));
+
+    return true;
+}
+
 String ProviderRegistrationManager::_generateKey(
     const String & name,
     const String & provider)
@@ -41,10 +41,13 @@
 #include <Pegasus/Common/ModuleController.h>
 #include <Pegasus/Common/CIMMessage.h>
 #include <Pegasus/Common/Constants.h>
+#include <Pegasus/Common/SharedPtr.h>
+#include <Pegasus/Common/Mutex.h>
 
 PEGASUS_NAMESPACE_BEGIN
 
 struct RegistrationTable;
+struct ProviderRoutingIndex;
 
 /**
    The name of the provider module name  property for provider capabilities
@@ -378,6 +381,21 @@ protected:
     */
     ReadWriteSem _registrationTableLock;
 
+    /**
+        Index of the instance, instance query and association provider
+        capabilities in the _registrationTable, by namespace and class name.
+        An index is never modified once published; it is rebuilt whenever
+        the _registrationTable changes.  lookupInstanceProvider() consults
+        the index without locking _registrationTableLock.
+    */
+    SharedPtr<ProviderRoutingIndex> _routingIndex;
+
+    /**
+        A lock held while replacing _routingIndex or taking a reference to
+        it.
+    */
+    Mutex _routingIndexMutex;
+
     Boolean _initComplete;
 
     void (*_PMInstAlertCallback)(
@@ -411,6 +429,34 @@ private:
     */
     void _initialRegistrationTable();
 
+    /**
+        Rebuilds the _routingIndex from the registration table.  The caller
+        must first lock _registrationTableLock for write access.
+    */
+    void _rebuildRoutingIndex();
+
+    /**
+        Returns a reference to the current _routingIndex.
+    */
+    SharedPtr<ProviderRoutingIndex> _getRoutingIndex();
+
+    /**
+        Looks up an instance, instance query or association provider in the
+        _routingIndex, with the semantics of lookupInstanceProvider().
+        Returns false if the index cannot answer the lookup, in which case
+        the registration table must be consulted.
+    */
+    Boolean _lookupRoutingIndex(
+        const CIMNamespaceName & nameSpace,
+        const CIMName & className,
+        Boolean is_assoc,
+        Boolean * has_no_query,
+        Boolean & found,
+        CIMInstance & provider,
+        CIMInstance & providerModule);
+
+    friend class RoutingIndexRebuilder;
+
     /**
         Adds an entry to the registration table for the specified
         instances.  The caller must first lock _registrationTableLock
@@ -208,6 +208,45 @@ void TestLookupInstanceProviderFail(ProviderRegistrationManager & prmanager)
     PEGASUS_TEST_ASSERT(!prmanager.lookupInstanceProvider(
         CIMNamespaceName ("test_namespaceNotExist"),
         CIMName ("test_class1"), providerIns, providerModuleIns));
+
+    // Names are matched regardless of case
+    PEGASUS_TEST_ASSERT(prmanager.lookupInstanceProvider(
+        CIMNamespaceName ("TEST_NAMESPACE2"),
+        CIMName ("Test_Class1"), providerIns, providerModuleIns));
+
+    // Only an instance provider is registered for the class
+    Boolean hasNoQuery = false;
+    PEGASUS_TEST_ASSERT(prmanager.lookupInstanceProvider(
+        CIMNamespaceName ("test_namespace1"),
+        CIMName ("test_class1"), providerIns, providerModuleIns,
+        false, &hasNoQuery));
+    PEGASUS_TEST_ASSERT(hasNoQuery);
+
+    PEGASUS_TEST_ASSERT(!prmanager.lookupInstanceProvider(
+        CIMNamespaceName ("test_namespace1"),
+        CIMName ("test_class1"), providerIns, providerModuleIns, true));
+}
+
+// Test that lookups follow the deletion of the registration. This must be
+// executed last.
+void TestLookupInstanceProviderDeleted(ProviderRegistrationManager & prmanager)
+{
+    Array<CIMKeyBinding> keys;
+    keys.append(CIMKeyBinding(CIMName("ProviderModuleName"),
+        "providersModule1", CIMKeyBinding::STRING));
+    keys.append(CIMKeyBinding(CIMName("ProviderName"),
+        "PG_ProviderInstance1", CIMKeyBinding::STRING));
+    keys.append(CIMKeyBinding(CIMName("CapabilityID"),
+        "capability1", CIMKeyBinding::STRING));
+    prmanager.deleteInstance(CIMObjectPath(String(), NAMESPACE,
+        CLASSNAME3, keys));
+
+    CIMInstance providerIns;
+    CIMInstance providerModuleIns;
+
+    PEGASUS_TEST_ASSERT(!prmanager.lookupInstanceProvider(
+        CIMNamespaceName ("test_namespace1"),
+        CIMName ("test_class1"), providerIns, providerModuleIns));
 }
 
 
@@ -239,6 +278,7 @@ int main(int, char** argv)
             exit (-1);
         }
         TestLookupInstanceProviderFail(prmanager);
+        TestLookupInstanceProviderDeleted(prmanager);
     }
 
     catch(Exception& e)
@@ -148,6 +148,8 @@ static CtlProviderRegDefinition CtlProviderRegDefinitionTable[] =
 #ifndef PEGASUS_DISABLE_PERFINST
     {PEGASUS_CLASSNAME_CIMOMSTATDATA,  PEGASUS_NAMESPACENAME_CIMOMSTATDATA,
         PEGASUS_MODULENAME_CIMOMSTATDATAPROVIDER},
+    {PEGASUS_CLASSNAME_PG_CIMOMSTATLATENCYDATA, PEGASUS_NAMESPACENAME_INTERNAL,
+        PEGASUS_MODULENAME_CIMOMSTATDATAPROVIDER},
 #endif
 
 #ifdef PEGASUS_ENABLE_CQL
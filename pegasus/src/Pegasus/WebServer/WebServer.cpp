@@ -219,7 +219,7 @@ void WebServer::handleResponse(HTTPMessage* response)
     }
     PEGASUS_ASSERT(dynamic_cast<HTTPConnection*>(queue) != 0);
 
-    httpMessage->dest = queue->getQueueId();
+    httpMessage->dest = queueId;
     queue->enqueue(httpMessage.release());
 
     PEG_METHOD_EXIT();
@@ -31,6 +31,7 @@
 
 #include <cctype>
 #include <cstdio>
+#include <cstring>
 #include <Pegasus/Common/Config.h>
 #include <Pegasus/Common/Tracer.h>
 #include <Pegasus/Common/String.h>
@@ -115,107 +116,53 @@ WsmResponse* CimToWsmResponseMapper::mapToWsmResponse(
                 break;
 
             case WS_ENUMERATION_ENUMERATE:
-                // Test for no association filter
-                if (((WsenEnumerateRequest*)wsmRequest)->
-                    wsmFilter.filterDialect != WsmFilter::ASSOCIATION)
+            {
+                // The responses to the CIM open operations and to the pull
+                // operations that follow them are mapped alike.
+                WsenEnumerateRequest* enumRequest =
+                    (WsenEnumerateRequest*) wsmRequest;
+                CIMOpenOrPullResponseDataMessage* enumResponse =
+                    (CIMOpenOrPullResponseDataMessage*) message;
+
+                // Select the endpoint whose resource URI and namespace are
+                // given to the returned items.
+                const WsmEndpointReference* objectTarget = &enumRequest->epr;
+                const WsmEndpointReference* eprTarget = &enumRequest->epr;
+
+                if (enumRequest->wsmFilter.filterDialect ==
+                    WsmFilter::ASSOCIATION)
                 {
-                    if (((WsenEnumerateRequest*) wsmRequest)->enumerationMode ==
-                        WSEN_EM_OBJECT)
-                    {
-                        wsmResponse.reset(_mapToWsenEnumerateResponseObject(
-                            (WsenEnumerateRequest*) wsmRequest,
-                            (CIMEnumerateInstancesResponseMessage*) message));
-                    }
-                    else if (((WsenEnumerateRequest*)wsmRequest)->
-                             enumerationMode ==
-                                 WSEN_EM_OBJECT_AND_EPR)
-                    {
-                        wsmResponse.reset(
-                            _mapToWsenEnumerateResponseObjectAndEPR(
-                              (WsenEnumerateRequest*) wsmRequest,
-                              (CIMEnumerateInstancesResponseMessage*) message));
-                    }
-                    else if (((WsenEnumerateRequest*) wsmRequest)->
-                             enumerationMode == WSEN_EM_EPR)
-                    {
-                        wsmResponse.reset(_mapToWsenEnumerateResponseEPR(
-                            (WsenEnumerateRequest*) wsmRequest,
-                            (CIMEnumerateInstanceNamesResponseMessage*)
-                                message));
-                    }
-                    else
+                    eprTarget = &enumRequest->wsmFilter.AssocFilter.object;
+
+                    if (enumRequest->wsmFilter.AssocFilter.assocFilterType !=
+                        WsmFilter::ASSOCIATED_INSTANCES)
                     {
-                        PEGASUS_UNREACHABLE(PEGASUS_ASSERT(0);)
+                        objectTarget = eprTarget;
                     }
                 }
-                else // association or reference response expected
+
+                if (enumRequest->enumerationMode == WSEN_EM_OBJECT)
                 {
-                    if (((WsenEnumerateRequest*)wsmRequest)->
-                        wsmFilter.AssocFilter.assocFilterType ==
-                           WsmFilter::ASSOCIATED_INSTANCES)
-                    {
-                        // Association responses
-                        if (((WsenEnumerateRequest*) wsmRequest)->
-                            enumerationMode == WSEN_EM_OBJECT)
-                        {
-                            wsmResponse.reset(
-                                _mapToWsenEnumerateResponseObject(
-                                    (WsenEnumerateRequest*) wsmRequest,
-                                    (CIMAssociatorsResponseMessage*) message));
-                        }
-                        else if (((WsenEnumerateRequest*)
-                                      wsmRequest)->enumerationMode ==
-                                 WSEN_EM_OBJECT_AND_EPR)
-                        {
-                            wsmResponse.reset(
-                                _mapToWsenEnumerateResponseObjectAndEPR(
-                                    (WsenEnumerateRequest*) wsmRequest,
-                                    (CIMAssociatorsResponseMessage*) message));
-                        }
-                        else if (((WsenEnumerateRequest*) wsmRequest)->
-                                 enumerationMode == WSEN_EM_EPR)
-                        {
-                            wsmResponse.reset(_mapToWsenEnumerateResponseEPR(
-                                (WsenEnumerateRequest*) wsmRequest,
-                                (CIMAssociatorNamesResponseMessage*) message));
-                        }
-                        else
-                        {
-                            PEGASUS_UNREACHABLE(PEGASUS_ASSERT(0);)
-                        }
-                    }
-                    else // references responses
-                    {
-                        if (((WsenEnumerateRequest*)
-                             wsmRequest)->enumerationMode == WSEN_EM_OBJECT)
-                        {
-                            wsmResponse.reset(_mapToWsenEnumerateResponseObject(
-                                (WsenEnumerateRequest*) wsmRequest,
-                                (CIMReferencesResponseMessage*) message));
-                        }
-                        else if (((WsenEnumerateRequest*)
-                                      wsmRequest)->enumerationMode ==
-                                 WSEN_EM_OBJECT_AND_EPR)
-                        {
-                            wsmResponse.reset(
-                                _mapToWsenEnumerateResponseObjectAndEPR(
-                                    (WsenEnumerateRequest*) wsmRequest,
-                                    (CIMReferencesResponseMessage*) message));
-                        }
-                        else if (((WsenEnumerateRequest*) wsmRequest)->
-                                 enumerationMode == WSEN_EM_EPR)
-                        {
-                            wsmResponse.reset(_mapToWsenEnumerateResponseEPR(
-                                (WsenEnumerateRequest*) wsmRequest,
-                                (CIMReferenceNamesResponseMessage*) message));
-                        }
-                        else
-                        {
-                            PEGASUS_UNREACHABLE(PEGASUS_ASSERT(0);)
-                        }
-                    }
+                    wsmResponse.reset(_mapToWsenEnumerateResponseObject(
+                        enumRequest, enumResponse, *objectTarget));
+                }
+                else if (enumRequest->enumerationMode ==
+                         WSEN_EM_OBJECT_AND_EPR)
+                {
+                    wsmResponse.reset(_mapToWsenEnumerateResponseObjectAndEPR(
+                        enumRequest, enumResponse, *eprTarget));
+                }
+                else if (enumRequest->enumerationMode == WSEN_EM_EPR)
+                {
+                    wsmResponse.reset(_mapToWsenEnumerateResponseEPR(
+                        enumRequest, enumResponse, *eprTarget));
+                }
+                else
+                {
+                    PEGASUS_UNREACHABLE(PEGASUS_ASSERT(0);)
                 }
                 break;
+            }
 
             case WS_INVOKE:
             {
@@ -426,20 +373,77 @@ WxfSubDeleteResponse* CimToWsmResponseMapper::_mapToWxfSubDeleteResponse(
     return wsmResponse;
 }
 
+/**
+    The pull operations return the paths of the enumerated instances with
+    the host name.  Plain enumerations address their items through the
+    anonymous endpoint, so the host is dropped for them.
+*/
+static CIMObjectPath _getEnumeratedItemPath(
+    const WsenEnumerateRequest* wsmRequest,
+    const CIMObjectPath& path)
+{
+    if (wsmRequest->wsmFilter.filterDialect == WsmFilter::ASSOCIATION)
+    {
+        return path;
+    }
+
+    CIMObjectPath localPath = path;
+    localPath.setHost(String::EMPTY);
+    return localPath;
+}
+
+/****************************************************************************
+**
+**       _mapToWsenEnumerateResponse for the OpenEnumerateInstances,
+**           OpenReferenceInstances and OpenAssociatorInstances responses
+**           and the PullInstancesWithPath responses that follow them
+**
+******************************************************************************/
 WsenEnumerateResponse*
     CimToWsmResponseMapper::_mapToWsenEnumerateResponseObject(
     const WsenEnumerateRequest* wsmRequest,
-    CIMEnumerateInstancesResponseMessage* response)
+    CIMOpenOrPullResponseDataMessage* response,
+    const WsmEndpointReference& target)
 {
     PEG_METHOD_ENTER(TRC_WSMSERVER,
         "CimToWsmResponseMapper::_mapToWsenEnumerateResponseObject");
     Array<WsmInstance> instances;
-    Array<WsmEndpointReference> EPRs;
+    CIMResponseData& responseData = response->getResponseData();
+
+    // Instances that providers returned in SCMO form are written directly
+    // by SCMOWsmWriter unless a WQL filter has to be applied to them.
+    if (wsmRequest->wsmFilter.filterDialect != WsmFilter::WQL &&
+        !responseData.hasCIMData())
+    {
+        Array<SCMOInstance>& scmoInstances = responseData.getSCMO();
+
+        PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
+            "Enumeration Returned %u SCMO instances", scmoInstances.size()));
+
+        for (Uint32 i = 0; i < scmoInstances.size(); i++)
+        {
+            instances.append(WsmInstance(
+                scmoInstances[i],
+                target.resourceUri,
+                target.getNamespace()));
+        }
+
+        WsenEnumerateResponse* wsmResponse =
+            new WsenEnumerateResponse(
+                instances,
+                instances.size(),
+                wsmRequest,
+                _getContentLanguages(response->operationContext));
+
+        PEG_METHOD_EXIT();
+        return wsmResponse;
+    }
+
     Array<CIMInstance>& namedInstances =
-        response->getResponseData().getInstances();
+        responseData.getInstancesFromInstancesOrObjects();
 
     PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-        "EnumerateInstances Returned %u instances",namedInstances.size() ));
+        "Enumeration Returned %u instances",namedInstances.size() ));
 
     // if WQLFilter type
     if (wsmRequest->wsmFilter.filterDialect == WsmFilter::WQL)
@@ -478,21 +482,12 @@ WsenEnumerateResponse*
 
             WsmInstance wsmInstance;
             convertCimToWsmInstance(
-                wsmRequest->epr.resourceUri,
+                target.resourceUri,
                 instance,
                 wsmInstance,
-                wsmRequest->epr.getNamespace());
+                target.getNamespace());
             instances.append(wsmInstance);
         }
-
-        WsenEnumerateResponse* wsmResponse =
-            new WsenEnumerateResponse(
-                instances,
-                instances.size(),
-                wsmRequest,
-                _getContentLanguages(response->operationContext));
-        PEG_METHOD_EXIT();
-        return wsmResponse;
     }
     else
     {
@@ -500,191 +495,99 @@ WsenEnumerateResponse*
         {
             WsmInstance wsmInstance;
             convertCimToWsmInstance(
-                wsmRequest->epr.resourceUri,
+                target.resourceUri,
                 namedInstances[i],
                 wsmInstance,
-                wsmRequest->epr.getNamespace());
+                target.getNamespace());
             instances.append(wsmInstance);
         }
-
-        WsenEnumerateResponse* wsmResponse =
-            new WsenEnumerateResponse(
-                instances,
-                instances.size(),
-                wsmRequest,
-                _getContentLanguages(response->operationContext));
-
-        PEG_METHOD_EXIT();
-        return wsmResponse;
-    }
-}
-
-WsenEnumerateResponse*
-    CimToWsmResponseMapper::_mapToWsenEnumerateResponseObjectAndEPR(
-    const WsenEnumerateRequest* wsmRequest,
-    CIMEnumerateInstancesResponseMessage* response)
-{
-    PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "CimToWsmResponseMapper::_mapToWsenEnumerateResponseObjectAndEPR");
-
-    Array<WsmInstance> instances;
-    Array<WsmEndpointReference> EPRs;
-    Array<CIMInstance>& namedInstances =
-        response->getResponseData().getInstances();
-
-    PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-        "EnumerateInstances Returned %u instances ",namedInstances.size() ));
-
-    for (Uint32 i = 0; i < namedInstances.size(); i++)
-    {
-        WsmInstance wsmInstance;
-        convertCimToWsmInstance(
-            wsmRequest->epr.resourceUri,
-            namedInstances[i],
-            wsmInstance,
-            wsmRequest->epr.getNamespace());
-        instances.append(wsmInstance);
-
-        WsmEndpointReference epr;
-        convertObjPathToEPR(
-            wsmRequest->epr.resourceUri,
-            namedInstances[i].getPath(),
-            epr,
-            wsmRequest->epr.getNamespace());
-        EPRs.append(epr);
     }
 
     WsenEnumerateResponse* wsmResponse =
         new WsenEnumerateResponse(
             instances,
-            EPRs,
             instances.size(),
             wsmRequest,
             _getContentLanguages(response->operationContext));
-    PEG_METHOD_EXIT();
-    return wsmResponse;
-}
-
-/****************************************************************************
-**
-**       _mapToWsenEnumerateResponse for enumerateInstances and
-**           EnumerateInstanceNames responses
-**
-******************************************************************************/
-WsenEnumerateResponse*
-CimToWsmResponseMapper::_mapToWsenEnumerateResponseEPR(
-    const WsenEnumerateRequest* wsmRequest,
-    CIMEnumerateInstanceNamesResponseMessage* response)
-{
-    PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "CimToWsmResponseMapper::_mapToWsenEnumerateResponseEPR");
-
-    Array<WsmEndpointReference> EPRs;
-    Array<CIMObjectPath>& instanceNames =
-        response->getResponseData().getInstanceNames();
 
-    PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-        "EnumerateInstanceNames Returned %u instanceNames ",
-               instanceNames.size() ));
-
-    for (Uint32 i = 0; i < instanceNames.size(); i++)
-    {
-        WsmEndpointReference epr;
-        convertObjPathToEPR(
-            wsmRequest->epr.resourceUri,
-            instanceNames[i],
-            epr,
-            wsmRequest->epr.getNamespace());
-        EPRs.append(epr);
-    }
-
-    WsenEnumerateResponse* wsmResponse =
-        new WsenEnumerateResponse(
-            EPRs,
-            EPRs.size(),
-            wsmRequest,
-            _getContentLanguages(response->operationContext));
     PEG_METHOD_EXIT();
     return wsmResponse;
 }
 
-/****************************************************************************
-**
-**       _mapToWsenEnumerateResponse for CIM Reference and ReferenceNames
-**           responses
-**
-******************************************************************************/
 WsenEnumerateResponse*
-    CimToWsmResponseMapper::_mapToWsenEnumerateResponseObject(
+    CimToWsmResponseMapper::_mapToWsenEnumerateResponseObjectAndEPR(
     const WsenEnumerateRequest* wsmRequest,
-    CIMReferencesResponseMessage* response)
+    CIMOpenOrPullResponseDataMessage* response,
+    const WsmEndpointReference& target)
 {
     PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "CimToWsmResponseMapper::_mapToWsenEnumerateResponseObject");
+        "CimToWsmResponseMapper::_mapToWsenEnumerateResponseObjectAndEPR");
 
     Array<WsmInstance> instances;
     Array<WsmEndpointReference> EPRs;
-    Array<CIMObject>& objects =
-        response->getResponseData().getObjects();
+    CIMResponseData& responseData = response->getResponseData();
 
-    PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-        "References Returned %u objects ",objects.size() ));
-
-    for (Uint32 i = 0; i < objects.size(); i++)
+    // Instances that providers returned in SCMO form are written directly
+    // by SCMOWsmWriter; only their paths are resolved here.
+    if (!responseData.hasCIMData())
     {
-        WsmInstance wsmInstance;
-        convertCimToWsmInstance(
-            wsmRequest->wsmFilter.AssocFilter.object.resourceUri,
-            (CIMInstance)objects[i],
-            wsmInstance,
-            wsmRequest->wsmFilter.AssocFilter.object.getNamespace());
-        instances.append(wsmInstance);
-    }
+        Array<SCMOInstance>& scmoInstances = responseData.getSCMO();
 
-    WsenEnumerateResponse* wsmResponse =
-        new WsenEnumerateResponse(
-            instances,
-            instances.size(),
-            wsmRequest,
-            _getContentLanguages(response->operationContext));
+        PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
+            "Enumeration Returned %u SCMO instances", scmoInstances.size()));
 
-    PEG_METHOD_EXIT();
-    return wsmResponse;
-}
+        for (Uint32 i = 0; i < scmoInstances.size(); i++)
+        {
+            instances.append(WsmInstance(
+                scmoInstances[i],
+                target.resourceUri,
+                target.getNamespace()));
+
+            CIMObjectPath path;
+            scmoInstances[i].getCIMObjectPath(path);
+
+            WsmEndpointReference epr;
+            convertObjPathToEPR(
+                target.resourceUri,
+                _getEnumeratedItemPath(wsmRequest, path),
+                epr,
+                target.getNamespace());
+            EPRs.append(epr);
+        }
 
-WsenEnumerateResponse*
-    CimToWsmResponseMapper::_mapToWsenEnumerateResponseObjectAndEPR(
-    const WsenEnumerateRequest* wsmRequest,
-    CIMReferencesResponseMessage* response)
-{
-    PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "CimToWsmResponseMapper::_mapToWsenEnumerateResponseObjectAndEPR");
+        WsenEnumerateResponse* wsmResponse =
+            new WsenEnumerateResponse(
+                instances,
+                EPRs,
+                instances.size(),
+                wsmRequest,
+                _getContentLanguages(response->operationContext));
+        PEG_METHOD_EXIT();
+        return wsmResponse;
+    }
 
-    Array<WsmInstance> instances;
-    Array<WsmEndpointReference> EPRs;
-    Array<CIMObject>& objects =
-        response->getResponseData().getObjects();
+    Array<CIMInstance>& namedInstances =
+        responseData.getInstancesFromInstancesOrObjects();
 
     PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-        "Returned %u objects from References ",objects.size() ));
+        "Enumeration Returned %u instances ",namedInstances.size() ));
 
-    for (Uint32 i = 0; i < objects.size(); i++)
+    for (Uint32 i = 0; i < namedInstances.size(); i++)
     {
         WsmInstance wsmInstance;
-
         convertCimToWsmInstance(
-            wsmRequest->wsmFilter.AssocFilter.object.resourceUri,
-            (CIMInstance)objects[i],
+            target.resourceUri,
+            namedInstances[i],
             wsmInstance,
-            wsmRequest->wsmFilter.AssocFilter.object.getNamespace());
+            target.getNamespace());
         instances.append(wsmInstance);
 
         WsmEndpointReference epr;
         convertObjPathToEPR(
-            wsmRequest->wsmFilter.AssocFilter.object.resourceUri,
-            objects[i].getPath(),
+            target.resourceUri,
+            _getEnumeratedItemPath(wsmRequest, namedInstances[i].getPath()),
             epr,
-            wsmRequest->wsmFilter.AssocFilter.object.getNamespace());
+            target.getNamespace());
         EPRs.append(epr);
     }
 
@@ -699,133 +602,18 @@ WsenEnumerateResponse*
     return wsmResponse;
 }
 
-WsenEnumerateResponse*
-CimToWsmResponseMapper::_mapToWsenEnumerateResponseEPR(
-    const WsenEnumerateRequest* wsmRequest,
-    CIMReferenceNamesResponseMessage* response)
-{
-    PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "CimToWsmResponseMapper::_mapToWsenEnumerateResponseEPR");
-
-    Array<WsmEndpointReference> EPRs;
-    Array<CIMObjectPath>& instanceNames =
-        response->getResponseData().getInstanceNames();
-
-    PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-        "Returned %u names from ReferenceNames ",instanceNames.size() ));
-
-    for (Uint32 i = 0; i < instanceNames.size(); i++)
-    {
-        WsmEndpointReference epr;
-
-        convertObjPathToEPR(
-            wsmRequest->wsmFilter.AssocFilter.object.resourceUri,
-            instanceNames[i],
-            epr,
-            wsmRequest->wsmFilter.AssocFilter.object.getNamespace());
-        EPRs.append(epr);
-    }
-
-    WsenEnumerateResponse* wsmResponse =
-        new WsenEnumerateResponse(
-            EPRs,
-            EPRs.size(),
-            wsmRequest,
-            _getContentLanguages(response->operationContext));
-    PEG_METHOD_EXIT();
-    return wsmResponse;
-}
-
 /****************************************************************************
 **
-**       _mapToWsenEnumerateResponse for Associator and AssociatorNames
-**           responses
+**       _mapToWsenEnumerateResponse for the OpenEnumerateInstancePaths,
+**           OpenReferenceInstancePaths and OpenAssociatorInstancePaths
+**           responses and the PullInstancePaths responses that follow them
 **
 ******************************************************************************/
-WsenEnumerateResponse*
-    CimToWsmResponseMapper::_mapToWsenEnumerateResponseObject(
-    const WsenEnumerateRequest* wsmRequest,
-    CIMAssociatorsResponseMessage* response)
-{
-    PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "CimToWsmResponseMapper::_mapToWsenEnumerateResponseObject");
-    Array<WsmInstance> instances;
-    Array<WsmEndpointReference> EPRs;
-    Array<CIMObject>& objects =
-        response->getResponseData().getObjects();
-
-    for (Uint32 i = 0; i < objects.size(); i++)
-    {
-        WsmInstance wsmInstance;
-        convertCimToWsmInstance(
-            wsmRequest->epr.resourceUri,
-            (CIMInstance)objects[i],
-            wsmInstance,
-            wsmRequest->epr.getNamespace());
-        instances.append(wsmInstance);
-    }
-
-    WsenEnumerateResponse* wsmResponse =
-        new WsenEnumerateResponse(
-            instances,
-            instances.size(),
-            wsmRequest,
-            _getContentLanguages(response->operationContext));
-    PEG_METHOD_EXIT();
-    return wsmResponse;
-}
-
-WsenEnumerateResponse*
-    CimToWsmResponseMapper::_mapToWsenEnumerateResponseObjectAndEPR(
-    const WsenEnumerateRequest* wsmRequest,
-    CIMAssociatorsResponseMessage* response)
-{
-    PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "CimToWsmResponseMapper::_mapToWsenEnumerateResponseObjectAndEPR");
-    Array<WsmInstance> instances;
-    Array<WsmEndpointReference> EPRs;
-    Array<CIMObject>& objects =
-        response->getResponseData().getObjects();
-
-    PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-        "Returned %u objects from Associators",objects.size() ));
-
-    for (Uint32 i = 0; i < objects.size(); i++)
-    {
-        WsmInstance wsmInstance;
-
-        convertCimToWsmInstance(
-            wsmRequest->wsmFilter.AssocFilter.object.resourceUri,
-            (CIMInstance)objects[i],
-            wsmInstance,
-            wsmRequest->wsmFilter.AssocFilter.object.getNamespace());
-        instances.append(wsmInstance);
-
-        WsmEndpointReference epr;
-        convertObjPathToEPR(
-            wsmRequest->wsmFilter.AssocFilter.object.resourceUri,
-            objects[i].getPath(),
-            epr,
-            wsmRequest->wsmFilter.AssocFilter.object.getNamespace());
-        EPRs.append(epr);
-    }
-
-    WsenEnumerateResponse* wsmResponse =
-        new WsenEnumerateResponse(
-            instances,
-            EPRs,
-            instances.size(),
-            wsmRequest,
-            _getContentLanguages(response->operationContext));
-
-    PEG_METHOD_EXIT();
-    return wsmResponse;
-}
-
 WsenEnumerateResponse*
 CimToWsmResponseMapper::_mapToWsenEnumerateResponseEPR(
     const WsenEnumerateRequest* wsmRequest,
-    CIMAssociatorNamesResponseMessage* response)
+    CIMOpenOrPullResponseDataMessage* response,
+    const WsmEndpointReference& target)
 {
     PEG_METHOD_ENTER(TRC_WSMSERVER,
         "CimToWsmResponseMapper::_mapToWsenEnumerateResponseEPR");
@@ -835,17 +623,17 @@ CimToWsmResponseMapper::_mapToWsenEnumerateResponseEPR(
         response->getResponseData().getInstanceNames();
 
     PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-        "Returned %u instanceNames",instanceNames.size() ));
+        "Enumeration Returned %u instanceNames ",
+               instanceNames.size() ));
 
     for (Uint32 i = 0; i < instanceNames.size(); i++)
     {
         WsmEndpointReference epr;
-
         convertObjPathToEPR(
-            wsmRequest->wsmFilter.AssocFilter.object.resourceUri,
-            instanceNames[i],
+            target.resourceUri,
+            _getEnumeratedItemPath(wsmRequest, instanceNames[i]),
             epr,
-            wsmRequest->wsmFilter.AssocFilter.object.getNamespace());
+            target.getNamespace());
         EPRs.append(epr);
     }
 
@@ -1264,14 +1052,20 @@ void CimToWsmResponseMapper::convertObjPathToEPR(
 
 void CimToWsmResponseMapper::convertCimToWsmDatetime(
     const CIMDateTime& cimDT, String& wsmDT)
+{
+    convertCimToWsmDatetime(
+        (const char*) cimDT.toString().getCString(), wsmDT);
+}
+
+void CimToWsmResponseMapper::convertCimToWsmDatetime(
+    const char* cimStr, String& wsmDT)
 {
     char buffer[50];
     Uint32 size;
 
-    String cimStrDT = cimDT.toString();
-    CString cimCStrDT = cimStrDT.getCString();
-    const char* cimStr = (const char*) cimCStrDT;
-    Uint32 firstAsteriskPos = cimStrDT.find('*');
+    const char* firstAsterisk = strchr(cimStr, '*');
+    Uint32 firstAsteriskPos = firstAsterisk ?
+        Uint32(firstAsterisk - cimStr) : PEG_NOT_FOUND;
 
     // DSP0230.
     // 1. If CIM datetime string contains ":", use Interval cim:cimDateTime
@@ -78,6 +78,11 @@ public:
         WsmEndpointReference& epr,
         const String& nameSpace);
     void convertCimToWsmDatetime(const CIMDateTime& cimDT, String& wsmDT);
+    /**
+        Converts a CIM datetime value given in its 25 character string
+        representation.
+    */
+    void convertCimToWsmDatetime(const char* cimStr, String& wsmDT);
 
 private:
 
@@ -102,33 +107,16 @@ private:
 
     WsenEnumerateResponse* _mapToWsenEnumerateResponseObject(
         const WsenEnumerateRequest* wsmRequest,
-        CIMEnumerateInstancesResponseMessage* response);
+        CIMOpenOrPullResponseDataMessage* response,
+        const WsmEndpointReference& target);
     WsenEnumerateResponse* _mapToWsenEnumerateResponseObjectAndEPR(
         const WsenEnumerateRequest* wsmRequest,
-        CIMEnumerateInstancesResponseMessage* response);
+        CIMOpenOrPullResponseDataMessage* response,
+        const WsmEndpointReference& target);
     WsenEnumerateResponse* _mapToWsenEnumerateResponseEPR(
         const WsenEnumerateRequest* wsmRequest,
-        CIMEnumerateInstanceNamesResponseMessage* response);
-
-    WsenEnumerateResponse* _mapToWsenEnumerateResponseObject(
-        const WsenEnumerateRequest* wsmRequest,
-        CIMReferencesResponseMessage* response);
-    WsenEnumerateResponse* _mapToWsenEnumerateResponseObjectAndEPR(
-        const WsenEnumerateRequest* wsmRequest,
-        CIMReferencesResponseMessage* response);
-    WsenEnumerateResponse* _mapToWsenEnumerateResponseEPR(
-        const WsenEnumerateRequest* wsmRequest,
-        CIMReferenceNamesResponseMessage* response);
-
-    WsenEnumerateResponse* _mapToWsenEnumerateResponseObject(
-        const WsenEnumerateRequest* wsmRequest,
-        CIMAssociatorsResponseMessage* response);
-    WsenEnumerateResponse* _mapToWsenEnumerateResponseObjectAndEPR(
-        const WsenEnumerateRequest* wsmRequest,
-        CIMAssociatorsResponseMessage* response);
-    WsenEnumerateResponse* _mapToWsenEnumerateResponseEPR(
-        const WsenEnumerateRequest* wsmRequest,
-        CIMAssociatorNamesResponseMessage* response);
+        CIMOpenOrPullResponseDataMessage* response,
+        const WsmEndpointReference& target);
 
     WsmFaultResponse* _mapToWsmFaultResponse(
         const WsmRequest* wsmRequest,
@@ -0,0 +1,458 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <cstring>
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/AutoPtr.h>
+#include <Pegasus/Common/System.h>
+#include <Pegasus/Common/StringConversion.h>
+#include <Pegasus/Common/CIMDateTimeInline.h>
+#include <Pegasus/Common/MessageLoader.h>
+#include <Pegasus/WsmServer/WsmConstants.h>
+#include <Pegasus/WsmServer/WsmUtils.h>
+#include <Pegasus/WsmServer/WsmFault.h>
+#include <Pegasus/WsmServer/CimToWsmResponseMapper.h>
+#include "SCMOWsmWriter.h"
+
+#ifdef PEGASUS_OS_VMS
+# define PEGASUS_NAN "NaNQ"
+# define PEGASUS_INF "Infinity"
+# define PEGASUS_NEG_INF "-Infinity"
+#else
+# define PEGASUS_NAN "nan"
+# define PEGASUS_INF "inf"
+# define PEGASUS_NEG_INF "-inf"
+#endif
+
+PEGASUS_NAMESPACE_BEGIN
+
+// The name and node index of a property of an SCMOInstance
+struct SCMOWsmProperty
+{
+    const char* name;
+    Uint32 nameLength;
+    Uint32 node;
+};
+
+// Orders properties by name the way WsmInstance::sortProperties() does.
+// Property names are CIM identifiers, so comparing their UTF-8 bytes gives
+// the order String::compare() gives.
+static int _compareProperties(const void* p1, const void* p2)
+{
+    const SCMOWsmProperty* prop1 = (const SCMOWsmProperty*) p1;
+    const SCMOWsmProperty* prop2 = (const SCMOWsmProperty*) p2;
+
+    int rc = memcmp(prop1->name, prop2->name,
+        prop1->nameLength < prop2->nameLength ?
+            prop1->nameLength : prop2->nameLength);
+
+    if (rc == 0)
+    {
+        rc = int(prop1->nameLength) - int(prop2->nameLength);
+    }
+    return rc;
+}
+
+// Append something like this to buffer: "<class:"
+static inline void _appendStartPrefix(Buffer& out, const char* ns)
+{
+    out.append('<');
+    out.append(ns, strlen(ns));
+    out.append(':');
+}
+
+// Append something like this to buffer: "</class:"
+static inline void _appendEndPrefix(Buffer& out, const char* ns)
+{
+    out.append('<');
+    out.append('/');
+    out.append(ns, strlen(ns));
+    out.append(':');
+}
+
+void SCMOWsmWriter::appendInstanceElement(
+    Buffer& out,
+    const String& resourceUri,
+    const SCMOInstance& scmoInstance,
+    const String& className,
+    const String& refResourceUri,
+    const String& nameSpace,
+    const char* ns,
+    Boolean isEmbedded)
+{
+    size_t nsLength = strlen(ns);
+
+    // Class opening element:
+    _appendStartPrefix(out, ns);
+    out << className;
+    out << STRLIT(" xmlns:");
+    out.append(ns, nsLength);
+    out << STRLIT("=\"");
+    out << WsmUtils::getRootResourceUri(resourceUri);
+    out << STRLIT("/") << className;
+    out << STRLIT("\"");
+
+    // DSP0230, section 7.2.5.2. The property element MUST contain an
+    // xsi:type attribute with the XSD type of the class of the instance
+    // (see section 7.3.1).
+    if (isEmbedded)
+    {
+        out << STRLIT(" ");
+        out << WsmNamespaces::supportedNamespaces[
+            WsmNamespaces::XML_SCHEMA_INSTANCE].localName;
+        out << STRLIT(":type=\"");
+        out << className;
+        out << STRLIT("_Type\"");
+    }
+    out << STRLIT(">");
+
+    // Collect the properties a CIMInstance resolved from the SCMOInstance
+    // would have and sort them before writing them out.
+    Uint32 propertyCount = scmoInstance.getPropertyCount();
+    AutoArrayPtr<SCMOWsmProperty> properties(
+        new SCMOWsmProperty[propertyCount]);
+    Uint32 n = 0;
+
+    const char* clsbase = scmoInstance.inst.hdr->theClass.ptr->cls.base;
+    Boolean exportSetOnly = scmoInstance.inst.hdr->flags.exportSetOnly;
+
+    for (Uint32 node = 0; node < propertyCount; node++)
+    {
+        if (scmoInstance._isClassDefinedProperty(node))
+        {
+            if (exportSetOnly &&
+                !scmoInstance._getSCMBValueForNode(node).flags.isSet)
+            {
+                continue;
+            }
+
+            SCMBValue* value;
+            const char* valueBase;
+            SCMBClassProperty* propertyDef;
+            scmoInstance._getPropertyAt(
+                node, &value, &valueBase, &propertyDef);
+
+            properties[n].name = _getCharString(propertyDef->name, clsbase);
+            properties[n].nameLength = propertyDef->name.size - 1;
+        }
+        else
+        {
+            SCMBUserPropertyElement* element =
+                scmoInstance._getUserDefinedPropertyElementAt(node);
+
+            properties[n].name =
+                _getCharString(element->name, scmoInstance.inst.base);
+            properties[n].nameLength = element->name.size - 1;
+        }
+        properties[n].node = node;
+        n++;
+    }
+
+    qsort((void*) properties.get(), n, sizeof(SCMOWsmProperty),
+        _compareProperties);
+
+    // Properties:
+    for (Uint32 i = 0; i < n; i++)
+    {
+        _appendPropertyElement(out, resourceUri, scmoInstance,
+            properties[i].node, properties[i].name, properties[i].nameLength,
+            refResourceUri, nameSpace, ns);
+    }
+
+    // Class closing element:
+    _appendEndPrefix(out, ns);
+    out << className << STRLIT(">");
+}
+
+void SCMOWsmWriter::_appendPropertyElement(
+    Buffer& out,
+    const String& resourceUri,
+    const SCMOInstance& scmoInstance,
+    Uint32 node,
+    const char* propName,
+    Uint32 propNameLength,
+    const String& refResourceUri,
+    const String& nameSpace,
+    const char* ns)
+{
+    SCMBValue* value;
+    const char* valueBase;
+    SCMBClassProperty* propertyDef;
+    scmoInstance._getPropertyAt(node, &value, &valueBase, &propertyDef);
+
+    if (value->flags.isNull)
+    {
+        _appendStartPrefix(out, ns);
+        out.append(propName, propNameLength);
+        out << " " << WsmNamespaces::supportedNamespaces[
+            WsmNamespaces::XML_SCHEMA_INSTANCE].localName;
+        out << STRLIT(":nil=\"true\"/>");
+        return;
+    }
+
+    if (value->flags.isArray)
+    {
+        const SCMBUnion* elements = (const SCMBUnion*) _resolveDataPtr(
+            value->value.arrayValue, valueBase);
+
+        for (Uint32 i = 0, k = value->valueArraySize; i < k; i++)
+        {
+            _appendStartPrefix(out, ns);
+            out.append(propName, propNameLength);
+            out.append('>');
+            _appendValue(out, resourceUri, elements[i], value->valueType,
+                valueBase, refResourceUri, nameSpace);
+            _appendEndPrefix(out, ns);
+            out.append(propName, propNameLength);
+            out.append('>');
+        }
+    }
+    else
+    {
+        _appendStartPrefix(out, ns);
+        out.append(propName, propNameLength);
+        out.append('>');
+        _appendValue(out, resourceUri, value->value, value->valueType,
+            valueBase, refResourceUri, nameSpace);
+        _appendEndPrefix(out, ns);
+        out.append(propName, propNameLength);
+        out.append('>');
+    }
+}
+
+void SCMOWsmWriter::_appendValue(
+    Buffer& out,
+    const String& resourceUri,
+    const SCMBUnion& u,
+    CIMType type,
+    const char* base,
+    const String& refResourceUri,
+    const String& nameSpace)
+{
+    switch (type)
+    {
+        case CIMTYPE_BOOLEAN:
+        {
+            if (u.simple.hasValue)
+            {
+                if (u.simple.val.bin)
+                    out.append(STRLIT_ARGS("true"));
+                else
+                    out.append(STRLIT_ARGS("false"));
+            }
+            break;
+        }
+
+        case CIMTYPE_UINT8:
+        {
+            if (u.simple.hasValue)
+            {
+                append(out, Uint32(u.simple.val.u8));
+            }
+            break;
+        }
+
+        case CIMTYPE_SINT8:
+        {
+            if (u.simple.hasValue)
+            {
+                append(out, Sint32(u.simple.val.s8));
+            }
+            break;
+        }
+
+        case CIMTYPE_UINT16:
+        {
+            if (u.simple.hasValue)
+            {
+                append(out, Uint32(u.simple.val.u16));
+            }
+            break;
+        }
+
+        case CIMTYPE_SINT16:
+        {
+            if (u.simple.hasValue)
+            {
+                append(out, Sint32(u.simple.val.s16));
+            }
+            break;
+        }
+
+        case CIMTYPE_UINT32:
+        {
+            if (u.simple.hasValue)
+            {
+                append(out, u.simple.val.u32);
+            }
+            break;
+        }
+
+        case CIMTYPE_SINT32:
+        {
+            if (u.simple.hasValue)
+            {
+                append(out, u.simple.val.s32);
+            }
+            break;
+        }
+
+        case CIMTYPE_UINT64:
+        {
+            if (u.simple.hasValue)
+            {
+                append(out, u.simple.val.u64);
+            }
+            break;
+        }
+
+        case CIMTYPE_SINT64:
+        {
+            if (u.simple.hasValue)
+            {
+                append(out, u.simple.val.s64);
+            }
+            break;
+        }
+
+        case CIMTYPE_REAL32:
+        case CIMTYPE_REAL64:
+        {
+            if (u.simple.hasValue)
+            {
+                // Real32 values are formatted as Real64 values, as
+                // CIMValue::toString() does.
+                char buffer[128];
+                Uint32 size;
+                const char* str = Real64ToString(buffer,
+                    type == CIMTYPE_REAL32 ?
+                        Real64(u.simple.val.r32) : u.simple.val.r64,
+                    size);
+
+                if (System::strcasecmp(str, PEGASUS_NAN) == 0)
+                    out.append(STRLIT_ARGS("NaN"));
+                else if (System::strcasecmp(str, PEGASUS_INF) == 0)
+                    out.append(STRLIT_ARGS("INF"));
+                else if (System::strcasecmp(str, PEGASUS_NEG_INF) == 0)
+                    out.append(STRLIT_ARGS("-INF"));
+                else
+                    out.append(str, size);
+            }
+            break;
+        }
+
+        case CIMTYPE_CHAR16:
+        {
+            if (u.simple.hasValue)
+            {
+                appendSpecial(out, Char16(u.simple.val.c16));
+            }
+            break;
+        }
+
+        case CIMTYPE_STRING:
+        {
+            if (u.stringValue.start)
+            {
+                appendSpecial(
+                    out,
+                    &(base[u.stringValue.start]),
+                    u.stringValue.size - 1);
+            }
+            break;
+        }
+
+        case CIMTYPE_DATETIME:
+        {
+            // An SCMBDateTime is a CIMDateTimeRep.
+            char buffer[26];
+            _DateTimetoCStr(u.dateTimeValue, buffer);
+
+            String wsmDT;
+            CimToWsmResponseMapper mapper;
+            mapper.convertCimToWsmDatetime(buffer, wsmDT);
+            appendSpecial(out, wsmDT);
+            break;
+        }
+
+        case CIMTYPE_REFERENCE:
+        {
+            if (u.extRefPtr)
+            {
+                CIMObjectPath objPath;
+                u.extRefPtr->getCIMObjectPath(objPath);
+
+                WsmEndpointReference epr;
+                CimToWsmResponseMapper mapper;
+                mapper.convertObjPathToEPR(
+                    refResourceUri, objPath, epr, nameSpace);
+                appendEPRElement(out, epr);
+            }
+            break;
+        }
+
+        case CIMTYPE_OBJECT:
+        case CIMTYPE_INSTANCE:
+        {
+            if (u.extRefPtr)
+            {
+                if (u.extRefPtr->getIsClassOnly())
+                {
+                    throw WsmFault(WsmFault::wsman_InternalError,
+                        MessageLoaderParms(
+                            "WsmServer.CimToWsmResponseMapper."
+                                "EMBEDDED_CLASS_NOT_SUPPORTED",
+                            "Embedded class objects in WS-Management "
+                                "responses are not supported"));
+                }
+
+                appendInstanceElement(
+                    out,
+                    resourceUri,
+                    *u.extRefPtr,
+                    String(u.extRefPtr->getClassName()),
+                    refResourceUri,
+                    nameSpace,
+                    PEGASUS_INSTANCE_NS,
+                    true);
+            }
+            break;
+        }
+
+        default:
+        {
+            PEGASUS_UNREACHABLE(PEGASUS_ASSERT(0);)
+        }
+    }
+}
+
+PEGASUS_NAMESPACE_END
@@ -0,0 +1,103 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%////////////////////////////////////////////////////////////////////////////
+
+#ifndef Pegasus_SCMOWsmWriter_h
+#define Pegasus_SCMOWsmWriter_h
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/Buffer.h>
+#include <Pegasus/Common/String.h>
+#include <Pegasus/Common/SCMO.h>
+#include <Pegasus/Common/SCMOInstance.h>
+#include <Pegasus/WsmServer/WsmWriter.h>
+
+PEGASUS_NAMESPACE_BEGIN
+
+/**
+    Writes instances held in SCMO form as WS-CIM elements (DSP0230) without
+    resolving them to CIMInstance and WsmInstance objects first.  The output
+    is the same as WsmWriter::appendInstanceElement() produces for the
+    WsmInstance that CimToWsmResponseMapper converts the instance to.
+*/
+class PEGASUS_WSMSERVER_LINKAGE SCMOWsmWriter : public WsmWriter
+{
+public:
+
+    /**
+        Appends the element of an instance.
+        @param resourceUri The resource URI the class namespace is formed of.
+        @param scmoInstance The instance to write.
+        @param className The name written for the class of the instance.
+        @param refResourceUri The resource URI of the endpoint references
+            that reference values are written as.
+        @param nameSpace The namespace of the endpoint references of
+            reference values that do not specify one.
+        @param ns The prefix of the class namespace.
+        @param isEmbedded Whether the instance is the value of a property.
+    */
+    static void appendInstanceElement(
+        Buffer& out,
+        const String& resourceUri,
+        const SCMOInstance& scmoInstance,
+        const String& className,
+        const String& refResourceUri,
+        const String& nameSpace,
+        const char* ns,
+        Boolean isEmbedded);
+
+private:
+
+    SCMOWsmWriter();
+
+    static void _appendPropertyElement(
+        Buffer& out,
+        const String& resourceUri,
+        const SCMOInstance& scmoInstance,
+        Uint32 node,
+        const char* propName,
+        Uint32 propNameLength,
+        const String& refResourceUri,
+        const String& nameSpace,
+        const char* ns);
+
+    static void _appendValue(
+        Buffer& out,
+        const String& resourceUri,
+        const SCMBUnion& u,
+        CIMType type,
+        const char* base,
+        const String& refResourceUri,
+        const String& nameSpace);
+};
+
+PEGASUS_NAMESPACE_END
+
+#endif /* Pegasus_SCMOWsmWriter_h */
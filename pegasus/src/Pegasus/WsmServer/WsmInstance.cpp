@@ -40,9 +40,23 @@ WsmInstance::WsmInstance(const String& className) :
 {
 }
 
+WsmInstance::WsmInstance(
+    const SCMOInstance& scmoInstance,
+    const String& resourceUri,
+    const String& nameSpace) :
+    _className(scmoInstance.getClassName()),
+    _scmoInstance(&scmoInstance, 1),
+    _resourceUri(resourceUri),
+    _nameSpace(nameSpace)
+{
+}
+
 WsmInstance::WsmInstance(const WsmInstance& inst) :
     _className(inst._className),
-    _properties(inst._properties)
+    _properties(inst._properties),
+    _scmoInstance(inst._scmoInstance),
+    _resourceUri(inst._resourceUri),
+    _nameSpace(inst._nameSpace)
 {
 }
 
@@ -35,6 +35,7 @@
 #include <Pegasus/Common/Config.h>
 #include <Pegasus/Common/String.h>
 #include <Pegasus/Common/ArrayInternal.h>
+#include <Pegasus/Common/SCMOInstance.h>
 #include <Pegasus/WsmServer/WsmProperty.h>
 
 
@@ -48,6 +49,20 @@ public:
     WsmInstance(const WsmInstance& inst);
     WsmInstance(const String& className);
 
+    /**
+        Constructs a WsmInstance that holds a CIM instance in SCMO form.
+        Its properties are not converted; SCMOWsmWriter writes them
+        directly from the SCMOInstance.
+        @param resourceUri The resource URI of the endpoint references that
+            reference values are written as.
+        @param nameSpace The namespace of the endpoint references of
+            reference values that do not specify one.
+    */
+    WsmInstance(
+        const SCMOInstance& scmoInstance,
+        const String& resourceUri,
+        const String& nameSpace);
+
     const String& getClassName() const
     {
         return _className;
@@ -63,10 +78,36 @@ public:
     void addProperty(const WsmProperty& prop);
     Uint32 getPropertyCount() const;
 
+    Boolean isSCMOInstance() const
+    {
+        return _scmoInstance.size() != 0;
+    }
+
+    const SCMOInstance& getSCMOInstance() const
+    {
+        return _scmoInstance[0];
+    }
+
+    const String& getResourceUri() const
+    {
+        return _resourceUri;
+    }
+
+    const String& getNameSpace() const
+    {
+        return _nameSpace;
+    }
+
 private:
 
     String _className;
     Array<WsmProperty> _properties;
+
+    // SCMOInstance objects must not be copied uninitialized, so the
+    // SCMO representation is stored as a zero or one element array.
+    Array<SCMOInstance> _scmoInstance;
+    String _resourceUri;
+    String _nameSpace;
 };
 
 
@@ -46,6 +46,32 @@ PEGASUS_NAMESPACE_BEGIN
 
 Uint64 WsmProcessor::_currentEnumContext = 0;
 
+static struct timeval deallocateWait = { 300, 0 };
+
+/**
+    Parameters of a thread that forwards a CIM request issued while a CIM
+    response was being handled.
+*/
+struct WsmDeferredRequest
+{
+    WsmDeferredRequest(MessageQueue* queue_, CIMRequestMessage* request_)
+        : queue(queue_), request(request_)
+    {
+    }
+
+    MessageQueue* queue;
+    CIMRequestMessage* request;
+};
+
+static ThreadReturnType PEGASUS_THREAD_CDECL _forwardDeferredRequest(
+    void* parm)
+{
+    WsmDeferredRequest* deferred = reinterpret_cast<WsmDeferredRequest*>(parm);
+    deferred->queue->enqueue(deferred->request);
+    delete deferred;
+    return ThreadReturnType(0);
+}
+
 WsmProcessor::WsmProcessor(
     MessageQueue* cimOperationProcessorQueue,
     CIMRepository* repository)
@@ -54,7 +80,9 @@ WsmProcessor::WsmProcessor(
       _wsmRequestDecoder(this),
       _cimOperationProcessorQueue(cimOperationProcessorQueue),
       _repository(repository),
-      _wsmToCimRequestMapper(repository)
+      _wsmToCimRequestMapper(repository),
+      _deferredRequestThreadPool(
+          0, "WsmProcessor", 0, 0, deallocateWait)
 {
     _initializeSubInfoTable();
 }
@@ -65,6 +93,7 @@ WsmProcessor::~WsmProcessor()
     for (WsmEnumerationContextTable::Iterator i =
              _WsmEnumerationContextTable.start(); i; i++)
     {
+        delete i.value().request;
         delete i.value().response;
     }
 }
@@ -174,7 +203,10 @@ void WsmProcessor::handleRequest(WsmRequest* wsmRequest)
         {
             // Save the request until the response comes back.
             // Note that the CIM request has its own unique message ID.
-            _requestTable.insert(cimRequest->messageId, wsmRequest);
+            {
+                AutoMutex lock(_requestTableLock);
+                _requestTable.insert(cimRequest->messageId, wsmRequest);
+            }
 
             cimRequest->queueIds.push(getQueueId());
             _cimOperationProcessorQueue->enqueue(cimRequest);
@@ -186,7 +218,13 @@ void WsmProcessor::handleRequest(WsmRequest* wsmRequest)
             switch (wsmRequest->getType())
             {
                 case WS_ENUMERATION_PULL:
-                    _handlePullRequest((WsenPullRequest*) wsmRequest);
+                    // A Pull request that needs more items from the CIM
+                    // enumeration is kept until the CIM pull response
+                    // comes back.
+                    if (_handlePullRequest((WsenPullRequest*) wsmRequest))
+                    {
+                        wsmRequestDestroyer.release();
+                    }
                     break;
 
                 case WS_ENUMERATION_RELEASE:
@@ -254,24 +292,65 @@ void WsmProcessor::handleResponse(CIMResponseMessage* cimResponse)
 
     AutoPtr<CIMResponseMessage> cimResponseDestroyer(cimResponse);
 
+    // CIM enumerations are closed on behalf of released and expired
+    // enumeration contexts, so there is no request to respond to.
+    if (cimResponse->getType() == CIM_CLOSE_ENUMERATION_RESPONSE_MESSAGE)
+    {
+        if (cimResponse->cimException.getCode() != CIM_ERR_SUCCESS)
+        {
+            PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL2,
+                "CloseEnumeration failed: %s",
+                (const char*)cimResponse->cimException.getMessage().
+                    getCString()));
+        }
+        PEG_METHOD_EXIT();
+        return;
+    }
+
     // Lookup the request this response corresponds to
     WsmRequest* wsmRequest = 0;
 
-    PEGASUS_FCT_EXECUTE_AND_ASSERT(
-        true,
-        _requestTable.lookup(cimResponse->messageId, wsmRequest));
+    {
+        AutoMutex lock(_requestTableLock);
+        PEGASUS_FCT_EXECUTE_AND_ASSERT(
+            true,
+            _requestTable.lookup(cimResponse->messageId, wsmRequest));
+        _requestTable.remove(cimResponse->messageId);
+    }
 
     AutoPtr<WsmRequest> wsmRequestDestroyer(wsmRequest);
-    _requestTable.remove(cimResponse->messageId);
+
+    // Lookup the enumeration context a CIM pull was issued for
+    Uint64 contextId = 0;
+    Boolean isPullResponse;
+
+    {
+        AutoMutex lock(_WsmEnumerationContextTableLock);
+        isPullResponse =
+            _pullRequestTable.lookup(cimResponse->messageId, contextId);
+        _pullRequestTable.remove(cimResponse->messageId);
+    }
 
     try
     {
-        switch (wsmRequest->getType())
+        if (isPullResponse)
+        {
+            // An Enumerate request that is still needed is owned by its
+            // enumeration context.
+            if (_handlePullResponse(cimResponse, wsmRequest, contextId))
+            {
+                wsmRequestDestroyer.release();
+            }
+        }
+        else switch (wsmRequest->getType())
         {
             case WS_ENUMERATION_ENUMERATE:
-                _handleEnumerateResponse(
-                    cimResponse,
-                    (WsenEnumerateRequest*) wsmRequest);
+                if (_handleEnumerateResponse(
+                        cimResponse,
+                        (WsenEnumerateRequest*) wsmRequest))
+                {
+                    wsmRequestDestroyer.release();
+                }
                 break;
             case WS_SUBSCRIPTION_CREATE:
                 _handleSubscriptionResponse(
@@ -414,30 +493,56 @@ Uint32 WsmProcessor::getWsmRequestDecoderQueueId()
     return _wsmRequestDecoder.getQueueId();
 }
 
-void WsmProcessor::_handleEnumerateResponse(
+Boolean WsmProcessor::_handleEnumerateResponse(
     CIMResponseMessage* cimResponse,
     WsenEnumerateRequest* wsmRequest)
 {
     if (cimResponse->cimException.getCode() != CIM_ERR_SUCCESS)
     {
         _handleDefaultResponse(cimResponse, wsmRequest);
-        return;
+        return false;
     }
 
-    AutoPtr<SoapResponse> soapResponse;
+    CIMOpenOrPullResponseDataMessage* openResponse =
+        (CIMOpenOrPullResponseDataMessage*) cimResponse;
+    CIMNamespaceName nameSpace =
+        WsmToCimRequestMapper::getEnumerationNameSpace(wsmRequest);
+    String cimEnumerationContext = openResponse->endOfSequence ?
+        String::EMPTY : openResponse->enumerationContext;
 
-    {
-        AutoMutex lock(_WsmEnumerationContextTableLock);
+    AutoPtr<WsenEnumerateResponse> wsmResponse;
+    CIMDateTime expiration;
 
-        AutoPtr<WsenEnumerateResponse> wsmResponse(
-            (WsenEnumerateResponse*) _cimToWsmResponseMapper.
-                mapToWsmResponse(wsmRequest, cimResponse));
+    try
+    {
+        wsmResponse.reset((WsenEnumerateResponse*) _cimToWsmResponseMapper.
+            mapToWsmResponse(wsmRequest, cimResponse));
 
         // Get the enumeration expiration time
-        CIMDateTime expiration;
         _getExpirationDatetime(wsmRequest->expiration, expiration);
+    }
+    catch (...)
+    {
+        if (cimEnumerationContext.size())
+        {
+            _closeCimEnumeration(
+                _wsmToCimRequestMapper.mapToCimCloseEnumerationRequest(
+                    wsmRequest, nameSpace, cimEnumerationContext));
+        }
+        throw;
+    }
+
+    AutoPtr<SoapResponse> soapResponse;
+    AutoPtr<CIMPullOperationRequestMessage> cimRequest;
+    AutoPtr<CIMCloseEnumerationRequestMessage> closeRequest;
+    Boolean retained;
+
+    try
+    {
+        AutoMutex lock(_WsmEnumerationContextTableLock);
 
-        // Create a new context
+        // Create a new context.  It owns the Enumerate request until the
+        // enumeration is complete.
         Uint64 contextId = _currentEnumContext++;
         _WsmEnumerationContextTable.insert(
             contextId,
@@ -447,47 +552,162 @@ void WsmProcessor::_handleEnumerateResponse(
                 wsmRequest->enumerationMode,
                 expiration,
                 wsmRequest->epr,
-                wsmResponse.get()));
-        wsmResponse->setEnumerationContext(contextId);
+                wsmRequest,
+                wsmResponse.release(),
+                nameSpace,
+                cimEnumerationContext));
 
-        // Get the requsted chunk of results
-        AutoPtr<WsenEnumerateResponse> splitResponse(
-            _splitEnumerateResponse(wsmRequest, wsmResponse.get(),
-                wsmRequest->optimized ? wsmRequest->maxElements : 0));
-        splitResponse->setEnumerationContext(contextId);
+        WsmEnumerationContext* enumContext;
+        _WsmEnumerationContextTable.lookupReference(contextId, enumContext);
 
-        // If no items are left in the original response, mark split
-        // response as complete
-        if (wsmResponse->getSize() == 0)
+        try
         {
-            splitResponse->setComplete();
+            cimRequest.reset(_continueEnumeration(
+                enumContext, wsmRequest, true, soapResponse));
+        }
+        catch (...)
+        {
+            if (enumContext->cimEnumerationContext.size())
+            {
+                closeRequest.reset(
+                    _wsmToCimRequestMapper.mapToCimCloseEnumerationRequest(
+                        wsmRequest,
+                        nameSpace,
+                        enumContext->cimEnumerationContext));
+            }
+            _removeEnumerationContext(enumContext, wsmRequest);
+            throw;
         }
 
-        Uint32 numDataItemsEncoded = 0;
-        soapResponse.reset(_wsmResponseEncoder.encodeWsenEnumerateResponse(
-            splitResponse.get(), numDataItemsEncoded));
+        retained = _WsmEnumerationContextTable.contains(contextId);
+    }
+    catch (...)
+    {
+        // The enumeration context table lock is released here.
+        if (closeRequest.get())
+        {
+            _closeCimEnumeration(closeRequest.release());
+        }
+        throw;
+    }
 
-        if (splitResponse->getSize() > numDataItemsEncoded)
+    if (cimRequest.get())
+    {
+        _enqueueDeferredRequest(cimRequest.release());
+    }
+    else
+    {
+        _wsmResponseEncoder.sendResponse(soapResponse.get());
+    }
+
+    return retained;
+}
+
+Boolean WsmProcessor::_handlePullResponse(
+    CIMResponseMessage* cimResponse,
+    WsmRequest* wsmRequest,
+    Uint64 contextId)
+{
+    CIMOpenOrPullResponseDataMessage* pullResponse =
+        (CIMOpenOrPullResponseDataMessage*) cimResponse;
+    AutoPtr<SoapResponse> soapResponse;
+    AutoPtr<CIMPullOperationRequestMessage> cimRequest;
+    AutoPtr<CIMCloseEnumerationRequestMessage> closeRequest;
+    Boolean retained;
+
+    try
+    {
+        AutoMutex lock(_WsmEnumerationContextTableLock);
+
+        // A context is neither released nor expired while a CIM pull is
+        // outstanding for it.
+        WsmEnumerationContext* enumContext = 0;
+        PEGASUS_FCT_EXECUTE_AND_ASSERT(
+            true,
+            _WsmEnumerationContextTable.lookupReference(
+                contextId, enumContext));
+
+        enumContext->pullPending = false;
+
+        if (cimResponse->cimException.getCode() != CIM_ERR_SUCCESS)
         {
-            // Add unprocessed items back to the context
-            splitResponse->remove(0, numDataItemsEncoded);
-            wsmResponse->merge(splitResponse.get());
+            // The CIM enumeration is closed after an error.
+            _removeEnumerationContext(enumContext, wsmRequest);
+
+            // The CIM enumeration expires if the client waits longer than
+            // the operation timeout between two Pull requests.
+            if (cimResponse->cimException.getCode() ==
+                CIM_ERR_INVALID_ENUMERATION_CONTEXT)
+            {
+                throw WsmFault(
+                    WsmFault::wsen_InvalidEnumerationContext,
+                    MessageLoaderParms(
+                        "WsmServer.WsmProcessor.INVALID_ENUMERATION_CONTEXT",
+                        "Enumeration context \"$0\" is not valid.",
+                        contextId));
+            }
+
+            throw cimResponse->cimException;
         }
 
-        // Remove the context if there are no instances left
-        if (wsmResponse->getSize() == 0)
+        try
         {
-            _WsmEnumerationContextTable.remove(contextId);
+            AutoPtr<WsenEnumerateResponse> wsmResponse(
+                (WsenEnumerateResponse*) _cimToWsmResponseMapper.
+                    mapToWsmResponse(enumContext->request, cimResponse));
+
+            enumContext->cimEnumerationContext =
+                pullResponse->endOfSequence ?
+                    String::EMPTY : pullResponse->enumerationContext;
+
+            // Stop retrieving items if this pull produced none, so a
+            // response is sent even if a filter drops many objects.
+            Boolean retrieveItems = wsmResponse->getSize() > 0;
+            enumContext->response->merge(wsmResponse.get());
+
+            cimRequest.reset(_continueEnumeration(
+                enumContext, wsmRequest, retrieveItems, soapResponse));
         }
-        else
+        catch (...)
         {
-            // If the context is not removed, the pointer to the response is
-            // now owned by the context
-            wsmResponse.release();
+            if (enumContext->cimEnumerationContext.size())
+            {
+                closeRequest.reset(
+                    _wsmToCimRequestMapper.mapToCimCloseEnumerationRequest(
+                        enumContext->request,
+                        enumContext->nameSpace,
+                        enumContext->cimEnumerationContext));
+            }
+            _removeEnumerationContext(enumContext, wsmRequest);
+            throw;
+        }
+
+        // The request is also needed while another CIM pull is issued
+        // for it.
+        retained = cimRequest.get() ||
+            ((wsmRequest->getType() == WS_ENUMERATION_ENUMERATE) &&
+                _WsmEnumerationContextTable.contains(contextId));
+    }
+    catch (...)
+    {
+        // The enumeration context table lock is released here.
+        if (closeRequest.get())
+        {
+            _closeCimEnumeration(closeRequest.release());
         }
+        throw;
     }
 
-    _wsmResponseEncoder.sendResponse(soapResponse.get());
+    if (cimRequest.get())
+    {
+        _enqueueDeferredRequest(cimRequest.release());
+    }
+    else
+    {
+        _wsmResponseEncoder.sendResponse(soapResponse.get());
+    }
+
+    return retained;
 }
 
 void WsmProcessor::_handleSubscriptionResponse(
@@ -718,9 +938,10 @@ void WsmProcessor::_handleSubscriptionDeleteResponse(
     return;
 }
 
-void WsmProcessor::_handlePullRequest(WsenPullRequest* wsmRequest)
+Boolean WsmProcessor::_handlePullRequest(WsenPullRequest* wsmRequest)
 {
     AutoPtr<SoapResponse> soapResponse;
+    AutoPtr<CIMPullOperationRequestMessage> cimRequest;
 
     {
         AutoMutex lock(_WsmEnumerationContextTableLock);
@@ -754,32 +975,19 @@ void WsmProcessor::_handlePullRequest(WsenPullRequest* wsmRequest)
                 throw WsmFault(WsmFault::wsman_AccessDenied);
             }
 
-            AutoPtr<WsenPullResponse> wsmResponse(_splitPullResponse(
-                wsmRequest, enumContext->response, wsmRequest->maxElements));
-            wsmResponse->setEnumerationContext(enumContext->contextId);
-            if (enumContext->response->getSize() == 0)
+            if (enumContext->pullPending)
             {
-                wsmResponse->setComplete();
-            }
-
-            Uint32 numDataItemsEncoded = 0;
-            soapResponse.reset(_wsmResponseEncoder.encodeWsenPullResponse(
-                wsmResponse.get(), numDataItemsEncoded));
-
-            if (wsmResponse->getSize() > numDataItemsEncoded)
-            {
-                // Add unprocessed items back to the context
-                wsmResponse->remove(0, numDataItemsEncoded);
-                enumContext->response->merge(wsmResponse.get());
+                throw WsmFault(
+                    WsmFault::wsman_Concurrency,
+                    MessageLoaderParms(
+                        "WsmServer.WsmProcessor.ENUMERATION_CONTEXT_IN_USE",
+                        "Enumeration context \"$0\" is in use by another "
+                            "request.",
+                        wsmRequest->enumerationContext));
             }
 
-            // Remove the context if there are no instances left
-            if (enumContext->response->getSize() == 0)
-            {
-                delete enumContext->response;
-                _WsmEnumerationContextTable.remove(
-                    wsmRequest->enumerationContext);
-            }
+            cimRequest.reset(_continueEnumeration(
+                enumContext, wsmRequest, true, soapResponse));
         }
         else
         {
@@ -792,22 +1000,30 @@ void WsmProcessor::_handlePullRequest(WsenPullRequest* wsmRequest)
         }
     }
 
+    if (cimRequest.get())
+    {
+        _cimOperationProcessorQueue->enqueue(cimRequest.release());
+        return true;
+    }
+
     _wsmResponseEncoder.sendResponse(soapResponse.get());
+    return false;
 }
 
 void WsmProcessor::_handleReleaseRequest(WsenReleaseRequest* wsmRequest)
 {
     AutoPtr<WsenReleaseResponse> wsmResponse;
+    AutoPtr<CIMCloseEnumerationRequestMessage> closeRequest;
 
     {
         AutoMutex lock(_WsmEnumerationContextTableLock);
 
-        WsmEnumerationContext enumContext;
-        if (_WsmEnumerationContextTable.lookup(
+        WsmEnumerationContext* enumContext;
+        if (_WsmEnumerationContextTable.lookupReference(
                 wsmRequest->enumerationContext, enumContext))
         {
             // EPRs of the request and the enumeration context must match
-            if (wsmRequest->epr != enumContext.epr)
+            if (wsmRequest->epr != enumContext->epr)
             {
                 throw WsmFault(
                     WsmFault::wsa_MessageInformationHeaderRequired,
@@ -819,7 +1035,7 @@ void WsmProcessor::_handleReleaseRequest(WsenReleaseRequest* wsmRequest)
 
             // User credentials of the request and the enumeration context must
             // match.
-            if (wsmRequest->userName != enumContext.userName)
+            if (wsmRequest->userName != enumContext->userName)
             {
                 // DSP0226 R8.1-6:  The wsen:Pull and wsen:Release operations
                 // are a continuation of the original wsen:Enumerate operation.
@@ -831,11 +1047,30 @@ void WsmProcessor::_handleReleaseRequest(WsenReleaseRequest* wsmRequest)
                 throw WsmFault(WsmFault::wsman_AccessDenied);
             }
 
+            if (enumContext->pullPending)
+            {
+                throw WsmFault(
+                    WsmFault::wsman_Concurrency,
+                    MessageLoaderParms(
+                        "WsmServer.WsmProcessor.ENUMERATION_CONTEXT_IN_USE",
+                        "Enumeration context \"$0\" is in use by another "
+                            "request.",
+                        wsmRequest->enumerationContext));
+            }
+
             wsmResponse.reset(new WsenReleaseResponse(
-                wsmRequest, enumContext.response->getContentLanguages()));
+                wsmRequest, enumContext->response->getContentLanguages()));
 
-            delete enumContext.response;
-            _WsmEnumerationContextTable.remove(wsmRequest->enumerationContext);
+            if (enumContext->cimEnumerationContext.size())
+            {
+                closeRequest.reset(
+                    _wsmToCimRequestMapper.mapToCimCloseEnumerationRequest(
+                        enumContext->request,
+                        enumContext->nameSpace,
+                        enumContext->cimEnumerationContext));
+            }
+
+            _removeEnumerationContext(enumContext, wsmRequest);
         }
         else
         {
@@ -848,9 +1083,185 @@ void WsmProcessor::_handleReleaseRequest(WsenReleaseRequest* wsmRequest)
         }
     }
 
+    if (closeRequest.get())
+    {
+        _closeCimEnumeration(closeRequest.release());
+    }
+
     _wsmResponseEncoder.enqueue(wsmResponse.get());
 }
 
+CIMPullOperationRequestMessage* WsmProcessor::_continueEnumeration(
+    WsmEnumerationContext* enumContext,
+    WsmRequest* wsmRequest,
+    Boolean retrieveItems,
+    AutoPtr<SoapResponse>& soapResponse)
+{
+    Boolean isEnumerate = (wsmRequest->getType() == WS_ENUMERATION_ENUMERATE);
+    Uint32 maxElements;
+
+    if (isEnumerate)
+    {
+        maxElements = enumContext->request->optimized ?
+            enumContext->request->maxElements : 0;
+    }
+    else
+    {
+        maxElements = ((WsenPullRequest*) wsmRequest)->maxElements;
+    }
+
+    // Retrieve items until the response can be filled and it is known
+    // whether it completes the enumeration.
+    if (retrieveItems && enumContext->cimEnumerationContext.size() &&
+        enumContext->response->getSize() <= maxElements)
+    {
+        AutoPtr<CIMPullOperationRequestMessage> cimRequest(
+            _wsmToCimRequestMapper.mapToCimPullRequest(
+                wsmRequest,
+                enumContext->nameSpace,
+                enumContext->cimEnumerationContext,
+                enumContext->enumerationMode,
+                maxElements - enumContext->response->getSize()));
+        cimRequest->queueIds.push(getQueueId());
+
+        // Save the request until the response comes back.
+        {
+            AutoMutex lock(_requestTableLock);
+            _requestTable.insert(cimRequest->messageId, wsmRequest);
+        }
+        _pullRequestTable.insert(
+            cimRequest->messageId, enumContext->contextId);
+        enumContext->pullPending = true;
+
+        return cimRequest.release();
+    }
+
+    Uint32 numDataItemsEncoded = 0;
+
+    if (isEnumerate)
+    {
+        // Get the requested chunk of results
+        AutoPtr<WsenEnumerateResponse> splitResponse(
+            _splitEnumerateResponse(
+                enumContext->request, enumContext->response, maxElements));
+        splitResponse->setEnumerationContext(enumContext->contextId);
+
+        // If no items are left, mark the split response as complete
+        if (!enumContext->cimEnumerationContext.size() &&
+            enumContext->response->getSize() == 0)
+        {
+            splitResponse->setComplete();
+        }
+
+        soapResponse.reset(_wsmResponseEncoder.encodeWsenEnumerateResponse(
+            splitResponse.get(), numDataItemsEncoded));
+
+        if (splitResponse->getSize() > numDataItemsEncoded)
+        {
+            // Add unprocessed items back to the context
+            splitResponse->remove(0, numDataItemsEncoded);
+            enumContext->response->merge(splitResponse.get());
+        }
+    }
+    else
+    {
+        AutoPtr<WsenPullResponse> splitResponse(_splitPullResponse(
+            (WsenPullRequest*) wsmRequest, enumContext->response, maxElements));
+        splitResponse->setEnumerationContext(enumContext->contextId);
+
+        // If no items are left, mark the split response as complete
+        if (!enumContext->cimEnumerationContext.size() &&
+            enumContext->response->getSize() == 0)
+        {
+            splitResponse->setComplete();
+        }
+
+        soapResponse.reset(_wsmResponseEncoder.encodeWsenPullResponse(
+            splitResponse.get(), numDataItemsEncoded));
+
+        if (splitResponse->getSize() > numDataItemsEncoded)
+        {
+            // Add unprocessed items back to the context
+            splitResponse->remove(0, numDataItemsEncoded);
+            enumContext->response->merge(splitResponse.get());
+        }
+    }
+
+    // Remove the context if there are no items left
+    if (!enumContext->cimEnumerationContext.size() &&
+        enumContext->response->getSize() == 0)
+    {
+        _removeEnumerationContext(enumContext, wsmRequest);
+    }
+
+    return 0;
+}
+
+void WsmProcessor::_removeEnumerationContext(
+    WsmEnumerationContext* enumContext,
+    WsmRequest* wsmRequest)
+{
+    if (enumContext->request != wsmRequest)
+    {
+        delete enumContext->request;
+    }
+    delete enumContext->response;
+    _WsmEnumerationContextTable.remove(enumContext->contextId);
+}
+
+void WsmProcessor::_closeCimEnumeration(
+    CIMCloseEnumerationRequestMessage* cimRequest)
+{
+    cimRequest->queueIds.push(getQueueId());
+    _enqueueDeferredRequest(cimRequest);
+}
+
+void WsmProcessor::_enqueueDeferredRequest(CIMRequestMessage* cimRequest)
+{
+    PEG_METHOD_ENTER(TRC_WSMSERVER, "WsmProcessor::_enqueueDeferredRequest");
+
+    AutoPtr<CIMRequestMessage> request(cimRequest);
+    AutoPtr<WsmDeferredRequest> deferred(
+        new WsmDeferredRequest(_cimOperationProcessorQueue, cimRequest));
+
+    ThreadStatus rtn = PEGASUS_THREAD_OK;
+    while ((rtn = _deferredRequestThreadPool.allocate_and_awaken(
+                deferred.get(), _forwardDeferredRequest)) != PEGASUS_THREAD_OK)
+    {
+        if (rtn == PEGASUS_THREAD_INSUFFICIENT_RESOURCES)
+        {
+            Threads::yield();
+        }
+        else
+        {
+            PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL1,
+                "Could not allocate a thread to forward CIM request %s.",
+                (const char*)cimRequest->messageId.getCString()));
+
+            // Fail the request as the CIM server would, so that the WS-Man
+            // request waiting for it gets a fault and its enumeration
+            // context is no longer marked as having a pull pending.
+            AutoPtr<CIMResponseMessage> cimResponse(request->buildResponse());
+            cimResponse->cimException = PEGASUS_CIM_EXCEPTION_L(
+                CIM_ERR_FAILED,
+                MessageLoaderParms(
+                    "WsmServer.WsmProcessor.FORWARD_REQUEST_FAILED",
+                    "Could not allocate a thread to process the request."));
+            request.reset();
+            handleResponse(cimResponse.release());
+
+            PEG_METHOD_EXIT();
+            return;
+        }
+    }
+
+    // The forwarding thread now owns the request.
+    deferred.release();
+    request.release();
+
+    PEG_METHOD_EXIT();
+}
+
 void WsmProcessor::_handleDefaultResponse(
     CIMResponseMessage* cimResponse, WsmRequest* wsmRequest)
 {
@@ -869,7 +1280,7 @@ WsenEnumerateResponse* WsmProcessor::_splitEnumerateResponse(
     WsenEnumerationData splitData;
     response->getEnumerationData().split(splitData, num);
 
-    return new WsenEnumerateResponse(splitData, response->getItemCount(),
+    return new WsenEnumerateResponse(splitData, splitData.getSize(),
         request, response->getContentLanguages());
 }
 
@@ -947,25 +1358,46 @@ void WsmProcessor::_getExpirationDatetime(
 void WsmProcessor::cleanupExpiredContexts()
 {
     CIMDateTime currentDT = CIMDateTime::getCurrentDateTime();
-    Array<Uint64> expiredContextIds;
-    Array<WsenEnumerateResponse*> expiredResponses;
+    Array<CIMCloseEnumerationRequestMessage*> closeRequests;
 
-    AutoMutex lock(_WsmEnumerationContextTableLock);
-    for (WsmEnumerationContextTable::Iterator i =
-             _WsmEnumerationContextTable.start (); i; i++)
     {
-        WsmEnumerationContext context = i.value();
-        if (context.expiration < currentDT)
+        AutoMutex lock(_WsmEnumerationContextTableLock);
+        Array<Uint64> expiredContextIds;
+
+        for (WsmEnumerationContextTable::Iterator i =
+                 _WsmEnumerationContextTable.start (); i; i++)
         {
-            expiredContextIds.append(context.contextId);
-            expiredResponses.append(context.response);
+            // A context with an outstanding CIM pull expires after the
+            // response to the pull is processed.
+            WsmEnumerationContext context = i.value();
+            if (context.expiration < currentDT && !context.pullPending)
+            {
+                expiredContextIds.append(context.contextId);
+            }
+        }
+
+        for (Uint32 i = 0; i < expiredContextIds.size(); i++)
+        {
+            WsmEnumerationContext* enumContext;
+            _WsmEnumerationContextTable.lookupReference(
+                expiredContextIds[i], enumContext);
+
+            if (enumContext->cimEnumerationContext.size())
+            {
+                closeRequests.append(
+                    _wsmToCimRequestMapper.mapToCimCloseEnumerationRequest(
+                        enumContext->request,
+                        enumContext->nameSpace,
+                        enumContext->cimEnumerationContext));
+            }
+
+            _removeEnumerationContext(enumContext, 0);
         }
     }
 
-    for (Uint32 i = 0; i < expiredContextIds.size(); i++)
+    for (Uint32 i = 0; i < closeRequests.size(); i++)
     {
-        delete expiredResponses[i];
-        _WsmEnumerationContextTable.remove(expiredContextIds[i]);
+        _closeCimEnumeration(closeRequests[i]);
     }
 }
 
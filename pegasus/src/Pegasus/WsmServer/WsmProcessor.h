@@ -35,6 +35,7 @@
 #include <Pegasus/Common/Config.h>
 #include <Pegasus/Common/MessageQueue.h>
 #include <Pegasus/Common/CIMMessage.h>
+#include <Pegasus/Common/ThreadPool.h>
 #include <Pegasus/Repository/CIMRepository.h>
 #include <Pegasus/WsmServer/WsmRequestDecoder.h>
 #include <Pegasus/WsmServer/WsmResponseEncoder.h>
@@ -44,6 +45,11 @@
 
 PEGASUS_NAMESPACE_BEGIN
 
+/**
+    A WsmEnumerationContext tracks a WS-Management enumeration.  The items
+    are retrieved from the CIM enumeration opened for it as the client pulls
+    them, so only the items of the pending response are held in the context.
+*/
 class WsmEnumerationContext
 {
 public:
@@ -54,20 +60,35 @@ public:
         WsenEnumerationMode enumerationMode_,
         CIMDateTime expiration_,
         WsmEndpointReference epr_,
-        WsenEnumerateResponse* response_)
+        WsenEnumerateRequest* request_,
+        WsenEnumerateResponse* response_,
+        const CIMNamespaceName& nameSpace_,
+        const String& cimEnumerationContext_)
         : contextId(contextId_),
           userName(userName_),
           enumerationMode(enumerationMode_),
           expiration(expiration_),
           epr(epr_),
-          response(response_) {}
+          request(request_),
+          response(response_),
+          nameSpace(nameSpace_),
+          cimEnumerationContext(cimEnumerationContext_),
+          pullPending(false) {}
 
     Uint64 contextId;
     String userName;
     WsenEnumerationMode enumerationMode;
     CIMDateTime expiration;
     WsmEndpointReference epr;
+    // The Enumerate request, used to map the pulled CIM objects
+    WsenEnumerateRequest* request;
+    // The items retrieved but not yet returned to the client
     WsenEnumerateResponse* response;
+    CIMNamespaceName nameSpace;
+    // Empty once the CIM enumeration has returned all of its objects
+    String cimEnumerationContext;
+    // True while a CIM pull is outstanding for the context
+    Boolean pullPending;
 };
 
 /**
@@ -167,11 +188,51 @@ public:
 
 private:
 
-    void _handlePullRequest(WsenPullRequest* wsmRequest);
+    Boolean _handlePullRequest(WsenPullRequest* wsmRequest);
     void _handleReleaseRequest(WsenReleaseRequest* wsmRequest);
-    void _handleEnumerateResponse(
+    Boolean _handleEnumerateResponse(
         CIMResponseMessage* cimResponse,
         WsenEnumerateRequest* wsmRequest);
+    Boolean _handlePullResponse(
+        CIMResponseMessage* cimResponse,
+        WsmRequest* wsmRequest,
+        Uint64 contextId);
+
+    /**
+        Continues an enumeration on behalf of its Enumerate request or a
+        Pull request.  If the context holds too few items for the response
+        and the CIM enumeration is still open, a CIM pull request is
+        returned, which the caller enqueues after releasing the enumeration
+        context table lock.  Otherwise the response is encoded into
+        soapResponse, 0 is returned, and the context is removed if the
+        enumeration is complete.  No more items are retrieved if
+        retrieveItems is false.
+    */
+    CIMPullOperationRequestMessage* _continueEnumeration(
+        WsmEnumerationContext* enumContext,
+        WsmRequest* wsmRequest,
+        Boolean retrieveItems,
+        AutoPtr<SoapResponse>& soapResponse);
+
+    /**
+        Removes an enumeration context from the table and deletes the
+        Enumerate request and the items it holds.  The Enumerate request
+        is not deleted if it is wsmRequest, which its caller owns.
+    */
+    void _removeEnumerationContext(
+        WsmEnumerationContext* enumContext,
+        WsmRequest* wsmRequest);
+
+    void _closeCimEnumeration(CIMCloseEnumerationRequestMessage* cimRequest);
+
+    /**
+        Forwards a CIM request to the CIMOperationRequestDispatcher on a
+        separate thread.  The dispatcher delivers CIM responses while it
+        holds the state of the operation, so a request issued while such a
+        response is handled must not re-enter it on the same thread.
+    */
+    void _enqueueDeferredRequest(CIMRequestMessage* cimRequest);
+
     void _handleSubscriptionResponse(
         CIMResponseMessage* cimResponse,
         WxfSubCreateRequest* wsmRequest);
@@ -235,6 +296,12 @@ private:
     WsmToCimRequestMapper _wsmToCimRequestMapper;
     CimToWsmResponseMapper _cimToWsmResponseMapper;
 
+    /**
+        Threads that forward the CIM requests issued while CIM responses
+        are handled.
+    */
+    ThreadPool _deferredRequestThreadPool;
+
     typedef HashTable<String,
         WsmRequest*, EqualFunc<String>, HashFunc<String> > RequestTable;
     /**
@@ -244,13 +311,26 @@ private:
         A unique message ID is used for CIM operation messages, different from
         the WS-Management request message ID.  The CIM operation message ID
         is used as the hash key.
+        Responses to CIM pull requests are handled on other threads than
+        the requests are issued on, so the table is guarded by
+        _requestTableLock.
     */
     RequestTable _requestTable;
+    Mutex _requestTableLock;
 
     typedef HashTable<Uint64, WsmEnumerationContext,
         EqualFunc<Uint64>, HashFunc<Uint64> > WsmEnumerationContextTable;
 
     WsmEnumerationContextTable _WsmEnumerationContextTable;
+
+    typedef HashTable<String, Uint64,
+        EqualFunc<String>, HashFunc<String> > PullRequestTable;
+    /**
+        The PullRequestTable maps the message ID of each outstanding CIM pull
+        request to the enumeration context it was issued for.  The request
+        the pulled items are for is kept in the RequestTable.
+    */
+    PullRequestTable _pullRequestTable;
     Mutex _WsmEnumerationContextTableLock;
     static Uint64 _currentEnumContext;
 
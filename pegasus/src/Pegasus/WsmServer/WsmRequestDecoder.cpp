@@ -124,6 +124,7 @@ void WsmRequestDecoder::sendResponse(
     if (queue)
     {
         AutoPtr<HTTPMessage> httpMessage(new HTTPMessage(message));
+        httpMessage->dest = queueId;
         httpMessage->setCloseConnect(httpCloseConnect);
         queue->enqueue(httpMessage.release());
     }
@@ -96,6 +96,7 @@ void WsmResponseEncoder::_sendResponse(SoapResponse* response)
 
     AutoPtr<HTTPMessage> httpMessage(new HTTPMessage(message));
 
+    httpMessage->dest = queueId;
     httpMessage->setCloseConnect(httpCloseConnect);
     queue->enqueue(httpMessage.release());
 
@@ -234,7 +235,7 @@ void WsmResponseEncoder::enqueue(WsmResponse* response)
         PEGASUS_ASSERT(httpQueue);
 
         // Handle the internal server error on this connection.
-        httpQueue->handleInternalServerError(0, true);
+        httpQueue->handleInternalServerError(response->getQueueId(), 0, true);
     }
 
     PEG_METHOD_EXIT();
@@ -416,11 +417,36 @@ SoapResponse* WsmResponseEncoder::encodeWsenEnumerateResponse(
 
     if (response->requestedItemCount())
     {
-        WsmWriter::appendStartTag(
-            headers, WsmNamespaces::WS_MAN, STRLIT("TotalItemsCountEstimate"));
-        WsmWriter::append(headers, response->getItemCount());
-        WsmWriter::appendEndTag(
-            headers, WsmNamespaces::WS_MAN, STRLIT("TotalItemsCountEstimate"));
+        if (response->isComplete())
+        {
+            WsmWriter::appendStartTag(
+                headers,
+                WsmNamespaces::WS_MAN,
+                STRLIT("TotalItemsCountEstimate"));
+            WsmWriter::append(headers, response->getItemCount());
+            WsmWriter::appendEndTag(
+                headers,
+                WsmNamespaces::WS_MAN,
+                STRLIT("TotalItemsCountEstimate"));
+        }
+        else
+        {
+            // The total is not known until the providers have delivered
+            // all the items, so no estimate is given.
+            CString nilAttrName = (String(WsmNamespaces::supportedNamespaces[
+                WsmNamespaces::XML_SCHEMA_INSTANCE].localName) +
+                ":nil").getCString();
+            WsmWriter::appendStartTag(
+                headers,
+                WsmNamespaces::WS_MAN,
+                STRLIT("TotalItemsCountEstimate"),
+                nilAttrName,
+                "true");
+            WsmWriter::appendEndTag(
+                headers,
+                WsmNamespaces::WS_MAN,
+                STRLIT("TotalItemsCountEstimate"));
+        }
     }
 
     if (!_encodeEnumerationData(
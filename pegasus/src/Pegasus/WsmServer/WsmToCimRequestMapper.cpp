@@ -39,6 +39,7 @@
 #include <Pegasus/Common/XmlWriter.h>
 #include <Pegasus/Common/HostLocator.h>
 #include <Pegasus/Common/CIMNameCast.h>
+#include <Pegasus/Config/ConfigManager.h>
 #include <Pegasus/WsmServer/WsmConstants.h>
 #include <Pegasus/WsmServer/WsmFault.h>
 #include "WsmToCimRequestMapper.h"
@@ -122,13 +123,13 @@ CIMOperationRequestMessage* WsmToCimRequestMapper::mapToCimRequest(
                     ((WsenEnumerateRequest*) request)->enumerationMode ==
                     WSEN_EM_OBJECT_AND_EPR)
                 {
-                    cimRequest.reset(mapToCimEnumerateInstancesRequest(
+                    cimRequest.reset(mapToCimOpenEnumerateInstancesRequest(
                         (WsenEnumerateRequest*) request));
                 }
                 else if (((WsenEnumerateRequest*) request)->enumerationMode ==
                          WSEN_EM_EPR)
                 {
-                    cimRequest.reset(mapToCimEnumerateInstanceNamesRequest(
+                    cimRequest.reset(mapToCimOpenEnumerateInstancePathsRequest(
                         (WsenEnumerateRequest*) request));
                 }
                 else
@@ -149,13 +150,13 @@ CIMOperationRequestMessage* WsmToCimRequestMapper::mapToCimRequest(
                         ((WsenEnumerateRequest*) request)->enumerationMode ==
                         WSEN_EM_OBJECT_AND_EPR)
                     {
-                        cimRequest.reset(mapToCimAssociatorsRequest(
+                        cimRequest.reset(mapToCimOpenAssociatorInstancesRequest(
                             (WsenEnumerateRequest*) request));
                     }
                     else if (((WsenEnumerateRequest*) request)->
                              enumerationMode == WSEN_EM_EPR)
                     {
-                        cimRequest.reset(mapToCimAssociatorNamesRequest(
+                        cimRequest.reset(mapToCimOpenAssociatorInstancePathsRequest(
                             (WsenEnumerateRequest*) request));
                     }
                     else
@@ -170,13 +171,13 @@ CIMOperationRequestMessage* WsmToCimRequestMapper::mapToCimRequest(
                         ((WsenEnumerateRequest*) request)->enumerationMode ==
                         WSEN_EM_OBJECT_AND_EPR)
                     {
-                        cimRequest.reset(mapToCimReferencesRequest(
+                        cimRequest.reset(mapToCimOpenReferenceInstancesRequest(
                             (WsenEnumerateRequest*) request));
                     }
                     else if (((WsenEnumerateRequest*) request)->
                              enumerationMode == WSEN_EM_EPR)
                     {
-                        cimRequest.reset(mapToCimReferenceNamesRequest(
+                        cimRequest.reset(mapToCimOpenReferenceInstancePathsRequest(
                             (WsenEnumerateRequest*) request));
                     }
                     else
@@ -206,21 +207,28 @@ CIMOperationRequestMessage* WsmToCimRequestMapper::mapToCimRequest(
 
     if (cimRequest.get())
     {
-        cimRequest->operationContext.insert(
-            IdentityContainer(request->userName));
-        cimRequest->operationContext.set(
-            AcceptLanguageListContainer(request->acceptLanguages));
-        cimRequest->operationContext.set(
-            ContentLanguageListContainer(request->contentLanguages));
-        cimRequest->setHttpMethod(request->httpMethod);
-        cimRequest->setCloseConnect(request->httpCloseConnect);
-        cimRequest->binaryRequest = true;
-        cimRequest->binaryResponse = true;
+        _setCimRequestProperties(request, cimRequest.get());
     }
     PEG_METHOD_EXIT();
     return cimRequest.release();
 }
 
+void WsmToCimRequestMapper::_setCimRequestProperties(
+    WsmRequest* request,
+    CIMOperationRequestMessage* cimRequest)
+{
+    cimRequest->operationContext.insert(
+        IdentityContainer(request->userName));
+    cimRequest->operationContext.set(
+        AcceptLanguageListContainer(request->acceptLanguages));
+    cimRequest->operationContext.set(
+        ContentLanguageListContainer(request->contentLanguages));
+    cimRequest->setHttpMethod(request->httpMethod);
+    cimRequest->setCloseConnect(request->httpCloseConnect);
+    cimRequest->binaryRequest = true;
+    cimRequest->binaryResponse = true;
+}
+
 CIMGetInstanceRequestMessage*
     WsmToCimRequestMapper::mapToCimGetInstanceRequest(
     WxfGetRequest* request)
@@ -383,25 +391,53 @@ CIMDeleteInstanceRequestMessage*
     return cimRequest;
 }
 
-CIMEnumerateInstancesRequestMessage*
-    WsmToCimRequestMapper::mapToCimEnumerateInstancesRequest(
+Uint32 WsmToCimRequestMapper::_getOperationMaxObjectCount(Uint32 maxElements)
+{
+    Uint32 systemMaxObjectCount = ConfigManager::parseUint32Value(
+        ConfigManager::getInstance()->getCurrentValue(
+            "pullOperationsMaxObjectCount"));
+
+    if (maxElements >= systemMaxObjectCount)
+    {
+        return systemMaxObjectCount;
+    }
+
+    return maxElements + 1;
+}
+
+Uint32Arg WsmToCimRequestMapper::_getOperationTimeout()
+{
+    return Uint32Arg(ConfigManager::parseUint32Value(
+        ConfigManager::getInstance()->getCurrentValue(
+            "pullOperationsMaxTimeout")));
+}
+
+CIMOpenEnumerateInstancesRequestMessage*
+    WsmToCimRequestMapper::mapToCimOpenEnumerateInstancesRequest(
         WsenEnumerateRequest* request)
 {
     PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "WsmToCimRequestMapper::mapToCimEnumerateInstancesRequest");
+        "WsmToCimRequestMapper::mapToCimOpenEnumerateInstancesRequest");
 
     CIMObjectPath objPath;
     convertEPRToObjectPath(request->epr, objPath);
 
-    CIMEnumerateInstancesRequestMessage* cimRequest =
-        new CIMEnumerateInstancesRequestMessage(
+    CIMOpenEnumerateInstancesRequestMessage* cimRequest =
+        new CIMOpenEnumerateInstancesRequestMessage(
             XmlWriter::getNextMessageId(),
             objPath.getNameSpace(),
             objPath.getClassName(),
             request->polymorphismMode == WSMB_PM_INCLUDE_SUBCLASS_PROPERTIES,
-            false, // includeQualifiers
             false, // includeClassOrigin
             CIMPropertyList(),
+            String::EMPTY, // filterQueryLanguage
+            String::EMPTY, // filterQuery
+            _getOperationTimeout(),
+            false, // continueOnError
+            // Only an optimized enumeration returns items with the
+            // Enumerate response.
+            _getOperationMaxObjectCount(
+                request->optimized ? request->maxElements : 0),
             QueueIdStack(request->queueId),
             request->authType,
             request->userName);
@@ -410,20 +446,28 @@ CIMEnumerateInstancesRequestMessage*
     return cimRequest;
 }
 
-CIMEnumerateInstanceNamesRequestMessage*
-    WsmToCimRequestMapper::mapToCimEnumerateInstanceNamesRequest(
+CIMOpenEnumerateInstancePathsRequestMessage*
+    WsmToCimRequestMapper::mapToCimOpenEnumerateInstancePathsRequest(
         WsenEnumerateRequest* request)
 {
     PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "WsmToCimRequestMapper::mapToCimEnumerateInstanceNamesRequest");
+        "WsmToCimRequestMapper::mapToCimOpenEnumerateInstancePathsRequest");
     CIMObjectPath objPath;
     convertEPRToObjectPath(request->epr, objPath);
 
-    CIMEnumerateInstanceNamesRequestMessage* cimRequest =
-        new CIMEnumerateInstanceNamesRequestMessage(
+    CIMOpenEnumerateInstancePathsRequestMessage* cimRequest =
+        new CIMOpenEnumerateInstancePathsRequestMessage(
             XmlWriter::getNextMessageId(),
             objPath.getNameSpace(),
             objPath.getClassName(),
+            String::EMPTY, // filterQueryLanguage
+            String::EMPTY, // filterQuery
+            _getOperationTimeout(),
+            false, // continueOnError
+            // Only an optimized enumeration returns items with the
+            // Enumerate response.
+            _getOperationMaxObjectCount(
+                request->optimized ? request->maxElements : 0),
             QueueIdStack(request->queueId),
             request->authType,
             request->userName);
@@ -432,12 +476,12 @@ CIMEnumerateInstanceNamesRequestMessage*
     return cimRequest;
 }
 
-CIMReferencesRequestMessage*
-    WsmToCimRequestMapper::mapToCimReferencesRequest(
+CIMOpenReferenceInstancesRequestMessage*
+    WsmToCimRequestMapper::mapToCimOpenReferenceInstancesRequest(
         WsenEnumerateRequest* request)
 {
     PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "WsmToCimRequestMapper::mapToCimReferencesRequest");
+        "WsmToCimRequestMapper::mapToCimOpenReferenceInstancesRequest");
 
     _disallowAllClassesResourceUri(
         request->wsmFilter.AssocFilter.object.resourceUri);
@@ -454,7 +498,7 @@ CIMReferencesRequestMessage*
     // in the maptoWsm return just in case?
 
     PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-               "References Request "
+               "OpenReferenceInstances Request "
                "Namespace=%s "
                "instanceName=%s "
                "resultClassName=%s "
@@ -466,18 +510,24 @@ CIMReferencesRequestMessage*
                (const char*)request->
                wsmFilter.AssocFilter.role.getCString()));
 
-    CIMReferencesRequestMessage* cimRequest =
-        new CIMReferencesRequestMessage(
+    CIMOpenReferenceInstancesRequestMessage* cimRequest =
+        new CIMOpenReferenceInstancesRequestMessage(
             XmlWriter::getNextMessageId(),
             ns,
             instanceName,
             request->wsmFilter.AssocFilter.resultClassName,
             request->wsmFilter.AssocFilter.role,
-            false, // includeQualifiers
             false, // includeClassOrigin
             CIMPropertyList(),
+            String::EMPTY, // filterQueryLanguage
+            String::EMPTY, // filterQuery
+            _getOperationTimeout(),
+            false, // continueOnError
+            // Only an optimized enumeration returns items with the
+            // Enumerate response.
+            _getOperationMaxObjectCount(
+                request->optimized ? request->maxElements : 0),
             QueueIdStack(request->queueId),
-            false,                        // WSMAN does not do class request
             request->authType,
             request->userName);
     cimRequest->ipAddress = request->ipAddress;
@@ -485,12 +535,12 @@ CIMReferencesRequestMessage*
     return cimRequest;
 }
 
-CIMReferenceNamesRequestMessage*
-    WsmToCimRequestMapper::mapToCimReferenceNamesRequest(
+CIMOpenReferenceInstancePathsRequestMessage*
+    WsmToCimRequestMapper::mapToCimOpenReferenceInstancePathsRequest(
         WsenEnumerateRequest* request)
 {
     PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "WsmToCimRequestMapper::mapToCimReferenceNamesRequest");
+        "WsmToCimRequestMapper::mapToCimOpenReferenceInstancePathsRequest");
 
     _disallowAllClassesResourceUri(
         request->wsmFilter.AssocFilter.object.resourceUri);
@@ -503,7 +553,7 @@ CIMReferenceNamesRequestMessage*
     instanceName.setHost(String::EMPTY);
 
     PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-               "ReferenceNames Request "
+               "OpenReferenceInstancePaths Request "
                "Namespace=%s "
                "instanceName=%s "
                "resultClassName=%s "
@@ -515,15 +565,22 @@ CIMReferenceNamesRequestMessage*
                (const char*)request->
                wsmFilter.AssocFilter.role.getCString()));
 
-    CIMReferenceNamesRequestMessage* cimRequest =
-        new CIMReferenceNamesRequestMessage(
+    CIMOpenReferenceInstancePathsRequestMessage* cimRequest =
+        new CIMOpenReferenceInstancePathsRequestMessage(
             XmlWriter::getNextMessageId(),
             ns,
             instanceName,
             request->wsmFilter.AssocFilter.resultClassName,
             request->wsmFilter.AssocFilter.role,
+            String::EMPTY, // filterQueryLanguage
+            String::EMPTY, // filterQuery
+            _getOperationTimeout(),
+            false, // continueOnError
+            // Only an optimized enumeration returns items with the
+            // Enumerate response.
+            _getOperationMaxObjectCount(
+                request->optimized ? request->maxElements : 0),
             QueueIdStack(request->queueId),
-            false,            // WSMAN does not do class request
             request->authType,
             request->userName);
     cimRequest->ipAddress = request->ipAddress;
@@ -531,12 +588,12 @@ CIMReferenceNamesRequestMessage*
     return cimRequest;
 }
 
-CIMAssociatorsRequestMessage*
-    WsmToCimRequestMapper::mapToCimAssociatorsRequest(
+CIMOpenAssociatorInstancesRequestMessage*
+    WsmToCimRequestMapper::mapToCimOpenAssociatorInstancesRequest(
         WsenEnumerateRequest* request)
 {
     PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "WsmToCimRequestMapper::mapToCimAssociatorsRequest");
+        "WsmToCimRequestMapper::mapToCimOpenAssociatorInstancesRequest");
 
     _disallowAllClassesResourceUri(
         request->wsmFilter.AssocFilter.object.resourceUri);
@@ -549,7 +606,7 @@ CIMAssociatorsRequestMessage*
     instanceName.setHost(String::EMPTY);
 
     PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-               "Associators Request "
+               "OpenAssociatorInstances Request "
                "Namespace=%s "
                "instanceName=%s "
                "assocClasName=%s "
@@ -567,8 +624,8 @@ CIMAssociatorsRequestMessage*
                (const char*)request->
                wsmFilter.AssocFilter.resultRole.getCString()));
 
-    CIMAssociatorsRequestMessage* cimRequest =
-        new CIMAssociatorsRequestMessage(
+    CIMOpenAssociatorInstancesRequestMessage* cimRequest =
+        new CIMOpenAssociatorInstancesRequestMessage(
             XmlWriter::getNextMessageId(),
             ns,
             instanceName,
@@ -576,11 +633,17 @@ CIMAssociatorsRequestMessage*
             request->wsmFilter.AssocFilter.resultClassName,
             request->wsmFilter.AssocFilter.role,
             request->wsmFilter.AssocFilter.resultRole,
-            false, // includeQualifiers
             false, // includeClassOrigin
             CIMPropertyList(),
+            String::EMPTY, // filterQueryLanguage
+            String::EMPTY, // filterQuery
+            _getOperationTimeout(),
+            false, // continueOnError
+            // Only an optimized enumeration returns items with the
+            // Enumerate response.
+            _getOperationMaxObjectCount(
+                request->optimized ? request->maxElements : 0),
             QueueIdStack(request->queueId),
-            false,          // WSMAN does not do class request
             request->authType,
             request->userName);
     cimRequest->ipAddress = request->ipAddress;
@@ -588,12 +651,12 @@ CIMAssociatorsRequestMessage*
     return cimRequest;
 }
 
-CIMAssociatorNamesRequestMessage*
-    WsmToCimRequestMapper::mapToCimAssociatorNamesRequest(
+CIMOpenAssociatorInstancePathsRequestMessage*
+    WsmToCimRequestMapper::mapToCimOpenAssociatorInstancePathsRequest(
         WsenEnumerateRequest* request)
 {
     PEG_METHOD_ENTER(TRC_WSMSERVER,
-        "WsmToCimRequestMapper::mapToCimAssociatorNamesRequest");
+        "WsmToCimRequestMapper::mapToCimOpenAssociatorInstancePathsRequest");
 
     _disallowAllClassesResourceUri(
         request->wsmFilter.AssocFilter.object.resourceUri);
@@ -607,7 +670,7 @@ CIMAssociatorNamesRequestMessage*
     instanceName.setHost(String::EMPTY);
 
     PEG_TRACE((TRC_WSMSERVER, Tracer::LEVEL4,
-               "AssociatorNames Request "
+               "OpenAssociatorInstancePaths Request "
                "Namespace=%s "
                "instanceName=%s "
                "assocClasName=%s "
@@ -625,8 +688,8 @@ CIMAssociatorNamesRequestMessage*
                (const char*)request->
                wsmFilter.AssocFilter.resultRole.getCString()));
 
-    CIMAssociatorNamesRequestMessage* cimRequest =
-        new CIMAssociatorNamesRequestMessage(
+    CIMOpenAssociatorInstancePathsRequestMessage* cimRequest =
+        new CIMOpenAssociatorInstancePathsRequestMessage(
             XmlWriter::getNextMessageId(),
             ns,
             instanceName,
@@ -634,8 +697,15 @@ CIMAssociatorNamesRequestMessage*
             request->wsmFilter.AssocFilter.resultClassName,
             request->wsmFilter.AssocFilter.role,
             request->wsmFilter.AssocFilter.resultRole,
+            String::EMPTY, // filterQueryLanguage
+            String::EMPTY, // filterQuery
+            _getOperationTimeout(),
+            false, // continueOnError
+            // Only an optimized enumeration returns items with the
+            // Enumerate response.
+            _getOperationMaxObjectCount(
+                request->optimized ? request->maxElements : 0),
             QueueIdStack(request->queueId),
-            false,            // WSMAN does not do class request
             request->authType,
             request->userName);
     cimRequest->ipAddress = request->ipAddress;
@@ -643,6 +713,80 @@ CIMAssociatorNamesRequestMessage*
     return cimRequest;
 }
 
+CIMPullOperationRequestMessage* WsmToCimRequestMapper::mapToCimPullRequest(
+    WsmRequest* request,
+    const CIMNamespaceName& nameSpace,
+    const String& enumerationContext,
+    WsenEnumerationMode enumerationMode,
+    Uint32 maxElements)
+{
+    PEG_METHOD_ENTER(TRC_WSMSERVER,
+        "WsmToCimRequestMapper::mapToCimPullRequest");
+
+    AutoPtr<CIMPullOperationRequestMessage> cimRequest;
+
+    if (enumerationMode == WSEN_EM_EPR)
+    {
+        cimRequest.reset(new CIMPullInstancePathsRequestMessage(
+            XmlWriter::getNextMessageId(),
+            nameSpace,
+            enumerationContext,
+            _getOperationMaxObjectCount(maxElements),
+            QueueIdStack(request->queueId),
+            request->authType,
+            request->userName));
+    }
+    else
+    {
+        cimRequest.reset(new CIMPullInstancesWithPathRequestMessage(
+            XmlWriter::getNextMessageId(),
+            nameSpace,
+            enumerationContext,
+            _getOperationMaxObjectCount(maxElements),
+            QueueIdStack(request->queueId),
+            request->authType,
+            request->userName));
+    }
+
+    cimRequest->ipAddress = request->ipAddress;
+    _setCimRequestProperties(request, cimRequest.get());
+
+    PEG_METHOD_EXIT();
+    return cimRequest.release();
+}
+
+CIMCloseEnumerationRequestMessage*
+    WsmToCimRequestMapper::mapToCimCloseEnumerationRequest(
+        WsenEnumerateRequest* request,
+        const CIMNamespaceName& nameSpace,
+        const String& enumerationContext)
+{
+    CIMCloseEnumerationRequestMessage* cimRequest =
+        new CIMCloseEnumerationRequestMessage(
+            XmlWriter::getNextMessageId(),
+            nameSpace,
+            enumerationContext,
+            QueueIdStack(request->queueId),
+            request->authType,
+            request->userName);
+    cimRequest->ipAddress = request->ipAddress;
+    _setCimRequestProperties(request, cimRequest);
+
+    return cimRequest;
+}
+
+CIMNamespaceName WsmToCimRequestMapper::getEnumerationNameSpace(
+    const WsenEnumerateRequest* request)
+{
+    if (request->wsmFilter.filterDialect == WsmFilter::ASSOCIATION)
+    {
+        return CIMNamespaceName(
+            request->wsmFilter.AssocFilter.object.getNamespace());
+    }
+
+    return _convertEPRToNameSpace(request->epr);
+}
+
 CIMInvokeMethodRequestMessage*
 WsmToCimRequestMapper::mapToCimInvokeMethodRequest(
     WsInvokeRequest* request)
@@ -781,16 +925,11 @@ String WsmToCimRequestMapper::convertEPRAddressToHostname(const String& addr)
     return hostName;
 }
 
-void WsmToCimRequestMapper::convertEPRToObjectPath(
-    const WsmEndpointReference& epr,
-    CIMObjectPath& objectPath)
+CIMNamespaceName WsmToCimRequestMapper::_convertEPRToNameSpace(
+    const WsmEndpointReference& epr)
 {
-    Array<CIMKeyBinding> keyBindings;
     CIMNamespaceName namespaceName;
 
-    // Convert the ResourceURI to a CIM class name
-    CIMName className = convertResourceUriToClassName(epr.resourceUri);
-
     PEGASUS_ASSERT(epr.selectorSet);
 
     // Determine the namespace from the selector set
@@ -834,6 +973,23 @@ void WsmToCimRequestMapper::convertEPRToObjectPath(
         namespaceName = PEGASUS_DEFAULT_WSM_NAMESPACE;
     }
 
+    return namespaceName;
+}
+
+void WsmToCimRequestMapper::convertEPRToObjectPath(
+    const WsmEndpointReference& epr,
+    CIMObjectPath& objectPath)
+{
+    Array<CIMKeyBinding> keyBindings;
+
+    // Convert the ResourceURI to a CIM class name
+    CIMName className = convertResourceUriToClassName(epr.resourceUri);
+
+    PEGASUS_ASSERT(epr.selectorSet);
+
+    // Determine the namespace from the selector set
+    CIMNamespaceName namespaceName = _convertEPRToNameSpace(epr);
+
     CIMClass cimClass = _repository->getClass(
         namespaceName,
         className,
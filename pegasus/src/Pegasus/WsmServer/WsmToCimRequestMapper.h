@@ -59,20 +59,59 @@ public:
         WsmRequest * request,Boolean isSubCreate=false);
     CIMDeleteInstanceRequestMessage* mapToCimDeleteInstanceRequest(
         WsmRequest* request,Boolean isSubDeleteReq=false);
-    CIMEnumerateInstancesRequestMessage* mapToCimEnumerateInstancesRequest(
-        WsenEnumerateRequest* request);
-    CIMEnumerateInstanceNamesRequestMessage*
-        mapToCimEnumerateInstanceNamesRequest(WsenEnumerateRequest* request);
+    // WS-Management enumerations are mapped to the CIM pull operations so
+    // the results are retrieved from the providers as the client pulls them.
+    CIMOpenEnumerateInstancesRequestMessage*
+        mapToCimOpenEnumerateInstancesRequest(WsenEnumerateRequest* request);
+    CIMOpenEnumerateInstancePathsRequestMessage*
+        mapToCimOpenEnumerateInstancePathsRequest(
+            WsenEnumerateRequest* request);
 
     // Support Associated filter
-    CIMReferencesRequestMessage* mapToCimReferencesRequest(
-        WsenEnumerateRequest* request);
-    CIMReferenceNamesRequestMessage* mapToCimReferenceNamesRequest(
-        WsenEnumerateRequest* request);
-    CIMAssociatorsRequestMessage* mapToCimAssociatorsRequest(
-        WsenEnumerateRequest* request);
-    CIMAssociatorNamesRequestMessage* mapToCimAssociatorNamesRequest(
-        WsenEnumerateRequest* request);
+    CIMOpenReferenceInstancesRequestMessage*
+        mapToCimOpenReferenceInstancesRequest(WsenEnumerateRequest* request);
+    CIMOpenReferenceInstancePathsRequestMessage*
+        mapToCimOpenReferenceInstancePathsRequest(
+            WsenEnumerateRequest* request);
+    CIMOpenAssociatorInstancesRequestMessage*
+        mapToCimOpenAssociatorInstancesRequest(WsenEnumerateRequest* request);
+    CIMOpenAssociatorInstancePathsRequestMessage*
+        mapToCimOpenAssociatorInstancePathsRequest(
+            WsenEnumerateRequest* request);
+
+    /**
+        Maps a request for more items of an enumeration to a CIM pull
+        operation on the CIM enumeration context.  The request is either
+        the Enumerate request or a Pull request that the items are for.
+        Such requests have no CIM representation of their own, so
+        mapToCimRequest() does not map them.
+        @param request The WS-Management request.
+        @param nameSpace The namespace of the CIM enumeration.
+        @param enumerationContext The CIM enumeration context.
+        @param enumerationMode The enumeration mode of the Enumerate request.
+        @param maxElements The number of items the response needs.
+    */
+    CIMPullOperationRequestMessage* mapToCimPullRequest(
+        WsmRequest* request,
+        const CIMNamespaceName& nameSpace,
+        const String& enumerationContext,
+        WsenEnumerationMode enumerationMode,
+        Uint32 maxElements);
+
+    /**
+        Maps the closing of a CIM enumeration that is no longer needed on
+        behalf of the Enumerate request that opened it.
+    */
+    CIMCloseEnumerationRequestMessage* mapToCimCloseEnumerationRequest(
+        WsenEnumerateRequest* request,
+        const CIMNamespaceName& nameSpace,
+        const String& enumerationContext);
+
+    /**
+        Returns the CIM namespace that is the target of an Enumerate request.
+    */
+    static CIMNamespaceName getEnumerationNameSpace(
+        const WsenEnumerateRequest* request);
 
     CIMInvokeMethodRequestMessage* mapToCimInvokeMethodRequest(
         WsInvokeRequest* request);
@@ -121,6 +160,35 @@ private:
     CIMRepository* _repository;
 
     void _disallowAllClassesResourceUri(const String& resourceUri);
+
+    static CIMNamespaceName _convertEPRToNameSpace(
+        const WsmEndpointReference& epr);
+
+    /**
+        Applies the operation context, HTTP and encoding properties of a
+        WS-Management request to the CIM request it was mapped to.
+    */
+    static void _setCimRequestProperties(
+        WsmRequest* request,
+        CIMOperationRequestMessage* cimRequest);
+
+    /**
+        Returns the maximum number of objects to request from a CIM open or
+        pull operation on behalf of a response of maxElements items.  One
+        object more is requested, so the response that completes the
+        enumeration can be recognized.  The value is limited by the
+        pullOperationsMaxObjectCount configuration property.
+    */
+    static Uint32 _getOperationMaxObjectCount(Uint32 maxElements);
+
+    /**
+        Returns the operation timeout of the CIM enumerations opened on
+        behalf of WS-Management enumerations.  This is the longest
+        interoperation timeout allowed by the pullOperationsMaxTimeout
+        configuration property; the WS-Management enumeration expiration
+        still bounds the life of the enumeration.
+    */
+    static Uint32Arg _getOperationTimeout();
 };
 
 PEGASUS_NAMESPACE_END
@@ -42,6 +42,7 @@
 #include "WsmUtils.h"
 #include "WsmWriter.h"
 #include "WsmSelectorSet.h"
+#include "SCMOWsmWriter.h"
 #include <Pegasus/Common/StrLit.h>
 #include <Clients/wbemexec/HttpConstants.h>
 
@@ -196,6 +197,20 @@ void WsmWriter::appendInstanceElement(
     const char* ns,
     Boolean isEmbedded)
 {
+    if (instance.isSCMOInstance())
+    {
+        SCMOWsmWriter::appendInstanceElement(
+            out,
+            resourceUri,
+            instance.getSCMOInstance(),
+            instance.getClassName(),
+            instance.getResourceUri(),
+            instance.getNameSpace(),
+            ns,
+            isEmbedded);
+        return;
+    }
+
     size_t nsLength = strlen(ns);
 
     // Class opening element:
@@ -0,0 +1,358 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include <Pegasus/Common/PegasusAssert.h>
+#include <Pegasus/Common/FileSystem.h>
+#include <Pegasus/Common/HTTPConnection.h>
+#include <Pegasus/Common/HTTPMessage.h>
+#include <Pegasus/Common/CIMMessage.h>
+#include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/Threads.h>
+#include <Pegasus/Repository/CIMRepository.h>
+#include <Pegasus/WsmServer/WsmConstants.h>
+#include <Pegasus/WsmServer/WsmRequest.h>
+#include <Pegasus/WsmServer/WsmProcessor.h>
+
+PEGASUS_USING_PEGASUS;
+PEGASUS_USING_STD;
+
+static Boolean verbose;
+static String repositoryRoot;
+
+static const String NAMESPACE = "aa/bb";
+static const String CLASSNAME = "MyClass";
+
+/* Stands in for the CIM operation processor and keeps the CIM requests
+   the WsmProcessor forwards to it.  Pull requests may be forwarded on
+   another thread. */
+class TestCimQueue : public MessageQueue
+{
+public:
+    TestCimQueue() : MessageQueue("TestCimQueue") {}
+
+    virtual void enqueue(Message* message)
+    {
+        AutoMutex lock(_mutex);
+        _requests.append((CIMRequestMessage*) message);
+    }
+
+    CIMRequestMessage* waitForRequest()
+    {
+        for (Uint32 i = 0; i < 1000; i++)
+        {
+            {
+                AutoMutex lock(_mutex);
+                if (_requests.size())
+                {
+                    CIMRequestMessage* request = _requests[0];
+                    _requests.remove(0);
+                    return request;
+                }
+            }
+            Threads::sleep(10);
+        }
+        return 0;
+    }
+
+    Uint32 getRequestCount()
+    {
+        AutoMutex lock(_mutex);
+        return _requests.size();
+    }
+
+private:
+    Mutex _mutex;
+    Array<CIMRequestMessage*> _requests;
+};
+
+/* Stands in for the HTTP connection a WS-Man request arrived on and keeps
+   the responses sent on it.  It has no socket. */
+class TestConnection : public HTTPConnection
+{
+public:
+    TestConnection(SharedPtr<MP_Socket>& socket)
+        : HTTPConnection(0, socket, "127.0.0.1", 0, 0)
+    {
+    }
+
+    virtual void enqueue(Message* message)
+    {
+        AutoPtr<HTTPMessage> httpMessage((HTTPMessage*) message);
+        AutoMutex lock(_mutex);
+        _responses.append(String(
+            httpMessage->message.getData(), httpMessage->message.size()));
+    }
+
+    String getResponse()
+    {
+        AutoMutex lock(_mutex);
+        PEGASUS_TEST_ASSERT(_responses.size() == 1);
+        String response = _responses[0];
+        _responses.clear();
+        return response;
+    }
+
+private:
+    Mutex _mutex;
+    Array<String> _responses;
+};
+
+static WsmEndpointReference _makeEPR()
+{
+    WsmEndpointReference epr;
+    epr.address = "http://localhost:5988/wsman";
+    epr.resourceUri = String(WSM_RESOURCEURI_CIMSCHEMAV2) + "/" + CLASSNAME;
+    epr.selectorSet->selectors.append(
+        WsmSelector("__cimnamespace", NAMESPACE));
+    return epr;
+}
+
+static Array<CIMInstance> _makeInstances(Uint32 first, Uint32 count)
+{
+    Array<CIMInstance> instances;
+    for (Uint32 i = first; i < first + count; i++)
+    {
+        CIMInstance instance(CLASSNAME);
+        char value[32];
+        sprintf(value, "item%u", i);
+        instance.addProperty(CIMProperty(CIMName("prop1"), String(value)));
+        instances.append(instance);
+    }
+    return instances;
+}
+
+/* Answers an open or pull request with the given instances. */
+static void _respond(
+    WsmProcessor& processor,
+    CIMRequestMessage* request,
+    const Array<CIMInstance>& instances,
+    Boolean endOfSequence)
+{
+    PEGASUS_TEST_ASSERT(request != 0);
+    AutoPtr<CIMRequestMessage> requestDestroyer(request);
+    AutoPtr<CIMOpenOrPullResponseDataMessage> response(
+        (CIMOpenOrPullResponseDataMessage*) request->buildResponse());
+    response->getResponseData().setInstances(instances);
+    response->endOfSequence = endOfSequence;
+    response->enumerationContext = endOfSequence ? "" : "cimcontext";
+    processor.handleEnqueue(response.release());
+}
+
+static Uint32 _countItems(const String& response)
+{
+    CString text = response.getCString();
+    Uint32 count = 0;
+    for (const char* p = strstr(text, "item"); p; p = strstr(p + 1, "item"))
+    {
+        count++;
+    }
+    return count;
+}
+
+static Boolean _contains(const String& response, const char* text)
+{
+    return response.find(text) != PEG_NOT_FOUND;
+}
+
+static Uint64 _getEnumerationContext(const String& response)
+{
+    Uint32 pos = response.find("EnumerationContext>");
+    PEGASUS_TEST_ASSERT(pos != PEG_NOT_FOUND);
+    CString digits = response.subString(pos + 19).getCString();
+    return strtoul((const char*) digits, 0, 10);
+}
+
+static WsenEnumerateRequest* _makeEnumerateRequest(
+    TestConnection& connection,
+    Uint32 maxElements)
+{
+    WsenEnumerateRequest* request = new WsenEnumerateRequest(
+        "enumerate",
+        _makeEPR(),
+        String::EMPTY,
+        true,                   // requestItemCount
+        true,                   // optimized
+        maxElements,
+        WSEN_EM_OBJECT,
+        WSMB_PM_INCLUDE_SUBCLASS_PROPERTIES,
+        WsmFilter());
+    request->queueId = connection.getQueueId();
+    return request;
+}
+
+static WsenPullRequest* _makePullRequest(
+    TestConnection& connection,
+    Uint64 contextId,
+    Uint32 maxElements)
+{
+    WsenPullRequest* request = new WsenPullRequest(
+        "pull",
+        _makeEPR(),
+        contextId,
+        String::EMPTY,
+        false,                  // requestItemCount
+        maxElements,
+        0);                     // maxCharacters
+    request->queueId = connection.getQueueId();
+    return request;
+}
+
+/* The Enumerate response holds MaxElements items and carries a nil item
+   count estimate while the CIM enumeration is open.  A Pull that needs
+   more items waits for CIM pulls, and a second Pull on the same context
+   is rejected meanwhile. */
+static void _testSplitEnumeration(
+    WsmProcessor& processor,
+    TestCimQueue& cimQueue,
+    TestConnection& connection)
+{
+    processor.handleRequest(_makeEnumerateRequest(connection, 2));
+    _respond(processor, cimQueue.waitForRequest(), _makeInstances(0, 3), false);
+
+    String response = connection.getResponse();
+    PEGASUS_TEST_ASSERT(_countItems(response) == 2);
+    PEGASUS_TEST_ASSERT(_contains(response, "TotalItemsCountEstimate"));
+    PEGASUS_TEST_ASSERT(_contains(response, ":nil=\"true\""));
+    PEGASUS_TEST_ASSERT(!_contains(response, "EndOfSequence"));
+    Uint64 contextId = _getEnumerationContext(response);
+
+    // The context holds one item, so the Pull needs a CIM pull.
+    processor.handleRequest(_makePullRequest(connection, contextId, 5));
+    CIMRequestMessage* pullRequest = cimQueue.waitForRequest();
+    PEGASUS_TEST_ASSERT(pullRequest != 0);
+    PEGASUS_TEST_ASSERT(
+        pullRequest->getType() == CIM_PULL_INSTANCES_WITH_PATH_REQUEST_MESSAGE);
+
+    processor.handleRequest(_makePullRequest(connection, contextId, 5));
+    response = connection.getResponse();
+    PEGASUS_TEST_ASSERT(_contains(response, "Concurrency"));
+    PEGASUS_TEST_ASSERT(_contains(response, "is in use by another request"));
+    PEGASUS_TEST_ASSERT(cimQueue.getRequestCount() == 0);
+
+    // The Pull response is still not full, so another CIM pull is issued
+    // on behalf of the Pull request.
+    _respond(processor, pullRequest, _makeInstances(3, 2), false);
+    pullRequest = cimQueue.waitForRequest();
+    PEGASUS_TEST_ASSERT(pullRequest != 0);
+    _respond(processor, pullRequest, _makeInstances(5, 1), true);
+
+    response = connection.getResponse();
+    PEGASUS_TEST_ASSERT(_contains(response, "PullResponse"));
+    PEGASUS_TEST_ASSERT(_countItems(response) == 4);
+    PEGASUS_TEST_ASSERT(_contains(response, "item2"));
+    PEGASUS_TEST_ASSERT(_contains(response, "item5"));
+    PEGASUS_TEST_ASSERT(_contains(response, "EndOfSequence"));
+
+    // The enumeration is complete, so its context is gone.
+    processor.handleRequest(_makePullRequest(connection, contextId, 5));
+    response = connection.getResponse();
+    PEGASUS_TEST_ASSERT(_contains(response, "InvalidEnumerationContext"));
+}
+
+/* The open response holds too few items for the Enumerate response, so a
+   CIM pull is issued before it is sent.  The response then completes the
+   enumeration and carries the item count. */
+static void _testPulledEnumeration(
+    WsmProcessor& processor,
+    TestCimQueue& cimQueue,
+    TestConnection& connection)
+{
+    processor.handleRequest(_makeEnumerateRequest(connection, 5));
+    _respond(processor, cimQueue.waitForRequest(), _makeInstances(0, 2), false);
+
+    // The CIM pull is forwarded on another thread.
+    CIMRequestMessage* pullRequest = cimQueue.waitForRequest();
+    PEGASUS_TEST_ASSERT(pullRequest != 0);
+    PEGASUS_TEST_ASSERT(
+        pullRequest->getType() == CIM_PULL_INSTANCES_WITH_PATH_REQUEST_MESSAGE);
+    _respond(processor, pullRequest, _makeInstances(2, 1), true);
+
+    String response = connection.getResponse();
+    PEGASUS_TEST_ASSERT(_contains(response, "EnumerateResponse"));
+    PEGASUS_TEST_ASSERT(_countItems(response) == 3);
+    PEGASUS_TEST_ASSERT(_contains(response, "TotalItemsCountEstimate>3<"));
+    PEGASUS_TEST_ASSERT(!_contains(response, ":nil=\"true\""));
+    PEGASUS_TEST_ASSERT(_contains(response, "EndOfSequence"));
+}
+
+int main(int argc, char** argv)
+{
+    verbose = getenv("PEGASUS_TEST_VERBOSE") ? true : false;
+
+    const char* tmpDir = getenv ("PEGASUS_TMP");
+    if (tmpDir == NULL)
+    {
+        repositoryRoot = ".";
+    }
+    else
+    {
+        repositoryRoot = tmpDir;
+    }
+    repositoryRoot.append("/repository");
+
+    FileSystem::removeDirectoryHier(repositoryRoot);
+
+    try
+    {
+        CIMRepository repository(repositoryRoot, CIMRepository::MODE_XML);
+        repository.createNameSpace(NAMESPACE);
+        CIMClass cimClass(CLASSNAME);
+        cimClass.addProperty(CIMProperty(CIMName("prop1"), String::EMPTY));
+        repository.createClass(NAMESPACE, cimClass);
+
+        TestCimQueue cimQueue;
+        WsmProcessor processor(&cimQueue, &repository);
+        SharedPtr<MP_Socket> socket(new MP_Socket(PEGASUS_INVALID_SOCKET));
+        TestConnection connection(socket);
+
+        if (verbose)
+        {
+            cout << "Testing an enumeration split by MaxElements." << endl;
+        }
+        _testSplitEnumeration(processor, cimQueue, connection);
+
+        if (verbose)
+        {
+            cout << "Testing an enumeration completed by a CIM pull." << endl;
+        }
+        _testPulledEnumeration(processor, cimQueue, connection);
+    }
+    catch (Exception& e)
+    {
+        cerr << "Error: " << e.getMessage() << endl;
+        exit(1);
+    }
+
+    FileSystem::removeDirectoryHier(repositoryRoot);
+
+    cout << argv[0] << " +++++ passed all tests" << endl;
+
+    return 0;
+}
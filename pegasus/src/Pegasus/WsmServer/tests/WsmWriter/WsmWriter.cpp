@@ -40,6 +40,10 @@
 #include <Pegasus/WsmServer/WsmRequest.h>
 #include <Pegasus/WsmServer/WsmResponse.h>
 #include <Pegasus/WsmServer/SoapResponse.h>
+#include <Pegasus/WsmServer/CimToWsmResponseMapper.h>
+#include <Pegasus/Common/SCMOClass.h>
+#include <Pegasus/Common/SCMOInstance.h>
+#include <Pegasus/Common/SCMOClassCache.h>
 
 PEGASUS_USING_PEGASUS;
 PEGASUS_USING_STD;
@@ -380,6 +384,149 @@ static void _testInstances(void)
     }
 }
 
+// Checks that an instance held in SCMO form is written as the WsmInstance
+// CimToWsmResponseMapper converts the equivalent CIMInstance to.
+static void _checkSCMOInstance(
+    const SCMOInstance& scmoInstance,
+    const CIMInstance& cimInstance,
+    const char* text)
+{
+    const String nameSpace = "test/WsmTest";
+    CimToWsmResponseMapper mapper;
+
+    WsmInstance wsmInstance;
+    mapper.convertCimToWsmInstance(
+        WSM_RESOURCEURI_CIMSCHEMAV2, cimInstance, wsmInstance, nameSpace);
+    Buffer expected;
+    WsmWriter::appendInstanceElement(expected, WSM_RESOURCEURI_CIMSCHEMAV2,
+        wsmInstance, PEGASUS_INSTANCE_NS, false);
+
+    WsmInstance scmoWsmInstance(
+        scmoInstance, WSM_RESOURCEURI_CIMSCHEMAV2, nameSpace);
+    Buffer actual;
+    WsmWriter::appendInstanceElement(actual, WSM_RESOURCEURI_CIMSCHEMAV2,
+        scmoWsmInstance, PEGASUS_INSTANCE_NS, false);
+
+    if (verbose)
+    {
+        cout << expected.getData() << endl;
+        cout << actual.getData() << endl;
+    }
+
+    if (strcmp(expected.getData(), actual.getData()) != 0)
+        throw Exception(text);
+}
+
+static CIMClass _getSCMOTestClass()
+{
+    CIMClass cimClass("WsmTest_SCMO");
+    cimClass.addProperty(CIMProperty("Key", String())
+        .addQualifier(CIMQualifier("Key", true)));
+    cimClass.addProperty(CIMProperty("Zeta", Uint32(0)));
+    cimClass.addProperty(CIMProperty("Alpha", String("default")));
+    cimClass.addProperty(CIMProperty("Flag", Boolean(false)));
+    cimClass.addProperty(CIMProperty("Small", Sint8(0)));
+    cimClass.addProperty(CIMProperty("Big", Uint64(0)));
+    cimClass.addProperty(CIMProperty("Negative", Sint64(0)));
+    cimClass.addProperty(CIMProperty("Ratio", Real32(0)));
+    cimClass.addProperty(CIMProperty("Precise", Real64(0)));
+    cimClass.addProperty(CIMProperty("Letter", Char16('a')));
+    cimClass.addProperty(CIMProperty("When", CIMDateTime()));
+    cimClass.addProperty(CIMProperty("Interval", CIMDateTime()));
+    cimClass.addProperty(CIMProperty("Names", Array<String>()));
+    cimClass.addProperty(CIMProperty("Counts", Array<Uint16>()));
+    cimClass.addProperty(CIMProperty("Flags", Array<Boolean>()));
+    cimClass.addProperty(
+        CIMProperty("Unset", CIMValue(CIMTYPE_STRING, false)));
+    cimClass.addProperty(CIMProperty("Ref", CIMObjectPath(),
+        0, CIMName("WsmTest_SCMO")));
+    cimClass.addProperty(
+        CIMProperty("Inner", CIMValue(CIMTYPE_INSTANCE, false)));
+    return cimClass;
+}
+
+static SCMOClass _scmoClassCache_GetClass(
+    const CIMNamespaceName& nameSpace,
+    const CIMName& className)
+{
+    return SCMOClass(
+        _getSCMOTestClass(),
+        (const char*)nameSpace.getString().getCString());
+}
+
+static void _testSCMOInstances(void)
+{
+    SCMOClassCache::getInstance()->setCallBack(_scmoClassCache_GetClass);
+
+    CIMClass cimClass = _getSCMOTestClass();
+
+    Array<String> names;
+    names.append("first & <second>");
+    names.append("");
+    Array<Uint16> counts;
+    counts.append(1);
+    counts.append(65535);
+    Array<Boolean> flags;
+    flags.append(true);
+    flags.append(false);
+
+    CIMInstance cimInstance("WsmTest_SCMO");
+    cimInstance.addProperty(CIMProperty("Key", String("key\"1\"")));
+    cimInstance.addProperty(CIMProperty("Zeta", Uint32(4294967295U)));
+    cimInstance.addProperty(CIMProperty("Flag", Boolean(true)));
+    cimInstance.addProperty(CIMProperty("Small", Sint8(-128)));
+    cimInstance.addProperty(CIMProperty("Big", Uint64(
+        PEGASUS_UINT64_LITERAL(18446744073709551615))));
+    cimInstance.addProperty(CIMProperty("Negative", Sint64(-42)));
+    cimInstance.addProperty(CIMProperty("Ratio", Real32(1.5)));
+    cimInstance.addProperty(CIMProperty("Precise", Real64(-2.25e100)));
+    cimInstance.addProperty(CIMProperty("Letter", Char16('<')));
+    cimInstance.addProperty(CIMProperty("When",
+        CIMDateTime("20091231235959.123456-300")));
+    cimInstance.addProperty(CIMProperty("Interval",
+        CIMDateTime("00000001020304.000005:000")));
+    cimInstance.addProperty(CIMProperty("Names", names));
+    cimInstance.addProperty(CIMProperty("Counts", counts));
+    cimInstance.addProperty(CIMProperty("Flags", flags));
+    cimInstance.addProperty(CIMProperty("Unset",
+        CIMValue(CIMTYPE_STRING, false)));
+    cimInstance.addProperty(CIMProperty("Ref", CIMObjectPath(
+        "//otherhost/test/WsmTest:WsmTest_SCMO.Key=\"other\""),
+        0, CIMName("WsmTest_SCMO")));
+    CIMInstance innerInstance("WsmTest_SCMO");
+    innerInstance.addProperty(CIMProperty("Key", String("inner")));
+    innerInstance.addProperty(CIMProperty("Zeta", Uint32(3)));
+    cimInstance.addProperty(CIMProperty("Inner", CIMValue(innerInstance)));
+    cimInstance.setPath(CIMObjectPath("WsmTest_SCMO.Key=\"key\""));
+
+    SCMOClass scmoClass(cimClass, "test/WsmTest");
+
+    // An instance converted from a CIMInstance exports only the properties
+    // that are set in the CIMInstance.
+    {
+        SCMOInstance scmoInstance(scmoClass, cimInstance);
+        _checkSCMOInstance(scmoInstance, cimInstance,
+            "SCMO instance converted from a CIMInstance does not compare");
+    }
+
+    // An instance created from the class also exports the default values
+    // of the properties that are not set.
+    {
+        SCMOInstance scmoInstance(scmoClass);
+        SCMBUnion value;
+        value.simple.val.u32 = 7;
+        value.simple.hasValue = true;
+        scmoInstance.setPropertyWithOrigin("Zeta", CIMTYPE_UINT32, &value);
+
+        CIMInstance resolved;
+        scmoInstance.getCIMInstance(resolved);
+        _checkSCMOInstance(scmoInstance, resolved,
+            "SCMO instance with default values does not compare");
+    }
+
+    SCMOClassCache::destroy();
+}
+
 static void  _testResponseFormatting(void)
 {
     ContentLanguageList contentLanguage;
@@ -636,6 +783,10 @@ int main(int argc, char** argv)
             cout << "Testing instances." << endl;
         _testInstances();
 
+        if (verbose)
+            cout << "Testing SCMO instances." << endl;
+        _testSCMOInstances();
+
         if (verbose)
             cout << "Testing response formatting." << endl;
         _testResponseFormatting();
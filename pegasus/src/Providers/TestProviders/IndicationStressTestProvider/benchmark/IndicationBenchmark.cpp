@@ -0,0 +1,688 @@
+//%LICENSE////////////////////////////////////////////////////////////////
+//
+// Licensed to The Open Group (TOG) under one or more contributor license
+// agreements.  Refer to the OpenPegasusNOTICE.txt file distributed with
+// this work for additional information regarding copyright ownership.
+// Each contributor licenses this file to you under the OpenPegasus Open
+// Source License; you may not use this file except in compliance with the
+// License.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+//
+//%/////////////////////////////////////////////////////////////////////////////
+
+/*
+    End-to-end Indication throughput and latency benchmark.
+
+    The benchmark plays the part of a remote CIM Listener.  It starts an
+    embedded CIMListener, creates one filter and <subscriptions> CIM-XML
+    handlers and subscriptions that all point back at that listener, and then
+    drives the IndicationStressTestProvider at the requested rate.
+
+    Each delivered Indication carries the IndicationTime set by the provider
+    when the Indication was generated.  The difference between that time and
+    the time at which the consumer receives the Indication covers the complete
+    server path (provider, IndicationService matching, handler DestinationQueue
+    and CIM-XML export) and is recorded for every delivery.  When all expected
+    deliveries have been received, or no progress is seen for the timeout
+    interval, a report of key=value lines is written to stdout and, if
+    requested, to a file so that results can be compared between builds.
+*/
+
+#include <Pegasus/Common/Config.h>
+#include <Pegasus/Common/Constants.h>
+#include <Pegasus/Common/CIMDateTime.h>
+#include <Pegasus/Common/Array.h>
+#include <Pegasus/Common/AtomicInt.h>
+#include <Pegasus/Common/Mutex.h>
+#include <Pegasus/Common/System.h>
+#include <Pegasus/Common/Threads.h>
+#include <Pegasus/Common/Exception.h>
+#include <Pegasus/Common/PegasusAssert.h>
+
+#include <Pegasus/Client/CIMClient.h>
+#include <Pegasus/Consumer/CIMIndicationConsumer.h>
+#include <Pegasus/Listener/CIMListener.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+PEGASUS_USING_PEGASUS;
+PEGASUS_USING_STD;
+
+static const String FILTER_NAME = String("IBFilter01");
+static const String HANDLER_NAME_PREFIX = String("IBHandler");
+static const String DESTINATION_PATH_PREFIX = String("/IndicationBenchmark/");
+
+static const Uint32 DEFAULT_LISTENER_PORT = 2006;
+static const Uint32 DEFAULT_INDICATION_COUNT = 1000;
+static const Uint32 DEFAULT_SUBSCRIPTION_COUNT = 1;
+static const Uint32 DEFAULT_RATE = 0;
+static const Uint32 DEFAULT_TIMEOUT_SECONDS = 60;
+
+// Indications are generated in batches, one provider method call per batch.
+// With a target rate, one batch is sent per tick; without one, batches are
+// sent back to back.
+static const Uint32 TICK_MILLISECONDS = 100;
+static const Uint32 MAX_BATCH_SIZE = 1000;
+
+struct BenchmarkOptions
+{
+    String className;
+    CIMNamespaceName nameSpace;
+    String queryLanguage;
+    Uint32 indicationCount;
+    Uint32 subscriptionCount;
+    Uint32 rate;
+    Uint32 port;
+    Uint32 timeoutSeconds;
+    String reportFile;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Delivery statistics collected by the consumer
+//
+////////////////////////////////////////////////////////////////////////////////
+
+static Mutex _statsMutex;
+static Array<Uint64> _latencies;
+static Array<Uint32> _receivedPerSubscription;
+static Uint64 _lastReceiveTime = 0;
+static AtomicInt _receivedCount(0);
+static AtomicInt _errorCount(0);
+
+class BenchmarkConsumer : public CIMIndicationConsumer
+{
+public:
+    BenchmarkConsumer() { }
+    ~BenchmarkConsumer() { }
+
+    void consumeIndication(
+        const OperationContext& context,
+        const String& url,
+        const CIMInstance& indicationInstance);
+};
+
+void BenchmarkConsumer::consumeIndication(
+    const OperationContext& context,
+    const String& url,
+    const CIMInstance& indicationInstance)
+{
+    CIMDateTime receiveDateTime = CIMDateTime::getCurrentDateTime();
+    Uint64 receiveTime = System::getCurrentTimeUsec();
+
+    Uint32 pos = indicationInstance.findProperty("IndicationTime");
+    if (pos == PEG_NOT_FOUND)
+    {
+        _errorCount++;
+        return;
+    }
+
+    CIMDateTime indicationTime;
+    indicationInstance.getProperty(pos).getValue().get(indicationTime);
+    Sint64 latency =
+        CIMDateTime::getDifference(indicationTime, receiveDateTime);
+    if (latency < 0)
+    {
+        latency = 0;
+    }
+
+    // The destination path identifies the subscription, e.g.
+    // "/IndicationBenchmark/3".
+    Uint32 subscription = PEG_NOT_FOUND;
+    Uint32 slash = url.reverseFind('/');
+    if (slash != PEG_NOT_FOUND)
+    {
+        subscription = (Uint32)atoi(url.subString(slash + 1).getCString());
+    }
+
+    {
+        AutoMutex lock(_statsMutex);
+        _latencies.append(Uint64(latency));
+        if (subscription < _receivedPerSubscription.size())
+        {
+            _receivedPerSubscription[subscription]++;
+        }
+        else
+        {
+            _errorCount++;
+        }
+        _lastReceiveTime = receiveTime;
+    }
+
+    _receivedCount++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Subscription setup and cleanup
+//
+////////////////////////////////////////////////////////////////////////////////
+
+static String _getHandlerName(Uint32 index)
+{
+    char buffer[22];
+    sprintf(buffer, "%u", index);
+    return HANDLER_NAME_PREFIX + buffer;
+}
+
+static CIMObjectPath _getFilterObjectPath()
+{
+    Array<CIMKeyBinding> keys;
+    keys.append(CIMKeyBinding("SystemCreationClassName",
+        System::getSystemCreationClassName(), CIMKeyBinding::STRING));
+    keys.append(CIMKeyBinding("SystemName",
+        System::getFullyQualifiedHostName(), CIMKeyBinding::STRING));
+    keys.append(CIMKeyBinding("CreationClassName",
+        PEGASUS_CLASSNAME_INDFILTER.getString(), CIMKeyBinding::STRING));
+    keys.append(CIMKeyBinding("Name", FILTER_NAME, CIMKeyBinding::STRING));
+    return CIMObjectPath("", CIMNamespaceName(),
+        PEGASUS_CLASSNAME_INDFILTER, keys);
+}
+
+static CIMObjectPath _getHandlerObjectPath(Uint32 index)
+{
+    Array<CIMKeyBinding> keys;
+    keys.append(CIMKeyBinding("SystemCreationClassName",
+        System::getSystemCreationClassName(), CIMKeyBinding::STRING));
+    keys.append(CIMKeyBinding("SystemName",
+        System::getFullyQualifiedHostName(), CIMKeyBinding::STRING));
+    keys.append(CIMKeyBinding("CreationClassName",
+        PEGASUS_CLASSNAME_INDHANDLER_CIMXML.getString(),
+        CIMKeyBinding::STRING));
+    keys.append(CIMKeyBinding("Name", _getHandlerName(index),
+        CIMKeyBinding::STRING));
+    return CIMObjectPath("", CIMNamespaceName(),
+        PEGASUS_CLASSNAME_INDHANDLER_CIMXML, keys);
+}
+
+static CIMObjectPath _getSubscriptionObjectPath(Uint32 index)
+{
+    CIMObjectPath filterPath = _getFilterObjectPath();
+    CIMObjectPath handlerPath = _getHandlerObjectPath(index);
+
+    Array<CIMKeyBinding> keys;
+    keys.append(CIMKeyBinding("Filter", CIMValue(filterPath)));
+    keys.append(CIMKeyBinding("Handler", CIMValue(handlerPath)));
+    return CIMObjectPath("", CIMNamespaceName(),
+        PEGASUS_CLASSNAME_INDSUBSCRIPTION, keys);
+}
+
+static void _setup(CIMClient& client, const BenchmarkOptions& options)
+{
+    // The stress test providers rotate the source namespace of the
+    // Indications they generate through these three namespaces.
+    Array<String> sourceNamespaces;
+    sourceNamespaces.append("test/testProvider");
+    sourceNamespaces.append("test/testIndSrcNS1");
+    sourceNamespaces.append("test/testIndSrcNS2");
+
+    CIMInstance filterInstance(PEGASUS_CLASSNAME_INDFILTER);
+    filterInstance.addProperty(CIMProperty(CIMName("SystemCreationClassName"),
+        System::getSystemCreationClassName()));
+    filterInstance.addProperty(CIMProperty(CIMName("SystemName"),
+        System::getFullyQualifiedHostName()));
+    filterInstance.addProperty(CIMProperty(CIMName("CreationClassName"),
+        PEGASUS_CLASSNAME_INDFILTER.getString()));
+    filterInstance.addProperty(CIMProperty(CIMName("Name"), FILTER_NAME));
+    filterInstance.addProperty(CIMProperty(CIMName("Query"),
+        String("SELECT * FROM ") + options.className));
+    filterInstance.addProperty(CIMProperty(CIMName("QueryLanguage"),
+        options.queryLanguage));
+    filterInstance.addProperty(CIMProperty(CIMName("SourceNamespaces"),
+        sourceNamespaces));
+    CIMObjectPath filterPath =
+        client.createInstance(PEGASUS_NAMESPACENAME_INTEROP, filterInstance);
+
+    char portBuffer[22];
+    sprintf(portBuffer, "%u", options.port);
+
+    for (Uint32 i = 0; i < options.subscriptionCount; i++)
+    {
+        char indexBuffer[22];
+        sprintf(indexBuffer, "%u", i);
+
+        CIMInstance handlerInstance(PEGASUS_CLASSNAME_INDHANDLER_CIMXML);
+        handlerInstance.addProperty(CIMProperty(
+            CIMName("SystemCreationClassName"),
+            System::getSystemCreationClassName()));
+        handlerInstance.addProperty(CIMProperty(CIMName("SystemName"),
+            System::getFullyQualifiedHostName()));
+        handlerInstance.addProperty(CIMProperty(CIMName("CreationClassName"),
+            PEGASUS_CLASSNAME_INDHANDLER_CIMXML.getString()));
+        handlerInstance.addProperty(CIMProperty(CIMName("Name"),
+            _getHandlerName(i)));
+        handlerInstance.addProperty(CIMProperty(CIMName("Destination"),
+            String("http://localhost:") + portBuffer +
+                DESTINATION_PATH_PREFIX + indexBuffer));
+        CIMObjectPath handlerPath = client.createInstance(
+            PEGASUS_NAMESPACENAME_INTEROP, handlerInstance);
+
+        CIMInstance subscriptionInstance(PEGASUS_CLASSNAME_INDSUBSCRIPTION);
+        subscriptionInstance.addProperty(CIMProperty(CIMName("Filter"),
+            filterPath, 0, PEGASUS_CLASSNAME_INDFILTER));
+        subscriptionInstance.addProperty(CIMProperty(CIMName("Handler"),
+            handlerPath, 0, PEGASUS_CLASSNAME_INDHANDLER_CIMXML));
+        subscriptionInstance.addProperty(CIMProperty(
+            CIMName("SubscriptionState"), CIMValue(Uint16(2))));
+        client.createInstance(
+            PEGASUS_NAMESPACENAME_INTEROP, subscriptionInstance);
+    }
+}
+
+static void _deleteIgnoringNotFound(
+    CIMClient& client,
+    const CIMObjectPath& path)
+{
+    try
+    {
+        client.deleteInstance(PEGASUS_NAMESPACENAME_INTEROP, path);
+    }
+    catch (CIMException& e)
+    {
+        if (e.getCode() != CIM_ERR_NOT_FOUND)
+        {
+            throw;
+        }
+    }
+}
+
+static void _cleanup(CIMClient& client, Uint32 subscriptionCount)
+{
+    for (Uint32 i = 0; i < subscriptionCount; i++)
+    {
+        _deleteIgnoringNotFound(client, _getSubscriptionObjectPath(i));
+        _deleteIgnoringNotFound(client, _getHandlerObjectPath(i));
+    }
+    _deleteIgnoringNotFound(client, _getFilterObjectPath());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Indication generation
+//
+////////////////////////////////////////////////////////////////////////////////
+
+static void _generateIndications(
+    CIMClient& client,
+    const BenchmarkOptions& options)
+{
+    Uint32 batchSize = MAX_BATCH_SIZE;
+    if (options.rate != 0)
+    {
+        batchSize = options.rate * TICK_MILLISECONDS / 1000;
+        if (batchSize == 0)
+        {
+            batchSize = 1;
+        }
+        else if (batchSize > MAX_BATCH_SIZE)
+        {
+            batchSize = MAX_BATCH_SIZE;
+        }
+    }
+
+    // The tick length is stretched for rates below one batch per tick so
+    // that the requested rate is still honoured.
+    Uint64 tickUsec = 0;
+    if (options.rate != 0)
+    {
+        tickUsec = Uint64(batchSize) * 1000000 / options.rate;
+    }
+
+    CIMObjectPath classPath(String::EMPTY, CIMNamespaceName(),
+        CIMName(options.className));
+    Uint64 nextTick = System::getCurrentTimeUsec();
+    Uint32 generated = 0;
+
+    while (generated < options.indicationCount)
+    {
+        Uint32 count = options.indicationCount - generated;
+        if (count > batchSize)
+        {
+            count = batchSize;
+        }
+
+        Array<CIMParamValue> inParams;
+        Array<CIMParamValue> outParams;
+        inParams.append(CIMParamValue(String("indicationSendCount"),
+            CIMValue(count)));
+
+        CIMValue retValue = client.invokeMethod(options.nameSpace,
+            classPath, CIMName("SendTestIndicationNormal"),
+            inParams, outParams);
+        Sint32 rc;
+        retValue.get(rc);
+        if (rc != 0)
+        {
+            throw Exception("SendTestIndicationNormal failed");
+        }
+        generated += count;
+
+        if (tickUsec != 0)
+        {
+            nextTick += tickUsec;
+            Uint64 now = System::getCurrentTimeUsec();
+            if (nextTick > now)
+            {
+                Threads::sleep(Uint32((nextTick - now) / 1000));
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Reporting
+//
+////////////////////////////////////////////////////////////////////////////////
+
+extern "C" int _compareUint64(const void* p1, const void* p2)
+{
+    Uint64 v1 = *(const Uint64*)p1;
+    Uint64 v2 = *(const Uint64*)p2;
+    return (v1 < v2) ? -1 : ((v1 > v2) ? 1 : 0);
+}
+
+// Nearest-rank percentile of a sorted, non-empty array.
+static Uint64 _percentile(const Array<Uint64>& sorted, Uint32 perMille)
+{
+    Uint64 rank = (Uint64(sorted.size()) * perMille + 999) / 1000;
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+    return sorted[Uint32(rank - 1)];
+}
+
+static void _writeReport(
+    ostream& os,
+    const BenchmarkOptions& options,
+    Uint64 startTime,
+    Uint64 generateEndTime)
+{
+    AutoMutex lock(_statsMutex);
+
+    Uint32 expected = options.indicationCount * options.subscriptionCount;
+    Uint32 received = _latencies.size();
+    Uint64 endTime = (_lastReceiveTime > startTime) ?
+        _lastReceiveTime : generateEndTime;
+    double elapsed = double(endTime - startTime) / 1000000;
+    double generateElapsed = double(generateEndTime - startTime) / 1000000;
+
+    os << "className=" << options.className << endl;
+    os << "namespace=" << options.nameSpace.getString() << endl;
+    os << "queryLanguage=" << options.queryLanguage << endl;
+    os << "subscriptions=" << options.subscriptionCount << endl;
+    os << "targetRate=" << options.rate << endl;
+    os << "indicationsGenerated=" << options.indicationCount << endl;
+    os << "deliveriesExpected=" << expected << endl;
+    os << "deliveriesReceived=" << received << endl;
+    os << "deliveriesLost=" << (expected > received ? expected - received : 0)
+        << endl;
+    os << "errors=" << _errorCount.get() << endl;
+    os << "generateSeconds=" << generateElapsed << endl;
+    os << "elapsedSeconds=" << elapsed << endl;
+    os << "generateRate="
+        << (generateElapsed > 0 ? options.indicationCount / generateElapsed : 0)
+        << endl;
+    os << "deliveryRate=" << (elapsed > 0 ? received / elapsed : 0) << endl;
+
+    if (received != 0)
+    {
+        Array<Uint64> sorted(_latencies);
+        qsort(&sorted[0], sorted.size(), sizeof(Uint64), _compareUint64);
+
+        Uint64 total = 0;
+        for (Uint32 i = 0; i < sorted.size(); i++)
+        {
+            total += sorted[i];
+        }
+
+        os << "latencyMinUsec=" << sorted[0] << endl;
+        os << "latencyMeanUsec=" << total / sorted.size() << endl;
+        os << "latencyP50Usec=" << _percentile(sorted, 500) << endl;
+        os << "latencyP90Usec=" << _percentile(sorted, 900) << endl;
+        os << "latencyP99Usec=" << _percentile(sorted, 990) << endl;
+        os << "latencyP999Usec=" << _percentile(sorted, 999) << endl;
+        os << "latencyMaxUsec=" << sorted[sorted.size() - 1] << endl;
+    }
+
+    for (Uint32 i = 0; i < _receivedPerSubscription.size(); i++)
+    {
+        os << "subscription." << i << ".received="
+            << _receivedPerSubscription[i] << endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// main
+//
+////////////////////////////////////////////////////////////////////////////////
+
+static void _usage()
+{
+    cerr << endl
+        << "Usage:" << endl
+        << "    TestIndicationBenchmark ClassName Namespace [options]\n"
+        << "    where options are:\n"
+        << "       -n <count>     number of indications to generate"
+        << " (default " << DEFAULT_INDICATION_COUNT << ")\n"
+        << "       -s <count>     number of subscriptions, each with its own\n"
+        << "                      handler (default "
+        << DEFAULT_SUBSCRIPTION_COUNT << ")\n"
+        << "       -r <rate>      target generation rate in indications per\n"
+        << "                      second, 0 for unpaced (default "
+        << DEFAULT_RATE << ")\n"
+        << "       -q <language>  WQL or DMTF:CQL (default WQL)\n"
+        << "       -p <port>      CIMListener port (default "
+        << DEFAULT_LISTENER_PORT << ")\n"
+        << "       -t <seconds>   give up when no deliveries arrive for this\n"
+        << "                      many seconds (default "
+        << DEFAULT_TIMEOUT_SECONDS << ")\n"
+        << "       -o <file>      also write the report to <file>\n"
+        << "    TestIndicationBenchmark ClassName Namespace cleanup"
+        << " [-s <count>]\n"
+        << "       removes subscriptions left behind by an aborted run.\n"
+        << endl;
+}
+
+static Boolean _parseUint32(const char* arg, Uint32& value)
+{
+    char* end = 0;
+    unsigned long v = strtoul(arg, &end, 10);
+    if (*arg == '\0' || *end != '\0')
+    {
+        return false;
+    }
+    value = Uint32(v);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        _usage();
+        return 1;
+    }
+
+    BenchmarkOptions options;
+    options.className = argv[1];
+    options.nameSpace = CIMNamespaceName(argv[2]);
+    options.queryLanguage = "WQL";
+    options.indicationCount = DEFAULT_INDICATION_COUNT;
+    options.subscriptionCount = DEFAULT_SUBSCRIPTION_COUNT;
+    options.rate = DEFAULT_RATE;
+    options.port = DEFAULT_LISTENER_PORT;
+    options.timeoutSeconds = DEFAULT_TIMEOUT_SECONDS;
+
+    Boolean cleanupOnly = false;
+
+    for (int i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "cleanup") == 0)
+        {
+            cleanupOnly = true;
+            continue;
+        }
+
+        if (argv[i][0] != '-' || argv[i][2] != '\0' || i + 1 == argc)
+        {
+            _usage();
+            return 1;
+        }
+
+        const char* value = argv[++i];
+        Boolean valid = true;
+
+        switch (argv[i - 1][1])
+        {
+            case 'n':
+                valid = _parseUint32(value, options.indicationCount);
+                break;
+            case 's':
+                valid = _parseUint32(value, options.subscriptionCount) &&
+                    options.subscriptionCount != 0;
+                break;
+            case 'r':
+                valid = _parseUint32(value, options.rate);
+                break;
+            case 'p':
+                valid = _parseUint32(value, options.port);
+                break;
+            case 't':
+                valid = _parseUint32(value, options.timeoutSeconds);
+                break;
+            case 'q':
+                options.queryLanguage = value;
+                valid = options.queryLanguage == "WQL" ||
+                    options.queryLanguage == "DMTF:CQL";
+                break;
+            case 'o':
+                options.reportFile = value;
+                break;
+            default:
+                valid = false;
+                break;
+        }
+
+        if (!valid)
+        {
+            cerr << "Invalid value for " << argv[i - 1] << ": '" << value
+                << "'" << endl;
+            _usage();
+            return 1;
+        }
+    }
+
+    int rc = 0;
+
+    try
+    {
+        CIMClient client;
+        client.connectLocal();
+
+        // Remove anything left behind by an earlier, aborted run.
+        _cleanup(client, options.subscriptionCount);
+        if (cleanupOnly)
+        {
+            cout << "+++++ cleanup completed successfully" << endl;
+            return 0;
+        }
+
+        _receivedPerSubscription.grow(options.subscriptionCount, 0);
+        _latencies.reserveCapacity(
+            options.indicationCount * options.subscriptionCount);
+
+        // The consumer must outlive the listener that dispatches to it.
+        BenchmarkConsumer consumer;
+        CIMListener listener(options.port);
+        listener.addConsumer(&consumer);
+        listener.start();
+
+        _setup(client, options);
+
+        Uint64 startTime = System::getCurrentTimeUsec();
+        _generateIndications(client, options);
+        Uint64 generateEndTime = System::getCurrentTimeUsec();
+
+        Uint32 expected = options.indicationCount * options.subscriptionCount;
+        Uint32 lastReceived = 0;
+        Uint64 lastProgress = generateEndTime;
+
+        while (_receivedCount.get() < expected)
+        {
+            Threads::sleep(TICK_MILLISECONDS);
+
+            Uint64 now = System::getCurrentTimeUsec();
+            Uint32 received = _receivedCount.get();
+            if (received != lastReceived)
+            {
+                lastReceived = received;
+                lastProgress = now;
+            }
+            else if (now - lastProgress >=
+                Uint64(options.timeoutSeconds) * 1000000)
+            {
+                cerr << "----- Warning: no deliveries for "
+                    << options.timeoutSeconds << " seconds, "
+                    << received << " of " << expected << " received" << endl;
+                rc = 1;
+                break;
+            }
+        }
+
+        _cleanup(client, options.subscriptionCount);
+        listener.stop();
+        listener.removeConsumer(&consumer);
+
+        _writeReport(cout, options, startTime, generateEndTime);
+
+        if (options.reportFile.size() != 0)
+        {
+            ofstream os(options.reportFile.getCString());
+            if (!os)
+            {
+                cerr << "Unable to open report file " << options.reportFile
+                    << endl;
+                return 1;
+            }
+            _writeReport(os, options, startTime, generateEndTime);
+        }
+    }
+    catch (Exception& e)
+    {
+        cerr << "----- Error: " << e.getMessage() << endl;
+        rc = 1;
+    }
+
+    if (_errorCount.get() != 0)
+    {
+        rc = 1;
+    }
+
+    return rc;
+}
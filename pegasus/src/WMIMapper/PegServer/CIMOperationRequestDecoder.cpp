@@ -78,6 +78,7 @@ void CIMOperationRequestDecoder::sendResponse(
    if (queue)
    {
       AutoPtr<HTTPMessage> httpMessage(new HTTPMessage(message));
+      httpMessage->dest = queueId;
       queue->enqueue(httpMessage.release());
    }
 }
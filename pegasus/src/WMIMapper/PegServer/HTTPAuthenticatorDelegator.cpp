@@ -86,7 +86,7 @@ void HTTPAuthenticatorDelegator::_sendResponse(
     if (queue)
     {
         AutoPtr<HTTPMessage> httpMessage(new HTTPMessage(message));
-        httpMessage->dest = queue->getQueueId();
+        httpMessage->dest = queueId;
 
         queue->enqueue(httpMessage.release());
     }